@@ -290,6 +290,7 @@ typedef int pid_t;
 #include "Common/Threadpool.h"
 #ifdef PLATFORM_UNIX
 #include "Common/TimerQueue.h"
+#include "Common/IoUring.h"
 #include "Common/EventLoop.h"
 #endif
 #include "Common/Timer.h"
@@ -382,6 +383,7 @@ typedef int pid_t;
 #include "Common/LruCache.h"
 #include "Common/SynchronizedMap.h"
 #include "Common/SynchronizedSet.h"
+#include "Common/MpscQueue.h"
 #include "Common/ReaderQueue.h"
 #include "Common/Uri.h"
 #include "Common/Uri.Parser.h"
@@ -457,6 +459,7 @@ typedef int pid_t;
 #include "Common/AsyncOperationWorkJobItem.h"
 #include "Common/AsyncWorkJobQueue.h"
 #include "Common/JobQueue.h"
+#include "Common/ShardedJobQueue.h"
 #include "Common/BatchJobQueue.h"
 
 // FabricConstants
@@ -574,3 +577,4 @@ typedef int pid_t;
 #include "Common/Math.h"
 
 #include "Common/crc.h"
+#include "Common/Lz4.h"
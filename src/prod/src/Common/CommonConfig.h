@@ -59,11 +59,19 @@ namespace Common
 
         // Dispatch time threshold for TimerQueue timer, longer dispatch time will be traced out
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Common", TimerQueueDispatchTimeThreshold, Common::TimeSpan::FromSeconds(0.1), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanGreaterThan(Common::TimeSpan::Zero));
+        // Tick length of TimerQueue timing wheel, timers fire on the first tick at or after their due time
+        INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Common", TimerQueueTickInterval, Common::TimeSpan::FromMilliseconds(1), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanGreaterThan(Common::TimeSpan::Zero));
+        // Maximum count of expired TimerQueue timers fired by one threadpool callback
+        INTERNAL_CONFIG_ENTRY(uint, L"Common", TimerQueueDispatchBatchSize, 32, Common::ConfigEntryUpgradePolicy::Static, Common::InRange<uint>(1, 4096));
 
         // Count of concurrent event loops for sockets, linux only, default to 0 to use processor current. 
         DEPRECATED_CONFIG_ENTRY(uint, L"Common", EventLoopConcurrency, 0, Common::ConfigEntryUpgradePolicy::Static);
         // Cleanup delay for fd context used in event loop
         DEPRECATED_CONFIG_ENTRY(Common::TimeSpan, L"Common", EventLoopCleanupDelay, Common::TimeSpan::FromSeconds(120), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanGreaterThan(Common::TimeSpan::Zero));
+        // Submission queue depth of each io_uring backed event loop
+        INTERNAL_CONFIG_ENTRY(uint, L"Common", EventLoopIoUringQueueDepth, 1024, Common::ConfigEntryUpgradePolicy::Static, Common::InRange<uint>(16, 32768));
+        // Maximum count of completions reaped from io_uring in one batch
+        INTERNAL_CONFIG_ENTRY(uint, L"Common", EventLoopIoUringReapBatchSize, 128, Common::ConfigEntryUpgradePolicy::Static, Common::InRange<uint>(1, 4096));
 #endif
         // Switch to support upgrade and downgrade scenarios without trace loss for transitioning into Structured traces in linux using config upgrade
         // TODO - remove after transition to structured traces is complete
@@ -16,6 +16,19 @@ namespace
     const int eventListCapacity = 64;
     const uint defaultEventMask = EPOLLONESHOT; 
 
+    // io_uring user_data is FdContext pointer tagged with operation type in the low bits,
+    // user_data 0 is used for internal operations, e.g. cancellation, whose completions are ignored
+    const uint64 IoOpMask = 0x7;
+    const uint IoOpPoll = 1;
+    const uint IoOpReadv = 2;
+    const uint IoOpWritev = 3;
+    // readiness poll armed after readv/writev returned EAGAIN on a non-blocking socket,
+    // the operation is resubmitted with the same iovec array once the poll completes
+    const uint IoOpReadvPoll = 4;
+    const uint IoOpWritevPoll = 5;
+
+    bool IsRetryPollOp(uint op) { return (op == IoOpReadvPoll) || (op == IoOpWritevPoll); }
+
     EventLoopPool* defaultPool = nullptr;
     INIT_ONCE initDefaultPoolOnce = INIT_ONCE_STATIC_INIT;
 
@@ -39,9 +52,10 @@ EventLoopPool* EventLoopPool::GetDefault()
     return defaultPool; 
 }
 
-EventLoopPool::EventLoopPool(wstring const & tag, uint concurrency)
+EventLoopPool::EventLoopPool(wstring const & tag, uint concurrency, EventLoopBackend::Enum backend)
     : id_(tag.empty()? wformatString("{0}", TextTraceThis) : wformatString("{0}.{1}", tag, TextTraceThis))
     , assignmentIndex_(0)
+    , backend_(backend)
 {
     if (concurrency == 0)
     {
@@ -56,12 +70,18 @@ EventLoopPool::EventLoopPool(wstring const & tag, uint concurrency)
     //Need at least 2 loops to seperate input and output events for a given socket
     if (concurrency < 2) concurrency = 2;
 
-    EventLoopPool::WriteInfo(TracePool, id_, "create: concurrency = {0}", concurrency);
+    if ((backend_ == EventLoopBackend::IoUring) && !IoUring::IsSupported())
+    {
+        EventLoopPool::WriteWarning(TracePool, id_, "io_uring is not supported, falling back to epoll");
+        backend_ = EventLoopBackend::Epoll;
+    }
+
+    EventLoopPool::WriteInfo(TracePool, id_, "create: concurrency = {0}, backend = {1}", concurrency, (int)backend_);
 
     pool_.reserve(concurrency);
     for(uint i = 0; i < concurrency; ++i)
     {
-        pool_.emplace_back(make_unique<EventLoop>());
+        pool_.emplace_back(make_unique<EventLoop>(backend_));
     }
 }
 
@@ -113,28 +133,65 @@ class EventLoop::FdContext
 public:
     typedef std::shared_ptr<FdContext> SPtr;
 
-    FdContext(int fd, uint events, Callback const & cb, bool dispatchEventAsync);
+    FdContext(
+        int fd,
+        uint events,
+        Callback const & cb,
+        IoCallback const & readCompleteCb,
+        IoCallback const & writeCompleteCb,
+        bool dispatchEventAsync);
 
     int Fd() const;
     uint Events() const;
     void FireEvent(uint event);
+    void FireIoCompletion(uint op, int result);
     void Close(bool waitForCallback);
 
+    uint64 UserData(uint op) { return reinterpret_cast<uint64>(this) | op; }
+    void SetIoPending(uint op) { pendingIoMask_ |= (1 << op); }
+    void ClearIoPending(uint op) { pendingIoMask_ &= ~(1 << op); }
+    uint PendingIoMask() const { return pendingIoMask_.load(); }
+    bool IsClosed() const { return closed_.load(); }
+
+    void SetIov(uint op, iovec const * iov, int iovCount);
+    iovec const * Iov(uint op) const { return iov_[op]; }
+    int IovCount(uint op) const { return iovCount_[op]; }
+
+    // Entries submitted to io_uring with this context as user data and not yet reaped
+    void IoStarted() { ++ioInFlight_; }
+    void IoCompleted();
+    bool WaitForIoCompletion(Common::TimeSpan timeout);
+
     void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const;
 
 private:
     void RunCallback(uint event);
+    void RunIoCallback(uint op, int result);
+    bool TryStartCallback();
     int CallbackRunningDec();
 
     const int fd_;
     const uint events_;
     const Callback cb_;
+    const IoCallback readCompleteCb_;
+    const IoCallback writeCompleteCb_;
     const bool dispatchEventAsync_;
     std::atomic_int cbRunning_ {1};
+    std::atomic_uint pendingIoMask_ {0};
+    std::atomic_bool closed_ {false};
+    std::atomic_int ioInFlight_ {0};
+    std::atomic_bool waitingForIo_ {false};
+    iovec const * iov_[IoOpWritev + 1] = {};
+    int iovCount_[IoOpWritev + 1] = {};
     ManualResetEvent closedEvent_;
+    ManualResetEvent ioCompletedEvent_;
 };
 
-EventLoop::EventLoop() : id_(wformatString("{0}", TextTraceThis)), fdMapSize_(0)
+EventLoop::EventLoop(EventLoopBackend::Enum backend)
+    : id_(wformatString("{0}", TextTraceThis))
+    , backend_(backend)
+    , epfd_(-1)
+    , fdMapSize_(0)
 {
     Setup();
 }
@@ -146,9 +203,24 @@ EventLoop::~EventLoop()
 
 void EventLoop::Setup()
 {
-    epfd_ = epoll_create1(EPOLL_CLOEXEC);
-    ASSERT_IF(epfd_ < 0, "epoll_create failed: {0}", errno);
-    reportList_.resize(eventListCapacity);
+    if (backend_ == EventLoopBackend::IoUring)
+    {
+        ioUring_ = make_unique<IoUring>();
+        auto error = ioUring_->Open(CommonConfig::GetConfig().EventLoopIoUringQueueDepth);
+        if (!error.IsSuccess())
+        {
+            WriteWarning(TraceLoop, id_, "failed to open io_uring, falling back to epoll: {0}", error);
+            ioUring_.reset();
+            backend_ = EventLoopBackend::Epoll;
+        }
+    }
+
+    if (backend_ == EventLoopBackend::Epoll)
+    {
+        epfd_ = epoll_create1(EPOLL_CLOEXEC);
+        ASSERT_IF(epfd_ < 0, "epoll_create failed: {0}", errno);
+        reportList_.resize(eventListCapacity);
+    }
 
     pthread_attr_t pthreadAttr;
     Invariant(pthread_attr_init(&pthreadAttr) == 0);
@@ -177,7 +249,16 @@ void EventLoop::SetSchedParam(int policy, int priority)
 
 void* EventLoop::PthreadFunc(void *arg)
 {
-    ((EventLoop*)arg)->Loop();
+    auto loop = (EventLoop*)arg;
+    if (loop->backend_ == EventLoopBackend::IoUring)
+    {
+        loop->IoUringLoop();
+    }
+    else
+    {
+        loop->Loop();
+    }
+
     return nullptr;
 }
 
@@ -238,22 +319,232 @@ void EventLoop::Loop()
     WriteInfo(TraceLoop, id_,"event loop ended");
 }
 
+void EventLoop::IoUringLoop()
+{
+    WriteInfo(TraceLoop, id_, "starting io_uring event loop");
+
+    vector<IoUring::Completion> completions(CommonConfig::GetConfig().EventLoopIoUringReapBatchSize);
+    for(;;)
+    {
+        // Submissions made on this thread, e.g. from callbacks dispatched synchronously,
+        // are only queued and get flushed here together with waiting for completions
+        uint count = 0;
+        auto error = ioUring_->SubmitAndWait(completions.data(), (uint)completions.size(), count);
+        if (!error.IsSuccess())
+        {
+            WriteError(TraceLoop, id_, "io_uring_enter failed: {0}", error);
+            break;
+        }
+
+        WriteNoise(
+            TraceLoop,
+            id_,
+            "reaped {0} completions on {1} registered descriptor(s)",
+            count,
+            fdMapSize_);
+
+        for(uint i = 0; i < count; ++i)
+        {
+            auto userData = completions[i].UserData;
+            if (userData == 0) continue;
+
+            auto fdc = reinterpret_cast<FdContext*>(userData & ~IoOpMask);
+            auto op = (uint)(userData & IoOpMask);
+            auto result = completions[i].Result;
+            OnIoUringCompletion(fdc, op, result);
+            fdc->IoCompleted();
+        }
+    }
+
+    WriteInfo(TraceLoop, id_,"io_uring event loop ended");
+}
+
+void EventLoop::OnIoUringCompletion(FdContext* fdc, uint op, int result)
+{
+    if (op == IoOpPoll)
+    {
+        uint evt = (result < 0)? EPOLLERR : (uint)result;
+        WriteTrace(
+            IsFdClosedOrInError(evt) ? LogLevel::Info : LogLevel::Noise,
+            TraceLoop,
+            id_,
+            "poll completed on {0}: result = {1}",
+            *fdc,
+            result);
+
+        fdc->FireEvent(evt);
+        return;
+    }
+
+    if (IsRetryPollOp(op))
+    {
+        fdc->ClearIoPending(op);
+        auto ioOp = (op == IoOpReadvPoll)? IoOpReadv : IoOpWritev;
+        if (fdc->IsClosed())
+        {
+            WriteInfo(TraceLoop, id_, "{0} retry dropped, descriptor closed: {1}, result = {2}", (ioOp == IoOpReadv)? "readv" : "writev", *fdc, result);
+            return;
+        }
+
+        if (result < 0)
+        {
+            fdc->FireIoCompletion(ioOp, result);
+            return;
+        }
+
+        // The socket is readable or writable, or in error, in which case the retried operation reports the error
+        auto error = SubmitIo(fdc, ioOp, fdc->Iov(ioOp), fdc->IovCount(ioOp));
+        if (!error.IsSuccess())
+        {
+            fdc->FireIoCompletion(ioOp, -EIO);
+        }
+
+        return;
+    }
+
+    if ((result == -EAGAIN) || (result == -EWOULDBLOCK))
+    {
+        // Sockets are non-blocking, so readv/writev complete with EAGAIN instead of waiting for data or
+        // send buffer space. This is not a failure, wait for readiness and submit the same operation again.
+        fdc->ClearIoPending(op);
+        if (fdc->IsClosed()) return;
+
+        WriteNoise(TraceLoop, id_, "{0} would block on {1}, waiting for readiness", (op == IoOpReadv)? "readv" : "writev", *fdc);
+        if (!PrepIo(fdc, (op == IoOpReadv)? IoOpReadvPoll : IoOpWritevPoll, nullptr, 0))
+        {
+            fdc->FireIoCompletion(op, result);
+        }
+
+        return;
+    }
+
+    WriteTrace(
+        (result < 0) ? LogLevel::Info : LogLevel::Noise,
+        TraceLoop,
+        id_,
+        "{0} completed on {1}: result = {2}",
+        (op == IoOpReadv)? "readv" : "writev",
+        *fdc,
+        result);
+
+    fdc->FireIoCompletion(op, result);
+}
+
+ErrorCode EventLoop::Flush()
+{
+    if (pthread_equal(pthread_self(), tid_))
+    {
+        // IoUringLoop will submit before waiting
+        return ErrorCode();
+    }
+
+    return ioUring_->Submit();
+}
+
+bool EventLoop::PrepIo(FdContext* fdc, uint op, iovec const * iov, int iovCount)
+{
+    fdc->SetIoPending(op);
+    fdc->IoStarted();
+
+    bool prepared = false;
+    switch (op)
+    {
+    case IoOpPoll:
+        prepared = ioUring_->PrepPollAdd(fdc->Fd(), fdc->Events() & ~defaultEventMask, fdc->UserData(op));
+        break;
+    case IoOpReadv:
+        prepared = ioUring_->PrepReadv(fdc->Fd(), iov, iovCount, fdc->UserData(op));
+        break;
+    case IoOpWritev:
+        prepared = ioUring_->PrepWritev(fdc->Fd(), iov, iovCount, fdc->UserData(op));
+        break;
+    case IoOpReadvPoll:
+        prepared = ioUring_->PrepPollAdd(fdc->Fd(), EPOLLIN, fdc->UserData(op));
+        break;
+    case IoOpWritevPoll:
+        prepared = ioUring_->PrepPollAdd(fdc->Fd(), EPOLLOUT, fdc->UserData(op));
+        break;
+    default:
+        Assert::CodingError("unexpected io_uring operation {0}", op);
+    }
+
+    if (!prepared)
+    {
+        WriteWarning(TraceLoop, id_, "failed to queue operation {0} for {1}", op, *fdc);
+        fdc->ClearIoPending(op);
+        fdc->IoCompleted();
+        return false;
+    }
+
+    if (fdc->IsClosed())
+    {
+        // UnregisterFd may have read the pending mask before this entry was queued, cancel it here
+        // so that UnregisterFd does not wait for an operation that never completes on an idle socket
+        ioUring_->PrepCancel(fdc->UserData(op), 0);
+    }
+
+    return true;
+}
+
+ErrorCode EventLoop::SubmitIo(FdContext* fdc, uint op, iovec const * iov, int iovCount)
+{
+    Invariant(ioUring_);
+
+    fdc->SetIov(op, iov, iovCount);
+    if (!PrepIo(fdc, op, iov, iovCount))
+    {
+        return ErrorCodeValue::OperationFailed;
+    }
+
+    return Flush();
+}
+
+ErrorCode EventLoop::SubmitReadv(FdContext* fdc, iovec const * iov, int iovCount)
+{
+    WriteNoise(TraceLoop, id_, "SubmitReadv({0}, {1})", *fdc, iovCount);
+    return SubmitIo(fdc, IoOpReadv, iov, iovCount);
+}
+
+ErrorCode EventLoop::SubmitWritev(FdContext* fdc, iovec const * iov, int iovCount)
+{
+    WriteNoise(TraceLoop, id_, "SubmitWritev({0}, {1})", *fdc, iovCount);
+    return SubmitIo(fdc, IoOpWritev, iov, iovCount);
+}
+
 void EventLoop::Cleanup()
 {
-    close(epfd_);
+    if (epfd_ >= 0)
+    {
+        close(epfd_);
+    }
+
+    ioUring_.reset();
     fdMap_.clear();
     fdMapSize_ = fdMap_.size();
 }
 
-EventLoop::FdContext* EventLoop::RegisterFd(int fd, uint events, bool dispatchEventAsync, Callback const & cb)
+EventLoop::FdContext* EventLoop::RegisterFd(
+    int fd,
+    uint events,
+    bool dispatchEventAsync,
+    Callback const & cb,
+    IoCallback const & readCompleteCb,
+    IoCallback const & writeCompleteCb)
 {
-    auto ctx = make_shared<FdContext>(fd, events, cb, dispatchEventAsync);
+    auto ctx = make_shared<FdContext>(fd, events, cb, readCompleteCb, writeCompleteCb, dispatchEventAsync);
     {
         AcquireWriteLock grab(lock_);
 
         auto inserted = fdMap_.emplace(make_pair(fd, ctx));
         fdMapSize_ = fdMap_.size();
         Invariant(inserted.second);
+
+        if (ioUring_)
+        {
+            // nothing to register with io_uring, readiness is requested per Activate() call
+            WriteInfo(TraceLoop, id_, "RegisterFd: ctx={0}", *ctx);
+            return ctx.get();
+        }
     
         epoll_event ev;
         ev.events = 0;
@@ -271,11 +562,29 @@ ErrorCode EventLoop::Activate(FdContext* fdc)
 {
     WriteNoise(TraceLoop, id_, "Activate({0})", *fdc);
 
+    if (ioUring_)
+    {
+        // poll request in io_uring is always one-shot
+        if (!PrepIo(fdc, IoOpPoll, nullptr, 0))
+        {
+            return ErrorCodeValue::OperationFailed;
+        }
+
+        return Flush();
+    }
+
     epoll_event ev = { .events = fdc->Events()};
     ev.data.ptr = fdc;
 
     ErrorCode error;
     auto updated = epoll_ctl(epfd_, EPOLL_CTL_MOD, fdc->Fd(), &ev);
+    if ((updated < 0) && (errno == ENOENT))
+    {
+        // fd is removed from epoll when EPOLLERR is reported, which is not always fatal,
+        // e.g. MSG_ZEROCOPY send completions are reported through socket error queue
+        updated = epoll_ctl(epfd_, EPOLL_CTL_ADD, fdc->Fd(), &ev);
+    }
+
     if (updated < 0)
     {
         error = ErrorCode::FromErrno();
@@ -312,7 +621,39 @@ void EventLoop::UnregisterFd(FdContext* fdc, bool waitForCallback)
         fdMap_.erase(iter);
         fdMapSize_ = fdMap_.size();
 
-        epoll_ctl(epfd_, EPOLL_CTL_DEL, fdc->Fd(), nullptr);
+        if (ioUring_)
+        {
+            // Cancel whatever may still be outstanding, completions of cancelled operations
+            // are ignored as callbacks are disabled by FdContext::Close above
+            auto pendingIoMask = fdc->PendingIoMask();
+            for (auto op : { IoOpPoll, IoOpReadv, IoOpWritev, IoOpReadvPoll, IoOpWritevPoll })
+            {
+                if (pendingIoMask & (1 << op))
+                {
+                    ioUring_->PrepCancel(fdc->UserData(op), 0);
+                }
+            }
+        }
+        else
+        {
+            epoll_ctl(epfd_, EPOLL_CTL_DEL, fdc->Fd(), nullptr);
+        }
+    }
+
+    if (ioUring_)
+    {
+        Flush();
+
+        // Submitted operations reference the caller's iovec buffers, which may be freed once this returns.
+        // Waiting is only possible off the loop thread, and only when the caller may block, otherwise the
+        // caller must keep its buffers alive for EventLoopCleanupDelay, as it already does for callbacks.
+        if (waitForCallback && !pthread_equal(pthread_self(), tid_))
+        {
+            if (!ctx->WaitForIoCompletion(CommonConfig::GetConfig().EventLoopCleanupDelay))
+            {
+                WriteWarning(TraceLoop, id_, "UnregisterFd({0}): timed out waiting for io_uring operations, pendingIoMask = {1:x}", *ctx, ctx->PendingIoMask());
+            }
+        }
     }
 
     //Keep ctx alive a little longer in case an event is being or about to be reported
@@ -324,8 +665,19 @@ void EventLoop::UnregisterFd(FdContext* fdc, bool waitForCallback)
         CommonConfig::GetConfig().EventLoopCleanupDelay);
 }
 
-EventLoop::FdContext::FdContext(int fd, uint events, Callback const & cb, bool dispatchEventAsync)
-    : fd_(fd), events_(events | defaultEventMask), cb_(cb), dispatchEventAsync_(dispatchEventAsync)
+EventLoop::FdContext::FdContext(
+    int fd,
+    uint events,
+    Callback const & cb,
+    IoCallback const & readCompleteCb,
+    IoCallback const & writeCompleteCb,
+    bool dispatchEventAsync)
+    : fd_(fd)
+    , events_(events | defaultEventMask)
+    , cb_(cb)
+    , readCompleteCb_(readCompleteCb)
+    , writeCompleteCb_(writeCompleteCb)
+    , dispatchEventAsync_(dispatchEventAsync)
 {
     WriteInfo(TraceLoop, "FdContext ctor: {0}", *this);
 }
@@ -351,18 +703,26 @@ int EventLoop::FdContext::CallbackRunningDec()
     return after;
 }
 
-void EventLoop::FdContext::FireEvent(uint events)
+bool EventLoop::FdContext::TryStartCallback()
 {
     auto cbRunning = ++cbRunning_;
-    //there are no concurrent ++cbRunning_ calls, as FireEvent is called sequentially after epoll_wait return
+    //there are no concurrent ++cbRunning_ calls, as FireEvent and FireIoCompletion are called sequentially on loop thread
     if (cbRunning < 2) 
     {
         Invariant(cbRunning == 1);
         auto afterDec = CallbackRunningDec();
         Invariant(afterDec == 0);
-        return;
+        return false;
     }
 
+    return true;
+}
+
+void EventLoop::FdContext::FireEvent(uint events)
+{
+    pendingIoMask_ &= ~(1 << IoOpPoll);
+    if (!TryStartCallback()) return;
+
     if (dispatchEventAsync_ || EventLoop::IsFdClosedOrInError(events))
     {
         Threadpool::Post([events, this] { RunCallback(events); });
@@ -378,9 +738,56 @@ void EventLoop::FdContext::RunCallback(uint events)
     CallbackRunningDec();
 }
 
+void EventLoop::FdContext::FireIoCompletion(uint op, int result)
+{
+    pendingIoMask_ &= ~(1 << op);
+    if (!TryStartCallback()) return;
+
+    if (dispatchEventAsync_ || (result < 0))
+    {
+        Threadpool::Post([op, result, this] { RunIoCallback(op, result); });
+        return;
+    }
+
+    RunIoCallback(op, result);
+}
+
+void EventLoop::FdContext::RunIoCallback(uint op, int result)
+{
+    auto const & cb = (op == IoOpReadv)? readCompleteCb_ : writeCompleteCb_;
+    Invariant(cb);
+    cb(fd_, result);
+    CallbackRunningDec();
+}
+
+void EventLoop::FdContext::SetIov(uint op, iovec const * iov, int iovCount)
+{
+    iov_[op] = iov;
+    iovCount_[op] = iovCount;
+}
+
+void EventLoop::FdContext::IoCompleted()
+{
+    auto after = --ioInFlight_;
+    Invariant(after >= 0);
+    if ((after == 0) && waitingForIo_.load())
+    {
+        ioCompletedEvent_.Set();
+    }
+}
+
+bool EventLoop::FdContext::WaitForIoCompletion(TimeSpan timeout)
+{
+    waitingForIo_ = true;
+    if (ioInFlight_.load() == 0) return true;
+
+    return ioCompletedEvent_.WaitOne(timeout);
+}
+
 void EventLoop::FdContext::Close(bool waitForCallback)
 {
     WriteInfo(TraceLoop, "FdContext({0}): closing {1}", TextTraceThis, *this);
+    closed_ = true;
 
     if (CallbackRunningDec() == 0)
     {
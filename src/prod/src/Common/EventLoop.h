@@ -7,20 +7,49 @@
 
 namespace Common
 {
+    namespace EventLoopBackend
+    {
+        enum Enum
+        {
+            // readiness notification, IO is issued by callback via readv/writev
+            Epoll = 0,
+            // completion notification, readv/writev are submitted to io_uring and
+            // completions are reaped in batches on the loop thread
+            IoUring = 1,
+        };
+    }
+
     class EventLoop : public Common::TextTraceComponent<Common::TraceTaskCodes::Common>
     {
     public:
         typedef std::function<void(int fd, uint event)> Callback;
+        // result is the byte count transferred on success or -errno on failure
+        typedef std::function<void(int fd, int result)> IoCallback;
 
-        EventLoop();
+        EventLoop(EventLoopBackend::Enum backend = EventLoopBackend::Epoll);
         ~EventLoop();
 
         class FdContext;
-        FdContext* RegisterFd(int fd, uint events, bool dispatchEventAsync, Callback const & cb);
+        FdContext* RegisterFd(
+            int fd,
+            uint events,
+            bool dispatchEventAsync,
+            Callback const & cb,
+            IoCallback const & readCompleteCb = nullptr,
+            IoCallback const & writeCompleteCb = nullptr);
+
         void UnregisterFd(FdContext* fdc, bool waitForCallback);
 
         Common::ErrorCode Activate(FdContext* fdc);
 
+        // Async IO is only available with EventLoopBackend::IoUring, iovec array must stay
+        // valid until the completion callback registered for the descriptor is invoked, or until
+        // UnregisterFd(waitForCallback = true) returns. EAGAIN is handled by waiting for readiness
+        // and resubmitting, completion callbacks only see byte counts and real errors.
+        bool SupportsAsyncIo() const { return backend_ == EventLoopBackend::IoUring; }
+        Common::ErrorCode SubmitReadv(FdContext* fdc, iovec const * iov, int iovCount);
+        Common::ErrorCode SubmitWritev(FdContext* fdc, iovec const * iov, int iovCount);
+
         static bool IsFdClosedOrInError(uint events) { return events & (EPOLLERR|EPOLLHUP); }
 
         void SetSchedParam(int policy, int priority);
@@ -31,10 +60,17 @@ namespace Common
         void Setup();
         void Cleanup();
         void Loop();
+        void IoUringLoop();
+        void OnIoUringCompletion(FdContext* fdc, uint op, int result);
+        bool PrepIo(FdContext* fdc, uint op, iovec const * iov, int iovCount);
+        Common::ErrorCode SubmitIo(FdContext* fdc, uint op, iovec const * iov, int iovCount);
+        Common::ErrorCode Flush();
         static void* PthreadFunc(void*);
 
         Common::RwLock lock_;
         std::wstring id_;
+        EventLoopBackend::Enum backend_;
+        std::unique_ptr<IoUring> ioUring_;
         int epfd_;
         pthread_t tid_;
         FdMap fdMap_;
@@ -47,7 +83,10 @@ namespace Common
     public:
         EventLoopPool(
             std::wstring const & tag = L"",
-            uint concurrency = 0);
+            uint concurrency = 0,
+            EventLoopBackend::Enum backend = EventLoopBackend::Epoll);
+
+        EventLoopBackend::Enum Backend() const { return backend_; }
 
         EventLoop& Assign();
         void AssignPair(EventLoop** inLoop, EventLoop** outLoop);
@@ -63,5 +102,6 @@ namespace Common
         std::wstring id_;
         std::vector<std::unique_ptr<EventLoop>> pool_;
         uint assignmentIndex_;
+        EventLoopBackend::Enum backend_;
     };
 }
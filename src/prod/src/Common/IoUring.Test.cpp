@@ -0,0 +1,214 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+
+using namespace std;
+
+namespace Common
+{
+    StringLiteral const TraceType("IoUringTest");
+
+    BOOST_AUTO_TEST_SUITE2(IoUringTest)
+
+    namespace
+    {
+        class SocketPair
+        {
+            DENY_COPY(SocketPair);
+
+        public:
+            SocketPair()
+            {
+                int sds[2];
+                Invariant(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sds) == 0);
+                Writer = sds[0];
+                Reader = sds[1];
+            }
+
+            ~SocketPair()
+            {
+                close(Writer);
+                close(Reader);
+            }
+
+            // Reads until "expected" bytes arrived or timeout
+            size_t ReadAll(size_t expected, TimeSpan timeout)
+            {
+                vector<byte> buffer(expected);
+                size_t total = 0;
+                auto stopwatch = Stopwatch::StartNew();
+                while ((total < expected) && (stopwatch.Elapsed < timeout))
+                {
+                    pollfd pfd = { Reader, POLLIN, 0 };
+                    poll(&pfd, 1, 100);
+
+                    auto received = recv(Reader, buffer.data() + total, expected - total, 0);
+                    if (received > 0) total += received;
+                }
+
+                return total;
+            }
+
+            int Writer;
+            int Reader;
+        };
+
+        uint ReapAtLeast(IoUring & ring, uint expected, vector<IoUring::Completion> & reaped)
+        {
+            IoUring::Completion completions[16];
+            auto stopwatch = Stopwatch::StartNew();
+            while ((reaped.size() < expected) && (stopwatch.Elapsed < TimeSpan::FromSeconds(10)))
+            {
+                uint count = 0;
+                VERIFY_IS_TRUE(ring.SubmitAndWait(completions, 16, count).IsSuccess());
+                reaped.insert(reaped.end(), completions, completions + count);
+            }
+
+            return (uint)reaped.size();
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(WritevReadvTest)
+    {
+        ENTER;
+
+        if (!IoUring::IsSupported())
+        {
+            Trace.WriteWarning(TraceType, "io_uring is not supported, skipping");
+            return;
+        }
+
+        IoUring ring;
+        VERIFY_IS_TRUE(ring.Open(8).IsSuccess());
+
+        SocketPair sockets;
+        string payload("io_uring writev/readv round trip");
+        iovec writeIov = { (void*)payload.data(), payload.size() };
+        VERIFY_IS_TRUE(ring.PrepWritev(sockets.Writer, &writeIov, 1, 1));
+
+        vector<IoUring::Completion> reaped;
+        VERIFY_ARE_EQUAL(1u, ReapAtLeast(ring, 1, reaped));
+        VERIFY_ARE_EQUAL(1u, reaped[0].UserData);
+        VERIFY_ARE_EQUAL((int)payload.size(), reaped[0].Result);
+
+        vector<char> received(payload.size());
+        iovec readIov = { received.data(), received.size() };
+        VERIFY_IS_TRUE(ring.PrepReadv(sockets.Reader, &readIov, 1, 2));
+
+        reaped.clear();
+        VERIFY_ARE_EQUAL(1u, ReapAtLeast(ring, 1, reaped));
+        VERIFY_ARE_EQUAL(2u, reaped[0].UserData);
+        VERIFY_ARE_EQUAL((int)payload.size(), reaped[0].Result);
+        VERIFY_IS_TRUE(string(received.begin(), received.end()) == payload);
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(SubmitAndWaitSubmitsWhileCompletionsPendingTest)
+    {
+        ENTER;
+
+        if (!IoUring::IsSupported())
+        {
+            Trace.WriteWarning(TraceType, "io_uring is not supported, skipping");
+            return;
+        }
+
+        IoUring ring;
+        VERIFY_IS_TRUE(ring.Open(8).IsSuccess());
+
+        SocketPair sockets;
+        char data[] = "0123456789";
+        iovec iov = { data, 10 };
+
+        VERIFY_IS_TRUE(ring.PrepWritev(sockets.Writer, &iov, 1, 1));
+        VERIFY_IS_TRUE(ring.PrepWritev(sockets.Writer, &iov, 1, 2));
+
+        // Reap one at a time, so that the completion queue is never empty when the third write is prepared
+        IoUring::Completion completion;
+        uint count = 0;
+        VERIFY_IS_TRUE(ring.SubmitAndWait(&completion, 1, count).IsSuccess());
+        VERIFY_ARE_EQUAL(1u, count);
+
+        VERIFY_IS_TRUE(ring.PrepWritev(sockets.Writer, &iov, 1, 3));
+        VERIFY_IS_TRUE(ring.SubmitAndWait(&completion, 1, count).IsSuccess());
+
+        // The third write must have been submitted without draining the completion queue first
+        VERIFY_ARE_EQUAL((size_t)30, sockets.ReadAll(30, TimeSpan::FromSeconds(10)));
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(ConcurrentSubmitTest)
+    {
+        ENTER;
+
+        if (!IoUring::IsSupported())
+        {
+            Trace.WriteWarning(TraceType, "io_uring is not supported, skipping");
+            return;
+        }
+
+        IoUring ring;
+        VERIFY_IS_TRUE(ring.Open(32).IsSuccess());
+
+        SocketPair sockets;
+        char data = 'x';
+        iovec iov = { &data, 1 };
+
+        int const submitterCount = 4;
+        int const writesPerSubmitter = 200;
+        atomic_long submittersDone(0);
+        ManualResetEvent allSubmitted(false);
+
+        // Submitters race the reaping thread on the submission queue, every entry must complete exactly once
+        for (int submitter = 0; submitter < submitterCount; ++submitter)
+        {
+            Threadpool::Post([&, submitter]
+            {
+                for (int i = 0; i < writesPerSubmitter; ++i)
+                {
+                    while (!ring.PrepWritev(sockets.Writer, &iov, 1, (uint64)(submitter * writesPerSubmitter + i + 1)))
+                    {
+                        ::Sleep(1);
+                    }
+
+                    VERIFY_IS_TRUE(ring.Submit().IsSuccess());
+                }
+
+                if (++submittersDone == submitterCount)
+                {
+                    allSubmitted.Set();
+                }
+            });
+        }
+
+        uint const expected = submitterCount * writesPerSubmitter;
+        vector<IoUring::Completion> reaped;
+        VERIFY_ARE_EQUAL(expected, ReapAtLeast(ring, expected, reaped));
+        VERIFY_IS_TRUE(allSubmitted.WaitOne(TimeSpan::FromSeconds(10)));
+
+        set<uint64> userData;
+        for (auto const & completion : reaped)
+        {
+            VERIFY_ARE_EQUAL(1, completion.Result);
+            userData.insert(completion.UserData);
+        }
+
+        VERIFY_ARE_EQUAL((size_t)expected, userData.size());
+        VERIFY_ARE_EQUAL((size_t)expected, sockets.ReadAll(expected, TimeSpan::FromSeconds(10)));
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,355 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+using namespace Common;
+using namespace std;
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+namespace
+{
+    StringLiteral const TraceType("IoUring");
+
+    int sys_io_uring_setup(uint entries, io_uring_params* params)
+    {
+        return (int)syscall(__NR_io_uring_setup, entries, params);
+    }
+
+    int sys_io_uring_enter(int fd, uint toSubmit, uint minComplete, uint flags)
+    {
+        return (int)syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0);
+    }
+
+    bool ioUringSupported = false;
+    INIT_ONCE probeOnce = INIT_ONCE_STATIC_INIT;
+
+    BOOL CALLBACK ProbeIoUring(PINIT_ONCE, PVOID, PVOID*)
+    {
+        io_uring_params params = {};
+        auto fd = sys_io_uring_setup(2, &params);
+        if (fd < 0)
+        {
+            IoUring::WriteInfo(TraceType, "io_uring is not supported by kernel: errno = {0}", errno);
+            return TRUE;
+        }
+
+        // Single mmap and no-drop completion queue are required, both are available since kernel 5.5
+        ioUringSupported = (params.features & IORING_FEAT_SINGLE_MMAP) && (params.features & IORING_FEAT_NODROP);
+        IoUring::WriteInfo(TraceType, "io_uring features = {0:x}, supported = {1}", params.features, ioUringSupported);
+        close(fd);
+        return TRUE;
+    }
+
+    template <typename T>
+    T* RingOffset(void* base, uint offset)
+    {
+        return reinterpret_cast<T*>(static_cast<byte*>(base) + offset);
+    }
+}
+
+bool IoUring::IsSupported()
+{
+    BOOL bStatus = ::InitOnceExecuteOnce(&probeOnce, ProbeIoUring, nullptr, nullptr);
+    ASSERT_IF(!bStatus, "Failed to probe io_uring support");
+    return ioUringSupported;
+}
+
+IoUring::IoUring() : ringFd_(-1), features_(0), sqeTail_(0)
+{
+}
+
+IoUring::~IoUring()
+{
+    Cleanup();
+}
+
+void IoUring::Cleanup()
+{
+    if (sq_.Sqes)
+    {
+        munmap(sq_.Sqes, sq_.SqesSize);
+        sq_.Sqes = nullptr;
+    }
+
+    if (sq_.Map)
+    {
+        munmap(sq_.Map, sq_.MapSize);
+        sq_.Map = nullptr;
+        cq_.Map = nullptr;
+    }
+
+    if (ringFd_ >= 0)
+    {
+        close(ringFd_);
+        ringFd_ = -1;
+    }
+}
+
+ErrorCode IoUring::Open(uint queueDepth)
+{
+    Invariant(ringFd_ < 0);
+
+    io_uring_params params = {};
+    // completion queue is sized larger than submission queue, as poll, read and write
+    // can all be outstanding on the same descriptor at the same time
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = queueDepth * 4;
+
+    ringFd_ = sys_io_uring_setup(queueDepth, &params);
+    if (ringFd_ < 0)
+    {
+        auto error = ErrorCode::FromErrno();
+        WriteWarning(TraceType, "io_uring_setup({0}) failed: {1}", queueDepth, error);
+        return error;
+    }
+
+    features_ = params.features;
+    if (!(features_ & IORING_FEAT_SINGLE_MMAP))
+    {
+        WriteWarning(TraceType, "IORING_FEAT_SINGLE_MMAP is not supported: features = {0:x}", features_);
+        Cleanup();
+        return ErrorCodeValue::NotImplemented;
+    }
+
+    sq_.MapSize = params.sq_off.array + params.sq_entries * sizeof(uint);
+    cq_.MapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    auto mapSize = std::max(sq_.MapSize, cq_.MapSize);
+
+    sq_.Map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+    if (sq_.Map == MAP_FAILED)
+    {
+        sq_.Map = nullptr;
+        auto error = ErrorCode::FromErrno();
+        WriteWarning(TraceType, "mmap(sq ring) failed: {0}", error);
+        Cleanup();
+        return error;
+    }
+
+    sq_.MapSize = mapSize;
+    cq_.Map = sq_.Map;
+
+    sq_.SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sq_.Sqes = mmap(nullptr, sq_.SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+    if (sq_.Sqes == MAP_FAILED)
+    {
+        sq_.Sqes = nullptr;
+        auto error = ErrorCode::FromErrno();
+        WriteWarning(TraceType, "mmap(sqes) failed: {0}", error);
+        Cleanup();
+        return error;
+    }
+
+    sq_.Head = RingOffset<uint>(sq_.Map, params.sq_off.head);
+    sq_.Tail = RingOffset<uint>(sq_.Map, params.sq_off.tail);
+    sq_.RingMask = RingOffset<uint>(sq_.Map, params.sq_off.ring_mask);
+    sq_.RingEntries = RingOffset<uint>(sq_.Map, params.sq_off.ring_entries);
+    sq_.Array = RingOffset<uint>(sq_.Map, params.sq_off.array);
+    sqeTail_ = *sq_.Tail;
+
+    cq_.Head = RingOffset<uint>(cq_.Map, params.cq_off.head);
+    cq_.Tail = RingOffset<uint>(cq_.Map, params.cq_off.tail);
+    cq_.RingMask = RingOffset<uint>(cq_.Map, params.cq_off.ring_mask);
+    cq_.Cqes = RingOffset<void>(cq_.Map, params.cq_off.cqes);
+
+    WriteInfo(
+        TraceType,
+        "opened: fd = {0}, sq_entries = {1}, cq_entries = {2}, features = {3:x}",
+        ringFd_,
+        params.sq_entries,
+        params.cq_entries,
+        features_);
+
+    return ErrorCode();
+}
+
+uint IoUring::PendingSubmissions_CallerHoldingLock() const
+{
+    return sqeTail_ - __atomic_load_n(sq_.Head, __ATOMIC_ACQUIRE);
+}
+
+void* IoUring::GetSqe_CallerHoldingLock()
+{
+    if (PendingSubmissions_CallerHoldingLock() >= *sq_.RingEntries)
+    {
+        // submission queue is full, let kernel consume what is already queued
+        auto submitted = sys_io_uring_enter(ringFd_, PendingSubmissions_CallerHoldingLock(), 0, 0);
+        if ((submitted <= 0) || (PendingSubmissions_CallerHoldingLock() >= *sq_.RingEntries))
+        {
+            WriteWarning(TraceType, "submission queue full: fd = {0}, io_uring_enter returned {1}, errno = {2}", ringFd_, submitted, errno);
+            return nullptr;
+        }
+    }
+
+    auto index = sqeTail_ & *sq_.RingMask;
+    auto sqe = static_cast<io_uring_sqe*>(sq_.Sqes) + index;
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+}
+
+namespace
+{
+    void PublishSqe(uint* array, uint* tail, uint ringMask, uint & sqeTail)
+    {
+        array[sqeTail & ringMask] = sqeTail & ringMask;
+        ++sqeTail;
+        __atomic_store_n(tail, sqeTail, __ATOMIC_RELEASE);
+    }
+}
+
+bool IoUring::PrepPollAdd(int fd, uint events, uint64 userData)
+{
+    AcquireWriteLock grab(sqLock_);
+
+    auto sqe = static_cast<io_uring_sqe*>(GetSqe_CallerHoldingLock());
+    if (!sqe) return false;
+
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+#ifdef IORING_FEAT_POLL_32BITS
+    sqe->poll32_events = events;
+#else
+    sqe->poll_events = static_cast<uint16>(events);
+#endif
+    sqe->user_data = userData;
+
+    PublishSqe(sq_.Array, sq_.Tail, *sq_.RingMask, sqeTail_);
+    return true;
+}
+
+bool IoUring::PrepReadv(int fd, iovec const * iov, uint iovCount, uint64 userData)
+{
+    AcquireWriteLock grab(sqLock_);
+
+    auto sqe = static_cast<io_uring_sqe*>(GetSqe_CallerHoldingLock());
+    if (!sqe) return false;
+
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64>(iov);
+    sqe->len = iovCount;
+    sqe->user_data = userData;
+
+    PublishSqe(sq_.Array, sq_.Tail, *sq_.RingMask, sqeTail_);
+    return true;
+}
+
+bool IoUring::PrepWritev(int fd, iovec const * iov, uint iovCount, uint64 userData)
+{
+    AcquireWriteLock grab(sqLock_);
+
+    auto sqe = static_cast<io_uring_sqe*>(GetSqe_CallerHoldingLock());
+    if (!sqe) return false;
+
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64>(iov);
+    sqe->len = iovCount;
+    sqe->user_data = userData;
+
+    PublishSqe(sq_.Array, sq_.Tail, *sq_.RingMask, sqeTail_);
+    return true;
+}
+
+bool IoUring::PrepCancel(uint64 targetUserData, uint64 userData)
+{
+    AcquireWriteLock grab(sqLock_);
+
+    auto sqe = static_cast<io_uring_sqe*>(GetSqe_CallerHoldingLock());
+    if (!sqe) return false;
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = targetUserData;
+    sqe->user_data = userData;
+
+    PublishSqe(sq_.Array, sq_.Tail, *sq_.RingMask, sqeTail_);
+    return true;
+}
+
+ErrorCode IoUring::Submit()
+{
+    AcquireWriteLock grab(sqLock_);
+    return Submit_CallerHoldingLock();
+}
+
+ErrorCode IoUring::Submit_CallerHoldingLock()
+{
+    // The kernel consumes entries up to the shared tail during io_uring_enter, so submission
+    // is done with sqLock_ held, otherwise it races with Prep* publishing new entries
+    for(;;)
+    {
+        auto toSubmit = PendingSubmissions_CallerHoldingLock();
+        if (toSubmit == 0) return ErrorCode();
+
+        auto submitted = sys_io_uring_enter(ringFd_, toSubmit, 0, 0);
+        if (submitted > 0) continue;
+
+        if ((submitted < 0) && (errno == EINTR)) continue;
+
+        if ((submitted == 0) || (errno == EAGAIN) || (errno == EBUSY))
+        {
+            // Completion queue is under pressure, entries left pending are flushed by the
+            // next SubmitAndWait on the reaping thread once it has made room
+            WriteNoise(TraceType, "io_uring_enter(submit {0}) deferred: returned {1}", toSubmit, submitted);
+            return ErrorCode();
+        }
+
+        auto error = ErrorCode::FromErrno();
+        WriteWarning(TraceType, "io_uring_enter(submit {0}) failed: {1}", toSubmit, error);
+        return error;
+    }
+}
+
+ErrorCode IoUring::SubmitAndWait(Completion * completions, uint capacity, uint & reaped)
+{
+    reaped = 0;
+
+    // Always flush pending entries first, even when there are completions to reap,
+    // so that I/O prepared by completion callbacks is not held back by a busy ring
+    auto error = Submit();
+    if (!error.IsSuccess())
+    {
+        return error;
+    }
+
+    auto head = *cq_.Head;
+    auto tail = __atomic_load_n(cq_.Tail, __ATOMIC_ACQUIRE);
+    if (head == tail)
+    {
+        // Waiting is done without sqLock_, other threads submit their own entries through Submit
+        auto retval = sys_io_uring_enter(ringFd_, 0, 1, IORING_ENTER_GETEVENTS);
+        if ((retval < 0) && (errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY))
+        {
+            return ErrorCode::FromErrno();
+        }
+
+        tail = __atomic_load_n(cq_.Tail, __ATOMIC_ACQUIRE);
+    }
+
+    auto cqes = static_cast<io_uring_cqe*>(cq_.Cqes);
+    auto mask = *cq_.RingMask;
+    while ((head != tail) && (reaped < capacity))
+    {
+        auto const & cqe = cqes[head & mask];
+        completions[reaped].UserData = cqe.user_data;
+        completions[reaped].Result = cqe.res;
+        ++reaped;
+        ++head;
+    }
+
+    __atomic_store_n(cq_.Head, head, __ATOMIC_RELEASE);
+    return ErrorCode();
+}
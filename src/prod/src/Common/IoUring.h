@@ -0,0 +1,81 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Common
+{
+    // Minimal io_uring wrapper built directly on the system call interface, so that
+    // no liburing dependency is needed. Submission queue access is serialized
+    // internally, completion queue must only be reaped from a single thread.
+    class IoUring : public TextTraceComponent<TraceTaskCodes::Common>
+    {
+        DENY_COPY(IoUring);
+
+    public:
+        struct Completion
+        {
+            uint64 UserData;
+            int Result;
+        };
+
+        IoUring();
+        ~IoUring();
+
+        // Probes kernel support once per process
+        static bool IsSupported();
+
+        ErrorCode Open(uint queueDepth);
+        bool IsOpen() const { return ringFd_ >= 0; }
+
+        bool PrepPollAdd(int fd, uint events, uint64 userData);
+        bool PrepReadv(int fd, iovec const * iov, uint iovCount, uint64 userData);
+        bool PrepWritev(int fd, iovec const * iov, uint iovCount, uint64 userData);
+        bool PrepCancel(uint64 targetUserData, uint64 userData);
+
+        // Submits all prepared entries without waiting, may be called from any thread
+        ErrorCode Submit();
+
+        // Submits all prepared entries, waits for at least one completion and
+        // reaps up to "capacity" completions in a single batch
+        ErrorCode SubmitAndWait(Completion * completions, uint capacity, _Out_ uint & reaped);
+
+    private:
+        struct SubmissionRing
+        {
+            uint * Head = nullptr;
+            uint * Tail = nullptr;
+            uint * RingMask = nullptr;
+            uint * RingEntries = nullptr;
+            uint * Array = nullptr;
+            void * Sqes = nullptr;
+            void * Map = nullptr;
+            size_t MapSize = 0;
+            size_t SqesSize = 0;
+        };
+
+        struct CompletionRing
+        {
+            uint * Head = nullptr;
+            uint * Tail = nullptr;
+            uint * RingMask = nullptr;
+            void * Cqes = nullptr;
+            void * Map = nullptr;
+            size_t MapSize = 0;
+        };
+
+        void * GetSqe_CallerHoldingLock();
+        ErrorCode Submit_CallerHoldingLock();
+        uint PendingSubmissions_CallerHoldingLock() const;
+        void Cleanup();
+
+        RwLock sqLock_;
+        int ringFd_;
+        uint features_;
+        SubmissionRing sq_;
+        CompletionRing cq_;
+        uint sqeTail_;
+    };
+}
@@ -0,0 +1,134 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace std;
+
+namespace Common
+{
+    StringLiteral const TraceType("Lz4Test");
+
+    BOOST_AUTO_TEST_SUITE2(Lz4Test)
+
+    namespace
+    {
+        bool RoundTrip(vector<byte> const & input, size_t & compressedSize)
+        {
+            vector<byte> compressed(Lz4::CompressBound(input.size()));
+            compressedSize = Lz4::Compress(input.data(), input.size(), compressed.data(), compressed.size());
+            if (compressedSize == 0) return false;
+
+            vector<byte> output(input.size());
+            if (!Lz4::Decompress(compressed.data(), compressedSize, output.data(), output.size())) return false;
+
+            return output == input;
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(RoundTripTest)
+    {
+        ENTER;
+
+        Random random(1);
+        for (size_t size : { 0u, 1u, 12u, 13u, 100u, 4096u, 65536u, 65537u, 1024u * 1024u })
+        {
+            vector<byte> repetitive(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                repetitive[i] = (byte)("0123456789abcdef"[i % 16]);
+            }
+
+            vector<byte> sparse(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                sparse[i] = (random.Next(8) == 0)? (byte)random.Next(256) : (byte)'x';
+            }
+
+            vector<byte> noise(size);
+            for (auto & b : noise)
+            {
+                b = (byte)random.Next(256);
+            }
+
+            size_t compressedSize;
+            VERIFY_IS_TRUE(RoundTrip(repetitive, compressedSize));
+            Trace.WriteInfo(TraceType, "repetitive: {0} -> {1}", size, compressedSize);
+            if (size >= 4096)
+            {
+                VERIFY_IS_TRUE(compressedSize < size / 10);
+            }
+
+            VERIFY_IS_TRUE(RoundTrip(sparse, compressedSize));
+            Trace.WriteInfo(TraceType, "sparse: {0} -> {1}", size, compressedSize);
+
+            VERIFY_IS_TRUE(RoundTrip(noise, compressedSize));
+            Trace.WriteInfo(TraceType, "noise: {0} -> {1}", size, compressedSize);
+            VERIFY_IS_TRUE(compressedSize <= Lz4::CompressBound(size));
+        }
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(InsufficientOutputTest)
+    {
+        ENTER;
+
+        Random random(2);
+        vector<byte> noise(4096);
+        for (auto & b : noise)
+        {
+            b = (byte)random.Next(256);
+        }
+
+        vector<byte> compressed(noise.size() / 2);
+        VERIFY_ARE_EQUAL(0u, Lz4::Compress(noise.data(), noise.size(), compressed.data(), compressed.size()));
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(MalformedInputTest)
+    {
+        ENTER;
+
+        string text;
+        for (int i = 0; i < 200; ++i)
+        {
+            text += "service fabric replication operation ";
+        }
+
+        vector<byte> compressed(Lz4::CompressBound(text.size()));
+        auto compressedSize = Lz4::Compress(text.data(), text.size(), compressed.data(), compressed.size());
+        VERIFY_IS_TRUE(compressedSize > 0);
+
+        vector<byte> output(text.size());
+
+        // truncated input
+        VERIFY_IS_FALSE(Lz4::Decompress(compressed.data(), compressedSize - 1, output.data(), output.size()));
+
+        // wrong expected size
+        VERIFY_IS_FALSE(Lz4::Decompress(compressed.data(), compressedSize, output.data(), output.size() - 1));
+
+        // random garbage must not crash
+        Random random(3);
+        for (int i = 0; i < 10000; ++i)
+        {
+            vector<byte> garbage(random.Next(64));
+            for (auto & b : garbage)
+            {
+                b = (byte)random.Next(256);
+            }
+
+            Lz4::Decompress(garbage.data(), garbage.size(), output.data(), random.Next((int)output.size()));
+        }
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
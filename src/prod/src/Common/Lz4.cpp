@@ -0,0 +1,243 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Common;
+
+namespace
+{
+    const size_t MinMatch = 4;
+    // The last match must start at least 12 bytes before end of block, and
+    // the last 5 bytes of a block are always literals
+    const size_t MatchFindLimit = 12;
+    const size_t LastLiterals = 5;
+    const size_t MaxDistance = 65535;
+    const uint HashLog = 12;
+    const uint SkipTrigger = 6;
+
+    inline uint32 Read32(byte const * p)
+    {
+        uint32 value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint Hash(uint32 sequence)
+    {
+        return (sequence * 2654435761U) >> (32 - HashLog);
+    }
+
+    inline size_t LengthExtensionBytes(size_t length)
+    {
+        return (length >= 15)? ((length - 15) / 255 + 1) : 0;
+    }
+
+    inline byte* WriteLengthExtension(byte* op, size_t length)
+    {
+        length -= 15;
+        while (length >= 255)
+        {
+            *op++ = 255;
+            length -= 255;
+        }
+
+        *op++ = (byte)length;
+        return op;
+    }
+
+    inline bool ReadLengthExtension(byte const * & ip, byte const * iend, size_t & length)
+    {
+        byte b;
+        do
+        {
+            if (ip >= iend) return false;
+
+            b = *ip++;
+            length += b;
+        } while (b == 255);
+
+        return true;
+    }
+
+    // Emit one sequence: token, literals and, if matchLength is not 0, offset and match length
+    byte* WriteSequence(
+        byte* op,
+        byte* oend,
+        byte const * literals,
+        size_t literalLength,
+        size_t offset,
+        size_t matchLength)
+    {
+        size_t matchCode = matchLength? (matchLength - MinMatch) : 0;
+        size_t required =
+            1 + LengthExtensionBytes(literalLength) + literalLength +
+            (matchLength? (2 + LengthExtensionBytes(matchCode)) : 0);
+
+        if ((size_t)(oend - op) < required) return nullptr;
+
+        byte* token = op++;
+        *token = (byte)(std::min<size_t>(literalLength, 15) << 4);
+        if (literalLength >= 15)
+        {
+            op = WriteLengthExtension(op, literalLength);
+        }
+
+        if (literalLength > 0)
+        {
+            memcpy(op, literals, literalLength);
+            op += literalLength;
+        }
+
+        if (!matchLength) return op;
+
+        *op++ = (byte)offset;
+        *op++ = (byte)(offset >> 8);
+
+        *token |= (byte)std::min<size_t>(matchCode, 15);
+        if (matchCode >= 15)
+        {
+            op = WriteLengthExtension(op, matchCode);
+        }
+
+        return op;
+    }
+}
+
+size_t Lz4::Compress(void const * src, size_t srcSize, void * dst, size_t dstCapacity)
+{
+    auto const istart = static_cast<byte const *>(src);
+    auto const iend = istart + srcSize;
+    auto const ostart = static_cast<byte*>(dst);
+    auto const oend = ostart + dstCapacity;
+
+    byte const * ip = istart;
+    byte const * anchor = istart;
+    byte* op = ostart;
+
+    if (srcSize > MatchFindLimit)
+    {
+        // offsets into src, 0 is a valid initial value as candidate matches are always verified
+        uint32 hashTable[1 << HashLog] = {};
+
+        auto const mflimit = iend - MatchFindLimit;
+        auto const matchlimit = iend - LastLiterals;
+
+        hashTable[Hash(Read32(ip))] = 0;
+        ++ip;
+
+        for(;;)
+        {
+            // find a match, step size grows as we fail to find matches in incompressible data
+            byte const * ref = nullptr;
+            uint searchCount = 1 << SkipTrigger;
+            for (;;)
+            {
+                if (ip >= mflimit) break;
+
+                auto h = Hash(Read32(ip));
+                ref = istart + hashTable[h];
+                hashTable[h] = (uint32)(ip - istart);
+                if ((ref < ip) && ((size_t)(ip - ref) <= MaxDistance) && (Read32(ref) == Read32(ip)))
+                {
+                    break;
+                }
+
+                ip += (searchCount++ >> SkipTrigger);
+                ref = nullptr;
+            }
+
+            if (!ref) break;
+
+            // extend backward
+            while ((ip > anchor) && (ref > istart) && (ip[-1] == ref[-1]))
+            {
+                --ip;
+                --ref;
+            }
+
+            // extend forward
+            size_t matchLength = MinMatch;
+            while (((ip + matchLength) < matchlimit) && (ip[matchLength] == ref[matchLength]))
+            {
+                ++matchLength;
+            }
+
+            op = WriteSequence(op, oend, anchor, ip - anchor, ip - ref, matchLength);
+            if (!op) return 0;
+
+            ip += matchLength;
+            anchor = ip;
+
+            if (ip >= mflimit) break;
+
+            // keep table current with the position just before the next search
+            hashTable[Hash(Read32(ip - 2))] = (uint32)(ip - 2 - istart);
+        }
+    }
+
+    op = WriteSequence(op, oend, anchor, iend - anchor, 0, 0);
+    if (!op) return 0;
+
+    return op - ostart;
+}
+
+bool Lz4::Decompress(void const * src, size_t srcSize, void * dst, size_t dstSize)
+{
+    auto ip = static_cast<byte const *>(src);
+    auto const iend = ip + srcSize;
+    auto const ostart = static_cast<byte*>(dst);
+    auto const oend = ostart + dstSize;
+    byte* op = ostart;
+
+    while (ip < iend)
+    {
+        auto token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if ((literalLength == 15) && !ReadLengthExtension(ip, iend, literalLength)) return false;
+
+        if ((literalLength > (size_t)(iend - ip)) || (literalLength > (size_t)(oend - op))) return false;
+
+        if (literalLength > 0)
+        {
+            memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+        }
+
+        // the last sequence has no match part
+        if (ip == iend) break;
+
+        if ((iend - ip) < 2) return false;
+
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if ((offset == 0) || (offset > (size_t)(op - ostart))) return false;
+
+        size_t matchLength = token & 15;
+        if ((matchLength == 15) && !ReadLengthExtension(ip, iend, matchLength)) return false;
+
+        matchLength += MinMatch;
+        if (matchLength > (size_t)(oend - op)) return false;
+
+        byte const * match = op - offset;
+        if (offset >= matchLength)
+        {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+        }
+        else
+        {
+            // overlapping copy replicates the pattern
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    return op == oend;
+}
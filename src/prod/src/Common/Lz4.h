@@ -0,0 +1,37 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+// Compressor and decompressor for the LZ4 block format:
+// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+
+#pragma once
+
+namespace Common
+{
+    class Lz4
+    {
+    public:
+        // Worst case compressed size for inputSize bytes of incompressible data
+        static size_t CompressBound(size_t inputSize)
+        {
+            return inputSize + (inputSize / 255) + 16;
+        }
+
+        // Returns compressed size, or 0 if output does not fit in dstCapacity,
+        // callers should send the input uncompressed in that case
+        static size_t Compress(
+            __in_bcount(srcSize) void const * src,
+            size_t srcSize,
+            __out_bcount(dstCapacity) void * dst,
+            size_t dstCapacity);
+
+        // Decompression must produce exactly dstSize bytes, malformed input is
+        // detected and reported as failure without reading or writing out of bounds
+        static bool Decompress(
+            __in_bcount(srcSize) void const * src,
+            size_t srcSize,
+            __out_bcount(dstSize) void * dst,
+            size_t dstSize);
+    };
+}
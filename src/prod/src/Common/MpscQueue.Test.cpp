@@ -0,0 +1,113 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace std;
+
+namespace Common
+{
+    BOOST_AUTO_TEST_SUITE2(MpscQueueTest)
+
+    namespace
+    {
+        struct IntrusiveItem
+        {
+            IntrusiveItem(int producer, int sequence) : Producer(producer), Sequence(sequence)
+            {
+            }
+
+            int Producer;
+            int Sequence;
+            IntrusiveItem * Next = nullptr;
+        };
+    }
+
+    BOOST_AUTO_TEST_CASE(IntrusiveOrderTest)
+    {
+        ENTER;
+
+        IntrusiveMpscQueue<IntrusiveItem, &IntrusiveItem::Next> queue;
+        VERIFY_IS_TRUE(queue.Empty());
+
+        for (int i = 0; i < 10; ++i)
+        {
+            queue.Push(make_unique<IntrusiveItem>(0, i));
+        }
+
+        VERIFY_IS_FALSE(queue.Empty());
+
+        int expected = 0;
+        auto count = queue.Drain([&expected](unique_ptr<IntrusiveItem> && item)
+        {
+            VERIFY_IS_TRUE(item->Next == nullptr);
+            VERIFY_ARE_EQUAL(expected, item->Sequence);
+            ++expected;
+        });
+
+        VERIFY_ARE_EQUAL(10u, count);
+        VERIFY_IS_TRUE(queue.Empty());
+        VERIFY_ARE_EQUAL(0u, queue.Drain([](unique_ptr<IntrusiveItem> &&) {}));
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(IntrusiveConcurrentProducersTest)
+    {
+        ENTER;
+
+        int const producerCount = 8;
+        int const itemsPerProducer = 20000;
+
+        IntrusiveMpscQueue<IntrusiveItem, &IntrusiveItem::Next> queue;
+        VERIFY_IS_TRUE(queue.Empty());
+
+        atomic_long producersDone(0);
+        ManualResetEvent allDone(false);
+
+        for (int producer = 0; producer < producerCount; ++producer)
+        {
+            Threadpool::Post([&queue, &producersDone, &allDone, producer, itemsPerProducer, producerCount]
+            {
+                for (int i = 0; i < itemsPerProducer; ++i)
+                {
+                    queue.Push(make_unique<IntrusiveItem>(producer, i));
+                }
+
+                if (++producersDone == producerCount)
+                {
+                    allDone.Set();
+                }
+            });
+        }
+
+        // each producer's items must be consumed exactly once, in push order and unlinked
+        vector<int> next(producerCount, 0);
+        size_t consumed = 0;
+        bool producing = true;
+        while (producing || !queue.Empty())
+        {
+            producing = !allDone.WaitOne(TimeSpan::Zero);
+            consumed += queue.Drain([&next](unique_ptr<IntrusiveItem> && item)
+            {
+                VERIFY_IS_TRUE(item->Next == nullptr);
+                VERIFY_ARE_EQUAL(next[item->Producer], item->Sequence);
+                ++next[item->Producer];
+            });
+        }
+
+        VERIFY_ARE_EQUAL((size_t)(producerCount * itemsPerProducer), consumed);
+
+        // items left in queue are released on destruction
+        queue.Push(make_unique<IntrusiveItem>(0, 0));
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,79 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Common
+{
+    // Lock-free multi-producer/single-consumer queue of owned items linked through a member of T,
+    // so Push does not allocate. Producers push with a single CAS on the list head. The consumer
+    // detaches the whole list with one exchange and reverses it, so items pushed by the same producer
+    // are consumed in push order. Producers only push and the consumer only detaches the whole list,
+    // so the list head is not subject to ABA. An item belongs to the queue between Push and Drain,
+    // and can be in at most one queue at a time.
+    // Only one thread may call Drain at a time, callers are responsible for electing it.
+    template <typename T, T * T::*Next>
+    class IntrusiveMpscQueue
+    {
+        DENY_COPY(IntrusiveMpscQueue);
+
+    public:
+        IntrusiveMpscQueue()
+        {
+        }
+
+        ~IntrusiveMpscQueue()
+        {
+            Drain([](std::unique_ptr<T> &&) {});
+        }
+
+        void Push(std::unique_ptr<T> && item)
+        {
+            auto node = item.release();
+            auto head = head_.load(std::memory_order_relaxed);
+            do
+            {
+                node->*Next = head;
+            } while (!head_.compare_exchange_weak(head, node, std::memory_order_seq_cst, std::memory_order_relaxed));
+        }
+
+        bool Empty() const
+        {
+            return head_.load(std::memory_order_seq_cst) == nullptr;
+        }
+
+        // Invokes consumer on every item pushed so far, in push order, returns number of items consumed
+        template <typename TConsumer>
+        size_t Drain(TConsumer const & consumer)
+        {
+            auto node = head_.exchange(nullptr, std::memory_order_seq_cst);
+            if (node == nullptr) return 0;
+
+            T * reversed = nullptr;
+            while (node != nullptr)
+            {
+                auto next = node->*Next;
+                node->*Next = reversed;
+                reversed = node;
+                node = next;
+            }
+
+            size_t count = 0;
+            while (reversed != nullptr)
+            {
+                std::unique_ptr<T> current(reversed);
+                reversed = current.get()->*Next;
+                current.get()->*Next = nullptr;
+                consumer(std::move(current));
+                ++count;
+            }
+
+            return count;
+        }
+
+    private:
+        std::atomic<T*> head_{nullptr};
+    };
+}
@@ -0,0 +1,381 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+using namespace Common;
+using namespace std;
+
+namespace Common
+{
+    StringLiteral const TraceType("ShardedJobQueueTest");
+
+    class ShardedJobQueueTest
+    {
+    };
+
+    class ShardedJobRoot : public ComponentRoot
+    {
+    public:
+        explicit ShardedJobRoot(size_t expectedItems)
+            : expectedItems_(expectedItems)
+            , processedCount_(0)
+            , closedCount_(0)
+            , queueFullCount_(0)
+            , inSynchronizedProcess_(false)
+            , concurrentSynchronizedProcess_(false)
+            , allProcessed_(false)
+        {
+        }
+
+        __declspec(property(get = get_ProcessedItems)) vector<int> const& ProcessedItems;
+        vector<int> const& get_ProcessedItems() { return processedItems_; }
+
+        void AddProcessedItem(int item)
+        {
+            AcquireWriteLock lock(lock_);
+
+            processedItems_.push_back(item);
+        }
+
+        void OnProcessed()
+        {
+            if (++processedCount_ == expectedItems_)
+            {
+                allProcessed_.Set();
+            }
+        }
+
+        void Reset(size_t expectedItems)
+        {
+            expectedItems_ = expectedItems;
+            processedCount_ = 0;
+            allProcessed_.Reset();
+        }
+
+        bool WaitForAllProcessed()
+        {
+            return allProcessed_.WaitOne(TimeSpan::FromSeconds(60));
+        }
+
+        size_t expectedItems_;
+        atomic<uint64> processedCount_;
+        atomic<uint64> closedCount_;
+        atomic_long queueFullCount_;
+        atomic_bool inSynchronizedProcess_;
+        atomic_bool concurrentSynchronizedProcess_;
+
+    private:
+        ManualResetEvent allProcessed_;
+        RWLOCK(ShardedJobQueueTest, lock_);
+        vector<int> processedItems_;
+    };
+
+    class ShardedTestJobItem
+    {
+    public:
+        ShardedTestJobItem()
+            : owner_(nullptr)
+            , itemNumber_(0)
+        {
+        }
+
+        ShardedTestJobItem(
+            ShardedJobRoot & owner,
+            int itemNumber,
+            shared_ptr<ManualResetEvent> const & processingStartedEvent = nullptr,
+            shared_ptr<ManualResetEvent> const & blockJobProcessingEvent = nullptr)
+            : owner_(&owner)
+            , itemNumber_(itemNumber)
+            , processingStartedEvent_(processingStartedEvent)
+            , blockJobProcessingEvent_(blockJobProcessingEvent)
+        {
+        }
+
+        bool ProcessJob(ShardedJobRoot &)
+        {
+            if (processingStartedEvent_)
+            {
+                processingStartedEvent_->Set();
+            }
+
+            if (blockJobProcessingEvent_)
+            {
+                blockJobProcessingEvent_->WaitOne();
+            }
+
+            if (itemNumber_ > 0)
+            {
+                owner_->AddProcessedItem(itemNumber_);
+            }
+
+            owner_->OnProcessed();
+            return true;
+        }
+
+        void SynchronizedProcess(ShardedJobRoot & root)
+        {
+            if (root.inSynchronizedProcess_.exchange(true))
+            {
+                root.concurrentSynchronizedProcess_ = true;
+            }
+
+            root.inSynchronizedProcess_ = false;
+        }
+
+        void Close(ShardedJobRoot & root)
+        {
+            ++root.closedCount_;
+        }
+
+        void OnQueueFull(ShardedJobRoot & root, size_t)
+        {
+            ++root.queueFullCount_;
+        }
+
+    private:
+        ShardedJobRoot * owner_;
+        int itemNumber_;
+        shared_ptr<ManualResetEvent> processingStartedEvent_;
+        shared_ptr<ManualResetEvent> blockJobProcessingEvent_;
+    };
+
+    class TestShardedJobQueue : public ShardedJobQueue<ShardedTestJobItem, ShardedJobRoot>
+    {
+    public:
+        TestShardedJobQueue(ShardedJobRoot & root, int maxThreads, uint64 maxQueueSize = UINT64_MAX, DequePolicy dequePolicy = DequePolicy::FifoLifo)
+            : ShardedJobQueue(L"TestShardedJobQueue", root, false, maxThreads, nullptr, maxQueueSize, dequePolicy)
+            , finishedItems_(false)
+        {
+        }
+
+        void OnFinishItems() override
+        {
+            finishedItems_.Set();
+        }
+
+        bool WaitForFinishItems()
+        {
+            return finishedItems_.WaitOne(TimeSpan::FromSeconds(60));
+        }
+
+    private:
+        ManualResetEvent finishedItems_;
+    };
+
+    template <typename TQueueBase>
+    class BenchmarkJobQueue : public TQueueBase
+    {
+    public:
+        explicit BenchmarkJobQueue(ShardedJobRoot & root)
+            : TQueueBase(L"EnqueueBenchmark", root)
+            , finishedItems_(false)
+        {
+        }
+
+        void OnFinishItems() override
+        {
+            finishedItems_.Set();
+        }
+
+        bool WaitForFinishItems()
+        {
+            return finishedItems_.WaitOne(TimeSpan::FromSeconds(60));
+        }
+
+    private:
+        ManualResetEvent finishedItems_;
+    };
+
+    template <typename TQueueBase>
+    double MeasureEnqueueThroughput(int producerCount, int itemsPerProducer)
+    {
+        auto root = make_shared<ShardedJobRoot>(producerCount * itemsPerProducer);
+        BenchmarkJobQueue<TQueueBase> queue(*root);
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        vector<thread> producers;
+        for (int i = 0; i < producerCount; ++i)
+        {
+            producers.push_back(thread([&queue, &root, itemsPerProducer]()
+            {
+                for (int j = 0; j < itemsPerProducer; ++j)
+                {
+                    queue.Enqueue(ShardedTestJobItem(*root, 0));
+                }
+            }));
+        }
+
+        for (auto & producer : producers)
+        {
+            producer.join();
+        }
+
+        VERIFY_IS_TRUE(root->WaitForAllProcessed());
+        stopwatch.Stop();
+
+        queue.Close();
+        VERIFY_IS_TRUE(queue.WaitForFinishItems());
+
+        return (producerCount * itemsPerProducer) / (stopwatch.Elapsed.TotalMillisecondsAsDouble() / 1000);
+    }
+
+    //
+    // TEST METHODS
+    //
+    BOOST_FIXTURE_TEST_SUITE(ShardedJobQueueTestSuite, ShardedJobQueueTest)
+
+    BOOST_AUTO_TEST_CASE(ShardedQueueFullTest)
+    {
+        auto root = make_shared<ShardedJobRoot>(6);
+        TestShardedJobQueue jobQueue(*root, 1, 5);
+
+        auto processingStarted = make_shared<ManualResetEvent>(false);
+        auto processingBlocked = make_shared<ManualResetEvent>(false);
+        VERIFY_IS_TRUE(jobQueue.Enqueue(ShardedTestJobItem(*root, 0, processingStarted, processingBlocked)));
+
+        //
+        // Wait for the job queue thread pickup the first job and block, so that additional items get queued in the jobqueue
+        //
+        processingStarted->WaitOne();
+
+        int enqueueFailures = 0;
+        for (int i = 1; i < 10; ++i)
+        {
+            if (!jobQueue.Enqueue(ShardedTestJobItem(*root, 0)))
+            {
+                ++enqueueFailures;
+            }
+        }
+
+        VERIFY_ARE_EQUAL(4, enqueueFailures);
+        VERIFY_ARE_EQUAL(4L, root->queueFullCount_.load());
+        VERIFY_ARE_EQUAL(static_cast<uint64>(5), jobQueue.GetQueueLength());
+
+        processingBlocked->Set();
+        VERIFY_IS_TRUE(root->WaitForAllProcessed());
+
+        jobQueue.Close();
+        VERIFY_IS_TRUE(jobQueue.WaitForFinishItems());
+        VERIFY_ARE_EQUAL(static_cast<uint64>(6), root->closedCount_.load());
+    }
+
+    BOOST_AUTO_TEST_CASE(ShardedFifoLifoTest)
+    {
+        auto root = make_shared<ShardedJobRoot>(6);
+        TestShardedJobQueue jobQueue(*root, 1, 5, DequePolicy::FifoLifo);
+
+        //
+        // A single processing thread uses a single shard, so the processing order is the same as JobQueue
+        //
+        VERIFY_ARE_EQUAL(1u, jobQueue.GetShardCount());
+
+        auto processingStarted = make_shared<ManualResetEvent>(false);
+        auto processingBlocked = make_shared<ManualResetEvent>(false);
+
+        int numberOfEnqueuedItems = 0;
+        VERIFY_IS_TRUE(jobQueue.Enqueue(ShardedTestJobItem(*root, ++numberOfEnqueuedItems, processingStarted, processingBlocked)));
+        processingStarted->WaitOne();
+
+        for (int i = 0; i < 10; i++)
+        {
+            if (jobQueue.Enqueue(ShardedTestJobItem(*root, numberOfEnqueuedItems + 1)))
+            {
+                numberOfEnqueuedItems++;
+            }
+        }
+
+        processingBlocked->Set();
+        VERIFY_IS_TRUE(root->WaitForAllProcessed());
+
+        // The queue was full, so the items are processed Lifo
+        VERIFY_ARE_EQUAL(wformatString(root->ProcessedItems), L"(1 6 5 4 3 2)");
+
+        root->Reset(4);
+        processingStarted->Reset();
+        processingBlocked->Reset();
+
+        VERIFY_IS_TRUE(jobQueue.Enqueue(ShardedTestJobItem(*root, ++numberOfEnqueuedItems, processingStarted, processingBlocked)));
+        processingStarted->WaitOne();
+
+        for (int i = 0; i < 3; i++)
+        {
+            VERIFY_IS_TRUE(jobQueue.Enqueue(ShardedTestJobItem(*root, ++numberOfEnqueuedItems)));
+        }
+
+        processingBlocked->Set();
+        VERIFY_IS_TRUE(root->WaitForAllProcessed());
+
+        // The queue was emptied in between, so the processing order goes back to Fifo
+        VERIFY_ARE_EQUAL(wformatString(root->ProcessedItems), L"(1 6 5 4 3 2 7 8 9 10)");
+
+        jobQueue.Close();
+    }
+
+    BOOST_AUTO_TEST_CASE(ShardedManyProducersTest)
+    {
+        int const producerCount = 16;
+        int const itemsPerProducer = 10000;
+        int const maxThreads = 8;
+
+        auto root = make_shared<ShardedJobRoot>(producerCount * itemsPerProducer);
+        TestShardedJobQueue jobQueue(*root, maxThreads);
+
+        vector<thread> producers;
+        for (int i = 0; i < producerCount; ++i)
+        {
+            producers.push_back(thread([&jobQueue, &root]()
+            {
+                for (int j = 0; j < itemsPerProducer; ++j)
+                {
+                    VERIFY_IS_TRUE(jobQueue.Enqueue(ShardedTestJobItem(*root, 0)));
+                }
+            }));
+        }
+
+        for (auto & producer : producers)
+        {
+            producer.join();
+        }
+
+        VERIFY_IS_TRUE(root->WaitForAllProcessed());
+
+        jobQueue.Close();
+        VERIFY_IS_TRUE(jobQueue.WaitForFinishItems());
+
+        VERIFY_ARE_EQUAL(static_cast<uint64>(producerCount * itemsPerProducer), root->closedCount_.load());
+        VERIFY_ARE_EQUAL(static_cast<uint64>(0), jobQueue.GetQueueLength());
+        VERIFY_IS_FALSE(root->concurrentSynchronizedProcess_.load());
+        VERIFY_IS_TRUE(jobQueue.Test_HighestActiveThreads <= maxThreads);
+
+        // Enqueue is rejected after close
+        VERIFY_IS_FALSE(jobQueue.Enqueue(ShardedTestJobItem(*root, 0)));
+    }
+
+    BOOST_AUTO_TEST_CASE(EnqueueThroughputBenchmark)
+    {
+        int const totalItems = 400000;
+
+        for (int producerCount : { 1, 4, 16, 64 })
+        {
+            auto jobQueueRate = MeasureEnqueueThroughput<JobQueue<ShardedTestJobItem, ShardedJobRoot>>(producerCount, totalItems / producerCount);
+            auto shardedRate = MeasureEnqueueThroughput<ShardedJobQueue<ShardedTestJobItem, ShardedJobRoot>>(producerCount, totalItems / producerCount);
+
+            Trace.WriteInfo(
+                TraceType,
+                "producers={0}: JobQueue {1} items/sec, ShardedJobQueue {2} items/sec",
+                producerCount,
+                static_cast<int64>(jobQueueRate),
+                static_cast<int64>(shardedRate));
+        }
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
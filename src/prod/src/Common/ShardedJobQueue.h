@@ -0,0 +1,712 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Common
+{
+    //
+    // JobQueue variant for queues with many concurrent producers.
+    //
+    // JobQueue takes one write lock for every Enqueue and for every item dequeued by its
+    // processing threads. ShardedJobQueue splits the items over several shards, each with
+    // its own lock, and keeps the processing thread count and the close state in a single
+    // atomic word, so producers and processing threads only meet on a shard lock.
+    // Producers pick a shard based on the calling thread, processing threads start with
+    // their own shard and take items from the other shards when it is empty.
+    //
+    // Job items follow the same contract as JobQueue (ProcessJob, SynchronizedProcess,
+    // Close, UpdatePerfCounter and OnQueueFull). The differences are:
+    //
+    //  - DequePolicy is applied per shard. By default there is one shard per processing
+    //    thread, so a queue with a single processing thread has exactly the ordering of
+    //    JobQueue. With more threads, items already complete out of order in JobQueue.
+    //  - SynchronizedProcess calls are serialized with each other, but not with Enqueue.
+    //  - NeedThrottle/Resume based throttling is not supported, use JobQueue for
+    //    job items that need it.
+    //
+    template <typename T, typename R>
+    class ShardedJobQueue
+    {
+        DENY_COPY(ShardedJobQueue);
+
+    public:
+        ShardedJobQueue(
+            std::wstring const & name,
+            R & root,
+            bool forceEnqueue = false,
+            int maxThreads = 0,
+            JobQueuePerfCountersSPtr perfCounters = nullptr,
+            uint64 maxQueueSize = UINT64_MAX,
+            DequePolicy dequePolicy = DequePolicy::FifoLifo,
+            int shardCount = 0)
+            :   root_(root),
+                name_(name),
+                maxThreads_(maxThreads),
+                state_(0),
+                highestActiveThreads_(0),
+                completed_(0),
+                queuedItems_(0),
+                nextThreadShard_(0),
+                forceEnqueue_(forceEnqueue),
+                extraTracingEnabled_(false),
+                traceProcessingThreads_(false),
+                asyncJobs_(false),
+                finishedItems_(false),
+                perfCounters_(perfCounters),
+                maxQueueSize_(maxQueueSize),
+                dequePolicy_(dequePolicy),
+                isFifo_(dequePolicy != DequePolicy::Lifo)
+        {
+            rootSPtr_ = CreateComponentRoot();
+
+            if (maxThreads_ == 0)
+            {
+                maxThreads_ = Environment::GetNumberOfProcessors();
+            }
+
+            if (shardCount <= 0)
+            {
+                shardCount = std::min(maxThreads_.load(), static_cast<int>(Environment::GetNumberOfProcessors()));
+            }
+
+            for (int i = 0; i < std::max(shardCount, 1); ++i)
+            {
+                shards_.push_back(make_unique<Shard>());
+            }
+
+            Trace.WriteInfo("JobQueue", name_, "Sharded queue created MaxThreads {0} Shards {1}", maxThreads_.load(), shards_.size());
+        }
+
+        virtual ~ShardedJobQueue()
+        {
+            ASSERT_IF(GetActiveThreads() != 0,
+                "{0} has {1} active thread during destruction",
+                name_, GetActiveThreads());
+            Trace.WriteInfo("JobQueue", name_, "Sharded queue destructed, highest threads={0}", highestActiveThreads_.load());
+        }
+
+        int GetMaxThreads()
+        {
+            return maxThreads_;
+        }
+
+        uint64 GetQueueLength()
+        {
+            uint64 length = 0;
+            for (auto const & shard : shards_)
+            {
+                length += shard->Count.load();
+            }
+
+            return length;
+        }
+
+        uint64 GetActiveThreads()
+        {
+            return static_cast<uint64>(state_.load() & ActiveThreadsMask);
+        }
+
+        uint GetCompleted()
+        {
+            return completed_;
+        }
+
+        size_t GetShardCount() const
+        {
+            return shards_.size();
+        }
+
+        void SetExtraTracing(bool enable)
+        {
+            extraTracingEnabled_ = enable;
+            traceProcessingThreads_ = enable;
+        }
+
+        void SetTraceProcessingThreads(bool enable)
+        {
+            traceProcessingThreads_ = enable;
+        }
+
+        void SetAsyncJobs(bool enable)
+        {
+            Trace.WriteInfo(
+                "JobQueue",
+                name_,
+                "SetAsyncJobs={0}",
+                enable);
+
+            asyncJobs_ = enable;
+        }
+
+        void Test_ResetHighestActiveThreads()
+        {
+            highestActiveThreads_ = 0;
+        }
+
+        void UpdateMaxThreads(int maxThreads)
+        {
+            Trace.WriteInfo(
+                "JobQueue",
+                name_,
+                "UpdateMaxThreads: old = {0} new = {1}",
+                maxThreads_.load(),
+                maxThreads);
+
+            maxThreads_ = maxThreads;
+        }
+
+        ComponentRootSPtr CreateComponentRoot()
+        {
+            __if_exists (R::CreateComponentRoot)
+            {
+                return root_.CreateComponentRoot();
+            }
+            __if_not_exists (R::CreateComponentRoot)
+            {
+                return root_.Root.CreateComponentRoot();
+            }
+        }
+
+        virtual void Close()
+        {
+            auto state = state_.fetch_or(ClosedFlag);
+            if ((state & ClosedFlag) != 0)
+            {
+                return;
+            }
+
+            if ((state & ActiveThreadsMask) == 0)
+            {
+                CompleteClose(L"Close()");
+            }
+            else
+            {
+                Trace.WriteInfo("JobQueue", name_, "Close called, {0} active threads, {1} queued items", state & ActiveThreadsMask, GetQueueLength());
+            }
+        }
+
+        // Same as JobQueue::OnFinishItems
+        virtual void OnFinishItems()
+        {
+        }
+
+        bool Enqueue(T && item)
+        {
+            return Enqueue(item, false);
+        }
+
+        bool Reserve(T & item)
+        {
+            TESTASSERT_IF(
+                maxQueueSize_ != UINT64_MAX,
+                "Enqueue can fail because of size limit and callers of Reserve() currently dont handle that");
+
+            return Enqueue(item, true);
+        }
+
+        void CancelReserve()
+        {
+            bool completeClose;
+            if (ReleaseThread(completeClose))
+            {
+                ScheduleThread();
+            }
+
+            if (completeClose)
+            {
+                CompleteClose(L"CancelReserve()");
+            }
+        }
+
+        void CompleteAsyncJob()
+        {
+            if (!asyncJobs_)
+            {
+                TRACE_LEVEL_AND_TESTASSERT(Trace.WriteError, "JobQueue", "{0} CompleteAsyncJob, async jobs not enabled", name_);
+
+                return;
+            }
+
+            completed_++;
+
+            bool completeClose;
+            if (ReleaseThread(completeClose))
+            {
+                ScheduleThread();
+            }
+
+            if (completeClose)
+            {
+                CompleteClose(L"CompleteAsyncJob()");
+            }
+        }
+
+        __declspec (property(get=get_Name)) std::wstring const & Name;
+        std::wstring const & get_Name() { return name_; }
+
+        __declspec (property(get=get_HighestThreads)) int Test_HighestActiveThreads;
+        int get_HighestThreads() { return highestActiveThreads_; }
+
+    protected:
+        R & root_;
+
+        bool Enqueue(T & item, bool isReserve)
+        {
+            if (!forceEnqueue_ && (state_.load() & ClosedFlag) != 0)
+            {
+                return false;
+            }
+
+            if (extraTracingEnabled_)
+            {
+                Trace.WriteInfo(
+                    "JobQueue", name_,
+                    "Enqueue: activeThreads_ = {0}, maxThreads_ = {1}, queue size = {2}",
+                    GetActiveThreads(), maxThreads_.load(), GetQueueLength());
+            }
+
+            if (isReserve && TryClaimThread(false))
+            {
+                return true;
+            }
+
+            if (!TryReserveQueueSlot())
+            {
+                if (dequePolicy_ == DequePolicy::FifoLifo)
+                {
+                    isFifo_ = false;
+                }
+
+                if (perfCounters_)
+                {
+                    perfCounters_->NumberOfDroppedItems.Increment();
+                }
+
+                callOnQueueFull(item);
+
+                // If isReserve is true, return true to indicate that the item wasnt queued and so the current
+                // thread can be used to process that item if the higher layer wants.
+                return isReserve;
+            }
+
+            auto & shard = *shards_[GetCurrentThreadId() % shards_.size()];
+            {
+                AcquireExclusiveLock grab(shard.Lock);
+                shard.Items.push_back(std::move(item));
+                ++shard.Count;
+            }
+
+            if (perfCounters_)
+            {
+                perfCounters_->NumberOfItems.Increment();
+                perfCounters_->NumberOfItemsInsertedPerSecond.Increment();
+            }
+
+            // Either a new thread is scheduled for the item, or all thread slots are taken and
+            // PendingFlag makes one of the running threads look at the shards again before it exits.
+            if (TryClaimThread(true))
+            {
+                ScheduleThread();
+            }
+
+            return !isReserve;
+        }
+
+        void Process(size_t shardIndex)
+        {
+            int crtThread = GetCurrentThreadId();
+
+            if (traceProcessingThreads_)
+            {
+                CommonEventSource::Events->JobQueueEnterProcess(name_, crtThread);
+            }
+
+            T currentItem;
+            bool completeClose = false;
+            bool isAsync = false;
+
+            for (;;)
+            {
+                if (!TryDequeue(currentItem, shardIndex))
+                {
+                    if (ReleaseThread(completeClose))
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                if (perfCounters_)
+                {
+                    JobTraits<T>::UpdatePerfCounter(currentItem, *perfCounters_);
+                }
+
+                JobTraits<T>::ProcessJob(currentItem, root_);
+
+                if (asyncJobs_)
+                {
+                    // ProcessJob() is performing async work when async jobs are enabled, the thread
+                    // slot is released by CompleteAsyncJob() when the async job completes.
+                    isAsync = true;
+                    break;
+                }
+
+                {
+                    AcquireExclusiveLock grab(synchronizedProcessLock_);
+                    JobTraits<T>::SynchronizedProcess(currentItem, root_);
+                }
+
+                completed_++;
+                JobTraits<T>::Close(currentItem, root_);
+            }
+
+            if (traceProcessingThreads_)
+            {
+                if (isAsync)
+                {
+                    Trace.WriteInfo("JobQueue", name_, "leaving Process(), thread {0}", crtThread);
+                }
+                else
+                {
+                    CommonEventSource::Events->JobQueueLeaveProcess(name_, crtThread);
+                }
+            }
+
+            if (completeClose)
+            {
+                CompleteClose(L"Process()");
+            }
+        }
+
+    private:
+        static const int64 ActiveThreadsMask = (1ll << 32) - 1;
+        static const int64 ClosedFlag = 1ll << 32;
+        static const int64 PendingFlag = 1ll << 33;
+
+        struct Shard
+        {
+            ExclusiveLock Lock;
+            std::deque<T> Items;
+            std::atomic<uint64> Count;
+
+            Shard() : Count(0)
+            {
+            }
+        };
+
+        bool TryReserveQueueSlot()
+        {
+            if (maxQueueSize_ == UINT64_MAX)
+            {
+                return true;
+            }
+
+            auto queued = queuedItems_.load();
+            do
+            {
+                if (queued >= maxQueueSize_)
+                {
+                    return false;
+                }
+            } while (!queuedItems_.compare_exchange_weak(queued, queued + 1));
+
+            return true;
+        }
+
+        bool TryDequeue(T & item, size_t & shardIndex)
+        {
+            bool isFifo = isFifo_;
+
+            for (size_t i = 0; i < shards_.size(); ++i)
+            {
+                auto index = (shardIndex + i) % shards_.size();
+                auto & shard = *shards_[index];
+                if (shard.Count.load() == 0)
+                {
+                    continue;
+                }
+
+                bool shardEmptied;
+                {
+                    AcquireExclusiveLock grab(shard.Lock);
+                    if (shard.Items.empty())
+                    {
+                        continue;
+                    }
+
+                    if (isFifo)
+                    {
+                        item = std::move(shard.Items.front());
+                        shard.Items.pop_front();
+                    }
+                    else
+                    {
+                        item = std::move(shard.Items.back());
+                        shard.Items.pop_back();
+                    }
+
+                    shardEmptied = (--shard.Count == 0);
+                }
+
+                if (maxQueueSize_ != UINT64_MAX)
+                {
+                    --queuedItems_;
+                }
+
+                if (!isFifo && shardEmptied && dequePolicy_ == DequePolicy::FifoLifo && !HasQueuedItems())
+                {
+                    isFifo_ = true;
+                }
+
+                if (perfCounters_) { perfCounters_->NumberOfItems.Decrement(); }
+
+                shardIndex = index;
+                return true;
+            }
+
+            return false;
+        }
+
+        bool HasQueuedItems()
+        {
+            for (auto const & shard : shards_)
+            {
+                if (shard->Count.load() > 0)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Takes a thread slot if one is available. Otherwise, if signalIfBusy is set, sets
+        // PendingFlag so that a running thread checks for new items before releasing its slot.
+        bool TryClaimThread(bool signalIfBusy)
+        {
+            auto state = state_.load();
+            for (;;)
+            {
+                if ((state & ActiveThreadsMask) < maxThreads_)
+                {
+                    if (state_.compare_exchange_weak(state, state + 1))
+                    {
+                        break;
+                    }
+                }
+                else if (!signalIfBusy || (state & PendingFlag) != 0 || state_.compare_exchange_weak(state, state | PendingFlag))
+                {
+                    return false;
+                }
+            }
+
+            auto activeThreads = static_cast<int>((state & ActiveThreadsMask) + 1);
+            auto highest = highestActiveThreads_.load();
+            while (activeThreads > highest && !highestActiveThreads_.compare_exchange_weak(highest, activeThreads))
+            {
+            }
+
+            return true;
+        }
+
+        // Gives up a thread slot. Returns true instead if items were queued while all thread
+        // slots were taken, in which case the caller keeps the slot and checks the shards again.
+        // Members must not be accessed after the slot is given up unless completeClose is set.
+        bool ReleaseThread(__out bool & completeClose)
+        {
+            completeClose = false;
+
+            auto state = state_.load();
+            for (;;)
+            {
+                if ((state & PendingFlag) != 0)
+                {
+                    if (state_.compare_exchange_weak(state, state & ~PendingFlag))
+                    {
+                        return true;
+                    }
+                }
+                else if (state_.compare_exchange_weak(state, state - 1))
+                {
+                    completeClose = (state - 1 == ClosedFlag);
+                    return false;
+                }
+            }
+        }
+
+        template <typename J>
+        struct JobTraits
+        {
+            static bool ProcessJob(J & item, R & root)
+            {
+                return item.ProcessJob(root);
+            }
+
+            static void SynchronizedProcess(J & item, R & root)
+            {
+                __if_exists(J::SynchronizedProcess)
+                {
+                    item.SynchronizedProcess(root);
+                }
+                __if_not_exists(J::SynchronizedProcess)
+                {
+                    UNREFERENCED_PARAMETER(item);
+                    UNREFERENCED_PARAMETER(root);
+                }
+            }
+
+            static void Close(J & item, R & root)
+            {
+                __if_exists(J::Close)
+                {
+                    item.Close(root);
+                }
+                __if_not_exists(J::Close)
+                {
+                    UNREFERENCED_PARAMETER(item);
+                    UNREFERENCED_PARAMETER(root);
+                }
+            }
+
+            static void UpdatePerfCounter(J &item, JobQueuePerfCounters &perfCounter)
+            {
+                __if_exists(J::UpdatePerfCounter)
+                {
+                    item.UpdatePerfCounter(perfCounter);
+                }
+                __if_not_exists(J::UpdatePerfCounter)
+                {
+                    UNREFERENCED_PARAMETER(item);
+                    UNREFERENCED_PARAMETER(perfCounter);
+                }
+            }
+        };
+
+        template <typename JU>
+        struct JobTraits<std::unique_ptr<JU>>
+        {
+            static bool ProcessJob(std::unique_ptr<JU> & item, R & root) { return JobTraits<JU>::ProcessJob(*item, root); }
+            static void SynchronizedProcess(std::unique_ptr<JU> & item, R & root) { JobTraits<JU>::SynchronizedProcess(*item, root); }
+            static void Close(std::unique_ptr<JU> & item, R & root) { JobTraits<JU>::Close(*item, root); }
+            static void UpdatePerfCounter(std::unique_ptr<JU> & item, JobQueuePerfCounters & perfCounter) { JobTraits<JU>::UpdatePerfCounter(*item, perfCounter); }
+        };
+
+        template <typename JU>
+        struct JobTraits<std::shared_ptr<JU>>
+        {
+            static bool ProcessJob(std::shared_ptr<JU> & item, R & root) { return JobTraits<JU>::ProcessJob(*item, root); }
+            static void SynchronizedProcess(std::shared_ptr<JU> & item, R & root) { JobTraits<JU>::SynchronizedProcess(*item, root); }
+            static void Close(std::shared_ptr<JU> & item, R & root) { JobTraits<JU>::Close(*item, root); }
+            static void UpdatePerfCounter(std::shared_ptr<JU> & item, JobQueuePerfCounters & perfCounter) { JobTraits<JU>::UpdatePerfCounter(*item, perfCounter); }
+        };
+
+        void ScheduleThread()
+        {
+            if (traceProcessingThreads_)
+            {
+                CommonEventSource::Events->JobQueueScheduleThread(name_);
+            }
+
+            auto shardIndex = static_cast<size_t>(nextThreadShard_++) % shards_.size();
+            auto root = CreateComponentRoot();
+            Threadpool::Post([this, root, shardIndex]
+            {
+                this->Process(shardIndex);
+            });
+        }
+
+        void CompleteClose(wstring const & caller)
+        {
+            Trace.WriteInfo("JobQueue", name_, "Root reset during {0}", caller);
+
+            // With forceEnqueue_ the queue can go idle after Close() more than once,
+            // OnFinishItems() is only called the first time.
+            bool finishItems = !forceEnqueue_ && !finishedItems_.exchange(true);
+
+            // release the root after accessing all the member variables needed in this method as the
+            // release could result in the queue destruction
+            auto tempRoot = std::move(rootSPtr_);
+
+            if (finishItems)
+            {
+                OnFinishItems();
+            }
+        }
+
+        ComponentRootSPtr rootSPtr_;
+        std::wstring name_;
+        std::atomic<int> maxThreads_;
+
+        // Number of active processing threads in the low 32 bits, ClosedFlag once Close() is called
+        // and PendingFlag while items queued by Enqueue() wait for a running thread
+        std::atomic<int64> state_;
+        std::atomic<int> highestActiveThreads_;
+        std::atomic<uint> completed_;
+
+        // Only maintained when maxQueueSize_ is set
+        std::atomic<uint64> queuedItems_;
+        std::atomic<uint> nextThreadShard_;
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+        RWLOCK(ShardedJobQueue, synchronizedProcessLock_);
+
+        bool forceEnqueue_;
+        // If enabled, traces information about queue state at the time of enqueue. Disabled by default.
+        bool extraTracingEnabled_;
+        // If enabled, traces processing threads. Disabled by default.
+        bool traceProcessingThreads_;
+        bool asyncJobs_;
+        std::atomic<bool> finishedItems_;
+        JobQueuePerfCountersSPtr perfCounters_;
+        uint64 maxQueueSize_;
+        DequePolicy dequePolicy_;
+        std::atomic<bool> isFifo_;
+
+        // See JobQueue::callOnQueueFull
+        void callOnQueueFull(T & item)
+        {
+            callOnQueueFull(item, 0);
+        }
+
+        template <typename TU>
+        auto callOnQueueFull(TU & item, int) -> decltype(item.OnQueueFull(root_, size_t()), void())
+        {
+            item.OnQueueFull(root_, static_cast<size_t>(GetQueueLength()));
+        }
+
+        template <typename TU>
+        auto callOnQueueFull(TU & item, char) -> decltype(item->OnQueueFull(root_, size_t()), void())
+        {
+            item->OnQueueFull(root_, static_cast<size_t>(GetQueueLength()));
+        }
+
+        template <typename TU>
+        auto callOnQueueFull(TU &, ...) -> decltype(void())
+        {
+        }
+    };
+
+    template <typename R>
+    class CommonShardedJobQueue : public ShardedJobQueue<std::unique_ptr<JobItem<R>>, R>
+    {
+    public:
+        CommonShardedJobQueue(std::wstring const & name, R & root, bool forceEnqueue = false, int maxThreads = 0, JobQueuePerfCountersSPtr perfCounters = nullptr, uint64 queueSize = UINT64_MAX, DequePolicy dequePolicy = DequePolicy::FifoLifo)
+            : ShardedJobQueue<std::unique_ptr<JobItem<R>>, R>(name, root, forceEnqueue, maxThreads, perfCounters, queueSize, dequePolicy)
+        {
+        }
+    };
+
+    template <typename R>
+    class CommonTimedShardedJobQueue : public ShardedJobQueue<std::unique_ptr<CommonTimedJobItem<R>>, R>
+    {
+    public:
+        CommonTimedShardedJobQueue(std::wstring const & name, R & root, bool forceEnqueue = false, int maxThreads = 0, JobQueuePerfCountersSPtr perfCounters = nullptr, uint64 queueSize = UINT64_MAX, DequePolicy dequePolicy = DequePolicy::FifoLifo)
+            : ShardedJobQueue<std::unique_ptr<CommonTimedJobItem<R>>, R>(name, root, forceEnqueue, maxThreads, perfCounters, queueSize, dequePolicy)
+        {
+        }
+    };
+}
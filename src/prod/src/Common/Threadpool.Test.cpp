@@ -121,5 +121,68 @@ namespace Common
         VERIFY_IS_TRUE(TimeSpan::FromSeconds(3) <= (stopwatch.Elapsed + accuracyMargin));
     }
 
+    //
+    // Work posted from callbacks goes to the worker's own queue and may be stolen by
+    // other workers, work posted from external threads goes to the shared queues.
+    // Every callback must run exactly once either way.
+    //
+    static void PostFanOut(atomic_long & pending, ManualResetEvent & allDone, int depth)
+    {
+        Threadpool::Post([&pending, &allDone, depth]() -> void
+        {
+            if (depth > 0)
+            {
+                pending += 2;
+                PostFanOut(pending, allDone, depth - 1);
+                PostFanOut(pending, allDone, depth - 1);
+            }
+
+            if (--pending == 0)
+            {
+                allDone.Set();
+            }
+        });
+    }
+
+    BOOST_AUTO_TEST_CASE(NestedPostTest)
+    {
+        int const producerCount = 8;
+        int const rootsPerProducer = 16;
+        int const depth = 10;
+
+        atomic_long pending(producerCount * rootsPerProducer);
+        ManualResetEvent allDone(false);
+
+        Stopwatch stopwatch;
+        stopwatch.Start();
+
+        vector<thread> producers;
+        for (int i = 0; i < producerCount; ++i)
+        {
+            producers.push_back(thread([&pending, &allDone]()
+            {
+                for (int j = 0; j < rootsPerProducer; ++j)
+                {
+                    PostFanOut(pending, allDone, depth);
+                }
+            }));
+        }
+
+        for (auto & producer : producers)
+        {
+            producer.join();
+        }
+
+        VERIFY_IS_TRUE(allDone.WaitOne(TimeSpan::FromSeconds(60)));
+        stopwatch.Stop();
+
+        Trace.WriteInfo(
+            TraceType,
+            "{0} callbacks completed in {1}",
+            producerCount * rootsPerProducer * ((1 << (depth + 1)) - 1),
+            stopwatch.Elapsed);
+        VERIFY_ARE_EQUAL(0L, pending.load());
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
@@ -51,6 +51,8 @@ namespace Threadpool{
 
         RecycledLists.Initialize(NumberOfProcessors);
 
+        WorkQueues.Initialize(NumberOfProcessors);
+
         // initialize Worker thread settings
         DWORD forceMin = ThreadpoolConfig::ForceMinWorkerThreads;
         MinLimitTotalWorkerThreads = forceMin > 0 ? (LONG)forceMin :
@@ -513,12 +515,12 @@ namespace Threadpool{
 
     void ThreadpoolMgr::EnqueueWorkRequest(WorkRequest* workRequest)
     {
-        AppendWorkRequest(workRequest);
+        WorkQueues.Enqueue(workRequest);
     }
 
     WorkRequest* ThreadpoolMgr::DequeueWorkRequest()
     {
-        WorkRequest* entry = RemoveWorkRequest();
+        WorkRequest* entry = WorkQueues.Dequeue();
         if (entry != NULL)
         {
             UpdateLastDequeueTime();
@@ -613,6 +615,8 @@ namespace Threadpool{
         int tid = GetCurrentThreadId();
         ThreadpoolMgr *pThis = (ThreadpoolMgr*)lpArgs;
 
+        pThis->WorkQueues.AttachWorker();
+
     Work:
 
         counts = pThis->WorkerCounter.GetCleanCounts();
@@ -668,6 +672,9 @@ namespace Threadpool{
 
     Retire:
 
+        // retired threads may not run for a long time, give local work to other workers
+        pThis->WorkQueues.DetachWorker();
+
         counts = pThis->WorkerCounter.GetCleanCounts();
 
         if (pThis->ThreadpoolRequestInstance.IsRequestPending())
@@ -683,6 +690,7 @@ namespace Threadpool{
             if (result)
             {
                 foundWork = true;
+                pThis->WorkQueues.AttachWorker();
 
                 counts = pThis->WorkerCounter.GetCleanCounts();
                 TP_ASSERT(counts.NumWorking > 0, "WorkerThreadStart: counts.NumWorking > 0");
@@ -756,6 +764,7 @@ namespace Threadpool{
         }
 
     Exit:
+        pThis->WorkQueues.DetachWorker();
         counts = pThis->WorkerCounter.GetCleanCounts();
         return NULL;
     }
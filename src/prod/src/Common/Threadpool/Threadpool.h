@@ -10,6 +10,7 @@
 #include "Volatile.h"
 #include "HillClimbing.h"
 #include "UnfairSemaphore.h"
+#include "WorkStealingQueue.h"
 #include "ThreadpoolRequest.h"
 
 namespace Threadpool{
@@ -48,6 +49,9 @@ namespace Threadpool{
 
         static const DWORD SpinLimitPerProcessor            = 50;
 
+        static const DWORD WorkerDequesPerProcessor         = 2;                    // work stealing deques for worker threads
+        static const DWORD MinWorkerDeques                  = 16;
+
         //static const DWORD UnfairSemaphoreSpinTime          = 100;
     };
 
@@ -348,44 +352,9 @@ namespace Threadpool{
             return wr;
         }
 
-        inline void AppendWorkRequest(WorkRequest* entry)
-        {
-            if (WorkRequestTail)
-            {
-                _ASSERTE(WorkRequestHead != NULL);
-                WorkRequestTail->next = entry;
-            }
-            else
-            {
-                _ASSERTE(WorkRequestHead == NULL);
-                WorkRequestHead = entry;
-            }
-
-            WorkRequestTail = entry;
-            _ASSERTE(WorkRequestTail->next == NULL);
-        }
-
-        inline WorkRequest* RemoveWorkRequest()
-        {
-            WorkRequest* entry = NULL;
-            if (WorkRequestHead)
-            {
-                entry = WorkRequestHead;
-                WorkRequestHead = entry->next;
-                if (WorkRequestHead == NULL)
-                    WorkRequestTail = NULL;
-            }
-            return entry;
-        }
-
         inline BOOL PeekWorkRequestAge(DWORD &age)
         {
-            if (WorkRequestHead)
-            {
-                age = WorkRequestHead->AgeTick;
-                return TRUE;
-            }
-            return FALSE;
+            return WorkQueues.PeekOldestAge(GetTickCount(), age);
         }
 
         inline void FreeWorkRequest(WorkRequest* workRequest)
@@ -478,8 +447,7 @@ namespace Threadpool{
         INT ThreadAdjustmentInterval = 0;
         DangerousSpinLock ThreadAdjustmentLock;
 
-        WorkRequest* WorkRequestHead = NULL;
-        WorkRequest* WorkRequestTail = NULL;
+        WorkStealingScheduler WorkQueues;
 
         LONG GateThreadStatus = GateThreadNotRunning;
 
@@ -9,6 +9,9 @@
 
 namespace Threadpool{
 
+    // stays below SWITCH_SLEEP_START_THRESHOLD, so a retry yields but never sleeps
+    #define DEQUEUE_RETRY_COUNT 4
+
     void ThreadpoolRequest::ResetState()
     {
         m_NumRequests = 0;
@@ -69,10 +72,11 @@ namespace Threadpool{
         pWorkRequest = m_threadpoolMgr->MakeWorkRequest(function, parameter, context);
         TP_ASSERT(pWorkRequest != NULL, "QueueWorkRequest: pWorkRequest != NULL");
 
-        SpinLock::Holder slh(&m_lock);
-        m_threadpoolMgr->EnqueueWorkRequest(pWorkRequest);
+        // count first, so that a worker that dequeues this request right away does not see the count go negative
+        InterlockedIncrement(&m_NumRequests);
 
-        m_NumRequests++;
+        // work queues are lock-free for worker threads, see WorkStealingScheduler
+        m_threadpoolMgr->EnqueueWorkRequest(pWorkRequest);
         SetRequestsActive();
     }
 
@@ -80,12 +84,24 @@ namespace Threadpool{
     {
         *lastOne = true;
 
-        SpinLock::Holder slh(&m_lock);
+        // m_NumRequests is incremented before a request is queued and decremented after it is dequeued,
+        // so while it is positive a request may still be on its way into a queue. Look again a few times,
+        // yielding in between. The count also covers requests other workers have dequeued but not yet
+        // counted down, so do not wait for it to drop: after DEQUEUE_RETRY_COUNT misses report no work.
+        // The thread request added by SetRequestsActive is only taken on a successful dequeue, so the
+        // worker still sees IsRequestPending before it waits and comes back for the request.
+        WorkRequest * pWorkRequest;
+        DWORD switchCount = 0;
+        while ((pWorkRequest = m_threadpoolMgr->DequeueWorkRequest()) == NULL) {
+            if (m_NumRequests <= 0 || switchCount >= DEQUEUE_RETRY_COUNT) {
+                break;
+            }
+
+            __SwitchToThread(0, ++switchCount);
+        }
 
-        WorkRequest * pWorkRequest = m_threadpoolMgr->DequeueWorkRequest();
         if (pWorkRequest) {
-            m_NumRequests--;
-            if(m_NumRequests > 0) {
+            if (InterlockedDecrement(&m_NumRequests) > 0) {
                 *lastOne = false;
             }
 
@@ -97,7 +113,6 @@ namespace Threadpool{
 
     BOOL ThreadpoolRequest::PeekWorkRequestAge(DWORD& age)
     {
-        SpinLock::Holder slh(&m_lock);
         return m_threadpoolMgr->PeekWorkRequestAge(age);
     }
 
@@ -28,7 +28,7 @@ namespace Threadpool{
     class ThreadpoolRequest
     {
     public:
-        ThreadpoolRequest() { m_lock.Init(); ResetState(); }
+        ThreadpoolRequest() { ResetState(); }
 
         void Initialize(ThreadpoolMgr *tpm) { m_threadpoolMgr = tpm; }
 
@@ -53,9 +53,8 @@ namespace Threadpool{
         void ResetState();
 
     private:
-        ULONG m_NumRequests;
+        Volatile<LONG> m_NumRequests;
         Volatile<LONG> m_outstandingThreadRequestCount;
-        SpinLock m_lock;
 
         ThreadpoolMgr *m_threadpoolMgr;
     };
@@ -0,0 +1,522 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <map>
+#include <string>
+#include "Threadpool.h"
+#include "ThreadpoolRequest.h"
+#include "WorkStealingQueue.h"
+#include "Tracer.h"
+
+namespace Threadpool{
+
+    //
+    // WorkStealingDeque
+    //
+
+    WorkStealingDeque::Buffer::Buffer(LONGLONG capacity)
+        : m_capacity(capacity)
+        , m_mask(capacity - 1)
+        , m_slots(new std::atomic<WorkRequest*>[capacity])
+        , m_ageTicks(new std::atomic<DWORD>[capacity])
+    {
+        TP_ASSERT((capacity & (capacity - 1)) == 0, "WorkStealingDeque: capacity must be power of 2");
+    }
+
+    WorkStealingDeque::Buffer::~Buffer()
+    {
+        delete[] m_slots;
+        delete[] m_ageTicks;
+    }
+
+    WorkStealingDeque::WorkStealingDeque()
+        : m_top(0)
+        , m_bottom(0)
+        , m_buffer(new Buffer(InitialCapacity))
+    {
+    }
+
+    WorkStealingDeque::~WorkStealingDeque()
+    {
+        delete m_buffer.load(std::memory_order_relaxed);
+        for (auto buffer : m_retiredBuffers)
+        {
+            delete buffer;
+        }
+    }
+
+    WorkStealingDeque::Buffer* WorkStealingDeque::Grow(Buffer* buffer, LONGLONG top, LONGLONG bottom)
+    {
+        Buffer* newBuffer = new Buffer(buffer->m_capacity * 2);
+        for (LONGLONG i = top; i < bottom; ++i)
+        {
+            newBuffer->Put(i, buffer->Get(i), buffer->GetAgeTick(i));
+        }
+
+        m_retiredBuffers.push_back(buffer);
+        m_buffer.store(newBuffer, std::memory_order_release);
+        return newBuffer;
+    }
+
+    void WorkStealingDeque::Push(WorkRequest* workRequest)
+    {
+        LONGLONG bottom = m_bottom.load(std::memory_order_relaxed);
+        LONGLONG top = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+        if (bottom - top > buffer->m_capacity - 1)
+        {
+            buffer = Grow(buffer, top, bottom);
+        }
+
+        buffer->Put(bottom, workRequest, workRequest->AgeTick);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    WorkRequest* WorkStealingDeque::Pop()
+    {
+        LONGLONG bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        LONGLONG top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // empty
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return NULL;
+        }
+
+        WorkRequest* workRequest = buffer->Get(bottom);
+        if (top == bottom)
+        {
+            // last item, race with thieves for it
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                workRequest = NULL;
+            }
+
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return workRequest;
+    }
+
+    WorkRequest* WorkStealingDeque::Steal()
+    {
+        for (;;)
+        {
+            LONGLONG top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            LONGLONG bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+            {
+                return NULL;
+            }
+
+            Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+            WorkRequest* workRequest = buffer->Get(top);
+            if (m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return workRequest;
+            }
+
+            // lost to the owner or another thief, look again in case more requests are left
+        }
+    }
+
+    BOOL WorkStealingDeque::PeekAge(DWORD& age) const
+    {
+        LONGLONG top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        LONGLONG bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return FALSE;
+        }
+
+        // retired buffers stay alive with the deque, the slot may be reused concurrently,
+        // which only makes the reported age slightly newer than the real oldest one
+        age = m_buffer.load(std::memory_order_acquire)->GetAgeTick(top);
+        return TRUE;
+    }
+
+    //
+    // InjectionQueue
+    //
+
+    void InjectionQueue::Enqueue(WorkRequest* workRequest)
+    {
+        workRequest->next = NULL;
+
+        SpinLock::Holder slh(&m_lock);
+        if (m_tail)
+        {
+            m_tail->next = workRequest;
+        }
+        else
+        {
+            m_head = workRequest;
+        }
+
+        m_tail = workRequest;
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    WorkRequest* InjectionQueue::Dequeue()
+    {
+        // Only a hint, a request being enqueued may not be counted yet. ThreadpoolRequest
+        // retries while it has requests outstanding, so a miss here only delays dequeue.
+        if (IsEmpty())
+        {
+            return NULL;
+        }
+
+        SpinLock::Holder slh(&m_lock);
+        WorkRequest* workRequest = m_head;
+        if (workRequest)
+        {
+            m_head = workRequest->next;
+            if (m_head == NULL)
+            {
+                m_tail = NULL;
+            }
+
+            m_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return workRequest;
+    }
+
+    BOOL InjectionQueue::PeekAge(DWORD& age)
+    {
+        SpinLock::Holder slh(&m_lock);
+        if (m_head)
+        {
+            age = m_head->AgeTick;
+            return TRUE;
+        }
+
+        return FALSE;
+    }
+
+    //
+    // WorkStealingScheduler
+    //
+
+    thread_local WorkStealingScheduler::WorkerContext WorkStealingScheduler::t_worker = { NULL, NULL, 0, 0 };
+
+    WorkStealingScheduler::WorkStealingScheduler()
+        : m_nodeCount(1)
+        , m_injectionQueues(NULL)
+        , m_slots(NULL)
+        , m_slotCount(0)
+    {
+    }
+
+    WorkStealingScheduler::~WorkStealingScheduler()
+    {
+        delete[] m_injectionQueues;
+        delete[] m_slots;
+    }
+
+    void WorkStealingScheduler::Initialize(DWORD numberOfProcessors)
+    {
+        LoadNumaTopology(numberOfProcessors, m_nodeOfProcessor, m_nodeCount);
+
+        m_injectionQueues = new InjectionQueue[m_nodeCount];
+
+        // Worker count normally stays close to processor count under hill climbing, workers
+        // beyond this many deques only run work from injection queues and from stealing.
+        m_slotCount = numberOfProcessors * ThreadpoolConfig::WorkerDequesPerProcessor;
+        if (m_slotCount < ThreadpoolConfig::MinWorkerDeques)
+        {
+            m_slotCount = ThreadpoolConfig::MinWorkerDeques;
+        }
+
+        m_slots = new WorkerSlot[m_slotCount];
+
+        TP_TRACE(Info, "WorkStealingScheduler: %d processors, %d NUMA nodes, %d worker deques", numberOfProcessors, m_nodeCount, m_slotCount);
+    }
+
+    void WorkStealingScheduler::LoadNumaTopology(DWORD numberOfProcessors, std::vector<DWORD>& nodeOfProcessor, DWORD& nodeCount)
+    {
+        nodeOfProcessor.assign(numberOfProcessors, 0);
+        nodeCount = 1;
+
+        // Node ids may be sparse, map them to dense indexes
+        std::map<int, std::string> cpuLists;
+        DIR* dir = opendir("/sys/devices/system/node");
+        if (dir == NULL)
+        {
+            return;
+        }
+
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL)
+        {
+            if ((strncmp(entry->d_name, "node", 4) != 0) || (entry->d_name[4] < '0') || (entry->d_name[4] > '9'))
+            {
+                continue;
+            }
+
+            std::string path = std::string("/sys/devices/system/node/") + entry->d_name + "/cpulist";
+            std::ifstream file(path);
+            std::string cpuList;
+            if (file && std::getline(file, cpuList))
+            {
+                cpuLists[atoi(entry->d_name + 4)] = cpuList;
+            }
+        }
+
+        closedir(dir);
+
+        if (cpuLists.size() <= 1)
+        {
+            return;
+        }
+
+        DWORD node = 0;
+        for (auto const & nodeCpus : cpuLists)
+        {
+            // cpulist format: "0-15,32-47"
+            char const* p = nodeCpus.second.c_str();
+            while (*p)
+            {
+                char* end;
+                long first = strtol(p, &end, 10);
+                if (end == p) break;
+
+                long last = first;
+                p = end;
+                if (*p == '-')
+                {
+                    last = strtol(p + 1, &end, 10);
+                    p = end;
+                }
+
+                for (long cpu = first; cpu <= last; ++cpu)
+                {
+                    if ((cpu >= 0) && ((DWORD)cpu < numberOfProcessors))
+                    {
+                        nodeOfProcessor[cpu] = node;
+                    }
+                }
+
+                if (*p == ',') ++p;
+            }
+
+            ++node;
+        }
+
+        nodeCount = node;
+    }
+
+    WorkStealingScheduler::WorkerContext* WorkStealingScheduler::CurrentWorker()
+    {
+        return (t_worker.Scheduler == this) ? &t_worker : NULL;
+    }
+
+    DWORD WorkStealingScheduler::CurrentNode()
+    {
+        if (m_nodeCount == 1)
+        {
+            return 0;
+        }
+
+        DWORD processor = GetCurrentProcessorNumber();
+        return (processor < m_nodeOfProcessor.size()) ? m_nodeOfProcessor[processor] : 0;
+    }
+
+    void WorkStealingScheduler::AttachWorker()
+    {
+        if (CurrentWorker() != NULL)
+        {
+            return;
+        }
+
+        DWORD node = CurrentNode();
+        DWORD start = GetCurrentProcessorNumber() % m_slotCount;
+
+        t_worker.Scheduler = this;
+        t_worker.Slot = NULL;
+        t_worker.Node = node;
+        t_worker.StealSeed = (DWORD)GetCurrentThreadId() | 1;
+
+        for (DWORD i = 0; i < m_slotCount; ++i)
+        {
+            WorkerSlot& slot = m_slots[(start + i) % m_slotCount];
+            bool inUse = false;
+            if (!slot.InUse.load(std::memory_order_relaxed) &&
+                slot.InUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+            {
+                slot.Node.store(node, std::memory_order_relaxed);
+                t_worker.Slot = &slot;
+                return;
+            }
+        }
+    }
+
+    void WorkStealingScheduler::DetachWorker()
+    {
+        WorkerContext* worker = CurrentWorker();
+        if (worker == NULL)
+        {
+            return;
+        }
+
+        if (worker->Slot)
+        {
+            // hand over remaining local work, nobody else pushes to this deque
+            WorkRequest* workRequest;
+            while ((workRequest = worker->Slot->Deque.Pop()) != NULL)
+            {
+                m_injectionQueues[worker->Node].Enqueue(workRequest);
+            }
+
+            worker->Slot->Node.store(-1, std::memory_order_relaxed);
+            worker->Slot->InUse.store(false, std::memory_order_release);
+        }
+
+        worker->Scheduler = NULL;
+        worker->Slot = NULL;
+    }
+
+    void WorkStealingScheduler::Enqueue(WorkRequest* workRequest)
+    {
+        WorkerContext* worker = CurrentWorker();
+        if (worker && worker->Slot)
+        {
+            worker->Slot->Deque.Push(workRequest);
+            return;
+        }
+
+        m_injectionQueues[worker ? worker->Node : CurrentNode()].Enqueue(workRequest);
+    }
+
+    WorkRequest* WorkStealingScheduler::StealFromWorkers(DWORD node, bool sameNode, WorkerSlot* self, DWORD seed)
+    {
+        // start from a different victim on each attempt to spread thieves
+        DWORD start = seed % m_slotCount;
+        for (DWORD i = 0; i < m_slotCount; ++i)
+        {
+            WorkerSlot& slot = m_slots[(start + i) % m_slotCount];
+            if ((&slot == self) || slot.Deque.IsEmpty())
+            {
+                continue;
+            }
+
+            LONG slotNode = slot.Node.load(std::memory_order_relaxed);
+            if (sameNode != (slotNode == (LONG)node))
+            {
+                continue;
+            }
+
+            WorkRequest* workRequest = slot.Deque.Steal();
+            if (workRequest)
+            {
+                return workRequest;
+            }
+        }
+
+        return NULL;
+    }
+
+    WorkRequest* WorkStealingScheduler::Dequeue()
+    {
+        WorkerContext* worker = CurrentWorker();
+        WorkerSlot* self = NULL;
+        DWORD node;
+        DWORD seed;
+
+        if (worker)
+        {
+            self = worker->Slot;
+            node = worker->Node;
+
+            // xorshift
+            seed = worker->StealSeed;
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            worker->StealSeed = seed;
+        }
+        else
+        {
+            node = CurrentNode();
+            seed = GetCurrentProcessorNumber();
+        }
+
+        WorkRequest* workRequest = NULL;
+        if (self)
+        {
+            workRequest = self->Deque.Pop();
+            if (workRequest) return workRequest;
+        }
+
+        workRequest = m_injectionQueues[node].Dequeue();
+        if (workRequest) return workRequest;
+
+        workRequest = StealFromWorkers(node, true, self, seed);
+        if (workRequest) return workRequest;
+
+        for (DWORD i = 1; i < m_nodeCount; ++i)
+        {
+            workRequest = m_injectionQueues[(node + i) % m_nodeCount].Dequeue();
+            if (workRequest) return workRequest;
+        }
+
+        if (m_nodeCount > 1)
+        {
+            workRequest = StealFromWorkers(node, false, self, seed);
+        }
+
+        return workRequest;
+    }
+
+    BOOL WorkStealingScheduler::PeekOldestAge(DWORD now, DWORD& age)
+    {
+        BOOL found = FALSE;
+        DWORD oldestDiff = 0;
+
+        auto updateOldest = [&](DWORD queueAge)
+        {
+            DWORD diff = now - queueAge;
+            if (!found || (diff > oldestDiff))
+            {
+                oldestDiff = diff;
+                age = queueAge;
+                found = TRUE;
+            }
+        };
+
+        DWORD queueAge;
+        for (DWORD i = 0; i < m_nodeCount; ++i)
+        {
+            if (m_injectionQueues[i].PeekAge(queueAge))
+            {
+                updateOldest(queueAge);
+            }
+        }
+
+        for (DWORD i = 0; i < m_slotCount; ++i)
+        {
+            if (m_slots[i].Deque.PeekAge(queueAge))
+            {
+                updateOldest(queueAge);
+            }
+        }
+
+        return found;
+    }
+}
@@ -0,0 +1,168 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include "MinPal.h"
+#include "Synch.h"
+
+namespace Threadpool{
+
+    struct WorkRequest;
+
+    // Chase-Lev work stealing deque, "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al., PPoPP 2013).
+    // Only the owning worker thread calls Push and Pop, which work on the bottom end without atomic read-modify-write
+    // unless the deque is about to become empty. Any thread may call Steal, which takes from the top end.
+    class WorkStealingDeque
+    {
+    public:
+        WorkStealingDeque();
+        ~WorkStealingDeque();
+
+        void Push(WorkRequest* workRequest);
+        WorkRequest* Pop();
+
+        // Returns NULL only when the deque was seen empty, a lost race with the owner or another thief is retried
+        WorkRequest* Steal();
+
+        // Any thread may call this, returns AgeTick of the oldest request or FALSE when the deque is empty
+        BOOL PeekAge(DWORD& age) const;
+
+        inline bool IsEmpty() const
+        {
+            return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Buffer
+        {
+            Buffer(LONGLONG capacity);
+            ~Buffer();
+
+            inline WorkRequest* Get(LONGLONG index) const
+            {
+                return m_slots[index & m_mask].load(std::memory_order_relaxed);
+            }
+
+            // Request may be executed and freed by the time another thread reads the age, ages are
+            // kept next to the slots so that PeekAge never dereferences a request it does not own
+            inline DWORD GetAgeTick(LONGLONG index) const
+            {
+                return m_ageTicks[index & m_mask].load(std::memory_order_relaxed);
+            }
+
+            inline void Put(LONGLONG index, WorkRequest* workRequest, DWORD ageTick)
+            {
+                m_ageTicks[index & m_mask].store(ageTick, std::memory_order_relaxed);
+                m_slots[index & m_mask].store(workRequest, std::memory_order_relaxed);
+            }
+
+            const LONGLONG m_capacity;
+            const LONGLONG m_mask;
+            std::atomic<WorkRequest*>* m_slots;
+            std::atomic<DWORD>* m_ageTicks;
+        };
+
+        Buffer* Grow(Buffer* buffer, LONGLONG top, LONGLONG bottom);
+
+        static const LONGLONG InitialCapacity = 256;
+
+        // top and bottom are written by different threads, keep them on different cache lines
+        BYTE CacheGuardPre[64];
+        std::atomic<LONGLONG> m_top;
+        BYTE CacheGuardMid[64];
+        std::atomic<LONGLONG> m_bottom;
+        std::atomic<Buffer*> m_buffer;
+        BYTE CacheGuardPost[64];
+
+        // Thieves may still read from a buffer after it is replaced, retired buffers are only freed with the deque
+        std::vector<Buffer*> m_retiredBuffers;
+    };
+
+    // FIFO queue for work submitted from threads that do not own a deque, one per NUMA node
+    class InjectionQueue
+    {
+    public:
+        InjectionQueue() : m_head(NULL), m_tail(NULL), m_count(0) { m_lock.Init(); }
+
+        void Enqueue(WorkRequest* workRequest);
+        WorkRequest* Dequeue();
+        BOOL PeekAge(DWORD& age);
+
+        inline bool IsEmpty() const
+        {
+            return m_count.load(std::memory_order_relaxed) == 0;
+        }
+
+    private:
+        BYTE CacheGuardPre[64];
+        SpinLock m_lock;
+        WorkRequest* m_head;
+        WorkRequest* m_tail;
+        std::atomic<LONG> m_count;
+        BYTE CacheGuardPost[64];
+    };
+
+    // Work queues of a ThreadpoolMgr. Each worker thread owns a WorkStealingDeque, work queued from a worker thread
+    // goes to its own deque and is executed LIFO by that worker. Work queued from other threads goes to the injection
+    // queue of the NUMA node the caller is running on. A worker looks for work in its own deque, then in its node's
+    // injection queue, then steals from workers on the same node, and only then from other nodes.
+    class WorkStealingScheduler
+    {
+    public:
+        WorkStealingScheduler();
+        ~WorkStealingScheduler();
+
+        void Initialize(DWORD numberOfProcessors);
+
+        void Enqueue(WorkRequest* workRequest);
+        WorkRequest* Dequeue();
+
+        // Worker threads call these when they start and exit, and when they retire. A worker that
+        // is not attached, e.g. because all deques are taken, still runs work from the shared queues.
+        void AttachWorker();
+        void DetachWorker();
+
+        // AgeTick of the oldest request in injection queues and worker deques, FALSE when all are empty.
+        // now must come from the same clock as WorkRequest::AgeTick.
+        BOOL PeekOldestAge(DWORD now, DWORD& age);
+
+        DWORD NodeCount() const { return m_nodeCount; }
+
+    private:
+        struct WorkerSlot
+        {
+            WorkStealingDeque Deque;
+            std::atomic<bool> InUse;
+            std::atomic<LONG> Node;
+
+            WorkerSlot() : InUse(false), Node(-1) {}
+        };
+
+        struct WorkerContext
+        {
+            WorkStealingScheduler* Scheduler;
+            WorkerSlot* Slot;
+            DWORD Node;
+            DWORD StealSeed;
+        };
+
+        WorkerContext* CurrentWorker();
+        DWORD CurrentNode();
+        WorkRequest* StealFromWorkers(DWORD node, bool sameNode, WorkerSlot* self, DWORD seed);
+
+        static void LoadNumaTopology(DWORD numberOfProcessors, std::vector<DWORD>& nodeOfProcessor, DWORD& nodeCount);
+
+        static thread_local WorkerContext t_worker;
+
+        DWORD m_nodeCount;
+        std::vector<DWORD> m_nodeOfProcessor;
+        InjectionQueue* m_injectionQueues;
+        WorkerSlot* m_slots;
+        DWORD m_slotCount;
+    };
+}
@@ -508,6 +508,73 @@ namespace Common
         LEAVE;
     }
 
+    BOOST_AUTO_TEST_CASE(TimerQueueMillionTimersBenchmark)
+    {
+        ENTER;
+
+        const LONG timerCount = 1000000;
+        auto & timerQueue = TimerQueue::GetDefault();
+
+        atomic_long fireCount(0);
+        ManualResetEvent allFired(false);
+
+        vector<TimerQueue::TimerSPtr> timers;
+        timers.reserve(timerCount);
+        for (LONG i = 0; i < timerCount; ++i)
+        {
+            timers.emplace_back(timerQueue.CreateTimer(TimerTagDefault, [&fireCount, &allFired, timerCount]
+            {
+                if (++fireCount == timerCount)
+                {
+                    allFired.Set();
+                }
+            }));
+        }
+
+        // due times are spread over an hour, so that timers are armed on every level of the wheel
+        Stopwatch stopwatch;
+        stopwatch.Start();
+        for (LONG i = 0; i < timerCount; ++i)
+        {
+            timerQueue.Enqueue(timers[i], TimeSpan::FromMilliseconds(3600 * 1000 + (i * 37) % (3600 * 1000)));
+        }
+        auto armTime = stopwatch.Elapsed;
+
+        stopwatch.Restart();
+        for (auto const & timer : timers)
+        {
+            VERIFY_IS_TRUE(timerQueue.Dequeue(timer));
+        }
+        auto cancelTime = stopwatch.Elapsed;
+
+        stopwatch.Restart();
+        for (LONG i = 0; i < timerCount; ++i)
+        {
+            timerQueue.Enqueue(timers[i], TimeSpan::FromMilliseconds(i % 2000));
+        }
+        auto rearmTime = stopwatch.Elapsed;
+
+        VERIFY_IS_TRUE(allFired.WaitOne(TimeSpan::FromSeconds(60)));
+        auto fireAllTime = stopwatch.Elapsed;
+
+        Trace.WriteInfo(
+            TraceType,
+            "{0} timers: arm {1}, cancel {2}, rearm {3}, rearm and fire all {4}",
+            timerCount,
+            armTime,
+            cancelTime,
+            rearmTime,
+            fireAllTime);
+
+        VERIFY_ARE_EQUAL(timerCount, fireCount.load());
+        for (auto const & timer : timers)
+        {
+            VERIFY_IS_FALSE(timerQueue.IsTimerArmed(timer));
+        }
+
+        LEAVE;
+    }
+
 #endif
 
     BOOST_AUTO_TEST_CASE(TestTimerWaitOnCancel)
@@ -15,12 +15,31 @@ namespace
     TimerEventSource const trace;
     const StringLiteral TraceType("TimerQueue");
     atomic_uint64 LeaseTimerCount(0);
-    constexpr size_t InvalidHeapIndex = numeric_limits<decltype(InvalidHeapIndex)>::max();
+
+    // Returns the distance from start to the first set bit, scanning circularly, or -1 if no bit is set
+    int FindNextOccupied(uint64 const * bitmap, uint wordCount, uint start)
+    {
+        uint const bitCount = wordCount * 64;
+        for (uint scanned = 0; scanned < bitCount;)
+        {
+            uint index = (start + scanned) % bitCount;
+            uint64 word = bitmap[index / 64] >> (index % 64);
+            if (word != 0)
+            {
+                return scanned + __builtin_ctzll(word);
+            }
+
+            scanned += 64 - (index % 64);
+        }
+
+        return -1;
+    }
 }
 
 class TimerQueue::Timer
 {
     DENY_COPY(Timer);
+    friend class TimerQueue;
 
 public:
     Timer(TimerQueue const* queue, StringLiteral const tag, Callback const & callback)
@@ -28,7 +47,6 @@ public:
         , callback_(callback)
     {
         trace.CreatedQueued(TraceThis, tag, ++LeaseTimerCount, TracePtr(queue));
-        ClearHeapIndex();
     }
 
     ~Timer()
@@ -36,17 +54,8 @@ public:
         trace.DestructedQueued(TraceThis, --LeaseTimerCount);
     }
 
-    bool operator < (Timer const & rhs) const noexcept { return dueTime_ < rhs.dueTime_; }
-    bool operator <= (Timer const & rhs) const noexcept { return dueTime_ <= rhs.dueTime_; }
-
     StopwatchTime DueTime() const noexcept { return dueTime_; }
 
-    bool ShouldAddToHeap(StopwatchTime dueTime) noexcept
-    {
-        dueTime_ = dueTime;
-        return !IsInHeap(); 
-    }
-
     const char* Tag() const noexcept { return tag_; }
 
     void Fire()
@@ -55,145 +64,220 @@ public:
         callback_();
     }
 
-    size_t HeapIndex() const noexcept { return heapIndex_; }
-    void SetHeapIndex(ssize_t idx) noexcept { heapIndex_ = idx; }
-
-    bool IsInHeap() const noexcept { return heapIndex_ != InvalidHeapIndex; }
-
-    size_t ClearHeapIndex() noexcept
-    {
-        auto index = heapIndex_; 
-        heapIndex_ = InvalidHeapIndex; 
-        return index;
-    }
+    bool IsQueued() const noexcept { return list_ != nullptr; }
 
 private:
     const char * const tag_; //only stores string literal
     const Callback callback_;
 
     StopwatchTime dueTime_ = StopwatchTime::Zero;
-    size_t heapIndex_;
+    uint64 dueTick_ = 0;
+
+    // Links of the intrusive wheel slot list, guarded by TimerQueue::lock_. The queue holds a reference
+    // to the timer only while it is on a list, so rearming a queued timer does not touch the ref count.
+    Timer* prev_ = nullptr;
+    Timer* next_ = nullptr;
+    TimerList* list_ = nullptr;
+    TimerSPtr self_;
 };
 
-namespace
+bool TimerQueue::IsTimerArmed(TimerSPtr const & timer)
+{
+    AcquireReadLock grab(lock_);
+    return timer->IsQueued() && (timer->DueTime() < StopwatchTime::MaxValue);
+}
+
+uint64 TimerQueue::ToTickCeiling(StopwatchTime time) const
 {
-    size_t HeapNodeParentIndex(size_t nodeIndex)
+    if (time == StopwatchTime::MaxValue)
     {
-        return (nodeIndex - 1) / 2; // underflow is fine in the way we are using it
+        return NoTick;
     }
 
-    size_t HeapNodeLeftChildIndex(size_t nodeIndex)
+    auto ticks = static_cast<uint64>(max<int64>(time.Ticks, 0));
+    return (ticks / tickTicks_) + ((ticks % tickTicks_) != 0);
+}
+
+uint64 TimerQueue::ToTickFloor(StopwatchTime time) const
+{
+    return static_cast<uint64>(max<int64>(time.Ticks, 0)) / tickTicks_;
+}
+
+StopwatchTime TimerQueue::ToStopwatchTime(uint64 tick) const
+{
+    return StopwatchTime(static_cast<int64>(tick * tickTicks_));
+}
+
+void TimerQueue::Link_LockHeld(Timer & timer, TimerList & list)
+{
+    Invariant(!timer.IsQueued());
+
+    timer.list_ = &list;
+    timer.prev_ = nullptr;
+    timer.next_ = list.Head;
+    if (list.Head)
     {
-        return nodeIndex*2 + 1;
+        list.Head->prev_ = &timer;
     }
 
-    size_t HeapNodeRightChildIndex(size_t nodeIndex)
+    list.Head = &timer;
+
+    if (list.Level < WheelLevels)
     {
-        return nodeIndex*2 + 2;
+        occupied_[list.Level][list.Index / 64] |= (1ULL << (list.Index % 64));
     }
-}
 
-bool TimerQueue::IsTimerArmed(TimerSPtr const & timer)
-{
-    AcquireReadLock grab(lock_);
-    return timer->IsInHeap() && (timer->DueTime() < StopwatchTime::MaxValue);
+    if (&list != &parked_)
+    {
+        ++wheelTimerCount_;
+    }
 }
 
-void TimerQueue::HeapCheck_Dbg()
+void TimerQueue::Unlink_LockHeld(Timer & timer)
 {
-#ifdef DBG
-//    wstring str;
-//    StringWriter w(str);
-//    w.WriteLine();
-//
-//    for(size_t i = 0; i < heap_.size(); ++i)
-//    {
-//        w.WriteLine("{0}-([{1}] = {2})", TextTracePtr(heap_[i].get()), heap_[i]->HeapIndex(), heap_[i]->DueTime());
-//    }
-//    TimerQueue::WriteNoise(TraceType, "heap: {0}", str);
+    auto list = timer.list_;
+    Invariant(list);
 
-    for(size_t i = 0; i < heap_.size(); ++i)
+    if (timer.prev_)
     {
-        Invariant(heap_[i]);
-        Invariant(heap_[i]->IsInHeap());
+        timer.prev_->next_ = timer.next_;
+    }
+    else
+    {
+        list->Head = timer.next_;
+    }
 
-        auto leftChildIndex = HeapNodeLeftChildIndex(i);
-        auto rightChildIndex = HeapNodeRightChildIndex(i);
+    if (timer.next_)
+    {
+        timer.next_->prev_ = timer.prev_;
+    }
 
-        if (leftChildIndex >= heap_.size()) return;
+    timer.prev_ = nullptr;
+    timer.next_ = nullptr;
+    timer.list_ = nullptr;
 
-        ASSERT_IFNOT(*(heap_[i]) <= *(heap_[leftChildIndex]), "[{0}] <= [{1}] assert failed", i, rightChildIndex);
+    if ((list->Level < WheelLevels) && !list->Head)
+    {
+        occupied_[list->Level][list->Index / 64] &= ~(1ULL << (list->Index % 64));
+    }
 
+    if (list != &parked_)
+    {
+        --wheelTimerCount_;
+    }
+}
 
-        if (rightChildIndex >= heap_.size()) return;
+void TimerQueue::Place_LockHeld(Timer & timer)
+{
+    if (timer.dueTick_ == NoTick)
+    {
+        Link_LockHeld(timer, parked_);
+        return;
+    }
 
-        ASSERT_IFNOT(*(heap_[i]) <= *(heap_[rightChildIndex]), "[{0}] <= [{1}] assert failed", i, rightChildIndex);
+    Invariant(timer.dueTick_ > currentTick_);
+
+    // The lowest level on which due tick and current tick fall into the same slot of the level above
+    uint level = (63 - __builtin_clzll(timer.dueTick_ ^ currentTick_)) / WheelSlotBits;
+    if (level >= WheelLevels)
+    {
+        Link_LockHeld(timer, overflow_);
+        return;
     }
-#endif
+
+    Link_LockHeld(timer, wheel_[level][(timer.dueTick_ >> (level * WheelSlotBits)) & WheelSlotMask]);
 }
 
-void TimerQueue::HeapNodeSwap_LockHeld(size_t index1, size_t index2)
+void TimerQueue::Expire_LockHeld(Timer & timer, vector<TimerSPtr> & expired)
 {
-    Invariant(index1 != index2);
-    heap_[index1]->SetHeapIndex(index2);
-    heap_[index2]->SetHeapIndex(index1);
-    std::swap(heap_[index1], heap_[index2]);
+    Invariant(!timer.IsQueued());
+    expired.emplace_back(move(timer.self_));
 }
 
-void TimerQueue::HeapAdjustUp_LockHeld(size_t nodeIndex)
+void TimerQueue::Cascade_LockHeld(TimerList & list, vector<TimerSPtr> & expired)
 {
-    auto parentIndex = HeapNodeParentIndex(nodeIndex);
-    while (parentIndex < nodeIndex)
+    // Follow the saved links, a timer on the overflow list may be placed back onto the same list
+    Timer* timer = list.Head;
+    while (timer)
     {
-        if (*(heap_[nodeIndex]) < *(heap_[parentIndex]))
-        {
-            HeapNodeSwap_LockHeld(nodeIndex, parentIndex);
+        Timer* next = timer->next_;
+        Unlink_LockHeld(*timer);
 
-            nodeIndex = parentIndex;
-            parentIndex = HeapNodeParentIndex(nodeIndex); 
-            continue;
+        if (timer->dueTick_ <= currentTick_)
+        {
+            Expire_LockHeld(*timer, expired);
+        }
+        else
+        {
+            Place_LockHeld(*timer);
         }
 
-        HeapCheck_Dbg();
-        return;
+        timer = next;
     }
 }
 
-void TimerQueue::HeapAdjustDown_LockHeld(size_t nodeIndex)
+uint64 TimerQueue::NextEventTick_LockHeld() const
 {
-    for(;;)
+    // Timers on a level are all within the current slot of the level above, so
+    // the lowest occupied level always has the earliest event
+    for (uint level = 0; level < WheelLevels; ++level)
     {
-        auto leftChildIndex = HeapNodeLeftChildIndex(nodeIndex); 
-        if (leftChildIndex >= heap_.size())
+        uint const shift = level * WheelSlotBits;
+        uint64 const currentSlot = currentTick_ >> shift;
+        auto offset = FindNextOccupied(occupied_[level], BitmapWords, (currentSlot + 1) & WheelSlotMask);
+        if (offset >= 0)
         {
-            HeapCheck_Dbg();
-            return;
+            return (currentSlot + 1 + offset) << shift;
         }
+    }
+
+    if (overflow_.Head)
+    {
+        uint const shift = WheelLevels * WheelSlotBits;
+        return ((currentTick_ >> shift) + 1) << shift;
+    }
 
-        auto leftChildDueTime = heap_[leftChildIndex]->DueTime();
-        auto rightChildIndex = HeapNodeRightChildIndex(nodeIndex); 
-        auto rightChildDueTime = (rightChildIndex < heap_.size()) ? heap_[rightChildIndex]->DueTime() : StopwatchTime::MaxValue;
+    return NoTick;
+}
 
-        bool minOnLeft = (leftChildDueTime <= rightChildDueTime);
-        auto minChildDueTime = minOnLeft? leftChildDueTime : rightChildDueTime; 
+void TimerQueue::AdvanceTo_LockHeld(uint64 tick, vector<TimerSPtr> & expired)
+{
+    for (auto next = NextEventTick_LockHeld(); next <= tick; next = NextEventTick_LockHeld())
+    {
+        currentTick_ = next;
 
-        if (heap_[nodeIndex]->DueTime() <= minChildDueTime)
+        // Cascade from the top so that timers moved down are picked up by lower levels on the same tick
+        if ((next & ((1ULL << (WheelLevels * WheelSlotBits)) - 1)) == 0)
         {
-            HeapCheck_Dbg();
-            return;
+            Cascade_LockHeld(overflow_, expired);
         }
 
-        if (minOnLeft)
+        for (uint level = WheelLevels - 1; level > 0; --level)
         {
-            HeapNodeSwap_LockHeld(nodeIndex, leftChildIndex);
-            nodeIndex = leftChildIndex;
-            continue;
+            uint const shift = level * WheelSlotBits;
+            if ((next & ((1ULL << shift) - 1)) == 0)
+            {
+                Cascade_LockHeld(wheel_[level][(next >> shift) & WheelSlotMask], expired);
+            }
         }
 
-        Invariant(rightChildIndex < heap_.size());
-        HeapNodeSwap_LockHeld(nodeIndex, rightChildIndex);
-        nodeIndex = rightChildIndex;
+        Cascade_LockHeld(wheel_[0][next & WheelSlotMask], expired);
+    }
+
+    // No event is left up to tick, so every queued timer keeps its level relative to tick
+    currentTick_ = max(currentTick_, tick);
+}
+
+void TimerQueue::ScheduleNextEvent_LockHeld(StopwatchTime now)
+{
+    auto next = NextEventTick_LockHeld();
+    if (next >= armedTick_)
+    {
+        return;
     }
+
+    armedTick_ = next;
+    SetTimer(ToStopwatchTime(next) - now);
 }
 
 template <typename TSPtr>
@@ -201,37 +285,36 @@ void TimerQueue::EnqueueT(TSPtr && timer, TimeSpan t)
 {
     WriteNoise(TraceType, "{0}: Enqueue, due in {1}", TextTracePtr(timer.get()), t);
     Invariant(timer);
-    StopwatchTime dueTime = Stopwatch::Now() + t;
+    auto now = Stopwatch::Now();
+    StopwatchTime dueTime = now + t;
+    auto & queuedTimer = *timer;
     {
         AcquireWriteLock grab(lock_);
 
-        bool shouldScheduleTimer = heap_.empty() || (dueTime < heap_.front()->DueTime());
-
-        bool dueTimeIncreased = timer->DueTime() < dueTime; 
-        if (timer->ShouldAddToHeap(dueTime))
+        if (queuedTimer.IsQueued())
         {
-            auto nodeIndex = heap_.size();
-            timer->SetHeapIndex(nodeIndex);
-            heap_.emplace_back(std::forward<TSPtr>(timer));
-            HeapAdjustUp_LockHeld(nodeIndex); //timer may have been moved by statement above
+            Unlink_LockHeld(queuedTimer);
         }
         else
         {
-            Invariant(!heap_.empty());
-            if (dueTimeIncreased)
-            {
-                HeapAdjustDown_LockHeld(timer->HeapIndex());
-            }
-            else
-            {
-                HeapAdjustUp_LockHeld(timer->HeapIndex());
-            }
+            queuedTimer.self_ = std::forward<TSPtr>(timer); //timer may have been moved
+        }
+
+        if (wheelTimerCount_ == 0)
+        {
+            // Nothing to cascade, catch up with the clock so that the timer is placed relative to now
+            currentTick_ = max(currentTick_, ToTickFloor(now));
         }
 
-        if (shouldScheduleTimer)
+        queuedTimer.dueTime_ = dueTime;
+        queuedTimer.dueTick_ = ToTickCeiling(dueTime);
+        if (queuedTimer.dueTick_ <= currentTick_)
         {
-            SetTimer(t);
+            queuedTimer.dueTick_ = currentTick_ + 1;
         }
+
+        Place_LockHeld(queuedTimer);
+        ScheduleNextEvent_LockHeld(now);
     }
 }
 
@@ -254,42 +337,20 @@ bool TimerQueue::Dequeue(TimerSPtr const & timer)
 {
     Invariant(timer);
 
-    AcquireWriteLock grab(lock_);
-
-    if (!timer->IsInHeap())
+    TimerSPtr queueReference;
     {
-        WriteNoise(TraceType, "{0}: Dequeue: false", TextTracePtr(timer.get()));
-        return false;
-    }
-
-    Invariant(!heap_.empty());
-
-    if (heap_.back() == timer)
-    {
-        timer->ClearHeapIndex();
-        heap_.pop_back();
-        WriteNoise(TraceType, "{0}: Dequeue: true", TextTracePtr(timer.get()));
-        return true;
-    }
-
-    Invariant(heap_.back()->HeapIndex() != timer->HeapIndex());
-
-    //timer node and back() has no ancestor-descendent relationship
-    bool shouldAdjustUp = heap_.back()->DueTime() < timer->DueTime();
+        AcquireWriteLock grab(lock_);
 
-    auto heapIndex = timer->ClearHeapIndex();
-    heap_.back()->SetHeapIndex(heapIndex);
-    heap_[heapIndex] = move(heap_.back()); //replaced *(heap_[heapIndex]) will not destruct under lock because caller has "timer"
-    heap_.pop_back();
+        if (!timer->IsQueued())
+        {
+            WriteNoise(TraceType, "{0}: Dequeue: false", TextTracePtr(timer.get()));
+            return false;
+        }
 
-    if (shouldAdjustUp)
-    {
-        HeapAdjustUp_LockHeld(heapIndex);
-        WriteNoise(TraceType, "{0}: Dequeue: true", TextTracePtr(timer.get()));
-        return true;
+        Unlink_LockHeld(*timer);
+        queueReference = move(timer->self_);
     }
 
-    HeapAdjustDown_LockHeld(heapIndex);
     WriteNoise(TraceType, "{0}: Dequeue: true", TextTracePtr(timer.get()));
     return true;
 }
@@ -301,61 +362,60 @@ void TimerQueue::FireDueTimers()
     {
         AcquireWriteLock grab(lock_);
 
-        while(!heap_.empty() && (heap_.front()->DueTime() <= now))
-        {
-            auto idx = heap_.front()->ClearHeapIndex();
-            Invariant(idx == 0);
+        AdvanceTo_LockHeld(ToTickFloor(now), timersToFire);
 
-            WriteNoise(
-                TraceType,
-                "{0}: {1} '{2}': calling callback,  asyncDispatch_ = {3}",
-                TextTraceThis, TextTracePtr(heap_.front().get()), heap_.front()->Tag(), asyncDispatch_);
+        // posix timer is one-shot, it is no longer armed once fired
+        armedTick_ = NoTick;
+        ScheduleNextEvent_LockHeld(now);
+    }
 
-            if (asyncDispatch_)
-            {
-               Threadpool::Post([timerToFire = move(heap_.front())] { timerToFire->Fire(); });
-            }
-            else
-            {
-                timersToFire.emplace_back(move(heap_.front()));
-            }
+    WriteNoise(
+        TraceType,
+        "{0}: {1} timers due, asyncDispatch_ = {2}",
+        TextTraceThis, timersToFire.size(), asyncDispatch_);
 
-            if (heap_.size() > 1)
-            {
-                heap_.front() = move(heap_.back()); 
-                heap_.front()->SetHeapIndex(0);
-                heap_.pop_back();
+    DispatchTimers(move(timersToFire));
+}
 
-                HeapAdjustDown_LockHeld(0);
-                continue;
-            }
+void TimerQueue::DispatchTimers(vector<TimerSPtr> && timersToFire)
+{
+    if (timersToFire.empty())
+    {
+        return;
+    }
 
-            heap_.pop_back();
-        }
+    if (!asyncDispatch_)
+    {
+        FireTimers(timersToFire, dispatchTimeThreshold_);
+        return;
+    }
 
-        if (!heap_.empty())
-        {
-            SetTimer(heap_.front()->DueTime() - now); 
-        }
+    // Fire expired timers in batches to bound the number of threadpool callbacks when many timers expire on the same tick
+    for (size_t begin = 0; begin < timersToFire.size(); begin += dispatchBatchSize_)
+    {
+        auto end = min(begin + dispatchBatchSize_, timersToFire.size());
+        vector<TimerSPtr> batch(make_move_iterator(timersToFire.begin() + begin), make_move_iterator(timersToFire.begin() + end));
+
+        Threadpool::Post([batch = move(batch), threshold = dispatchTimeThreshold_] { FireTimers(batch, threshold); });
     }
+}
 
-    if (!timersToFire.empty())
+void TimerQueue::FireTimers(vector<TimerSPtr> const & timersToFire, TimeSpan dispatchTimeThreshold)
+{
+    auto beforeDispatch = Stopwatch::Now();
+    for(auto const & timerToFire : timersToFire)
     {
-        auto beforeDispatch = Stopwatch::Now();
-        for(auto const & timerToFire : timersToFire)
+        timerToFire->Fire();
+        auto afterDispatch = Stopwatch::Now();
+        if ((afterDispatch - beforeDispatch) >= dispatchTimeThreshold)
         {
-            timerToFire->Fire();
-            auto afterDispatch = Stopwatch::Now();
-            if ((afterDispatch - beforeDispatch) >= dispatchTimeThreshold_)
-            {
-                WriteInfo(
-                    TraceType,
-                    "{0}: {1} '{2}': slow callback, dispatchTimeThreshold_ = {3}", 
-                    TextTraceThis, TextTracePtr(timerToFire.get()), timerToFire->Tag(), dispatchTimeThreshold_);
-            }
-
-            beforeDispatch = afterDispatch;
+            WriteInfo(
+                TraceType,
+                "{0} '{1}': slow callback, dispatchTimeThreshold = {2}",
+                TextTracePtr(timerToFire.get()), timerToFire->Tag(), dispatchTimeThreshold);
         }
+
+        beforeDispatch = afterDispatch;
     }
 }
 
@@ -364,13 +424,40 @@ TimerQueue::TimerSPtr TimerQueue::CreateTimer(Common::StringLiteral const tag, C
     return make_shared<Timer>(this, tag, callback);
 }
 
-TimerQueue::TimerQueue(bool asyncDispatch) : asyncDispatch_(asyncDispatch), dispatchTimeThreshold_(CommonConfig::GetConfig().TimerQueueDispatchTimeThreshold)
+TimerQueue::TimerQueue(bool asyncDispatch)
+    : wheelTimerCount_(0)
+    , currentTick_(0)
+    , armedTick_(NoTick)
+    , tickTicks_(CommonConfig::GetConfig().TimerQueueTickInterval.Ticks)
+    , asyncDispatch_(asyncDispatch)
+    , dispatchTimeThreshold_(CommonConfig::GetConfig().TimerQueueDispatchTimeThreshold)
+    , dispatchBatchSize_(CommonConfig::GetConfig().TimerQueueDispatchBatchSize)
 {
-    WriteInfo(TraceType, "{0}: asyncDispatch_ = {1}, dispatchTimeThreshold_  = {2}", TextTraceThis, asyncDispatch_, dispatchTimeThreshold_); 
+    WriteInfo(
+        TraceType,
+        "{0}: asyncDispatch_ = {1}, dispatchTimeThreshold_  = {2}, tick = {3}, dispatchBatchSize_ = {4}",
+        TextTraceThis, asyncDispatch_, dispatchTimeThreshold_, TimeSpan::FromTicks(tickTicks_), dispatchBatchSize_);
+
+    for (uint level = 0; level < WheelLevels; ++level)
+    {
+        for (uint index = 0; index < WheelSlots; ++index)
+        {
+            wheel_[level][index].Level = level;
+            wheel_[level][index].Index = index;
+        }
+
+        for (uint word = 0; word < BitmapWords; ++word)
+        {
+            occupied_[level][word] = 0;
+        }
+    }
+
+    overflow_.Level = WheelLevels;
+    parked_.Level = WheelLevels + 1;
+    currentTick_ = ToTickFloor(Stopwatch::Now());
 
     InitSignalPipe();
     CreatePosixTimer();
-    heap_.reserve(200000);
 }
 
 void TimerQueue::InitSignalPipe()
@@ -40,20 +40,56 @@ namespace Common
         void SignalPipeLoop();
         void SetTimer(Common::TimeSpan dueTime);
         void FireDueTimers();
+        void DispatchTimers(std::vector<TimerSPtr> && timersToFire);
+        static void FireTimers(std::vector<TimerSPtr> const & timersToFire, TimeSpan dispatchTimeThreshold);
 
-        void HeapAdjustUp_LockHeld(size_t nodeIndex);
-        void HeapAdjustDown_LockHeld(size_t nodeIndex);
-        void HeapNodeSwap_LockHeld(size_t index1, size_t index2);
-        void HeapCheck_Dbg();
+        // Hierarchical timing wheel, "Hashed and Hierarchical Timing Wheels" (Varghese & Lauck). Level L has
+        // WheelSlots slots of WheelSlots^L ticks each. A timer is placed on the lowest level whose slot span covers
+        // its distance to the current tick, and is cascaded to lower levels as the wheel advances. Arm and cancel are
+        // O(1) list operations, the next expiration is found through per level slot occupancy bitmaps.
+        static const uint WheelLevels = 4;
+        static const uint WheelSlotBits = 8;
+        static const uint WheelSlots = 1 << WheelSlotBits;
+        static const uint WheelSlotMask = WheelSlots - 1;
+        static const uint BitmapWords = WheelSlots / 64;
+        static const uint64 NoTick = UINT64_MAX;
+
+        struct TimerList
+        {
+            Timer* Head = nullptr;
+            uint Level = 0;
+            uint Index = 0;
+        };
+
+        uint64 ToTickCeiling(StopwatchTime time) const;
+        uint64 ToTickFloor(StopwatchTime time) const;
+        StopwatchTime ToStopwatchTime(uint64 tick) const;
+
+        void Link_LockHeld(Timer & timer, TimerList & list);
+        void Unlink_LockHeld(Timer & timer);
+        void Place_LockHeld(Timer & timer);
+        void Expire_LockHeld(Timer & timer, std::vector<TimerSPtr> & expired);
+        void Cascade_LockHeld(TimerList & list, std::vector<TimerSPtr> & expired);
+        uint64 NextEventTick_LockHeld() const;
+        void AdvanceTo_LockHeld(uint64 tick, std::vector<TimerSPtr> & expired);
+        void ScheduleNextEvent_LockHeld(StopwatchTime now);
 
         mutable Common::RwLock lock_;
 
         timer_t timer_;
         int pipeFd_[2];
 
-        std::vector<TimerSPtr> heap_;
+        TimerList wheel_[WheelLevels][WheelSlots];
+        uint64 occupied_[WheelLevels][BitmapWords];
+        TimerList overflow_; // beyond the span of the top level
+        TimerList parked_; // due at StopwatchTime::MaxValue, never fire
+        size_t wheelTimerCount_;
+        uint64 currentTick_;
+        uint64 armedTick_;
+        const int64 tickTicks_;
 
         const bool asyncDispatch_;
         const TimeSpan dispatchTimeThreshold_;
+        const size_t dispatchBatchSize_;
     };
 }
@@ -2,6 +2,18 @@
 
 // https://msdn.microsoft.com/en-us/library/dd905031.aspx
 
+#if defined(_M_X64) || defined(__x86_64__)
+#define CRC32_CLMUL_SUPPORTED 1
+#if defined(PLATFORM_UNIX)
+#include <cpuid.h>
+#include <immintrin.h>
+#define CRC32_CLMUL_TARGET __attribute__((target("pclmul")))
+#else
+#include <intrin.h>
+#define CRC32_CLMUL_TARGET
+#endif
+#endif
+
 namespace Common
 {
     const uint32_t crc32::table_[256] = {
@@ -71,6 +83,130 @@ namespace Common
         0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
     };
 
+#if defined(CRC32_CLMUL_SUPPORTED)
+
+    static bool IsCrc32ClmulSupported()
+    {
+        unsigned int ecx = 0;
+
+#if defined(PLATFORM_UNIX)
+        unsigned int eax, ebx, edx;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+        {
+            return false;
+        }
+#else
+        int cpuInfo[4];
+        __cpuid(cpuInfo, 1);
+        ecx = static_cast<unsigned int>(cpuInfo[2]);
+#endif
+
+        // CPUID.1:ECX bit 1 is PCLMULQDQ
+        return (ecx & (1u << 1)) != 0;
+    }
+
+    static const bool Crc32UseClmul = IsCrc32ClmulSupported();
+
+    // The CRC is reflected, so the constants are reflect32(x^n mod P) << 1 to absorb the one bit
+    // shift of the 64 x 64 carry-less product. Low qword multiplies the low (earlier) half.
+    CRC32_CLMUL_TARGET
+    static inline __m128i FoldCrc32(__m128i x, __m128i constants, __m128i next)
+    {
+        __m128i low = _mm_clmulepi64_si128(x, constants, 0x00);
+        __m128i high = _mm_clmulepi64_si128(x, constants, 0x11);
+        return _mm_xor_si128(_mm_xor_si128(low, high), next);
+    }
+
+    CRC32_CLMUL_TARGET
+    static inline __m128i LoadCrc32Block(uint8_t const* buf)
+    {
+        return _mm_loadu_si128(reinterpret_cast<__m128i const*>(buf));
+    }
+
+    CRC32_CLMUL_TARGET
+    static uint32_t UpdateCrc32Clmul(uint32_t value, uint8_t const* buf, size_t len)
+    {
+        // x^544, x^480 (fold by 64 bytes) and x^160, x^96 (fold by 16 bytes)
+        __m128i const fold4 = _mm_set_epi64x(0x1C6E41596, 0x154442BD4);
+        __m128i const fold1 = _mm_set_epi64x(0x0CCAA009E, 0x1751997D0);
+
+        __m128i x0 = _mm_xor_si128(LoadCrc32Block(buf), _mm_cvtsi32_si128(static_cast<int>(value)));
+        __m128i x1 = LoadCrc32Block(buf + 16);
+        __m128i x2 = LoadCrc32Block(buf + 32);
+        __m128i x3 = LoadCrc32Block(buf + 48);
+
+        buf += 64;
+        len -= 64;
+
+        while (len >= 64)
+        {
+            x0 = FoldCrc32(x0, fold4, LoadCrc32Block(buf));
+            x1 = FoldCrc32(x1, fold4, LoadCrc32Block(buf + 16));
+            x2 = FoldCrc32(x2, fold4, LoadCrc32Block(buf + 32));
+            x3 = FoldCrc32(x3, fold4, LoadCrc32Block(buf + 48));
+
+            buf += 64;
+            len -= 64;
+        }
+
+        __m128i x = FoldCrc32(x0, fold1, x1);
+        x = FoldCrc32(x, fold1, x2);
+        x = FoldCrc32(x, fold1, x3);
+
+        while (len >= 16)
+        {
+            x = FoldCrc32(x, fold1, LoadCrc32Block(buf));
+
+            buf += 16;
+            len -= 16;
+        }
+
+        // The 16 byte remainder already includes the running value, finish it with the table
+        uint8_t remainder[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(remainder), x);
+
+        value = 0;
+        for (auto b : remainder)
+        {
+            value = crc32::table_[(value ^ b) & 0xFF] ^ (value >> 8);
+        }
+
+        while (len--)
+        {
+            value = crc32::table_[(value ^ *(buf++)) & 0xFF] ^ (value >> 8);
+        }
+
+        return value;
+    }
+
+#endif
+
+    bool crc32::IsHardwareAccelerated()
+    {
+#if defined(CRC32_CLMUL_SUPPORTED)
+        return Crc32UseClmul;
+#else
+        return false;
+#endif
+    }
+
+    uint32_t crc32::UpdateFolded(uint32_t value, uint8_t const* buf, size_t len)
+    {
+#if defined(CRC32_CLMUL_SUPPORTED)
+        if (Crc32UseClmul)
+        {
+            return UpdateCrc32Clmul(value, buf, len);
+        }
+#endif
+
+        while (len--)
+        {
+            value = table_[(value ^ *(buf++)) & 0xFF] ^ (value >> 8);
+        }
+
+        return value;
+    }
+
     const unsigned char crc8::table_[256] = {
         0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b, 0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d,
         0x70, 0x77, 0x7e, 0x79, 0x6c, 0x6b, 0x62, 0x65, 0x48, 0x4f, 0x46, 0x41, 0x54, 0x53, 0x5a, 0x5d,
@@ -21,6 +21,12 @@ namespace Common
         inline void AddData(void const* buf, size_t len)
         {
             auto cursor = (const uint8_t *)buf;
+            if (len >= FoldThreshold)
+            {
+                value_ = UpdateFolded(value_, cursor, len);
+                return;
+            }
+
             while (len--)
             {
                 value_ = table_[(value_ ^ *(cursor++)) & 0xFF] ^ (value_ >> 8);
@@ -29,9 +35,18 @@ namespace Common
 
         inline auto Value() const { return value_ ^ ~0U; }
 
+        static bool IsHardwareAccelerated();
+
         uint32_t value_ = ~0U;
 
         static const uint32_t table_[256];
+
+    private:
+        // Shorter inputs stay on the inline table loop
+        static const size_t FoldThreshold = 64;
+
+        // PCLMULQDQ folding when the CPU supports it, table loop otherwise
+        static uint32_t UpdateFolded(uint32_t value, uint8_t const* buf, size_t len);
     };
 
     class crc8
@@ -70,6 +70,35 @@ namespace Common
         LEAVE;
     }
 
+    BOOST_AUTO_TEST_CASE(long32)
+    {
+        ENTER;
+
+        // Long enough to go through the folded path when the CPU supports it
+        vector<uint8_t> data(1000);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            data[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+
+        Trace.WriteInfo(TraceType, "hardware accelerated = {0}", crc32::IsHardwareAccelerated());
+
+        crc32 c1(data.data(), data.size());
+        Trace.WriteInfo(TraceType, "c1 = {0:x}", c1.Value());
+        VERIFY_IS_TRUE(c1.Value() == 0x8902161E);
+
+        // Any split of the input, including ones that leave short pieces on the table path, gives the same value
+        for (size_t split = 0; split <= data.size(); split += 37)
+        {
+            crc32 c2;
+            c2.AddData(data.data(), split);
+            c2.AddData(data.data() + split, data.size() - split);
+            VERIFY_IS_TRUE(c2.Value() == c1.Value());
+        }
+
+        LEAVE;
+    }
+
     BOOST_AUTO_TEST_CASE(basic8)
     {
         ENTER;
@@ -7,6 +7,7 @@
 #include <sys/epoll.h>
 #include "Common/EventLoop.h"
 #include "Transport/IoBuffer.h"
+#include "Transport/FrameCompressionHeader.h"
 #include "Transport/SendBuffer.h"
 #include "Transport/ReceiveBuffer.h"
 #include "Transport/IBufferFactory.h"
@@ -124,7 +124,7 @@ void CentralSecretServiceReplica::AddHandler(
     StartRequestProcessHandler const & startHandler,
     CompleteRequestProcessHandler const & completeHandler)
 {
-    this->requestHandlers_.insert(make_pair(action, CentralSecretServiceReplica::RequestProcessor(startHandler, completeHandler)));
+    this->requestHandlers_.Add(action, CentralSecretServiceReplica::RequestProcessor(startHandler, completeHandler));
 }
 
 
@@ -289,11 +289,11 @@ void CentralSecretServiceReplica::ProcessMessage(
     auto activityId = FabricActivityHeader::FromMessage(*request).ActivityId;
     auto messageId = request->MessageId;
 
-    auto handler = this->requestHandlers_.find(request->Action);
+    auto handler = this->requestHandlers_.Find(*request);
 
-    if (handler != this->requestHandlers_.end())
+    if (handler != nullptr)
     {
-        auto requestProcessor = handler->second;
+        auto requestProcessor = *handler;
 
         auto operation = requestProcessor.StartHandler(
             *this,
@@ -122,7 +122,7 @@ namespace Management
             // The reference of the RoutingAgentProxy is held by CentralSecretServiceFactory
             SystemServices::ServiceRoutingAgentProxy & routingAgentProxy_;
 
-            unordered_map<wstring, RequestProcessor> requestHandlers_;
+            Transport::ActionDispatchTable<RequestProcessor> requestHandlers_;
         };
     }
 }
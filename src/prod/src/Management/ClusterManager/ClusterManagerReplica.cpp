@@ -5401,7 +5401,7 @@ void ClusterManagerReplica::Initialize()
 
 void ClusterManagerReplica::InitializeRequestHandlers()
 {
-    map<wstring, ProcessRequestHandler> t;
+    ActionDispatchTable<ProcessRequestHandler> t;
 
     this->AddHandler(t, ClusterManagerTcpMessage::ProvisionApplicationTypeAction, CreateHandler<ProvisionApplicationTypeAsyncOperation>);
     this->AddHandler(t, ClusterManagerTcpMessage::CreateApplicationAction, CreateHandler<CreateApplicationAsyncOperation>);
@@ -5441,9 +5441,9 @@ void ClusterManagerReplica::InitializeRequestHandlers()
     requestHandlers_.swap(t);
 }
 
-void ClusterManagerReplica::AddHandler(map<wstring, ProcessRequestHandler> & temp, wstring const & action, ProcessRequestHandler const & handler)
+void ClusterManagerReplica::AddHandler(ActionDispatchTable<ProcessRequestHandler> & temp, wstring const & action, ProcessRequestHandler const & handler)
 {
-    temp.insert(make_pair(action, handler));
+    temp.Add(action, handler);
 }
 
 template <class TAsyncOperation>
@@ -8096,10 +8096,10 @@ AsyncOperationSPtr ClusterManagerReplica::BeginProcessRequest(
     }
     else
     {
-        auto it = requestHandlers_.find(request->Action);
-        if (it != requestHandlers_.end())
+        auto handler = requestHandlers_.Find(*request);
+        if (handler != nullptr)
         {
-            return (it->second)(
+            return (*handler)(
                 *this,
                 request,
                 requestContext,
@@ -682,7 +682,7 @@ namespace Management
             void Initialize();
             void InitializeRequestHandlers();
             void AddHandler(
-                std::map<std::wstring, ProcessRequestHandler> & temp,
+                Transport::ActionDispatchTable<ProcessRequestHandler> & temp,
                 std::wstring const &,
                 ProcessRequestHandler const &);
 
@@ -845,7 +845,7 @@ namespace Management
             std::wstring nodeName_;
             std::unique_ptr<RolloutManager> rolloutManagerUPtr_;
 
-            std::map<std::wstring, ProcessRequestHandler> requestHandlers_;
+            Transport::ActionDispatchTable<ProcessRequestHandler> requestHandlers_;
 
             Naming::StringRequestInstanceTrackerUPtr stringRequestTrackerUPtr_;
             Naming::NameRequestInstanceTrackerUPtr nameRequestTrackerUPtr_;
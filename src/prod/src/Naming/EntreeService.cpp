@@ -389,7 +389,7 @@ namespace Naming
 
     void EntreeService::InitializeHandlers(bool isInZombieMode)
     {
-        map<wstring, ProcessRequestHandler> t;
+        ActionDispatchTable<ProcessRequestHandler> t;
 
         if (!isInZombieMode)
         {
@@ -461,9 +461,9 @@ namespace Naming
         requestHandlers_.swap(t);
     }
 
-    void EntreeService::AddHandler(map<wstring, ProcessRequestHandler> & temp, wstring const & action, ProcessRequestHandler const & handler)
+    void EntreeService::AddHandler(ActionDispatchTable<ProcessRequestHandler> & temp, wstring const & action, ProcessRequestHandler const & handler)
     {
-        temp.insert(std::make_pair(action, handler));
+        temp.Add(action, handler);
     }
 
     template <class TAsyncOperation>
@@ -490,10 +490,10 @@ namespace Naming
     {
         auto const & action = request->Action;
 
-        auto it = requestHandlers_.find(action);
-        if (it != requestHandlers_.end())
+        auto handler = requestHandlers_.Find(*request);
+        if (handler != nullptr)
         {
-            return (it->second)(this->Properties, request, timeout, callback, parent);
+            return (*handler)(this->Properties, request, timeout, callback, parent);
         }
         else
         {
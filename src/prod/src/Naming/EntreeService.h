@@ -216,7 +216,7 @@ namespace Naming
         void InitializeHandlers(bool);
 
         void AddHandler(
-            std::map<std::wstring, ProcessRequestHandler> & temp,
+            Transport::ActionDispatchTable<ProcessRequestHandler> & temp,
             std::wstring const &, 
             ProcessRequestHandler const &);
 
@@ -253,7 +253,7 @@ namespace Naming
         GatewayPropertiesSPtr properties_;        
 
         std::wstring listenAddress_;
-        std::map<std::wstring, ProcessRequestHandler> requestHandlers_;
+        Transport::ActionDispatchTable<ProcessRequestHandler> requestHandlers_;
 
         //
         // *** Sub-components
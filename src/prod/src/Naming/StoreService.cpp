@@ -289,7 +289,7 @@ namespace Naming
 
     void StoreService::InitializeHandlers()
     {
-        map<wstring, ProcessRequestHandler> t;
+        ActionDispatchTable<ProcessRequestHandler> t;
 
         this->AddHandler(t, NamingTcpMessage::CreateNameAction, CreateHandler<ProcessCreateNameRequestAsyncOperation>);
         this->AddHandler(t, NamingTcpMessage::DeleteNameAction, CreateHandler<ProcessDeleteNameRequestAsyncOperation>);
@@ -311,9 +311,9 @@ namespace Naming
         requestHandlers_.swap(t);
     }
 
-    void StoreService::AddHandler(map<wstring, ProcessRequestHandler> & temp, wstring const & action, ProcessRequestHandler const & handler)
+    void StoreService::AddHandler(ActionDispatchTable<ProcessRequestHandler> & temp, wstring const & action, ProcessRequestHandler const & handler)
     {
-        temp.insert(make_pair(action, handler));
+        temp.Add(action, handler);
     }
 
     template <class TAsyncOperation>
@@ -344,10 +344,10 @@ namespace Naming
 
         auto const & action = request->Action;
 
-        auto it = requestHandlers_.find(action);
-        if (it != requestHandlers_.end())
+        auto handler = requestHandlers_.Find(*request);
+        if (handler != nullptr)
         {
-            return (it->second)(
+            return (*handler)(
                 request, 
                 *namingStoreUPtr_,
                 *propertiesUPtr_,
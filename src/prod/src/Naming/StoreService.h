@@ -124,7 +124,7 @@ namespace Naming
         void InitializeHandlers();
 
         void AddHandler(
-            std::map<std::wstring, ProcessRequestHandler> & temp,
+            Transport::ActionDispatchTable<ProcessRequestHandler> & temp,
             std::wstring const &, 
             ProcessRequestHandler const &);
 
@@ -173,7 +173,7 @@ namespace Naming
         Reliability::FederationWrapper & federation_;
         SystemServices::SystemServiceLocation serviceLocation_;
         SystemServices::SystemServiceMessageFilterSPtr messageFilterSPtr_;
-        std::map<std::wstring, ProcessRequestHandler> requestHandlers_;
+        Transport::ActionDispatchTable<ProcessRequestHandler> requestHandlers_;
 
         // We need to ensure that if a name has tentative state associated with it,
         // then there is either a pending request or repair on that name. This greatly simplifies
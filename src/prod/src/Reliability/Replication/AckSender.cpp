@@ -29,6 +29,7 @@ AckSender::AckSender(
         partitionId_(partitionId),
         endpointUniqueId_(endpointUniqueId),
         sendCallback_(),
+        coalesceCallback_(),
         lastTraceTime_(),
         isActive_(false),
         forceSendAckOnMaxPendingItems_(
@@ -63,12 +64,14 @@ DateTime AckSender::get_LastAckSentAt() const
 
 void AckSender::Open(
     Common::ComponentRoot const & root, 
-    SendCallback const & sendCallback)
+    SendCallback const & sendCallback,
+    SendCallback const & coalesceCallback)
 {
     ASSERT_IF(config_->BatchAcknowledgementInterval < TimeSpan::Zero, "{0}: BatchAcknowledgementInterval can't be negative", endpointUniqueId_);
     ASSERT_IF(config_->BatchAcknowledgementInterval >= config_->RetryInterval, "BatchAcknowledgementInterval must be less than RetryInterval");
 
-    bool createTimer = config_->BatchAcknowledgementInterval > TimeSpan::Zero;
+    bool coalesce = coalesceCallback && config_->AckCoalescingLatencySlo > TimeSpan::Zero;
+    bool createTimer = !coalesce && config_->BatchAcknowledgementInterval > TimeSpan::Zero;
     ReplicatorEventSource::Events->AckSenderPolicy(
         partitionId_, 
         endpointUniqueId_,
@@ -93,6 +96,7 @@ void AckSender::Open(
         }
 
         sendCallback_ = sendCallback;
+        coalesceCallback_ = coalesce ? coalesceCallback : nullptr;
     }
 }
 
@@ -151,6 +155,7 @@ void AckSender::OnTimerCallback()
 void AckSender::ScheduleOrSendAck(bool forceSend)
 {
     bool sendNow = true;
+    bool coalesceNow = false;
     bool callTraceMethod = false;
 
     {
@@ -195,13 +200,19 @@ void AckSender::ScheduleOrSendAck(bool forceSend)
         }
         else
         {
+            // The transport delays the ACK at most AckCoalescingLatencySlo
+            coalesceNow = coalesceCallback_ && !forceSend;
             lastAckSentAt_ = DateTime::Now();
         }
 
         callTraceMethod = ShouldTraceCallerHoldsLock();
     }
  
-    if (sendNow)
+    if (coalesceNow)
+    {
+        coalesceCallback_(callTraceMethod);
+    }
+    else if (sendNow)
     {
         // AckSender is active and the callback should be sent immediately
         sendCallback_(callTraceMethod);
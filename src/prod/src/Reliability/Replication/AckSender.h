@@ -10,7 +10,8 @@ namespace Reliability
     namespace ReplicationComponent
     {
         // Class responsible with sending ACKs
-        // either on timer or immediately, based on the configuration
+        // either on timer, immediately or through the per node
+        // ACK coalescing of the transport, based on the configuration
         // settings.
         class AckSender 
         {
@@ -32,7 +33,8 @@ namespace Reliability
 
             void Open(
                 Common::ComponentRoot const & root,
-                SendCallback const & sendCallback);
+                SendCallback const & sendCallback,
+                SendCallback const & coalesceCallback = nullptr);
             void Close();
 
             void ScheduleOrSendAck(bool forceSend);
@@ -47,6 +49,8 @@ namespace Reliability
             ReplicationEndpointId const endpointUniqueId_; 
             Common::Guid const partitionId_;
             SendCallback sendCallback_;
+            // Set when AckCoalescingLatencySlo is enabled; replaces the batch timer
+            SendCallback coalesceCallback_;
             bool isActive_;
             
             Common::Stopwatch lastTraceTime_;
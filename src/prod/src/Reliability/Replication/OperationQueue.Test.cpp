@@ -45,6 +45,8 @@ namespace ReplicationUnitTest
         __declspec(property(get = get_Queue)) OperationQueue const & InnerQueue;
         OperationQueue const & get_Queue() const { return queue_; }
 
+        void SetFixedCapacity(bool value) { queue_.FixedCapacity = value; }
+
         void Enqueue(vector<FABRIC_SEQUENCE_NUMBER> const & seqNumbers, FABRIC_SEQUENCE_NUMBER lastSN, bool capacityChange, FABRIC_SEQUENCE_NUMBER cleanedCompletedItems, ULONGLONG totalMemorySize=(ULONGLONG)-1, ULONGLONG completedMemorySize=(ULONGLONG)-1, FABRIC_SEQUENCE_NUMBER numberOfDroppedOperation = 0)
         {
             Enqueue(seqNumbers, lastSN, 100, capacityChange, cleanedCompletedItems, totalMemorySize, completedMemorySize, numberOfDroppedOperation);
@@ -604,6 +606,44 @@ namespace ReplicationUnitTest
         queue.DiscardPendingOperations(true);
     }
 
+    BOOST_AUTO_TEST_CASE(TestEnqueueOperationsFixedCapacity)
+    {
+        FABRIC_SEQUENCE_NUMBER startSeq = 1;
+        config_->InitialSecondaryReplicationQueueSize = 4;
+        int max = 16;
+        config_->MaxSecondaryReplicationQueueSize = max;
+        config_->MaxSecondaryReplicationQueueMemorySize = 0;
+
+        OperationQueueWrapper queue(config_, startSeq, true /*cleanOnComplete*/, true /*ignoreCommit*/);
+        queue.SetFixedCapacity(true);
+        VERIFY_IS_TRUE(queue.InnerQueue.FixedCapacity);
+        VERIFY_ARE_EQUAL(static_cast<ULONGLONG>(max), queue.InnerQueue.Capacity);
+        ULONGLONG capacityChangeCount = queue.InnerQueue.CapacityChangeCount;
+
+        // The queue is filled and drained several times without being resized
+        for (int i = 0; i < 3; ++i)
+        {
+            queue.Enqueue(max, startSeq + max, false /*capacityChange*/, 0 /*cleanedCompletedItems*/);
+            queue.Complete(max, startSeq + max, false /*capacityChange*/);
+            startSeq += max;
+        }
+
+        VERIFY_ARE_EQUAL(static_cast<ULONGLONG>(max), queue.InnerQueue.Capacity);
+        VERIFY_ARE_EQUAL(capacityChangeCount, queue.InnerQueue.CapacityChangeCount);
+    }
+
+    BOOST_AUTO_TEST_CASE(TestMoveFixedCapacityQueue)
+    {
+        OperationQueue queue(PartitionId, L"OperationQueueTest", 4, 16, 0, 0, 0, false, true /*cleanOnComplete*/, true /*ignoreCommit*/, 1, nullptr);
+        queue.FixedCapacity = true;
+        VERIFY_ARE_EQUAL(static_cast<ULONGLONG>(16), queue.Capacity);
+
+        // The queue keeps its fixed capacity when it is moved with new limits
+        OperationQueue moved(L"OperationQueueTestMoved", move(queue), 4, 32, 0, 0, 0, true /*cleanOnComplete*/, nullptr);
+        VERIFY_IS_TRUE(moved.FixedCapacity);
+        VERIFY_ARE_EQUAL(static_cast<ULONGLONG>(32), moved.Capacity);
+    }
+
     BOOST_AUTO_TEST_CASE(TestCompleteBeforeCommit)
     {
         OperationQueueWrapper queue(config_, 1, false, false);
@@ -46,6 +46,7 @@ OperationQueue::OperationQueue(
         commitCallback_(nullptr),
         cleanOnComplete_(cleanOnComplete),
         ignoreCommit_(ignoreCommit),
+        fixedCapacity_(false),
         capacity_(initialSize),
         head_(startSequence), 
         tail_(startSequence),
@@ -110,6 +111,7 @@ OperationQueue::OperationQueue(
         commitCallback_(move(other.commitCallback_)),
         cleanOnComplete_(cleanOnComplete),
         ignoreCommit_(other.ignoreCommit_),
+        fixedCapacity_(false),
         capacity_(other.capacity_),
         head_(other.head_), 
         tail_(other.tail_),
@@ -167,6 +169,9 @@ OperationQueue::OperationQueue(
 
     ASSERT_IF(cleanOnComplete_ && maxCompletedOperationsMemorySize_ != 0 && maxCompletedOperationsSize_ != 0, "Queue {0}: Queue is cleaned up on complete. Cannot set completed operation size limit", ToString());
 
+    // Applied after the resize above, so the queue grows to the new max size
+    this->FixedCapacity = other.fixedCapacity_;
+
     OperationQueueEventSource::Events->Ctor(
         this->partitionId_,
         this->description_,
@@ -202,6 +207,27 @@ void OperationQueue::set_IgnoreCommit(bool value)
     ignoreCommit_ = value; 
 }
 
+void OperationQueue::set_FixedCapacity(bool value)
+{
+    fixedCapacity_ = value && maxSize_ > 0;
+
+    if (fixedCapacity_ && capacity_ < maxSize_)
+    {
+        OperationQueueEventSource::Events->Resize(
+            this->partitionId_,
+            this->description_,
+            this->completedHead_,
+            this->head_,
+            this->committedHead_,
+            this->tail_,
+            this->capacity_,
+            this->maxSize_);
+
+        UpdateCapacity(maxSize_);
+        expandedLast_ = true;
+    }
+}
+
 TimeSpan OperationQueue::get_FirstOperationInReplicationQueueEnqueuedSince() const
 {
     if (operationCount_  == 0)
@@ -570,7 +596,7 @@ void OperationQueue::ClearCompleted(FABRIC_SEQUENCE_NUMBER sequenceNumber)
     
 bool OperationQueue::Shrink(ULONGLONG activeItemsCount, bool clearCompleted)
 {
-    if (!expandedLast_)
+    if (!expandedLast_ || fixedCapacity_)
     {
         return false;
     }
@@ -1219,8 +1245,8 @@ void OperationQueue::Reset(FABRIC_SEQUENCE_NUMBER startSequence)
     completedMemorySize_ = 0;
     completedOperationCount_ = 0;
 
-    capacity_ = initialSize_;
-    expandedLast_ = false;
+    capacity_ = fixedCapacity_ ? maxSize_ : initialSize_;
+    expandedLast_ = fixedCapacity_;
     capacitySum_ = capacity_;
     convergentCapacity_ = 0;
     capacityChangeCount_ = 1;
@@ -25,6 +25,8 @@ namespace Reliability
         // of the last in-order, last out-of-order, first completed and committed operation.
         // The size of the queue is variable, and it can grow between 
         // configured start and max sizes.
+        // With FixedCapacity set, the buffer is allocated once at the max size
+        // and never resized, so enqueue, commit and complete never move items.
         // The queue does not provide any threading protection.  It is
         // the caller's responsibility to do synchronization.
         class OperationQueue
@@ -121,6 +123,11 @@ namespace Reliability
             __declspec (property(get=get_Mask)) ULONGLONG const & Mask;
             ULONGLONG const & get_Mask() const { return mask_; }
 
+            // Only takes effect if the queue has a max size
+            __declspec (property(get=get_FixedCapacity, put=set_FixedCapacity)) bool FixedCapacity;
+            bool get_FixedCapacity() const { return fixedCapacity_; }
+            void set_FixedCapacity(bool value);
+
             __declspec (property(get=get_IgnoreCommit, put=set_IgnoreCommit)) bool IgnoreCommit;
             bool get_IgnoreCommit() const { return ignoreCommit_; }
             void set_IgnoreCommit(bool value);
@@ -279,6 +286,9 @@ namespace Reliability
             // Ignore the commit state, allow complete of the items
             // even if they are not committed
             bool ignoreCommit_;
+
+            // The capacity is kept at maxSize_ instead of growing and shrinking
+            bool fixedCapacity_;
             
             // The capcity of the queue, which must be a power of 2
             // between start and max capacity.
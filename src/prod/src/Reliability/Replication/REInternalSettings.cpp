@@ -153,6 +153,30 @@ int64 REInternalSettings::get_SecondaryReplicatorBatchTracingArraySize() const
     return secondaryReplicatorBatchTracingArraySize_;
 }
 
+int64 REInternalSettings::get_ReplicationBatchSendMaxBytes() const
+{
+    AcquireReadLock grab(lock_);
+    return replicationBatchSendMaxBytes_;
+}
+
+TimeSpan REInternalSettings::get_ReplicationBatchSendMaxDelay() const
+{
+    AcquireReadLock grab(lock_);
+    return replicationBatchSendMaxDelay_;
+}
+
+TimeSpan REInternalSettings::get_AckCoalescingLatencySlo() const
+{
+    AcquireReadLock grab(lock_);
+    return ackCoalescingLatencySlo_;
+}
+
+bool REInternalSettings::get_PreallocateReplicationQueues() const
+{
+    AcquireReadLock grab(lock_);
+    return preallocateReplicationQueues_;
+}
+
 bool REInternalSettings::get_RequireServiceAck() const
 {
     AcquireReadLock grab(lock_);
@@ -624,6 +648,70 @@ int REInternalSettings::LoadGlobalSettingsCallerHoldsLock()
     });
     i += 1;
 
+    this->replicationBatchSendMaxBytes_ = globalConfig_->ReplicationBatchSendMaxBytes;
+    globalConfig_->ReplicationBatchSendMaxBytesEntry.AddHandler(
+        [&](EventArgs const &)
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        ReplicatorEventSource::Events->ReplicatorConfigUpdate(
+            reinterpret_cast<uintptr_t>(this),
+            L"ReplicationBatchSendMaxBytes",
+            Common::wformatString("{0}", this->replicationBatchSendMaxBytes_),
+            Common::wformatString("{0}", globalConfig_->ReplicationBatchSendMaxBytes));
+
+        this->replicationBatchSendMaxBytes_ = globalConfig_->ReplicationBatchSendMaxBytes;
+    });
+    i += 1;
+
+    this->replicationBatchSendMaxDelay_ = globalConfig_->ReplicationBatchSendMaxDelay;
+    globalConfig_->ReplicationBatchSendMaxDelayEntry.AddHandler(
+        [&](EventArgs const &)
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        ReplicatorEventSource::Events->ReplicatorConfigUpdate(
+            reinterpret_cast<uintptr_t>(this),
+            L"ReplicationBatchSendMaxDelay",
+            Common::wformatString("{0}", this->replicationBatchSendMaxDelay_),
+            Common::wformatString("{0}", globalConfig_->ReplicationBatchSendMaxDelay));
+
+        this->replicationBatchSendMaxDelay_ = globalConfig_->ReplicationBatchSendMaxDelay;
+    });
+    i += 1;
+
+    this->ackCoalescingLatencySlo_ = globalConfig_->AckCoalescingLatencySlo;
+    globalConfig_->AckCoalescingLatencySloEntry.AddHandler(
+        [&](EventArgs const &)
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        ReplicatorEventSource::Events->ReplicatorConfigUpdate(
+            reinterpret_cast<uintptr_t>(this),
+            L"AckCoalescingLatencySlo",
+            Common::wformatString("{0}", this->ackCoalescingLatencySlo_),
+            Common::wformatString("{0}", globalConfig_->AckCoalescingLatencySlo));
+
+        this->ackCoalescingLatencySlo_ = globalConfig_->AckCoalescingLatencySlo;
+    });
+    i += 1;
+
+    this->preallocateReplicationQueues_ = globalConfig_->PreallocateReplicationQueues;
+    globalConfig_->PreallocateReplicationQueuesEntry.AddHandler(
+        [&](EventArgs const &)
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        ReplicatorEventSource::Events->ReplicatorConfigUpdate(
+            reinterpret_cast<uintptr_t>(this),
+            L"PreallocateReplicationQueues",
+            Common::wformatString("{0}", this->preallocateReplicationQueues_),
+            Common::wformatString("{0}", globalConfig_->PreallocateReplicationQueues));
+
+        this->preallocateReplicationQueues_ = globalConfig_->PreallocateReplicationQueues;
+    });
+    i += 1;
+
     return i;
 }
 
@@ -85,6 +85,10 @@ namespace Reliability
             double secondaryProgressRateDecayFactor_ ;
             Common::TimeSpan idleReplicaMaxLagDurationBeforePromotion_;
             int64 secondaryReplicatorBatchTracingArraySize_;
+            int64 replicationBatchSendMaxBytes_;
+            Common::TimeSpan replicationBatchSendMaxDelay_;
+            Common::TimeSpan ackCoalescingLatencySlo_;
+            bool preallocateReplicationQueues_;
 
             // The following are over-ridable settings
             Common::TimeSpan retryInterval_;
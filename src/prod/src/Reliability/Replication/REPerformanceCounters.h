@@ -97,6 +97,61 @@ namespace Reliability
                         L"Enqueued Bytes/Sec",
                         L"Counter indicating the number of enqueued bytes/sec")
 
+                    COUNTER_DEFINITION(
+                        13,
+                        Common::PerformanceCounterType::AverageBase,
+                        L"Avg. Operations/Replication Message Base",
+                        L"Base Counter for measuring the average number of operations coalesced into each replication message sent by the Primary",
+                        noDisplay)
+                    COUNTER_DEFINITION_WITH_BASE(
+                        14,
+                        13,
+                        Common::PerformanceCounterType::AverageCount64,
+                        L"Avg. Operations/Replication Message",
+                        L"Counter for measuring the average number of operations coalesced into each replication message sent by the Primary")
+                    COUNTER_DEFINITION(
+                        15,
+                        Common::PerformanceCounterType::RawData64,
+                        L"# Replication Messages With 1 Operation",
+                        L"Counter for measuring the number of replication messages sent by the Primary with a single operation")
+                    COUNTER_DEFINITION(
+                        16,
+                        Common::PerformanceCounterType::RawData64,
+                        L"# Replication Messages With 2-15 Operations",
+                        L"Counter for measuring the number of replication messages sent by the Primary with 2 to 15 operations")
+                    COUNTER_DEFINITION(
+                        17,
+                        Common::PerformanceCounterType::RawData64,
+                        L"# Replication Messages With 16+ Operations",
+                        L"Counter for measuring the number of replication messages sent by the Primary with 16 or more operations")
+                    COUNTER_DEFINITION(
+                        18,
+                        Common::PerformanceCounterType::AverageBase,
+                        L"Avg. Batch Wait us/Replication Message Base",
+                        L"Base Counter for measuring the average time the first operation of a batched replication message waited for the batch to be sent",
+                        noDisplay)
+                    COUNTER_DEFINITION_WITH_BASE(
+                        19,
+                        18,
+                        Common::PerformanceCounterType::AverageCount64,
+                        L"Avg. Batch Wait us/Replication Message",
+                        L"Counter for measuring the average time the first operation of a batched replication message waited for the batch to be sent")
+                    COUNTER_DEFINITION(
+                        20,
+                        Common::PerformanceCounterType::RawData64,
+                        L"# Replication Batches Waited < 100us",
+                        L"Counter for measuring the number of batched replication messages sent less than 100 microseconds after their first operation was added")
+                    COUNTER_DEFINITION(
+                        21,
+                        Common::PerformanceCounterType::RawData64,
+                        L"# Replication Batches Waited 100us-1ms",
+                        L"Counter for measuring the number of batched replication messages sent between 100 microseconds and 1 millisecond after their first operation was added")
+                    COUNTER_DEFINITION(
+                        22,
+                        Common::PerformanceCounterType::RawData64,
+                        L"# Replication Batches Waited >= 1ms",
+                        L"Counter for measuring the number of batched replication messages sent 1 millisecond or more after their first operation was added")
+
                 END_COUNTER_SET_DEFINITION()
                 
                 DECLARE_COUNTER_INSTANCE(NumberOfBytesReplicationQueue)
@@ -111,6 +166,16 @@ namespace Reliability
                 DECLARE_COUNTER_INSTANCE(Role)
                 DECLARE_COUNTER_INSTANCE(EnqueuedOpsPerSecond)
                 DECLARE_COUNTER_INSTANCE(EnqueuedBytesPerSecond)
+                DECLARE_COUNTER_INSTANCE(AverageOperationsPerMessageBase)
+                DECLARE_COUNTER_INSTANCE(AverageOperationsPerMessage)
+                DECLARE_COUNTER_INSTANCE(MessagesWithOneOperation)
+                DECLARE_COUNTER_INSTANCE(MessagesWithUpTo15Operations)
+                DECLARE_COUNTER_INSTANCE(MessagesWith16OrMoreOperations)
+                DECLARE_COUNTER_INSTANCE(AverageBatchWaitTimeBase)
+                DECLARE_COUNTER_INSTANCE(AverageBatchWaitTime)
+                DECLARE_COUNTER_INSTANCE(BatchesWaitedUnder100Us)
+                DECLARE_COUNTER_INSTANCE(BatchesWaitedUnder1Ms)
+                DECLARE_COUNTER_INSTANCE(BatchesWaited1MsOrMore)
 
                 BEGIN_COUNTER_SET_INSTANCE(REPerformanceCounters)
                     DEFINE_COUNTER_INSTANCE(
@@ -149,6 +214,36 @@ namespace Reliability
                     DEFINE_COUNTER_INSTANCE(
                         EnqueuedBytesPerSecond, 
                         12)
+                    DEFINE_COUNTER_INSTANCE(
+                        AverageOperationsPerMessageBase, 
+                        13)
+                    DEFINE_COUNTER_INSTANCE(
+                        AverageOperationsPerMessage, 
+                        14)
+                    DEFINE_COUNTER_INSTANCE(
+                        MessagesWithOneOperation, 
+                        15)
+                    DEFINE_COUNTER_INSTANCE(
+                        MessagesWithUpTo15Operations, 
+                        16)
+                    DEFINE_COUNTER_INSTANCE(
+                        MessagesWith16OrMoreOperations, 
+                        17)
+                    DEFINE_COUNTER_INSTANCE(
+                        AverageBatchWaitTimeBase, 
+                        18)
+                    DEFINE_COUNTER_INSTANCE(
+                        AverageBatchWaitTime, 
+                        19)
+                    DEFINE_COUNTER_INSTANCE(
+                        BatchesWaitedUnder100Us, 
+                        20)
+                    DEFINE_COUNTER_INSTANCE(
+                        BatchesWaitedUnder1Ms, 
+                        21)
+                    DEFINE_COUNTER_INSTANCE(
+                        BatchesWaited1MsOrMore, 
+                        22)
                 END_COUNTER_SET_INSTANCE()
 
         public:
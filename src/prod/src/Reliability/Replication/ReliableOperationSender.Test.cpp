@@ -24,6 +24,7 @@ namespace ReplicationUnitTest
     {
     protected:
         static REConfigSPtr CreateGenericConfig();
+        static REConfigSPtr CreateBatchingConfig();
         static ReliableOperationSender::OperationLatencyList CreateOperationLatencyList(int itemCount);
         static void VerifyOperationListStopWatchesState(
             ReliableOperationSender::OperationLatencyList list, 
@@ -53,7 +54,8 @@ namespace ReplicationUnitTest
             REConfigSPtr && config);
         ~ReliableOperationSenderWrapper();
         
-        void AddOp(FABRIC_SEQUENCE_NUMBER lsn);
+        // If dataSize is not 0, the operation carries a buffer of exactly that many bytes
+        void AddOp(FABRIC_SEQUENCE_NUMBER lsn, ULONG dataSize = 0);
         
         // Add operations [fromLSN, toLSN] one by one, shuffled if so specified
         void AddOps(
@@ -77,13 +79,24 @@ namespace ReplicationUnitTest
         void CheckRequestAck(uint64 minExpectedValue);
         void WaitUntilSWSReduced(size_t sws);
 
+        // Messages are listed in send order, "n;" for a single operation and "n-m;" for a batch
+        void CheckMessagesSent(wstring const & expectedMessages);
+
         void Open();
 
+        // Opens the sender with a batch callback and a receive ACK duration
+        // that makes it hold operations well past the length of a test
+        void OpenWithBatching();
+
+        void FireBatchTimer();
+        void RetryPendingOperations();
+
     private:
         REConfigSPtr config_;
         OperationQueue queue_;
         ReliableOperationSender sender_;
         vector<FABRIC_SEQUENCE_NUMBER> operationsSent_;
+        wstring messagesSent_;
         atomic_uint64 requestAckCount_;
         size_t sendWindowSize_;
     };
@@ -309,6 +322,123 @@ namespace ReplicationUnitTest
         wrapper.CheckSws(16, SendWindowSizeState::SwsIncreased);
     }
 
+    BOOST_AUTO_TEST_CASE(TestBatchHoldUnderMaxBytes)
+    {
+        ComTestOperation::WriteInfo(
+            ReliableOperationSenderTestSource,
+            "Start TestBatchHoldUnderMaxBytes");
+
+        auto wrapperSPtr = std::make_shared<ReliableOperationSenderWrapper>(L"TestBatchHoldUnderMaxBytes", ReplicationEndpointId(), 1, CreateBatchingConfig());
+        ReliableOperationSenderWrapper & wrapper = *wrapperSPtr;
+        wrapper.OpenWithBatching();
+
+        // 3 operations of 100 bytes stay under the 400 bytes batch limit
+        wrapper.AddOp(1, 100);
+        wrapper.AddOp(2, 100);
+        wrapper.AddOp(3, 100);
+
+        // The held operations are pending, but nothing was sent yet
+        wrapper.CheckSender(-1, -1, L"1;2;3;", TimerEnabled);
+        wrapper.CheckMessagesSent(L"");
+    }
+
+    BOOST_AUTO_TEST_CASE(TestBatchFlushOnMaxBytes)
+    {
+        ComTestOperation::WriteInfo(
+            ReliableOperationSenderTestSource,
+            "Start TestBatchFlushOnMaxBytes");
+
+        auto wrapperSPtr = std::make_shared<ReliableOperationSenderWrapper>(L"TestBatchFlushOnMaxBytes", ReplicationEndpointId(), 1, CreateBatchingConfig());
+        ReliableOperationSenderWrapper & wrapper = *wrapperSPtr;
+        wrapper.OpenWithBatching();
+
+        wrapper.AddOp(1, 100);
+        wrapper.AddOp(2, 100);
+        wrapper.AddOp(3, 100);
+        wrapper.CheckMessagesSent(L"");
+
+        // The 4th operation fills the batch, which is sent as one message
+        wrapper.AddOp(4, 100);
+        wrapper.CheckMessagesSent(L"1-4;");
+
+        // An operation larger than the limit is sent on its own as soon as it is added
+        wrapper.AddOp(5, 500);
+        wrapper.CheckMessagesSent(L"1-4;5;");
+
+        wrapper.CheckSender(-1, -1, L"1;2;3;4;5;", TimerEnabled);
+    }
+
+    BOOST_AUTO_TEST_CASE(TestBatchFlushOnTimer)
+    {
+        ComTestOperation::WriteInfo(
+            ReliableOperationSenderTestSource,
+            "Start TestBatchFlushOnTimer");
+
+        auto wrapperSPtr = std::make_shared<ReliableOperationSenderWrapper>(L"TestBatchFlushOnTimer", ReplicationEndpointId(), 1, CreateBatchingConfig());
+        ReliableOperationSenderWrapper & wrapper = *wrapperSPtr;
+        wrapper.OpenWithBatching();
+
+        wrapper.AddOp(1, 100);
+        wrapper.AddOp(2, 100);
+        wrapper.CheckMessagesSent(L"");
+
+        // The batch timer sends what is held even though the batch is not full
+        wrapper.FireBatchTimer();
+        wrapper.CheckMessagesSent(L"1-2;");
+
+        // A later operation starts a new batch
+        wrapper.AddOp(3, 100);
+        wrapper.CheckMessagesSent(L"1-2;");
+
+        wrapper.FireBatchTimer();
+        wrapper.CheckMessagesSent(L"1-2;3;");
+
+        // Firing with nothing held sends nothing
+        wrapper.FireBatchTimer();
+        wrapper.CheckMessagesSent(L"1-2;3;");
+
+        wrapper.CheckSender(-1, -1, L"1;2;3;", TimerEnabled);
+    }
+
+    BOOST_AUTO_TEST_CASE(TestBatchPartialAckAndRetry)
+    {
+        ComTestOperation::WriteInfo(
+            ReliableOperationSenderTestSource,
+            "Start TestBatchPartialAckAndRetry");
+
+        auto wrapperSPtr = std::make_shared<ReliableOperationSenderWrapper>(L"TestBatchPartialAckAndRetry", ReplicationEndpointId(), 1, CreateBatchingConfig());
+        ReliableOperationSenderWrapper & wrapper = *wrapperSPtr;
+        wrapper.OpenWithBatching();
+
+        wrapper.AddOp(1, 100);
+        wrapper.AddOp(2, 100);
+        wrapper.AddOp(3, 100);
+        wrapper.AddOp(4, 100);
+        wrapper.CheckMessagesSent(L"1-4;");
+
+        // Only the first half of the batch is ACKed, the rest stays pending
+        // and is not resent before the retry interval passes
+        wrapper.Ack(2, 2);
+        wrapper.CheckSender(2, 2, L"3;4;", TimerEnabled, SwsIncreased);
+        wrapper.CheckMessagesSent(L"1-4;");
+
+        // The retry resends only the operations that were not ACKed, still coalesced
+        wrapper.RetryPendingOperations();
+        wrapper.CheckSender(2, 2, L"3;4;", TimerEnabled);
+        wrapper.CheckMessagesSent(L"1-4;3-4;");
+
+        // An ACK flushes an operation held for batching
+        wrapper.AddOp(5, 100);
+        wrapper.CheckMessagesSent(L"1-4;3-4;");
+        wrapper.Ack(4, 4);
+        wrapper.CheckSender(4, 4, L"5;", TimerEnabled, SwsIncreased);
+        wrapper.CheckMessagesSent(L"1-4;3-4;5;");
+
+        wrapper.Ack(5, 5);
+        wrapper.CheckSender(5, 5, L"", TimerDisabled, SwsIncreased);
+        wrapper.CheckMessagesSent(L"1-4;3-4;5;");
+    }
+
     BOOST_AUTO_TEST_CASE(TestOperationLatencyList)
     {
         auto temp1 = TimeSpan::Zero;
@@ -447,6 +577,20 @@ namespace ReplicationUnitTest
         return config;
     }
 
+    REConfigSPtr TestReliableOperationSender::CreateBatchingConfig()
+    {
+        REConfigSPtr config = CreateGenericConfig();
+
+        // Neither the retry timer nor the batch timer fire during a test,
+        // operations are resent and batches flushed only when a test asks for it
+        config->RetryInterval = TimeSpan::FromMinutes(60);
+        config->ReplicationBatchSendMaxDelay = TimeSpan::FromMinutes(60);
+        config->ReplicationBatchSendMaxBytes = 400;
+        config->InitialCopyQueueSize = 16;
+        config->MaxCopyQueueSize = 16;
+        return config;
+    }
+
     /***********************************
     * ReliableOperationSenderWrapper methods
     **********************************/
@@ -479,6 +623,7 @@ namespace ReplicationUnitTest
                 id,
                 -1),
             operationsSent_(),
+            messagesSent_(),
             requestAckCount_(0),
             sendWindowSize_(static_cast<size_t>(config_->InitialCopyQueueSize))
     {
@@ -510,6 +655,64 @@ namespace ReplicationUnitTest
             });
     }
 
+    void ReliableOperationSenderWrapper::OpenWithBatching()
+    {
+        sender_.Open<ComponentRootSPtr>(
+            this->CreateComponentRoot(),
+            [this](ComOperationCPtr const & op, bool requestAck, FABRIC_SEQUENCE_NUMBER) 
+            { 
+                if (requestAck)
+                {
+                    ++requestAckCount_;
+                    return true;
+                }
+
+                ComTestOperation::WriteInfo(
+                    ReliableOperationSenderTestSource,
+                    "Send {0}",
+                    op->SequenceNumber);
+                this->operationsSent_.push_back(op->SequenceNumber);
+                this->messagesSent_.append(wformatString("{0};", op->SequenceNumber));
+                return true;
+            },
+            [this](vector<ComOperationCPtr> const & ops, FABRIC_SEQUENCE_NUMBER) 
+            { 
+                ComTestOperation::WriteInfo(
+                    ReliableOperationSenderTestSource,
+                    "Send batch {0}-{1}",
+                    ops.front()->SequenceNumber,
+                    ops.back()->SequenceNumber);
+                for (ComOperationCPtr const & op : ops)
+                {
+                    this->operationsSent_.push_back(op->SequenceNumber);
+                }
+
+                this->messagesSent_.append(wformatString("{0}-{1};", ops.front()->SequenceNumber, ops.back()->SequenceNumber));
+                return true;
+            });
+
+        // A tenth of the receive ACK duration is the batching budget
+        sender_.Test_SetAverageReceiveAckDuration(TimeSpan::FromMinutes(60));
+    }
+
+    void ReliableOperationSenderWrapper::FireBatchTimer()
+    {
+        sender_.Test_FireBatchTimer();
+    }
+
+    void ReliableOperationSenderWrapper::RetryPendingOperations()
+    {
+        sender_.Test_RetryPendingOperations();
+    }
+
+    void ReliableOperationSenderWrapper::CheckMessagesSent(wstring const & expectedMessages)
+    {
+        VERIFY_ARE_EQUAL_FMT(
+            messagesSent_,
+            expectedMessages,
+            "Messages sent: expected \"{0}\", actual \"{1}\"", expectedMessages, messagesSent_);
+    }
+
     ReliableOperationSenderWrapper::~ReliableOperationSenderWrapper() 
     {
         sender_.Close();
@@ -569,9 +772,12 @@ namespace ReplicationUnitTest
     }
         
     void ReliableOperationSenderWrapper::AddOp(
-        FABRIC_SEQUENCE_NUMBER lsn)
+        FABRIC_SEQUENCE_NUMBER lsn,
+        ULONG dataSize)
     {
-        ComPointer<IFabricOperationData> op = make_com<ComTestOperation,IFabricOperationData>(L"Dummy op generated by ReliableOperationSender test");   
+        ComPointer<IFabricOperationData> op = (dataSize == 0) ?
+            make_com<ComTestOperation,IFabricOperationData>(L"Dummy op generated by ReliableOperationSender test") :
+            make_com<ComTestOperation,IFabricOperationData>(0, static_cast<int>(dataSize));
         FABRIC_OPERATION_METADATA metadata;
         metadata.Type = FABRIC_OPERATION_TYPE_NORMAL;
         metadata.SequenceNumber = lsn;
@@ -24,6 +24,9 @@ using std::wstring;
 
 ULONGLONG const ReliableOperationSender::DEFAULT_MAX_SWS_WHEN_0 = 1024;
 int const ReliableOperationSender::DEFAULT_MAX_SWS_FACTOR_WHEN_0 = 4;
+// Holding an operation back for a fraction of the round trip to the secondary
+// only adds that fraction to the replication latency
+int const ReliableOperationSender::BATCH_DELAY_RECEIVE_ACK_DIVISOR = 10;
 
 ReliableOperationSender::ReliableOperationSender(
     REInternalSettingsSPtr const & config,
@@ -33,7 +36,8 @@ ReliableOperationSender::ReliableOperationSender(
     std::wstring const & purpose,
     ReplicationEndpointId const & endpointUniqueId,
     FABRIC_REPLICA_ID const & replicaId,
-    FABRIC_SEQUENCE_NUMBER lastAckedSequenceNumber)
+    FABRIC_SEQUENCE_NUMBER lastAckedSequenceNumber,
+    REPerformanceCountersSPtr const & perfCounters)
     : ComponentRoot(),
     config_(config),
     maxSendWindowSize_(maxSendWindowSize),
@@ -43,6 +47,12 @@ ReliableOperationSender::ReliableOperationSender(
     replicaId_(replicaId),
     pendingOperations_(),
     opCallback_(),
+    batchCallback_(),
+    perfCounters_(perfCounters),
+    batchedOperations_(),
+    batchedBytes_(0),
+    batchWait_(),
+    batchSendTimer_(),
     lastAckedReceivedSequenceNumber_(lastAckedSequenceNumber),
     lastAckedApplySequenceNumber_(lastAckedSequenceNumber),
     highestOperationSequenceNumber_(lastAckedSequenceNumber),
@@ -81,6 +91,12 @@ ReliableOperationSender::ReliableOperationSender(ReliableOperationSender && othe
     replicaId_(other.replicaId_),
     pendingOperations_(move(other.pendingOperations_)),
     opCallback_(move(other.opCallback_)),
+    batchCallback_(move(other.batchCallback_)),
+    perfCounters_(move(other.perfCounters_)),
+    batchedOperations_(move(other.batchedOperations_)),
+    batchedBytes_(other.batchedBytes_),
+    batchWait_(other.batchWait_),
+    batchSendTimer_(move(other.batchSendTimer_)),
     lastAckedReceivedSequenceNumber_(other.lastAckedReceivedSequenceNumber_),
     lastAckedApplySequenceNumber_(other.lastAckedApplySequenceNumber_),
     highestOperationSequenceNumber_(other.highestOperationSequenceNumber_),
@@ -135,6 +151,14 @@ void ReliableOperationSender::Close()
         retrySendTimer_->Cancel();
         retrySendTimer_ = nullptr;
         timerActive_ = false;
+
+        batchedOperations_.clear();
+        batchedBytes_ = 0;
+        if (batchSendTimer_)
+        {
+            batchSendTimer_->Cancel();
+            batchSendTimer_ = nullptr;
+        }
     }
 }
 
@@ -322,6 +346,8 @@ void ReliableOperationSender::Add(
             return;
         }
 
+        TakeBatchedOperationsCallerHoldsLock(copies);
+
         if (!copies.empty())
         {
             FABRIC_SEQUENCE_NUMBER minAddedLSN = copies.front()->SequenceNumber;
@@ -350,14 +376,7 @@ void ReliableOperationSender::Add(
         }
     }
        
-    for(ComOperationCPtr const & opPtr : copies)
-    {
-        if(!this->opCallback_(opPtr, false, completedSeqNumber))
-        {
-            // Stop sending rest of the operations if there are errors 
-            break;
-        }
-    }
+    SendOperations(copies, completedSeqNumber);
 }
 
 void ReliableOperationSender::UpdateCompletedLsnCallerHoldsLock(FABRIC_SEQUENCE_NUMBER completedSeqNumber)
@@ -372,6 +391,7 @@ void ReliableOperationSender::Add(
 {
     ComOperationCPtr copy;
     bool send;
+    std::vector<ComOperationCPtr> copies;
     
     {
         AcquireWriteLock lock(lock_);
@@ -464,14 +484,232 @@ void ReliableOperationSender::Add(
             retrySendTimer_->Change(config_->RetryInterval);
             timerActive_ = true;
         }
+
+        if (send && IsBatchingEnabled())
+        {
+            TimeSpan batchDelay = GetBatchDelayCallerHoldsLock();
+            if (batchDelay > TimeSpan::Zero)
+            {
+                if (batchedOperations_.empty())
+                {
+                    batchWait_.Restart();
+                    batchSendTimer_->Change(batchDelay);
+                }
+
+                batchedBytes_ += operationPtr->DataSize;
+                batchedOperations_.push_back(move(copy));
+
+                if (batchedBytes_ < static_cast<ULONGLONG>(config_->ReplicationBatchSendMaxBytes))
+                {
+                    // Sent when the batch fills up or the timer fires
+                    return;
+                }
+
+                TakeBatchedOperationsCallerHoldsLock(copies);
+            }
+            else if (!batchedOperations_.empty())
+            {
+                // The secondary responds faster than the batch budget, flush what is held
+                TakeBatchedOperationsCallerHoldsLock(copies);
+                copies.push_back(move(copy));
+            }
+            else
+            {
+                copies.push_back(move(copy));
+            }
+        }
     }
      
-    if (send)
+    if (!copies.empty())
     {
+        SendOperations(copies, completedSeqNumber);
+    }
+    else if (send)
+    {
+        ReportMessageOperationCount(1);
         opCallback_(copy, false, completedSeqNumber);
     }
 }
 
+bool ReliableOperationSender::IsBatchingEnabled() const
+{
+    return batchCallback_ && config_->ReplicationBatchSendMaxBytes > 0;
+}
+
+// The batching budget tracks the measured time for the secondary to receive an operation,
+// so a fast secondary is not slowed down by a fixed delay
+TimeSpan ReliableOperationSender::GetBatchDelayCallerHoldsLock() const
+{
+    TimeSpan ackDerivedDelay = TimeSpan::FromTicks(averageReceiveAckDuration_.Value.Ticks / BATCH_DELAY_RECEIVE_ACK_DIVISOR);
+    TimeSpan maxDelay = config_->ReplicationBatchSendMaxDelay;
+
+    return ackDerivedDelay < maxDelay ? ackDerivedDelay : maxDelay;
+}
+
+void ReliableOperationSender::TakeBatchedOperationsCallerHoldsLock(__inout std::vector<ComOperationCPtr> & operations)
+{
+    if (batchedOperations_.empty())
+    {
+        return;
+    }
+
+    if (batchSendTimer_)
+    {
+        batchSendTimer_->Change(TimeSpan::MaxValue);
+    }
+
+    if (perfCounters_)
+    {
+        int64 waitMicroseconds = batchWait_.ElapsedMicroseconds;
+
+        perfCounters_->AverageBatchWaitTimeBase.Increment();
+        perfCounters_->AverageBatchWaitTime.IncrementBy(waitMicroseconds);
+
+        if (waitMicroseconds < 100)
+        {
+            perfCounters_->BatchesWaitedUnder100Us.Increment();
+        }
+        else if (waitMicroseconds < 1000)
+        {
+            perfCounters_->BatchesWaitedUnder1Ms.Increment();
+        }
+        else
+        {
+            perfCounters_->BatchesWaited1MsOrMore.Increment();
+        }
+    }
+
+    if (operations.empty())
+    {
+        operations.swap(batchedOperations_);
+    }
+    else
+    {
+        // Keep sequence number order so consecutive operations can still be coalesced
+        operations.insert(operations.end(), batchedOperations_.begin(), batchedOperations_.end());
+        batchedOperations_.clear();
+
+        std::stable_sort(
+            operations.begin(),
+            operations.end(),
+            [](ComOperationCPtr const & left, ComOperationCPtr const & right)
+            {
+                return left->SequenceNumber < right->SequenceNumber;
+            });
+    }
+
+    batchedBytes_ = 0;
+}
+
+void ReliableOperationSender::OnBatchTimerCallback()
+{
+    std::vector<ComOperationCPtr> copies;
+    FABRIC_SEQUENCE_NUMBER completedSeqNumber;
+
+    {
+        AcquireWriteLock lock(lock_);
+        if (!isActive_)
+        {
+            ReplicatorEventSource::Events->OpSenderNotActive(
+                partitionId_, 
+                endpointUniqueId_,
+                replicaId_,
+                purpose_,
+                L"OnBatchTimerCallback");
+            return;
+        }
+
+        completedSeqNumber = completedSeqNumber_;
+        TakeBatchedOperationsCallerHoldsLock(copies);
+    }
+
+    SendOperations(copies, completedSeqNumber);
+}
+
+// Send the operations in order, coalescing runs of consecutive operations that the
+// replication message header can describe together, up to the configured size
+void ReliableOperationSender::SendOperations(
+    std::vector<ComOperationCPtr> const & operations,
+    FABRIC_SEQUENCE_NUMBER completedSeqNumber)
+{
+    if (!IsBatchingEnabled())
+    {
+        for(ComOperationCPtr const & opPtr : operations)
+        {
+            ReportMessageOperationCount(1);
+            if(!this->opCallback_(opPtr, false, completedSeqNumber))
+            {
+                // Stop sending rest of the operations if there are errors 
+                break;
+            }
+        }
+
+        return;
+    }
+
+    ULONGLONG maxBytes = static_cast<ULONGLONG>(config_->ReplicationBatchSendMaxBytes);
+    std::vector<ComOperationCPtr> batch;
+
+    for (size_t begin = 0; begin < operations.size(); begin += batch.size())
+    {
+        ComOperationCPtr const & first = operations[begin];
+        ULONGLONG bytes = first->DataSize;
+
+        size_t end = begin + 1;
+        for (; end < operations.size(); ++end)
+        {
+            ComOperationCPtr const & next = operations[end];
+            if (next->SequenceNumber != first->SequenceNumber + static_cast<FABRIC_SEQUENCE_NUMBER>(end - begin) ||
+                next->Type != first->Type ||
+                next->Metadata.AtomicGroupId != first->Metadata.AtomicGroupId ||
+                next->Epoch != first->Epoch ||
+                bytes + next->DataSize > maxBytes)
+            {
+                break;
+            }
+
+            bytes += next->DataSize;
+        }
+
+        batch.assign(operations.begin() + begin, operations.begin() + end);
+        ReportMessageOperationCount(batch.size());
+
+        bool sent = (batch.size() == 1) ?
+            this->opCallback_(first, false, completedSeqNumber) :
+            this->batchCallback_(batch, completedSeqNumber);
+
+        if (!sent)
+        {
+            // Stop sending rest of the operations if there are errors 
+            break;
+        }
+    }
+}
+
+void ReliableOperationSender::ReportMessageOperationCount(size_t count) const
+{
+    if (!perfCounters_)
+    {
+        return;
+    }
+
+    perfCounters_->AverageOperationsPerMessageBase.Increment();
+    perfCounters_->AverageOperationsPerMessage.IncrementBy(static_cast<int64>(count));
+
+    if (count == 1)
+    {
+        perfCounters_->MessagesWithOneOperation.Increment();
+    }
+    else if (count < 16)
+    {
+        perfCounters_->MessagesWithUpTo15Operations.Increment();
+    }
+    else
+    {
+        perfCounters_->MessagesWith16OrMoreOperations.Increment();
+    }
+}
+
 void ReliableOperationSender::RemoveOperationsCallerHoldsLock(FABRIC_SEQUENCE_NUMBER sequenceNumber)
 {
     //
@@ -578,6 +816,11 @@ void ReliableOperationSender::OnTimerCallback()
 
         noAckSinceLastCallback_ = true;
         GetNextSendAndSetTimerCallerHoldsLock(requestAck, copies);
+
+        if (!requestAck)
+        {
+            TakeBatchedOperationsCallerHoldsLock(copies);
+        }
     }
 
     if (requestAck)
@@ -587,14 +830,7 @@ void ReliableOperationSender::OnTimerCallback()
     }
     else
     {
-        for(ComOperationCPtr const & opPtr : copies)
-        {
-            if(!this->opCallback_(opPtr, false, completedSeqNumber))
-            {
-                // Stop sending rest of the operations if there are errors 
-                break;
-            }
-        }
+        SendOperations(copies, completedSeqNumber);
     }
 }
 
@@ -679,6 +915,11 @@ bool ReliableOperationSender::ProcessOnAck(
         }
 
         GetNextSendAndSetTimerCallerHoldsLock(requestAck, copies);
+
+        if (!requestAck)
+        {
+            TakeBatchedOperationsCallerHoldsLock(copies);
+        }
     }
 
     // Do not send request ACK, it will be sent on callback only.
@@ -686,14 +927,7 @@ bool ReliableOperationSender::ProcessOnAck(
     // it will send ACK back with the same numbers and the behavior will be repeated in a loop.
     if (!requestAck)
     {
-        for(ComOperationCPtr const & opPtr : copies)
-        {
-            if(!this->opCallback_(opPtr, false, completedSeqNumber))
-            {
-                // Stop sending rest of the operations if there are errors 
-                break;
-            }
-        }
+        SendOperations(copies, completedSeqNumber);
     }
 
     return progressQuorumDone || progressReceiveDone;
@@ -896,6 +1130,31 @@ void ReliableOperationSender::Test_GetPendingOperationsCopy(
     sendWindowSize = sendWindowSize_;
 }
 
+void ReliableOperationSender::Test_SetAverageReceiveAckDuration(TimeSpan const & duration)
+{
+    AcquireWriteLock lock(lock_);
+    averageReceiveAckDuration_.Reset();
+    averageReceiveAckDuration_.Update(duration);
+}
+
+void ReliableOperationSender::Test_FireBatchTimer()
+{
+    OnBatchTimerCallback();
+}
+
+void ReliableOperationSender::Test_RetryPendingOperations()
+{
+    {
+        AcquireWriteLock lock(lock_);
+        for (auto & op : pendingOperations_)
+        {
+            op.second = DateTime::Zero;
+        }
+    }
+
+    OnTimerCallback();
+}
+
 // Implementation of the OperationLatencyList Class
 ReliableOperationSender::OperationLatencyList::OperationLatencyList()
     : items_()
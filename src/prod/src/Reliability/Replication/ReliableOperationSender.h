@@ -22,7 +22,8 @@ namespace Reliability
                 std::wstring const & purpose,
                 ReplicationEndpointId const & endpointUniqueId,
                 FABRIC_REPLICA_ID const & replicaId,
-                FABRIC_SEQUENCE_NUMBER lastAckedSequenceNumber);
+                FABRIC_SEQUENCE_NUMBER lastAckedSequenceNumber,
+                REPerformanceCountersSPtr const & perfCounters = REPerformanceCountersSPtr());
 
             ReliableOperationSender(ReliableOperationSender && other);
 
@@ -30,6 +31,7 @@ namespace Reliability
 
             static ULONGLONG const DEFAULT_MAX_SWS_WHEN_0;
             static int const DEFAULT_MAX_SWS_FACTOR_WHEN_0;
+            static int const BATCH_DELAY_RECEIVE_ACK_DIVISOR;
 
             __declspec (property(get=get_LastAckedSequenceNumber)) FABRIC_SEQUENCE_NUMBER LastAckedSequenceNumber;
             FABRIC_SEQUENCE_NUMBER get_LastAckedSequenceNumber() const;
@@ -69,10 +71,13 @@ namespace Reliability
 
             void ResetAverageStatistics();
 
+            // If batchCallback is provided, operations added one at a time are held for a short
+            // latency budget and consecutive ones are coalesced into a single message
             template <class T>
             void Open(
                 T const & root,
-                SendOperationCallback const & opCallback);
+                SendOperationCallback const & opCallback,
+                SendOperationBatchCallback const & batchCallback = SendOperationBatchCallback());
 
             void Close();
 
@@ -99,6 +104,15 @@ namespace Reliability
                 __out std::list<std::pair<ComOperationRawPtr, Common::DateTime>> & ops,
                 __out bool & timerActive,
                 __out size_t & sendWindowSize);
+
+            // CIT only
+            void Test_SetAverageReceiveAckDuration(Common::TimeSpan const & duration);
+
+            // CIT only
+            void Test_FireBatchTimer();
+
+            // CIT only: resends every pending operation as if the retry interval had passed
+            void Test_RetryPendingOperations();
  
             // Ascending Sorted List of LSN's with the respective operations' receive ACK and apply ACK duration
             // OnAck() is invoked on every ACK and is hence expected to be fast
@@ -145,6 +159,14 @@ namespace Reliability
         private:
 
             void OnTimerCallback();
+            void OnBatchTimerCallback();
+            bool IsBatchingEnabled() const;
+            Common::TimeSpan GetBatchDelayCallerHoldsLock() const;
+            void TakeBatchedOperationsCallerHoldsLock(__inout std::vector<ComOperationCPtr> & operations);
+            void SendOperations(
+                std::vector<ComOperationCPtr> const & operations,
+                FABRIC_SEQUENCE_NUMBER completedSeqNumber);
+            void ReportMessageOperationCount(size_t count) const;
             void RemoveOperationsCallerHoldsLock(FABRIC_SEQUENCE_NUMBER lastReceivedLSN);
             void GetNextSendAndSetTimerCallerHoldsLock(
                 __out bool & requestAck,
@@ -168,6 +190,18 @@ namespace Reliability
             // Callback called when an operation needs to be sent to the other side
             SendOperationCallback opCallback_;
 
+            // Callback called when several consecutive operations are sent in one message
+            SendOperationBatchCallback batchCallback_;
+
+            REPerformanceCountersSPtr perfCounters_;
+
+            // Operations accepted by the send window and held until the batch
+            // fills up or the batch timer fires, in sequence number order
+            std::vector<ComOperationCPtr> batchedOperations_;
+            ULONGLONG batchedBytes_;
+            Common::Stopwatch batchWait_;
+            Common::TimerSPtr batchSendTimer_;
+
             // Last ACKed numbers for in-order operations
             FABRIC_SEQUENCE_NUMBER lastAckedReceivedSequenceNumber_;
             FABRIC_SEQUENCE_NUMBER lastAckedApplySequenceNumber_;
@@ -209,7 +243,8 @@ namespace Reliability
         template <class T>
         void ReliableOperationSender::Open(
             T const & root, 
-            SendOperationCallback const & opCallback)
+            SendOperationCallback const & opCallback,
+            SendOperationBatchCallback const & batchCallback)
         {
             ReplicatorEventSource::Events->OpSenderOpen(
                 partitionId_, 
@@ -220,6 +255,7 @@ namespace Reliability
                 lastAckedApplySequenceNumber_);
 
             opCallback_ = opCallback;
+            batchCallback_ = batchCallback;
         
             {
                 Common::AcquireWriteLock lock(lock_);
@@ -232,6 +268,17 @@ namespace Reliability
                         this->OnTimerCallback(); 
                     },
                     true);
+
+                if (batchCallback_)
+                {
+                    batchSendTimer_ = Common::Timer::Create(
+                        "rrbt",
+                        [this, root] (Common::TimerSPtr const &) 
+                        { 
+                            this->OnBatchTimerCallback(); 
+                        },
+                        true);
+                }
             }
         }
          
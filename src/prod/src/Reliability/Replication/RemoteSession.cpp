@@ -95,11 +95,14 @@ ReplicationEndpointId RemoteSession::GetEndpointUniqueId(std::wstring const & re
     Common::Assert::CodingError("Can't parse endpoint, it is in an incorrect format: {0}", replicatorAddress);
 }
 
-void RemoteSession::OnOpen(__in SendOperationCallback const & replicationOperationSendCallback)
+void RemoteSession::OnOpen(
+    __in SendOperationCallback const & replicationOperationSendCallback,
+    __in SendOperationBatchCallback const & replicationOperationBatchSendCallback)
 {
     replicationOperations_.Open<ComponentRootSPtr>(
         CreateComponentRoot(),
-        replicationOperationSendCallback);
+        replicationOperationSendCallback,
+        replicationOperationBatchSendCallback);
 
     isSessionActive_.store(true);
 }
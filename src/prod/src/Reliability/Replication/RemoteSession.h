@@ -161,7 +161,9 @@ namespace Reliability
             // 
             // Derived class must provide the callback for sending replication operations
             // 
-            void OnOpen(__in SendOperationCallback const & replicationOperationSendCallback);
+            void OnOpen(
+                __in SendOperationCallback const & replicationOperationSendCallback,
+                __in SendOperationBatchCallback const & replicationOperationBatchSendCallback);
             
             void OnClose();
 
@@ -183,6 +185,10 @@ namespace Reliability
                 ComOperationCPtr const & operation,
                 FABRIC_SEQUENCE_NUMBER completedSeqNumber) = 0;
 
+            virtual bool SendReplicateOperations(
+                std::vector<ComOperationCPtr> const & operations,
+                FABRIC_SEQUENCE_NUMBER completedSeqNumber) = 0;
+
             virtual bool SendRequestAck() = 0;
 
             virtual bool SendCopyContextAck(bool shouldTrace) = 0;
@@ -1211,7 +1211,7 @@ ReplicationSessionSPtr ReplicaManager::CreateReplica(
         "{0}: Can't add the local replica {1} to the list of replicas.", endpointUniqueId_, replica);
 
     ReplicationSessionSPtr session = std::make_shared<ReplicationSession>(
-        config_, partition_, replica.Id, replica.ReplicatorAddress, replica.TransportEndpointId, replica.CurrentProgress, endpointUniqueId_, partitionId_, epoch_, apiMonitor_, transport_);
+        config_, partition_, replica.Id, replica.ReplicatorAddress, replica.TransportEndpointId, replica.CurrentProgress, endpointUniqueId_, partitionId_, epoch_, apiMonitor_, transport_, perfCounters_);
     session->Open();
     
     return session;
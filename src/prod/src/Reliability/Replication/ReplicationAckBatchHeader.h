@@ -0,0 +1,127 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Reliability
+{
+    namespace ReplicationComponent
+    {
+        // Replication ACK of one secondary, carried in a ReplicationAckBatchHeader
+        class ReplicationAckBatchEntry : public Serialization::FabricSerializable
+        {
+        public:
+            ReplicationAckBatchEntry()
+                : senderActor_()
+                , receiverActor_()
+                , replicationReceivedLSN_(Constants::NonInitializedLSN)
+                , replicationQuorumLSN_(Constants::NonInitializedLSN)
+                , copyReceivedLSN_(Constants::NonInitializedLSN)
+                , copyQuorumLSN_(Constants::NonInitializedLSN)
+                , errorCodeValue_(0)
+            {
+            }
+
+            ReplicationAckBatchEntry(
+                ReplicationEndpointId const & senderActor,
+                ReplicationEndpointId const & receiverActor,
+                FABRIC_SEQUENCE_NUMBER replicationReceivedLSN,
+                FABRIC_SEQUENCE_NUMBER replicationQuorumLSN,
+                FABRIC_SEQUENCE_NUMBER copyReceivedLSN,
+                FABRIC_SEQUENCE_NUMBER copyQuorumLSN,
+                int errorCodeValue)
+                : senderActor_(senderActor)
+                , receiverActor_(receiverActor)
+                , replicationReceivedLSN_(replicationReceivedLSN)
+                , replicationQuorumLSN_(replicationQuorumLSN)
+                , copyReceivedLSN_(copyReceivedLSN)
+                , copyQuorumLSN_(copyQuorumLSN)
+                , errorCodeValue_(errorCodeValue)
+            {
+            }
+
+            __declspec(property(get=get_SenderActor)) ReplicationEndpointId const & SenderActor;
+            ReplicationEndpointId const & get_SenderActor() const { return senderActor_; }
+
+            __declspec(property(get=get_ReceiverActor)) ReplicationEndpointId const & ReceiverActor;
+            ReplicationEndpointId const & get_ReceiverActor() const { return receiverActor_; }
+
+            __declspec(property(get=get_ErrorCodeValue)) int ErrorCodeValue;
+            int get_ErrorCodeValue() const { return errorCodeValue_; }
+
+            ReplicationAckMessageBody CreateAckBody() const
+            {
+                return ReplicationAckMessageBody(
+                    replicationReceivedLSN_,
+                    replicationQuorumLSN_,
+                    copyReceivedLSN_,
+                    copyQuorumLSN_);
+            }
+
+            void WriteTo(__in Common::TextWriter & w, Common::FormatOptions const &) const
+            {
+                w.Write("{0}->{1}:{2},{3}", senderActor_, receiverActor_, replicationReceivedLSN_, replicationQuorumLSN_);
+                if (copyReceivedLSN_ != Constants::NonInitializedLSN)
+                {
+                    w.Write(":{0},{1}", copyReceivedLSN_, copyQuorumLSN_);
+                }
+            }
+
+            FABRIC_FIELDS_07(senderActor_, receiverActor_, replicationReceivedLSN_, replicationQuorumLSN_, copyReceivedLSN_, copyQuorumLSN_, errorCodeValue_);
+
+        private:
+            ReplicationEndpointId senderActor_;
+            ReplicationEndpointId receiverActor_;
+            FABRIC_SEQUENCE_NUMBER replicationReceivedLSN_;
+            FABRIC_SEQUENCE_NUMBER replicationQuorumLSN_;
+            FABRIC_SEQUENCE_NUMBER copyReceivedLSN_;
+            FABRIC_SEQUENCE_NUMBER copyQuorumLSN_;
+            int errorCodeValue_;
+        };
+    }
+}
+
+DEFINE_USER_ARRAY_UTILITY(Reliability::ReplicationComponent::ReplicationAckBatchEntry);
+
+namespace Reliability
+{
+    namespace ReplicationComponent
+    {
+        // ACKs of secondaries on the sending node to primaries on the receiving node.
+        // Sent in a ReplicationAckBatch message or piggybacked on any other replication message
+        // between the two nodes; the receiving demuxer dispatches each entry as a ReplicationAck.
+        class ReplicationAckBatchHeader
+            : public Transport::MessageHeader<Transport::MessageHeaderId::ReplicationAckBatch>
+            , public Serialization::FabricSerializable
+        {
+        public:
+            ReplicationAckBatchHeader() {}
+
+            ReplicationAckBatchHeader(std::wstring const & address, std::vector<ReplicationAckBatchEntry> && acks)
+                : address_(address)
+                , acks_(std::move(acks))
+            {
+            }
+
+            // Replication endpoint of the sending node, the From address of every ACK
+            __declspec(property(get=get_Address)) std::wstring const & Address;
+            std::wstring const & get_Address() const { return address_; }
+
+            __declspec(property(get=get_Acks)) std::vector<ReplicationAckBatchEntry> const & Acks;
+            std::vector<ReplicationAckBatchEntry> const & get_Acks() const { return acks_; }
+
+            void WriteTo(__in Common::TextWriter & w, Common::FormatOptions const &) const
+            {
+                w.Write("{0}: {1} acks", address_, acks_.size());
+            }
+
+            FABRIC_FIELDS_02(address_, acks_);
+
+        private:
+            std::wstring address_;
+            std::vector<ReplicationAckBatchEntry> acks_;
+        };
+    }
+}
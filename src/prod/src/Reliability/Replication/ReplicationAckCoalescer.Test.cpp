@@ -0,0 +1,266 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include "ComTestOperation.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace ReplicationUnitTest
+{
+    using namespace Common;
+    using namespace std;
+    using namespace Reliability::ReplicationComponent;
+    using namespace Transport;
+
+    static StringLiteral const AckCoalescerTestSource("TESTAckCoalescer");
+
+    class TestAckCoalescerTarget : public ISendTarget
+    {
+    public:
+        TestAckCoalescerTarget() : address_(L"127.0.0.1:1234"), empty_() {}
+
+        wstring const & Address() const override { return address_; }
+        wstring const & LocalAddress() const override { return empty_; }
+        wstring const & Id() const override { return empty_; }
+        wstring const & TraceId() const override { return address_; }
+        bool IsAnonymous() const override { return false; }
+        size_t ConnectionCount() const override { return 1; }
+
+    private:
+        wstring address_;
+        wstring empty_;
+    };
+
+    class TestAckCoalescerRoot : public ComponentRoot
+    {
+    };
+
+    // Time as seen by the coalescer, only moves when a test advances it
+    class TestAckCoalescerClock
+    {
+    public:
+        TestAckCoalescerClock() : now_(Stopwatch::Now()) {}
+
+        ReplicationAckCoalescer::ClockCallback CreateCallback()
+        {
+            return [this]() { return now_; };
+        }
+
+        void Advance(TimeSpan const & interval) { now_ += interval; }
+
+    private:
+        StopwatchTime now_;
+    };
+
+    // Records the batches flushed by the coalescer
+    class TestAckFlushes
+    {
+    public:
+        TestAckFlushes() : flushError_(ErrorCodeValue::Success) {}
+
+        ReplicationAckCoalescer::FlushCallback CreateCallback()
+        {
+            return [this](ISendTarget::SPtr const &, vector<ReplicationAckBatchEntry> && acks)
+            {
+                AcquireWriteLock grab(lock_);
+                batchSizes_.push_back(acks.size());
+                return flushError_;
+            };
+        }
+
+        void SetFlushError(ErrorCodeValue::Enum error)
+        {
+            AcquireWriteLock grab(lock_);
+            flushError_ = error;
+        }
+
+        vector<size_t> TakeBatchSizes()
+        {
+            AcquireWriteLock grab(lock_);
+            return move(batchSizes_);
+        }
+
+    private:
+        RwLock lock_;
+        vector<size_t> batchSizes_;
+        ErrorCode flushError_;
+    };
+
+    class TestReplicationAckCoalescer
+    {
+    protected:
+        TestReplicationAckCoalescer() { BOOST_REQUIRE(Setup()); }
+        TEST_CLASS_SETUP(Setup)
+
+        static ReplicationAckBatchEntry CreateAck(Guid const & partitionId, FABRIC_SEQUENCE_NUMBER lsn)
+        {
+            return ReplicationAckBatchEntry(
+                ReplicationEndpointId(partitionId, 2),
+                ReplicationEndpointId(partitionId, 1),
+                lsn,
+                lsn,
+                Constants::NonInitializedLSN,
+                Constants::NonInitializedLSN,
+                0);
+        }
+    };
+
+    BOOST_FIXTURE_TEST_SUITE(TestReplicationAckCoalescerSuite, TestReplicationAckCoalescer)
+
+    BOOST_AUTO_TEST_CASE(AcksWithinWindowSentInOneMessage)
+    {
+        ComTestOperation::WriteInfo(AckCoalescerTestSource, "Start AcksWithinWindowSentInOneMessage");
+
+        // The ACK interval and the SLO are long enough that the coalescer's timer never fires during
+        // the test, pending ACKs are only flushed when the test fires the timer
+        auto root = make_shared<TestAckCoalescerRoot>();
+        ISendTarget::SPtr target = make_shared<TestAckCoalescerTarget>();
+        TestAckFlushes flushes;
+        TestAckCoalescerClock clock;
+        ReplicationAckCoalescer coalescer(*root, flushes.CreateCallback(), clock.CreateCallback());
+        auto latencySlo = TimeSpan::FromMinutes(60);
+        auto ackInterval = TimeSpan::FromMinutes(1);
+
+        // Establishes an ACK rate of one per minute for the node, the newer ACKs of the
+        // warmup partition replace the pending one
+        Guid warmupPartition = Guid::NewGuid();
+        for (FABRIC_SEQUENCE_NUMBER lsn = 1; lsn <= 16; ++lsn)
+        {
+            VERIFY_IS_TRUE(coalescer.Add(target, CreateAck(warmupPartition, lsn), latencySlo, false).IsSuccess());
+            clock.Advance(ackInterval);
+        }
+
+        // Only the first ACK, sent before there was a rate estimate, was flushed
+        auto batchSizes = flushes.TakeBatchSizes();
+        VERIFY_ARE_EQUAL(1u, batchSizes.size());
+        VERIFY_ARE_EQUAL(1u, batchSizes[0]);
+
+        coalescer.Test_FireTimer(target->Address());
+        batchSizes = flushes.TakeBatchSizes();
+        VERIFY_ARE_EQUAL(1u, batchSizes.size());
+        VERIFY_ARE_EQUAL(1u, batchSizes[0]);
+
+        size_t const ackCount = 10;
+        for (size_t i = 0; i < ackCount; ++i)
+        {
+            VERIFY_IS_TRUE(coalescer.Add(target, CreateAck(Guid::NewGuid(), 1), latencySlo, false).IsSuccess());
+            clock.Advance(ackInterval);
+        }
+
+        VERIFY_ARE_EQUAL(0u, flushes.TakeBatchSizes().size());
+
+        coalescer.Test_FireTimer(target->Address());
+        batchSizes = flushes.TakeBatchSizes();
+        VERIFY_ARE_EQUAL(1u, batchSizes.size());
+        VERIFY_ARE_EQUAL(ackCount, batchSizes[0]);
+
+        // Nothing is left to flush or piggyback
+        coalescer.Test_FireTimer(target->Address());
+        VERIFY_ARE_EQUAL(0u, flushes.TakeBatchSizes().size());
+
+        vector<ReplicationAckBatchEntry> acks;
+        VERIFY_IS_FALSE(coalescer.TryTakePending(*target, acks));
+
+        coalescer.Close();
+    }
+
+    BOOST_AUTO_TEST_CASE(SlowAcksSentRightAway)
+    {
+        ComTestOperation::WriteInfo(AckCoalescerTestSource, "Start SlowAcksSentRightAway");
+
+        auto root = make_shared<TestAckCoalescerRoot>();
+        ISendTarget::SPtr target = make_shared<TestAckCoalescerTarget>();
+        TestAckFlushes flushes;
+        TestAckCoalescerClock clock;
+        ReplicationAckCoalescer coalescer(*root, flushes.CreateCallback(), clock.CreateCallback());
+        auto latencySlo = TimeSpan::FromMilliseconds(10);
+
+        // No other ACK is expected within the SLO, so waiting for one only adds latency
+        for (FABRIC_SEQUENCE_NUMBER lsn = 1; lsn <= 4; ++lsn)
+        {
+            VERIFY_IS_TRUE(coalescer.Add(target, CreateAck(Guid::NewGuid(), lsn), latencySlo, false).IsSuccess());
+            clock.Advance(TimeSpan::FromSeconds(1));
+        }
+
+        auto batchSizes = flushes.TakeBatchSizes();
+        VERIFY_ARE_EQUAL(4u, batchSizes.size());
+        for (auto batchSize : batchSizes)
+        {
+            VERIFY_ARE_EQUAL(1u, batchSize);
+        }
+
+        coalescer.Close();
+    }
+
+    BOOST_AUTO_TEST_CASE(PendingAcksPiggybacked)
+    {
+        ComTestOperation::WriteInfo(AckCoalescerTestSource, "Start PendingAcksPiggybacked");
+
+        auto root = make_shared<TestAckCoalescerRoot>();
+        ISendTarget::SPtr target = make_shared<TestAckCoalescerTarget>();
+        TestAckFlushes flushes;
+        TestAckCoalescerClock clock;
+        ReplicationAckCoalescer coalescer(*root, flushes.CreateCallback(), clock.CreateCallback());
+        auto latencySlo = TimeSpan::FromMinutes(60);
+
+        VERIFY_IS_TRUE(coalescer.Add(target, CreateAck(Guid::NewGuid(), 1), latencySlo, false).IsSuccess());
+        clock.Advance(TimeSpan::FromMinutes(1));
+        VERIFY_IS_TRUE(coalescer.Add(target, CreateAck(Guid::NewGuid(), 1), latencySlo, false).IsSuccess());
+        clock.Advance(TimeSpan::FromMinutes(1));
+        VERIFY_IS_TRUE(coalescer.Add(target, CreateAck(Guid::NewGuid(), 1), latencySlo, false).IsSuccess());
+        VERIFY_ARE_EQUAL(1u, flushes.TakeBatchSizes().size());
+
+        // A message sent to the node takes the held ACKs, the timer then has nothing to flush
+        vector<ReplicationAckBatchEntry> acks;
+        VERIFY_IS_TRUE(coalescer.TryTakePending(*target, acks));
+        VERIFY_ARE_EQUAL(2u, acks.size());
+
+        coalescer.Test_FireTimer(target->Address());
+        VERIFY_ARE_EQUAL(0u, flushes.TakeBatchSizes().size());
+
+        coalescer.Close();
+    }
+
+    BOOST_AUTO_TEST_CASE(ForcedAckReturnsSendResult)
+    {
+        ComTestOperation::WriteInfo(AckCoalescerTestSource, "Start ForcedAckReturnsSendResult");
+
+        auto root = make_shared<TestAckCoalescerRoot>();
+        ISendTarget::SPtr target = make_shared<TestAckCoalescerTarget>();
+        TestAckFlushes flushes;
+        TestAckCoalescerClock clock;
+        ReplicationAckCoalescer coalescer(*root, flushes.CreateCallback(), clock.CreateCallback());
+        auto latencySlo = TimeSpan::FromMinutes(60);
+
+        flushes.SetFlushError(ErrorCodeValue::TransportSendQueueFull);
+
+        // First ACK to the node has no rate estimate and is sent right away
+        auto error = coalescer.Add(target, CreateAck(Guid::NewGuid(), 1), latencySlo, false);
+        VERIFY_IS_TRUE(error.IsError(ErrorCodeValue::TransportSendQueueFull));
+
+        // Second one waits for more ACKs, the forced third one flushes both
+        clock.Advance(TimeSpan::FromMinutes(1));
+        VERIFY_IS_TRUE(coalescer.Add(target, CreateAck(Guid::NewGuid(), 1), latencySlo, false).IsSuccess());
+        error = coalescer.Add(target, CreateAck(Guid::NewGuid(), 1), latencySlo, true);
+        VERIFY_IS_TRUE(error.IsError(ErrorCodeValue::TransportSendQueueFull));
+
+        auto batchSizes = flushes.TakeBatchSizes();
+        VERIFY_ARE_EQUAL(2u, batchSizes.size());
+        VERIFY_ARE_EQUAL(1u, batchSizes[0]);
+        VERIFY_ARE_EQUAL(2u, batchSizes[1]);
+
+        coalescer.Close();
+        VERIFY_IS_TRUE(coalescer.Add(target, CreateAck(Guid::NewGuid(), 1), latencySlo, true).IsError(ErrorCodeValue::ObjectClosed));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+
+    bool TestReplicationAckCoalescer::Setup()
+    {
+        return TRUE;
+    }
+}
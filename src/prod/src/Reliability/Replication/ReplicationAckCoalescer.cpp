@@ -0,0 +1,247 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Common;
+using namespace std;
+using namespace Transport;
+using namespace Reliability::ReplicationComponent;
+
+size_t const ReplicationAckCoalescer::MaxAcksPerMessage = 128;
+
+// The delay of a batch is the time needed for this many ACKs to arrive at the observed rate, bounded by the SLO
+int const ReplicationAckCoalescer::AcksPerMessageTarget = 4;
+
+ReplicationAckCoalescer::ReplicationAckCoalescer(
+    ComponentRoot const & root,
+    FlushCallback const & flushCallback,
+    ClockCallback const & clock)
+    : root_(root)
+    , flushCallback_(flushCallback)
+    , clock_(clock ? clock : ClockCallback([]() { return Stopwatch::Now(); }))
+    , targets_()
+    , pendingTargetCount_(0)
+    , closed_(false)
+    , lock_()
+{
+}
+
+ReplicationAckCoalescer::~ReplicationAckCoalescer()
+{
+    Close();
+}
+
+ErrorCode ReplicationAckCoalescer::Add(
+    ISendTarget::SPtr const & target,
+    ReplicationAckBatchEntry && ack,
+    TimeSpan const & latencySlo,
+    bool sendNow)
+{
+    vector<ReplicationAckBatchEntry> acks;
+    auto now = clock_();
+
+    {
+        AcquireWriteLock grab(lock_);
+        if (closed_)
+        {
+            return ErrorCodeValue::ObjectClosed;
+        }
+
+        auto pending = GetOrCreateCallerHoldsLock(target);
+
+        if (pending->LastAddTime != StopwatchTime::Zero)
+        {
+            // Exponentially weighted average with a weight of 1/8 for the newest interval
+            TimeSpan interval = now - pending->LastAddTime;
+            pending->AverageAddInterval = TimeSpan::FromTicks(
+                pending->AverageAddInterval.Ticks + (interval.Ticks - pending->AverageAddInterval.Ticks) / 8);
+        }
+
+        TimeSpan delay = sendNow ? TimeSpan::Zero : GetDelay(*pending, latencySlo);
+        pending->LastAddTime = now;
+
+        // ACKs are cumulative, a newer ACK of the same secondary replaces the pending one
+        auto it = find_if(
+            pending->Acks.begin(),
+            pending->Acks.end(),
+            [&ack](ReplicationAckBatchEntry const & entry)
+            {
+                return entry.SenderActor == ack.SenderActor && entry.ReceiverActor == ack.ReceiverActor;
+            });
+
+        if (it != pending->Acks.end())
+        {
+            *it = move(ack);
+        }
+        else
+        {
+            if (pending->Acks.empty())
+            {
+                ++pendingTargetCount_;
+            }
+
+            pending->Acks.push_back(move(ack));
+        }
+
+        if (delay == TimeSpan::Zero || pending->Acks.size() >= MaxAcksPerMessage)
+        {
+            TakeCallerHoldsLock(*pending, acks);
+        }
+        else if (now + delay < pending->Deadline)
+        {
+            pending->Deadline = now + delay;
+            if (!pending->Timer)
+            {
+                auto componentRoot = root_.CreateComponentRoot();
+                wstring address = target->Address();
+                pending->Timer = Timer::Create(
+                    TimerTagDefault,
+                    [this, componentRoot, address](TimerSPtr const &)
+                    {
+                        this->OnTimerCallback(address);
+                    },
+                    true);
+            }
+
+            pending->Timer->Change(delay);
+        }
+    }
+
+    if (acks.empty())
+    {
+        return ErrorCode::Success();
+    }
+
+    return flushCallback_(target, move(acks));
+}
+
+bool ReplicationAckCoalescer::TryTakePending(
+    ISendTarget const & target,
+    __out vector<ReplicationAckBatchEntry> & acks)
+{
+    // Fast path for the common case of no secondaries on this node waiting to ACK
+    if (pendingTargetCount_.load() == 0)
+    {
+        return false;
+    }
+
+    AcquireWriteLock grab(lock_);
+    auto it = targets_.find(target.Address());
+    if (it == targets_.end() || it->second->Acks.empty())
+    {
+        return false;
+    }
+
+    TakeCallerHoldsLock(*it->second, acks);
+    return true;
+}
+
+void ReplicationAckCoalescer::Close()
+{
+    map<wstring, PendingAcksSPtr> targets;
+    {
+        AcquireWriteLock grab(lock_);
+        closed_ = true;
+        targets.swap(targets_);
+        pendingTargetCount_.store(0);
+    }
+
+    for (auto const & pair : targets)
+    {
+        if (pair.second->Timer)
+        {
+            pair.second->Timer->Cancel();
+        }
+    }
+}
+
+void ReplicationAckCoalescer::Test_FireTimer(wstring const & address)
+{
+    OnTimerCallback(address);
+}
+
+ReplicationAckCoalescer::PendingAcksSPtr ReplicationAckCoalescer::GetOrCreateCallerHoldsLock(ISendTarget::SPtr const & target)
+{
+    auto it = targets_.find(target->Address());
+    if (it != targets_.end())
+    {
+        // The target may have been re-resolved since the last ACK
+        it->second->Target = target;
+        return it->second;
+    }
+
+    auto pending = make_shared<PendingAcks>();
+    pending->Target = target;
+    pending->Deadline = StopwatchTime::MaxValue;
+    pending->LastAddTime = StopwatchTime::Zero;
+    pending->AverageAddInterval = TimeSpan::Zero;
+
+    targets_.insert(make_pair(target->Address(), pending));
+    return pending;
+}
+
+void ReplicationAckCoalescer::TakeCallerHoldsLock(
+    PendingAcks & pending,
+    __out vector<ReplicationAckBatchEntry> & acks)
+{
+    if (!pending.Acks.empty())
+    {
+        --pendingTargetCount_;
+    }
+
+    acks.swap(pending.Acks);
+    pending.Deadline = StopwatchTime::MaxValue;
+
+    // The timer holds a reference to the root, so it is only kept while armed
+    if (pending.Timer)
+    {
+        pending.Timer->Cancel();
+        pending.Timer = nullptr;
+    }
+}
+
+void ReplicationAckCoalescer::OnTimerCallback(wstring const & address)
+{
+    ISendTarget::SPtr target;
+    vector<ReplicationAckBatchEntry> acks;
+
+    {
+        AcquireWriteLock grab(lock_);
+        if (closed_)
+        {
+            return;
+        }
+
+        auto it = targets_.find(address);
+        if (it == targets_.end())
+        {
+            return;
+        }
+
+        target = it->second->Target;
+        TakeCallerHoldsLock(*it->second, acks);
+    }
+
+    if (!acks.empty())
+    {
+        // Nobody to report a failure to, the secondaries send a newer ACK when the primary asks or on their retry
+        flushCallback_(target, move(acks));
+    }
+}
+
+TimeSpan ReplicationAckCoalescer::GetDelay(PendingAcks const & pending, TimeSpan const & latencySlo)
+{
+    if (pending.LastAddTime == StopwatchTime::Zero ||
+        pending.AverageAddInterval == TimeSpan::Zero ||
+        pending.AverageAddInterval >= latencySlo)
+    {
+        // No estimate yet, or no other ACK is expected to arrive within the SLO
+        return TimeSpan::Zero;
+    }
+
+    int64 delayTicks = pending.AverageAddInterval.Ticks * AcksPerMessageTarget;
+    return delayTicks < latencySlo.Ticks ? TimeSpan::FromTicks(delayTicks) : latencySlo;
+}
@@ -0,0 +1,85 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Reliability
+{
+    namespace ReplicationComponent
+    {
+        // Holds the ACKs of the secondaries on this node per remote node hosting their primaries,
+        // so that the ACKs of all partitions are sent in one message or piggybacked on the next
+        // replication message to that node. Shared by all replicators through the ReplicationTransport.
+        class ReplicationAckCoalescer
+        {
+            DENY_COPY(ReplicationAckCoalescer)
+
+        public:
+            typedef std::function<Common::ErrorCode(Transport::ISendTarget::SPtr const & target, std::vector<ReplicationAckBatchEntry> && acks)> FlushCallback;
+            typedef std::function<Common::StopwatchTime()> ClockCallback;
+
+            // The ACK rate is measured with clock, Stopwatch::Now if not provided
+            ReplicationAckCoalescer(
+                Common::ComponentRoot const & root,
+                FlushCallback const & flushCallback,
+                ClockCallback const & clock = ClockCallback());
+
+            ~ReplicationAckCoalescer();
+
+            static size_t const MaxAcksPerMessage;
+            static int const AcksPerMessageTarget;
+
+            // Replaces the pending ACK of the same secondary, if any. The ACK is flushed together with
+            // all ACKs pending for the node if sendNow is set or no other ACK is expected within latencySlo.
+            // Returns the send result if the ACK was flushed, success if it is pending.
+            Common::ErrorCode Add(
+                Transport::ISendTarget::SPtr const & target,
+                ReplicationAckBatchEntry && ack,
+                Common::TimeSpan const & latencySlo,
+                bool sendNow);
+
+            // Called for every message sent to target, returns false if there is nothing to piggyback
+            bool TryTakePending(
+                Transport::ISendTarget const & target,
+                __out std::vector<ReplicationAckBatchEntry> & acks);
+
+            void Close();
+
+            // CIT only: flushes the ACKs pending for the address as if their timer fired
+            void Test_FireTimer(std::wstring const & address);
+
+        private:
+            struct PendingAcks
+            {
+                Transport::ISendTarget::SPtr Target;
+                std::vector<ReplicationAckBatchEntry> Acks;
+                Common::StopwatchTime Deadline;
+                Common::StopwatchTime LastAddTime;
+                Common::TimeSpan AverageAddInterval;
+                Common::TimerSPtr Timer;
+            };
+
+            typedef std::shared_ptr<PendingAcks> PendingAcksSPtr;
+
+            PendingAcksSPtr GetOrCreateCallerHoldsLock(Transport::ISendTarget::SPtr const & target);
+            void TakeCallerHoldsLock(PendingAcks & pending, __out std::vector<ReplicationAckBatchEntry> & acks);
+            void OnTimerCallback(std::wstring const & address);
+
+            static Common::TimeSpan GetDelay(PendingAcks const & pending, Common::TimeSpan const & latencySlo);
+
+            Common::ComponentRoot const & root_;
+            FlushCallback const flushCallback_;
+            ClockCallback const clock_;
+
+            // Keyed by the address of the target
+            std::map<std::wstring, PendingAcksSPtr> targets_;
+            Common::atomic_long pendingTargetCount_;
+            bool closed_;
+            MUTABLE_RWLOCK(REReplicationAckCoalescer, lock_);
+        };
+
+        typedef std::unique_ptr<ReplicationAckCoalescer> ReplicationAckCoalescerUPtr;
+    }
+}
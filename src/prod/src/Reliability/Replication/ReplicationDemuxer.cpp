@@ -27,3 +27,25 @@ ReplicationEndpointId ReplicationDemuxer::GetActor(Message & message)
 
     return actorHeader.Actor;
 }
+
+void ReplicationDemuxer::OnMessageReceived(MessageUPtr & message, ISendTarget::SPtr const & replyTargetSPtr)
+{
+    ReplicationAckBatchHeader ackBatchHeader;
+    if (message->Headers.TryReadFirst(ackBatchHeader))
+    {
+        // Dispatch every coalesced ACK as if it was received in its own ReplicationAck message
+        for (auto const & ack : ackBatchHeader.Acks)
+        {
+            MessageUPtr ackMessage = ReplicationTransport::CreateAckMessageFromBatchEntry(ackBatchHeader.Address, ack);
+            ReceiverContextUPtr receiverContext = this->CreateReceiverContext(*ackMessage, replyTargetSPtr);
+            this->ActorDispatch(ack.ReceiverActor, ackMessage, receiverContext);
+        }
+    }
+
+    if (message->Action == ReplicationTransport::ReplicationAckBatchAction)
+    {
+        return;
+    }
+
+    DemuxerT<ReplicationEndpointId, ReceiverContext>::OnMessageReceived(message, replyTargetSPtr);
+}
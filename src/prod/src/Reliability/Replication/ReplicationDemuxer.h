@@ -18,6 +18,8 @@ namespace ReplicationComponent {
         virtual Transport::ReceiverContextUPtr CreateReceiverContext(Transport::Message & message, Transport::ISendTarget::SPtr const & replyTargetSPtr);
 
         virtual ReplicationEndpointId GetActor(Transport::Message & message);
+
+        virtual void OnMessageReceived(Transport::MessageUPtr & message, Transport::ISendTarget::SPtr const & replyTargetSPtr);
     };
 
     typedef std::unique_ptr<ReplicationDemuxer> ReplicationDemuxerUPtr;
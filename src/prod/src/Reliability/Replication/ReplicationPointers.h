@@ -34,6 +34,8 @@ namespace Reliability
 
         typedef std::function<bool(ComOperationCPtr const &, bool requestAck, FABRIC_SEQUENCE_NUMBER completedSeqNumber)> SendOperationCallback;
 
+        typedef std::function<bool(std::vector<ComOperationCPtr> const &, FABRIC_SEQUENCE_NUMBER completedSeqNumber)> SendOperationBatchCallback;
+
         typedef std::function<void(ComOperationCPtr const &)> OperationCallback;
 
         typedef std::function<void(ComOperation &)> OperationAckCallback;
@@ -54,6 +54,7 @@ ReplicationQueueManager::ReplicationQueueManager(
         previousConfigCatchupLsn_(Constants::InvalidLSN),
         previousConfigQuorumLsn_(Constants::InvalidLSN)
 {
+    replicationQueue_.FixedCapacity = config->PreallocateReplicationQueues;
 }
 
 ReplicationQueueManager::ReplicationQueueManager(
@@ -80,6 +81,7 @@ ReplicationQueueManager::ReplicationQueueManager(
         previousConfigCatchupLsn_(Constants::InvalidLSN),
         previousConfigQuorumLsn_(Constants::InvalidLSN)
 {
+    replicationQueue_.FixedCapacity = config->PreallocateReplicationQueues;
     replicationQueue_.IgnoreCommit = false;
     // Discard any pending replication operations from previous configuration versions
     replicationQueue_.DiscardNonCompletedOperations();
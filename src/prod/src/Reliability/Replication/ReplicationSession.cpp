@@ -41,7 +41,8 @@ ReplicationSession::ReplicationSession(
     Common::Guid const & partitionId,
     FABRIC_EPOCH const & epoch,
     ApiMonitoringWrapperSPtr const & apiMonitor,
-    ReplicationTransportSPtr const & transport)
+    ReplicationTransportSPtr const & transport,
+    REPerformanceCountersSPtr const & perfCounters)
     : replicationOperationHeadersSPtr_(transport->CreateSharedHeaders(primaryEndpointUniqueId, GetEndpointUniqueId(replicatorAddress), ReplicationTransport::ReplicationOperationAction)),
     copyOperationHeadersSPtr_(transport->CreateSharedHeaders(primaryEndpointUniqueId, GetEndpointUniqueId(replicatorAddress), ReplicationTransport::CopyOperationAction)),
     copyContextAckOperationHeadersSPtr_(transport->CreateSharedHeaders(primaryEndpointUniqueId, GetEndpointUniqueId(replicatorAddress), ReplicationTransport::CopyContextAckAction)),
@@ -67,7 +68,8 @@ ReplicationSession::ReplicationSession(
             Constants::ReplOperationTrace,
             primaryEndpointUniqueId,
             replicaId,
-            currentProgress)
+            currentProgress,
+            perfCounters)
         ),
     isPromotedtoActiveSecondary_(false),
     faultLock_(),
@@ -108,6 +110,10 @@ void ReplicationSession::Open()
         {
             return SendReplicateOperation(op, completedSeqNumber);
         }
+    },
+        [this](std::vector<ComOperationCPtr> const & ops, FABRIC_SEQUENCE_NUMBER completedSeqNumber)
+    {
+        return SendReplicateOperations(ops, completedSeqNumber);
     });
 }
 
@@ -447,6 +453,30 @@ bool ReplicationSession::SendReplicateOperation(
     return SendTransportMessage(replicationOperationHeadersSPtr_, move(message), true);
 }
 
+bool ReplicationSession::SendReplicateOperations(
+    std::vector<ComOperationCPtr> const & operations,
+    FABRIC_SEQUENCE_NUMBER completedSeqNumber)
+{
+    MessageUPtr message = ReplicationTransport::CreateReplicationBatchOperationMessage(
+        operations,
+        operations.back()->LastOperationInBatch,
+        ReadEpoch(),
+        config_->EnableReplicationOperationHeaderInBody,
+        completedSeqNumber);
+
+    ReplicatorEventSource::Events->PrimarySendW(
+        partitionId_,
+        primaryEndpointUniqueId_,
+        replicaId_,
+        Constants::ReplOperationTrace,
+        operations.front()->SequenceNumber,
+        replicationOperations_,
+        message->MessageId.Guid,
+        static_cast<uint32>(message->MessageId.Index));
+
+    return SendTransportMessage(replicationOperationHeadersSPtr_, move(message), true);
+}
+
 bool ReplicationSession::SendRequestAck()
 {
     MessageUPtr message = ReplicationTransport::CreateRequestAckMessage();
@@ -28,7 +28,8 @@ namespace Reliability
                 Common::Guid const & partitionId,
                 FABRIC_EPOCH const & epoch,
                 ApiMonitoringWrapperSPtr const & apiMonitor,
-                ReplicationTransportSPtr const & transport);
+                ReplicationTransportSPtr const & transport,
+                REPerformanceCountersSPtr const & perfCounters);
            
             virtual ~ReplicationSession();
 
@@ -85,6 +86,10 @@ namespace Reliability
                 ComOperationCPtr const & operation,
                 FABRIC_SEQUENCE_NUMBER completedSeqNumber) override;
 
+            bool SendReplicateOperations(
+                std::vector<ComOperationCPtr> const & operations,
+                FABRIC_SEQUENCE_NUMBER completedSeqNumber) override;
+
             bool SendRequestAck() override;
 
             bool SendCopyContextAck(bool shouldTrace) override;
@@ -616,6 +616,97 @@ namespace ReplicationUnitTest
         transportSecondary1->Stop();
     }
 
+    BOOST_AUTO_TEST_CASE(TestReplicationBatchMessage)
+    {
+        ComTestOperation::WriteInfo(
+            TransportTestSource,
+            "Start TestReplicationBatchMessage");
+
+        FABRIC_EPOCH epoch;
+        epoch.ConfigurationNumber = 100;
+        epoch.DataLossNumber = 1;
+        epoch.Reserved = NULL;
+
+        vector<ComOperationCPtr> operations;
+        for (FABRIC_SEQUENCE_NUMBER lsn = 10; lsn <= 14; ++lsn)
+        {
+            FABRIC_OPERATION_METADATA metadata;
+            metadata.Type = FABRIC_OPERATION_TYPE_NORMAL;
+            metadata.SequenceNumber = lsn;
+            metadata.AtomicGroupId = FABRIC_INVALID_ATOMIC_GROUP_ID;
+            metadata.Reserved = NULL;
+
+            operations.push_back(make_com<ComUserDataOperation,ComOperation>(
+                make_com<ComTestOperation,IFabricOperationData>(wformatString("TransportTest Batch Operation {0}", lsn)),
+                metadata,
+                epoch));
+        }
+
+        for (bool headerInBody : { true, false })
+        {
+            MessageUPtr message = ReplicationTransport::CreateReplicationBatchOperationMessage(operations, 20, epoch, headerInBody, 7);
+
+            vector<ComOperationCPtr> batchOperation;
+            FABRIC_EPOCH receivedEpoch;
+            FABRIC_SEQUENCE_NUMBER completedSequenceNumber;
+            VERIFY_IS_TRUE(ReplicationTransport::GetReplicationBatchOperationFromMessage(
+                *message,
+                nullptr,
+                batchOperation,
+                receivedEpoch,
+                completedSequenceNumber));
+
+            VERIFY_ARE_EQUAL(operations.size(), batchOperation.size());
+            VERIFY_ARE_EQUAL(7, completedSequenceNumber);
+            VERIFY_ARE_EQUAL(epoch.ConfigurationNumber, receivedEpoch.ConfigurationNumber);
+
+            for (size_t i = 0; i < operations.size(); ++i)
+            {
+                VERIFY_ARE_EQUAL(operations[i]->SequenceNumber, batchOperation[i]->SequenceNumber);
+                VERIFY_ARE_EQUAL(operations[i]->DataSize, batchOperation[i]->DataSize);
+                VERIFY_ARE_EQUAL(20, batchOperation[i]->LastOperationInBatch);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(TestReplicationAckBatchEntryMessage)
+    {
+        ComTestOperation::WriteInfo(
+            TransportTestSource,
+            "Start TestReplicationAckBatchEntryMessage");
+
+        Guid partitionId = Guid::NewGuid();
+        ReplicationEndpointId secondary(partitionId, 2);
+        ReplicationEndpointId primary(partitionId, 1);
+
+        ReplicationAckBatchEntry ack(secondary, primary, 10, 8, 5, 4, static_cast<int>(Common::ErrorCodeValue::InvalidState));
+        MessageUPtr message = ReplicationTransport::CreateAckMessageFromBatchEntry(L"127.0.0.1:1234", ack);
+
+        VERIFY_IS_TRUE(message->Action == ReplicationTransport::ReplicationAckAction);
+
+        ReplicationFromHeader fromHeader;
+        VERIFY_IS_TRUE(message->Headers.TryReadFirst(fromHeader));
+        VERIFY_ARE_EQUAL(L"127.0.0.1:1234", fromHeader.Address);
+        VERIFY_IS_TRUE(fromHeader.DemuxerActor == secondary);
+
+        ReplicationActorHeader actorHeader;
+        VERIFY_IS_TRUE(message->Headers.TryReadFirst(actorHeader));
+        VERIFY_IS_TRUE(actorHeader.Actor == primary);
+
+        FABRIC_SEQUENCE_NUMBER replicationReceivedLSN;
+        FABRIC_SEQUENCE_NUMBER replicationQuorumLSN;
+        FABRIC_SEQUENCE_NUMBER copyReceivedLSN;
+        FABRIC_SEQUENCE_NUMBER copyQuorumLSN;
+        int errorCodeValue;
+        ReplicationTransport::GetAckFromMessage(*message, replicationReceivedLSN, replicationQuorumLSN, copyReceivedLSN, copyQuorumLSN, errorCodeValue);
+
+        VERIFY_ARE_EQUAL(10, replicationReceivedLSN);
+        VERIFY_ARE_EQUAL(8, replicationQuorumLSN);
+        VERIFY_ARE_EQUAL(5, copyReceivedLSN);
+        VERIFY_ARE_EQUAL(4, copyQuorumLSN);
+        VERIFY_ARE_EQUAL(ack.ErrorCodeValue, errorCodeValue);
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 
     bool TestReplicationTransport::Setup()
@@ -31,6 +31,7 @@ GlobalWString ReplicationTransport::CopyContextAckAction = make_global<std::wstr
 GlobalWString ReplicationTransport::StartCopyAction = make_global<std::wstring>(L"StartCopy");
 GlobalWString ReplicationTransport::RequestAckAction = make_global<std::wstring>(L"RequestAck");
 GlobalWString ReplicationTransport::InduceFaultAction = make_global<std::wstring>(L"InduceFault");
+GlobalWString ReplicationTransport::ReplicationAckBatchAction = make_global<std::wstring>(L"ReplicationAckBatch");
 
 ReplicationTransport::ReplicationTransport(
     wstring const & endpoint, 
@@ -39,6 +40,7 @@ ReplicationTransport::ReplicationTransport(
     endpoint_(),
     publishEndpoint_(),
     demuxer_(),
+    ackCoalescer_(),
     securitySettings_(),
     securitySettingsLock_(),
     maxMessageSize_(0),
@@ -52,6 +54,7 @@ ReplicationTransport::ReplicationTransport(
     REGISTER_MESSAGE_HEADER(CopyContextOperationHeader);
     REGISTER_MESSAGE_HEADER(OperationAckHeader);
     REGISTER_MESSAGE_HEADER(OperationErrorHeader);
+    REGISTER_MESSAGE_HEADER(ReplicationAckBatchHeader);
 
 #ifdef PLATFORM_UNIX
     unicastTransport_->SetEventLoopReadDispatch(false);
@@ -62,6 +65,13 @@ ReplicationTransport::ReplicationTransport(
 
     // ReplicationTransport's root isn't a good root for the demuxer since the lifetime's don't match up
     this->demuxer_ = Common::make_unique<ReplicationDemuxer>(*this, unicastTransport_);
+
+    this->ackCoalescer_ = Common::make_unique<ReplicationAckCoalescer>(
+        *this,
+        [this](ISendTarget::SPtr const & target, vector<ReplicationAckBatchEntry> && acks)
+        {
+            return this->SendAckBatch(target, move(acks));
+        });
 }
 
 ReplicationTransport::~ReplicationTransport()
@@ -156,6 +166,7 @@ void ReplicationTransport::Stop()
 {
     ReplicatorEventSource::Events->TransportStop(endpoint_);
     
+    this->ackCoalescer_->Close();
     this->demuxer_->Abort();
     this->unicastTransport_->Stop();
 }
@@ -199,6 +210,27 @@ MessageUPtr ReplicationTransport::CreateAckMessage(
     return move(message);
 }
 
+MessageUPtr ReplicationTransport::CreateAckMessageFromBatchEntry(
+    wstring const & senderAddress,
+    ReplicationAckBatchEntry const & ack)
+{
+    MessageUPtr message = Common::make_unique<Transport::Message>(ack.CreateAckBody());
+
+    message->Headers.Add(ActionHeader(ReplicationAckAction));
+    message->Headers.Add(ReplicationActorHeader(ack.ReceiverActor));
+    message->Headers.Add(ReplicationFromHeader(senderAddress, ack.SenderActor));
+    message->Headers.Add(MessageIdHeader());
+
+    if (ack.ErrorCodeValue != 0)
+    {
+        message->Headers.Add(OperationErrorHeader(ack.ErrorCodeValue));
+    }
+
+    message->SetLocalTraceContext(move(wformatString("{0}:{1}", TransportTraceTagPrefix::ReplicationAck, ack)));
+
+    return move(message);
+}
+
 void ReplicationTransport::GetAckFromMessage(
     __in Message & message, 
     __out FABRIC_SEQUENCE_NUMBER & replicationReceivedLSN, 
@@ -274,28 +306,63 @@ MessageUPtr ReplicationTransport::CreateReplicationOperationMessage(
 {
     ASSERT_IFNOT(operation, "CreateReplicationOperationMessage: Null replication operation not allowed");
 
-    ULONG bufferCount;
-    FABRIC_OPERATION_DATA_BUFFER const * replicaBuffers = nullptr;
-    operation->GetData(&bufferCount, &replicaBuffers);
+    return CreateReplicationBatchOperationMessage(
+        vector<ComOperationCPtr>(1, operation),
+        lastSequenceNumberInBatch,
+        epoch,
+        enableReplicationOperationHeaderInBody,
+        completedSequenceNumber);
+}
+
+MessageUPtr ReplicationTransport::CreateReplicationBatchOperationMessage(
+    vector<ComOperationCPtr> const & operations, 
+    FABRIC_SEQUENCE_NUMBER lastSequenceNumberInBatch,
+    FABRIC_EPOCH const & epoch,
+    bool enableReplicationOperationHeaderInBody,
+    FABRIC_SEQUENCE_NUMBER completedSequenceNumber)
+{
+    ASSERT_IF(operations.empty(), "CreateReplicationBatchOperationMessage: Empty replication operation batch not allowed");
+
+    // The header carries the metadata and epoch of the first operation only,
+    // the receiver assigns consecutive sequence numbers to the rest
+    ComOperationCPtr const & firstOperation = operations.front();
+    FABRIC_SEQUENCE_NUMBER firstSequenceNumber = firstOperation->SequenceNumber;
+    FABRIC_SEQUENCE_NUMBER lastSequenceNumber = operations.back()->SequenceNumber;
 
-    FABRIC_SEQUENCE_NUMBER sequenceNumber = operation->SequenceNumber;
     vector<Common::const_buffer> buffers;
     vector<ULONG> segmentSizes;
-    vector<ULONG> bufferCounts(1, bufferCount);
+    vector<ULONG> bufferCounts;
+    bufferCounts.reserve(operations.size());
 
-    for (ULONG i = 0; i < bufferCount; ++i)
+    for (auto const & operation : operations)
     {
-        buffers.push_back(Common::const_buffer(replicaBuffers[i].Buffer, replicaBuffers[i].BufferSize));
-        segmentSizes.push_back(replicaBuffers[i].BufferSize);
+        ASSERT_IFNOT(operation, "CreateReplicationBatchOperationMessage: Null replication operation not allowed");
+        ASSERT_IFNOT(
+            operation->SequenceNumber == firstSequenceNumber + static_cast<FABRIC_SEQUENCE_NUMBER>(bufferCounts.size()),
+            "CreateReplicationBatchOperationMessage: operation {0} is not consecutive in batch starting at {1}",
+            operation->SequenceNumber,
+            firstSequenceNumber);
+
+        ULONG bufferCount;
+        FABRIC_OPERATION_DATA_BUFFER const * replicaBuffers = nullptr;
+        operation->GetData(&bufferCount, &replicaBuffers);
+
+        for (ULONG i = 0; i < bufferCount; ++i)
+        {
+            buffers.push_back(Common::const_buffer(replicaBuffers[i].Buffer, replicaBuffers[i].BufferSize));
+            segmentSizes.push_back(replicaBuffers[i].BufferSize);
+        }
+
+        bufferCounts.push_back(bufferCount);
     }
 
     ReplicationOperationHeader opHeader(
-        operation->Metadata,
+        firstOperation->Metadata,
         epoch,
-        operation->Epoch,
+        firstOperation->Epoch,
         std::move(segmentSizes),
-        sequenceNumber,
-        sequenceNumber,
+        firstSequenceNumber,
+        lastSequenceNumber,
         lastSequenceNumberInBatch,
         std::move(bufferCounts),
         completedSequenceNumber);
@@ -313,11 +380,10 @@ MessageUPtr ReplicationTransport::CreateReplicationOperationMessage(
 
     void * state = nullptr;
 
-    ComOperationCPtr copy(operation);
-    MoveCPtr<ComOperation> mover(move(copy));
+    // The operations own the buffers, keep them alive until the message is released
     MessageUPtr message = Common::make_unique<Message>(
         buffers,
-        [mover, sequenceNumber, lastSequenceNumberInBatch, replicationOperationBodyHeaderBuffer] (vector<Common::const_buffer> const & buffers, void *)
+        [operations, firstSequenceNumber, lastSequenceNumber, lastSequenceNumberInBatch, replicationOperationBodyHeaderBuffer] (vector<Common::const_buffer> const & buffers, void *)
         {
             //replicationOperationBodyHeaderBuffer is captured as its value is placed in the buffers that are sent out with the message
             //if not captures, it could be garbage collected and no correct message buffer will be sent.
@@ -329,8 +395,8 @@ MessageUPtr ReplicationTransport::CreateReplicationOperationMessage(
 
             ReplicatorEventSource::Events->TransportMsgBatchCallback(
                 Constants::ReplOperationTrace,
-                sequenceNumber, 
-                sequenceNumber, 
+                firstSequenceNumber, 
+                lastSequenceNumber, 
                 lastSequenceNumberInBatch, 
                 static_cast<uint64>(size));
         },
@@ -350,7 +416,7 @@ MessageUPtr ReplicationTransport::CreateReplicationOperationMessage(
     
     message->Headers.Add(MessageIdHeader());
 
-    message->SetLocalTraceContext(move(wformatString("{0}:{1}", TransportTraceTagPrefix::ReplicationOperation, sequenceNumber)));
+    message->SetLocalTraceContext(move(wformatString("{0}:{1}", TransportTraceTagPrefix::ReplicationOperation, firstSequenceNumber)));
 
     return move(message);
 }
@@ -886,12 +952,45 @@ ErrorCode ReplicationTransport::SendMessage(
 {
     ASSERT_IF(message == nullptr, "SendMessage to {0}: null message", receiverTarget->Address());
     message->Headers.Add(buffer, true);
+
+    vector<ReplicationAckBatchEntry> acks;
+    if (ackCoalescer_->TryTakePending(*receiverTarget, acks))
+    {
+        message->Headers.Add(ReplicationAckBatchHeader(publishEndpoint_, move(acks)));
+    }
+
     UnreliableTransport::AddPartitionIdToMessageProperty(*message, partitionId);
     auto errorCode = unicastTransport_->SendOneWay(receiverTarget, move(message), messageExpiration);
 
     return this->ReturnSendMessage(errorCode, receiverTarget);
 }
 
+ErrorCode ReplicationTransport::AddAck(
+    ISendTarget::SPtr const & receiverTarget,
+    ReplicationAckBatchEntry && ack,
+    TimeSpan const & latencySlo,
+    bool sendNow)
+{
+    return ackCoalescer_->Add(receiverTarget, move(ack), latencySlo, sendNow);
+}
+
+ErrorCode ReplicationTransport::SendAckBatch(
+    ISendTarget::SPtr const & receiverTarget,
+    vector<ReplicationAckBatchEntry> && acks)
+{
+    MessageUPtr message = Common::make_unique<Transport::Message>();
+    message->Headers.Add(ReplicationAckBatchHeader(publishEndpoint_, move(acks)));
+    message->Headers.Add(MessageIdHeader());
+
+    // Not sent through SendMessage, which would piggyback the ACKs added since the batch was taken in a second header
+    auto buffer = CreateSharedHeaders(ReplicationEndpointId(), ReplicationEndpointId(), ReplicationAckBatchAction);
+    message->Headers.Add(*buffer, true);
+    UnreliableTransport::AddPartitionIdToMessageProperty(*message, Guid::Empty());
+
+    auto errorCode = unicastTransport_->SendOneWay(receiverTarget, move(message), TimeSpan::MaxValue);
+    return this->ReturnSendMessage(errorCode, receiverTarget);
+}
+
 ErrorCode ReplicationTransport::ReturnSendMessage(
     ErrorCode const & errorCode,
     ISendTarget::SPtr const & receiverTarget) const
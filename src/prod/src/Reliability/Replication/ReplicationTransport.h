@@ -89,6 +89,7 @@ namespace Reliability
             static Common::GlobalWString CopyContextAckAction;
             static Common::GlobalWString RequestAckAction;
             static Common::GlobalWString InduceFaultAction;
+            static Common::GlobalWString ReplicationAckBatchAction;
 
             Common::ErrorCode SetSecurity(Transport::SecuritySettings const& securitySettings);
 
@@ -119,6 +120,15 @@ namespace Reliability
 
             Common::ErrorCode ReturnSendMessage(Common::ErrorCode const & errorCode, Transport::ISendTarget::SPtr const & receiverTarget) const;
 
+            // Queues the ACK of a secondary on this node to be sent with the other ACKs to the same node,
+            // either in a ReplicationAckBatch message or piggybacked on the next message sent to the node.
+            // Returns the send result if the ACK was sent right away.
+            Common::ErrorCode AddAck(
+                Transport::ISendTarget::SPtr const & receiverTarget,
+                ReplicationAckBatchEntry && ack,
+                Common::TimeSpan const & latencySlo,
+                bool sendNow);
+
             Transport::ISendTarget::SPtr ResolveTarget(std::wstring const & endpoint, std::wstring const& id = L"");
 
             static Transport::MessageUPtr CreateReplicationOperationMessage(
@@ -128,6 +138,15 @@ namespace Reliability
                 bool enableReplicationOperationHeaderInBody,
                 FABRIC_SEQUENCE_NUMBER completedSequenceNumber = Constants::InvalidLSN);
 
+            // Operations must have consecutive sequence numbers and share the metadata type,
+            // atomic group and epoch of the first one, only that is carried in the header
+            static Transport::MessageUPtr CreateReplicationBatchOperationMessage(
+                std::vector<ComOperationCPtr> const & operations, 
+                FABRIC_SEQUENCE_NUMBER lastSequenceNumberInBatch,
+                FABRIC_EPOCH const & epoch,
+                bool enableReplicationOperationHeaderInBody,
+                FABRIC_SEQUENCE_NUMBER completedSequenceNumber = Constants::InvalidLSN);
+
             static bool GetReplicationBatchOperationFromMessage(
                 __in Transport::Message & message, 
                 OperationAckCallback const & ackCallback,
@@ -199,6 +218,10 @@ namespace Reliability
                 FABRIC_SEQUENCE_NUMBER copyQuorumLSN = Constants::NonInitializedLSN,
                 int errorCodeValue = 0);
 
+            static Transport::MessageUPtr CreateAckMessageFromBatchEntry(
+                std::wstring const & senderAddress,
+                ReplicationAckBatchEntry const & ack);
+
             static void GetAckFromMessage(
                 __in Transport::Message & message, 
                 __out FABRIC_SEQUENCE_NUMBER & replicationReceivedLSN, 
@@ -237,10 +260,15 @@ namespace Reliability
                 ComOperationCPtr const & operation,
                 std::vector<ULONG> & segmentSizes);
 
+            Common::ErrorCode SendAckBatch(
+                Transport::ISendTarget::SPtr const & receiverTarget,
+                std::vector<ReplicationAckBatchEntry> && acks);
+
             Transport::IDatagramTransportSPtr unicastTransport_;
             std::wstring endpoint_;
             std::wstring publishEndpoint_; // Initialized during Start()
             ReplicationDemuxerUPtr demuxer_;
+            ReplicationAckCoalescerUPtr ackCoalescer_;
             Transport::SecuritySettings securitySettings_;
             MUTABLE_RWLOCK(REReplicationTransportSecuritySettings, securitySettingsLock_);
             // Maximum size of a single replication message
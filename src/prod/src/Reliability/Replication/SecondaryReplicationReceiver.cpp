@@ -127,6 +127,8 @@ SecondaryReplicationReceiver::SecondaryReplicationReceiver(
             perfCounters_);
     }
 
+    replicationQueue_->FixedCapacity = config->PreallocateReplicationQueues;
+
     // At this point, we could possibly have some operations in the queue after the introduction of QC_QUORUM with mustcatchup instead of catchup all
     // That is because all replicas may not have been caught up and hence all operations are not completed from the primary replicator's perspective to discard it.
 
@@ -677,6 +679,8 @@ void SecondaryReplicationReceiver::CreateReplicationQueue(
             perfCounters_);
    }
     
+    queue->FixedCapacity = config_->PreallocateReplicationQueues;
+
     // Initially, do not set the commit callback;
     // the callback will be set when all copy operations are received, 
     // so we can start dispatching replication operations.
@@ -323,7 +323,8 @@ void SecondaryReplicator::Open()
 {
     ackSender_.Open(
         *this,
-        [this](bool shouldTrace) { return this->SendAck(shouldTrace); });
+        [this](bool shouldTrace) { return this->SendAck(shouldTrace, false); },
+        [this](bool shouldTrace) { return this->SendAck(shouldTrace, true); });
 
     if (requireServiceAck_)
     {
@@ -678,13 +679,14 @@ OperationStreamSPtr SecondaryReplicator::GetReplicationStream(SecondaryReplicato
     return replicationReceiver_.GetStream(thisSPtr);
 }
 
-bool SecondaryReplicator::SendAck(bool shouldTrace)
+bool SecondaryReplicator::SendAck(bool shouldTrace, bool coalesce)
 {
     FABRIC_SEQUENCE_NUMBER copyCommittedLSN;
     FABRIC_SEQUENCE_NUMBER copyCompletedLSN;
     FABRIC_SEQUENCE_NUMBER replicationCommittedLSN;
     FABRIC_SEQUENCE_NUMBER replicationCompletedLSN;
     wstring primaryTarget;
+    ReplicationEndpointId primaryActor;
     KBuffer::SPtr headersStream;
     ISendTarget::SPtr target;
     int errorCodeValue;
@@ -697,6 +699,7 @@ bool SecondaryReplicator::SendAck(bool shouldTrace)
         copyCommittedLSN,
         copyCompletedLSN,
         primaryTarget,
+        primaryActor,
         headersStream,
         target,
         errorCodeValue,
@@ -709,6 +712,45 @@ bool SecondaryReplicator::SendAck(bool shouldTrace)
         // (the secondary must have been closed)
         return false;
     }
+
+    TimeSpan ackCoalescingLatencySlo = config_->AckCoalescingLatencySlo;
+    if (ackCoalescingLatencySlo > TimeSpan::Zero)
+    {
+        // Forced ACKs go through the coalescer as well, replacing the pending ACK of this replica
+        auto errorCode = transport_->AddAck(
+            target,
+            ReplicationAckBatchEntry(
+                endpointUniqueId_,
+                primaryActor,
+                replicationCommittedLSN,
+                replicationCompletedLSN,
+                copyCommittedLSN,
+                copyCompletedLSN,
+                errorCodeValue),
+            ackCoalescingLatencySlo,
+            !coalesce);
+
+        if (shouldTrace)
+        {
+            ReplicatorEventSource::Events->SecondarySendVerboseAcknowledgement(
+                partitionId_,
+                endpointUniqueId_,
+                primaryTarget,
+                replicationCommittedLSN,
+                replicationCompletedLSN,
+                copyCommittedLSN,
+                copyCompletedLSN,
+                errorCodeValue,
+                Common::Guid::Empty(),
+                0,
+                pendingReplOpTraces,
+                pendingCopyOpTraces,
+                config_->ToString());
+        }
+
+        // Same as SendTransportMessage, only queue full stops the sender from retrying
+        return !errorCode.IsError(ErrorCodeValue::TransportSendQueueFull);
+    }
     
     MessageUPtr message = ReplicationTransport::CreateAckMessage(
         replicationCommittedLSN,
@@ -803,6 +845,34 @@ void SecondaryReplicator::GetAck(
     __out int & errorCodeValue,
     __out std::vector<SecondaryReplicatorTraceInfo> & pendingReplOpMessages,
     __out std::vector<SecondaryReplicatorTraceInfo> & pendingCopyOpMessages)
+{
+    ReplicationEndpointId primaryActor;
+    GetAck(
+        replicationCommittedLSN,
+        replicationCompletedLSN,
+        copyCommittedLSN,
+        copyCompletedLSN,
+        primaryTarget,
+        primaryActor,
+        headersStream,
+        target,
+        errorCodeValue,
+        pendingReplOpMessages,
+        pendingCopyOpMessages);
+}
+
+void SecondaryReplicator::GetAck(
+    __out FABRIC_SEQUENCE_NUMBER & replicationCommittedLSN, 
+    __out FABRIC_SEQUENCE_NUMBER & replicationCompletedLSN, 
+    __out FABRIC_SEQUENCE_NUMBER & copyCommittedLSN,
+    __out FABRIC_SEQUENCE_NUMBER & copyCompletedLSN,
+    __out wstring & primaryTarget,
+    __out ReplicationEndpointId & primaryActor,
+    __out KBuffer::SPtr & headersStream,
+    __out ISendTarget::SPtr & target,
+    __out int & errorCodeValue,
+    __out std::vector<SecondaryReplicatorTraceInfo> & pendingReplOpMessages,
+    __out std::vector<SecondaryReplicatorTraceInfo> & pendingCopyOpMessages)
 {
     AcquireWriteLock lock(queuesLock_);
     // Look at the copy and replication queues 
@@ -815,6 +885,7 @@ void SecondaryReplicator::GetAck(
         primaryTarget = primaryTarget_->Address();
     }
 
+    primaryActor = primaryDemuxerActor_;
     headersStream = replicationAckHeadersSPtr_;
     target = primaryTarget_;
     errorCodeValue = copyErrorCodeValue_;
@@ -268,7 +268,20 @@ namespace Reliability
 
             bool ShouldForceSendAck();
 
-            bool SendAck(bool shouldTrace);
+            bool SendAck(bool shouldTrace, bool coalesce);
+
+            void GetAck(
+                __out FABRIC_SEQUENCE_NUMBER & replicationCommittedLSN, 
+                __out FABRIC_SEQUENCE_NUMBER & replicationCompletedLSN, 
+                __out FABRIC_SEQUENCE_NUMBER & copyCommittedLSN,
+                __out FABRIC_SEQUENCE_NUMBER & copyCompletedLSN,
+                __out std::wstring & primaryTarget,
+                __out ReplicationEndpointId & primaryActor,
+                __out KBuffer::SPtr & headersStream,
+                __out Transport::ISendTarget::SPtr & target,
+                __out int & errorCodeValue,
+                __out std::vector<SecondaryReplicatorTraceInfo> & pendingReplOpMessages,
+                __out std::vector<SecondaryReplicatorTraceInfo> & pendingCopyOpMessages);
 
             bool SendCopyContextOperation(
                 ComOperationCPtr const & operationPtr,
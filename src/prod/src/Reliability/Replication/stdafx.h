@@ -54,6 +54,7 @@
 #include "Reliability/Replication/CopyContextReceiver.h"
 #include "Reliability/Replication/RemoteSession.EstablishCopyAsyncOperation.h"
 #include "Reliability/Replication/ReplicationAckMessageBody.h"
+#include "Reliability/Replication/ReplicationAckBatchHeader.h"
 #include "Reliability/Replication/ReplicationFromHeader.h"
 #include "Reliability/Replication/ReplicationOperationHeader.h"
 #include "Reliability/Replication/ReplicationOperationBodyHeader.h"
@@ -62,6 +63,7 @@
 #include "Reliability/Replication/OperationAckHeader.h"
 #include "Reliability/Replication/AckMessageBody.h"
 #include "Reliability/Replication/OperationErrorHeader.h"
+#include "Reliability/Replication/ReplicationAckCoalescer.h"
 #include "Reliability/Replication/ReplicationTransport.h"
 #include "Reliability/Replication/PrimaryReplicator.h"
 #include "Reliability/Replication/PrimaryReplicator.BuildIdleAsyncOperation.h"
@@ -8,7 +8,7 @@
 namespace TxnReplicator
 {
 
-#define TR_GLOBAL_SETTINGS_COUNT 10
+#define TR_GLOBAL_SETTINGS_COUNT 14
 #define TR_OVERRIDABLE_STATIC_SETTINGS_COUNT 9
 #define TR_OVERRIDABLE_DYNAMIC_SETTINGS_COUNT 11
 #define TR_OVERRIDABLE_SETTINGS_COUNT (TR_OVERRIDABLE_STATIC_SETTINGS_COUNT + TR_OVERRIDABLE_DYNAMIC_SETTINGS_COUNT)
@@ -78,6 +78,14 @@ namespace TxnReplicator
             int64 get_FlushedRecordsTraceVectorSize() const; \
             std::wstring get_DispatchingMode() const; \
             __declspec(property(get=get_DispatchingMode)) std::wstring DispatchingMode; \
+            __declspec(property(get=get_GroupCommitTargetSizeInKb)) int64 GroupCommitTargetSizeInKb ; \
+            int64 get_GroupCommitTargetSizeInKb() const; \
+            __declspec(property(get=get_GroupCommitMaxDelay)) Common::TimeSpan GroupCommitMaxDelay ; \
+            Common::TimeSpan get_GroupCommitMaxDelay() const; \
+            __declspec(property(get=get_EnableLogRecordCompression)) bool EnableLogRecordCompression ; \
+            bool get_EnableLogRecordCompression() const; \
+            __declspec(property(get=get_RecoveryDecodeParallelism)) int64 RecoveryDecodeParallelism ; \
+            int64 get_RecoveryDecodeParallelism() const; \
 
 #define DEFINE_GET_TR_CONFIG_METHOD() \
             void GetTransactionalReplicatorSettingsStructValues(TxnReplicator::TRConfigValues & config) const \
@@ -137,6 +145,10 @@ namespace TxnReplicator
             double test_LogDelayRatio_; \
             double test_LogDelayProcessExitRatio_; \
             std::wstring dispatchingMode_; \
+            int64 groupCommitTargetSizeInKb_; \
+            Common::TimeSpan groupCommitMaxDelay_; \
+            bool enableLogRecordCompression_; \
+            int64 recoveryDecodeParallelism_; \
 
 /*ProgressVectorMaxEntires is set to the maximum number of records that can be traced*/
 #define TR_CONFIG_PROPERTIES(section_name)\
@@ -165,6 +177,10 @@ namespace TxnReplicator
             INTERNAL_CONFIG_ENTRY(uint, section_name, SerializationVersion, 0, Common::ConfigEntryUpgradePolicy::Static); \
             INTERNAL_CONFIG_ENTRY(bool, section_name, EnableIncrementalBackupsAcrossReplicas, false, Common::ConfigEntryUpgradePolicy::Static); \
             INTERNAL_CONFIG_ENTRY(std::wstring, section_name, DispatchingMode, L"", Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, GroupCommitTargetSizeInKb, 256, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(Common::TimeSpan, section_name, GroupCommitMaxDelay, Common::TimeSpan::FromMilliseconds(2), Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(bool, section_name, EnableLogRecordCompression, false, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, RecoveryDecodeParallelism, 1, Common::ConfigEntryUpgradePolicy::Dynamic); \
             TEST_CONFIG_ENTRY(std::wstring, section_name, Test_LoggingEngine, L"ktl", Common::ConfigEntryUpgradePolicy::NotAllowed); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMinDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMaxDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
@@ -198,6 +214,10 @@ namespace TxnReplicator
             INTERNAL_CONFIG_ENTRY(uint, section_name, FlushedRecordsTraceVectorSize, 32, Common::ConfigEntryUpgradePolicy::Static); \
             INTERNAL_CONFIG_ENTRY(Common::TimeSpan, section_name, TruncationInterval, Common::TimeSpan::FromSeconds(0), Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(std::wstring, section_name, DispatchingMode, L"", Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, GroupCommitTargetSizeInKb, 256, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(Common::TimeSpan, section_name, GroupCommitMaxDelay, Common::TimeSpan::FromMilliseconds(2), Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(bool, section_name, EnableLogRecordCompression, false, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, RecoveryDecodeParallelism, 1, Common::ConfigEntryUpgradePolicy::Dynamic); \
             TEST_CONFIG_ENTRY(std::wstring, section_name, Test_LoggingEngine, L"ktl", Common::ConfigEntryUpgradePolicy::NotAllowed); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMinDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
             TEST_CONFIG_ENTRY(uint, section_name, Test_LogMaxDelayIntervalMilliseconds, 0, Common::ConfigEntryUpgradePolicy::Dynamic); \
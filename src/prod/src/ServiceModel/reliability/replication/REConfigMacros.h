@@ -10,7 +10,7 @@ namespace Reliability
     namespace ReplicationComponent
     {
 #define RE_GLOBAL_STATIC_SETTINGS_COUNT 0
-#define RE_GLOBAL_DYNAMIC_SETTINGS_COUNT 20
+#define RE_GLOBAL_DYNAMIC_SETTINGS_COUNT 24
 
 #define RE_GLOBAL_SETTINGS_COUNT RE_GLOBAL_STATIC_SETTINGS_COUNT + RE_GLOBAL_DYNAMIC_SETTINGS_COUNT
 
@@ -60,6 +60,14 @@ namespace Reliability
             Common::TimeSpan get_IdleReplicaMaxLagDurationBeforePromotion() const ;\
             __declspec(property(get=get_SecondaryReplicatorBatchTracingArraySize)) int64 SecondaryReplicatorBatchTracingArraySize ; \
             int64 get_SecondaryReplicatorBatchTracingArraySize() const; \
+            __declspec(property(get=get_ReplicationBatchSendMaxBytes)) int64 ReplicationBatchSendMaxBytes ; \
+            int64 get_ReplicationBatchSendMaxBytes() const; \
+            __declspec(property(get=get_ReplicationBatchSendMaxDelay)) Common::TimeSpan ReplicationBatchSendMaxDelay ; \
+            Common::TimeSpan get_ReplicationBatchSendMaxDelay() const ;\
+            __declspec(property(get=get_AckCoalescingLatencySlo)) Common::TimeSpan AckCoalescingLatencySlo ; \
+            Common::TimeSpan get_AckCoalescingLatencySlo() const ;\
+            __declspec(property(get=get_PreallocateReplicationQueues)) bool PreallocateReplicationQueues; \
+            bool get_PreallocateReplicationQueues() const; \
 
 // This macro defines all the settings in the replicator config that are overridable by the user using the CreateReplicator() API
 #define DECLARE_RE_OVERRIDABLE_SETTINGS_PROPERTIES() \
@@ -176,6 +184,10 @@ namespace Reliability
             INTERNAL_CONFIG_ENTRY(double, section_name, SecondaryProgressRateDecayFactor, 0.5, Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(Common::TimeSpan, section_name, IdleReplicaMaxLagDurationBeforePromotion, Common::TimeSpan::FromSeconds(60), Common::ConfigEntryUpgradePolicy::Dynamic); \
             INTERNAL_CONFIG_ENTRY(uint, section_name, SecondaryReplicatorBatchTracingArraySize, 32, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(uint, section_name, ReplicationBatchSendMaxBytes, 65536, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(Common::TimeSpan, section_name, ReplicationBatchSendMaxDelay, Common::TimeSpan::FromMilliseconds(1), Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(Common::TimeSpan, section_name, AckCoalescingLatencySlo, Common::TimeSpan::Zero, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            INTERNAL_CONFIG_ENTRY(bool, section_name, PreallocateReplicationQueues, false, Common::ConfigEntryUpgradePolicy::Dynamic); \
 
 // -----------------------------------------------------------------------------------------
             // NOTE - Update the list of configs in ReplicatorSettings.cpp when new configs that 
@@ -225,6 +237,10 @@ namespace Reliability
             DEPRECATED_CONFIG_ENTRY(double, section_name, SecondaryProgressRateDecayFactor, 0.5, Common::ConfigEntryUpgradePolicy::Dynamic); \
             DEPRECATED_CONFIG_ENTRY(Common::TimeSpan, section_name, IdleReplicaMaxLagDurationBeforePromotion, Common::TimeSpan::FromSeconds(60), Common::ConfigEntryUpgradePolicy::Dynamic); \
             DEPRECATED_CONFIG_ENTRY(uint, section_name, SecondaryReplicatorBatchTracingArraySize, 32, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            DEPRECATED_CONFIG_ENTRY(uint, section_name, ReplicationBatchSendMaxBytes, 65536, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            DEPRECATED_CONFIG_ENTRY(Common::TimeSpan, section_name, ReplicationBatchSendMaxDelay, Common::TimeSpan::FromMilliseconds(1), Common::ConfigEntryUpgradePolicy::Dynamic); \
+            DEPRECATED_CONFIG_ENTRY(Common::TimeSpan, section_name, AckCoalescingLatencySlo, Common::TimeSpan::Zero, Common::ConfigEntryUpgradePolicy::Dynamic); \
+            DEPRECATED_CONFIG_ENTRY(bool, section_name, PreallocateReplicationQueues, false, Common::ConfigEntryUpgradePolicy::Dynamic); \
             \
             \
             DEFINE_GETCONFIG_METHOD()
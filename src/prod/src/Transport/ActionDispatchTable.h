@@ -0,0 +1,94 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Transport
+{
+    // Maps message actions to handlers. Actions are interned into ActionTable when handlers are
+    // added, so dispatching an incoming message is an array index on its cached ActionId instead
+    // of a string keyed map lookup. Actions that could not be interned are kept in a string map.
+    template <typename THandler>
+    class ActionDispatchTable
+    {
+    public:
+        ActionDispatchTable()
+        {
+        }
+
+        bool Add(std::wstring const & action, THandler const & handler)
+        {
+            auto id = ActionTable::Register(action);
+            if (id == ActionTable::UnknownActionId)
+            {
+                return fallbackHandlers_.insert(std::make_pair(action, handler)).second;
+            }
+
+            if (handlers_.size() <= id)
+            {
+                handlers_.resize(id + 1);
+            }
+
+            if (handlers_[id]) { return false; }
+
+            handlers_[id] = Common::make_unique<THandler>(handler);
+            ++count_;
+            return true;
+        }
+
+        THandler const * Find(Message const & message) const
+        {
+            auto id = message.ActionId;
+            if (id != ActionTable::UnknownActionId)
+            {
+                return (id < handlers_.size()) ? handlers_[id].get() : nullptr;
+            }
+
+            return FindFallback(message.Action);
+        }
+
+        THandler const * Find(std::wstring const & action) const
+        {
+            auto id = ActionTable::Lookup(action);
+            if (id != ActionTable::UnknownActionId)
+            {
+                return (id < handlers_.size()) ? handlers_[id].get() : nullptr;
+            }
+
+            return FindFallback(action);
+        }
+
+        size_t size() const { return count_ + fallbackHandlers_.size(); }
+        bool empty() const { return this->size() == 0; }
+
+        void swap(ActionDispatchTable & other)
+        {
+            handlers_.swap(other.handlers_);
+            fallbackHandlers_.swap(other.fallbackHandlers_);
+            std::swap(count_, other.count_);
+        }
+
+        void clear()
+        {
+            handlers_.clear();
+            fallbackHandlers_.clear();
+            count_ = 0;
+        }
+
+    private:
+        THandler const * FindFallback(std::wstring const & action) const
+        {
+            if (fallbackHandlers_.empty()) { return nullptr; }
+
+            auto it = fallbackHandlers_.find(action);
+            return (it != fallbackHandlers_.end()) ? &(it->second) : nullptr;
+        }
+
+        // indexed by ActionId
+        std::vector<std::unique_ptr<THandler>> handlers_;
+        std::map<std::wstring, THandler> fallbackHandlers_;
+        size_t count_ = 0;
+    };
+}
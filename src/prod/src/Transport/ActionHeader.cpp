@@ -32,6 +32,11 @@ std::wstring const & ActionHeader::get_Action() const
     return action_;
 }
 
+std::wstring && ActionHeader::TakeAction()
+{
+    return std::move(action_);
+}
+
 void ActionHeader::WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const
 {
     w << action_;
@@ -21,6 +21,9 @@ namespace Transport
         __declspec(property(get=get_Action)) std::wstring const & Action;
         std::wstring const & get_Action() const;
 
+        // Moves action out, for callers that only need the action string of a deserialized header
+        std::wstring && TakeAction();
+
         void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const;
 
         FABRIC_FIELDS_01(action_);
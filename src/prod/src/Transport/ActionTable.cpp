@@ -0,0 +1,119 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Transport;
+using namespace Common;
+using namespace std;
+
+namespace
+{
+    StringLiteral const TraceType("ActionTable");
+
+    uint64 HashAction(wstring const & action)
+    {
+        // FNV-1a
+        uint64 hash = 14695981039346656037ULL;
+        for (auto c : action)
+        {
+            hash ^= (uint64)c;
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+}
+
+INIT_ONCE ActionTable::initOnce_ = INIT_ONCE_STATIC_INIT;
+ActionTable * ActionTable::singleton_ = nullptr;
+
+ActionTable::ActionTable()
+    : count_(0)
+    , slots_(new atomic<Entry const *>[SlotCount])
+{
+    for (size_t i = 0; i < SlotCount; ++i)
+    {
+        slots_[i].store(nullptr, memory_order_relaxed);
+    }
+}
+
+BOOL CALLBACK ActionTable::InitFunction(PINIT_ONCE, PVOID, PVOID*)
+{
+    singleton_ = new ActionTable();
+    return TRUE;
+}
+
+ActionTable & ActionTable::GetTable()
+{
+    BOOL bStatus = ::InitOnceExecuteOnce(&initOnce_, InitFunction, nullptr, nullptr);
+    ASSERT_IF(!bStatus, "Failed to initialize ActionTable singleton");
+    return *singleton_;
+}
+
+ActionTable::ActionId ActionTable::Register(wstring const & action)
+{
+    return GetTable().RegisterInternal(action);
+}
+
+ActionTable::ActionId ActionTable::Lookup(wstring const & action)
+{
+    return GetTable().LookupInternal(action);
+}
+
+size_t ActionTable::Count()
+{
+    return GetTable().count_.load(memory_order_relaxed);
+}
+
+ActionTable::Entry const * ActionTable::Find(wstring const & action, uint64 hash, size_t & slot) const
+{
+    // linear probing, the table never fills up as it has twice as many slots as there are ids
+    for (slot = hash & (SlotCount - 1); ; slot = (slot + 1) & (SlotCount - 1))
+    {
+        auto entry = slots_[slot].load(memory_order_acquire);
+        if (entry == nullptr) return nullptr;
+
+        if ((entry->Hash == hash) && (entry->Action == action)) return entry;
+    }
+}
+
+ActionTable::ActionId ActionTable::RegisterInternal(wstring const & action)
+{
+    auto hash = HashAction(action);
+
+    size_t slot;
+    auto entry = Find(action, hash, slot);
+    if (entry) return entry->Id;
+
+    AcquireExclusiveLock grab(registerLock_);
+
+    // probe again, another thread may have registered the same action
+    entry = Find(action, hash, slot);
+    if (entry) return entry->Id;
+
+    auto count = count_.load(memory_order_relaxed);
+    if (count >= numeric_limits<ActionId>::max())
+    {
+        WriteWarning(TraceType, "table full, cannot register '{0}'", action);
+        return UnknownActionId;
+    }
+
+    auto id = static_cast<ActionId>(count + 1);
+
+    // entries live for the process lifetime, as lookups may hold them without any lock
+    slots_[slot].store(new Entry(action, hash, id), memory_order_release);
+    count_.store(count + 1, memory_order_relaxed);
+
+    WriteNoise(TraceType, "registered '{0}' as {1}", action, id);
+    return id;
+}
+
+ActionTable::ActionId ActionTable::LookupInternal(wstring const & action) const
+{
+    size_t slot;
+    auto entry = Find(action, HashAction(action), slot);
+    return entry ? entry->Id : UnknownActionId;
+}
@@ -0,0 +1,62 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Transport
+{
+    // Process wide registry that interns well known message actions into compact integer ids.
+    // Ids are assigned when handler tables are built at component startup and are local to this
+    // process, they are never sent on the wire, so no agreement is needed across nodes or code
+    // versions. Registered actions are never removed, which lets Lookup run without any lock:
+    // it probes a fixed size open addressing table whose slots are published with release stores.
+    class ActionTable : public Common::TextTraceComponent<Common::TraceTaskCodes::Transport>
+    {
+        DENY_COPY(ActionTable);
+
+    public:
+        typedef uint16 ActionId;
+        static const ActionId UnknownActionId = 0;
+
+        // Returns the id of action, registering it if needed. Returns UnknownActionId
+        // only when the table is full, callers should then fall back to action string.
+        static ActionId Register(std::wstring const & action);
+
+        // Returns UnknownActionId for actions that have not been registered
+        static ActionId Lookup(std::wstring const & action);
+
+        static size_t Count();
+
+    private:
+        struct Entry
+        {
+            Entry(std::wstring const & action, uint64 hash, ActionId id) : Action(action), Hash(hash), Id(id) {}
+
+            std::wstring const Action;
+            uint64 const Hash;
+            ActionId const Id;
+        };
+
+        // Slot count is twice the id space, so probe sequences stay short even when every id is used
+        static const size_t SlotCount = 2 * (1 << (8 * sizeof(ActionId)));
+
+        ActionTable();
+
+        static ActionTable & GetTable();
+        static BOOL CALLBACK InitFunction(PINIT_ONCE, PVOID, PVOID*);
+
+        ActionId RegisterInternal(std::wstring const & action);
+        ActionId LookupInternal(std::wstring const & action) const;
+        Entry const * Find(std::wstring const & action, uint64 hash, _Out_ size_t & slot) const;
+
+        static INIT_ONCE initOnce_;
+        static ActionTable * singleton_;
+
+        // serializes registrations only, lookups never take it
+        Common::ExclusiveLock registerLock_;
+        std::atomic<size_t> count_;
+        std::unique_ptr<std::atomic<Entry const *>[]> slots_;
+    };
+}
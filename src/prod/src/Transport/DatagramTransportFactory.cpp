@@ -53,3 +53,20 @@ IDatagramTransportSPtr DatagramTransportFactory::CreateUnreliable(
 {
     return make_shared<UnreliableTransport>(root, innerTransport);
 }
+
+IDatagramTransportSPtr DatagramTransportFactory::CreateIpcSharedMemory(
+    IDatagramTransportSPtr const & innerTransport,
+    bool isClient)
+{
+#ifdef PLATFORM_UNIX
+    auto ringSize = TransportConfig::GetConfig().IpcSharedMemoryRingSize;
+    if ((ringSize > 0) && !TransportConfig::GetConfig().InMemoryTransportEnabled)
+    {
+        return make_shared<IpcSharedMemoryTransport>(innerTransport, isClient, ringSize);
+    }
+#else
+    UNREFERENCED_PARAMETER(isClient);
+#endif
+
+    return innerTransport;
+}
@@ -27,5 +27,10 @@ namespace Transport
         static IDatagramTransportSPtr CreateUnreliable(
             Common::ComponentRoot const & root,
             IDatagramTransportSPtr const & innerTransport);
+
+        // Returns innerTransport if shared memory is disabled or not supported
+        static IDatagramTransportSPtr CreateIpcSharedMemory(
+            IDatagramTransportSPtr const & innerTransport,
+            bool isClient);
     };
 }
@@ -40,6 +40,10 @@ namespace Transport
 
         void OnAbort();
 
+        virtual void OnMessageReceived(MessageUPtr & message, ISendTarget::SPtr const & replyTargetSPtr);
+
+        void ActorDispatch(TKey const & actorKey, MessageUPtr & message, TReceiverContextUPtr &);
+
         IDatagramTransportSPtr datagramTransport_;
 
     private:
@@ -47,10 +51,6 @@ namespace Transport
 
         void Cleanup();
 
-        void OnMessageReceived(MessageUPtr & message, ISendTarget::SPtr const & replyTargetSPtr);
-
-        void ActorDispatch(TKey const & actorKey, MessageUPtr & message, TReceiverContextUPtr &);
-
         void CallMessageHandler(MessageHandlerEntry const & handlerEntry, MessageUPtr & message, TReceiverContextUPtr & context);
 
         RWLOCK(Demuxer, lock_);
@@ -0,0 +1,36 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Transport;
+using namespace Common;
+
+void FrameCompression::WriteToTextWriter(TextWriter & w, Enum const & value)
+{
+    switch (value)
+    {
+    case None: w << "None"; return;
+    case Lz4: w << "Lz4"; return;
+    default: w << "FrameCompression(" << static_cast<int>(value) << ')';
+    }
+}
+
+FrameCompressionHeader::FrameCompressionHeader()
+    : algorithm_(FrameCompression::None)
+    , uncompressedBodySize_(0)
+{
+}
+
+FrameCompressionHeader::FrameCompressionHeader(FrameCompression::Enum algorithm, uint32 uncompressedBodySize)
+    : algorithm_(algorithm)
+    , uncompressedBodySize_(uncompressedBodySize)
+{
+}
+
+void FrameCompressionHeader::WriteTo(TextWriter & w, FormatOptions const &) const
+{
+    w.Write("{0}, uncompressedBodySize={1}", algorithm_, uncompressedBodySize_);
+}
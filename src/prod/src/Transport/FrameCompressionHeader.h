@@ -0,0 +1,43 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Transport
+{
+    namespace FrameCompression
+    {
+        enum Enum
+        {
+            None = 0,
+            Lz4 = 1
+        };
+
+        void WriteToTextWriter(Common::TextWriter & w, Enum const & value);
+    }
+
+    // On ListenInstance message, advertises that the sender can decompress frames with the given algorithm.
+    // On other messages, indicates that message body is compressed, and records uncompressed body size.
+    class FrameCompressionHeader : public MessageHeader<MessageHeaderId::FrameCompression>, public Serialization::FabricSerializable
+    {
+    public:
+        FrameCompressionHeader();
+        FrameCompressionHeader(FrameCompression::Enum algorithm, uint32 uncompressedBodySize);
+
+        FrameCompression::Enum Algorithm() const { return algorithm_; }
+        uint32 UncompressedBodySize() const { return uncompressedBodySize_; }
+
+        // Empty body is never compressed, so zero size means advertisement only
+        bool IsBodyCompressed() const { return uncompressedBodySize_ > 0; }
+
+        void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const;
+
+        FABRIC_FIELDS_02(algorithm_, uncompressedBodySize_);
+
+    private:
+        FrameCompression::Enum algorithm_;
+        uint32 uncompressedBodySize_;
+    };
+}
@@ -63,7 +63,10 @@ namespace
     BOOL CALLBACK InitEventLoopPool(PINIT_ONCE, PVOID, PVOID*)
     {
         // create a dedicated EventLoopPool for isolation
-        eventLoopPool = new EventLoopPool(L"Transport");
+        eventLoopPool = new EventLoopPool(
+            L"Transport",
+            0,
+            TransportConfig::GetConfig().EventLoopIoUringEnabled ? EventLoopBackend::IoUring : EventLoopBackend::Epoll);
         return TRUE;
     }
 }
@@ -179,6 +179,7 @@ namespace Transport
             uint64 instance) = 0;
 
         friend class UnreliableTransport;
+        friend class IpcSharedMemoryTransport;
     };
 }
 
@@ -22,6 +22,7 @@ namespace
         bool useUnreliableTransport)
     {
         IDatagramTransportSPtr transport = DatagramTransportFactory::CreateTcpClient(clientId, owner + L".IpcClient");
+        transport = DatagramTransportFactory::CreateIpcSharedMemory(transport, true /* isClient */);
 
         //Support for Unreliable transport for request reply over IPC
         if (useUnreliableTransport && TransportConfig::GetConfig().UseUnreliableForRequestReply)
@@ -54,6 +54,8 @@ namespace Transport
         MessageUPtr CreateServerMessage(Actor::Enum actor);
         MessageUPtr CreateClientMessage(Actor::Enum actor);
         MessageUPtr CreateClientMessageLong(Actor::Enum actor);
+        MessageUPtr CreateMessageWithBody(Actor::Enum actor, size_t length);
+        size_t GetBodyLength(Message & message);
 
         class TestRoot : public Common::ComponentRoot
         {
@@ -388,6 +390,177 @@ namespace Transport
         LEAVE;
     }
 
+#ifdef PLATFORM_UNIX
+    BOOST_AUTO_TEST_CASE(SharedMemoryTest)
+    {
+        ENTER;
+
+        KFinally([this] { Cleanup(); });
+
+        // messages larger than half of the ring are sent over TCP behind a marker in the ring
+        auto saved = TransportConfig::GetConfig().IpcSharedMemoryRingSize;
+        TransportConfig::GetConfig().IpcSharedMemoryRingSize = 64 * 1024;
+        KFinally([=] { TransportConfig::GetConfig().IpcSharedMemoryRingSize = saved; });
+
+        size_t const messageCount = 500;
+        auto getLength = [](size_t i) { return (i % 50 == 49) ? 20000 : (i * 97) % 4096; };
+        size_t expectedTotal = 0;
+        for (size_t i = 0; i < messageCount; ++i)
+        {
+            expectedTotal += getLength(i);
+        }
+
+        auto& server = root_->server_;
+        auto& client = root_->client_;
+
+        std::wstring serverListenAddress = TTestUtil::GetListenAddress();
+        server = OpenServer(serverListenAddress, false);
+
+        Common::atomic_uint64 serverReceived(0);
+        Common::atomic_uint64 serverReceivedLength(0);
+        ManualResetEvent serverReceivedAll(false);
+        server->RegisterMessageHandler(
+            serverSideActor_,
+            [&](MessageUPtr & message, IpcReceiverContextUPtr & context)
+            {
+                VERIFY_ARE_EQUAL2(context->From, L"client");
+                auto length = GetBodyLength(*message);
+                VERIFY_ARE_EQUAL2(getLength(serverReceived.load()), length);
+                serverReceivedLength += length;
+                if (++serverReceived == messageCount)
+                {
+                    serverReceivedAll.Set();
+                }
+            },
+            true/*dispatchOnTransportThread*/);
+
+        client = OpenClient(L"client", serverListenAddress, false);
+
+        Common::atomic_uint64 clientReceived(0);
+        Common::atomic_uint64 clientReceivedLength(0);
+        ManualResetEvent clientReceivedAll(false);
+        client->RegisterMessageHandler(
+            clientSideActor_,
+            [&](MessageUPtr & message, IpcReceiverContextUPtr & context)
+            {
+                VERIFY_IS_TRUE(context->From.empty());
+                auto length = GetBodyLength(*message);
+                VERIFY_ARE_EQUAL2(getLength(clientReceived.load()), length);
+                clientReceivedLength += length;
+                if (++clientReceived == messageCount)
+                {
+                    clientReceivedAll.Set();
+                }
+            },
+            true/*dispatchOnTransportThread*/);
+
+        auto sendStarted = IpcSharedMemoryChannel::Test_SendStartedCount();
+        auto ringReceived = IpcSharedMemoryChannel::Test_RingReceivedCount();
+        auto divertedReceived = IpcSharedMemoryChannel::Test_DivertedReceivedCount();
+
+        // first message goes over TCP after the offer, the rest through the ring once both sides have switched to it
+        VERIFY_IS_TRUE(client->SendOneWay(CreateMessageWithBody(serverSideActor_, getLength(0))).IsSuccess());
+        for (int i = 0; (i < 100) && (IpcSharedMemoryChannel::Test_SendStartedCount() < sendStarted + 2); ++i)
+        {
+            Sleep(100);
+        }
+
+        VERIFY_ARE_EQUAL2(sendStarted + 2, IpcSharedMemoryChannel::Test_SendStartedCount());
+
+        for (size_t i = 1; i < messageCount; ++i)
+        {
+            VERIFY_IS_TRUE(client->SendOneWay(CreateMessageWithBody(serverSideActor_, getLength(i))).IsSuccess());
+        }
+
+        VERIFY_IS_TRUE(serverReceivedAll.WaitOne(TimeSpan::FromSeconds(30)));
+        VERIFY_ARE_EQUAL2(expectedTotal, serverReceivedLength.load());
+
+        for (size_t i = 0; i < messageCount; ++i)
+        {
+            VERIFY_IS_TRUE(server->SendOneWay(L"client", CreateMessageWithBody(clientSideActor_, getLength(i))).IsSuccess());
+        }
+
+        VERIFY_IS_TRUE(clientReceivedAll.WaitOne(TimeSpan::FromSeconds(30)));
+        VERIFY_ARE_EQUAL2(expectedTotal, clientReceivedLength.load());
+
+        // every 50th message is too large for the ring, 10 from each side
+        VERIFY_ARE_EQUAL2(divertedReceived + 20, IpcSharedMemoryChannel::Test_DivertedReceivedCount());
+        VERIFY_ARE_EQUAL2(ringReceived + (messageCount - 1 - 10) + (messageCount - 10), IpcSharedMemoryChannel::Test_RingReceivedCount());
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(SharedMemoryStopTest)
+    {
+        ENTER;
+
+        KFinally([this] { Cleanup(); });
+
+        auto saved = TransportConfig::GetConfig().IpcSharedMemoryRingSize;
+        TransportConfig::GetConfig().IpcSharedMemoryRingSize = 64 * 1024;
+        KFinally([=] { TransportConfig::GetConfig().IpcSharedMemoryRingSize = saved; });
+
+        auto& server = root_->server_;
+        auto& client = root_->client_;
+
+        std::wstring serverListenAddress = TTestUtil::GetListenAddress();
+        server = OpenServer(serverListenAddress, false);
+
+        // server is closed while its channel thread is dispatching a backlog of slow messages
+        Common::atomic_uint64 serverReceived(0);
+        Common::atomic_uint64 receivedAfterClose(0);
+        Common::atomic_bool serverClosed(false);
+        ManualResetEvent backlogStarted(false);
+        server->RegisterMessageHandler(
+            serverSideActor_,
+            [&](MessageUPtr &, IpcReceiverContextUPtr &)
+            {
+                if (serverClosed.load())
+                {
+                    ++receivedAfterClose;
+                }
+
+                if (++serverReceived == 10)
+                {
+                    backlogStarted.Set();
+                }
+
+                Sleep(20);
+            },
+            true/*dispatchOnTransportThread*/);
+
+        client = OpenClient(L"client", serverListenAddress, false);
+
+        auto sendStarted = IpcSharedMemoryChannel::Test_SendStartedCount();
+        VERIFY_IS_TRUE(client->SendOneWay(CreateMessageWithBody(serverSideActor_, 16)).IsSuccess());
+        for (int i = 0; (i < 100) && (IpcSharedMemoryChannel::Test_SendStartedCount() < sendStarted + 2); ++i)
+        {
+            Sleep(100);
+        }
+
+        VERIFY_ARE_EQUAL2(sendStarted + 2, IpcSharedMemoryChannel::Test_SendStartedCount());
+
+        size_t const messageCount = 500;
+        for (size_t i = 1; i < messageCount; ++i)
+        {
+            VERIFY_IS_TRUE(client->SendOneWay(CreateMessageWithBody(serverSideActor_, 16)).IsSuccess());
+        }
+
+        VERIFY_IS_TRUE(backlogStarted.WaitOne(TimeSpan::FromSeconds(30)));
+
+        // channel thread is joined by transport stop, the handler is not called after close returns
+        CloseServer(server);
+        serverClosed.store(true);
+        server.reset();
+
+        Sleep(1000);
+        VERIFY_IS_TRUE(receivedAfterClose.load() == 0);
+        VERIFY_IS_TRUE(serverReceived.load() < messageCount);
+
+        LEAVE;
+    }
+#endif
+
     BOOST_AUTO_TEST_SUITE_END()
 
     bool IpcTestBase::Setup()
@@ -854,4 +1027,22 @@ namespace Transport
 
         return message;
     }
+
+    MessageUPtr IpcTestBase::CreateMessageWithBody(Actor::Enum actor, size_t length)
+    {
+        IpcTestMessage body(std::wstring(length, L'x'));
+        MessageUPtr message = make_unique<Message>(body);
+
+        message->Headers.Add(MessageIdHeader());
+        message->Headers.Add(ActorHeader(actor));
+
+        return message;
+    }
+
+    size_t IpcTestBase::GetBodyLength(Message & message)
+    {
+        IpcTestMessage body;
+        VERIFY_IS_TRUE(message.GetBody(body));
+        return body.message_.size();
+    }
 }
@@ -27,6 +27,7 @@ namespace
         }
 
         auto transport = DatagramTransportFactory::CreateTcp(transportListenAddress, serverId, owner + L".IpcServer");
+        transport = DatagramTransportFactory::CreateIpcSharedMemory(transport, false /* isClient */);
 
         //Support for Unreliable transport for request reply over IPC
         if (useUnreliableTransport && TransportConfig::GetConfig().UseUnreliableForRequestReply)
@@ -0,0 +1,905 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+using namespace Transport;
+using namespace Common;
+using namespace std;
+
+namespace
+{
+    const StringLiteral TraceType("SharedMemory");
+
+    const uint32 SegmentMagic = 0x52435049; // "IPCR"
+    const uint32 SegmentVersion = 1;
+    const uint MinRingSize = 4 * 1024;
+    const uint MaxRingSize = 64 * 1024 * 1024;
+    const wstring SegmentNamePrefix = L"/ServiceFabric.Ipc.";
+
+    struct RecordHeader
+    {
+        uint32 HeaderSize;
+        uint32 BodySize;
+    };
+
+    // HeaderSize of a marker record, which stands in for a message sent over TCP
+    const uint32 MarkerHeaderSize = 0xFFFFFFFF;
+    const uint64 MarkerRecordSize = sizeof(RecordHeader);
+
+    // records are 8 byte aligned in the ring
+    uint64 GetRecordSize(uint64 headerSize, uint64 bodySize)
+    {
+        return (sizeof(RecordHeader) + headerSize + bodySize + 7) & ~7ull;
+    }
+
+    uint RoundUpRingSize(uint ringSize)
+    {
+        uint rounded = MinRingSize;
+        while ((rounded < ringSize) && (rounded < MaxRingSize))
+        {
+            rounded <<= 1;
+        }
+
+        return rounded;
+    }
+
+    void CopyToRing(byte* ring, uint ringSize, uint64 position, void const* source, size_t size)
+    {
+        auto offset = position & (ringSize - 1);
+        auto first = min<size_t>(size, ringSize - offset);
+        memcpy(ring + offset, source, first);
+        memcpy(ring, static_cast<byte const*>(source) + first, size - first);
+    }
+
+    void CopyFromRing(byte const* ring, uint ringSize, uint64 position, void* destination, size_t size)
+    {
+        auto offset = position & (ringSize - 1);
+        auto first = min<size_t>(size, ringSize - offset);
+        memcpy(destination, ring + offset, first);
+        memcpy(static_cast<byte*>(destination) + first, ring, size - first);
+    }
+
+    StopwatchTime ToDeadline(TimeSpan expiration)
+    {
+        return (expiration == TimeSpan::MaxValue) ? StopwatchTime::MaxValue : (Stopwatch::Now() + expiration);
+    }
+
+    ByteBique CopyFromRingToBique(byte const* ring, uint ringSize, uint64 position, size_t size)
+    {
+        if (size == 0)
+        {
+            return ByteBique();
+        }
+
+        // single chunk holding all the bytes
+        ByteBique bytes(size);
+        bytes.reserve_back(size);
+        auto output = bytes.end();
+        Invariant(output.fragment_size() >= size);
+
+        CopyFromRing(ring, ringSize, position, &(*output), size);
+        bytes.no_fill_advance_back(size);
+        return bytes;
+    }
+}
+
+// Futex words are shared between processes, so FUTEX_PRIVATE_FLAG must not be used
+struct IpcSharedMemoryChannel::Doorbell
+{
+    alignas(64) atomic<uint32> Sequence;
+    atomic<uint32> Waiting;
+
+    void Wait(uint32 sequence, TimeSpan timeout)
+    {
+        timespec ts = { static_cast<time_t>(timeout.Ticks / TimeSpan::TicksPerSecond), static_cast<long>((timeout.Ticks % TimeSpan::TicksPerSecond) * 100) };
+        syscall(SYS_futex, reinterpret_cast<uint32*>(&Sequence), FUTEX_WAIT, sequence, &ts, nullptr, 0);
+    }
+
+    void Wake()
+    {
+        ++Sequence;
+        syscall(SYS_futex, reinterpret_cast<uint32*>(&Sequence), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+
+    void WakeIfWaiting()
+    {
+        if (Waiting.load())
+        {
+            Wake();
+        }
+    }
+};
+
+// Head and Tail are byte positions that only increase, Head is advanced by producer after a whole record is written
+struct IpcSharedMemoryChannel::Ring
+{
+    alignas(64) atomic<uint64> Head;
+    alignas(64) atomic<uint64> Tail;
+};
+
+// Ring data follows the segment header, client to server ring first
+struct IpcSharedMemoryChannel::Segment
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 RingSize;
+    atomic<uint32> ServerAttached;
+    atomic<uint32> Closed;
+    Doorbell Doorbells[2]; // indexed by the side waiting on it
+    Ring Rings[2]; // indexed by producing side
+};
+
+static_assert(sizeof(atomic<uint32>) == sizeof(uint32), "futex word must be a plain 32 bit integer");
+
+_Use_decl_annotations_
+ErrorCode IpcSharedMemoryChannel::Create(
+    wstring const & traceId,
+    uint ringSize,
+    ISendTarget::SPtr const & target,
+    MessageHandler const & handler,
+    TcpSender const & tcpSender,
+    shared_ptr<IpcSharedMemoryChannel> & channel)
+{
+    ringSize = RoundUpRingSize(ringSize);
+    auto segmentName = wformatString("{0}{1}.{2}", SegmentNamePrefix, ::GetCurrentProcessId(), Guid::NewGuid());
+    auto segmentNameA = StringUtility::Utf16ToUtf8(segmentName);
+
+    auto fd = shm_open(segmentNameA.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        auto error = ErrorCode::FromErrno();
+        WriteInfo(TraceType, traceId, "shm_open({0}) failed: {1}", segmentName, error);
+        return error;
+    }
+
+    auto segmentSize = GetSegmentSize(ringSize);
+    void* mapping = MAP_FAILED;
+    if (ftruncate(fd, segmentSize) == 0)
+    {
+        mapping = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    auto error = (mapping == MAP_FAILED) ? ErrorCode::FromErrno() : ErrorCode::Success();
+    close(fd);
+
+    if (!error.IsSuccess())
+    {
+        WriteWarning(TraceType, traceId, "failed to map {0} of size {1}: {2}", segmentName, segmentSize, error);
+        shm_unlink(segmentNameA.c_str());
+        return error;
+    }
+
+    // ftruncate zero fills the segment
+    auto segment = static_cast<Segment*>(mapping);
+    segment->Magic = SegmentMagic;
+    segment->Version = SegmentVersion;
+    segment->RingSize = ringSize;
+
+    channel = shared_ptr<IpcSharedMemoryChannel>(new IpcSharedMemoryChannel(traceId, ClientSide, segmentName, ringSize, segment, target, handler, tcpSender));
+    return error;
+}
+
+_Use_decl_annotations_
+ErrorCode IpcSharedMemoryChannel::Attach(
+    wstring const & traceId,
+    IpcSharedMemoryHeader const & header,
+    ISendTarget::SPtr const & target,
+    MessageHandler const & handler,
+    TcpSender const & tcpSender,
+    shared_ptr<IpcSharedMemoryChannel> & channel)
+{
+    auto ringSize = header.RingSize();
+    auto const & segmentName = header.SegmentName();
+    if ((ringSize < MinRingSize) || (ringSize > MaxRingSize) || ((ringSize & (ringSize - 1)) != 0) ||
+        !StringUtility::StartsWith(segmentName, SegmentNamePrefix) ||
+        (segmentName.find(L'/', SegmentNamePrefix.size()) != wstring::npos))
+    {
+        WriteWarning(TraceType, traceId, "rejecting invalid {0}", header);
+        return ErrorCodeValue::InvalidArgument;
+    }
+
+    auto segmentNameA = StringUtility::Utf16ToUtf8(segmentName);
+    auto fd = shm_open(segmentNameA.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        // e.g. client is in a container with its own /dev/shm, or runs as a different user
+        auto error = ErrorCode::FromErrno();
+        WriteInfo(TraceType, traceId, "shm_open({0}) failed: {1}", segmentName, error);
+        return error;
+    }
+
+    // nobody else needs to open it, unlinking also avoids leaking it when both processes exit
+    shm_unlink(segmentNameA.c_str());
+
+    auto segmentSize = GetSegmentSize(ringSize);
+    struct stat st = {};
+    void* mapping = MAP_FAILED;
+    if ((fstat(fd, &st) == 0) && (static_cast<size_t>(st.st_size) == segmentSize))
+    {
+        mapping = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        WriteWarning(TraceType, traceId, "failed to map {0}: size = {1}, expected = {2}", segmentName, st.st_size, segmentSize);
+        return ErrorCodeValue::InvalidArgument;
+    }
+
+    auto segment = static_cast<Segment*>(mapping);
+    if ((segment->Magic != SegmentMagic) || (segment->Version != SegmentVersion) || (segment->RingSize != ringSize) ||
+        segment->ServerAttached.exchange(1) != 0)
+    {
+        WriteWarning(TraceType, traceId, "rejecting segment {0}: magic = {1:x}, version = {2}", segmentName, segment->Magic, segment->Version);
+        munmap(mapping, segmentSize);
+        return ErrorCodeValue::InvalidArgument;
+    }
+
+    // client side thread sends its start notice once it sees the attach
+    segment->Doorbells[ClientSide].Wake();
+
+    channel = shared_ptr<IpcSharedMemoryChannel>(new IpcSharedMemoryChannel(traceId, ServerSide, segmentName, ringSize, segment, target, handler, tcpSender));
+    return ErrorCodeValue::Success;
+}
+
+IpcSharedMemoryChannel::IpcSharedMemoryChannel(
+    wstring const & traceId,
+    Side side,
+    wstring const & segmentName,
+    uint ringSize,
+    Segment* segment,
+    ISendTarget::SPtr const & target,
+    MessageHandler const & handler,
+    TcpSender const & tcpSender)
+    : traceId_(traceId)
+    , side_(side)
+    , segmentName_(segmentName)
+    , ringSize_(ringSize)
+    , segment_(segment)
+    , target_(target)
+    , handler_(handler)
+    , tcpSender_(tcpSender)
+    , createTime_(Stopwatch::Now())
+{
+    WriteInfo(TraceType, traceId_, "{0}: created on {1} side, ring size = {2}", segmentName_, (side_ == ClientSide) ? "client" : "server", ringSize_);
+}
+
+IpcSharedMemoryChannel::~IpcSharedMemoryChannel()
+{
+    // last reference may be released on the channel thread itself, or after Join timed out
+    if (threadStarted_ && !threadJoined_)
+    {
+        pthread_detach(thread_);
+    }
+
+    munmap(segment_, GetSegmentSize(ringSize_));
+    WriteInfo(TraceType, traceId_, "{0}: destructed", segmentName_);
+}
+
+size_t IpcSharedMemoryChannel::GetSegmentSize(uint ringSize)
+{
+    static_assert((sizeof(Segment) % 64) == 0, "ring data must be cache line aligned");
+    return sizeof(Segment) + 2 * static_cast<size_t>(ringSize);
+}
+
+IpcSharedMemoryChannel::Ring & IpcSharedMemoryChannel::RingOf(Side producer) const
+{
+    return segment_->Rings[producer];
+}
+
+byte* IpcSharedMemoryChannel::RingDataOf(Side producer) const
+{
+    return reinterpret_cast<byte*>(segment_ + 1) + (producer * static_cast<size_t>(ringSize_));
+}
+
+atomic_uint64 IpcSharedMemoryChannel::sendStartedCount_(0);
+atomic_uint64 IpcSharedMemoryChannel::ringReceivedCount_(0);
+atomic_uint64 IpcSharedMemoryChannel::divertedReceivedCount_(0);
+
+bool IpcSharedMemoryChannel::IsReady() const
+{
+    return segment_->ServerAttached.load() && !segment_->Closed.load();
+}
+
+bool IpcSharedMemoryChannel::IsClosed() const
+{
+    return segment_->Closed.load() != 0;
+}
+
+ErrorCode IpcSharedMemoryChannel::Send(MessageUPtr & message, TimeSpan expiration)
+{
+    AcquireReadLock path(pathLock_);
+
+    if (IsClosed())
+    {
+        return ErrorCodeValue::ObjectClosed;
+    }
+
+    if (!sendStarted_)
+    {
+        // peer only drains the ring after the start notice, which will follow this message over TCP
+        return tcpSender_(move(message), expiration);
+    }
+
+    auto recordSize = GetRecordSize(message->SerializedHeaderSize(), message->SerializedBodySize());
+    bool written = false;
+    {
+        AcquireWriteLock grab(sendLock_);
+
+        // checked under sendLock_, pending sends are taken over by channel thread after it sees the channel closed
+        if (IsClosed())
+        {
+            return ErrorCodeValue::ObjectClosed;
+        }
+
+        if (recordSize > MaxMessageSize())
+        {
+            return SendDiverted_LockHeld(message);
+        }
+
+        if (pendingSends_.empty() && TryWrite_LockHeld(*message))
+        {
+            written = true;
+        }
+        else if ((pendingBytes_ + recordSize) > PendingSendLimit())
+        {
+            WriteInfo(
+                TraceType, traceId_,
+                "{0}: pending send limit reached: pending = {1} bytes, message {2} = {3} bytes",
+                segmentName_, pendingBytes_, message->TraceId(), recordSize);
+
+            message->OnSendStatus(ErrorCodeValue::TransportSendQueueFull, move(message));
+            return ErrorCodeValue::TransportSendQueueFull;
+        }
+        else
+        {
+            pendingBytes_ += recordSize;
+            pendingSends_.push_back(PendingSend{ move(message), ToDeadline(expiration), recordSize });
+        }
+    }
+
+    if (written)
+    {
+        Release(move(message));
+    }
+    else
+    {
+        // local thread flushes pending sends when peer frees up space
+        segment_->Doorbells[side_].Wake();
+    }
+
+    return ErrorCode();
+}
+
+ErrorCode IpcSharedMemoryChannel::SendDiverted_LockHeld(MessageUPtr & message)
+{
+    // Peer waits at the marker until the message arrives, so it is sent without expiration. The marker
+    // is only written after TCP transport accepted the message, a later TCP failure faults the connection
+    // and that closes the channel.
+    message->Headers.Add(IpcSharedMemoryHeader(segmentName_, 0));
+    auto error = tcpSender_(move(message), TimeSpan::MaxValue);
+    if (!error.IsSuccess())
+    {
+        return error;
+    }
+
+    if (pendingSends_.empty() && TryWriteMarker_LockHeld())
+    {
+        return error;
+    }
+
+    // markers are not counted against pending send limit, the message is already queued on TCP
+    pendingSends_.push_back(PendingSend{ nullptr, StopwatchTime::MaxValue, 0 });
+    segment_->Doorbells[side_].Wake();
+    return error;
+}
+
+bool IpcSharedMemoryChannel::TryWrite_LockHeld(Message & message)
+{
+    auto headerSize = message.SerializedHeaderSize();
+    auto bodySize = message.SerializedBodySize();
+    return TryWriteRecord_LockHeld(GetRecordSize(headerSize, bodySize), headerSize, bodySize, &message);
+}
+
+bool IpcSharedMemoryChannel::TryWriteMarker_LockHeld()
+{
+    return TryWriteRecord_LockHeld(MarkerRecordSize, MarkerHeaderSize, 0, nullptr);
+}
+
+bool IpcSharedMemoryChannel::TryWriteRecord_LockHeld(uint64 recordSize, uint32 headerSize, uint32 bodySize, Message * message)
+{
+    auto & ring = RingOf(side_);
+    auto data = RingDataOf(side_);
+    auto head = ring.Head.load(memory_order_relaxed);
+    if ((ringSize_ - (head - ring.Tail.load(memory_order_acquire))) < recordSize)
+    {
+        return false;
+    }
+
+    RecordHeader recordHeader = { headerSize, bodySize };
+    CopyToRing(data, ringSize_, head, &recordHeader, sizeof(recordHeader));
+
+    if (message)
+    {
+        auto position = head + sizeof(recordHeader);
+        for (BiqueChunkIterator chunk = message->BeginHeaderChunks(); chunk != message->EndHeaderChunks(); ++chunk)
+        {
+            CopyToRing(data, ringSize_, position, chunk->cbegin(), chunk->size());
+            position += chunk->size();
+        }
+
+        for (BufferIterator chunk = message->BeginBodyChunks(); chunk != message->EndBodyChunks(); ++chunk)
+        {
+            CopyToRing(data, ringSize_, position, chunk->cbegin(), chunk->size());
+            position += chunk->size();
+        }
+    }
+
+    ring.Head.store(head + recordSize);
+    segment_->Doorbells[PeerSide()].WakeIfWaiting();
+    return true;
+}
+
+void IpcSharedMemoryChannel::Release(MessageUPtr && message)
+{
+    if (message->HasSendStatusCallback())
+    {
+        auto msg = move(message);
+        msg->OnSendStatus(ErrorCodeValue::Success, move(msg));
+    }
+    else
+    {
+        message.reset();
+    }
+}
+
+void IpcSharedMemoryChannel::OnPeerStarted()
+{
+    WriteInfo(TraceType, traceId_, "{0}: peer started sending through the ring", segmentName_);
+    peerStarted_.store(true);
+    segment_->Doorbells[side_].Wake();
+}
+
+bool IpcSharedMemoryChannel::OnDivertedMessage(MessageUPtr & message)
+{
+    {
+        AcquireWriteLock grab(divertedLock_);
+
+        if (divertedClosed_ || IsClosed())
+        {
+            return false;
+        }
+
+        divertedMessages_.push_back(move(message));
+    }
+
+    // channel thread dispatches it when it reaches the marker
+    segment_->Doorbells[side_].Wake();
+    return true;
+}
+
+void IpcSharedMemoryChannel::Close()
+{
+    if (segment_->Closed.exchange(1) == 0)
+    {
+        WriteInfo(TraceType, traceId_, "{0}: closing", segmentName_);
+    }
+
+    if (side_ == ClientSide)
+    {
+        // segment is already unlinked if server side has attached
+        shm_unlink(StringUtility::Utf16ToUtf8(segmentName_).c_str());
+    }
+
+    segment_->Doorbells[ClientSide].Wake();
+    segment_->Doorbells[ServerSide].Wake();
+}
+
+void IpcSharedMemoryChannel::Fail(string const & reason)
+{
+    WriteError(TraceType, traceId_, "{0}: {1}, closing channel", segmentName_, reason);
+    Close();
+}
+
+void IpcSharedMemoryChannel::Start()
+{
+    AcquireExclusiveLock grab(threadLock_);
+
+    if (IsClosed() || threadStarted_)
+    {
+        return;
+    }
+
+    auto self = new shared_ptr<IpcSharedMemoryChannel>(shared_from_this());
+    auto error = pthread_create(&thread_, nullptr, &ThreadFunc, self);
+    if (error != 0)
+    {
+        delete self;
+        Fail(formatString("failed to create channel thread: {0}", error));
+        return;
+    }
+
+    threadStarted_ = true;
+}
+
+bool IpcSharedMemoryChannel::Join(TimeSpan timeout)
+{
+    {
+        AcquireExclusiveLock grab(threadLock_);
+
+        if (!threadStarted_ || threadJoined_)
+        {
+            return true;
+        }
+    }
+
+    if (pthread_equal(thread_, pthread_self()))
+    {
+        // e.g. message handler stopping the transport, the thread exits after the handler returns
+        return false;
+    }
+
+    int error;
+    if (timeout == TimeSpan::MaxValue)
+    {
+        error = pthread_join(thread_, nullptr);
+    }
+    else
+    {
+        auto deadline = ToAbsoluteTime(timeout);
+        error = pthread_timedjoin_np(thread_, nullptr, &deadline);
+    }
+
+    if (error == ETIMEDOUT)
+    {
+        WriteWarning(TraceType, traceId_, "{0}: channel thread did not stop within {1}", segmentName_, timeout);
+        return false;
+    }
+
+    Invariant(error == 0);
+    threadJoined_ = true;
+    return true;
+}
+
+timespec IpcSharedMemoryChannel::ToAbsoluteTime(TimeSpan timeout)
+{
+    // pthread_timedjoin_np only takes CLOCK_REALTIME deadlines
+    timespec ts;
+    ZeroRetValAssert(clock_gettime(CLOCK_REALTIME, &ts));
+
+    ts.tv_sec += static_cast<time_t>(timeout.Ticks / TimeSpan::TicksPerSecond);
+    ts.tv_nsec += static_cast<long>((timeout.Ticks % TimeSpan::TicksPerSecond) * 100);
+    if (ts.tv_nsec >= 1000000000)
+    {
+        ++ts.tv_sec;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    return ts;
+}
+
+void* IpcSharedMemoryChannel::ThreadFunc(void* arg)
+{
+    unique_ptr<shared_ptr<IpcSharedMemoryChannel>> self(static_cast<shared_ptr<IpcSharedMemoryChannel>*>(arg));
+    (*self)->Run();
+    return nullptr;
+}
+
+void IpcSharedMemoryChannel::StartSending()
+{
+    // Exclusive, so that no sender is between choosing TCP and queueing its message there
+    AcquireWriteLock path(pathLock_);
+
+    if (IsClosed())
+    {
+        return;
+    }
+
+    auto notice = make_unique<Message>();
+    notice->Headers.Add(ActorHeader(Actor::Ipc));
+    notice->Headers.Add(MessageIdHeader());
+    notice->Headers.Add(IpcSharedMemoryHeader(segmentName_, ringSize_));
+
+    auto error = tcpSender_(move(notice), TimeSpan::MaxValue);
+    if (!error.IsSuccess())
+    {
+        Fail(formatString("failed to send start notice: {0}", error));
+        return;
+    }
+
+    WriteInfo(TraceType, traceId_, "{0}: started sending through the ring", segmentName_);
+    sendStarted_ = true;
+    ++sendStartedCount_;
+}
+
+void IpcSharedMemoryChannel::Run()
+{
+    auto attachTimeout = TransportConfig::GetConfig().ConnectionOpenTimeout;
+    while (!IsClosed())
+    {
+        if ((side_ == ClientSide) && !segment_->ServerAttached.load() && ((Stopwatch::Now() - createTime_) > attachTimeout))
+        {
+            WriteInfo(TraceType, traceId_, "{0}: server side did not attach within {1}", segmentName_, attachTimeout);
+            Close();
+            break;
+        }
+
+        // only this thread sets sendStarted_
+        if (!sendStarted_ && segment_->ServerAttached.load())
+        {
+            StartSending();
+        }
+
+        auto received = ReceiveMessages();
+        auto flushed = FlushPendingSends();
+        if (!received && !flushed)
+        {
+            WaitForWork();
+        }
+    }
+
+    deque<PendingSend> pendingSends;
+    {
+        AcquireWriteLock grab(sendLock_);
+        pendingSends.swap(pendingSends_);
+        pendingBytes_ = 0;
+    }
+
+    FallBackToTcp(move(pendingSends));
+
+    // Messages that arrived behind markers are dropped, handler is not called after close. Same as messages
+    // still in the ring, they are lost like messages in flight across a reconnect.
+    deque<MessageUPtr> diverted;
+    {
+        AcquireWriteLock grab(divertedLock_);
+        divertedClosed_ = true;
+        diverted.swap(divertedMessages_);
+    }
+
+    WriteInfo(TraceType, traceId_, "{0}: stopped, dropped {1} diverted messages", segmentName_, diverted.size());
+}
+
+void IpcSharedMemoryChannel::FallBackToTcp(deque<PendingSend> && pendingSends)
+{
+    // Order with messages sent over TCP after the channel closed is not preserved, same as across a reconnect
+    size_t count = 0;
+    auto now = Stopwatch::Now();
+    for (auto & pending : pendingSends)
+    {
+        if (!pending.Message)
+        {
+            continue;
+        }
+
+        if (pending.Expiration <= now)
+        {
+            pending.Message->OnSendStatus(ErrorCodeValue::MessageExpired, move(pending.Message));
+            continue;
+        }
+
+        auto expiration = (pending.Expiration == StopwatchTime::MaxValue) ? TimeSpan::MaxValue : (pending.Expiration - now);
+        tcpSender_(move(pending.Message), expiration);
+        ++count;
+    }
+
+    WriteInfo(TraceType, traceId_, "{0}: {1} pending sends moved to TCP", segmentName_, count);
+}
+
+bool IpcSharedMemoryChannel::ReceiveMessages()
+{
+    if (!peerStarted_.load())
+    {
+        return false;
+    }
+
+    auto producer = PeerSide();
+    auto & ring = RingOf(producer);
+    auto data = RingDataOf(producer);
+
+    // everything read from the segment is validated, peer process is not trusted to keep it consistent
+    bool received = false;
+    while (!IsClosed())
+    {
+        auto tail = ring.Tail.load(memory_order_relaxed);
+        auto available = ring.Head.load(memory_order_acquire) - tail;
+        if (available == 0)
+        {
+            break;
+        }
+
+        if ((available < sizeof(RecordHeader)) || (available > ringSize_))
+        {
+            Fail(formatString("invalid ring state: available = {0}", available));
+            break;
+        }
+
+        RecordHeader recordHeader;
+        CopyFromRing(data, ringSize_, tail, &recordHeader, sizeof(recordHeader));
+
+        if (recordHeader.HeaderSize == MarkerHeaderSize)
+        {
+            if (recordHeader.BodySize != 0)
+            {
+                Fail(formatString("invalid marker: body size = {0}", recordHeader.BodySize));
+                break;
+            }
+
+            MessageUPtr diverted;
+            {
+                AcquireWriteLock grab(divertedLock_);
+                if (!divertedMessages_.empty())
+                {
+                    diverted = move(divertedMessages_.front());
+                    divertedMessages_.pop_front();
+                }
+            }
+
+            // the message is still on its way over TCP, messages after the marker wait for it
+            blockedAtMarker_ = !diverted;
+            if (blockedAtMarker_)
+            {
+                break;
+            }
+
+            ring.Tail.store(tail + MarkerRecordSize);
+            segment_->Doorbells[producer].WakeIfWaiting();
+
+            ++divertedReceivedCount_;
+            handler_(diverted, target_);
+            received = true;
+            continue;
+        }
+
+        auto recordSize = GetRecordSize(recordHeader.HeaderSize, recordHeader.BodySize);
+        if ((recordSize > MaxMessageSize()) || (recordSize > available))
+        {
+            Fail(formatString("invalid record: header size = {0}, body size = {1}, available = {2}", recordHeader.HeaderSize, recordHeader.BodySize, available));
+            break;
+        }
+
+        auto headers = CopyFromRingToBique(data, ringSize_, tail + sizeof(recordHeader), recordHeader.HeaderSize);
+        auto body = CopyFromRingToBique(data, ringSize_, tail + sizeof(recordHeader) + recordHeader.HeaderSize, recordHeader.BodySize);
+
+        ring.Tail.store(tail + recordSize);
+        segment_->Doorbells[producer].WakeIfWaiting();
+
+        auto message = make_unique<Message>(ByteBiqueRange(move(headers)), ByteBiqueRange(move(body)), Stopwatch::Now());
+        if (!message->IsValid)
+        {
+            Fail(formatString("received invalid message: {0:x}", message->Status));
+            break;
+        }
+
+        ++ringReceivedCount_;
+        handler_(message, target_);
+        received = true;
+    }
+
+    return received;
+}
+
+bool IpcSharedMemoryChannel::FlushPendingSends()
+{
+    bool progress = false;
+    vector<MessageUPtr> written;
+    vector<MessageUPtr> expired;
+    {
+        AcquireWriteLock grab(sendLock_);
+
+        auto now = Stopwatch::Now();
+        for (auto iter = pendingSends_.begin(); iter != pendingSends_.end();)
+        {
+            if (iter->Message && (iter->Expiration <= now))
+            {
+                pendingBytes_ -= iter->Bytes;
+                expired.emplace_back(move(iter->Message));
+                iter = pendingSends_.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+
+        while (!pendingSends_.empty())
+        {
+            auto & front = pendingSends_.front();
+            if (!(front.Message ? TryWrite_LockHeld(*front.Message) : TryWriteMarker_LockHeld()))
+            {
+                break;
+            }
+
+            pendingBytes_ -= front.Bytes;
+            if (front.Message)
+            {
+                written.emplace_back(move(front.Message));
+            }
+
+            pendingSends_.pop_front();
+            progress = true;
+        }
+    }
+
+    for (auto & message : expired)
+    {
+        WriteInfo(TraceType, traceId_, "{0}: pending send {1} expired", segmentName_, message->TraceId());
+        message->OnSendStatus(ErrorCodeValue::MessageExpired, move(message));
+    }
+
+    for (auto & message : written)
+    {
+        Release(move(message));
+    }
+
+    return progress;
+}
+
+bool IpcSharedMemoryChannel::HasWork()
+{
+    if (IsClosed())
+    {
+        return true;
+    }
+
+    if (!sendStarted_ && segment_->ServerAttached.load())
+    {
+        return true;
+    }
+
+    if (peerStarted_.load())
+    {
+        if (blockedAtMarker_)
+        {
+            AcquireReadLock grab(divertedLock_);
+            if (!divertedMessages_.empty())
+            {
+                return true;
+            }
+        }
+        else
+        {
+            auto & incoming = RingOf(PeerSide());
+            if (incoming.Head.load() != incoming.Tail.load(memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+    }
+
+    AcquireWriteLock grab(sendLock_);
+
+    if (pendingSends_.empty())
+    {
+        return false;
+    }
+
+    auto & outgoing = RingOf(side_);
+    auto & front = pendingSends_.front();
+    auto recordSize = front.Message ?
+        GetRecordSize(front.Message->SerializedHeaderSize(), front.Message->SerializedBodySize()) :
+        MarkerRecordSize;
+    return (ringSize_ - (outgoing.Head.load(memory_order_relaxed) - outgoing.Tail.load())) >= recordSize;
+}
+
+void IpcSharedMemoryChannel::WaitForWork()
+{
+    auto & doorbell = segment_->Doorbells[side_];
+    auto sequence = doorbell.Sequence.load();
+
+    // peer checks Waiting after publishing to a ring, so either peer rings or HasWork sees what peer published
+    doorbell.Waiting.store(1);
+    if (!HasWork())
+    {
+        doorbell.Wait(sequence, TimeSpan::FromSeconds(1));
+    }
+
+    doorbell.Waiting.store(0);
+}
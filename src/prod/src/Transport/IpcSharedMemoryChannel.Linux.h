@@ -0,0 +1,169 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Transport
+{
+    // Message channel between IpcClient and IpcServer processes on the same machine, over a POSIX shared memory
+    // segment created by client side. The segment holds a single producer single consumer byte ring for each
+    // direction, messages are copied into the ring as [header size][body size][headers][body] records. Each side
+    // has a futex doorbell in the segment, rung by the peer after producing into an empty-waiting ring or freeing
+    // space the side is waiting for. A dedicated thread per side drains the incoming ring, dispatches messages and
+    // flushes sends that did not fit into the outgoing ring. The TCP connection the channel was negotiated on stays
+    // open, its disconnect closes the channel.
+    //
+    // Messages to the peer are dispatched in send order across both paths. Each side keeps sending over TCP until
+    // it has sent a start notice over TCP, and the peer only drains the ring after receiving that notice. Messages
+    // too large for the ring are sent over TCP with a marker record in the ring, the peer stops at the marker until
+    // the message arrives over TCP and dispatches it there.
+    //
+    // Message handler is called on the channel thread for messages received through the ring or behind a marker.
+    // It is not called once the channel thread has seen the channel closed, messages still waiting behind markers
+    // are dropped then. Join waits for a handler call that is already in progress.
+    class IpcSharedMemoryChannel
+        : public std::enable_shared_from_this<IpcSharedMemoryChannel>
+        , public Common::TextTraceComponent<Common::TraceTaskCodes::IPC>
+    {
+        DENY_COPY(IpcSharedMemoryChannel);
+
+    public:
+        typedef std::function<void(MessageUPtr & message, ISendTarget::SPtr const & target)> MessageHandler;
+        typedef std::function<Common::ErrorCode(MessageUPtr && message, Common::TimeSpan expiration)> TcpSender;
+
+        // Client side, creates a new segment, the channel is ready after server side attaches
+        static Common::ErrorCode Create(
+            std::wstring const & traceId,
+            uint ringSize,
+            ISendTarget::SPtr const & target,
+            MessageHandler const & handler,
+            TcpSender const & tcpSender,
+            _Out_ std::shared_ptr<IpcSharedMemoryChannel> & channel);
+
+        // Server side, attaches to the segment offered by client side
+        static Common::ErrorCode Attach(
+            std::wstring const & traceId,
+            IpcSharedMemoryHeader const & header,
+            ISendTarget::SPtr const & target,
+            MessageHandler const & handler,
+            TcpSender const & tcpSender,
+            _Out_ std::shared_ptr<IpcSharedMemoryChannel> & channel);
+
+        ~IpcSharedMemoryChannel();
+
+        std::wstring const & SegmentName() const { return segmentName_; }
+        uint RingSize() const { return ringSize_; }
+
+        // Starts the channel thread, called once the channel is reachable for sends on this side
+        void Start();
+
+        // Both sides have attached and neither has closed
+        bool IsReady() const;
+        bool IsClosed() const;
+
+        // Sends over TCP until this side has started sending through the ring. Does not block, messages are
+        // queued up to ring size bytes if outgoing ring is full, and fail with TransportSendQueueFull beyond
+        // that. Returns ObjectClosed and leaves the message untouched if the channel is closed.
+        Common::ErrorCode Send(MessageUPtr & message, Common::TimeSpan expiration);
+
+        // Called from TCP receive path for the start notice and for messages sent behind a marker
+        void OnPeerStarted();
+        bool OnDivertedMessage(MessageUPtr & message);
+
+        void Close();
+
+        // Waits for the channel thread to exit, called once after Close. Returns false if the thread is still
+        // running when timeout expires, or if called on the channel thread itself.
+        bool Join(Common::TimeSpan timeout);
+
+        // Channels that switched sends to the ring, and messages received through rings and behind markers,
+        // by all channels in this process
+        static uint64 Test_SendStartedCount() { return sendStartedCount_.load(); }
+        static uint64 Test_RingReceivedCount() { return ringReceivedCount_.load(); }
+        static uint64 Test_DivertedReceivedCount() { return divertedReceivedCount_.load(); }
+
+    private:
+        struct Segment;
+        struct Doorbell;
+        struct Ring;
+
+        enum Side { ClientSide = 0, ServerSide = 1 };
+
+        struct PendingSend
+        {
+            MessageUPtr Message; // null for a marker of a message already sent over TCP
+            Common::StopwatchTime Expiration;
+            size_t Bytes;
+        };
+
+        IpcSharedMemoryChannel(
+            std::wstring const & traceId,
+            Side side,
+            std::wstring const & segmentName,
+            uint ringSize,
+            Segment* segment,
+            ISendTarget::SPtr const & target,
+            MessageHandler const & handler,
+            TcpSender const & tcpSender);
+
+        static size_t GetSegmentSize(uint ringSize);
+        static void* ThreadFunc(void* arg);
+        static timespec ToAbsoluteTime(Common::TimeSpan timeout);
+
+        void Run();
+        void StartSending();
+        bool ReceiveMessages();
+        bool FlushPendingSends();
+        Common::ErrorCode SendDiverted_LockHeld(MessageUPtr & message);
+        bool TryWrite_LockHeld(Message & message);
+        bool TryWriteMarker_LockHeld();
+        bool TryWriteRecord_LockHeld(uint64 recordSize, uint32 headerSize, uint32 bodySize, Message * message);
+        bool HasWork();
+        void WaitForWork();
+        void Fail(std::string const & reason);
+        void FallBackToTcp(std::deque<PendingSend> && pendingSends);
+        void Release(MessageUPtr && message);
+
+        Side PeerSide() const { return (side_ == ClientSide) ? ServerSide : ClientSide; }
+        Ring & RingOf(Side producer) const;
+        byte* RingDataOf(Side producer) const;
+        size_t MaxMessageSize() const { return ringSize_ / 2; }
+        size_t PendingSendLimit() const { return ringSize_; }
+
+        std::wstring const traceId_;
+        Side const side_;
+        std::wstring const segmentName_;
+        uint const ringSize_;
+        Segment* const segment_;
+        ISendTarget::SPtr const target_;
+        MessageHandler const handler_;
+        TcpSender const tcpSender_;
+        Common::StopwatchTime const createTime_;
+
+        // Start does not create the thread once the channel is closed, so Join after Close sees every thread
+        Common::ExclusiveLock threadLock_;
+        pthread_t thread_;
+        bool threadStarted_ = false;
+        bool threadJoined_ = false;
+
+        // Senders take it shared, channel thread takes it exclusive to send start notice and switch to the ring
+        Common::RwLock pathLock_;
+        bool sendStarted_ = false;
+
+        Common::RwLock sendLock_;
+        std::deque<PendingSend> pendingSends_;
+        size_t pendingBytes_ = 0;
+
+        std::atomic_bool peerStarted_{false};
+        bool blockedAtMarker_ = false; // only accessed on channel thread
+        Common::RwLock divertedLock_;
+        std::deque<MessageUPtr> divertedMessages_;
+        bool divertedClosed_ = false;
+
+        static Common::atomic_uint64 sendStartedCount_;
+        static Common::atomic_uint64 ringReceivedCount_;
+        static Common::atomic_uint64 divertedReceivedCount_;
+    };
+}
@@ -0,0 +1,25 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Transport;
+using namespace Common;
+using namespace std;
+
+IpcSharedMemoryHeader::IpcSharedMemoryHeader() : ringSize_(0)
+{
+}
+
+IpcSharedMemoryHeader::IpcSharedMemoryHeader(wstring const & segmentName, uint32 ringSize)
+    : segmentName_(segmentName)
+    , ringSize_(ringSize)
+{
+}
+
+void IpcSharedMemoryHeader::WriteTo(TextWriter & w, FormatOptions const &) const
+{
+    w.Write("IpcSharedMemoryHeader({0}, ringSize={1})", segmentName_, ringSize_);
+}
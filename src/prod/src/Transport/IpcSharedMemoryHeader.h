@@ -0,0 +1,32 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Transport
+{
+    // Added by IpcClient side to an Ipc actor message sent over TCP, offers IpcServer side a shared memory segment
+    // with a ring of the given size in each direction. Servers that do not understand it treat the message as a
+    // regular reconnect message, and communication stays on TCP. Once a channel exists, each side also sends it on
+    // an Ipc actor message as start notice before switching to the ring, and adds it with ring size 0 to a message
+    // sent over TCP behind a marker in the ring.
+    class IpcSharedMemoryHeader : public MessageHeader<MessageHeaderId::IpcSharedMemory>, public Serialization::FabricSerializable
+    {
+    public:
+        IpcSharedMemoryHeader();
+        IpcSharedMemoryHeader(std::wstring const & segmentName, uint32 ringSize);
+
+        std::wstring const & SegmentName() const { return segmentName_; }
+        uint32 RingSize() const { return ringSize_; }
+
+        void WriteTo(Common::TextWriter & w, Common::FormatOptions const &) const;
+
+        FABRIC_FIELDS_02(segmentName_, ringSize_);
+
+    private:
+        std::wstring segmentName_;
+        uint32 ringSize_;
+    };
+}
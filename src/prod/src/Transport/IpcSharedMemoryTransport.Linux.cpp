@@ -0,0 +1,350 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Transport;
+using namespace Common;
+using namespace std;
+
+static const StringLiteral TraceType("SharedMemory");
+
+IpcSharedMemoryTransport::IpcSharedMemoryTransport(IDatagramTransportSPtr const & innerTransport, bool isClient, uint ringSize)
+    : innerTransport_(innerTransport)
+    , isClient_(isClient)
+    , ringSize_(ringSize)
+{
+    ASSERT_IF(!innerTransport_, "the inner transport is invalid");
+}
+
+IpcSharedMemoryTransport::~IpcSharedMemoryTransport()
+{
+}
+
+ErrorCode IpcSharedMemoryTransport::Start(bool completeStart)
+{
+    weak_ptr<IpcSharedMemoryTransport> weakThis = shared_from_this();
+    disconnectHandler_ = innerTransport_->RegisterDisconnectEvent([weakThis](DisconnectEventArgs const & eventArgs)
+    {
+        if (auto thisSPtr = weakThis.lock())
+        {
+            thisSPtr->OnDisconnect(eventArgs.Target);
+        }
+    });
+
+    return innerTransport_->Start(completeStart);
+}
+
+void IpcSharedMemoryTransport::Stop(TimeSpan timeout)
+{
+    innerTransport_->UnregisterDisconnectEvent(disconnectHandler_);
+
+    unordered_map<ISendTarget const*, shared_ptr<IpcSharedMemoryChannel>> channels;
+    {
+        AcquireWriteLock grab(lock_);
+
+        // channel threads check the handler before dispatching, nothing new is dispatched after this
+        handler_ = nullptr;
+        stopped_ = true;
+        channels.swap(channels_);
+    }
+
+    for (auto const & channel : channels)
+    {
+        // null for a channel that failed to be created
+        if (channel.second)
+        {
+            channel.second->Close();
+        }
+    }
+
+    // wait for handler calls already in progress on channel threads
+    TimeoutHelper joinTimeout((timeout == TimeSpan::Zero) ? TransportConfig::GetConfig().CloseDrainTimeout : timeout);
+    for (auto const & channel : channels)
+    {
+        if (channel.second && !channel.second->Join(joinTimeout.GetRemainingTime()))
+        {
+            WriteWarning(TraceType, TraceId(), "{0}: channel thread is still running after stop", channel.second->SegmentName());
+        }
+    }
+
+    innerTransport_->Stop(timeout);
+}
+
+void IpcSharedMemoryTransport::SetMessageHandler(MessageHandler const & handler)
+{
+    {
+        AcquireWriteLock grab(lock_);
+        handler_ = handler;
+    }
+
+    weak_ptr<IpcSharedMemoryTransport> weakThis = shared_from_this();
+    innerTransport_->SetMessageHandler([weakThis](MessageUPtr & message, ISendTarget::SPtr const & target)
+    {
+        if (auto thisSPtr = weakThis.lock())
+        {
+            thisSPtr->OnMessageReceived(message, target);
+        }
+    });
+}
+
+ISendTarget::SPtr IpcSharedMemoryTransport::Resolve(
+    wstring const & address, wstring const & targetId, wstring const & sspiTarget, uint64 instance)
+{
+    return innerTransport_->Resolve(address, targetId, sspiTarget, instance);
+}
+
+bool IpcSharedMemoryTransport::IsEnabled() const
+{
+    auto security = innerTransport_->Security();
+    return security && (security->SecurityProvider == SecurityProvider::None);
+}
+
+ErrorCode IpcSharedMemoryTransport::SendOneWay(
+    ISendTarget::SPtr const & target,
+    MessageUPtr && message,
+    TimeSpan expiration,
+    TransportPriority::Enum priority)
+{
+    if (target && IsEnabled())
+    {
+        auto channel = GetChannel(target.get());
+        if (channel)
+        {
+            // the channel keeps order with messages it already sent over TCP or through the ring
+            auto error = channel->Send(message, expiration);
+            if (!error.IsError(ErrorCodeValue::ObjectClosed) || !message)
+            {
+                return error;
+            }
+        }
+        else if (isClient_)
+        {
+            OfferChannel(target, *message);
+        }
+    }
+
+    return innerTransport_->SendOneWay(target, move(message), expiration, priority);
+}
+
+void IpcSharedMemoryTransport::OfferChannel(ISendTarget::SPtr const & target, Message & message)
+{
+    // offer carries the same IpcHeader, so server side treats it as a reconnect message from this client
+    IpcHeader ipcHeader;
+    if (!message.Headers.TryReadFirst(ipcHeader))
+    {
+        return;
+    }
+
+    shared_ptr<IpcSharedMemoryChannel> channel;
+    {
+        AcquireWriteLock grab(lock_);
+
+        if (stopped_ || (channels_.find(target.get()) != channels_.cend()))
+        {
+            return;
+        }
+
+        auto error = IpcSharedMemoryChannel::Create(
+            TraceId(),
+            ringSize_,
+            target,
+            CreateChannelHandler(),
+            CreateTcpSender(target),
+            channel);
+
+        if (!error.IsSuccess())
+        {
+            // remember the failure with a closed channel, to avoid retrying on every send until reconnect
+            WriteInfo(TraceType, TraceId(), "failed to create shared memory channel to {0}: {1}", target->Address(), error);
+            channels_.emplace(target.get(), nullptr);
+            return;
+        }
+
+        channels_.emplace(target.get(), channel);
+    }
+
+    auto offer = make_unique<Message>();
+    offer->Headers.Add(ActorHeader(Actor::Ipc));
+    offer->Headers.Add(MessageIdHeader());
+    offer->Headers.Add(ipcHeader);
+    offer->Headers.Add(IpcSharedMemoryHeader(channel->SegmentName(), channel->RingSize()));
+
+    WriteInfo(TraceType, TraceId(), "offering {0} to {1}", channel->SegmentName(), target->Address());
+    auto error = innerTransport_->SendOneWay(target, move(offer));
+    if (!error.IsSuccess())
+    {
+        WriteInfo(TraceType, TraceId(), "failed to send shared memory offer: {0}", error);
+        channel->Close();
+        return;
+    }
+
+    channel->Start();
+}
+
+void IpcSharedMemoryTransport::OnMessageReceived(MessageUPtr & message, ISendTarget::SPtr const & target)
+{
+    if (TryHandleChannelMessage(message, target))
+    {
+        return;
+    }
+
+    DispatchMessage(message, target);
+}
+
+void IpcSharedMemoryTransport::DispatchMessage(MessageUPtr & message, ISendTarget::SPtr const & target)
+{
+    MessageHandler handler;
+    {
+        AcquireReadLock grab(lock_);
+        handler = handler_;
+    }
+
+    // reset by Stop
+    if (handler)
+    {
+        handler(message, target);
+    }
+}
+
+bool IpcSharedMemoryTransport::TryHandleChannelMessage(MessageUPtr & message, ISendTarget::SPtr const & target)
+{
+    IpcSharedMemoryHeader header;
+    if (!message->Headers.TryReadFirst(header))
+    {
+        return false;
+    }
+
+    auto channel = GetChannel(target.get());
+    bool isChannelMessage = channel && (channel->SegmentName() == header.SegmentName());
+
+    if (header.RingSize() == 0)
+    {
+        // sent behind a marker, dispatched directly if the channel is gone as there is no ring to keep order with
+        return isChannelMessage && channel->OnDivertedMessage(message);
+    }
+
+    if (message->Actor != Actor::Ipc)
+    {
+        return false;
+    }
+
+    if (isChannelMessage)
+    {
+        // start notice, peer sends through the ring from now on
+        channel->OnPeerStarted();
+        return true;
+    }
+
+    IpcHeader ipcHeader;
+    if (!message->Headers.TryReadFirst(ipcHeader))
+    {
+        // start notice of a channel that is already gone, offers always carry IpcHeader
+        return true;
+    }
+
+    if (isClient_ || !IsEnabled())
+    {
+        return false;
+    }
+
+    auto error = IpcSharedMemoryChannel::Attach(
+        TraceId(),
+        header,
+        target,
+        CreateChannelHandler(),
+        CreateTcpSender(target),
+        channel);
+    if (!error.IsSuccess())
+    {
+        return false;
+    }
+
+    WriteInfo(TraceType, TraceId(), "attached to {0} offered by {1}", header.SegmentName(), target->Address());
+
+    shared_ptr<IpcSharedMemoryChannel> replaced;
+    bool stopped;
+    {
+        AcquireWriteLock grab(lock_);
+
+        stopped = stopped_;
+        if (!stopped)
+        {
+            auto & entry = channels_[target.get()];
+            replaced = move(entry);
+            entry = channel;
+        }
+    }
+
+    if (replaced)
+    {
+        replaced->Close();
+    }
+
+    if (stopped)
+    {
+        // no thread was started, Stop has nothing to join
+        channel->Close();
+        return true;
+    }
+
+    channel->Start();
+
+    // offer is still passed on as a reconnect message
+    return false;
+}
+
+IpcSharedMemoryChannel::MessageHandler IpcSharedMemoryTransport::CreateChannelHandler()
+{
+    // the current handler is looked up for each message, so that channels stop dispatching once Stop reset it
+    weak_ptr<IpcSharedMemoryTransport> weakThis = shared_from_this();
+    return [weakThis](MessageUPtr & received, ISendTarget::SPtr const & sender)
+    {
+        if (auto thisSPtr = weakThis.lock())
+        {
+            thisSPtr->DispatchMessage(received, sender);
+        }
+    };
+}
+
+IpcSharedMemoryChannel::TcpSender IpcSharedMemoryTransport::CreateTcpSender(ISendTarget::SPtr const & target) const
+{
+    auto innerTransport = innerTransport_;
+    return [innerTransport, target](MessageUPtr && message, TimeSpan expiration)
+    {
+        return innerTransport->SendOneWay(target, move(message), expiration);
+    };
+}
+
+void IpcSharedMemoryTransport::OnDisconnect(ISendTarget const* target)
+{
+    shared_ptr<IpcSharedMemoryChannel> channel;
+    {
+        AcquireWriteLock grab(lock_);
+
+        auto iter = channels_.find(target);
+        if (iter == channels_.end())
+        {
+            return;
+        }
+
+        channel = move(iter->second);
+        channels_.erase(iter);
+    }
+
+    // a new channel is offered after client reconnects
+    if (channel)
+    {
+        channel->Close();
+    }
+}
+
+shared_ptr<IpcSharedMemoryChannel> IpcSharedMemoryTransport::GetChannel(ISendTarget const* target) const
+{
+    AcquireReadLock grab(lock_);
+
+    auto iter = channels_.find(target);
+    return (iter != channels_.cend()) ? iter->second : nullptr;
+}
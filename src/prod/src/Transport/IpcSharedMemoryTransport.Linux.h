@@ -0,0 +1,140 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Transport
+{
+    // Wraps the TCP transport of IpcClient or IpcServer. Client side offers a shared memory channel to the server
+    // over TCP, with an Actor::Ipc message carrying IpcSharedMemoryHeader, before its first message to the server.
+    // Server side attaches to the offered segment and still passes the offer on as a reconnect message, servers
+    // without shared memory support do the same and the offer times out on client side. Once a channel exists,
+    // all messages to its target go through the channel, which keeps them in send order while it switches from
+    // TCP to the ring, and falls back to the inner TCP transport after it closes. Start notices and messages sent
+    // behind ring markers are recognized on the TCP receive path and handed to the channel. Messages received
+    // through a channel are dispatched with the TCP send target, so replies and IpcHeader based routing are the
+    // same as for messages received over TCP. Only used for unsecured transports.
+    //
+    // Stop resets the message handler before closing channels, channel threads check it before each dispatch.
+    // Channel threads are then joined, also for a zero timeout, so no handler call outlives Stop unless it
+    // takes longer than CloseDrainTimeout.
+    class IpcSharedMemoryTransport
+        : public IDatagramTransport
+        , public std::enable_shared_from_this<IpcSharedMemoryTransport>
+        , public Common::TextTraceComponent<Common::TraceTaskCodes::IPC>
+    {
+        DENY_COPY(IpcSharedMemoryTransport);
+
+    public:
+        IpcSharedMemoryTransport(IDatagramTransportSPtr const & innerTransport, bool isClient, uint ringSize);
+        ~IpcSharedMemoryTransport() override;
+
+        std::wstring const & get_IdString() const override { return innerTransport_->get_IdString(); }
+
+        Common::ErrorCode Start(bool completeStart = true) override;
+        Common::ErrorCode CompleteStart() override { return innerTransport_->CompleteStart(); }
+        void Stop(Common::TimeSpan timeout = Common::TimeSpan::Zero) override;
+
+        std::wstring const & TraceId() const override { return innerTransport_->TraceId(); }
+
+        TransportSecuritySPtr Security() const override { return innerTransport_->Security(); }
+
+        void SetFrameHeaderErrorChecking(bool enabled) override { innerTransport_->SetFrameHeaderErrorChecking(enabled); }
+        void SetMessageErrorChecking(bool enabled) override { innerTransport_->SetMessageErrorChecking(enabled); }
+
+        void SetMessageHandler(MessageHandler const & handler) override;
+
+        size_t SendTargetCount() const override { return innerTransport_->SendTargetCount(); }
+
+        Common::ErrorCode SendOneWay(
+            ISendTarget::SPtr const & target,
+            MessageUPtr && message,
+            Common::TimeSpan expiration = Common::TimeSpan::MaxValue,
+            TransportPriority::Enum = TransportPriority::Normal) override;
+
+        std::wstring const & ListenAddress() const override { return innerTransport_->ListenAddress(); }
+
+        void SetConnectionAcceptedHandler(ConnectionAcceptedHandler const & handler) override { innerTransport_->SetConnectionAcceptedHandler(handler); }
+        void RemoveConnectionAcceptedHandler() override { innerTransport_->RemoveConnectionAcceptedHandler(); }
+
+        DisconnectHHandler RegisterDisconnectEvent(DisconnectEventHandler eventHandler) override { return innerTransport_->RegisterDisconnectEvent(eventHandler); }
+        bool UnregisterDisconnectEvent(DisconnectHHandler hHandler) override { return innerTransport_->UnregisterDisconnectEvent(hHandler); }
+
+        void SetConnectionFaultHandler(ConnectionFaultHandler const & handler) override { innerTransport_->SetConnectionFaultHandler(handler); }
+        void RemoveConnectionFaultHandler() override { innerTransport_->RemoveConnectionFaultHandler(); }
+
+        Common::ErrorCode SetSecurity(SecuritySettings const & securitySettings) override { return innerTransport_->SetSecurity(securitySettings); }
+        void SetInstance(uint64 instance) override { innerTransport_->SetInstance(instance); }
+
+        void DisableSecureSessionExpiration() override { innerTransport_->DisableSecureSessionExpiration(); }
+
+        void DisableThrottle() override { innerTransport_->DisableThrottle(); }
+        void AllowThrottleReplyMessage() override { innerTransport_->AllowThrottleReplyMessage(); }
+
+        void DisableListenInstanceMessage() override { innerTransport_->DisableListenInstanceMessage(); }
+
+        Common::ErrorCode SetPerTargetSendQueueLimit(ULONG limitInBytes) override { return innerTransport_->SetPerTargetSendQueueLimit(limitInBytes); }
+        Common::ErrorCode SetOutgoingMessageExpiration(Common::TimeSpan expiration) override { return innerTransport_->SetOutgoingMessageExpiration(expiration); }
+
+        void SetClaimsRetrievalMetadata(ClaimsRetrievalMetadata && metadata) override { innerTransport_->SetClaimsRetrievalMetadata(std::move(metadata)); }
+        void SetClaimsRetrievalHandler(TransportSecurity::ClaimsRetrievalHandler const & handler) override { innerTransport_->SetClaimsRetrievalHandler(handler); }
+        void RemoveClaimsRetrievalHandler() override { innerTransport_->RemoveClaimsRetrievalHandler(); }
+
+        void SetClaimsHandler(TransportSecurity::ClaimsHandler const & handler) override { innerTransport_->SetClaimsHandler(handler); }
+        void RemoveClaimsHandler() override { innerTransport_->RemoveClaimsHandler(); }
+
+        void SetMaxIncomingFrameSize(ULONG limit) override { innerTransport_->SetMaxIncomingFrameSize(limit); }
+        void SetMaxOutgoingFrameSize(ULONG limit) override { innerTransport_->SetMaxOutgoingFrameSize(limit); }
+
+        Common::TimeSpan ConnectionOpenTimeout() const override { return innerTransport_->ConnectionOpenTimeout(); }
+        void SetConnectionOpenTimeout(Common::TimeSpan timeout) override { innerTransport_->SetConnectionOpenTimeout(timeout); }
+
+        Common::TimeSpan ConnectionIdleTimeout() const override { return innerTransport_->ConnectionIdleTimeout(); }
+        void SetConnectionIdleTimeout(Common::TimeSpan idleTimeout) override { innerTransport_->SetConnectionIdleTimeout(idleTimeout); }
+
+        Common::TimeSpan KeepAliveTimeout() const override { return innerTransport_->KeepAliveTimeout(); }
+        void SetKeepAliveTimeout(Common::TimeSpan timeout) override { innerTransport_->SetKeepAliveTimeout(timeout); }
+
+        void EnableInboundActivityTracing() override { innerTransport_->EnableInboundActivityTracing(); }
+
+        void SetBufferFactory(std::unique_ptr<IBufferFactory> && bufferFactory) override { innerTransport_->SetBufferFactory(std::move(bufferFactory)); }
+
+        void DisableAllPerMessageTraces() override { innerTransport_->DisableAllPerMessageTraces(); }
+
+        void Test_Reset() override { innerTransport_->Test_Reset(); }
+
+        Common::EventLoopPool* EventLoops() const override { return innerTransport_->EventLoops(); }
+        void SetEventLoopPool(Common::EventLoopPool* pool) override { innerTransport_->SetEventLoopPool(pool); }
+        void SetEventLoopReadDispatch(bool asyncDispatch) override { innerTransport_->SetEventLoopReadDispatch(asyncDispatch); }
+        void SetEventLoopWriteDispatch(bool asyncDispatch) override { innerTransport_->SetEventLoopWriteDispatch(asyncDispatch); }
+
+    private:
+        ISendTarget::SPtr Resolve(
+            std::wstring const & address,
+            std::wstring const & targetId,
+            std::wstring const & sspiTarget,
+            uint64 instance) override;
+
+        bool IsEnabled() const;
+        void OnMessageReceived(MessageUPtr & message, ISendTarget::SPtr const & target);
+        void OnDisconnect(ISendTarget const* target);
+        void OfferChannel(ISendTarget::SPtr const & target, Message & message);
+        void DispatchMessage(MessageUPtr & message, ISendTarget::SPtr const & target);
+        bool TryHandleChannelMessage(MessageUPtr & message, ISendTarget::SPtr const & target);
+        IpcSharedMemoryChannel::MessageHandler CreateChannelHandler();
+        IpcSharedMemoryChannel::TcpSender CreateTcpSender(ISendTarget::SPtr const & target) const;
+        std::shared_ptr<IpcSharedMemoryChannel> GetChannel(ISendTarget const* target) const;
+
+        IDatagramTransportSPtr const innerTransport_;
+        bool const isClient_;
+        uint const ringSize_;
+        DisconnectHHandler disconnectHandler_;
+
+        mutable Common::RwLock lock_;
+        MessageHandler handler_;
+        bool stopped_ = false;
+        std::unordered_map<ISendTarget const*, std::shared_ptr<IpcSharedMemoryChannel>> channels_;
+    };
+}
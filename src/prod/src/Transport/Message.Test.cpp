@@ -2046,6 +2046,133 @@ namespace Transport
         std::vector<byte> samples_;
     };
 
+    BOOST_AUTO_TEST_CASE(ActionIdTest)
+    {
+        ENTER;
+
+        vector<wstring> actions;
+        for (int i = 0; i < 200; ++i)
+        {
+            actions.push_back(wformatString("ActionIdTest.Action{0}", i));
+        }
+
+        vector<ActionTable::ActionId> ids;
+        for (auto const & action : actions)
+        {
+            auto id = ActionTable::Register(action);
+            VERIFY_ARE_NOT_EQUAL(id, ActionTable::UnknownActionId);
+            ids.push_back(id);
+        }
+
+        // registration is idempotent and every action resolves to its own id
+        for (size_t i = 0; i < actions.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(ids[i], ActionTable::Register(actions[i]));
+            VERIFY_ARE_EQUAL(ids[i], ActionTable::Lookup(actions[i]));
+        }
+
+        VERIFY_ARE_EQUAL(ActionTable::UnknownActionId, ActionTable::Lookup(L"ActionIdTest.Unregistered"));
+
+        ActionDispatchTable<int> dispatchTable;
+        for (int i = 0; i < 100; ++i)
+        {
+            VERIFY_IS_TRUE(dispatchTable.Add(actions[i], i));
+        }
+
+        VERIFY_IS_FALSE(dispatchTable.Add(actions[0], 0));
+        VERIFY_ARE_EQUAL(100u, dispatchTable.size());
+
+        Message message;
+        message.Headers.Add(ActionHeader(actions[42]));
+        VERIFY_ARE_EQUAL(ids[42], message.ActionId);
+        VERIFY_IS_TRUE(dispatchTable.Find(message) != nullptr);
+        VERIFY_ARE_EQUAL(42, *dispatchTable.Find(message));
+
+        // action id must follow action header changes, including headers deserialized on receive
+        message.Headers.RemoveAll();
+        VERIFY_ARE_EQUAL(ActionTable::UnknownActionId, message.ActionId);
+        VERIFY_IS_TRUE(dispatchTable.Find(message) == nullptr);
+
+        message.Headers.Add(ActionHeader(actions[150]));
+        VERIFY_ARE_EQUAL(ids[150], message.ActionId);
+        VERIFY_IS_TRUE(dispatchTable.Find(message) == nullptr);
+
+        auto clone = message.Clone();
+        VERIFY_ARE_EQUAL(ids[150], clone->ActionId);
+
+        message.Headers.RemoveAll();
+        message.Headers.Add(ActionHeader(L"ActionIdTest.Unregistered"));
+        VERIFY_ARE_EQUAL(ActionTable::UnknownActionId, message.ActionId);
+        VERIFY_IS_TRUE(dispatchTable.Find(message) == nullptr);
+
+        // unknown id is not cached, a message looked up before its action got registered is still dispatched
+        Message lateMessage;
+        lateMessage.Headers.Add(ActionHeader(L"ActionIdTest.RegisteredLate"));
+        VERIFY_ARE_EQUAL(ActionTable::UnknownActionId, lateMessage.ActionId);
+        VERIFY_IS_TRUE(dispatchTable.Find(lateMessage) == nullptr);
+
+        VERIFY_IS_TRUE(dispatchTable.Add(L"ActionIdTest.RegisteredLate", 1000));
+        VERIFY_ARE_EQUAL(ActionTable::Lookup(L"ActionIdTest.RegisteredLate"), lateMessage.ActionId);
+        VERIFY_IS_TRUE(dispatchTable.Find(lateMessage) != nullptr);
+        VERIFY_ARE_EQUAL(1000, *dispatchTable.Find(lateMessage));
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(ActionIdConcurrentRegisterLookupTest)
+    {
+        ENTER;
+
+        int const threadCount = 8;
+        int const actionsPerThread = 500;
+        atomic_long threadsDone(0);
+        atomic_long failures(0);
+        ManualResetEvent allDone(false);
+
+        // every thread registers its own actions and a shared set, while looking up what others registered
+        for (int t = 0; t < threadCount; ++t)
+        {
+            Threadpool::Post([t, threadCount, actionsPerThread, &threadsDone, &failures, &allDone]
+            {
+                for (int i = 0; i < actionsPerThread; ++i)
+                {
+                    auto own = wformatString("ActionIdConcurrentTest.Thread{0}.Action{1}", t, i);
+                    auto shared = wformatString("ActionIdConcurrentTest.Shared{0}", i);
+
+                    auto ownId = ActionTable::Register(own);
+                    auto sharedId = ActionTable::Register(shared);
+                    if ((ownId == ActionTable::UnknownActionId) ||
+                        (ActionTable::Lookup(own) != ownId) ||
+                        (ActionTable::Lookup(shared) != sharedId))
+                    {
+                        ++failures;
+                    }
+                }
+
+                if (++threadsDone == threadCount)
+                {
+                    allDone.Set();
+                }
+            });
+        }
+
+        VERIFY_IS_TRUE(allDone.WaitOne(TimeSpan::FromSeconds(60)));
+        VERIFY_ARE_EQUAL(0, failures.load());
+
+        // shared actions got a single id each, and ids of different actions never collide
+        set<ActionTable::ActionId> ids;
+        for (int i = 0; i < actionsPerThread; ++i)
+        {
+            VERIFY_IS_TRUE(ids.insert(ActionTable::Lookup(wformatString("ActionIdConcurrentTest.Shared{0}", i))).second);
+            for (int t = 0; t < threadCount; ++t)
+            {
+                VERIFY_IS_TRUE(ids.insert(ActionTable::Lookup(wformatString("ActionIdConcurrentTest.Thread{0}.Action{1}", t, i))).second);
+            }
+        }
+
+        LEAVE;
+    }
+
     BOOST_AUTO_TEST_CASE(HeaderAddFailure)
     {
         ENTER;
@@ -73,6 +73,7 @@ namespace Transport
 
         __declspec(property(get=get_Headers)) MessageHeaders & Headers;
         __declspec(property(get=get_Action)) std::wstring const & Action;
+        __declspec(property(get=get_ActionId)) ActionTable::ActionId ActionId;
         __declspec(property(get=get_Actor)) Actor::Enum Actor;
         __declspec(property(get=get_MessageId)) Transport::MessageId const & MessageId;
         __declspec(property(get=get_RelatesTo)) Transport::MessageId const & RelatesTo;
@@ -85,6 +86,7 @@ namespace Transport
         __declspec(property(get=get_IsUncorrelatedReply)) bool IsUncorrelatedReply;
 
         std::wstring const & get_Action() const;
+        ActionTable::ActionId get_ActionId() const { return headers_.ActionId; }
         SendStatusCallback const & get_SendStatusCallback() const;
         Actor::Enum get_Actor() const;
         Transport::MessageId const & get_MessageId() const;
@@ -204,6 +206,13 @@ namespace Transport
 
         SendStatusCallback sendStatusCallback_;
 
+        // Set by TcpConnection while the message waits in its lock-free send intake, so that handing
+        // the message over does not allocate a queue node
+        Message * sendIntakeNext_ = nullptr;
+        Common::TimeSpan sendIntakeExpiration_;
+        size_t sendIntakeBytes_ = 0;
+        bool sendIntakeShouldEncrypt_ = false;
+
         // This class is used to  wrap message property, so that all message properties of different type can be stored in a single container.
         class MessageProperty
         {
@@ -284,6 +293,7 @@ namespace Transport
         };
 
         friend class SecurityContextSsl;
+        friend class TcpConnection;
     };
 
     // todo: find out if we can get rid of "body_(EmptyByteBique.begin(), EmptyByteBique.end(), false)" in the initialization list,
@@ -119,6 +119,9 @@ namespace Transport
             case UpgradeComposeDeploymentRequest: w << "UpgradeComposeDeploymentRequest"; return;
             case CreateVolumeRequest: w << "CreateVolumeRequest"; return;
             case FileUploadCreateRequest: w << "FileUploadCreateRequest"; return;
+            case FrameCompression: w << "FrameCompression"; return;
+            case IpcSharedMemory: w << "IpcSharedMemory"; return;
+            case ReplicationAckBatch: w << "ReplicationAckBatch"; return;
 
             // Header IDs for tests follow this line.
             case Example: w << "Example"; return;
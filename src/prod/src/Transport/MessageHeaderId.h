@@ -146,6 +146,10 @@ namespace Transport
             CreateVolumeRequest = 0x804e,
             FileUploadCreateRequest = 0x804f,
 
+            FrameCompression = 0x8050,
+            IpcSharedMemory = 0x8051,
+            ReplicationAckBatch = 0x8052,
+
             // Add new internal message header ids must be explicitly defined
             // ----------------------------------------------------------------
             // Header IDs for tests follow this line.
@@ -693,6 +693,7 @@ MessageHeaders::HeaderIterator& MessageHeaders::Remove(HeaderIterator& iter)
     {
     case MessageHeaderId::Action:
         action_.clear();
+        actionId_.store(ActionTable::UnknownActionId, std::memory_order_relaxed);
         break;
 
     case MessageHeaderId::Actor:
@@ -750,6 +751,7 @@ void MessageHeaders::RemoveAll()
 void MessageHeaders::ResetCommonHeaders()
 {
     action_.clear();
+    actionId_.store(ActionTable::UnknownActionId, std::memory_order_relaxed);
     actor_ = Actor::Enum::Empty;
     messageId_ = Transport::MessageId(Common::Guid::Empty(), 0);
     relatesTo_ = Transport::MessageId(Common::Guid::Empty(), 0);
@@ -781,7 +783,8 @@ NTSTATUS MessageHeaders::UpdateCommonHeaders()
                     return this->Status;
                 }
 
-                action_ = header.Action;
+                action_ = header.TakeAction();
+                actionId_.store(ActionTable::UnknownActionId, std::memory_order_relaxed);
                 break;
             }
         case MessageHeaderId::Actor:
@@ -42,6 +42,10 @@ namespace Transport
         // todo: consider returning const & of actual header from these common header properties and add a "initialized" boolean flag for each.
         // also dicussed, have the base header class have a flag for default value so that tracing will print empty but using it requires explicit check
         __declspec(property(get=get_Action)) std::wstring const & Action;
+        // Interned id of Action, UnknownActionId if Action is not registered in ActionTable.
+        // Resolved on first access and cached until action header changes. UnknownActionId is not
+        // cached, so an action registered after the first access is still resolved later.
+        __declspec(property(get=get_ActionId)) ActionTable::ActionId ActionId;
         __declspec(property(get=get_Actor)) Actor::Enum Actor;
         __declspec(property(get=get_MessageId)) Transport::MessageId const & MessageId;
         __declspec(property(get=get_RelatesTo)) Transport::MessageId const & RelatesTo;
@@ -55,6 +59,7 @@ namespace Transport
         __declspec(property(get=get_DeletedHeaderByteCount)) size_t DeletedHeaderByteCount;
 
         std::wstring const & get_Action() const;
+        ActionTable::ActionId get_ActionId() const;
         Actor::Enum get_Actor() const;
         Transport::MessageId const & get_MessageId() const;
         Transport::MessageId const & get_RelatesTo() const;
@@ -309,6 +314,8 @@ namespace Transport
         Transport::MessageId traceId_ {messageId_};
 
         std::wstring action_;
+        // received messages may be read from several threads, so the lazily resolved id is atomic
+        mutable std::atomic<ActionTable::ActionId> actionId_ {ActionTable::UnknownActionId};
         Actor::Enum actor_ =  Actor::Empty;
 
         bool expectsReply_ = false;
@@ -427,6 +434,7 @@ namespace Transport
         // also, we probably need to check whether there is already an action header
         //
         action_ = header.Action;
+        actionId_.store(ActionTable::UnknownActionId, std::memory_order_relaxed);
         return status;
     }
 
@@ -614,6 +622,19 @@ namespace Transport
         return action_;
     }
 
+    inline ActionTable::ActionId MessageHeaders::get_ActionId() const
+    {
+        auto id = actionId_.load(std::memory_order_relaxed);
+        if ((id == ActionTable::UnknownActionId) && !action_.empty())
+        {
+            // racing readers resolve the same id, so a relaxed store is enough
+            id = ActionTable::Lookup(action_);
+            actionId_.store(id, std::memory_order_relaxed);
+        }
+
+        return id;
+    }
+
     inline Actor::Enum MessageHeaders::get_Actor() const
     {
         return actor_;
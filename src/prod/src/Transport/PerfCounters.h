@@ -35,11 +35,35 @@ namespace Transport
                 Common::PerformanceCounterType::AverageCount64,
                 L"Avg. TCP send size (bytes)",
                 L"Counter for measuring the average TCP send size in bytes")
+            COUNTER_DEFINITION(
+                4,
+                Common::PerformanceCounterType::RawData64,
+                L"# of compressed frames",
+                L"Count of frames sent with compressed message body")
+            COUNTER_DEFINITION(
+                5,
+                Common::PerformanceCounterType::RawData64,
+                L"# of frames bypassing compression",
+                L"Count of frames eligible for compression but sent uncompressed, due to poor compression ratio")
+            COUNTER_DEFINITION(
+                6,
+                Common::PerformanceCounterType::RawData64,
+                L"Compression input bytes",
+                L"Total uncompressed message body bytes of compressed frames")
+            COUNTER_DEFINITION(
+                7,
+                Common::PerformanceCounterType::RawData64,
+                L"Compression output bytes",
+                L"Total compressed message body bytes of compressed frames")
         END_COUNTER_SET_DEFINITION()
 
         DECLARE_COUNTER_INSTANCE(NumberOfActiveCallbacks)
         DECLARE_COUNTER_INSTANCE(AverageTcpSendSizeBase)
         DECLARE_COUNTER_INSTANCE(AverageTcpSendSize)
+        DECLARE_COUNTER_INSTANCE(CompressedFrameCount)
+        DECLARE_COUNTER_INSTANCE(CompressionBypassedFrameCount)
+        DECLARE_COUNTER_INSTANCE(CompressionInputBytes)
+        DECLARE_COUNTER_INSTANCE(CompressionOutputBytes)
 
         BEGIN_COUNTER_SET_INSTANCE(PerfCounters)
             DEFINE_COUNTER_INSTANCE(
@@ -51,6 +75,18 @@ namespace Transport
                 DEFINE_COUNTER_INSTANCE(
                 AverageTcpSendSize,
                 3)
+                DEFINE_COUNTER_INSTANCE(
+                CompressedFrameCount,
+                4)
+                DEFINE_COUNTER_INSTANCE(
+                CompressionBypassedFrameCount,
+                5)
+                DEFINE_COUNTER_INSTANCE(
+                CompressionInputBytes,
+                6)
+                DEFINE_COUNTER_INSTANCE(
+                CompressionOutputBytes,
+                7)
         END_COUNTER_SET_INSTANCE()
     };
 }
@@ -24,6 +24,9 @@ namespace Transport
         virtual NTSTATUS GetNextMessage(_Out_ MessageUPtr & message, Common::StopwatchTime recvTime) = 0;
         virtual void ConsumeCurrentMessage() = 0;
 
+        // Whether this receive buffer can decompress message body compressed by remote side
+        virtual bool SupportsFrameCompression() const { return false; }
+
     protected:
         TcpConnection* const connectionPtr_;
         uint64 receiveCount_ = 0;
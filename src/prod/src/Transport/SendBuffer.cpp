@@ -86,6 +86,25 @@ bool SendBuffer::ConsumePreparedBuffers(ssize_t sent)
     return false;
 }
 
+uint SendBuffer::PreparedBufferRun(uint first, bool & zeroCopy) const
+{
+    zeroCopy = IsZeroCopyBuffer(first);
+
+    uint end = first + 1;
+    while ((end < preparedBuffers_.size()) && (IsZeroCopyBuffer(end) == zeroCopy))
+    {
+        ++end;
+    }
+
+    return end - first;
+}
+
+void SendBuffer::MarkLastPreparedBufferZeroCopy()
+{
+    zeroCopyBuffers_.resize(preparedBuffers_.size());
+    zeroCopyBuffers_.back() = true;
+}
+
 #endif
 
 SendBuffer::Buffers const & SendBuffer::PreparedBuffers() const
@@ -178,7 +197,7 @@ void SendBuffer::EnqueueMessagesDelayedBySecurityNegotiation(unique_ptr<Message>
     EnableEncryptEnqueue();
 }
 
-ErrorCode SendBuffer::EnqueueMessage(MessageUPtr && message, TimeSpan expiration, bool shouldEncrypt)
+ErrorCode SendBuffer::EnqueueMessage(MessageUPtr && message, TimeSpan expiration, bool shouldEncrypt, bool checkLimit)
 {
     if (firstEnqueueCall_)
     {
@@ -190,7 +209,8 @@ ErrorCode SendBuffer::EnqueueMessage(MessageUPtr && message, TimeSpan expiration
     if (shouldEncrypt && !canEnqueueEncrypt_)
     {
         size_t delayedBytesAfter = totalDelayedBytes_ + bytesToAdd;
-        if ((limitInBytes_ < delayedBytesAfter) && 
+        if (checkLimit &&
+            (limitInBytes_ < delayedBytesAfter) && 
             //when frame size limit is disabled, ignore queue limit on empty queue to allow one large message
             (!connection_->OutgoingFrameSizeLimitDisabled() ||
             totalDelayedBytes_)) 
@@ -220,7 +240,8 @@ ErrorCode SendBuffer::EnqueueMessage(MessageUPtr && message, TimeSpan expiration
     }
 
     size_t bufferedBytesAfter = totalBufferedBytes_ + bytesToAdd;
-    if ((bufferedBytesAfter > limitInBytes_) &&
+    if (checkLimit &&
+        (bufferedBytesAfter > limitInBytes_) &&
         //when frame size limit is disabled, ignore queue limit on empty queue to allow one large message
         (!connection_->OutgoingFrameSizeLimitDisabled() ||
         totalBufferedBytes_))
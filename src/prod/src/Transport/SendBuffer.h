@@ -19,7 +19,8 @@ namespace Transport
 
         virtual bool Empty() const = 0;
         virtual size_t MessageCount() const = 0;
-        Common::ErrorCode EnqueueMessage(MessageUPtr && message, Common::TimeSpan expiration, bool shouldEncrypt);
+        // checkLimit is false for messages already admitted against send queue limit by TcpConnection send intake
+        Common::ErrorCode EnqueueMessage(MessageUPtr && message, Common::TimeSpan expiration, bool shouldEncrypt, bool checkLimit = true);
 
         Buffers const & PreparedBuffers() const;
         virtual Common::ErrorCode Prepare() = 0;
@@ -34,9 +35,18 @@ namespace Transport
         uint TotalPreparedBytes() const;
         uint FirstBufferToSend() const; //only need for Linux
         bool ConsumePreparedBuffers(ssize_t sent);
+
+        // Count of prepared buffers starting at first that are all sent with or all without zero-copy
+        uint PreparedBufferRun(uint first, bool & zeroCopy) const;
+        uint ZeroCopySendThreshold() const { return zeroCopySendThreshold_; }
+        void SetZeroCopySendThreshold(uint value) { zeroCopySendThreshold_ = value; }
 #endif
         void SetLimit(ULONG limitInBytes);
         ULONG BytesPendingForSend() const;
+        uint64 Limit() const { return limitInBytes_; }
+
+        // Bytes counted against limit, including messages delayed by security negotiation
+        uint64 QueuedBytes() const { return (uint64)totalBufferedBytes_ + totalDelayedBytes_; }
         
         virtual bool PurgeExpiredMessages(Common::StopwatchTime now) = 0;
 
@@ -52,6 +62,9 @@ namespace Transport
         void SetFrameHeaderErrorChecking(bool value) { frameHeaderErrorCheckingEnabled_ = value; }
         void SetMessageErrorChecking(bool value) { messageErrorCheckingEnabled_ = value; }
 
+        FrameCompression::Enum Compression() const { return compression_; }
+        void SetCompression(FrameCompression::Enum value) { compression_ = value; }
+
         virtual void Abort() = 0;
 
     protected:
@@ -69,7 +82,12 @@ namespace Transport
         size_t sendingLength_ = 0;
         Buffers preparedBuffers_;
 #ifdef PLATFORM_UNIX
+        bool IsZeroCopyBuffer(uint index) const { return (index < zeroCopyBuffers_.size()) && zeroCopyBuffers_[index]; }
+        void MarkLastPreparedBufferZeroCopy();
+
         uint firstBufferToSend_ = 0; // index of first buffer to send
+        std::vector<bool> zeroCopyBuffers_; // flags of prepared buffers, buffers beyond the end are not zero-copy
+        uint zeroCopySendThreshold_ = 0; // 0 when zero-copy send is not enabled on the connection
 #endif
         uint64 limitInBytes_ = 0;
         byte securityProviderMask_ = SecurityProvider::None;
@@ -81,6 +99,8 @@ namespace Transport
         bool firstEnqueueCall_ = false;
         bool frameHeaderErrorCheckingEnabled_ = false;
         bool messageErrorCheckingEnabled_ = false;
+        FrameCompression::Enum compression_ = FrameCompression::None;
+        uint compressionBypassRemaining_ = 0;
         const uint sendBatchLimitInBytes_;
         int64 totalBufferedBytes_ = 0;
         uint64 messageSentCount_ = 0;
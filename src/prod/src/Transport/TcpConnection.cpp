@@ -214,6 +214,7 @@ bool TcpConnection::Initialize(
 
     sendBuffer_ = transport->BufferFactory().CreateSendBuffer(this);
     sendBuffer_->SetLimit(transport->PerTargetSendQueueLimit());
+    sendQueueLimit_.store(sendBuffer_->Limit());
     sendBuffer_->SetPerfCounters(transport->PerfCounters());
     sendBuffer_->SetFrameHeaderErrorChecking(transport->FrameHeaderErrorCheckingEnabled());
     sendBuffer_->SetMessageErrorChecking(transport->MessageErrorCheckingEnabled());
@@ -223,6 +224,8 @@ bool TcpConnection::Initialize(
         transport->FrameHeaderErrorCheckingEnabled(), transport->MessageErrorCheckingEnabled());
 
     receiveBuffer_ = transport->BufferFactory().CreateReceiveBuffer(this);
+    frameCompressionEnabled_ = TransportConfig::GetConfig().FrameCompressionEnabled && receiveBuffer_->SupportsFrameCompression();
+    sendIntakeEnabled_ = TransportConfig::GetConfig().LockFreeSendQueueEnabled;
     receiveBufferToReserve_ = (receiveChunkSize_ > transport->RecvBufferSize()) ? receiveChunkSize_ : transport->RecvBufferSize();
 
     hostnameResolveOption_ = transport->HostnameResolveOption();
@@ -358,6 +361,10 @@ bool TcpConnection::FinishSocketInit()
     }
 #endif
 
+#ifdef PLATFORM_UNIX
+    EnableZeroCopySendIfNeeded();
+#endif
+
     // Enable keep alive so that non-responsive remote side can be detected
     TcpConnection::EnableKeepAliveIfNeeded(socket_, keepAliveTimeout_);
 
@@ -425,6 +432,21 @@ void TcpConnection::OnRemoteFrameSizeLimit(size_t remoteIncomingMax)
     }
 }
 
+void TcpConnection::OnRemoteFrameCompression(FrameCompression::Enum remoteSupported)
+{
+    AcquireWriteLock grab(lock_);
+
+    auto compression = (frameCompressionEnabled_ && (remoteSupported == FrameCompression::Lz4))? FrameCompression::Lz4 : FrameCompression::None;
+    WriteInfo(
+        TraceType, traceId_,
+        "OnRemoteFrameCompression: remote={0}, local enabled={1}, outgoing compression={2}",
+        remoteSupported,
+        frameCompressionEnabled_,
+        compression);
+
+    sendBuffer_->SetCompression(compression);
+}
+
 void TcpConnection::DisableOutgoingFrameSizeLimit()
 {
     //TcpFrameHeader::FrameSizeHardLimit() means limit is disabled,
@@ -473,6 +495,7 @@ void TcpConnection::SetRecvLimit(ULONG messageSizeLimit)
 void TcpConnection::SetSendLimits(ULONG messageSizeLimit, ULONG sendQueueLimit)
 {
     sendBuffer_->SetLimit(sendQueueLimit);
+    sendQueueLimit_.store(sendBuffer_->Limit());
 
     if (OutgoingFrameSizeLimitDisabled()) return;
 
@@ -483,6 +506,7 @@ void TcpConnection::PurgeExpiredOutgoingMessages(StopwatchTime now)
 {
     AcquireWriteLock grab(lock_);
     sendBuffer_->PurgeExpiredMessages(now);
+    UpdateSendQueueBytes_CallerHoldingLock();
 }
 
 ISendTarget::SPtr TcpConnection::SetTarget(ISendTarget::SPtr const & target)
@@ -562,7 +586,7 @@ ErrorCode TcpConnection::SendOneWay(MessageUPtr && message, TimeSpan expiration)
         return ErrorCode::FromNtStatus(status);
     }
 
-    return Send(move(message), expiration, securityContext_ != nullptr);
+    return EnqueueSend(move(message), expiration, securityContext_ != nullptr);
 }
 
 bool TcpConnection::Open()
@@ -1405,6 +1429,11 @@ void TcpConnection::EnqueueListenInstanceMessage(TcpDatagramTransportSPtr const
     listenInstanceMessage->Headers.Add(MessageIdHeader());
     listenInstanceMessage->Headers.Add(ActorHeader(Actor::Transport));
     listenInstanceMessage->Headers.Add(HighPriorityHeader()); // Should not throttle on this message
+    if (frameCompressionEnabled_)
+    {
+        // advertise that we can decompress, remote side will start compressing after receiving this
+        listenInstanceMessage->Headers.Add(FrameCompressionHeader(FrameCompression::Lz4, 0));
+    }
 
     sendBuffer_->EnqueueMessage(move(listenInstanceMessage), TimeSpan::MaxValue, securityContext_ != nullptr);
 }
@@ -1644,115 +1673,258 @@ void TcpConnection::ConnectComplete(ErrorCode const & error)
     SubmitConnect();
 }
 
-ErrorCode TcpConnection::Send(MessageUPtr && message, TimeSpan expiration, bool shouldEncrypt, TcpConnectionState::Enum newState)
+ErrorCode TcpConnection::EnqueueSend(MessageUPtr && message, TimeSpan expiration, bool shouldEncrypt)
 {
-    ErrorCode errorCode;
-    bool shouldConnect = false;
-    bool shouldSend = false;
+    if (!sendIntakeEnabled_)
     {
-        AcquireWriteLock grab(lock_);
+        return Send(move(message), expiration, shouldEncrypt);
+    }
+
+    if (!sendIntakeDraining_.exchange(true))
+    {
+        if (sendIntake_.Empty())
+        {
+            // Uncontended, send directly so that enqueue failures are returned to the caller
+            auto error = Send(move(message), expiration, shouldEncrypt);
+            DrainSendIntake();
+            return error;
+        }
+
+        // Earlier messages are still in intake queue, go through it to preserve per sender ordering
+        auto error = PushSendIntake(move(message), expiration, shouldEncrypt);
+        DrainSendIntake();
+        return error;
+    }
+
+    // Another thread is draining, hand the message over without taking lock_
+    auto error = PushSendIntake(move(message), expiration, shouldEncrypt);
+
+    // The draining thread may have released the flag before our push became visible
+    if (error.IsSuccess() && !sendIntakeDraining_.exchange(true))
+    {
+        DrainSendIntake();
+    }
 
-        bool canSendQueuedAtCloseDraining = CanSendMessagesAlreadyQueued() && !message;
-        bool canSendPendingAtCloseDraining = CanSendMessagesAlreadyQueued() && (pendingSend_.load() > 0);
-        bool canSend = CanSend() || canSendQueuedAtCloseDraining || canSendPendingAtCloseDraining;
+    return error;
+}
 
-        if (!canSend)
+ErrorCode TcpConnection::PushSendIntake(MessageUPtr && message, TimeSpan expiration, bool shouldEncrypt)
+{
+    // Send queue limit is checked here against bytes published under lock_ plus bytes already in
+    // intake, so that send queue full is returned to the sender as it is on the locked path
+    size_t bytes = message->SerializedSize() + sizeof(TcpFrameHeader);
+    auto intakeBytes = sendIntakeBytes_.fetch_add(bytes) + bytes;
+    auto queuedBytes = sendBufferBytes_.load() + intakeBytes;
+    auto limit = sendQueueLimit_.load();
+
+    //when frame size limit is disabled, ignore queue limit on empty queue to allow one large message
+    if ((queuedBytes > limit) && (!OutgoingFrameSizeLimitDisabled() || (queuedBytes != bytes)))
+    {
+        sendIntakeBytes_ -= bytes;
+
+        WriteInfo(
+            TraceType, traceId_,
+            "{0}-{1} send queue full on intake: queued = {2}, limit = {3}, message {4}, size = {5}, actor = {6}, action = '{7}'",
+            localAddress_, targetAddress_, queuedBytes - bytes, limit,
+            message->TraceId(), message->SerializedSize(), message->Actor, message->Action);
+
+        message->OnSendStatus(ErrorCodeValue::TransportSendQueueFull, move(message));
+        return ErrorCodeValue::TransportSendQueueFull;
+    }
+
+    message->sendIntakeExpiration_ = expiration;
+    message->sendIntakeBytes_ = bytes;
+    message->sendIntakeShouldEncrypt_ = shouldEncrypt;
+    ++pendingSend_;
+    sendIntake_.Push(move(message));
+    return ErrorCode();
+}
+
+void TcpConnection::UpdateSendQueueBytes_CallerHoldingLock()
+{
+    if (sendIntakeEnabled_)
+    {
+        sendBufferBytes_.store(sendBuffer_->QueuedBytes());
+    }
+}
+
+void TcpConnection::DrainSendIntake()
+{
+    // Caller must hold sendIntakeDraining_
+    for (;;)
+    {
+        if (!sendIntake_.Empty())
         {
-            if (fault_.IsSuccess())
-            {
-                errorCode = ErrorCodeValue::OperationCanceled;
-            }
-            else
+            bool shouldConnect = false;
+            bool shouldSend = false;
             {
-                errorCode = fault_;
-            }
+                AcquireWriteLock grab(lock_);
 
-            if (message)
-            {
-                trace.Msg_InvalidStateForSend(
-                    traceId_,
-                    localAddress_,
-                    targetAddress_,
-                    state_,
-                    fault_,
-                    message->TraceId(),
-                    message->Actor,
-                    message->Action);
+                sendIntake_.Drain([this](MessageUPtr && message)
+                {
+                    // Admitted against send queue limit by PushSendIntake, sendBuffer_ counts it from now on
+                    sendIntakeBytes_ -= message->sendIntakeBytes_;
+                    auto expiration = message->sendIntakeExpiration_;
+                    auto shouldEncrypt = message->sendIntakeShouldEncrypt_;
+                    Enqueue_CallerHoldingLock(move(message), expiration, shouldEncrypt, TcpConnectionState::None, false);
+                    --pendingSend_;
+                });
 
-                message->OnSendStatus(errorCode, move(message));
-            }
-            else
-            {
-                trace.Null_InvalidStateForSend(
-                    traceId_,
-                    localAddress_,
-                    targetAddress_,
-                    state_,
-                    fault_);
+                UpdateSendQueueBytes_CallerHoldingLock();
+
+                auto error = StartSend_CallerHoldingLock(shouldConnect, shouldSend);
+                if (!error.IsSuccess())
+                {
+                    WriteWarning(
+                        TraceType, traceId_,
+                        "{0}-{1} DrainSendIntake: failed to start send: {2}",
+                        localAddress_, targetAddress_, error);
+                }
             }
 
-            return errorCode;
+            StartSend(shouldConnect, shouldSend);
         }
 
-        if (newState != TcpConnectionState::None)
+        sendIntakeDraining_.store(false);
+
+        // Recheck after releasing the flag, a producer may have pushed and failed to acquire the flag
+        if (sendIntake_.Empty() || sendIntakeDraining_.exchange(true))
         {
-            TransitToState_CallerHoldingLock(newState);
+            return;
         }
+    }
+}
 
-        if (message)
+ErrorCode TcpConnection::Send(MessageUPtr && message, TimeSpan expiration, bool shouldEncrypt, TcpConnectionState::Enum newState)
+{
+    bool shouldConnect = false;
+    bool shouldSend = false;
+    {
+        AcquireWriteLock grab(lock_);
+
+        auto errorCode = Enqueue_CallerHoldingLock(move(message), expiration, shouldEncrypt, newState);
+        UpdateSendQueueBytes_CallerHoldingLock();
+        if (!errorCode.IsSuccess())
         {
-            errorCode = sendBuffer_->EnqueueMessage(std::move(message), expiration, shouldEncrypt);
-            if (!errorCode.IsSuccess())
-            {
-                return errorCode;
-            }
+            return errorCode;
         }
 
-        if (sendActive_ || sendBuffer_->Empty())
+        errorCode = StartSend_CallerHoldingLock(shouldConnect, shouldSend);
+        if (!errorCode.IsSuccess())
         {
             return errorCode;
         }
+    }
+
+    StartSend(shouldConnect, shouldSend);
+    return ErrorCode();
+}
+
+ErrorCode TcpConnection::Enqueue_CallerHoldingLock(MessageUPtr && message, TimeSpan expiration, bool shouldEncrypt, TcpConnectionState::Enum newState, bool checkLimit)
+{
+    ErrorCode errorCode;
 
-        if (state_ == TcpConnectionState::Created)
+    bool canSendQueuedAtCloseDraining = CanSendMessagesAlreadyQueued() && !message;
+    bool canSendPendingAtCloseDraining = CanSendMessagesAlreadyQueued() && (pendingSend_.load() > 0);
+    bool canSend = CanSend() || canSendQueuedAtCloseDraining || canSendPendingAtCloseDraining;
+
+    if (!canSend)
+    {
+        if (fault_.IsSuccess())
         {
-            TransitToState_CallerHoldingLock(TcpConnectionState::Connecting);
-            shouldConnect = true;
+            errorCode = ErrorCodeValue::OperationCanceled;
         }
-        else if ((state_ == TcpConnectionState::Connected) || (state_ == TcpConnectionState::CloseDraining))
+        else
         {
-            auto error = sendBuffer_->Prepare();
-            if (!error.IsSuccess())
-            {
-                  return error;
-            }
+            errorCode = fault_;
+        }
+
+        if (message)
+        {
+            trace.Msg_InvalidStateForSend(
+                traceId_,
+                localAddress_,
+                targetAddress_,
+                state_,
+                fault_,
+                message->TraceId(),
+                message->Actor,
+                message->Action);
 
-            shouldSend = true;
-            sendActive_ = true;
+            message->OnSendStatus(errorCode, move(message));
         }
         else
         {
-            WriteNoise(
-                TraceType, traceId_,
-                "{0}-{1} Send: no action at state {2}",
-                localAddress_, targetAddress_, state_);
+            trace.Null_InvalidStateForSend(
+                traceId_,
+                localAddress_,
+                targetAddress_,
+                state_,
+                fault_);
+        }
 
-            return errorCode;
+        return errorCode;
+    }
+
+    if (newState != TcpConnectionState::None)
+    {
+        TransitToState_CallerHoldingLock(newState);
+    }
+
+    if (message)
+    {
+        errorCode = sendBuffer_->EnqueueMessage(std::move(message), expiration, shouldEncrypt, checkLimit);
+    }
+
+    return errorCode;
+}
+
+ErrorCode TcpConnection::StartSend_CallerHoldingLock(bool & shouldConnect, bool & shouldSend)
+{
+    if (sendActive_ || sendBuffer_->Empty())
+    {
+        return ErrorCode();
+    }
+
+    if (state_ == TcpConnectionState::Created)
+    {
+        TransitToState_CallerHoldingLock(TcpConnectionState::Connecting);
+        shouldConnect = true;
+    }
+    else if ((state_ == TcpConnectionState::Connected) || (state_ == TcpConnectionState::CloseDraining))
+    {
+        auto error = sendBuffer_->Prepare();
+        if (!error.IsSuccess())
+        {
+              return error;
         }
 
+        shouldSend = true;
+        sendActive_ = true;
+    }
+    else
+    {
+        WriteNoise(
+            TraceType, traceId_,
+            "{0}-{1} Send: no action at state {2}",
+            localAddress_, targetAddress_, state_);
     }
 
+    return ErrorCode();
+}
+
+void TcpConnection::StartSend(bool shouldConnect, bool shouldSend)
+{
     if (shouldConnect)
     {
         Connect();
-        return errorCode;
+        return;
     }
 
     if (shouldSend)
     {
         SubmitSend();
     }
-
-    return errorCode;
 }
 
 void TcpConnection::SendComplete(ErrorCode const & error, ULONG_PTR bytesTransferred)
@@ -1787,6 +1959,7 @@ void TcpConnection::SendComplete(ErrorCode const & error, ULONG_PTR bytesTransfe
         pendingSendStartTime_ = StopwatchTime::MaxValue;
         trace.SendCompleted(traceId_, bytesTransferred, sendBuffer_->SentByteTotal());
         sendBuffer_->Consume(bytesTransferred);
+        UpdateSendQueueBytes_CallerHoldingLock();
         sendActive_ = false;
 
         if (state_ == TcpConnectionState::Closed)
@@ -2322,7 +2495,8 @@ void TcpConnection::RegisterEvtLoopIn()
         socket_.GetHandle(),
         EPOLLIN,
         eventLoopDispatchReadAsync_,
-        [this] (int sd, uint evts) { ReadEvtCallback(sd, evts); });
+        [this] (int sd, uint evts) { ReadEvtCallback(sd, evts); },
+        [this] (int sd, int result) { ReadCompleteCallback(sd, result); });
 }
 
 void TcpConnection::RegisterEvtLoopOut()
@@ -2331,7 +2505,9 @@ void TcpConnection::RegisterEvtLoopOut()
         socket_.GetHandle(),
         EPOLLOUT,
         eventLoopDispatchWriteAsync_,
-        [this] (int sd, uint evts) { WriteEvtCallback(sd, evts); });
+        [this] (int sd, uint evts) { WriteEvtCallback(sd, evts); },
+        nullptr,
+        [this] (int sd, int result) { WriteCompleteCallback(sd, result); });
 }
 
 void TcpConnection::UnregisterEvtLoopIn(bool waitForCallback)
@@ -2350,6 +2526,49 @@ void TcpConnection::UnregisterEvtLoopOut(bool waitForCallback)
     fdCtxOut_ = nullptr;
 }
 
+void TcpConnection::EnableZeroCopySendIfNeeded()
+{
+    auto threshold = TransportConfig::GetConfig().ZeroCopySendThreshold;
+    if (threshold == 0)
+    {
+        return;
+    }
+
+    if (evtLoopOut_->SupportsAsyncIo())
+    {
+        // writev is submitted to io_uring, zero-copy is only supported on epoll send path
+        WriteInfo(TraceType, traceId_, "zero-copy send is not supported with io_uring event loop");
+        return;
+    }
+
+    zeroCopySend_ = ZeroCopySendTracker::Create(socket_.GetHandle(), traceId_);
+    if (zeroCopySend_)
+    {
+        sendBuffer_->SetZeroCopySendThreshold(threshold);
+        WriteInfo(TraceType, traceId_, "zero-copy send enabled for message body of at least {0} bytes", threshold);
+    }
+}
+
+bool TcpConnection::ProcessZeroCopyCompletions(int sd)
+{
+    // Read and write event loops may both report EPOLLERR for the same completions, draining the error queue
+    // until EAGAIN finds nothing then, which is fine. A real socket error without an error queue entry will
+    // be reported again once fd is activated.
+    AcquireWriteLock grab(lock_);
+
+    if (!zeroCopySend_) return false;
+
+    auto onlyCompletions = zeroCopySend_->ProcessCompletions(sd);
+    if (zeroCopySend_->KernelCopied() && (sendBuffer_->ZeroCopySendThreshold() > 0))
+    {
+        // e.g. loopback connection, pinning pages and processing completions are pure overhead
+        WriteInfo(TraceType, traceId_, "disable zero-copy send as kernel copies data");
+        sendBuffer_->SetZeroCopySendThreshold(0);
+    }
+
+    return onlyCompletions;
+}
+
 int TcpConnection::get_iov_count(size_t bufferCount)
 {
     if (bufferCount > IOV_MAX)
@@ -2366,6 +2585,17 @@ void TcpConnection::ReadEvtCallback(int sd, uint events)
     WriteNoise(TraceType, traceId_, "ReadEvtCallback: sd = {0:x}, events = {1:x}", sd, events);
     if(SocketErrorReported(sd, events)) return;
 
+    if ((events & (EPOLLIN | EPOLLHUP)) == 0)
+    {
+        // only zero-copy send completions were reported, keep waiting for incoming data
+        if (!evtLoopIn_->Activate(fdCtxIn_).IsSuccess())
+        {
+            AbortWithRetryableError();
+        }
+
+        return;
+    }
+
     auto const & buffers = receiveBuffer_->GetBuffers(receiveBufferToReserve_);
     for(;;)
     {
@@ -2380,7 +2610,7 @@ void TcpConnection::ReadEvtCallback(int sd, uint events)
 
 void TcpConnection::OnSocketWriteEvt()
 {
-    int sent = 0;
+    ssize_t sent = 0;
     bool sendCompleted = false;
     uint totalPreparedBytes = 0;
     int writevErrno = 0;
@@ -2394,32 +2624,48 @@ void TcpConnection::OnSocketWriteEvt()
         if (totalPreparedBytes > 0)
         {
             auto const & buffers = sendBuffer_->PreparedBuffers();
-            auto bufferIndex = sendBuffer_->FirstBufferToSend();
-            bufferCount = get_iov_count(buffers.size() - bufferIndex);
-
-//#ifdef DBG
-//            WriteNoise(TraceType, traceId_, "OnSocketWriteEvt: bufferIndex = {0}, bufferCount = {1}", bufferIndex, bufferCount);
-//            for (uint i = bufferIndex; i < bufferIndex + bufferCount; ++i)
-//            {
-//                WriteNoise(TraceType, traceId_, "OnSocketWriteEvt: buffer[{0}] has {1} bytes", i, buffers[i].iov_len);
-//            }
-//#endif 
-
-            do
-            {
-                sent = writev(socket_.GetHandle(), &(buffers[bufferIndex]), bufferCount);
-            }
-            while((sent < 0) && (errno == EINTR));
 
-            if (sent < 0)
+            // Zero-copy buffers, i.e. large message bodies, are sent by separate sendmsg(MSG_ZEROCOPY) calls,
+            // the rest is copied with writev. Without zero-copy send, there is only one run of buffers.
+            for (;;)
             {
-                writevErrno = errno;
-                Invariant(writevErrno);
-            }
+                auto bufferIndex = sendBuffer_->FirstBufferToSend();
+                bool zeroCopy = false;
+                auto runCount = get_iov_count(sendBuffer_->PreparedBufferRun(bufferIndex, zeroCopy));
+                size_t runBytes = 0;
+                for (int i = 0; i < runCount; ++i)
+                {
+                    runBytes += buffers[bufferIndex + i].size();
+                }
 
-            if (sent > 0)
-            {
-                sendCompleted = sendBuffer_->ConsumePreparedBuffers(sent);
+                ssize_t result = 0;
+                do
+                {
+                    result = zeroCopy ?
+                        zeroCopySend_->Send(socket_.GetHandle(), &(buffers[bufferIndex]), runCount) :
+                        writev(socket_.GetHandle(), &(buffers[bufferIndex]), runCount);
+                }
+                while((result < 0) && (errno == EINTR));
+
+                bufferCount += runCount;
+
+                if (result < 0)
+                {
+                    if ((errno == EAGAIN) && (sent > 0)) break; // socket send buffer is full after previous runs
+
+                    writevErrno = errno;
+                    Invariant(writevErrno);
+                    sent = result;
+                    break;
+                }
+
+                sent += result;
+                if (result > 0)
+                {
+                    sendCompleted = sendBuffer_->ConsumePreparedBuffers(result);
+                }
+
+                if (sendCompleted || ((size_t)result < runBytes)) break;
             }
         }
         else
@@ -2465,10 +2711,87 @@ void TcpConnection::OnSocketWriteEvt()
     }
 }
 
+void TcpConnection::ReadCompleteCallback(int sd, int result)
+{
+    WriteNoise(TraceType, traceId_, "ReadCompleteCallback: sd = {0:x}, result = {1}", sd, result);
+
+    // EAGAIN on the non-blocking socket is retried by the event loop, negative results here are real failures
+    ErrorCode error = (result < 0)? ErrorCode::FromErrno(-result) : ErrorCode();
+    ReceiveComplete(error, (result < 0)? 0 : result);
+}
+
+ErrorCode TcpConnection::SubmitWritev_CallerHoldingLock()
+{
+    auto const & buffers = sendBuffer_->PreparedBuffers();
+    auto bufferIndex = sendBuffer_->FirstBufferToSend();
+    auto bufferCount = get_iov_count(buffers.size() - bufferIndex);
+
+    // prepared buffers are not touched until this writev completes, as sendActive_ is set
+    return evtLoopOut_->SubmitWritev(fdCtxOut_, &(buffers[bufferIndex]), bufferCount);
+}
+
+void TcpConnection::WriteCompleteCallback(int sd, int result)
+{
+    WriteNoise(TraceType, traceId_, "WriteCompleteCallback: sd = {0:x}, result = {1}", sd, result);
+
+    bool sendCompleted = false;
+    uint totalPreparedBytes = 0;
+    ErrorCode error;
+    {
+        AcquireWriteLock grab(lock_);
+
+        if (state_ > TcpConnectionState::CloseDraining) return;
+
+        totalPreparedBytes = sendBuffer_->TotalPreparedBytes();
+        if (result > 0)
+        {
+            sendCompleted = sendBuffer_->ConsumePreparedBuffers(result);
+            if (!sendCompleted)
+            {
+                // partial write, continue with the rest
+                error = SubmitWritev_CallerHoldingLock();
+            }
+        }
+    }
+
+    // SendComplete must be called outside lock_ scope to avoid deadlock
+
+    if (result < 0)
+    {
+        WriteInfo(TraceType, traceId_, "writev completed with errno = {0}", -result);
+        SendComplete(ErrorCode::FromErrno(-result), 0);
+        return;
+    }
+
+    if (result == 0)
+    {
+        // writev never returns 0 for a non-empty buffer on a healthy stream socket,
+        // resubmitting would spin on the event loop thread forever
+        WriteInfo(TraceType, traceId_, "writev completed with 0 of {0} bytes written", totalPreparedBytes);
+        SendComplete(ErrorCodeValue::OperationFailed, 0);
+        return;
+    }
+
+    if (sendCompleted)
+    {
+        SendComplete(ErrorCode(), totalPreparedBytes);
+        return;
+    }
+
+    if (!error.IsSuccess())
+    {
+        AbortWithRetryableError();
+    }
+}
+
 bool TcpConnection::SocketErrorReported(int sd, uint events)
 {
     if ((events & EPOLLERR) == 0) return false;
 
+    // EPOLLERR is also reported when socket error queue has zero-copy send completions, a real
+    // socket error left after draining the queue will be reported again once fd is activated
+    if (((events & EPOLLHUP) == 0) && ProcessZeroCopyCompletions(sd)) return false;
+
     WriteInfo(TraceType, traceId_, "socket error reported");
     int sockError;
     socklen_t sockErrorSize = sizeof(sockError);
@@ -2513,6 +2836,17 @@ void TcpConnection::WriteEvtCallback(int sd, uint events)
         return;
     }
 
+    if ((events & (EPOLLOUT | EPOLLHUP)) == 0)
+    {
+        // only zero-copy send completions were reported, keep waiting for socket to be writable
+        if (!evtLoopOut_->Activate(fdCtxOut_).IsSuccess())
+        {
+            AbortWithRetryableError();
+        }
+
+        return;
+    }
+
     OnSocketWriteEvt();
 }
 
@@ -2587,7 +2921,16 @@ void TcpConnection::SubmitReceive()
         receivePending_ = true;
         lastRecvCompeteTime_ = Stopwatch::Now();
         trace.BeginReceive(traceId_);
-        error = evtLoopIn_->Activate(fdCtxIn_);
+
+        if (evtLoopIn_->SupportsAsyncIo())
+        {
+            auto const & buffers = receiveBuffer_->GetBuffers(receiveBufferToReserve_);
+            error = evtLoopIn_->SubmitReadv(fdCtxIn_, buffers.data(), get_iov_count(buffers.size()));
+        }
+        else
+        {
+            error = evtLoopIn_->Activate(fdCtxIn_);
+        }
     }
 
     if (!error.IsSuccess())
@@ -2610,7 +2953,7 @@ void TcpConnection::SubmitSend()
 
         pendingSendStartTime_ = Stopwatch::Now();
         trace.BeginSend(traceId_);
-        error = evtLoopOut_->Activate(fdCtxOut_);
+        error = evtLoopOut_->SupportsAsyncIo() ? SubmitWritev_CallerHoldingLock() : evtLoopOut_->Activate(fdCtxOut_);
     }
 
     if (!error.IsSuccess())
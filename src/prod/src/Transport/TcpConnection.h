@@ -106,6 +106,7 @@ namespace Transport
         size_t IncomingFrameSizeLimit() const override { return maxIncomingFrameSizeInBytes_; }
         size_t OutgoingFrameSizeLimit() const override { return maxOutgoingFrameSizeInBytes_; }
         void OnRemoteFrameSizeLimit(size_t remoteIncomingMax) override;
+        void OnRemoteFrameCompression(FrameCompression::Enum remoteSupported) override;
 
         void PurgeExpiredOutgoingMessages(Common::StopwatchTime now) override;
 
@@ -164,6 +165,18 @@ namespace Transport
             Common::TimeSpan expiration,
             bool shouldEncrypt,
             TcpConnectionState::Enum newState = TcpConnectionState::None);
+        Common::ErrorCode EnqueueSend(MessageUPtr && message, Common::TimeSpan expiration, bool shouldEncrypt);
+        void DrainSendIntake();
+        Common::ErrorCode PushSendIntake(MessageUPtr && message, Common::TimeSpan expiration, bool shouldEncrypt);
+        void UpdateSendQueueBytes_CallerHoldingLock();
+        Common::ErrorCode Enqueue_CallerHoldingLock(
+            MessageUPtr && message,
+            Common::TimeSpan expiration,
+            bool shouldEncrypt,
+            TcpConnectionState::Enum newState,
+            bool checkLimit = true);
+        Common::ErrorCode StartSend_CallerHoldingLock(bool & shouldConnect, bool & shouldSend);
+        void StartSend(bool shouldConnect, bool shouldSend);
 
         bool CanReceive() const;
         void SubmitReceive();
@@ -236,6 +249,7 @@ namespace Transport
         bool testAssertEnabled_;
         bool shouldTracePerMessage_ = true;
         bool outgoingFrameSizeLimitUpdatedForRemote_ = false;
+        bool frameCompressionEnabled_ = false;
 #ifdef PLATFORM_UNIX
         bool eventLoopDispatchReadAsync_ = true;
         bool eventLoopDispatchWriteAsync_ = false;
@@ -269,6 +283,19 @@ namespace Transport
 
         Common::atomic_long pendingSend_{0};
 
+        // Messages from SendOneWay that are waiting to be moved into sendBuffer_. Only the thread
+        // that sets sendIntakeDraining_ moves them, other senders return without taking lock_.
+        Common::IntrusiveMpscQueue<Message, &Message::sendIntakeNext_> sendIntake_;
+        std::atomic_bool sendIntakeDraining_{false};
+
+        // Contending senders check send queue limit against these instead of sendBuffer_, so that
+        // send queue full is still returned to them. sendBufferBytes_ and sendQueueLimit_ mirror
+        // sendBuffer_ and are updated under lock_, sendIntakeBytes_ counts bytes in sendIntake_.
+        std::atomic<uint64> sendBufferBytes_{0};
+        std::atomic<uint64> sendIntakeBytes_{0};
+        std::atomic<uint64> sendQueueLimit_{0};
+        bool sendIntakeEnabled_ = false;
+
 #ifdef PLATFORM_UNIX
         void RegisterEvtLoopIn();
         void RegisterEvtLoopOut();
@@ -276,7 +303,12 @@ namespace Transport
         void UnregisterEvtLoopOut(bool waitForCallback);
         void ReadEvtCallback(int sd, uint events);
         void WriteEvtCallback(int sd, uint events);
+        void ReadCompleteCallback(int sd, int result);
+        void WriteCompleteCallback(int sd, int result);
+        Common::ErrorCode SubmitWritev_CallerHoldingLock();
         bool SocketErrorReported(int sd, uint events);
+        bool ProcessZeroCopyCompletions(int sd);
+        void EnableZeroCopySendIfNeeded();
         void OnSocketWriteEvt();
         int get_iov_count(size_t bufferCount);
 
@@ -284,6 +316,7 @@ namespace Transport
         Common::EventLoop* evtLoopOut_ = nullptr;
         Common::EventLoop::FdContext* fdCtxIn_ = nullptr;
         Common::EventLoop::FdContext* fdCtxOut_ = nullptr;
+        std::unique_ptr<ZeroCopySendTracker> zeroCopySend_;
 #else
         void CleanupThreadPoolIo();
 
@@ -2176,6 +2176,315 @@ namespace Transport
         LEAVE;
     }
 
+    BOOST_AUTO_TEST_CASE(FrameCompressionTest)
+    {
+        ENTER;
+
+        auto saved = TransportConfig::GetConfig().FrameCompressionEnabled;
+        TransportConfig::GetConfig().FrameCompressionEnabled = true;
+        KFinally([=] { TransportConfig::GetConfig().FrameCompressionEnabled = saved; });
+
+        auto sender = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+        auto receiver = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+
+        // mix of bodies below and above compression threshold
+        vector<size_t> bodySizes = { 16, 64 * 1024, 1024 * 1024, 100, 8 * 1024 * 1024 };
+        LONG const TotalMessageCount = (LONG)bodySizes.size();
+        LONG messageCount = 0;
+        atomic_uint64 verifyFailureCount(0);
+        AutoResetEvent messagesReceived;
+
+        wstring testAction = TTestUtil::GetGuidAction();
+        TTestUtil::SetMessageHandler(
+            receiver,
+            testAction,
+            [&](MessageUPtr & message, ISendTarget::SPtr const &) -> void
+            {
+                TestMessageBody body;
+                if (!message->GetBody(body) || !body.Verify())
+                {
+                    ++verifyFailureCount;
+                }
+
+                Trace.WriteInfo(TraceType, "[receiver] got message {0}, body size = {1}", message->TraceId(), body.size());
+                if (InterlockedIncrement((volatile LONG *)&messageCount) == TotalMessageCount)
+                {
+                    messagesReceived.Set();
+                }
+            });
+
+        VERIFY_IS_TRUE(receiver->Start().IsSuccess());
+        VERIFY_IS_TRUE(sender->Start().IsSuccess());
+
+        ISendTarget::SPtr target = sender->ResolveTarget(receiver->ListenAddress());
+        VERIFY_IS_TRUE(target);
+
+        for (auto bodySize : bodySizes)
+        {
+            auto msg = make_unique<Message>(TestMessageBody(bodySize));
+            msg->Headers.Add(ActionHeader(testAction));
+            msg->Headers.Add(MessageIdHeader());
+            sender->SendOneWay(target, std::move(msg));
+        }
+
+        VERIFY_IS_TRUE(messagesReceived.WaitOne(TimeSpan::FromSeconds(30)));
+        VERIFY_ARE_EQUAL(0u, verifyFailureCount.load());
+
+        sender->Stop();
+        receiver->Stop();
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(ZeroCopySendTest)
+    {
+        ENTER;
+
+        auto saved = TransportConfig::GetConfig().ZeroCopySendThreshold;
+        TransportConfig::GetConfig().ZeroCopySendThreshold = 16 * 1024;
+        KFinally([=] { TransportConfig::GetConfig().ZeroCopySendThreshold = saved; });
+
+        auto sender = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+        auto receiver = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+
+        // mix of bodies below and above zero-copy threshold, send status is only
+        // reported after the kernel no longer needs message body of zero-copy sends
+        vector<size_t> bodySizes = { 16, 64 * 1024, 1024, 4 * 1024 * 1024, 100, 16 * 1024, 8 * 1024 * 1024 };
+        LONG const TotalMessageCount = (LONG)bodySizes.size();
+        atomic_long messageCount(0);
+        atomic_long sendStatusCount(0);
+        atomic_uint64 failureCount(0);
+        ManualResetEvent messagesReceived(false);
+        ManualResetEvent sendStatusReported(false);
+
+        wstring testAction = TTestUtil::GetGuidAction();
+        TTestUtil::SetMessageHandler(
+            receiver,
+            testAction,
+            [&](MessageUPtr & message, ISendTarget::SPtr const &) -> void
+            {
+                TestMessageBody body;
+                if (!message->GetBody(body) || !body.Verify())
+                {
+                    ++failureCount;
+                }
+
+                Trace.WriteInfo(TraceType, "[receiver] got message {0}, body size = {1}", message->TraceId(), body.size());
+                if (++messageCount == TotalMessageCount)
+                {
+                    messagesReceived.Set();
+                }
+            });
+
+        VERIFY_IS_TRUE(receiver->Start().IsSuccess());
+        VERIFY_IS_TRUE(sender->Start().IsSuccess());
+
+        ISendTarget::SPtr target = sender->ResolveTarget(receiver->ListenAddress());
+        VERIFY_IS_TRUE(target);
+
+        for (auto bodySize : bodySizes)
+        {
+            auto msg = make_unique<Message>(TestMessageBody(bodySize));
+            msg->Headers.Add(ActionHeader(testAction));
+            msg->Headers.Add(MessageIdHeader());
+            msg->SetSendStatusCallback([&, TotalMessageCount](ErrorCode const & error, MessageUPtr &&)
+            {
+                if (!error.IsSuccess())
+                {
+                    ++failureCount;
+                }
+
+                if (++sendStatusCount == TotalMessageCount)
+                {
+                    sendStatusReported.Set();
+                }
+            });
+
+            sender->SendOneWay(target, std::move(msg));
+        }
+
+        VERIFY_IS_TRUE(messagesReceived.WaitOne(TimeSpan::FromSeconds(30)));
+        VERIFY_IS_TRUE(sendStatusReported.WaitOne(TimeSpan::FromSeconds(30)));
+        VERIFY_ARE_EQUAL(0u, failureCount.load());
+
+        sender->Stop();
+        receiver->Stop();
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(SendQueueFullUnderContentionTest)
+    {
+        ENTER;
+
+        // Senders contending on one connection hand messages over through lock-free intake,
+        // send queue full must still be returned from SendOneWay and not only reported later
+        auto saved = TransportConfig::GetConfig().LockFreeSendQueueEnabled;
+        KFinally([=] { TransportConfig::GetConfig().LockFreeSendQueueEnabled = saved; });
+        TransportConfig::GetConfig().LockFreeSendQueueEnabled = true;
+
+        auto receiver = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+        receiver->SetMessageHandler([](MessageUPtr &, ISendTarget::SPtr const &) {});
+        VERIFY_IS_TRUE(receiver->Start().IsSuccess());
+
+        auto sender = TcpDatagramTransport::CreateClient();
+        size_t const messageBodySize = 64 * 1024;
+        sender->SetPerTargetSendQueueLimit((ULONG)(messageBodySize * 2));
+        VERIFY_IS_TRUE(sender->Start().IsSuccess());
+
+        ISendTarget::SPtr target = sender->ResolveTarget(receiver->ListenAddress());
+        VERIFY_IS_TRUE(target);
+
+        int const threadCount = 16;
+        int const messagesPerThread = 200;
+        atomic_long queueFullReturned(0);
+        atomic_long queueFullReported(0);
+        atomic_long unexpectedError(0);
+
+        ManualResetEvent startSending(false);
+        vector<thread> senderThreads;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            senderThreads.emplace_back([&]
+            {
+                startSending.WaitOne();
+                for (int j = 0; j < messagesPerThread; ++j)
+                {
+                    auto msg = make_unique<Message>(TestMessageBody(messageBodySize));
+                    msg->SetSendStatusCallback([&](ErrorCode const & error, MessageUPtr &&)
+                    {
+                        if (error.IsError(ErrorCodeValue::TransportSendQueueFull))
+                        {
+                            ++queueFullReported;
+                        }
+                    });
+
+                    auto error = sender->SendOneWay(target, move(msg));
+                    if (error.IsError(ErrorCodeValue::TransportSendQueueFull))
+                    {
+                        ++queueFullReturned;
+                    }
+                    else if (!error.IsSuccess())
+                    {
+                        ++unexpectedError;
+                    }
+                }
+            });
+        }
+
+        startSending.Set();
+        for (auto & senderThread : senderThreads)
+        {
+            senderThread.join();
+        }
+
+        Trace.WriteInfo(
+            TraceType,
+            "SendQueueFullUnderContentionTest: queue full returned = {0}, reported = {1}",
+            queueFullReturned.load(),
+            queueFullReported.load());
+
+        VERIFY_ARE_EQUAL(0, unexpectedError.load());
+        VERIFY_IS_TRUE(queueFullReturned.load() > 0);
+        VERIFY_ARE_EQUAL(queueFullReturned.load(), queueFullReported.load());
+
+        sender->Stop();
+        receiver->Stop();
+
+        LEAVE;
+    }
+
+    BOOST_AUTO_TEST_CASE(SendQueueContentionBenchmark)
+    {
+        ENTER;
+
+        // Many threads sending to the same target share one connection, compare
+        // throughput of lock-free send queue intake against enqueueing under connection lock
+        auto saved = TransportConfig::GetConfig().LockFreeSendQueueEnabled;
+        KFinally([=] { TransportConfig::GetConfig().LockFreeSendQueueEnabled = saved; });
+
+        LONG const MessagesPerRun = 64 * 1000;
+
+        for (bool lockFree : { false, true })
+        {
+            TransportConfig::GetConfig().LockFreeSendQueueEnabled = lockFree;
+
+            for (int threadCount : { 1, 2, 4, 8, 16, 32, 64 })
+            {
+                auto sender = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+                auto receiver = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+                sender->SetPerTargetSendQueueLimit(0);
+
+                atomic_long messageCount(0);
+                atomic_long expectedCount(1);
+                ManualResetEvent messagesReceived(false);
+
+                receiver->SetMessageHandler([&](MessageUPtr &, ISendTarget::SPtr const &)
+                {
+                    if (++messageCount == expectedCount.load())
+                    {
+                        messagesReceived.Set();
+                    }
+                });
+
+                VERIFY_IS_TRUE(receiver->Start().IsSuccess());
+                VERIFY_IS_TRUE(sender->Start().IsSuccess());
+
+                ISendTarget::SPtr target = sender->ResolveTarget(receiver->ListenAddress());
+                VERIFY_IS_TRUE(target);
+
+                // establish connection before measuring
+                sender->SendOneWay(target, make_unique<Message>(TcpTestMessage(L"warmup")));
+                VERIFY_IS_TRUE(messagesReceived.WaitOne(TimeSpan::FromSeconds(30)));
+                messagesReceived.Reset();
+
+                LONG messagesPerThread = MessagesPerRun / threadCount;
+                expectedCount.store(1 + messagesPerThread * threadCount);
+
+                ManualResetEvent startSending(false);
+                vector<thread> senderThreads;
+                for (int i = 0; i < threadCount; ++i)
+                {
+                    senderThreads.emplace_back([&sender, &target, &startSending, messagesPerThread]
+                    {
+                        startSending.WaitOne();
+                        for (LONG j = 0; j < messagesPerThread; ++j)
+                        {
+                            sender->SendOneWay(target, make_unique<Message>(TcpTestMessage(L"contention benchmark message")));
+                        }
+                    });
+                }
+
+                Stopwatch stopwatch;
+                stopwatch.Start();
+                startSending.Set();
+
+                for (auto & senderThread : senderThreads)
+                {
+                    senderThread.join();
+                }
+
+                auto enqueueTime = stopwatch.Elapsed;
+                VERIFY_IS_TRUE(messagesReceived.WaitOne(TimeSpan::FromSeconds(120)));
+                stopwatch.Stop();
+
+                Trace.WriteInfo(
+                    TraceType,
+                    "SendQueueContentionBenchmark: lockFree = {0}, threads = {1}, messages = {2}, enqueue = {3} msg/sec, end-to-end = {4} msg/sec",
+                    lockFree,
+                    threadCount,
+                    expectedCount.load() - 1,
+                    (uint64)((expectedCount.load() - 1) * 1000.0 / max(enqueueTime.TotalMillisecondsAsDouble(), 1.0)),
+                    (uint64)((expectedCount.load() - 1) * 1000.0 / max(stopwatch.Elapsed.TotalMillisecondsAsDouble(), 1.0)));
+
+                sender->Stop();
+                receiver->Stop();
+            }
+        }
+
+        LEAVE;
+    }
+
     BOOST_AUTO_TEST_CASE(AbortReceiver)
     {
         ENTER;
@@ -2867,6 +3176,115 @@ namespace Transport
         LEAVE;
     }
 
+    BOOST_AUTO_TEST_CASE(IoUringIdleReceiveAndFullSendBuffer)
+    {
+        // never destroyed, like the default transport event loop pool
+        static EventLoopPool* ioUringPool = new EventLoopPool(L"IoUringTest", 2, EventLoopBackend::IoUring);
+        if (ioUringPool->Backend() != EventLoopBackend::IoUring)
+        {
+            Trace.WriteWarning(TraceType, "io_uring is not supported, skipping test");
+            return;
+        }
+
+        ENTER;
+
+        auto sender = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+        auto receiver = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+        sender->SetEventLoopPool(ioUringPool);
+        receiver->SetEventLoopPool(ioUringPool);
+
+        atomic_uint64 connectionFaultCount(0);
+        sender->SetConnectionFaultHandler([&](ISendTarget const &, ErrorCode fault) -> void
+        {
+            Trace.WriteWarning(TraceType, "[sender] connection fault: {0}", fault);
+            ++connectionFaultCount;
+        });
+        receiver->SetConnectionFaultHandler([&](ISendTarget const &, ErrorCode fault) -> void
+        {
+            Trace.WriteWarning(TraceType, "[receiver] connection fault: {0}", fault);
+            ++connectionFaultCount;
+        });
+
+        // enough data to fill both the receive and the send socket buffers while the receiver is held
+        size_t const bodySize = 1024 * 1024;
+        LONG const BulkMessageCount = 32;
+        LONG messageCount = 0;
+        atomic_uint64 verifyFailureCount(0);
+        AutoResetEvent firstMessageReceived;
+        AutoResetEvent messagesReceived;
+        ManualResetEvent releaseReceiver;
+
+        wstring testAction = TTestUtil::GetGuidAction();
+        TTestUtil::SetMessageHandler(
+            receiver,
+            testAction,
+            [&](MessageUPtr & message, ISendTarget::SPtr const &) -> void
+            {
+                TestMessageBody body;
+                if (!message->GetBody(body) || !body.Verify())
+                {
+                    ++verifyFailureCount;
+                }
+
+                auto count = InterlockedIncrement((volatile LONG *)&messageCount);
+                if (count == 1)
+                {
+                    firstMessageReceived.Set();
+                    return;
+                }
+
+                if (count == 2)
+                {
+                    releaseReceiver.WaitOne();
+                }
+
+                if (count == BulkMessageCount + 1)
+                {
+                    messagesReceived.Set();
+                }
+            });
+
+        VERIFY_IS_TRUE(receiver->Start().IsSuccess());
+        VERIFY_IS_TRUE(sender->Start().IsSuccess());
+
+        ISendTarget::SPtr target = sender->ResolveTarget(receiver->ListenAddress());
+        VERIFY_IS_TRUE(target);
+
+        {
+            auto msg = make_unique<Message>(TestMessageBody(16));
+            msg->Headers.Add(ActionHeader(testAction));
+            msg->Headers.Add(MessageIdHeader());
+            sender->SendOneWay(target, std::move(msg));
+        }
+
+        VERIFY_IS_TRUE(firstMessageReceived.WaitOne(TimeSpan::FromSeconds(30)));
+
+        // Both sides now have a readv outstanding on an idle socket, which completes with EAGAIN
+        ::Sleep(3000);
+        VERIFY_ARE_EQUAL(0u, connectionFaultCount.load());
+
+        for (LONG i = 0; i < BulkMessageCount; ++i)
+        {
+            auto msg = make_unique<Message>(TestMessageBody(bodySize));
+            msg->Headers.Add(ActionHeader(testAction));
+            msg->Headers.Add(MessageIdHeader());
+            sender->SendOneWay(target, std::move(msg));
+        }
+
+        // Receiver is held in the first bulk message, so the sender's writev hits a full send buffer
+        ::Sleep(3000);
+        releaseReceiver.Set();
+
+        VERIFY_IS_TRUE(messagesReceived.WaitOne(TimeSpan::FromSeconds(60)));
+        VERIFY_ARE_EQUAL(0u, verifyFailureCount.load());
+        VERIFY_ARE_EQUAL(0u, connectionFaultCount.load());
+
+        sender->Stop();
+        receiver->Stop();
+
+        LEAVE;
+    }
+
 #else //LINUXTODO: enable the following tests for Linux
 
     BOOST_AUTO_TEST_CASE(SendQueueExpirationTest_ZeroExpiration)
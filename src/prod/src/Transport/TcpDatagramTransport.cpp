@@ -490,6 +490,12 @@ void TcpDatagramTransport::OnListenInstanceMessage(
 
     connection.OnConnectionReady();
 
+    FrameCompressionHeader compressionHeader;
+    if (message.Headers.TryReadFirst(compressionHeader))
+    {
+        connection.OnRemoteFrameCompression(compressionHeader.Algorithm());
+    }
+
 #ifdef DBG
     TcpSendTarget* tcpSendTarget = dynamic_cast<TcpSendTarget*>(target.get());
 #else
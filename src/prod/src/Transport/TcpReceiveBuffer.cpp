@@ -197,6 +197,12 @@ NTSTATUS TcpReceiveBuffer::GetNextMessage(MessageUPtr & message, StopwatchTime r
 #endif
     }
 
+    if (connectionPtr_->frameCompressionEnabled_)
+    {
+        auto status = DecompressIfNeeded(message, headers, body, recvTime);
+        if (status != STATUS_SUCCESS) return status;
+    }
+
     if (securityContext && connectionPtr_->inbound_)
     {
         message->SetSecurityContext(securityContext);
@@ -229,6 +235,99 @@ NTSTATUS TcpReceiveBuffer::GetNextMessage(MessageUPtr & message, StopwatchTime r
     return STATUS_SUCCESS;
 }
 
+NTSTATUS TcpReceiveBuffer::DecompressIfNeeded(
+    MessageUPtr & message,
+    ByteBiqueIterator const & headers,
+    ByteBiqueIterator const & body,
+    StopwatchTime recvTime)
+{
+    FrameCompressionHeader compressionHeader;
+    if (!message->Headers.TryReadFirst(compressionHeader) || !compressionHeader.IsBodyCompressed())
+    {
+        return STATUS_SUCCESS;
+    }
+
+    if (compressionHeader.Algorithm() != FrameCompression::Lz4)
+    {
+        TcpConnection::WriteError(
+            TraceType, connectionPtr_->TraceId(),
+            "unsupported compression on message {0}: {1}",
+            message->TraceId(),
+            compressionHeader);
+
+        return E_FAIL;
+    }
+
+    size_t uncompressedSize = compressionHeader.UncompressedBodySize();
+    if (!connectionPtr_->IsIncomingFrameSizeWithinLimit(sizeof(TcpFrameHeader) + currentFrame_.HeaderLength() + uncompressedSize))
+    {
+        trace.IncomingMessageTooLarge(
+            connectionPtr_->TraceId(),
+            connectionPtr_->localAddress_,
+            connectionPtr_->targetAddress_,
+            connectionPtr_->target_->TraceId(),
+            sizeof(TcpFrameHeader) + currentFrame_.HeaderLength() + uncompressedSize,
+            connectionPtr_->maxIncomingFrameSizeInBytes_);
+
+        return STATUS_DATA_ERROR;
+    }
+
+    size_t compressedSize = currentFrame_.FrameLength() - currentFrame_.HeaderLength();
+    vector<byte> gathered;
+    byte const * input = nullptr;
+    auto chunk = message->BeginBodyChunks();
+    if ((chunk != message->EndBodyChunks()) && (chunk->size() == compressedSize))
+    {
+        input = chunk->cbegin();
+    }
+    else
+    {
+        gathered.reserve(compressedSize);
+        for (; chunk != message->EndBodyChunks(); ++chunk)
+        {
+            gathered.insert(gathered.end(), chunk->cbegin(), chunk->cend());
+        }
+
+        input = gathered.data();
+    }
+
+    // single chunk sized to hold the entire uncompressed body
+    ByteBique decompressed(uncompressedSize);
+    decompressed.reserve_back(uncompressedSize);
+    auto output = decompressed.end();
+    Invariant(output.fragment_size() >= uncompressedSize);
+
+    if (!Lz4::Decompress(input, compressedSize, &(*output), uncompressedSize))
+    {
+        TcpConnection::WriteError(
+            TraceType, connectionPtr_->TraceId(),
+            "failed to decompress message {0}: {1}, compressed size = {2}",
+            message->TraceId(),
+            compressionHeader,
+            compressedSize);
+
+        return E_FAIL;
+    }
+
+    decompressed.no_fill_advance_back(uncompressedSize);
+
+    auto bodyBufferToReserve = (uncompressedSize + connectionPtr_->receiveChunkSize_ - 1) / connectionPtr_->receiveChunkSize_ + 1;
+    message = Common::make_unique<Message>(
+        ByteBiqueRange(headers, body, false),
+        ByteBiqueRange(move(decompressed)),
+        recvTime,
+        bodyBufferToReserve);
+
+    message->Headers.TryRemoveHeader<FrameCompressionHeader>();
+
+    TcpConnection::WriteNoise(
+        TraceType, connectionPtr_->TraceId(),
+        "decompressed message {0}: body size {1} -> {2}",
+        message->TraceId(), compressedSize, uncompressedSize);
+
+    return STATUS_SUCCESS;
+}
+
 void TcpReceiveBuffer::ConsumeCurrentMessage()
 {
     ASSERT_IF(!haveFrameHeader_, "deleting message in unexpected state");
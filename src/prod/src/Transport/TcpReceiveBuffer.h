@@ -14,8 +14,15 @@ namespace Transport
 
         NTSTATUS GetNextMessage(_Out_ MessageUPtr & message, Common::StopwatchTime recvTime) override;
         void ConsumeCurrentMessage() override;
+        bool SupportsFrameCompression() const override { return true; }
 
     private:
+        NTSTATUS DecompressIfNeeded(
+            MessageUPtr & message,
+            ByteBiqueIterator const & headers,
+            ByteBiqueIterator const & body,
+            Common::StopwatchTime recvTime);
+
         TcpFrameHeader currentFrame_;
         TcpFrameHeader firstFrameHeader_;
     };
@@ -17,6 +17,11 @@ namespace
 
     const static size_t FrameQueueBiqueChunkSize = (1024 * 32) / sizeof(TcpSendBuffer::Frame);
     const static size_t SendBatchBufferCountLimit = 1024; // writev on Linux limit buffer count to 1024
+
+    void FreeCompressedBuffer(vector<Common::const_buffer> const &, void * state)
+    {
+        unique_ptr<vector<byte>> buffer(static_cast<vector<byte>*>(state));
+    }
 }
 
 TcpSendBuffer::Frame::Frame(
@@ -28,6 +33,7 @@ TcpSendBuffer::Frame::Frame(
 , message_(std::move(message))
 , shouldEncrypt_(shouldEncrypt)
 , preparedForSending_(false)
+, zeroCopy_(false)
 {
     auto count = ++frameCount;
     TcpConnection::WriteNoise(TraceType, "Frame ctor: count = {0}", count);
@@ -85,6 +91,93 @@ bool TcpSendBuffer::Frame::IsInUse() const
     return preparedForSending_;
 }
 
+void TcpSendBuffer::Frame::CompressIfNeeded(TcpSendBuffer & sendBuffer)
+{
+    if (!sendBuffer.ShouldCompress(shouldEncrypt_))
+    {
+        return;
+    }
+
+    auto const & config = TransportConfig::GetConfig();
+    auto bodySize = message_->SerializedBodySize();
+    if ((bodySize == 0) || (bodySize < config.FrameCompressionThreshold))
+    {
+        return;
+    }
+
+    if (sendBuffer.compressionBypassRemaining_ > 0)
+    {
+        --sendBuffer.compressionBypassRemaining_;
+        sendBuffer.perfCounters_->CompressionBypassedFrameCount.Increment();
+        return;
+    }
+
+    // body is usually a single buffer, only gather into contiguous memory when it is not
+    vector<byte> gathered;
+    byte const * input = nullptr;
+    auto chunk = message_->BeginBodyChunks();
+    if ((chunk != message_->EndBodyChunks()) && (chunk->size() == bodySize))
+    {
+        input = chunk->cbegin();
+    }
+    else
+    {
+        gathered.reserve(bodySize);
+        for (; chunk != message_->EndBodyChunks(); ++chunk)
+        {
+            gathered.insert(gathered.end(), chunk->cbegin(), chunk->cend());
+        }
+
+        input = gathered.data();
+    }
+
+    // output capacity is capped at the largest acceptable size, so that compression
+    // gives up early on data that cannot reach the required saving
+    size_t maxCompressedSize = (size_t)bodySize * (100 - config.FrameCompressionMinSavingPercent) / 100;
+    unique_ptr<vector<byte>> compressed(new vector<byte>(maxCompressedSize));
+    size_t compressedSize = Lz4::Compress(input, bodySize, compressed->data(), compressed->size());
+    if (compressedSize == 0)
+    {
+        sendBuffer.compressionBypassRemaining_ = config.FrameCompressionBypassCount;
+        sendBuffer.perfCounters_->CompressionBypassedFrameCount.Increment();
+        TcpConnection::WriteNoise(
+            TraceType, sendBuffer.connection_->TraceId(),
+            "Compress: {0}: body size {1} not compressible enough, bypass next {2} frames",
+            message_->TraceId(), bodySize, sendBuffer.compressionBypassRemaining_);
+        return;
+    }
+
+    compressed->resize(compressedSize);
+
+    vector<Common::const_buffer> bufferList;
+    bufferList.push_back(Common::const_buffer(compressed->data(), compressed->size()));
+    auto compressedMessage = unique_ptr<Transport::Message>(new Transport::Message(bufferList, FreeCompressedBuffer, compressed.release()));
+    compressedMessage->Headers.AppendFrom(message_->Headers);
+    compressedMessage->Headers.Add(FrameCompressionHeader(FrameCompression::Lz4, bodySize));
+    if (message_->HasSendStatusCallback())
+    {
+        compressedMessage->SetSendStatusCallback(message_->get_SendStatusCallback());
+    }
+
+    compressedMessage->SetTraceId(message_->TraceId());
+    compressedMessage->MoveLocalTraceContextFrom(*message_);
+
+    TcpConnection::WriteNoise(
+        TraceType, sendBuffer.connection_->TraceId(),
+        "Compress: {0}: body size {1} -> {2}",
+        message_->TraceId(), bodySize, compressedSize);
+
+    // adjust for size change due to compression
+    sendBuffer.totalBufferedBytes_ -= header_.FrameLength();
+    message_ = move(compressedMessage);
+    header_ = TcpFrameHeader(message_, sendBuffer.securityProviderMask_);
+    sendBuffer.totalBufferedBytes_ += header_.FrameLength();
+
+    sendBuffer.perfCounters_->CompressedFrameCount.Increment();
+    sendBuffer.perfCounters_->CompressionInputBytes.IncrementBy(bodySize);
+    sendBuffer.perfCounters_->CompressionOutputBytes.IncrementBy(compressedSize);
+}
+
 ErrorCode TcpSendBuffer::Frame::EncryptIfNeeded(TcpSendBuffer & sendBuffer)
 {
     if (!shouldEncrypt_)
@@ -195,6 +288,8 @@ ErrorCode TcpSendBuffer::Frame::PrepareForSending(TcpSendBuffer & sendBuffer)
     Invariant(!preparedForSending_);
     preparedForSending_ = true;
 
+    CompressIfNeeded(sendBuffer);
+
     ErrorCode error = EncryptIfNeeded(sendBuffer);
     if (!error.IsSuccess())
     {
@@ -237,6 +332,14 @@ ErrorCode TcpSendBuffer::Frame::PrepareForSending(TcpSendBuffer & sendBuffer)
         }
     }
 
+#ifdef PLATFORM_UNIX
+    // frame header and message header are copied, they are small and frame header memory is reused after Consume()
+    zeroCopy_ =
+        !shouldEncrypt_ &&
+        (sendBuffer.zeroCopySendThreshold_ > 0) &&
+        (message_->SerializedBodySize() >= sendBuffer.zeroCopySendThreshold_);
+#endif
+
     // add message body
     for (BufferIterator chunk = message_->BeginBodyChunks(); chunk != message_->EndBodyChunks(); ++chunk)
     {
@@ -244,6 +347,12 @@ ErrorCode TcpSendBuffer::Frame::PrepareForSending(TcpSendBuffer & sendBuffer)
 
         sendBuffer.preparedBuffers_.emplace_back(ConstBuffer(chunk->cbegin(), chunk->size()));
         sendBuffer.sendingLength_ += chunk->size();
+#ifdef PLATFORM_UNIX
+        if (zeroCopy_)
+        {
+            sendBuffer.MarkLastPreparedBufferZeroCopy();
+        }
+#endif
 
         if (!shouldEncrypt_ && sendBuffer.MessageErrorCheckingEnabled())
         {
@@ -268,6 +377,25 @@ TcpSendBuffer::TcpSendBuffer(TcpConnection* connectionPtr)
 {
 }
 
+bool TcpSendBuffer::ShouldCompress(bool shouldEncrypt) const
+{
+    if (compression_ == FrameCompression::None)
+    {
+        return false;
+    }
+
+    if (!shouldEncrypt)
+    {
+        return true;
+    }
+
+    // Compressed body must be visible to the receiving side before message level decryption, which is only
+    // the case when the whole frame is protected, compression header would otherwise be encrypted with body
+    return
+        TransportConfig::GetConfig().FrameCompressionOnSecureConnectionEnabled &&
+        connection_->securityContext_->FramingProtectionEnabled();
+}
+
 size_t TcpSendBuffer::MessageCount() const
 {
     return messageQueue_.size();
@@ -309,6 +437,7 @@ ErrorCode TcpSendBuffer::Prepare()
     preparedBuffers_.resize(0);
 #ifdef PLATFORM_UNIX
     firstBufferToSend_ = 0;
+    zeroCopyBuffers_.resize(0);
 #endif
 
     StopwatchTime now = Stopwatch::Now();
@@ -377,6 +506,16 @@ void TcpSendBuffer::Consume(size_t length)
                 frame->Message()->IsReply(),
                 messageSentCount_);
 
+#ifdef PLATFORM_UNIX
+            if (frame->IsZeroCopy() && connection_->zeroCopySend_)
+            {
+                // kernel may still read message body, send status is reported when zero-copy send completes
+                connection_->zeroCopySend_->Retain(frame->Dispose());
+                ++frame;
+                continue;
+            }
+#endif
+
             if (frame->Message()->HasSendStatusCallback())
             {
                 auto msg = frame->Dispose();
@@ -32,8 +32,10 @@ namespace Transport
 
             bool HasExpired(Common::StopwatchTime now) const; // HasExpired => ! IsInUse
             bool IsInUse() const;
+            bool IsZeroCopy() const { return zeroCopy_; } // body is sent without copying and must outlive the send
 
         private:
+            void CompressIfNeeded(TcpSendBuffer & sendBuffer);
             Common::ErrorCode EncryptIfNeeded(TcpSendBuffer & sendBuffer);
 
             TcpFrameHeader header_;
@@ -41,6 +43,7 @@ namespace Transport
             Common::StopwatchTime expiration_;
             bool shouldEncrypt_;
             bool preparedForSending_;
+            bool zeroCopy_;
 
             Common::ByteBuffer2 encrypted_;
         };
@@ -62,6 +65,7 @@ namespace Transport
 
     private:
         void DropExpiredMessage(Frame & frame);
+        bool ShouldCompress(bool shouldEncrypt) const;
 
         using FrameQueue = Common::bique<Frame>;
         FrameQueue messageQueue_;
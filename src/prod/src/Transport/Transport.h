@@ -50,6 +50,7 @@
 #include "BiqueRangeStream.h"
 #include "BiqueWriteStream.h"
 
+#include "ActionTable.h"
 #include "MessageHeaders.h"
 #include "MessageHeadersCollection.h"
 #include "MessageHeaderTrace.h"
@@ -68,7 +69,9 @@
 #include "DuplexRequestReply.h"
 #include "DemuxerT.h"
 #include "Demuxer.h"
+#include "ActionDispatchTable.h"
 #include "IpcHeader.h"
+#include "IpcSharedMemoryHeader.h"
 #include "IpcReceiverContext.h"
 #include "IpcDemuxer.h"
 #include "IpcServer.h"
@@ -0,0 +1,611 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include "TestCommon.h"
+
+//
+// Single process loopback benchmark of TcpDatagramTransport, IpcServer/IpcClient and MemoryTransport.
+// Sender threads send one-way messages with a bounded number of messages in flight, receiver deserializes
+// all headers and the body of every message. Reports throughput, one-way latency percentiles and process
+// CPU time per message, which includes both sending and receiving side.
+//
+
+using namespace Transport;
+using namespace Common;
+using namespace std;
+
+#define TraceType "TransportBenchmark"
+
+RealConsole console;
+
+namespace
+{
+    namespace BenchmarkTransport
+    {
+        enum Enum
+        {
+            Tcp = 0,
+            Ipc = 1,
+            Memory = 2,
+        };
+
+        wstring ToString(Enum value)
+        {
+            switch (value)
+            {
+            case Tcp: return L"tcp";
+            case Ipc: return L"ipc";
+            case Memory: return L"mem";
+            }
+
+            return L"unknown";
+        }
+    }
+
+    struct BenchmarkHeader : public MessageHeader<MessageHeaderId::Example>, public Serialization::FabricSerializable
+    {
+        BenchmarkHeader() : sequence_(0) {}
+        BenchmarkHeader(uint64 sequence) : sequence_(sequence), tag_(L"TransportBenchmarkHeader") {}
+
+        uint64 Sequence() const { return sequence_; }
+
+        FABRIC_FIELDS_02(sequence_, tag_);
+
+    private:
+        uint64 sequence_;
+        wstring tag_;
+    };
+
+    struct BenchmarkBody : public Serialization::FabricSerializable
+    {
+        BenchmarkBody() : sendTicks_(0) {}
+        BenchmarkBody(int64 sendTicks, vector<byte> const & payload) : sendTicks_(sendTicks), payload_(payload) {}
+
+        int64 SendTicks() const { return sendTicks_; }
+        size_t PayloadSize() const { return payload_.size(); }
+
+        FABRIC_FIELDS_02(sendTicks_, payload_);
+
+    private:
+        int64 sendTicks_;
+        vector<byte> payload_;
+    };
+
+    struct BenchmarkRoot : public ComponentRoot
+    {
+    };
+
+    int64 GetProcessCpuTicks()
+    {
+#ifdef PLATFORM_UNIX
+        rusage usage = {};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+
+        auto toTicks = [](timeval const & tv) { return (int64)tv.tv_sec * TimeSpan::TicksPerSecond + (int64)tv.tv_usec * 10; };
+        return toTicks(usage.ru_utime) + toTicks(usage.ru_stime);
+#else
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!::GetProcessTimes(::GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+        {
+            return 0;
+        }
+
+        auto toTicks = [](FILETIME const & ft) { return (int64)(((uint64)ft.dwHighDateTime << 32) | ft.dwLowDateTime); };
+        return toTicks(kernelTime) + toTicks(userTime);
+#endif
+    }
+}
+
+class TransportBenchmark
+{
+    DENY_COPY(TransportBenchmark);
+
+public:
+    TransportBenchmark(BenchmarkTransport::Enum transport);
+
+    ErrorCode Run();
+
+    static void ParseCmdline(int argc, wchar_t* argv[]);
+    static vector<BenchmarkTransport::Enum> const & Transports() { return transports_; }
+    static void WriteResultColumns();
+
+private:
+    void Open();
+    void Close();
+    MessageUPtr CreateMessage(uint64 sequence);
+    ErrorCode Send(MessageUPtr && message);
+    void Fail(ErrorCode const & error);
+    void OnMessageReceived(Message & message);
+    void SendLoop();
+    void WriteResult(TimeSpan elapsed, int64 cpuTicks);
+    static void PrintUsageAndExit();
+
+    BenchmarkTransport::Enum const transport_;
+    shared_ptr<BenchmarkRoot> root_;
+
+    IDatagramTransportSPtr sender_;
+    IDatagramTransportSPtr receiver_;
+    ISendTarget::SPtr target_;
+    shared_ptr<IpcServer> ipcServer_;
+    shared_ptr<IpcClient> ipcClient_;
+
+    vector<byte> payload_;
+    atomic_uint64 sentCount_{0};
+    atomic_uint64 receivedCount_{0};
+    atomic_uint64 receivedBytes_{0};
+    atomic_uint64 failureCount_{0};
+    uint64 expectedCount_;
+    vector<int64> latencyTicks_;
+    atomic_bool measuring_;
+    ManualResetEvent warmedUp_;
+    ManualResetEvent allReceived_;
+
+    // first send failure, waits are released on failure as lost messages will never be received
+    RwLock errorLock_;
+    ErrorCode error_;
+    atomic_bool failed_;
+
+    static vector<BenchmarkTransport::Enum> transports_;
+    static SecurityProvider::Enum securityProvider_;
+    static uint messageSize_;
+    static uint headerCount_;
+    static uint senderCount_;
+    static uint messageCount_;
+    static uint window_;
+};
+
+#ifdef DBG
+static const uint messageCountDefault = 20000;
+#else
+static const uint messageCountDefault = 200000;
+#endif
+
+static const uint messageSizeDefault = 1024;
+static const uint headerCountDefault = 0;
+static const uint senderCountDefault = 1;
+static const uint windowDefault = 64;
+
+vector<BenchmarkTransport::Enum> TransportBenchmark::transports_ = { BenchmarkTransport::Tcp, BenchmarkTransport::Ipc, BenchmarkTransport::Memory };
+SecurityProvider::Enum TransportBenchmark::securityProvider_ = SecurityProvider::None;
+uint TransportBenchmark::messageSize_ = messageSizeDefault;
+uint TransportBenchmark::headerCount_ = headerCountDefault;
+uint TransportBenchmark::senderCount_ = senderCountDefault;
+uint TransportBenchmark::messageCount_ = messageCountDefault;
+uint TransportBenchmark::window_ = windowDefault;
+
+static const wstring transportArg = L"-transport";
+static const wstring securityArg = L"-security";
+static const wstring sizeArg = L"-size";
+static const wstring headersArg = L"-headers";
+static const wstring sendersArg = L"-senders";
+static const wstring countArg = L"-count";
+static const wstring windowArg = L"-window";
+
+#ifdef PLATFORM_UNIX
+int main(int argc, char* argva[])
+#else
+void wmain(int argc, wchar_t* argv[])
+#endif
+{
+    Config config; // Trigger config loading
+    TraceProvider::LoadConfiguration(config);
+
+#ifdef PLATFORM_UNIX
+    Invariant(argc >= 1);
+    vector<wstring> args;
+    for (int i = 0; i < argc; ++i)
+    {
+        args.emplace_back(StringUtility::Utf8ToUtf16(argva[i]));
+    }
+
+    vector<wchar_t*> argvv;
+    for (auto const & arg : args)
+    {
+        argvv.emplace_back(const_cast<wchar_t*>(arg.c_str()));
+    }
+
+    auto argv = argvv.data();
+#endif
+
+    TransportBenchmark::ParseCmdline(argc, argv);
+
+    TTestUtil::DisableSendThrottling();
+    TTestUtil::ReduceTracingInFreBuild();
+
+    TransportBenchmark::WriteResultColumns();
+    ErrorCode result;
+    for (auto transport : TransportBenchmark::Transports())
+    {
+        TransportBenchmark benchmark(transport);
+        auto error = benchmark.Run();
+        if (!error.IsSuccess())
+        {
+            console.WriteLine("{0}: failed: {1}", BenchmarkTransport::ToString(transport), error);
+            result = error;
+        }
+    }
+
+    TTestUtil::RecoverTracingInFreBuild();
+
+#ifdef PLATFORM_UNIX
+    return result.IsSuccess() ? 0 : 1;
+#endif
+}
+
+TransportBenchmark::TransportBenchmark(BenchmarkTransport::Enum transport)
+    : transport_(transport)
+    , root_(make_shared<BenchmarkRoot>())
+    , payload_(messageSize_)
+    , expectedCount_((uint64)messageCount_ * senderCount_)
+    , latencyTicks_(expectedCount_)
+    , measuring_(false)
+    , warmedUp_(false)
+    , allReceived_(false)
+    , failed_(false)
+{
+    for (size_t i = 0; i < payload_.size(); ++i)
+    {
+        payload_[i] = (byte)i;
+    }
+}
+
+void TransportBenchmark::Open()
+{
+    if (transport_ == BenchmarkTransport::Ipc)
+    {
+        ipcServer_ = make_shared<IpcServer>(*root_, TTestUtil::GetListenAddress(), L"TransportBenchmark", false /* disallow use of unreliable transport */, L"TransportBenchmark");
+        ipcServer_->RegisterMessageHandler(
+            Actor::IpcTestActor1,
+            [this](MessageUPtr & message, IpcReceiverContextUPtr &) { OnMessageReceived(*message); },
+            true /*dispatchOnTransportThread*/);
+
+        auto error = ipcServer_->Open();
+        Invariant(error.IsSuccess());
+
+        ipcClient_ = make_shared<IpcClient>(*root_, L"TransportBenchmarkClient", ipcServer_->TransportListenAddress, false /* disallow use of unreliable transport */, L"TransportBenchmark");
+        error = ipcClient_->Open();
+        Invariant(error.IsSuccess());
+        return;
+    }
+
+    if (transport_ == BenchmarkTransport::Memory)
+    {
+        auto receiverName = wformatString("TransportBenchmarkReceiver-{0}", Guid::NewGuid());
+        receiver_ = DatagramTransportFactory::CreateMem(receiverName);
+        sender_ = DatagramTransportFactory::CreateMem(wformatString("TransportBenchmarkSender-{0}", Guid::NewGuid()));
+    }
+    else
+    {
+        receiver_ = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+        sender_ = TcpDatagramTransport::Create(TTestUtil::GetListenAddress());
+
+        if (securityProvider_ != SecurityProvider::None)
+        {
+            auto securitySettings = TTestUtil::CreateTestSecuritySettings(securityProvider_);
+            Invariant(receiver_->SetSecurity(securitySettings).IsSuccess());
+            Invariant(sender_->SetSecurity(securitySettings).IsSuccess());
+        }
+    }
+
+    receiver_->SetMessageHandler([this](MessageUPtr & message, ISendTarget::SPtr const &) { OnMessageReceived(*message); });
+
+    Invariant(receiver_->Start().IsSuccess());
+    Invariant(sender_->Start().IsSuccess());
+
+    target_ = sender_->ResolveTarget(receiver_->ListenAddress());
+    Invariant(target_);
+}
+
+void TransportBenchmark::Close()
+{
+    if (ipcClient_)
+    {
+        ipcClient_->Close();
+        ipcServer_->Close();
+        return;
+    }
+
+    sender_->Stop();
+    receiver_->Stop();
+}
+
+MessageUPtr TransportBenchmark::CreateMessage(uint64 sequence)
+{
+    auto message = make_unique<Message>(BenchmarkBody(Stopwatch::Now().Ticks, payload_));
+    message->Headers.Add(MessageIdHeader());
+    for (uint i = 0; i < headerCount_; ++i)
+    {
+        message->Headers.Add(BenchmarkHeader(sequence));
+    }
+
+    if (transport_ == BenchmarkTransport::Ipc)
+    {
+        message->Headers.Add(ActorHeader(Actor::IpcTestActor1));
+    }
+
+    return message;
+}
+
+ErrorCode TransportBenchmark::Send(MessageUPtr && message)
+{
+    ErrorCode error;
+    if (ipcClient_)
+    {
+        error = ipcClient_->SendOneWay(move(message));
+    }
+    else
+    {
+        error = sender_->SendOneWay(target_, move(message));
+    }
+
+    if (!error.IsSuccess())
+    {
+        ++failureCount_;
+        Fail(error);
+    }
+
+    return error;
+}
+
+void TransportBenchmark::Fail(ErrorCode const & error)
+{
+    {
+        AcquireWriteLock grab(errorLock_);
+        if (failed_.load()) return;
+
+        Trace.WriteWarning(TraceType, "{0} benchmark failed: {1}", BenchmarkTransport::ToString(transport_), error);
+        error_ = error;
+        failed_.store(true);
+    }
+
+    warmedUp_.Set();
+    allReceived_.Set();
+}
+
+void TransportBenchmark::OnMessageReceived(Message & message)
+{
+    auto now = Stopwatch::Now().Ticks;
+
+    uint headersFound = 0;
+    for (auto header = message.Headers.Begin(); header != message.Headers.End(); ++header)
+    {
+        if (header->Id() == BenchmarkHeader::Id)
+        {
+            header->Deserialize<BenchmarkHeader>();
+            ++headersFound;
+        }
+    }
+
+    BenchmarkBody body;
+    if (!message.GetBody(body) || (body.PayloadSize() != messageSize_) || (headersFound != headerCount_))
+    {
+        ++failureCount_;
+    }
+
+    if (!measuring_.load())
+    {
+        warmedUp_.Set();
+        return;
+    }
+
+    receivedBytes_ += message.SerializedSize();
+
+    auto index = receivedCount_++;
+    latencyTicks_[index] = now - body.SendTicks();
+    if ((index + 1) == expectedCount_)
+    {
+        allReceived_.Set();
+    }
+}
+
+void TransportBenchmark::SendLoop()
+{
+    auto inFlightLimit = (uint64)window_ * senderCount_;
+    for (uint i = 0; i < messageCount_; ++i)
+    {
+        while (((sentCount_.load() - receivedCount_.load()) >= inFlightLimit) && !failed_.load())
+        {
+            this_thread::yield();
+        }
+
+        if (failed_.load() || !Send(CreateMessage(++sentCount_)).IsSuccess())
+        {
+            return;
+        }
+    }
+}
+
+ErrorCode TransportBenchmark::Run()
+{
+    if ((transport_ != BenchmarkTransport::Tcp) && (securityProvider_ != SecurityProvider::None))
+    {
+        console.WriteLine("{0}: security provider {1} is only applied to tcp", BenchmarkTransport::ToString(transport_), securityProvider_);
+    }
+
+    Trace.WriteInfo(TraceType, "starting {0} benchmark", BenchmarkTransport::ToString(transport_));
+    Open();
+
+    // warm-up, connection setup and security negotiation are not measured
+    Send(CreateMessage(0));
+    if (!warmedUp_.WaitOne(TimeSpan::FromMinutes(1)))
+    {
+        Fail(ErrorCodeValue::Timeout);
+    }
+
+    if (failed_.load())
+    {
+        Close();
+        return error_;
+    }
+
+    measuring_.store(true);
+
+    auto cpuTicksBefore = GetProcessCpuTicks();
+    Stopwatch stopwatch;
+    stopwatch.Start();
+
+    vector<thread> senders;
+    for (uint i = 0; i < senderCount_; ++i)
+    {
+        senders.push_back(thread([this] { SendLoop(); }));
+    }
+
+    for (auto & sender : senders)
+    {
+        sender.join();
+    }
+
+    if (!allReceived_.WaitOne(TimeSpan::FromMinutes(10)))
+    {
+        Fail(ErrorCodeValue::Timeout);
+    }
+
+    stopwatch.Stop();
+    auto cpuTicks = GetProcessCpuTicks() - cpuTicksBefore;
+
+    Close();
+    if (failed_.load())
+    {
+        return error_;
+    }
+
+    WriteResult(stopwatch.Elapsed, cpuTicks);
+    return ErrorCode();
+}
+
+void TransportBenchmark::WriteResultColumns()
+{
+    console.WriteLine("transport,security,size,headers,senders,messages,msg/s,MB/s,p50(us),p99(us),p999(us),cpu/msg(us),failures");
+}
+
+void TransportBenchmark::WriteResult(TimeSpan elapsed, int64 cpuTicks)
+{
+    sort(latencyTicks_.begin(), latencyTicks_.end());
+    auto percentileMicroseconds = [this](double percentile)
+    {
+        auto index = min<size_t>((size_t)(percentile * latencyTicks_.size()), latencyTicks_.size() - 1);
+        return (double)latencyTicks_[index] / TimeSpan::TicksPerMillisecond * 1000;
+    };
+
+    auto seconds = elapsed.TotalMillisecondsAsDouble() / 1000;
+    auto messagesPerSecond = expectedCount_ / seconds;
+    auto megabytesPerSecond = receivedBytes_.load() / seconds / (1024 * 1024);
+    auto cpuMicrosecondsPerMessage = (double)cpuTicks / TimeSpan::TicksPerMillisecond * 1000 / expectedCount_;
+
+    auto result = formatString(
+        "{0},{1},{2},{3},{4},{5},{6},{7},{8},{9},{10},{11},{12}",
+        BenchmarkTransport::ToString(transport_),
+        (transport_ == BenchmarkTransport::Tcp) ? securityProvider_ : SecurityProvider::None,
+        messageSize_,
+        headerCount_,
+        senderCount_,
+        expectedCount_,
+        (int64)messagesPerSecond,
+        megabytesPerSecond,
+        percentileMicroseconds(0.5),
+        percentileMicroseconds(0.99),
+        percentileMicroseconds(0.999),
+        cpuMicrosecondsPerMessage,
+        failureCount_.load());
+
+    console.WriteLine("{0}", result);
+    Trace.WriteInfo(TraceType, "{0}", result);
+}
+
+void TransportBenchmark::ParseCmdline(int argc, wchar_t* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        wstring arg(argv[i]);
+        vector<wstring> tokens;
+        StringUtility::Split<wstring>(arg, tokens, L":");
+        if ((tokens.size() != 2) || !StringUtility::StartsWith(tokens.front(), L"-"))
+        {
+            console.WriteLine("arg[{0}] = '{1}', token count = {2}, 2 expected", i, arg, tokens.size());
+            PrintUsageAndExit();
+        }
+
+        if (StringUtility::AreEqualCaseInsensitive(tokens.front(), transportArg))
+        {
+            if (StringUtility::AreEqualCaseInsensitive(tokens[1], L"all"))
+            {
+                continue;
+            }
+
+            transports_.clear();
+            vector<wstring> names;
+            StringUtility::Split<wstring>(tokens[1], names, L",");
+            for (auto const & name : names)
+            {
+                if (StringUtility::AreEqualCaseInsensitive(name, BenchmarkTransport::ToString(BenchmarkTransport::Tcp)))
+                {
+                    transports_.push_back(BenchmarkTransport::Tcp);
+                }
+                else if (StringUtility::AreEqualCaseInsensitive(name, BenchmarkTransport::ToString(BenchmarkTransport::Ipc)))
+                {
+                    transports_.push_back(BenchmarkTransport::Ipc);
+                }
+                else if (StringUtility::AreEqualCaseInsensitive(name, BenchmarkTransport::ToString(BenchmarkTransport::Memory)))
+                {
+                    transports_.push_back(BenchmarkTransport::Memory);
+                }
+                else
+                {
+                    console.WriteLine("Failed to parse '{0}' as transport", name);
+                    PrintUsageAndExit();
+                }
+            }
+            continue;
+        }
+
+        if (StringUtility::AreEqualCaseInsensitive(tokens.front(), securityArg))
+        {
+            if (!SecurityProvider::FromCredentialType(tokens[1], securityProvider_).IsSuccess())
+            {
+                console.WriteLine("Failed to parse '{0}' as SecurityProvider", tokens[1]);
+                PrintUsageAndExit();
+            }
+            continue;
+        }
+
+        uint * value = nullptr;
+        if (StringUtility::AreEqualCaseInsensitive(tokens.front(), sizeArg)) value = &messageSize_;
+        else if (StringUtility::AreEqualCaseInsensitive(tokens.front(), headersArg)) value = &headerCount_;
+        else if (StringUtility::AreEqualCaseInsensitive(tokens.front(), sendersArg)) value = &senderCount_;
+        else if (StringUtility::AreEqualCaseInsensitive(tokens.front(), countArg)) value = &messageCount_;
+        else if (StringUtility::AreEqualCaseInsensitive(tokens.front(), windowArg)) value = &window_;
+        else PrintUsageAndExit();
+
+        if (!StringUtility::TryFromWString(tokens[1], *value))
+        {
+            console.WriteLine("Failed to parse '{0}' as {1}", tokens[1], tokens.front());
+            PrintUsageAndExit();
+        }
+    }
+
+    if ((senderCount_ == 0) || (messageCount_ == 0) || (window_ == 0))
+    {
+        console.WriteLine("{0}, {1} and {2} must be positive", sendersArg, countArg, windowArg);
+        ::ExitProcess(1);
+    }
+}
+
+void TransportBenchmark::PrintUsageAndExit()
+{
+    console.WriteLine("Usage: {0} [-option:value] ...", Path::GetFileName(Environment::GetExecutableFileName()));
+    console.WriteLine("{0}:comma separated list of tcp, ipc and mem, default to all", transportArg);
+    console.WriteLine("{0}:security provider for tcp, e.g. None or X509 (SSL), default to None", securityArg);
+    console.WriteLine("{0}:message body size in bytes, default to {1}", sizeArg, messageSizeDefault);
+    console.WriteLine("{0}:number of extra message headers, default to {1}", headersArg, headerCountDefault);
+    console.WriteLine("{0}:number of concurrent sender threads, default to {1}", sendersArg, senderCountDefault);
+    console.WriteLine("{0}:number of messages per sender thread, default to {1}", countArg, messageCountDefault);
+    console.WriteLine("{0}:maximal messages in flight per sender thread, default to {1}", windowArg, windowDefault);
+
+    ::ExitProcess(1);
+}
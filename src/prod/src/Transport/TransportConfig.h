@@ -113,6 +113,10 @@ namespace Transport
 
         // The time Ipc server and client connection needs to remain idle before TCP starts sending keepalive probes.
         INTERNAL_CONFIG_ENTRY(Common::TimeSpan, L"Transport", IpcKeepaliveIdleTime, Common::TimeSpan::FromSeconds(5), Common::ConfigEntryUpgradePolicy::Static);
+        // Size of each direction's shared memory ring between IpcClient and IpcServer on Linux, rounded up to a power of 2.
+        // Messages larger than half of it are sent over TCP, in order with the ring. Pending sends that do not fit into a
+        // full ring are bounded by the ring size. 0 disables shared memory and all messages go over TCP.
+        INTERNAL_CONFIG_ENTRY(uint, L"Transport", IpcSharedMemoryRingSize, 0, Common::ConfigEntryUpgradePolicy::Static);
 
         // Default close delay for scheduled close
         DEPRECATED_CONFIG_ENTRY(Common::TimeSpan, L"Transport", DefaultCloseDelay, Common::TimeSpan::FromSeconds(60), Common::ConfigEntryUpgradePolicy::Dynamic, Common::TimeSpanNoLessThan(Common::TimeSpan::Zero));
@@ -145,6 +149,9 @@ namespace Transport
         DEPRECATED_CONFIG_ENTRY(uint, L"Transport", EventLoopConcurrency, 0, Common::ConfigEntryUpgradePolicy::Static);
         // Cleanup delay for fd context used in event loop
         DEPRECATED_CONFIG_ENTRY(Common::TimeSpan, L"Transport", EventLoopCleanupDelay, Common::TimeSpan::FromSeconds(120), Common::ConfigEntryUpgradePolicy::Static, Common::TimeSpanGreaterThan(Common::TimeSpan::Zero));
+        // Use io_uring instead of epoll for socket IO in the transport event loop pool, linux only,
+        // falls back to epoll when io_uring is not supported by kernel
+        INTERNAL_CONFIG_ENTRY(bool, L"Transport", EventLoopIoUringEnabled, false, Common::ConfigEntryUpgradePolicy::Static);
         // Enable support for Unreliable over IPC
         INTERNAL_CONFIG_ENTRY(bool, L"Transport", UseUnreliableForRequestReply, false, Common::ConfigEntryUpgradePolicy::Static);
         // For testing IPv6 usage.  If true, transport will fail open if the endpoint is not an IPv6 address
@@ -155,5 +162,28 @@ namespace Transport
 
         // Default setting for error checking on message header and body in non-secure mode, component setting overrides this
         PUBLIC_CONFIG_ENTRY(bool, L"Transport", MessageErrorCheckingEnabled, false, Common::ConfigEntryUpgradePolicy::Static);
+
+        // Whether to compress message body with LZ4 on connections where remote side also supports it,
+        // support is advertised in ListenInstance message, so both sides must enable this to compress
+        INTERNAL_CONFIG_ENTRY(bool, L"Transport", FrameCompressionEnabled, false, Common::ConfigEntryUpgradePolicy::Static);
+        // Whether to also compress frames that will be encrypted, disabled by default as compression before
+        // encryption may reveal information about plaintext through ciphertext length
+        INTERNAL_CONFIG_ENTRY(bool, L"Transport", FrameCompressionOnSecureConnectionEnabled, false, Common::ConfigEntryUpgradePolicy::Static);
+        // Messages with body smaller than this are not compressed
+        INTERNAL_CONFIG_ENTRY(uint, L"Transport", FrameCompressionThreshold, 4096, Common::ConfigEntryUpgradePolicy::Dynamic);
+        // Compressed body is sent only if it saves at least this percentage of uncompressed body size
+        INTERNAL_CONFIG_ENTRY(uint, L"Transport", FrameCompressionMinSavingPercent, 10, Common::ConfigEntryUpgradePolicy::Dynamic, Common::InRange<uint>(0, 100));
+        // Number of eligible frames to send without trying compression, after a frame failed to reach FrameCompressionMinSavingPercent,
+        // this bounds CPU wasted on incompressible traffic, e.g. already compressed or encrypted application data
+        INTERNAL_CONFIG_ENTRY(uint, L"Transport", FrameCompressionBypassCount, 32, Common::ConfigEntryUpgradePolicy::Dynamic);
+
+        // When enabled, concurrent SendOneWay calls on the same connection hand messages over through a lock-free queue,
+        // only one sender at a time takes the connection lock to move them into send buffer. Contending senders check send
+        // queue limit against the last send buffer size published under the connection lock, so the limit is approximate.
+        INTERNAL_CONFIG_ENTRY(bool, L"Transport", LockFreeSendQueueEnabled, false, Common::ConfigEntryUpgradePolicy::Static);
+
+        // Linux only, message bodies of at least this size are sent with MSG_ZEROCOPY on unencrypted frames,
+        // instead of being copied into kernel socket buffer. 0 disables zero-copy send, 64 KB is a reasonable start.
+        INTERNAL_CONFIG_ENTRY(uint, L"Transport", ZeroCopySendThreshold, 0, Common::ConfigEntryUpgradePolicy::Static);
     };
 }
@@ -0,0 +1,178 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+#include <linux/errqueue.h>
+
+// older glibc and kernel headers do not define these yet
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+using namespace Transport;
+using namespace Common;
+using namespace std;
+
+namespace
+{
+    const StringLiteral TraceType("ZeroCopySend");
+}
+
+unique_ptr<ZeroCopySendTracker> ZeroCopySendTracker::Create(int fd, wstring const & traceId)
+{
+    int enable = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) < 0)
+    {
+        WriteInfo(TraceType, traceId, "SO_ZEROCOPY not enabled: {0}", ErrorCode::FromErrno());
+        return nullptr;
+    }
+
+    return unique_ptr<ZeroCopySendTracker>(new ZeroCopySendTracker(traceId));
+}
+
+ZeroCopySendTracker::ZeroCopySendTracker(wstring const & traceId) : traceId_(traceId)
+{
+}
+
+ZeroCopySendTracker::~ZeroCopySendTracker()
+{
+    // Connection objects are only destroyed after cleanup delay, kernel no longer needs the retained messages
+    for (auto & retained : retained_)
+    {
+        for (auto & message : retained.Messages)
+        {
+            Release(move(message));
+        }
+    }
+}
+
+ssize_t ZeroCopySendTracker::Send(int fd, iovec const * iov, int iovCount)
+{
+    msghdr msg = {};
+    msg.msg_iov = const_cast<iovec*>(iov);
+    msg.msg_iovlen = iovCount;
+
+    auto sent = sendmsg(fd, &msg, MSG_ZEROCOPY);
+    if (sent >= 0)
+    {
+        ++nextSequence_;
+        return sent;
+    }
+
+    if (errno == ENOBUFS)
+    {
+        // locked page limit (optmem) is reached until some zero-copy sends complete
+        WriteNoise(TraceType, traceId_, "sendmsg(MSG_ZEROCOPY) returned ENOBUFS, copying instead");
+        return writev(fd, iov, iovCount);
+    }
+
+    return sent;
+}
+
+void ZeroCopySendTracker::Retain(MessageUPtr && message)
+{
+    if (!HasOutstandingSends())
+    {
+        Release(move(message));
+        return;
+    }
+
+    auto lastSequence = nextSequence_ - 1;
+    if (retained_.empty() || (retained_.back().LastSequence != lastSequence))
+    {
+        retained_.push_back(RetainedMessages{ lastSequence, vector<MessageUPtr>() });
+    }
+
+    retained_.back().Messages.emplace_back(move(message));
+}
+
+bool ZeroCopySendTracker::ProcessCompletions(int fd)
+{
+    bool onlyCompletions = true;
+    for (;;)
+    {
+        byte control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+        msghdr msg = {};
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        if (recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        {
+            if (errno == EINTR) continue;
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break; // error queue is drained
+
+            WriteInfo(TraceType, traceId_, "recvmsg(MSG_ERRQUEUE) failed: {0}", ErrorCode::FromErrno());
+            onlyCompletions = false;
+            break;
+        }
+
+        for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            bool isRecvErr =
+                ((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_RECVERR)) ||
+                ((cmsg->cmsg_level == SOL_IPV6) && (cmsg->cmsg_type == IPV6_RECVERR));
+            if (!isRecvErr) continue;
+
+            auto extendedErr = reinterpret_cast<sock_extended_err const*>(CMSG_DATA(cmsg));
+            if ((extendedErr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) || (extendedErr->ee_errno != 0))
+            {
+                WriteInfo(
+                    TraceType, traceId_,
+                    "error queue entry: origin = {0}, errno = {1}",
+                    extendedErr->ee_origin, extendedErr->ee_errno);
+
+                onlyCompletions = false;
+                continue;
+            }
+
+            // [ee_info, ee_data] is the range of completed sequences
+            WriteNoise(TraceType, traceId_, "completed: [{0}, {1}]", extendedErr->ee_info, extendedErr->ee_data);
+            completedSequence_ = extendedErr->ee_data + 1;
+
+            if ((extendedErr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) && !kernelCopied_)
+            {
+                WriteInfo(TraceType, traceId_, "kernel copied data of zero-copy send");
+                kernelCopied_ = true;
+            }
+        }
+    }
+
+    while (!retained_.empty() && (static_cast<int32>(retained_.front().LastSequence - completedSequence_) < 0))
+    {
+        for (auto & message : retained_.front().Messages)
+        {
+            Release(move(message));
+        }
+
+        retained_.pop_front();
+    }
+
+    return onlyCompletions;
+}
+
+void ZeroCopySendTracker::Release(MessageUPtr && message)
+{
+    if (message->HasSendStatusCallback())
+    {
+        auto msg = move(message);
+        msg->OnSendStatus(ErrorCodeValue::Success, move(msg));
+    }
+    else
+    {
+        message.reset();
+    }
+}
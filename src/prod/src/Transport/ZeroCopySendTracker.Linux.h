@@ -0,0 +1,54 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Transport
+{
+    // Tracks sends issued with MSG_ZEROCOPY on a socket. Kernel keeps reading from user memory after sendmsg returns,
+    // completion of zero-copy sendmsg calls is reported through socket error queue, in order for TCP. Messages whose
+    // body was sent zero-copy are retained until all zero-copy sends issued before they were consumed have completed.
+    // Not thread safe, callers synchronize with TcpConnection lock.
+    class ZeroCopySendTracker : public Common::TextTraceComponent<Common::TraceTaskCodes::Transport>
+    {
+        DENY_COPY(ZeroCopySendTracker);
+
+    public:
+        // Enables SO_ZEROCOPY on the socket, returns nullptr if it is not supported
+        static std::unique_ptr<ZeroCopySendTracker> Create(int fd, std::wstring const & traceId);
+
+        ~ZeroCopySendTracker();
+
+        // sendmsg with MSG_ZEROCOPY, copies with writev instead when kernel cannot pin more pages
+        ssize_t Send(int fd, iovec const * iov, int iovCount);
+
+        bool HasOutstandingSends() const { return nextSequence_ != completedSequence_; }
+        void Retain(MessageUPtr && message);
+
+        // Drains socket error queue until EAGAIN and releases messages whose sends have completed. Returns
+        // false if the queue could not be drained or held anything other than zero-copy completions.
+        bool ProcessCompletions(int fd);
+
+        // Kernel copied data instead of pinning pages, e.g. on loopback, zero-copy only adds overhead then
+        bool KernelCopied() const { return kernelCopied_; }
+
+    private:
+        explicit ZeroCopySendTracker(std::wstring const & traceId);
+
+        static void Release(MessageUPtr && message);
+
+        struct RetainedMessages
+        {
+            uint32 LastSequence;
+            std::vector<MessageUPtr> Messages;
+        };
+
+        std::wstring const traceId_;
+        std::deque<RetainedMessages> retained_;
+        uint32 nextSequence_ = 0; // kernel assigns sequence numbers to successful zero-copy sendmsg calls, starting from 0
+        uint32 completedSequence_ = 0; // all sequences before this have completed
+        bool kernelCopied_ = false;
+    };
+}
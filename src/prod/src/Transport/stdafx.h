@@ -16,12 +16,16 @@
 #include <ifaddrs.h>
 #include <sys/uio.h>
 #include <sys/epoll.h>
+#include <poll.h>
 #include <openssl/bio.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/ssl.h>
 #include "Common/CryptoUtility.Linux.h"
 #include "Transport/TransportSecurity.Linux.h"
+#include "Transport/ZeroCopySendTracker.Linux.h"
+#include "Transport/IpcSharedMemoryChannel.Linux.h"
+#include "Transport/IpcSharedMemoryTransport.Linux.h"
 #else
 #include <schannel.h>
 #include <Ws2tcpip.h>
@@ -36,6 +40,7 @@
 #include "Transport/TcpFrameHeader.h"
 #include "Transport/ListenInstance.h"
 #include "Transport/SecurityNegotiationHeader.h"
+#include "Transport/FrameCompressionHeader.h"
 #include "Transport/IConnection.h"
 #include "Transport/IoBuffer.h"
 #include "Transport/ReceiveBuffer.h"
@@ -164,6 +164,24 @@ namespace TStoreTests
             return bufferSptr;
         }
 
+        //
+        // Stores the value big-endian so that KBufferComparer orders the keys like the values.
+        //
+        KBuffer::SPtr MakeOrderedKey(__in int value)
+        {
+            KBuffer::SPtr bufferSPtr;
+            auto status = KBuffer::Create(sizeof(int), bufferSPtr, GetAllocator());
+            Diagnostics::Validate(status);
+
+            auto byteBuffer = (byte *)bufferSPtr->GetBuffer();
+            for (int i = 0; i < sizeof(int); i++)
+            {
+                byteBuffer[i] = static_cast<byte>(value >> (8 * (sizeof(int) - 1 - i)));
+            }
+
+            return bufferSPtr;
+        }
+
         bool IsSameBufferValue(
             __in KBuffer& buffer1,
             __in KBuffer& buffer2)
@@ -479,6 +497,7 @@ namespace TStoreTests
             CODING_ERROR_ASSERT(keyCheckpointFileSPtr->PropertiesSPtr->KeyCount == numberOfKeys);
             CODING_ERROR_ASSERT(keyCheckpointFileSPtr->PropertiesSPtr->FileId == 10);
             CODING_ERROR_ASSERT(keyCheckpointFileSPtr->PropertiesSPtr->KeysHandle->Offset == 0);
+            CODING_ERROR_ASSERT(keyCheckpointFileSPtr->PropertiesSPtr->KeyBlockIndexHandle == nullptr);
             int defaultBlockSize = BlockAlignedWriter<int, int>::DefaultBlockAlignmentSize;
             int blockItemPartSize = defaultBlockSize - KeyChunkMetadata::Size - sizeof(ULONG64);
 
@@ -1352,6 +1371,72 @@ namespace TStoreTests
             co_return;
         }
 
+        ktl::Awaitable<void> ValueCheckpointFile_CompressedValuesWriteAndRead_ShouldSucceed_Test()
+        {
+            KAllocator& allocator = GetAllocator();
+            KStringView filename = L"ValueCheckpointFile_CompressedValuesWriteAndRead_ShouldSucceed.txt";
+            KString::SPtr filePathToOpenSPtr = CreateFileString(filename, GetAllocator());
+
+            ULONG32 fileId = 10;
+            ValueCheckpointFile::SPtr fileSPtr = co_await ValueCheckpointFile::CreateAsync(*CreateTraceComponent(), *filePathToOpenSPtr, fileId, allocator);
+            fileSPtr->IsCompressed = true;
+
+            SharedBinaryWriter::SPtr bwSPtr = nullptr;
+            NTSTATUS status = SharedBinaryWriter::Create(allocator, bwSPtr);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            ktl::io::KFileStream::SPtr streamSPtr = co_await fileSPtr->StreamPoolSPtr->AcquireStreamAsync();
+
+            KArray<KSharedPtr<VersionedItem<int>>> itemList(allocator);
+            KArray<KBuffer::SPtr> valueList(allocator);
+
+            // Even values compress, odd values are below the compression threshold and are stored as is.
+            for (int i = 0; i < 100; i++)
+            {
+                ULONG32 valueSize = i % 2 == 0 ? 4096 : 16;
+                BinaryWriter br(allocator);
+                for (ULONG32 j = 0; j < valueSize; j++)
+                {
+                    br.Write(static_cast<byte>((i + j / 64) % 256));
+                }
+
+                valueList.Append(br.GetBuffer(0));
+                KSharedPtr<VersionedItem<int>> itemSPtr = AddValuesInBytesWithInsertedVersionedItem(*streamSPtr, *bwSPtr, *fileSPtr, i, *br.GetBuffer(0));
+                itemList.Append(itemSPtr);
+
+                if (i % 2 == 0)
+                {
+                    CODING_ERROR_ASSERT(itemSPtr->GetValueSize() < static_cast<int>(valueSize));
+                }
+                else
+                {
+                    CODING_ERROR_ASSERT(itemSPtr->GetValueSize() == static_cast<int>(valueSize + sizeof(ULONG32)));
+                }
+
+                // Memory accounting uses the serialized size, not the size on disk.
+                CODING_ERROR_ASSERT(itemSPtr->GetInMemoryValueSize() == static_cast<int>(valueSize));
+            }
+
+            co_await fileSPtr->FlushAsync(*streamSPtr, *bwSPtr);
+            co_await fileSPtr->StreamPoolSPtr->ReleaseStreamAsync(*streamSPtr);
+
+            ValueCheckpointFile::SPtr valueCheckpointFileSPtr = co_await ValueCheckpointFile::OpenAsync(allocator, *filePathToOpenSPtr, *CreateTraceComponent());
+            CODING_ERROR_ASSERT(valueCheckpointFileSPtr != nullptr);
+            CODING_ERROR_ASSERT(valueCheckpointFileSPtr->IsCompressed);
+            CODING_ERROR_ASSERT(valueCheckpointFileSPtr->PropertiesSPtr->ValueCount == 100);
+
+            for (int i = 0; i < 100; i++)
+            {
+                KBuffer::SPtr val = co_await valueCheckpointFileSPtr->ReadValueAsync<int>(*itemList[i]);
+                CODING_ERROR_ASSERT(*valueList[i] == *val);
+            }
+
+            co_await fileSPtr->CloseAsync();
+            co_await valueCheckpointFileSPtr->CloseAsync();
+            RemoveFile(*filePathToOpenSPtr);
+            co_return;
+        }
+
         ktl::Awaitable<void> KeyBlockAlignedWriter_WriteOnKeyAndEnumerate_ShouldSucceed_Test()
         {
             //one int key item is 4 bytes of serialzied key size, 48 bytes data in total (44 is reserved for meta and padding)
@@ -1418,6 +1503,99 @@ namespace TStoreTests
             co_return;
         }
 
+        ktl::Awaitable<void> KeyBlockIndex_LoadAndRangeOffsets_ShouldSucceed_Test()
+        {
+            KAllocator& allocator = GetAllocator();
+            KStringView filename = L"KeyBlockIndexRangeOffsetTests.txt";
+            KString::SPtr filePathToOpenSPtr = CreateFileString(filename, GetAllocator());
+
+            KBufferSerializer::SPtr serializer = nullptr;
+            NTSTATUS status = KBufferSerializer::Create(allocator, serializer);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            KBufferComparer::SPtr comparerSPtr = nullptr;
+            status = KBufferComparer::Create(allocator, comparerSPtr);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            KeyCheckpointFile::SPtr fileSPtr = co_await KeyCheckpointFile::CreateAsync(*CreateTraceComponent(), *filePathToOpenSPtr, false, 10, allocator);
+            fileSPtr->IsKeyBlockIndexEnabled = true;
+
+            SharedBinaryWriter::SPtr bwSPtr = nullptr;
+            status = SharedBinaryWriter::Create(allocator, bwSPtr);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            ktl::io::KFileStream::SPtr streamSPtr = co_await fileSPtr->StreamPoolSPtr->AcquireStreamAsync();
+
+            KeyBlockAlignedWriter<KBuffer::SPtr, int>::SPtr keyWriterSPtr = nullptr;
+            status = KeyBlockAlignedWriter<KBuffer::SPtr, int>::Create(*streamSPtr, *fileSPtr, *bwSPtr, *serializer, 0, *CreateTraceComponent(), allocator, keyWriterSPtr);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            // Keys are written with even values so that odd values can be used as bounds between keys.
+            int numberOfKeys = 1200;
+            for (int i = 0; i < numberOfKeys; i++)
+            {
+                InsertedVersionedItem<int>::SPtr valueSPtr = nullptr;
+                status = InsertedVersionedItem<int>::Create(allocator, valueSPtr);
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+                valueSPtr->SetVersionSequenceNumber(i);
+                valueSPtr->SetValueSize(i);
+                valueSPtr->SetValueChecksum(i);
+                valueSPtr->SetOffset(i, *CreateTraceComponent());
+                VersionedItem<int>::SPtr item(&(*valueSPtr));
+                KeyValuePair<KBuffer::SPtr, VersionedItem<int>::SPtr> itemToAdd(MakeOrderedKey(i * 2), item);
+                co_await keyWriterSPtr->BlockAlignedWriteKeyAsync(itemToAdd);
+            }
+
+            co_await keyWriterSPtr->FlushAsync();
+            co_await fileSPtr->StreamPoolSPtr->ReleaseStreamAsync(*streamSPtr);
+
+            KeyCheckpointFile::SPtr keyCheckpointFileSPtr = co_await KeyCheckpointFile::OpenAsync(allocator, *filePathToOpenSPtr, *CreateTraceComponent(), true);
+            CODING_ERROR_ASSERT(keyCheckpointFileSPtr->PropertiesSPtr->KeyBlockIndexHandle != nullptr);
+
+            KeyBlockIndex<KBuffer::SPtr, int>::SPtr indexSPtr = co_await KeyBlockIndex<KBuffer::SPtr, int>::LoadAsync(
+                *keyCheckpointFileSPtr,
+                *serializer,
+                *comparerSPtr,
+                *CreateTraceComponent(),
+                allocator);
+            CODING_ERROR_ASSERT(indexSPtr != nullptr);
+
+            ULONG32 defaultBlockSize = BlockAlignedWriter<int, int>::DefaultBlockAlignmentSize;
+            CODING_ERROR_ASSERT(indexSPtr->BlockCount == keyCheckpointFileSPtr->PropertiesSPtr->KeysHandle->Size / defaultBlockSize);
+            CODING_ERROR_ASSERT(indexSPtr->BlockCount > 1);
+
+            BlockHandle::SPtr keysHandleSPtr = keyCheckpointFileSPtr->PropertiesSPtr->KeysHandle;
+            CODING_ERROR_ASSERT(IsSameBufferValue(*indexSPtr->GetFenceKey(0), *MakeOrderedKey(0)));
+
+            // The first key and a bound past the last key span the whole keys section.
+            CODING_ERROR_ASSERT(indexSPtr->GetRangeStartOffset(MakeOrderedKey(0)) == keysHandleSPtr->Offset);
+            CODING_ERROR_ASSERT(indexSPtr->GetRangeEndOffset(MakeOrderedKey(numberOfKeys * 2)) == keysHandleSPtr->EndOffset());
+
+            for (ULONG32 blockIndex = 1; blockIndex < indexSPtr->BlockCount; blockIndex++)
+            {
+                KBuffer::SPtr fenceKey = indexSPtr->GetFenceKey(blockIndex);
+                CODING_ERROR_ASSERT(comparerSPtr->Compare(indexSPtr->GetFenceKey(blockIndex - 1), fenceKey) < 0);
+
+                // A range split at a fence key ends exactly where the next range starts.
+                ULONG64 startOffset = indexSPtr->GetRangeStartOffset(fenceKey);
+                CODING_ERROR_ASSERT(startOffset == keysHandleSPtr->Offset + blockIndex * defaultBlockSize);
+                CODING_ERROR_ASSERT(indexSPtr->GetRangeEndOffset(fenceKey) == startOffset);
+            }
+
+            // A bound between two keys of the same block keeps that block in the ranges on both sides of it.
+            for (int i = 0; i < numberOfKeys; i++)
+            {
+                KBuffer::SPtr bound = MakeOrderedKey(i * 2 + 1);
+                ULONG64 startOffset = indexSPtr->GetRangeStartOffset(bound);
+                CODING_ERROR_ASSERT(indexSPtr->GetRangeEndOffset(bound) == startOffset + defaultBlockSize);
+            }
+
+            co_await fileSPtr->CloseAsync();
+            co_await keyCheckpointFileSPtr->CloseAsync();
+            RemoveFile(*filePathToOpenSPtr);
+            co_return;
+        }
+
         ktl::Awaitable<void> ValueBlockAlignedWrite_SingleKey_ShouldSucceed_Test()
         {
             ULONG32 bufferSize = 1024;
@@ -1633,6 +1811,11 @@ namespace TStoreTests
         SyncAwait(ValueCheckpointFile_Write100KeysAndReadAndVerifyMetadataUsingBytes_ShouldSucceed_Test());
     }
 
+    BOOST_AUTO_TEST_CASE(ValueCheckpointFile_CompressedValuesWriteAndRead_ShouldSucceed)
+    {
+        SyncAwait(ValueCheckpointFile_CompressedValuesWriteAndRead_ShouldSucceed_Test());
+    }
+
     BOOST_AUTO_TEST_CASE(KeyBlockAlignedWriter_WriteOnKeyAndEnumerate_ShouldSucceed)
     {
         SyncAwait(KeyBlockAlignedWriter_WriteOnKeyAndEnumerate_ShouldSucceed_Test());
@@ -1668,6 +1851,11 @@ namespace TStoreTests
         SyncAwait(KeyBlockAlignedWriter_WriteOneKeyLargerThanOneChunk_ShouldSucceed_Test());
     }
 
+    BOOST_AUTO_TEST_CASE(KeyBlockIndex_LoadAndRangeOffsets_ShouldSucceed)
+    {
+        SyncAwait(KeyBlockIndex_LoadAndRangeOffsets_ShouldSucceed_Test());
+    }
+
     //
     // ValueBlockAlignedWriterTests
     //
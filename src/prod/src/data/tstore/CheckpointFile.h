@@ -98,7 +98,9 @@ namespace Data
                __in KAllocator& allocator,
                __in StoreTraceComponent & traceComponent,
                __in StorePerformanceCountersSPtr & perfCounters,
-               __in bool isValueAReferenceType)
+               __in bool isValueAReferenceType,
+               __in bool compressValues = false,
+               __in bool writeKeyBlockIndex = false)
             {
                 SharedException::CSPtr exceptionSPtr = nullptr;
                 KSharedPtr<IEnumerator<KeyValuePair<TKey, KSharedPtr<VersionedItem<TValue>>>>> sortedItemDataSPtr(&sortedItemData);
@@ -117,6 +119,8 @@ namespace Data
 
                 KSharedPtr<KeyCheckpointFile> keyFileSPtr = co_await KeyCheckpointFile::CreateAsync(traceComponent, *keyFileNameSPtr, isValueAReferenceType, fileId, allocator);
                 ValueCheckpointFile::SPtr valueFileSPtr = co_await ValueCheckpointFile::CreateAsync(traceComponent, *valueFileNameSPtr, fileId, allocator);
+                valueFileSPtr->IsCompressed = compressValues;
+                keyFileSPtr->IsKeyBlockIndexEnabled = writeKeyBlockIndex;
 
                 KSharedPtr<CheckpointFile> checkpointFileSPtr = nullptr;
                 status = CheckpointFile::Create(filename, *keyFileSPtr, *valueFileSPtr, traceComponent, allocator, checkpointFileSPtr);
@@ -217,6 +221,17 @@ namespace Data
                 return valueCheckpointFileSPtr_->ReadValueAsync(item);
             }
 
+            //
+            // Read the given values from disk. The items must be sorted by offset.
+            //
+            template<typename TValue>
+            ktl::Awaitable<KSharedPtr<KSharedArray<TValue>>> ReadValuesAsync(
+                __in KSharedArray<KSharedPtr<VersionedItem<TValue>>>& items,
+                __in Data::StateManager::IStateSerializer<TValue>& valueSerializer)
+            {
+                return valueCheckpointFileSPtr_->ReadValuesAsync(items, valueSerializer);
+            }
+
             template<typename TKey, typename TValue>
             KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> GetAsyncEnumerator(
                 __in Data::StateManager::IStateSerializer<TKey>& keySerializer)
@@ -234,6 +249,51 @@ namespace Data
                  return enumeratorSPtr;
             }
 
+            //
+            // Enumerates only the key blocks that can hold keys in the given range.
+            // The caller still has to set the key range on the enumerator to filter the keys of the boundary blocks.
+            //
+            template<typename TKey, typename TValue>
+            KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> GetAsyncEnumerator(
+                __in Data::StateManager::IStateSerializer<TKey>& keySerializer,
+                __in KeyBlockIndex<TKey, TValue> const & keyBlockIndex,
+                __in bool hasLowerBound,
+                __in TKey const & lowerBound,
+                __in bool hasUpperBound,
+                __in TKey const & upperBound)
+            {
+                 ULONG64 startOffset = hasLowerBound ?
+                     keyBlockIndex.GetRangeStartOffset(lowerBound) :
+                     keyCheckpointFileSPtr_->PropertiesSPtr->KeysHandle->Offset;
+
+                 ULONG64 endOffset = hasUpperBound ?
+                     keyBlockIndex.GetRangeEndOffset(upperBound) :
+                     keyCheckpointFileSPtr_->PropertiesSPtr->KeysHandle->EndOffset();
+
+                 KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> enumeratorSPtr = nullptr;
+                 NTSTATUS status = KeyCheckpointFileAsyncEnumerator<TKey, TValue>::Create(
+                     *keyCheckpointFileSPtr_,
+                     keySerializer,
+                     startOffset,
+                     endOffset,
+                     *traceComponent_,
+                     GetThisAllocator(),
+                     enumeratorSPtr);
+                 Diagnostics::Validate(status);
+                 return enumeratorSPtr;
+            }
+
+            //
+            // Returns nullptr if the key checkpoint file was written without a key block index.
+            //
+            template<typename TKey, typename TValue>
+            ktl::Awaitable<KSharedPtr<KeyBlockIndex<TKey, TValue>>> LoadKeyBlockIndexAsync(
+                __in Data::StateManager::IStateSerializer<TKey>& keySerializer,
+                __in IComparer<TKey>& keyComparer)
+            {
+                return KeyBlockIndex<TKey, TValue>::LoadAsync(*keyCheckpointFileSPtr_, keySerializer, keyComparer, *traceComponent_, GetThisAllocator());
+            }
+
             ktl::Awaitable<void> CloseAsync()
             {
                 co_await keyCheckpointFileSPtr_->CloseAsync();
@@ -61,10 +61,66 @@ namespace Data
 
                 if (value.IsInMemory() == true)
                 {
-                   InterlockedAdd64(&size_, value.GetValueSize());
+                   InterlockedAdd64(&size_, value.GetInMemoryValueSize());
                 }
             }
 
+            //
+            // Bulk load path for keys that arrive in sorted order.
+            // Keys are written straight into a partition that is handed to the sorted list once it is full, so only the last key
+            // is compared and the per key search and bookkeeping of Add are skipped.
+            // The appended keys are not visible until CompleteAppendSorted is called.
+            //
+            void AppendSorted(__in TKey& key, __in VersionedItem<TValue>& value)
+            {
+                KInvariant(value.GetRecordKind() != RecordKind::DeletedVersion);
+                KSharedPtr<VersionedItem<TValue>> valueSPtr = &value;
+
+                if (pendingPartitionSPtr_ != nullptr)
+                {
+                    TKey lastKey = pendingPartitionSPtr_->GetKey(pendingPartitionSPtr_->Count() - 1);
+                    KInvariant(keyComparerSPtr_->Compare(lastKey, key) < 0);
+                }
+                else
+                {
+                    if (componentSPtr_->Count() > 0)
+                    {
+                        TKey lastKey = componentSPtr_->GetLastKey();
+                        KInvariant(keyComparerSPtr_->Compare(lastKey, key) < 0);
+                    }
+
+                    int maxSubListSize = componentSPtr_->MaxSubListSize;
+                    NTSTATUS status = Partition<TKey, KSharedPtr<VersionedItem<TValue>>>::Create(maxSubListSize, maxSubListSize, this->GetThisAllocator(), pendingPartitionSPtr_);
+                    Diagnostics::Validate(status);
+                }
+
+                pendingPartitionSPtr_->Add(key, valueSPtr);
+
+                if (value.IsInMemory() == true)
+                {
+                   InterlockedAdd64(&size_, value.GetInMemoryValueSize());
+                }
+
+                if (pendingPartitionSPtr_->Count() == componentSPtr_->MaxSubListSize)
+                {
+                    CompleteAppendSorted();
+                }
+            }
+
+            //
+            // Publishes the keys added by AppendSorted that are still in a partially filled partition.
+            //
+            void CompleteAppendSorted()
+            {
+                if (pendingPartitionSPtr_ == nullptr)
+                {
+                    return;
+                }
+
+                componentSPtr_->AppendPartition(*pendingPartitionSPtr_);
+                pendingPartitionSPtr_ = nullptr;
+            }
+
             void Update(__in TKey& key, VersionedItem<TValue>& value)
             {
                 auto existingValue = Read(key);
@@ -83,12 +139,12 @@ namespace Data
                    // Existing value might or might be in memory
                    if (existingValue->IsInMemory() == true)
                    {
-                      InterlockedAdd64(&size_, value.GetValueSize() - existingValue->GetValueSize());
+                      InterlockedAdd64(&size_, value.GetInMemoryValueSize() - existingValue->GetInMemoryValueSize());
                    }
                    else
                    {
                       // Just add the new size
-                      InterlockedAdd64(&size_, value.GetValueSize());
+                      InterlockedAdd64(&size_, value.GetInMemoryValueSize());
                    }
                 }
                 else
@@ -96,7 +152,7 @@ namespace Data
                    if (existingValue->IsInMemory() == true)
                    {
                       // Subtract the existing value
-                      InterlockedAdd64(&size_, -existingValue->GetValueSize());
+                      InterlockedAdd64(&size_, -existingValue->GetInMemoryValueSize());
                    }
                    else
                    {
@@ -169,12 +225,14 @@ namespace Data
 
         private:
             KSharedPtr<PartitionedSortedList<TKey, KSharedPtr<VersionedItem<TValue>>>> componentSPtr_;
+            KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
+            KSharedPtr<Partition<TKey, KSharedPtr<VersionedItem<TValue>>>> pendingPartitionSPtr_;
             ConsolidatedStoreComponent(__in IComparer<TKey>& keyComparer);
             LONG64 size_;
         };
 
         template <typename TKey, typename TValue>
-        ConsolidatedStoreComponent<TKey, TValue>::ConsolidatedStoreComponent(__in IComparer<TKey>& keyComparer) : size_(0)
+        ConsolidatedStoreComponent<TKey, TValue>::ConsolidatedStoreComponent(__in IComparer<TKey>& keyComparer) : size_(0), keyComparerSPtr_(&keyComparer)
         {
            NTSTATUS status = PartitionedSortedList<TKey, KSharedPtr<VersionedItem<TValue>>>::Create(keyComparer, this->GetThisAllocator(), componentSPtr_);
            this->SetConstructorStatus(status);
@@ -59,6 +59,47 @@ namespace Data
                numberOfDeltasToBeConsolidated_ = value;
             }
 
+            //
+            // Maximum number of key ranges merged in parallel, each into its own checkpoint file.
+            // Key ranges are split on the key block index, so values above 1 only take effect when the store
+            // enables EnableKeyBlockIndex and every merged file was written with it. Otherwise the merge is serial.
+            //
+            __declspec(property(get = get_MergeParallelism, put = set_MergeParallelism)) ULONG32 MergeParallelism;
+            ULONG32 get_MergeParallelism() const
+            {
+               return mergeParallelism_;
+            }
+
+            void set_MergeParallelism(__in ULONG32 value)
+            {
+               mergeParallelism_ = value;
+            }
+
+            __declspec(property(get = get_MinimumKeyBlocksPerMergePartition, put = set_MinimumKeyBlocksPerMergePartition)) ULONG32 MinimumKeyBlocksPerMergePartition;
+            ULONG32 get_MinimumKeyBlocksPerMergePartition() const
+            {
+               return minimumKeyBlocksPerMergePartition_;
+            }
+
+            void set_MinimumKeyBlocksPerMergePartition(__in ULONG32 value)
+            {
+               minimumKeyBlocksPerMergePartition_ = value;
+            }
+
+            //
+            // Write rate limit of a merge, across all of its key ranges. 0 means unlimited.
+            //
+            __declspec(property(get = get_MergeWriteBytesPerSecond, put = set_MergeWriteBytesPerSecond)) ULONG64 MergeWriteBytesPerSecond;
+            ULONG64 get_MergeWriteBytesPerSecond() const
+            {
+               return mergeWriteBytesPerSecond_;
+            }
+
+            void set_MergeWriteBytesPerSecond(__in ULONG64 value)
+            {
+               mergeWriteBytesPerSecond_ = value;
+            }
+
             // Exposed for testing
             __declspec(property(get = get_AggregatedStoreComponent)) KSharedPtr<AggregatedStoreComponent<TKey, TValue>> AggregatedStoreComponentSPtr;
             KSharedPtr<AggregatedStoreComponent<TKey, TValue>> get_AggregatedStoreComponent()
@@ -465,6 +506,25 @@ namespace Data
                cachedAggregratedStoreComponentSPtr->GetConsolidatedState()->Add(key, value);
             }
 
+            //
+            // Keys must be added in strictly increasing order, as recovery does, and are visible after CompleteAppendSorted.
+            //
+            void AppendSorted(__in TKey key, __in VersionedItem<TValue>& value)
+            {
+               auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
+               STORE_ASSERT(cachedAggregratedStoreComponentSPtr != nullptr, "cachedAggregratedStoreComponentSPtr != nullptr");
+
+               cachedAggregratedStoreComponentSPtr->GetConsolidatedState()->AppendSorted(key, value);
+            }
+
+            void CompleteAppendSorted()
+            {
+               auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
+               STORE_ASSERT(cachedAggregratedStoreComponentSPtr != nullptr, "cachedAggregratedStoreComponentSPtr != nullptr");
+
+               cachedAggregratedStoreComponentSPtr->GetConsolidatedState()->CompleteAppendSorted();
+            }
+
             virtual bool ContainsKey(__in TKey& key) const override
             {
                auto cachedAggregratedStoreComponentSPtr = aggregatedStoreComponentSPtr_.Get();
@@ -656,7 +716,7 @@ namespace Data
                      if (swept)
                      {
                         sweepCount++;
-                        consolidatedState->DecrementSize(versionedItem->GetValueSize());
+                        consolidatedState->DecrementSize(versionedItem->GetInMemoryValueSize());
                      }
                   }
                }
@@ -693,7 +753,7 @@ namespace Data
                      {
                         sweepCount++;
                         auto diffComponentSPtr = valuesForSweepEnumeratorSPtr->CurrentComponentSPtr;
-                        diffComponentSPtr->DecrementSize(versionedItem->GetValueSize());
+                        diffComponentSPtr->DecrementSize(versionedItem->GetInMemoryValueSize());
                      }
                   }
                }
@@ -710,8 +770,287 @@ namespace Data
                 __in ktl::CancellationToken const cancellationToken)
             {
                 StoreEventSource::Events->ConsolidationManagerMergeAsync(traceComponent_->PartitionId, traceComponent_->TraceTag, L"started");
-                
+
+                MetadataTable::SPtr mergeTableSPtr = &mergeTable;
+                KSharedPtr<ConsolidatedStoreComponent<TKey, TValue>> newConsolidatedStateSPtr = &newConsolidatedState;
+                KSharedArray<ULONG32>::SPtr listOfFileIdsSPtr = &listOfFileIds;
+                ktl::CancellationToken snappedToken = cancellationToken; // To get around compiler bug
+
                 PostMergeMetadataTableInformation::SPtr mergeMetadataTableInformationSPtr = nullptr;
+
+                KSharedArray<FileMetadata::SPtr>::SPtr mergedFilesSPtr = _new(CONSOLIDATIONMANAGER_TAG, this->GetThisAllocator()) KSharedArray<FileMetadata::SPtr>();
+                Diagnostics::Validate(mergedFilesSPtr);
+
+                MergeWriteThrottle::SPtr writeThrottleSPtr = nullptr;
+                NTSTATUS status = MergeWriteThrottle::Create(mergeWriteBytesPerSecond_, this->GetThisAllocator(), writeThrottleSPtr);
+                Diagnostics::Validate(status);
+
+                KSharedPtr<KSharedArray<KSharedPtr<KeyBlockIndex<TKey, TValue>>>> keyBlockIndexesSPtr = nullptr;
+                KSharedPtr<KSharedArray<TKey>> partitionBoundariesSPtr = co_await GetMergePartitionBoundariesAsync(*mergeTableSPtr, *listOfFileIdsSPtr, keyBlockIndexesSPtr);
+
+                if (partitionBoundariesSPtr->Count() == 0)
+                {
+                    FileMetadata::SPtr mergedFileMetadataSPtr = co_await MergeRangeAsync(
+                        *mergeTableSPtr,
+                        *listOfFileIdsSPtr,
+                        nullptr,
+                        *newConsolidatedStateSPtr,
+                        perfCounters,
+                        *writeThrottleSPtr,
+                        false,
+                        TKey(),
+                        false,
+                        TKey(),
+                        snappedToken);
+
+                    if (mergedFileMetadataSPtr != nullptr)
+                    {
+                        status = mergedFilesSPtr->Append(mergedFileMetadataSPtr);
+                        Diagnostics::Validate(status);
+                    }
+                }
+                else
+                {
+                    ULONG32 partitionCount = partitionBoundariesSPtr->Count() + 1;
+                    KArray<ktl::Awaitable<FileMetadata::SPtr>> partitionTasks(this->GetThisAllocator(), partitionCount);
+                    Diagnostics::Validate(partitionTasks.Status());
+
+                    for (ULONG32 i = 0; i < partitionCount; i++)
+                    {
+                        status = partitionTasks.Append(MergePartitionAsync(
+                            *mergeTableSPtr,
+                            *listOfFileIdsSPtr,
+                            *keyBlockIndexesSPtr,
+                            *partitionBoundariesSPtr,
+                            i,
+                            *newConsolidatedStateSPtr,
+                            perfCounters,
+                            *writeThrottleSPtr,
+                            snappedToken));
+                        Diagnostics::Validate(status);
+                    }
+
+                    // Every partition has to finish before the merge can either commit or clean up.
+                    SharedException::CSPtr exceptionCSPtr = nullptr;
+                    for (ULONG32 i = 0; i < partitionCount; i++)
+                    {
+                        try
+                        {
+                            FileMetadata::SPtr mergedFileMetadataSPtr = co_await partitionTasks[i];
+                            if (mergedFileMetadataSPtr != nullptr)
+                            {
+                                status = mergedFilesSPtr->Append(mergedFileMetadataSPtr);
+                                Diagnostics::Validate(status);
+                            }
+                        }
+                        catch (ktl::Exception const & e)
+                        {
+                            if (exceptionCSPtr == nullptr)
+                            {
+                                exceptionCSPtr = SharedException::Create(e, this->GetThisAllocator());
+                            }
+                        }
+                    }
+
+                    if (exceptionCSPtr != nullptr)
+                    {
+                        // The files of the partitions that did finish are not in any metadata table yet.
+                        for (ULONG32 i = 0; i < mergedFilesSPtr->Count(); i++)
+                        {
+                            FileMetadata::SPtr mergedFileMetadataSPtr = (*mergedFilesSPtr)[i];
+                            co_await mergedFileMetadataSPtr->CheckpointFileSPtr->CloseAsync();
+
+                            auto keyFileNameSPtr = CombinePaths(*consolidationProviderSPtr_->WorkingDirectoryCSPtr, *mergedFileMetadataSPtr->FileName, KeyCheckpointFile::GetFileExtension());
+                            auto valueFileNameSPtr = CombinePaths(*consolidationProviderSPtr_->WorkingDirectoryCSPtr, *mergedFileMetadataSPtr->FileName, ValueCheckpointFile::GetFileExtension());
+                            Common::File::Delete(keyFileNameSPtr->operator LPCWSTR(), true);
+                            Common::File::Delete(valueFileNameSPtr->operator LPCWSTR(), true);
+                        }
+
+                        auto exec = exceptionCSPtr->Info;
+                        throw exec;
+                    }
+                }
+
+                KSharedArray<ULONG32>::SPtr deletedFileIds = _new(CONSOLIDATIONMANAGER_TAG, this->GetThisAllocator()) KSharedArray<ULONG32>();
+                Diagnostics::Validate(deletedFileIds);
+                for (ULONG32 i = 0; i < listOfFileIdsSPtr->Count(); i++)
+                {
+                    status = deletedFileIds->Append((*listOfFileIdsSPtr)[i]);
+                    STORE_ASSERT(NT_SUCCESS(status), "unable to append file id to deleted file ids list");
+                }
+
+                // there could be deleted filed ids w/o a new merged file depending on invalid entries
+                status = PostMergeMetadataTableInformation::Create(*deletedFileIds, *mergedFilesSPtr, this->GetThisAllocator(), mergeMetadataTableInformationSPtr);
+                Diagnostics::Validate(status);
+
+                if (mergedFilesSPtr->Count() > 0)
+                {
+                    MetadataTable::SPtr mergedMetadataTableSPtr;
+                    MetadataTable::Create(this->GetThisAllocator(), mergedMetadataTableSPtr);
+                    for (ULONG32 i = 0; i < mergedFilesSPtr->Count(); i++)
+                    {
+                        FileMetadata::SPtr mergedFileMetadataSPtr = (*mergedFilesSPtr)[i];
+                        mergedMetadataTableSPtr->Table->Add(mergedFileMetadataSPtr->FileId, mergedFileMetadataSPtr);
+                    }
+
+                    consolidationProviderSPtr_->MergeMetadataTableSPtr = mergedMetadataTableSPtr;
+                }
+
+                STORE_ASSERT(mergeMetadataTableInformationSPtr != nullptr, "mergeMetadataTableInformationSPtr != nullptr");
+                STORE_ASSERT(mergeMetadataTableInformationSPtr->DeletedFileIdsSPtr != nullptr, "mergeMetadataTableInformationSPtr->DeletedFileIdsSPtr != nullptr");
+
+                StoreEventSource::Events->ConsolidationManagerMergeAsync(traceComponent_->PartitionId, traceComponent_->TraceTag, L"completed");
+
+                co_return mergeMetadataTableInformationSPtr;
+            }
+
+            //
+            // Splits the key space of the files being merged into ranges that are merged in parallel.
+            // Returns the exclusive upper bound of every range but the last, so no boundaries means a serial merge.
+            // The key block index of every file is returned in the order of listOfFileIds when the merge is partitioned.
+            //
+            ktl::Awaitable<KSharedPtr<KSharedArray<TKey>>> GetMergePartitionBoundariesAsync(
+                __in MetadataTable & mergeTable,
+                __in KSharedArray<ULONG32> & listOfFileIds,
+                __out KSharedPtr<KSharedArray<KSharedPtr<KeyBlockIndex<TKey, TValue>>>> & keyBlockIndexesSPtr)
+            {
+                MetadataTable::SPtr mergeTableSPtr = &mergeTable;
+                KSharedArray<ULONG32>::SPtr listOfFileIdsSPtr = &listOfFileIds;
+
+                KSharedPtr<KSharedArray<TKey>> boundariesSPtr = _new(CONSOLIDATIONMANAGER_TAG, this->GetThisAllocator()) KSharedArray<TKey>();
+                Diagnostics::Validate(boundariesSPtr);
+
+                keyBlockIndexesSPtr = nullptr;
+                if (mergeParallelism_ <= 1)
+                {
+                    co_return boundariesSPtr;
+                }
+
+                KSharedPtr<KSharedArray<KSharedPtr<KeyBlockIndex<TKey, TValue>>>> indexesSPtr = _new(CONSOLIDATIONMANAGER_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyBlockIndex<TKey, TValue>>>();
+                Diagnostics::Validate(indexesSPtr);
+
+                KSharedPtr<KeyBlockIndex<TKey, TValue>> largestIndexSPtr = nullptr;
+                for (ULONG32 i = 0; i < listOfFileIdsSPtr->Count(); i++)
+                {
+                    auto fileId = (*listOfFileIdsSPtr)[i];
+                    FileMetadata::SPtr fileMetadataSPtr = nullptr;
+                    bool found = mergeTableSPtr->Table->TryGetValue(fileId, fileMetadataSPtr);
+                    STORE_ASSERT(found, "fileId {1} should be in merge table", fileId);
+
+                    KSharedPtr<KeyBlockIndex<TKey, TValue>> indexSPtr = co_await fileMetadataSPtr->CheckpointFileSPtr->LoadKeyBlockIndexAsync<TKey, TValue>(
+                        *consolidationProviderSPtr_->KeyConverterSPtr,
+                        *consolidationProviderSPtr_->KeyComparerSPtr);
+
+                    // Files written without the key block index (EnableKeyBlockIndex off, or written before it existed)
+                    // can only be merged serially.
+                    if (indexSPtr == nullptr || indexSPtr->BlockCount == 0)
+                    {
+                        StoreEventSource::Events->ConsolidationManagerSerialMergeFallback(
+                            traceComponent_->PartitionId, traceComponent_->TraceTag,
+                            mergeParallelism_,
+                            fileId);
+
+                        co_return boundariesSPtr;
+                    }
+
+                    NTSTATUS status = indexesSPtr->Append(indexSPtr);
+                    Diagnostics::Validate(status);
+
+                    if (largestIndexSPtr == nullptr || indexSPtr->BlockCount > largestIndexSPtr->BlockCount)
+                    {
+                        largestIndexSPtr = indexSPtr;
+                    }
+                }
+
+                // The largest file holds most of the keys, so its fence keys split the merge into ranges of similar size.
+                ULONG32 blockCount = largestIndexSPtr->BlockCount;
+                ULONG32 minimumBlocksPerPartition = minimumKeyBlocksPerMergePartition_ == 0 ? 1 : minimumKeyBlocksPerMergePartition_;
+                ULONG32 partitionCount = blockCount / minimumBlocksPerPartition;
+                if (partitionCount > mergeParallelism_)
+                {
+                    partitionCount = mergeParallelism_;
+                }
+
+                if (partitionCount <= 1)
+                {
+                    co_return boundariesSPtr;
+                }
+
+                for (ULONG32 p = 1; p < partitionCount; p++)
+                {
+                    ULONG32 blockIndex = static_cast<ULONG32>((static_cast<ULONG64>(p) * blockCount) / partitionCount);
+                    NTSTATUS status = boundariesSPtr->Append(largestIndexSPtr->GetFenceKey(blockIndex));
+                    Diagnostics::Validate(status);
+                }
+
+                keyBlockIndexesSPtr = indexesSPtr;
+                co_return boundariesSPtr;
+            }
+
+            ktl::Awaitable<FileMetadata::SPtr> MergePartitionAsync(
+                __in MetadataTable & mergeTable,
+                __in KSharedArray<ULONG32> & listOfFileIds,
+                __in KSharedArray<KSharedPtr<KeyBlockIndex<TKey, TValue>>> & keyBlockIndexes,
+                __in KSharedArray<TKey> & partitionBoundaries,
+                __in ULONG32 partition,
+                __in ConsolidatedStoreComponent<TKey, TValue> & newConsolidatedState,
+                __in StorePerformanceCountersSPtr & perfCounters,
+                __in MergeWriteThrottle & writeThrottle,
+                __in ktl::CancellationToken const cancellationToken)
+            {
+                KSharedPtr<ConsolidationManager<TKey, TValue>> thisSPtr = this;
+                MetadataTable::SPtr mergeTableSPtr = &mergeTable;
+                KSharedArray<ULONG32>::SPtr listOfFileIdsSPtr = &listOfFileIds;
+                KSharedPtr<KSharedArray<KSharedPtr<KeyBlockIndex<TKey, TValue>>>> keyBlockIndexesSPtr = &keyBlockIndexes;
+                KSharedPtr<KSharedArray<TKey>> partitionBoundariesSPtr = &partitionBoundaries;
+                KSharedPtr<ConsolidatedStoreComponent<TKey, TValue>> newConsolidatedStateSPtr = &newConsolidatedState;
+                MergeWriteThrottle::SPtr writeThrottleSPtr = &writeThrottle;
+                ktl::CancellationToken snappedToken = cancellationToken; // To get around compiler bug
+
+                co_await ktl::CorHelper::ThreadPoolThread(this->GetThisKtlSystem().DefaultThreadPool());
+
+                bool hasLowerBound = partition > 0;
+                bool hasUpperBound = partition < partitionBoundariesSPtr->Count();
+
+                FileMetadata::SPtr mergedFileMetadataSPtr = co_await MergeRangeAsync(
+                    *mergeTableSPtr,
+                    *listOfFileIdsSPtr,
+                    keyBlockIndexesSPtr.RawPtr(),
+                    *newConsolidatedStateSPtr,
+                    perfCounters,
+                    *writeThrottleSPtr,
+                    hasLowerBound,
+                    hasLowerBound ? (*partitionBoundariesSPtr)[partition - 1] : TKey(),
+                    hasUpperBound,
+                    hasUpperBound ? (*partitionBoundariesSPtr)[partition] : TKey(),
+                    snappedToken);
+
+                co_return mergedFileMetadataSPtr;
+            }
+
+            //
+            // Merges the keys in [lowerBound, upperBound) of the given files into one new checkpoint file.
+            // Returns nullptr if none of the keys in the range had to be written.
+            //
+            ktl::Awaitable<FileMetadata::SPtr> MergeRangeAsync(
+                __in MetadataTable & mergeTable,
+                __in KSharedArray<ULONG32> & listOfFileIds,
+                __in_opt KSharedArray<KSharedPtr<KeyBlockIndex<TKey, TValue>>> * keyBlockIndexes,
+                __in ConsolidatedStoreComponent<TKey, TValue> & newConsolidatedState,
+                __in StorePerformanceCountersSPtr & perfCounters,
+                __in MergeWriteThrottle & writeThrottle,
+                __in bool hasLowerBound,
+                __in TKey lowerBound,
+                __in bool hasUpperBound,
+                __in TKey upperBound,
+                __in ktl::CancellationToken const cancellationToken)
+            {
+                KSharedPtr<ConsolidationManager<TKey, TValue>> thisSPtr = this;
+                KSharedPtr<KSharedArray<KSharedPtr<KeyBlockIndex<TKey, TValue>>>> keyBlockIndexesSPtr = keyBlockIndexes;
+                MergeWriteThrottle::SPtr writeThrottleSPtr = &writeThrottle;
+                bool isKeyRangeSet = hasLowerBound || hasUpperBound;
+
+                FileMetadata::SPtr mergedFileMetadataSPtr = nullptr;
                 KArray<KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>>> enumerators(this->GetThisAllocator());
                 SharedException::CSPtr exceptionCSPtr;
 
@@ -731,9 +1070,6 @@ namespace Data
                     KSharedPtr<ConsolidatedStoreComponent<TKey, TValue>> newConsolidatedStateSPtr = &newConsolidatedState;
                     KSharedArray<ULONG32>::SPtr listOfFileIdsSPtr = &listOfFileIds;
 
-                    // TODO: trace
-                    FileMetadata::SPtr mergedFileMetadataSPtr = nullptr;
-                    
                     KPriorityQueue<KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>>> priorityQueue(
                         this->GetThisAllocator(),
                         KeyCheckpointFileAsyncEnumerator<TKey, TValue>::CompareEnumerators);
@@ -746,18 +1082,42 @@ namespace Data
                         bool found = mergeTableSPtr->Table->TryGetValue(fileId, fileMetadataSPtr);
                         STORE_ASSERT(found, "fileId {1} should be in merge table", fileId);
 
-                        auto enumeratorSPtr = fileMetadataSPtr->CheckpointFileSPtr->GetAsyncEnumerator<TKey, TValue>(*consolidationProviderSPtr_->KeyConverterSPtr);
+                        KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> enumeratorSPtr = nullptr;
+                        if (isKeyRangeSet)
+                        {
+                            enumeratorSPtr = fileMetadataSPtr->CheckpointFileSPtr->GetAsyncEnumerator<TKey, TValue>(
+                                *consolidationProviderSPtr_->KeyConverterSPtr,
+                                *(*keyBlockIndexesSPtr)[i],
+                                hasLowerBound,
+                                lowerBound,
+                                hasUpperBound,
+                                upperBound);
+                        }
+                        else
+                        {
+                            enumeratorSPtr = fileMetadataSPtr->CheckpointFileSPtr->GetAsyncEnumerator<TKey, TValue>(*consolidationProviderSPtr_->KeyConverterSPtr);
+                        }
+
                         STORE_ASSERT(enumeratorSPtr != nullptr, "key checkpoint file enumerator should not be null");
                         enumeratorSPtr->KeyComparerSPtr = *consolidationProviderSPtr_->KeyComparerSPtr;
+                        if (isKeyRangeSet)
+                        {
+                            enumeratorSPtr->SetKeyRange(hasLowerBound, lowerBound, hasUpperBound, upperBound);
+                        }
 
                         // Prime the enumerator so it can be compared
                         auto hasNext = co_await enumeratorSPtr->MoveNextAsync(cancellationToken);
-                        STORE_ASSERT(hasNext, "enumerator should not be empty");
+                        STORE_ASSERT(hasNext || isKeyRangeSet, "enumerator should not be empty");
 
                         // Merge cannot be interrupted before enumerator is added here so races here can be ignored
                         auto status = enumerators.Append(enumeratorSPtr);
                         STORE_ASSERT(NT_SUCCESS(status), "unable to append enumerator to list of enumerators");
-                        priorityQueue.Push(enumeratorSPtr);
+
+                        // A file can have no keys in a partition's range.
+                        if (hasNext)
+                        {
+                            priorityQueue.Push(enumeratorSPtr);
+                        }
                     }
 
                     // Start writing a new filename
@@ -796,6 +1156,7 @@ namespace Data
                     Diagnostics::Validate(status);
 
                     CheckpointPerformanceCounterWriter checkpointPerfCounterWriter(perfCounters);
+                    ULONG64 writtenBytes = 0;
 
                     while (!priorityQueue.IsEmpty())
                     {
@@ -935,6 +1296,14 @@ namespace Data
                             
                             checkpointPerfCounterWriter.StopMeasurement();
 
+                            // The block aligned writer only reaches the file streams once a block is full.
+                            ULONG64 fileBytes = static_cast<ULONG64>(keyFileStreamSPtr->GetPosition()) + static_cast<ULONG64>(valueFileStreamSPtr->GetPosition());
+                            if (fileBytes > writtenBytes)
+                            {
+                                co_await writeThrottleSPtr->OnBytesWrittenAsync(fileBytes - writtenBytes);
+                                writtenBytes = fileBytes;
+                            }
+
                             if (kvpToWrite.Value->GetRecordKind() != RecordKind::DeletedVersion)
                             {
                                 // Copy-on-write the versioned value in-memory into the next consolidated state, to avoid taking locks.
@@ -1000,31 +1369,6 @@ namespace Data
                            traceComponent_->PartitionId, traceComponent_->TraceTag,
                            writeBytesPerSecond);
                     }
-
-                    KSharedArray<ULONG32>::SPtr deletedFileIds = _new(CONSOLIDATIONMANAGER_TAG, this->GetThisAllocator()) KSharedArray<ULONG32>();
-                    Diagnostics::Validate(deletedFileIds);
-                    for (ULONG32 i = 0; i < listOfFileIdsSPtr->Count(); i++)
-                    {
-                        status = deletedFileIds->Append((*listOfFileIdsSPtr)[i]);
-                        STORE_ASSERT(NT_SUCCESS(status), "unable to append file id to deleted file ids list");
-                    }
-
-                    if (mergedFileMetadataSPtr != nullptr)
-                    {
-                        status = PostMergeMetadataTableInformation::Create(*deletedFileIds, mergedFileMetadataSPtr, this->GetThisAllocator(), mergeMetadataTableInformationSPtr);
-                        Diagnostics::Validate(status);
-
-                        MetadataTable::SPtr mergedMetadataTableSPtr;
-                        MetadataTable::Create(this->GetThisAllocator(), mergedMetadataTableSPtr);
-                        mergedMetadataTableSPtr->Table->Add(mergedFileMetadataSPtr->FileId, mergedFileMetadataSPtr);
-                        consolidationProviderSPtr_->MergeMetadataTableSPtr = mergedMetadataTableSPtr;
-                    }
-                    else
-                    {
-                        // there could be deleted filed ids w/o a new merged file depending on invalid entries
-                        status = PostMergeMetadataTableInformation::Create(*deletedFileIds, nullptr, this->GetThisAllocator(), mergeMetadataTableInformationSPtr);
-                        Diagnostics::Validate(status);
-                    }
                 }
                 catch (ktl::Exception const & e)
                 {
@@ -1061,12 +1405,7 @@ namespace Data
                     throw exec;
                 }
 
-                STORE_ASSERT(mergeMetadataTableInformationSPtr != nullptr, "mergeMetadataTableInformationSPtr != nullptr");
-                STORE_ASSERT(mergeMetadataTableInformationSPtr->DeletedFileIdsSPtr != nullptr, "mergeMetadataTableInformationSPtr->DeletedFileIdsSPtr != nullptr");
-
-                StoreEventSource::Events->ConsolidationManagerMergeAsync(traceComponent_->PartitionId, traceComponent_->TraceTag, L"completed");
-
-                co_return mergeMetadataTableInformationSPtr;
+                co_return mergedFileMetadataSPtr;
             }
 
            void MovePreviousVersionItemsToSnapshotContainerIfNeeded(__in ULONG32 highestIndex, __in MetadataTable& metadataTable)
@@ -1180,6 +1519,8 @@ namespace Data
 
                keyFileSPtr = co_await KeyCheckpointFile::CreateAsync(*traceComponent_, *keyFileNameSPtr, consolidationProviderSPtr_->IsValueAReferenceType, fileId, this->GetThisAllocator());
                valueFileSPtr = co_await ValueCheckpointFile::CreateAsync(*traceComponent_, *valueFileNameSPtr, fileId, this->GetThisAllocator());
+               valueFileSPtr->IsCompressed = consolidationProviderSPtr_->EnableValueCompression;
+               keyFileSPtr->IsKeyBlockIndexEnabled = consolidationProviderSPtr_->EnableKeyBlockIndex;
 
                co_return fileId;
            }
@@ -1235,6 +1576,9 @@ namespace Data
             KSharedPtr<AggregatedStoreComponent<TKey, TValue>> newAggregatedStoreComponentSPtr_;
             KSpinLock indexLock_;
             ULONG32 numberOfDeltasToBeConsolidated_;
+            ULONG32 mergeParallelism_;
+            ULONG32 minimumKeyBlocksPerMergePartition_;
+            ULONG64 mergeWriteBytesPerSecond_;
             ULONG32 snapshotOfHighestIndexOnConsolidation_;
 
             StoreTraceComponent::SPtr traceComponent_;
@@ -1248,7 +1592,10 @@ namespace Data
            consolidationProviderSPtr_(&consolidationProvider),
            aggregatedStoreComponentSPtr_(nullptr),
            newAggregatedStoreComponentSPtr_(nullptr),
-           numberOfDeltasToBeConsolidated_(Constants::DefaultNumberOfDeltasTobeConsolidated)
+           numberOfDeltasToBeConsolidated_(Constants::DefaultNumberOfDeltasTobeConsolidated),
+           mergeParallelism_(Constants::DefaultMergeParallelism),
+           minimumKeyBlocksPerMergePartition_(Constants::DefaultMinimumKeyBlocksPerMergePartition),
+           mergeWriteBytesPerSecond_(Constants::DefaultMergeWriteBytesPerSecond)
         {
            KSharedPtr<AggregatedStoreComponent<TKey, TValue>> aggregatedStoreComponentSPtr = nullptr;
            NTSTATUS status = AggregatedStoreComponent<TKey, TValue>::Create(*consolidationProviderSPtr_->KeyComparerSPtr, traceComponent, this->GetThisAllocator(), aggregatedStoreComponentSPtr);
@@ -40,12 +40,35 @@ namespace Data
             static const ULONG32 MaxBackOffInMs = 4 * 1024;
 
             static const ULONG32 InitialRecoveryComponentSize = 1024 << 3;
+
+            //
+            // Default number of key chunks per key checkpoint file that recovery decodes concurrently.
+            // Parallel decode calls the user key serializer concurrently, so it is opt in.
+            //
+            static const ULONG32 DefaultRecoveryKeyDecodeParallelism = 1;
             
             //
             // Default number of delta components that can exist before checkpoint decides to consolidate.
             //
             static ULONG32 const DefaultNumberOfDeltasTobeConsolidated = 3;
 
+            //
+            // Default number of key range partitions a merge writes concurrently. 1 merges in a single pass.
+            // Parallel merge also requires the key block index, see Store::EnableKeyBlockIndex.
+            //
+            static const ULONG32 DefaultMergeParallelism = 1;
+
+            //
+            // Default number of key blocks the largest merged file must have for each partition of a parallel merge.
+            // Keeps small merges in a single pass and their output in a single file.
+            //
+            static const ULONG32 DefaultMinimumKeyBlocksPerMergePartition = 256;
+
+            //
+            // Default rate limit for the checkpoint file writes of a merge. 0 does not limit it.
+            //
+            static const ULONG64 DefaultMergeWriteBytesPerSecond = 0;
+
             static const LONG64 ZeroLsn = 0;
 
             static const LONG64 InvalidLsn = -1;
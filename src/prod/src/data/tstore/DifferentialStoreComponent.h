@@ -127,7 +127,7 @@ namespace Data
             if (differentialStateVersionsSPtr->get_CurrentVersion() == nullptr)
             {
                STORE_ASSERT(differentialStateVersionsSPtr->get_PreviousVersion() == nullptr, "Previous version should be null");
-               InterlockedAdd64(&size_, value.GetValueSize());
+               InterlockedAdd64(&size_, value.GetInMemoryValueSize());
                differentialStateVersionsSPtr->SetCurrentVersion(value);
             }
             else
@@ -139,7 +139,7 @@ namespace Data
                if (currentVersionSequenceNumber == nextVersionSequenceNumber)
                {
                   // Update the size with the difference with the existing current item
-                  InterlockedAdd64(&size_, value.GetValueSize() - differentialStateVersionsSPtr->CurrentVersionSPtr->GetValueSize());
+                  InterlockedAdd64(&size_, value.GetInMemoryValueSize() - differentialStateVersionsSPtr->CurrentVersionSPtr->GetInMemoryValueSize());
 
                   STORE_ASSERT(size_ >= 0, "Size {1} should not be negative", size_);
 
@@ -153,7 +153,7 @@ namespace Data
                if (differentialStateVersionsSPtr->get_PreviousVersion() == nullptr)
                {
                   // Increase by size of new current
-                  InterlockedAdd64(&size_, value.GetValueSize());
+                  InterlockedAdd64(&size_, value.GetInMemoryValueSize());
 
                   differentialStateVersionsSPtr->SetPreviousVersion(differentialStateVersionsSPtr->CurrentVersionSPtr);
                   differentialStateVersionsSPtr->SetCurrentVersion(value);
@@ -218,7 +218,7 @@ namespace Data
                   // Remove from differential state
 
                   // Increase by size of new current, decrease by size of old previous
-                  InterlockedAdd64(&size_, value.GetValueSize() - differentialStateVersionsSPtr->PreviousVersionSPtr->GetValueSize());
+                  InterlockedAdd64(&size_, value.GetInMemoryValueSize() - differentialStateVersionsSPtr->PreviousVersionSPtr->GetInMemoryValueSize());
 
                   STORE_ASSERT(size_ >= 0, "Size {1} should not be negative", size_);
 
@@ -64,6 +64,12 @@ namespace Data
             __declspec(property(get = get_EnableSweep)) bool EnableSweep;
             virtual bool get_EnableSweep() const = 0;
 
+            __declspec(property(get = get_EnableValueCompression)) bool EnableValueCompression;
+            virtual bool get_EnableValueCompression() const = 0;
+
+            __declspec(property(get = get_EnableKeyBlockIndex)) bool EnableKeyBlockIndex;
+            virtual bool get_EnableKeyBlockIndex() const = 0;
+
             __declspec(property(get = get_MergeHelper)) MergeHelper::SPtr MergeHelperSPtr;
             virtual MergeHelper::SPtr get_MergeHelper() const = 0;
 
@@ -55,6 +55,18 @@ namespace Data
                 __in Common::TimeSpan timeout, // If less than 0, then assumes infinite timeout
                 __in ktl::CancellationToken const & cancellationToken) noexcept = 0;
 
+            //
+            // Reads the given keys under a single prime lock acquisition, isolation level and visibility sequence number.
+            // values and exists are filled in the order of keys; a missing key has exists set to false.
+            //
+            virtual ktl::Awaitable<void> MultiGetAsync(
+                __in IStoreTransaction<TKey, TValue>& storeTransaction,
+                __in KArray<TKey> const & keys,
+                __in Common::TimeSpan timeout, // If less than 0, then assumes infinite timeout
+                __out KArray<KeyValuePair<LONG64, TValue>>& values,
+                __out KArray<bool>& exists,
+                __in ktl::CancellationToken const & cancellationToken) = 0;
+
             virtual ktl::Awaitable<KSharedPtr<Utilities::IAsyncEnumerator<KeyValuePair<TKey, KeyValuePair<LONG64, TValue>>>>> CreateEnumeratorAsync(
                 __in IStoreTransaction<TKey, TValue> & storeTransaction,
                 __in ReadMode readMode=ReadMode::ReadValue) = 0;
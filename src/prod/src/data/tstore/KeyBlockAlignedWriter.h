@@ -90,7 +90,7 @@ namespace Data
                     if (currentBlockPosition_ + keyRecordsize + ChecksumSize <=  blockAlignmentSize_)
                     {
                         // Do a mem copy.
-                        co_await CopyStreamAsync();
+                        co_await CopyStreamAsync(item.Key);
                     }
                     else
                     {
@@ -118,7 +118,7 @@ namespace Data
                         }
 
                         // Do a mem copy.
-                        co_await CopyStreamAsync();
+                        co_await CopyStreamAsync(item.Key);
                     }
                 }
                 else
@@ -143,7 +143,7 @@ namespace Data
                     GetBlockSize(keyRecordsize + ChecksumSize + KeyChunkMetadata::Size);
 
                     // Do a mem copy.
-                    co_await CopyStreamAsync();
+                    co_await CopyStreamAsync(item.Key);
                 }       
             }
 
@@ -174,10 +174,14 @@ namespace Data
 
         private:
 
-            ktl::Awaitable<void> CopyStreamAsync()
+            ktl::Awaitable<void> CopyStreamAsync(__in TKey const & key)
             {
                 if (currentBlockPosition_ == 0)
                 {
+                    // The first key of every block is its fence key in the sparse key block index.
+                    ULONG64 blockOffset = static_cast<ULONG64>(keyFileStreamSPtr_->GetPosition()) + keyBufferSPtr_->Position;
+                    keyCheckpointFileSPtr_->AddKeyBlockIndexEntry<TKey>(blockOffset, key, *keySerializerSPtr_);
+
                     ReserveSpaceForKeyBlockMetadata();
                 }
 
@@ -0,0 +1,236 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define KEYBLOCKINDEX_TAG 'xiBK'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // In-memory form of the sparse key block index of a key checkpoint file: the fence (first) key and file offset of every key block.
+        // Used to split a merge into key ranges without reading the keys.
+        //
+        template<typename TKey, typename TValue>
+        class KeyBlockIndex :
+            public KObject<KeyBlockIndex<TKey, TValue>>,
+            public KShared<KeyBlockIndex<TKey, TValue>>
+        {
+            K_FORCE_SHARED(KeyBlockIndex)
+
+        public:
+
+            //
+            // Returns nullptr if the key checkpoint file was written without a key block index.
+            //
+            static ktl::Awaitable<KSharedPtr<KeyBlockIndex<TKey, TValue>>> LoadAsync(
+                __in KeyCheckpointFile& keyCheckpointFile,
+                __in Data::StateManager::IStateSerializer<TKey>& keySerializer,
+                __in IComparer<TKey>& keyComparer,
+                __in StoreTraceComponent & traceComponent,
+                __in KAllocator& allocator)
+            {
+                KeyCheckpointFile::SPtr keyCheckpointFileSPtr = &keyCheckpointFile;
+                KSharedPtr<Data::StateManager::IStateSerializer<TKey>> keySerializerSPtr = &keySerializer;
+                KSharedPtr<IComparer<TKey>> keyComparerSPtr = &keyComparer;
+                StoreTraceComponent::SPtr traceComponentSPtr = &traceComponent;
+
+                KBuffer::SPtr indexBufferSPtr = co_await keyCheckpointFileSPtr->ReadKeyBlockIndexAsync();
+                if (indexBufferSPtr == nullptr)
+                {
+                    co_return nullptr;
+                }
+
+                KSharedPtr<KeyBlockIndex<TKey, TValue>> result = _new(KEYBLOCKINDEX_TAG, allocator)
+                    KeyBlockIndex(*keyCheckpointFileSPtr, *keySerializerSPtr, *keyComparerSPtr, *traceComponentSPtr);
+
+                if (!result)
+                {
+                    throw ktl::Exception(STATUS_INSUFFICIENT_RESOURCES);
+                }
+
+                Diagnostics::Validate(result->Status());
+
+                result->Read(*indexBufferSPtr);
+                co_return result;
+            }
+
+            __declspec(property(get = get_BlockCount)) ULONG32 BlockCount;
+            ULONG32 get_BlockCount() const
+            {
+                return blockOffsets_.Count();
+            }
+
+            TKey const & GetFenceKey(__in ULONG32 blockIndex) const
+            {
+                return fenceKeys_[blockIndex];
+            }
+
+            //
+            // Offset of the first key block that can contain keys greater than or equal to the given key.
+            //
+            ULONG64 GetRangeStartOffset(__in TKey const & lowerBound) const
+            {
+                LONG32 blockIndex = FindBlock(lowerBound);
+                return blockIndex < 0 ? blockOffsets_[0] : blockOffsets_[blockIndex];
+            }
+
+            //
+            // End offset of the last key block that can contain keys smaller than the given key.
+            //
+            ULONG64 GetRangeEndOffset(__in TKey const & upperBound) const
+            {
+                LONG32 blockIndex = FindBlock(upperBound);
+                if (blockIndex < 0)
+                {
+                    return blockOffsets_[0];
+                }
+
+                // A block whose fence key is the bound only holds keys at or after it.
+                if (keyComparerSPtr_->Compare(fenceKeys_[blockIndex], upperBound) == 0)
+                {
+                    return blockOffsets_[blockIndex];
+                }
+
+                return blockOffsets_[blockIndex] + GetAlignedBlockSize(static_cast<ULONG32>(blockIndex));
+            }
+
+        private:
+
+            KeyBlockIndex(
+                __in KeyCheckpointFile& keyCheckpointFile,
+                __in Data::StateManager::IStateSerializer<TKey>& keySerializer,
+                __in IComparer<TKey>& keyComparer,
+                __in StoreTraceComponent & traceComponent);
+
+            //
+            // Mirrors KeyCheckpointFile::AddKeyBlockIndexEntry and KeyCheckpointFile::WriteKeyBlockIndex.
+            //
+            void Read(__in KBuffer& indexBuffer)
+            {
+                BinaryReader reader(indexBuffer, this->GetThisAllocator());
+
+                ULONG32 blockCount = 0;
+                reader.Read(blockCount);
+                ByteAlignedReaderWriterHelper::ReadPaddingUntilAligned(reader); // RESERVED
+
+                for (ULONG32 i = 0; i < blockCount; i++)
+                {
+                    ULONG64 blockOffset = 0;
+                    reader.Read(blockOffset);
+
+                    ULONG32 keySize = 0;
+                    reader.Read(keySize);
+                    ByteAlignedReaderWriterHelper::ReadPaddingUntilAligned(reader); // RESERVED
+
+                    // Protection in case the user's key serializer doesn't leave the stream at the correct end point.
+                    ULONG32 keyPosition = reader.Position;
+                    TKey fenceKey = keySerializerSPtr_->Read(reader);
+                    reader.Position = keyPosition + keySize;
+                    ByteAlignedReaderWriterHelper::ReadPaddingUntilAligned(reader); // PADDING
+
+                    // Blocks are written in key order at increasing offsets.
+                    if (i > 0 && blockOffset <= blockOffsets_[i - 1])
+                    {
+                        throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+                    }
+
+                    NTSTATUS status = blockOffsets_.Append(blockOffset);
+                    Diagnostics::Validate(status);
+
+                    status = fenceKeys_.Append(fenceKey);
+                    Diagnostics::Validate(status);
+                }
+
+                STORE_ASSERT(reader.Position == indexBuffer.QuerySize(), "reader.Position={1} != index size={2}", reader.Position, indexBuffer.QuerySize());
+            }
+
+            //
+            // Returns the last block whose fence key is not greater than the key, or -1 if the key sorts before the first block.
+            //
+            LONG32 FindBlock(__in TKey const & key) const
+            {
+                LONG32 low = 0;
+                LONG32 high = static_cast<LONG32>(fenceKeys_.Count()) - 1;
+                LONG32 result = -1;
+
+                while (low <= high)
+                {
+                    LONG32 mid = low + (high - low) / 2;
+                    if (keyComparerSPtr_->Compare(fenceKeys_[mid], key) <= 0)
+                    {
+                        result = mid;
+                        low = mid + 1;
+                    }
+                    else
+                    {
+                        high = mid - 1;
+                    }
+                }
+
+                return result;
+            }
+
+            //
+            // Blocks are contiguous, so a block extends to the start of the next one or to the end of the keys section.
+            //
+            ULONG32 GetAlignedBlockSize(__in ULONG32 blockIndex) const
+            {
+                ULONG64 endOffset = blockIndex + 1 < blockOffsets_.Count() ?
+                    blockOffsets_[blockIndex + 1] :
+                    keyCheckpointFileSPtr_->PropertiesSPtr->KeysHandle->EndOffset();
+
+                ULONG64 blockSize = endOffset - blockOffsets_[blockIndex];
+                if (blockSize > MAXULONG32)
+                {
+                    throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+                }
+
+                return static_cast<ULONG32>(blockSize);
+            }
+
+            KeyCheckpointFile::SPtr keyCheckpointFileSPtr_;
+            KSharedPtr<Data::StateManager::IStateSerializer<TKey>> keySerializerSPtr_;
+            KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
+            StoreTraceComponent::SPtr traceComponent_;
+
+            KArray<TKey> fenceKeys_;
+            KArray<ULONG64> blockOffsets_;
+        };
+
+        template<typename TKey, typename TValue>
+        KeyBlockIndex<TKey, TValue>::KeyBlockIndex(
+            __in KeyCheckpointFile& keyCheckpointFile,
+            __in Data::StateManager::IStateSerializer<TKey>& keySerializer,
+            __in IComparer<TKey>& keyComparer,
+            __in StoreTraceComponent & traceComponent)
+            : keyCheckpointFileSPtr_(&keyCheckpointFile),
+            keySerializerSPtr_(&keySerializer),
+            keyComparerSPtr_(&keyComparer),
+            traceComponent_(&traceComponent),
+            fenceKeys_(this->GetThisAllocator()),
+            blockOffsets_(this->GetThisAllocator())
+        {
+            if (!NT_SUCCESS(fenceKeys_.Status()))
+            {
+                this->SetConstructorStatus(fenceKeys_.Status());
+                return;
+            }
+
+            if (!NT_SUCCESS(blockOffsets_.Status()))
+            {
+                this->SetConstructorStatus(blockOffsets_.Status());
+                return;
+            }
+        }
+
+        template<typename TKey, typename TValue>
+        KeyBlockIndex<TKey, TValue>::~KeyBlockIndex()
+        {
+        }
+    }
+}
@@ -20,7 +20,10 @@ KeyCheckpointFile::KeyCheckpointFile(
     isValueAReferenceType_(isValueAReferenceType),
     filenameSPtr_(&filename),
     fileSPtr_(&file),
-    traceComponent_(&component)
+    traceComponent_(&component),
+    keyBlockIndexWriterSPtr_(nullptr),
+    keyBlockCount_(0),
+    isKeyBlockIndexEnabled_(false)
 {
     StreamPool::StreamFactoryType fileStreamFactoryDelegate;
     fileStreamFactoryDelegate.Bind(this, &KeyCheckpointFile::CreateFileStreamAsync);
@@ -50,7 +53,10 @@ KeyCheckpointFile::KeyCheckpointFile(
     isValueAReferenceType_(isValueAReferenceType),
     filenameSPtr_(&filename),
     fileSPtr_(&file),
-    traceComponent_(&traceComponent)
+    traceComponent_(&traceComponent),
+    keyBlockIndexWriterSPtr_(nullptr),
+    keyBlockCount_(0),
+    isKeyBlockIndexEnabled_(false)
 {
     StreamPool::StreamFactoryType fileStreamFactoryDelegate;
     fileStreamFactoryDelegate.Bind(this, &KeyCheckpointFile::CreateFileStreamAsync);
@@ -262,6 +268,18 @@ ktl::Awaitable<void> KeyCheckpointFile::FlushAsync(
     Diagnostics::Validate(status);
     propertiesSPtr_->KeysHandle = *keysHandleSPtr;
 
+    // Write the sparse key block index, if the keys were written in blocks.
+    if (keyBlockCount_ > 0)
+    {
+        BlockHandle::SPtr keyBlockIndexHandleSPtr = nullptr;
+        FileBlock<KBuffer::SPtr>::SerializerFunc indexFunc(this, &KeyCheckpointFile::WriteKeyBlockIndex);
+        status = co_await FileBlock<KBuffer::SPtr>::WriteBlockAsync(*fileStreamSPtr, indexFunc, GetThisAllocator(), ktl::CancellationToken::None, keyBlockIndexHandleSPtr);
+        STORE_ASSERT(NT_SUCCESS(status), "Failed to write file block for key block index. Status: {1}", status);
+
+        propertiesSPtr_->KeyBlockIndexHandle = *keyBlockIndexHandleSPtr;
+        keyBlockIndexWriterSPtr_ = nullptr;
+    }
+
     // Write the Properties.
     BlockHandle::SPtr propertiesHandleSPtr = nullptr;
     FileBlock<KeyCheckpointFileProperties::SPtr>::SerializerFunc propfunc(propertiesSPtr_.RawPtr(), &KeyCheckpointFileProperties::Write);
@@ -304,6 +322,79 @@ ktl::Awaitable<void> KeyCheckpointFile::FlushMemoryBufferAsync(
 }
 
 
+void KeyCheckpointFile::WriteKeyBlockIndex(__in BinaryWriter& writer)
+{
+    STORE_ASSERT(keyBlockIndexWriterSPtr_ != nullptr, "key block index should not be null");
+    ULONG32 size = keyBlockIndexWriterSPtr_->Position;
+
+    // Fill in the reserved block count.
+    keyBlockIndexWriterSPtr_->Position = 0;
+    keyBlockIndexWriterSPtr_->Write(keyBlockCount_);
+    ByteAlignedReaderWriterHelper::WritePaddingUntilAligned(*keyBlockIndexWriterSPtr_); // RESERVED
+    keyBlockIndexWriterSPtr_->Position = size;
+
+    writer.Write(*keyBlockIndexWriterSPtr_->GetBuffer(0, size));
+}
+
+KBuffer::SPtr KeyCheckpointFile::ReadKeyBlockIndexBuffer(
+    __in BinaryReader& reader,
+    __in BlockHandle const & handle,
+    __in KAllocator& allocator)
+{
+    KBuffer::SPtr bufferSPtr = nullptr;
+    NTSTATUS status = KBuffer::Create(static_cast<ULONG>(handle.Size), bufferSPtr, allocator);
+    Diagnostics::Validate(status);
+
+    reader.Position = static_cast<ULONG>(handle.Offset);
+    reader.Read(static_cast<ULONG>(handle.Size), bufferSPtr);
+    return bufferSPtr;
+}
+
+ktl::Awaitable<KBuffer::SPtr> KeyCheckpointFile::ReadKeyBlockIndexAsync()
+{
+    BlockHandle::SPtr keyBlockIndexHandleSPtr = propertiesSPtr_->KeyBlockIndexHandle;
+    if (keyBlockIndexHandleSPtr == nullptr)
+    {
+        co_return nullptr;
+    }
+
+    ktl::io::KFileStream::SPtr filestreamSPtr = nullptr;
+    KBuffer::SPtr indexSPtr = nullptr;
+    SharedException::CSPtr exception = nullptr;
+
+    try
+    {
+        filestreamSPtr = co_await streamPool_->AcquireStreamAsync();
+
+        FileBlock<KBuffer::SPtr>::DeserializerFunc indexFunc(&KeyCheckpointFile::ReadKeyBlockIndexBuffer);
+        indexSPtr = co_await FileBlock<KBuffer::SPtr>::ReadBlockAsync(
+            *filestreamSPtr,
+            *keyBlockIndexHandleSPtr,
+            indexFunc,
+            GetThisAllocator(),
+            ktl::CancellationToken::None);
+    }
+    catch (ktl::Exception const& e)
+    {
+        exception = SharedException::Create(e, GetThisAllocator());
+    }
+
+    if (filestreamSPtr != nullptr && filestreamSPtr->IsOpen())
+    {
+        co_await streamPool_->ReleaseStreamAsync(*filestreamSPtr);
+        filestreamSPtr = nullptr;
+    }
+
+    if (exception != nullptr)
+    {
+        //clang compiler error, needs to assign before throw.
+        auto ex = exception->Info;
+        throw ex;
+    }
+
+    co_return indexSPtr;
+}
+
 ktl::Awaitable<void> KeyCheckpointFile::ReadMetadataAsync()
 {
     ktl::io::KFileStream::SPtr filestreamSPtr= nullptr;
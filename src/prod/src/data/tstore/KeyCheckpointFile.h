@@ -104,6 +104,19 @@ namespace Data
                 return filenameSPtr_.RawPtr();
             }
 
+            //
+            // Whether FlushAsync writes the sparse key block index. Off until a store reads keys through it.
+            //
+            __declspec(property(get = get_IsKeyBlockIndexEnabled, put = set_IsKeyBlockIndexEnabled)) bool IsKeyBlockIndexEnabled;
+            bool get_IsKeyBlockIndexEnabled() const
+            {
+                return isKeyBlockIndexEnabled_;
+            }
+            void set_IsKeyBlockIndexEnabled(__in bool value)
+            {
+                isKeyBlockIndexEnabled_ = value;
+            }
+
             __declspec(property(get = get_StreamPool)) StreamPool::SPtr StreamPoolSPtr;
             StreamPool::SPtr get_StreamPool() const
             {
@@ -135,6 +148,72 @@ namespace Data
                 WriteKey<TKey, TValue>(memoryBuffer, item, keySerializer, logicalTimeStamp);
             }
 
+            //
+            // BlockCount (int) and 4 bytes of reserved space at the start of the key block index.
+            //
+            static const ULONG32 KeyBlockIndexHeaderSize = sizeof(ULONG32) + 4;
+
+            //
+            // Records the file offset and the first (fence) key of a key block, so that a key can be found by reading a single block.
+            // The data is written is 8 bytes aligned.
+            // 
+            // Name                    Type        Size
+            // 
+            // BlockOffset             long        8
+            // KeySize                 int         4
+            // RESERVED                            4
+            // 
+            // Key                     TKey        N
+            // PADDING                             (N % 8 ==0) ? 0 : 8 - (N % 8)
+            //
+            template<typename TKey>
+            void AddKeyBlockIndexEntry(
+                __in ULONG64 blockOffset,
+                __in TKey const & fenceKey,
+                __in Data::StateManager::IStateSerializer<TKey>& keySerializer)
+            {
+                if (!isKeyBlockIndexEnabled_)
+                {
+                    return;
+                }
+
+                if (keyBlockIndexWriterSPtr_ == nullptr)
+                {
+                    NTSTATUS status = SharedBinaryWriter::Create(GetThisAllocator(), keyBlockIndexWriterSPtr_);
+                    Diagnostics::Validate(status);
+
+                    // Reserve space for the block count.
+                    keyBlockIndexWriterSPtr_->Position += KeyBlockIndexHeaderSize;
+                }
+
+                BinaryWriter & writer = *keyBlockIndexWriterSPtr_;
+                ByteAlignedReaderWriterHelper::AssertIfNotAligned(writer.Position);
+
+                writer.Write(blockOffset);
+
+                ULONG recordPosition = writer.Position;
+                writer.Position += sizeof(ULONG32);
+                ByteAlignedReaderWriterHelper::WritePaddingUntilAligned(writer); // RESERVED
+
+                ULONG keyPosition = writer.Position;
+                keySerializer.Write(fenceKey, writer);
+                ULONG keyEndPosition = writer.Position;
+                STORE_ASSERT(keyEndPosition >= keyPosition, "keyEndPosition={1} >= keyPosition={2}", keyEndPosition, keyPosition);
+
+                writer.Position = recordPosition;
+                writer.Write(static_cast<ULONG32>(keyEndPosition - keyPosition));
+                writer.Position = keyEndPosition;
+
+                ByteAlignedReaderWriterHelper::WritePaddingUntilAligned(writer); // PADDING
+                keyBlockCount_++;
+            }
+
+            //
+            // Reads the sparse key block index written by AddKeyBlockIndexEntry.
+            // Returns nullptr if the file was written without one.
+            //
+            ktl::Awaitable<KBuffer::SPtr> ReadKeyBlockIndexAsync();
+
             // 
             // A Flush indicates that all keys have been written to the checkpoint file (via AddItemAsync), so
             // the checkpoint file can finish flushing any remaining in-memory buffered data, write any extra
@@ -347,6 +426,13 @@ namespace Data
             //
             ktl::Awaitable<void> ReadMetadataAsync();
 
+            void WriteKeyBlockIndex(__in BinaryWriter& writer);
+
+            static KBuffer::SPtr ReadKeyBlockIndexBuffer(
+                __in BinaryReader& reader,
+                __in BlockHandle const & handle,
+                __in KAllocator& allocator);
+
             //
             // The currently supported key checkpoint file version.
             // 
@@ -369,6 +455,12 @@ namespace Data
 
             StoreTraceComponent::SPtr traceComponent_;
 
+            SharedBinaryWriter::SPtr keyBlockIndexWriterSPtr_;
+
+            ULONG32 keyBlockCount_;
+
+            bool isKeyBlockIndexEnabled_;
+
             //
             // Create a new key checkpoint file with the given filename.
             //
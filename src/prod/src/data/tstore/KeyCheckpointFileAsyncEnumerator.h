@@ -67,8 +67,57 @@ namespace Data
                 keyComparerSPtr_ = &value;
             }
 
+            //
+            // Number of chunks decoded concurrently on the thread pool ahead of the consumer.
+            // 1 (default) decodes every chunk inline when it is reached.
+            // Above 1 the key serializer reads keys of different chunks concurrently, so it must be thread safe.
+            //
+            __declspec(property(get = get_DecodeParallelism, put = set_DecodeParallelism)) ULONG32 DecodeParallelism;
+            ULONG32 get_DecodeParallelism() const
+            {
+                return decodeParallelism_;
+            }
+            void set_DecodeParallelism(__in ULONG32 value)
+            {
+                STORE_ASSERT(stateZero_, "DecodeParallelism must be set before enumeration starts");
+                decodeParallelism_ = value;
+            }
+
+            //
+            // Restricts the enumeration to keys greater than or equal to the lower bound and smaller than the upper bound.
+            // The offsets given on creation must cover all key blocks of the range. Requires the KeyComparer.
+            //
+            void SetKeyRange(
+                __in bool hasLowerBound,
+                __in TKey const & lowerBound,
+                __in bool hasUpperBound,
+                __in TKey const & upperBound)
+            {
+                STORE_ASSERT(stateZero_, "Key range must be set before enumeration starts");
+                STORE_ASSERT(keyComparerSPtr_ != nullptr, "Key range requires a key comparer");
+                hasLowerBound_ = hasLowerBound;
+                lowerBound_ = lowerBound;
+                hasUpperBound_ = hasUpperBound;
+                upperBound_ = upperBound;
+            }
+
             ktl::Awaitable<void> CloseAsync()
             {
+                // Decode tasks still reference this enumerator, let them drain.
+                // Their failures are not interesting once the enumeration is abandoned.
+                for (ULONG32 i = 0; i < decodeTasks_.Count(); i++)
+                {
+                    try
+                    {
+                        co_await decodeTasks_[i];
+                    }
+                    catch (ktl::Exception const &)
+                    {
+                    }
+                }
+
+                decodeTasks_.Clear();
+
                 if (fileStreamSPtr_ != nullptr && fileStreamSPtr_->IsOpen())
                 {
                     co_await keyCheckpointFileSPtr_->StreamPoolSPtr->ReleaseStreamAsync(*fileStreamSPtr_);
@@ -139,103 +188,165 @@ namespace Data
 
             ktl::Awaitable<bool> MoveNextAsync(__in ktl::CancellationToken const & cancellationToken) override
             {
-                // Starting from state zero.
-                if (stateZero_)
+                while (true)
                 {
-                    // Assert that startOffset - endOffset is a multiple of 4k
-                    stateZero_ = false;
-                    itemsBufferSPtr_ = _new(KEYCHECKPOINTASYNCENUMERATOR_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>();
-                    STORE_ASSERT(itemsBufferSPtr_ != nullptr, "itemsBufferSPtr_ should not be null");
-                    index_ = 0;
-
-                    // Call read keys and populate list.
-                    NTSTATUS status = KBuffer::Create(ChunkSize, memoryStreamSPtr_, this->GetThisAllocator());
-                    Diagnostics::Validate(status);
+                    bool hasKey = false;
 
-                    // Assert file stream is null;
-                    STORE_ASSERT(fileStreamSPtr_ == nullptr, "fileStreamSPtr_ == nullptr");
+                    // Starting from state zero.
+                    if (stateZero_)
+                    {
+                        // Assert that startOffset - endOffset is a multiple of 4k
+                        stateZero_ = false;
+                        itemsBufferSPtr_ = _new(KEYCHECKPOINTASYNCENUMERATOR_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>();
+                        STORE_ASSERT(itemsBufferSPtr_ != nullptr, "itemsBufferSPtr_ should not be null");
+                        index_ = 0;
 
-                    fileStreamSPtr_ = co_await keyCheckpointFileSPtr_->StreamPoolSPtr->AcquireStreamAsync();
-                    STORE_ASSERT(fileStreamSPtr_ != nullptr, "fileStreamSPtr_ != nullptr");
+                        // Assert file stream is null;
+                        STORE_ASSERT(fileStreamSPtr_ == nullptr, "fileStreamSPtr_ == nullptr");
 
-                    fileStreamSPtr_->Position = startOffset_;
-                    bool result = co_await ReadChunkAsync();
+                        fileStreamSPtr_ = co_await keyCheckpointFileSPtr_->StreamPoolSPtr->AcquireStreamAsync();
+                        STORE_ASSERT(fileStreamSPtr_ != nullptr, "fileStreamSPtr_ != nullptr");
 
-                    if (result)
-                    {
-                        current_ = (*itemsBufferSPtr_)[index_];
-                        co_return true;
+                        fileStreamSPtr_->Position = startOffset_;
+                        hasKey = co_await ReadChunkAsync();
                     }
                     else
                     {
-                        STORE_ASSERT(keyCount_ == keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount, "Key Counts differ. actual={1} expected={2}", keyCount_, keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount);
-                        co_return false;
-                    }
-                }
-                else
-                {
-                    index_++;
+                        index_++;
 
-                    // Check if it is in the buffer.
-                    if (static_cast<ULONG32>(index_) < itemsBufferSPtr_->Count())
-                    {
-                        current_ = (*itemsBufferSPtr_)[index_];
-                        co_return true;
-                    }
-                    else
-                    {
-                        // read next block
-                        bool result = co_await ReadChunkAsync();
-                        if (result)
+                        // Check if it is in the buffer.
+                        if (static_cast<ULONG32>(index_) < itemsBufferSPtr_->Count())
                         {
-                            current_ = (*itemsBufferSPtr_)[index_];
-                            co_return true;
+                            hasKey = true;
                         }
                         else
                         {
-                            STORE_ASSERT(keyCount_ == keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount, "Key counts differ. actual={1} expected={2}", keyCount_, keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount);
-                            co_return false;
+                            // read next block
+                            hasKey = co_await ReadChunkAsync();
                         }
                     }
+
+                    if (!hasKey)
+                    {
+                        STORE_ASSERT(IsKeyRangeSet() || keyCount_ == keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount, "Key counts differ. actual={1} expected={2}", keyCount_, keyCheckpointFileSPtr_->PropertiesSPtr->KeyCount);
+                        co_return false;
+                    }
+
+                    current_ = (*itemsBufferSPtr_)[index_];
+
+                    // The blocks at the edges of a key range also hold keys outside of it.
+                    if (hasLowerBound_ && keyComparerSPtr_->Compare(current_->Key, lowerBound_) < 0)
+                    {
+                        continue;
+                    }
+
+                    if (hasUpperBound_ && keyComparerSPtr_->Compare(current_->Key, upperBound_) >= 0)
+                    {
+                        co_return false;
+                    }
+
+                    co_return true;
                 }
             }
 
         private:
 
+            bool IsKeyRangeSet() const
+            {
+                return hasLowerBound_ || hasUpperBound_;
+            }
+
             ktl::Awaitable<bool> ReadChunkAsync()
             {
                 itemsBufferSPtr_->Clear();
                 index_ = 0;
 
+                KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> chunkItemsSPtr = nullptr;
+
+                if (decodeParallelism_ <= 1)
+                {
+                    KBuffer::SPtr chunkSPtr = co_await ReadRawChunkAsync();
+                    if (chunkSPtr == nullptr)
+                    {
+                        co_return false;
+                    }
+
+                    chunkItemsSPtr = DecodeChunk(*chunkSPtr);
+                }
+                else
+                {
+                    // Reading the file is sequential, only the decoding of the chunks read is parallelized.
+                    while (!isEndOfKeys_ && decodeTasks_.Count() < decodeParallelism_)
+                    {
+                        KBuffer::SPtr chunkSPtr = co_await ReadRawChunkAsync();
+                        if (chunkSPtr == nullptr)
+                        {
+                            isEndOfKeys_ = true;
+                            break;
+                        }
+
+                        NTSTATUS status = decodeTasks_.Append(DecodeChunkAsync(*chunkSPtr));
+                        Diagnostics::Validate(status);
+                    }
+
+                    if (decodeTasks_.Count() == 0)
+                    {
+                        co_return false;
+                    }
+
+                    // Chunks are handed out in file order.
+                    ktl::Awaitable<KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>>> decodeTask = Ktl::Move(decodeTasks_[0]);
+                    BOOLEAN removed = decodeTasks_.Remove(0);
+                    STORE_ASSERT(removed == TRUE, "Failed to remove the decoded chunk");
+
+                    chunkItemsSPtr = co_await decodeTask;
+                }
+
+                itemsBufferSPtr_ = chunkItemsSPtr;
+
+                // Track the number of keys returned.
+                keyCount_ += itemsBufferSPtr_->Count();
+
+                STORE_ASSERT(itemsBufferSPtr_->Count() > 0, "items buffer count={1} should be 0", itemsBufferSPtr_->Count());
+                co_return true;
+            }
+
+            //
+            // Reads the next chunk of whole key blocks into memory without decoding it.
+            // Returns nullptr once the end offset is reached.
+            //
+            ktl::Awaitable<KBuffer::SPtr> ReadRawChunkAsync()
+            {
                 // Pick a chunk size that is a multiple of 4k lesser than the end offset.
                 ULONG chunkSize = static_cast<ULONG>(GetChunkSize());
                 if (chunkSize == 0)
                 {
-                    co_return false;
+                    co_return nullptr;
                 }
 
                 // Read the entire chunk (plus the checksum and next chunk size) into memory.
-                NTSTATUS status = KBuffer::Create(chunkSize, memoryStreamSPtr_, this->GetThisAllocator());
+                KBuffer::SPtr chunkSPtr = nullptr;
+                NTSTATUS status = KBuffer::Create(chunkSize, chunkSPtr, this->GetThisAllocator());
                 Diagnostics::Validate(status);
 
                 ULONG startPosition = 0;
                 ULONG bytesRead = 0;
     
-                status = co_await fileStreamSPtr_->ReadAsync(*memoryStreamSPtr_, bytesRead, startPosition, chunkSize);
+                status = co_await fileStreamSPtr_->ReadAsync(*chunkSPtr, bytesRead, startPosition, chunkSize);
                 STORE_ASSERT(NT_SUCCESS(status), "Failed to read from filestream. status={1}", status);
                 STORE_ASSERT(bytesRead == chunkSize, "bytesRead={1} != chunkSize={2}", bytesRead, chunkSize);
 
                 //need sharedreader because the while loop may adjust the br buffer which requires reader to be recreated.
                 KSharedPtr<SharedBinaryReader> brSPtr = nullptr;
-                status = SharedBinaryReader::Create(this->GetThisAllocator(), *memoryStreamSPtr_, brSPtr);
+                status = SharedBinaryReader::Create(this->GetThisAllocator(), *chunkSPtr, brSPtr);
                 Diagnostics::Validate(status);
-            
+
+                // Only the block sizes are read here, to find the end of the last block in the chunk.
                 while (true)
                 {
                     ULONG32 alignedStartBlockOffset = brSPtr->Position;
                     KeyChunkMetadata blockMetadata = KeyChunkMetadata::Read(*brSPtr);
-                    ULONG32 currentBlockSize = blockMetadata.BlockSize;
-                    ULONG32 alignedBlockSize = GetBlockSize(currentBlockSize);
+                    ULONG32 alignedBlockSize = GetBlockSize(blockMetadata.BlockSize);
 
                     // Check if the next block was only partially read.  If so, read the remainder of it into memory.
                     if ((alignedStartBlockOffset + alignedBlockSize) > chunkSize)
@@ -244,9 +355,9 @@ namespace Data
                         ULONG32 remainder = remainingBlockSize %  BlockAlignedWriter<TKey, TValue>::DefaultBlockAlignmentSize;
                         STORE_ASSERT(remainder == 0, "remainder={1} should be 0", remainder);
 
-                        memoryStreamSPtr_->SetSize(chunkSize + remainingBlockSize, true);
+                        chunkSPtr->SetSize(chunkSize + remainingBlockSize, true);
                         bytesRead = 0;
-                        status = co_await fileStreamSPtr_->ReadAsync(*memoryStreamSPtr_, bytesRead, chunkSize, remainingBlockSize);
+                        status = co_await fileStreamSPtr_->ReadAsync(*chunkSPtr, bytesRead, chunkSize, remainingBlockSize);
                         STORE_ASSERT(NT_SUCCESS(status), "Failed to read from filestream. status={1}", status);
                         STORE_ASSERT(bytesRead == remainingBlockSize, "bytesRead={1} != remainingBlockSize={2}", bytesRead, remainingBlockSize);
                         chunkSize = chunkSize + remainingBlockSize;
@@ -254,20 +365,55 @@ namespace Data
                         //create the binary reader again to update its base stream and keep the current position.
                         //this differs from managed since br in native made a copy of stream
                         ULONG currentPosition = brSPtr->Position;
-                        status = SharedBinaryReader::Create(this->GetThisAllocator(), *memoryStreamSPtr_, brSPtr);
+                        status = SharedBinaryReader::Create(this->GetThisAllocator(), *chunkSPtr, brSPtr);
                         Diagnostics::Validate(status);
                         brSPtr->Position = currentPosition;
                     }
 
-                    KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> keysFromBlockSPtr = ReadBlock(currentBlockSize, *brSPtr);
-
-                    for (ULONG i = 0; i < keysFromBlockSPtr->Count(); i++)
+                    // Move the reader ahead to the next block, if possible, else break.
+                    brSPtr->Position = alignedStartBlockOffset + alignedBlockSize;
+                    if (alignedStartBlockOffset + alignedBlockSize >= chunkSize)
                     {
-                        itemsBufferSPtr_->Append((*keysFromBlockSPtr)[i]);
+                        STORE_ASSERT(alignedStartBlockOffset + alignedBlockSize == chunkSize, "offset+size {1} != chunkSize {2}", alignedStartBlockOffset + alignedBlockSize, chunkSize);
+                        break;
                     }
+                }
 
-                    // Move the reader ahead to the next block, if possible, else reset and break.
-                    brSPtr->Position = alignedStartBlockOffset + alignedBlockSize;
+                co_return chunkSPtr;
+            }
+
+            ktl::Awaitable<KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>>> DecodeChunkAsync(__in KBuffer& chunk)
+            {
+                KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> thisSPtr = this;
+                KBuffer::SPtr chunkSPtr = &chunk;
+
+                co_await ktl::CorHelper::ThreadPoolThread(this->GetThisKtlSystem().DefaultThreadPool());
+
+                co_return DecodeChunk(*chunkSPtr);
+            }
+
+            //
+            // Verifies and decodes every key block of a chunk returned by ReadRawChunkAsync.
+            //
+            KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> DecodeChunk(__in KBuffer& chunk)
+            {
+                KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> itemsSPtr = _new(KEYCHECKPOINTASYNCENUMERATOR_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>();
+                STORE_ASSERT(itemsSPtr != nullptr, "itemsSPtr should not be null");
+
+                BinaryReader reader(chunk, this->GetThisAllocator());
+                ULONG32 chunkSize = chunk.QuerySize();
+
+                while (true)
+                {
+                    ULONG32 alignedStartBlockOffset = reader.Position;
+                    KeyChunkMetadata blockMetadata = KeyChunkMetadata::Read(reader);
+                    ULONG32 currentBlockSize = blockMetadata.BlockSize;
+                    ULONG32 alignedBlockSize = GetBlockSize(currentBlockSize);
+
+                    ReadBlock(chunk, currentBlockSize, reader, *itemsSPtr);
+
+                    // Move the reader ahead to the next block, if possible, else break.
+                    reader.Position = alignedStartBlockOffset + alignedBlockSize;
                     if (alignedStartBlockOffset + alignedBlockSize >= chunkSize)
                     {
                         STORE_ASSERT(alignedStartBlockOffset + alignedBlockSize == chunkSize, "offset+size {1} != chunkSize {2}", alignedStartBlockOffset + alignedBlockSize, chunkSize);
@@ -275,16 +421,14 @@ namespace Data
                     }
                 }
 
-                // Track the number of keys returned.
-                keyCount_ += itemsBufferSPtr_->Count();
-
-                STORE_ASSERT(itemsBufferSPtr_->Count() > 0, "items buffer count={1} should be 0", itemsBufferSPtr_->Count());
-                co_return true;
+                return itemsSPtr;
             }
 
-            KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> ReadBlock(
+            void ReadBlock(
+                __in KBuffer& chunk,
                 __in ULONG32 blockSize,
-                __in BinaryReader& reader)
+                __in BinaryReader& reader,
+                __inout KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>& items)
             {
                 ULONG32 blockStartPosition = reader.Position;
                 ULONG32 alignedBlockStartPosition = blockStartPosition - KeyChunkMetadata::Size;
@@ -295,24 +439,21 @@ namespace Data
                 reader.Position = blockStartPosition;
 
                 // Verify checksum.
-                ULONG64 actualChecksum = CRC64::ToCRC64(*memoryStreamSPtr_, alignedBlockStartPosition, blockSize - sizeof(ULONG64));
+                ULONG64 actualChecksum = CRC64::ToCRC64(chunk, alignedBlockStartPosition, blockSize - sizeof(ULONG64));
                 if (actualChecksum != expectedChecksum)
                 {
                     //todo: throw invalid data exception.
                     throw ktl::Exception(SF_STATUS_INVALID_OPERATION);
                 }
 
-                KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> keysDataSPtr = _new(KEYCHECKPOINTASYNCENUMERATOR_TAG, this->GetThisAllocator()) KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>();
-                STORE_ASSERT(keysDataSPtr != nullptr, "keysDataSPtr should not be null");
-
                 while(reader.Position < (alignedBlockStartPosition + blockSize - sizeof(ULONG64)))
                 {
                     KSharedPtr<KeyData<TKey, TValue>> keyDataSPtr = keyCheckpointFileSPtr_->ReadKey<TKey, TValue>(reader, *keySerializerSPtr_);
-                    keysDataSPtr->Append(keyDataSPtr);
+                    NTSTATUS status = items.Append(keyDataSPtr);
+                    Diagnostics::Validate(status);
                 }
 
                 STORE_ASSERT(reader.Position == (alignedBlockStartPosition + blockSize - sizeof(ULONG64)), "reader.Position={1} != expected position={2}", reader.Position, alignedBlockStartPosition + blockSize - sizeof(ULONG64));
-                return keysDataSPtr;
             }
 
             ULONG64 GetChunkSize()
@@ -356,7 +497,6 @@ namespace Data
                 __in ULONG64 endOffset,
                 __in StoreTraceComponent & traceComponent);
 
-            static const ULONG32 ChunkSize = 64 * 1024;
             static const ULONG32 ReadChunkSize = 32 * 1024;
 
             int index_;
@@ -367,11 +507,20 @@ namespace Data
             ULONG64 endOffset_;
             KSharedPtr<KeyData<TKey, TValue>> current_;
             KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>> itemsBufferSPtr_;
-            KSharedPtr<KBuffer> memoryStreamSPtr_;
             KSharedPtr<ktl::io::KFileStream> fileStreamSPtr_;
             KSharedPtr<Data::StateManager::IStateSerializer<TKey>> keySerializerSPtr_;
             KSharedPtr<IComparer<TKey>> keyComparerSPtr_;
 
+            // Chunks read ahead of the consumer and decoded on the thread pool, in file order.
+            ULONG32 decodeParallelism_;
+            bool isEndOfKeys_;
+            KArray<ktl::Awaitable<KSharedPtr<KSharedArray<KSharedPtr<KeyData<TKey, TValue>>>>>> decodeTasks_;
+
+            bool hasLowerBound_;
+            TKey lowerBound_;
+            bool hasUpperBound_;
+            TKey upperBound_;
+
             StoreTraceComponent::SPtr traceComponent_;
 
         };
@@ -394,8 +543,15 @@ namespace Data
             itemsBufferSPtr_(nullptr),
             fileStreamSPtr_(nullptr),
             keyComparerSPtr_(nullptr),
-            memoryStreamSPtr_(nullptr)
+            decodeParallelism_(1),
+            isEndOfKeys_(false),
+            decodeTasks_(this->GetThisAllocator()),
+            hasLowerBound_(false),
+            lowerBound_(),
+            hasUpperBound_(false),
+            upperBound_()
         {
+            this->SetConstructorStatus(decodeTasks_.Status());
         }
 
         template<typename TKey, typename TValue>
@@ -12,6 +12,7 @@ using namespace Data::Utilities;
 
 KeyCheckpointFileProperties::KeyCheckpointFileProperties()
     :keysHandleSPtr_(nullptr),
+    keyBlockIndexHandleSPtr_(nullptr),
     keyCount_(0),
     fileId_(0)
 {
@@ -66,6 +67,15 @@ void KeyCheckpointFileProperties::Write(__in BinaryWriter& writer)
     writer.Write(fileId_);
     ByteAlignedReaderWriterHelper::WritePaddingUntilAligned(writer);
 
+    // 'KeyBlockIndexHandle' - BlockHandle
+    if (keyBlockIndexHandleSPtr_ != nullptr)
+    {
+        writer.Write(static_cast<LONG32>(PropertyId::KeyBlockIndexHandleProp));
+        VarInt::Write(writer, BlockHandle::SerializedSize());
+        ByteAlignedReaderWriterHelper::WritePaddingUntilAligned(writer);
+        keyBlockIndexHandleSPtr_->Write(writer);
+    }
+
     ByteAlignedReaderWriterHelper::AssertIfNotAligned(writer.Position);
 }
 
@@ -90,6 +100,10 @@ void KeyCheckpointFileProperties::ReadProperty(
         ByteAlignedReaderWriterHelper::ReadPaddingUntilAligned(reader);
         break;
 
+    case PropertyId::KeyBlockIndexHandleProp:
+        keyBlockIndexHandleSPtr_ = BlockHandle::Read(reader, GetThisAllocator());
+        break;
+
     default:
         FilePropertySection::ReadProperty(reader, property, valueSize);
         break;
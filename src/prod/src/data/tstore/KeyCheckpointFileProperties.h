@@ -31,6 +31,19 @@ namespace Data
                 keysHandleSPtr_ = &value;
             }
 
+            //
+            // Location of the sparse key block index. Null for files written without one.
+            //
+            __declspec(property(get = get_KeyBlockIndexHandle, put = set_KeyBlockIndexHandle)) BlockHandle::SPtr KeyBlockIndexHandle;
+            BlockHandle::SPtr get_KeyBlockIndexHandle() const
+            {
+                return keyBlockIndexHandleSPtr_;
+            }
+            void set_KeyBlockIndexHandle(__in BlockHandle& value)
+            {
+                keyBlockIndexHandleSPtr_ = &value;
+            }
+
             __declspec(property(get = get_KeyCount, put = set_KeyCount)) ULONG64 KeyCount;
             ULONG64 get_KeyCount() const
             {
@@ -73,6 +86,12 @@ namespace Data
             // FileId          bytes       4
             // RESERVED                    4
             // 
+            // (Optional)
+            // KeyBlockIndexHandle.PID  int     4
+            // SerializedSize           VarInt  1
+            // RESERVED                         3
+            // KeyBlockIndexHandle      bytes   16
+            // 
             void Write(__in BinaryWriter& writer) override;
 
             //
@@ -90,11 +109,13 @@ namespace Data
                 KeysHandleProp = 1,
                 KeyCountProp = 2,
                 FileIdProp = 3,
+                KeyBlockIndexHandleProp = 4,
             };
 
             ULONG64 keyCount_;
             ULONG32 fileId_;
             BlockHandle::SPtr keysHandleSPtr_;
+            BlockHandle::SPtr keyBlockIndexHandleSPtr_;
 
         };
     }
@@ -838,6 +838,72 @@ namespace TStoreTests
             co_return;
         }
 
+        ktl::Awaitable<void> Merge3Files_ToNewFiles_InParallelKeyRanges_ShouldSucceed_Test()
+        {
+            ULONG32 const keyCount = 1000;
+            auto fileNamesSPtr = CreateStringHashSet();
+
+            Store->MergeHelperSPtr->MergeFilesCountThreshold = 3;
+            Store->MergeHelperSPtr->NumberOfInvalidEntries = 1;
+            Store->ConsolidationManagerSPtr->NumberOfDeltasToBeConsolidated = 1;
+
+            // Key ranges are split on the key block index, which is only written when enabled.
+            Store->EnableKeyBlockIndex = true;
+
+            // Split the merge on every key block so that a small file still gets all the key ranges.
+            Store->ConsolidationManagerSPtr->MergeParallelism = 4;
+            Store->ConsolidationManagerSPtr->MinimumKeyBlocksPerMergePartition = 1;
+
+            for (ULONG32 i = 1; i <= keyCount; i++)
+            {
+                auto txn = CreateWriteTransaction();
+                co_await Store->AddAsync(*txn->StoreTransactionSPtr, CreateString(i), CreateBuffer(8), DefaultTimeout, CancellationToken::None);
+                co_await txn->CommitAsync();
+            }
+
+            co_await CheckpointAsync(*Store);
+            AddFileNames(*fileNamesSPtr);
+
+            for (ULONG32 i = 1; i <= 3; i++)
+            {
+                ULONG32 key = 1;
+                auto value = CreateBuffer(88);
+
+                {
+                    auto txn = CreateWriteTransaction();
+                    co_await Store->ConditionalUpdateAsync(*txn->StoreTransactionSPtr, CreateString(key), value, DefaultTimeout, CancellationToken::None);
+                    co_await txn->CommitAsync();
+                }
+
+                co_await CheckpointAsync(*Store);
+                AddFileNames(*fileNamesSPtr);
+            }
+
+            RemoveFileNames(*fileNamesSPtr);
+
+            // One merged file per key range and the last checkpoint file.
+            CODING_ERROR_ASSERT(5 == Store->CurrentMetadataTableSPtr->Table->Count);
+
+            VerifyInvalidFilesAreDeleted(*fileNamesSPtr);
+
+            co_await VerifyKeyExistsAsync(CreateString(1), CreateBuffer(88));
+            for (ULONG32 i = 2; i <= keyCount; i++)
+            {
+                co_await VerifyKeyExistsAsync(CreateString(i), CreateBuffer(8));
+            }
+
+            co_await CloseAndReOpenStoreAsync();
+            Store->ConsolidationManagerSPtr->NumberOfDeltasToBeConsolidated = 1;
+
+            co_await VerifyKeyExistsAsync(CreateString(1), CreateBuffer(88));
+            for (ULONG32 i = 2; i <= keyCount; i++)
+            {
+                co_await VerifyKeyExistsAsync(CreateString(i), CreateBuffer(8));
+            }
+
+            co_return;
+        }
+
         ktl::Awaitable<void> Merge3Files_ToNewFile_WithRepeatingEntries_ShouldSucceed_Test()
         {
             auto fileNamesSPtr = CreateStringHashSet();
@@ -2478,6 +2544,11 @@ namespace TStoreTests
         SyncAwait(Merge3Files_ToNewFile_ShouldSucceed_Test());
     }
 
+    BOOST_AUTO_TEST_CASE(Merge3Files_ToNewFiles_InParallelKeyRanges_ShouldSucceed)
+    {
+        SyncAwait(Merge3Files_ToNewFiles_InParallelKeyRanges_ShouldSucceed_Test());
+    }
+
     BOOST_AUTO_TEST_CASE(Merge3Files_ToNewFile_WithRepeatingEntries_ShouldSucceed)
     {
         SyncAwait(Merge3Files_ToNewFile_WithRepeatingEntries_ShouldSucceed_Test());
@@ -0,0 +1,78 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace Data::TStore;
+using namespace Data::Utilities;
+
+MergeWriteThrottle::MergeWriteThrottle(__in ULONG64 bytesPerSecond)
+    : bytesPerSecond_(bytesPerSecond),
+    paidUntilInUs_(0)
+{
+    stopwatch_.Start();
+}
+
+MergeWriteThrottle::~MergeWriteThrottle()
+{
+}
+
+NTSTATUS MergeWriteThrottle::Create(
+    __in ULONG64 bytesPerSecond,
+    __in KAllocator& allocator,
+    __out MergeWriteThrottle::SPtr& result)
+{
+    NTSTATUS status;
+    SPtr output = _new(MERGEWRITETHROTTLE_TAG, allocator) MergeWriteThrottle(bytesPerSecond);
+
+    if (!output)
+    {
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    status = output->Status();
+    if (!NT_SUCCESS(status))
+    {
+        return status;
+    }
+
+    result = Ktl::Move(output);
+    return STATUS_SUCCESS;
+}
+
+ktl::Awaitable<void> MergeWriteThrottle::OnBytesWrittenAsync(__in ULONG64 bytesWritten)
+{
+    if (bytesPerSecond_ == 0 || bytesWritten == 0)
+    {
+        co_return;
+    }
+
+    MergeWriteThrottle::SPtr thisSPtr = this;
+    LONG64 delayInMs = 0;
+
+    K_LOCK_BLOCK(lock_)
+    {
+        // Time the merge did not write is not banked, so idle periods do not turn into bursts.
+        LONG64 nowInUs = stopwatch_.ElapsedMicroseconds;
+        if (paidUntilInUs_ < nowInUs)
+        {
+            paidUntilInUs_ = nowInUs;
+        }
+
+        // Accounted in microseconds so that single block writes are not rounded away.
+        paidUntilInUs_ += static_cast<LONG64>((bytesWritten * 1000000) / bytesPerSecond_);
+        delayInMs = (paidUntilInUs_ - nowInUs) / 1000;
+    }
+
+    if (delayInMs > 0)
+    {
+        NTSTATUS status = co_await KTimer::StartTimerAsync(
+            this->GetThisAllocator(),
+            MERGEWRITETHROTTLE_TAG,
+            static_cast<ULONG>(delayInMs),
+            nullptr);
+        Diagnostics::Validate(status);
+    }
+}
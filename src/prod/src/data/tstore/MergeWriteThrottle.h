@@ -0,0 +1,52 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+#define MERGEWRITETHROTTLE_TAG 'thWM'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Limits the rate at which merge writes checkpoint files, so that merge IO does not starve foreground reads.
+        // One throttle is shared by all the partitions of a merge, so the limit applies to the merge as a whole.
+        //
+        class MergeWriteThrottle :
+            public KObject<MergeWriteThrottle>,
+            public KShared<MergeWriteThrottle>
+        {
+            K_FORCE_SHARED(MergeWriteThrottle)
+
+        public:
+
+            //
+            // 0 bytes per second disables throttling.
+            //
+            static NTSTATUS
+                Create(
+                    __in ULONG64 bytesPerSecond,
+                    __in KAllocator& allocator,
+                    __out MergeWriteThrottle::SPtr& result);
+
+            //
+            // Accounts for the given number of bytes written, and completes once the merge is back within its rate.
+            //
+            ktl::Awaitable<void> OnBytesWrittenAsync(__in ULONG64 bytesWritten);
+
+        private:
+
+            MergeWriteThrottle(__in ULONG64 bytesPerSecond);
+
+            ULONG64 bytesPerSecond_;
+
+            // Time at which the bytes written so far are paid for at the configured rate.
+            LONG64 paidUntilInUs_;
+
+            KSpinLock lock_;
+            Common::Stopwatch stopwatch_;
+        };
+    }
+}
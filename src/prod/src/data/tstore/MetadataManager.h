@@ -117,6 +117,28 @@ namespace Data
                 return fileMetadataSPtr->CheckpointFileSPtr->ReadValueAsync(item);
             }
 
+            //
+            // Read the values of items that all live in the given file. The items must be sorted by offset.
+            //
+            template<typename TValue>
+            static ktl::Awaitable<KSharedPtr<KSharedArray<TValue>>> ReadValuesAsync(
+                __in MetadataTable& metadataTable,
+                __in ULONG32 fileId,
+                __in KSharedArray<KSharedPtr<VersionedItem<TValue>>>& items,
+                __in Data::StateManager::IStateSerializer<TValue>& valueSerializer)
+            {
+                FileMetadata::SPtr fileMetadataSPtr = nullptr;
+                bool result = metadataTable.Table->TryGetValue(fileId, fileMetadataSPtr);
+                if (!result)
+                {
+                    throw ktl::Exception(SF_STATUS_INVALID_OPERATION);
+                }
+
+                ASSERT_IFNOT(fileMetadataSPtr->CheckpointFileSPtr != nullptr, "Checkpoint file with id '{0}' does not exist in memory.", fileId);
+
+                return fileMetadataSPtr->CheckpointFileSPtr->ReadValuesAsync<TValue>(items, valueSerializer);
+            }
+
         private:
            static const ULONG32 FileVersion = 1;
            static const ULONG32 MemoryBufferFlushSize = 32 * 1024;
@@ -109,6 +109,55 @@ namespace TStoreTests
         }
     }
 
+    BOOST_AUTO_TEST_CASE(PartitionedSortedList_AppendPartition_ShouldFindAllTheKeys)
+    {
+        auto allocator = PartitionSortedListAddTest::GetAllocator();
+
+        KSharedPtr<IntComparer> comparerSptr = nullptr;
+        NTSTATUS status = IntComparer::Create(*allocator, comparerSptr);
+        KInvariant(status == STATUS_SUCCESS);
+
+        int maxSublistSize = 4;
+        KSharedPtr<PartitionedSortedList<int, int>> sortedListSptr = nullptr;
+        status = PartitionedSortedList<int, int>::Create(*comparerSptr, *allocator, sortedListSptr, maxSublistSize);
+        KInvariant(status == STATUS_SUCCESS);
+
+        // Two full partitions and a partially filled one with the even keys 0 to 18.
+        int keyCount = 10;
+        KSharedPtr<Partition<int, int>> partitionSPtr = nullptr;
+        for (int i = 0; i < keyCount; i++)
+        {
+            if (partitionSPtr == nullptr)
+            {
+                status = Partition<int, int>::Create(maxSublistSize, maxSublistSize, *allocator, partitionSPtr);
+                KInvariant(status == STATUS_SUCCESS);
+            }
+
+            partitionSPtr->Add(i * 2, i * 2);
+
+            if (partitionSPtr->Count() == maxSublistSize || i == keyCount - 1)
+            {
+                sortedListSptr->AppendPartition(*partitionSPtr);
+                partitionSPtr = nullptr;
+            }
+        }
+
+        KInvariant(sortedListSptr->Count() == keyCount);
+
+        // Add continues in the partially filled partition.
+        sortedListSptr->Add(keyCount * 2, keyCount * 2);
+        KInvariant(sortedListSptr->Count() == keyCount + 1);
+        KInvariant(sortedListSptr->GetLastKey() == keyCount * 2);
+
+        for (int i = 0; i <= keyCount * 2; i++)
+        {
+            int value = -1;
+            bool found = sortedListSptr->TryGetValue(i, value);
+            KInvariant(found == (i % 2 == 0));
+            KInvariant(!found || value == i);
+        }
+    }
+
     BOOST_AUTO_TEST_CASE(PartitionedSortedList_Add_Enumerate_ShouldContainAllTheKeys)
     {
         auto allocator = PartitionSortedListAddTest::GetAllocator();
@@ -80,6 +80,29 @@ namespace Data
                 InterlockedIncrement(&count_);
             }
 
+            __declspec(property(get = get_MaxSubListSize)) int MaxSubListSize;
+            int get_MaxSubListSize() const
+            {
+                return maxSubListSize_;
+            }
+
+            //
+            // Appends a partition built by the caller, for bulk loads that fill partitions without going through Add.
+            // Every partition but the last must hold MaxSubListSize items, so the current partition has to be full.
+            //
+            void AppendPartition(__in Partition<TKey, TValue>& partition)
+            {
+                KInvariant(partition.Count() > 0 && partition.Count() <= maxSubListSize_);
+                KInvariant(currentPartitionSPtr_ == nullptr || currentPartitionSPtr_->Count() == maxSubListSize_);
+
+                KSharedPtr<Partition<TKey, TValue>> partitionSPtr = &partition;
+                NTSTATUS status = partitionListSPtr_->Append(partitionSPtr);
+                Diagnostics::Validate(status);
+
+                currentPartitionSPtr_ = partitionSPtr;
+                InterlockedExchangeAdd(&count_, partition.Count());
+            }
+
             TKey GetLastKey() const
             {
                 int currentPartitionCount = currentPartitionSPtr_->Count();
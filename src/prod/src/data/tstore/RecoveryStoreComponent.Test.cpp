@@ -356,6 +356,59 @@ namespace TStoreTests
             co_await metadataTableSPtr->CloseAsync();
             co_return;
         }
+
+        ktl::Awaitable<void> Enumerate_ParallelKeyDecode_TwoEntries_ShouldSucceed_Test()
+        {
+            KString::SPtr checkpoint1FileName;
+            KString::Create(checkpoint1FileName, GetAllocator(), L"Enumerate_ParallelKeyDecode_TwoEntries_ShouldSucceed_1");
+
+            KString::SPtr checkpoint2FileName;
+            KString::Create(checkpoint2FileName, GetAllocator(), L"Enumerate_ParallelKeyDecode_TwoEntries_ShouldSucceed_2");
+
+            // Enough keys for many chunks per file. The second file overlaps the upper half of the first one with newer versions.
+            auto checkpointFile1SPtr = co_await CreateCheckpointFileAsync(*checkpoint1FileName, 1, 20000, 0, 0);
+            co_await checkpointFile1SPtr->CloseAsync();
+            auto checkpointFile2SPtr = co_await CreateCheckpointFileAsync(*checkpoint2FileName, 2, 20000, 10000, 20000);
+            co_await checkpointFile2SPtr->CloseAsync();
+
+            MetadataTable::SPtr metadataTableSPtr;
+            MetadataTable::Create(GetAllocator(), metadataTableSPtr);
+
+            FileMetadata::SPtr file1MetadataSPtr;
+            FileMetadata::Create(1, *checkpoint1FileName, 20000, 20000, 1, 0, true, GetAllocator(), *CreateTraceComponent(), file1MetadataSPtr);
+
+            FileMetadata::SPtr file2MetadataSPtr;
+            FileMetadata::Create(2, *checkpoint2FileName, 20000, 20000, 2, 0, true, GetAllocator(), *CreateTraceComponent(), file2MetadataSPtr);
+
+            MetadataManager::AddFile(*(metadataTableSPtr->Table), 1, *file1MetadataSPtr);
+            MetadataManager::AddFile(*(metadataTableSPtr->Table), 2, *file2MetadataSPtr);
+
+            RecoveryStoreComponent<int, ULONG32>::SPtr recoveryStoreComponentSPtr;
+            CreateRecoveryStoreComponent(*metadataTableSPtr, recoveryStoreComponentSPtr);
+            recoveryStoreComponentSPtr->KeyDecodeParallelism = 4;
+
+            co_await recoveryStoreComponentSPtr->RecoverAsync(CancellationToken::None);
+
+            auto enumeratorSPtr = recoveryStoreComponentSPtr->GetEnumerable();
+
+            int expectedKey = 0;
+            while (enumeratorSPtr->MoveNext())
+            {
+                auto current = enumeratorSPtr->Current();
+                CODING_ERROR_ASSERT(current.Key == expectedKey);
+
+                // Keys present in both files must come from the second, newer file.
+                LONG64 expectedSequenceNumber = expectedKey < 10000 ? expectedKey : expectedKey + 10000;
+                CODING_ERROR_ASSERT(current.Value->GetVersionSequenceNumber() == expectedSequenceNumber);
+                expectedKey++;
+            }
+
+            CODING_ERROR_ASSERT(expectedKey == 30000);
+            CODING_ERROR_ASSERT(recoveryStoreComponentSPtr->TotalKeyCount == 40000);
+
+            co_await metadataTableSPtr->CloseAsync();
+            co_return;
+        }
     #pragma endregion
     };
 
@@ -391,5 +444,10 @@ namespace TStoreTests
         SyncAwait(Enumerate_MetadataTableSingleEntry_100Keys_ShouldSucceed_Test());
     }
 
+    BOOST_AUTO_TEST_CASE(Enumerate_ParallelKeyDecode_TwoEntries_ShouldSucceed)
+    {
+        SyncAwait(Enumerate_ParallelKeyDecode_TwoEntries_ShouldSucceed_Test());
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
@@ -74,6 +74,20 @@ namespace Data
                return logicalCheckpointFileTimeStamp_;
             }
 
+            //
+            // Number of key chunks each key checkpoint file decodes concurrently ahead of the merge.
+            // Above 1 the key serializer is called concurrently from thread pool threads, so it must be thread safe.
+            //
+            __declspec(property(get = get_KeyDecodeParallelism, put = set_KeyDecodeParallelism)) ULONG32 KeyDecodeParallelism;
+            ULONG32 get_KeyDecodeParallelism() const
+            {
+                return keyDecodeParallelism_;
+            }
+            void set_KeyDecodeParallelism(__in ULONG32 value)
+            {
+                keyDecodeParallelism_ = value;
+            }
+
             KSharedPtr<RecoveryStoreEnumerator<TKey, TValue>> GetEnumerable()
             {
                 KSharedPtr<RecoveryStoreEnumerator<TKey, TValue>> enumeratorSPtr;
@@ -170,17 +184,36 @@ namespace Data
                 StoreEventSource::Events->RecoveryStoreComponentMergeKeyCheckpointFilesAsync(traceComponent_->PartitionId, traceComponent_->TraceTag, L"starting", -1);
                 LONG64 count = 0;
 
-                // Get Enumerators for each file from the MetadataTable
+                // Move all the enumerators once to make them point at their first item.
+                // With parallel decode the files are independent, so their first chunks are read and decoded concurrently.
+                // Otherwise the key serializer is only ever called from one thread at a time.
+                KArray<ktl::Awaitable<bool>> moveNextTasks(this->GetThisAllocator(), keyCheckpointFileListSPtr->Count());
+                Diagnostics::Validate(moveNextTasks.Status());
+
                 for (ULONG i = 0; i < keyCheckpointFileListSPtr->Count(); i++)
                 {
                     KSharedPtr<KeyCheckpointFileAsyncEnumerator<TKey, TValue>> keyCheckpointEnumeratorSPtr = (*keyCheckpointFileListSPtr)[i];
                     
                     keyCheckpointEnumeratorSPtr->KeyComparerSPtr = *comparerSPtr_;
+                    keyCheckpointEnumeratorSPtr->DecodeParallelism = keyDecodeParallelism_;
+
+                    if (keyDecodeParallelism_ > 1)
+                    {
+                        NTSTATUS status = moveNextTasks.Append(keyCheckpointEnumeratorSPtr->MoveNextAsync(cancellationToken));
+                        Diagnostics::Validate(status);
+                    }
+                    else
+                    {
+                        co_await keyCheckpointEnumeratorSPtr->MoveNextAsync(cancellationToken);
+                    }
+                }
 
-                    // Move the enumerator once to make it point at the first item
-                    co_await keyCheckpointEnumeratorSPtr->MoveNextAsync(cancellationToken);
+                co_await TaskUtilities<bool>::WhenAll(moveNextTasks);
 
-                    priorityQueue.Push(keyCheckpointEnumeratorSPtr);
+                // Get Enumerators for each file from the MetadataTable
+                for (ULONG i = 0; i < keyCheckpointFileListSPtr->Count(); i++)
+                {
+                    priorityQueue.Push((*keyCheckpointFileListSPtr)[i]);
                 }
 
                 while (!priorityQueue.IsEmpty())
@@ -281,6 +314,7 @@ namespace Data
 
             LONG64 totalKeyCount_;
             LONG64 totalKeySize_;
+            ULONG32 keyDecodeParallelism_;
             
             StoreTraceComponent::SPtr traceComponent_;
         };
@@ -300,6 +334,7 @@ namespace Data
             comparerSPtr_(&keyComparer),
             totalKeyCount_(0),
             totalKeySize_(0),
+            keyDecodeParallelism_(1),
             traceComponent_(&traceComponent)
         {
             auto status = KString::Create(workDirectorySPtr_, this->GetThisAllocator(), workDirectory);
@@ -73,7 +73,7 @@ namespace Data
                     {
                         if (currentValue->IsInMemory())
                         {
-                            InterlockedAdd64(&size_, -currentValue->GetValueSize());
+                            InterlockedAdd64(&size_, -currentValue->GetInMemoryValueSize());
                             STORE_ASSERT(size_ >= 0, "Size {1} should not be negative", size_);
                         }
 
@@ -87,7 +87,7 @@ namespace Data
 
                 if (valueSPtr->IsInMemory())
                 {
-                    InterlockedAdd64(&size_, valueSPtr->GetValueSize());
+                    InterlockedAdd64(&size_, valueSPtr->GetInMemoryValueSize());
                 }
             }
 
@@ -152,7 +152,7 @@ namespace Data
                             versionedItemSPtr->SetInUse(true);
 
                             // Increment size - concurrent loads may cause overcounting
-                            InterlockedAdd64(&size_, versionedItemSPtr->GetValueSize());
+                            InterlockedAdd64(&size_, versionedItemSPtr->GetInMemoryValueSize());
                         }
 
                         // Load the value into memory.
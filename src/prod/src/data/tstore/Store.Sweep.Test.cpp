@@ -48,6 +48,39 @@ namespace TStoreTests
             return value;
         }
 
+        KString::SPtr CreateCompressibleString(__in ULONG seed)
+        {
+            KString::SPtr value;
+            wstring str = wstring(1024, L'a') + to_wstring(seed);
+            auto status = KString::Create(value, GetAllocator(), str.c_str());
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+            return value;
+        }
+
+        ktl::Awaitable<void> VerifyMultiGetAsync(
+            __in StoreTransaction<LONG64, KString::SPtr>& storeTransaction,
+            __in KArray<LONG64> const & keys,
+            __in KArray<KString::SPtr> const & expectedValues)
+        {
+            KArray<KeyValuePair<LONG64, KString::SPtr>> values(GetAllocator());
+            KArray<bool> exists(GetAllocator());
+            co_await Store->MultiGetAsync(storeTransaction, keys, DefaultTimeout, values, exists, ktl::CancellationToken::None);
+
+            CODING_ERROR_ASSERT(values.Count() == keys.Count());
+            CODING_ERROR_ASSERT(exists.Count() == keys.Count());
+
+            for (ULONG32 i = 0; i < keys.Count(); i++)
+            {
+                KString::SPtr expectedValue = expectedValues[i];
+                KString::SPtr actualValue = values[i].Value;
+
+                CODING_ERROR_ASSERT(exists[i] == true);
+                CODING_ERROR_ASSERT(EqualityFunction(actualValue, expectedValue));
+            }
+
+            co_return;
+        }
+
         void SweepConsolidatedState()
         {
            Store->ConsolidationManagerSPtr->SweepConsolidatedState(ktl::CancellationToken::None);
@@ -718,6 +751,235 @@ namespace TStoreTests
             }
             co_return;
         }
+        ktl::Awaitable<void> MultiGet_SweptAndWriteSetKeys_ShouldSucceed_Test()
+        {
+            for (LONG64 key = 0; key < 20; key++)
+            {
+                auto txn = CreateWriteTransaction();
+                co_await Store->AddAsync(*txn->StoreTransactionSPtr, key, CreateString(static_cast<ULONG>(key)), DefaultTimeout, ktl::CancellationToken::None);
+                co_await txn->CommitAsync();
+            }
+
+            co_await CheckpointAsync();
+            SweepConsolidatedState();
+            SweepConsolidatedState();
+
+            for (LONG64 key = 0; key < 20; key++)
+            {
+                VersionedItem<KString::SPtr>::SPtr versionedItem = Store->ConsolidationManagerSPtr->Read(key);
+                CODING_ERROR_ASSERT(versionedItem->GetValue() == nullptr);
+            }
+
+            KArray<LONG64> keys(GetAllocator());
+            LONG64 keysToRead[] = { 15, 3, 7, 100, 3, 0, 19 };
+            for (LONG64 key : keysToRead)
+            {
+                keys.Append(key);
+            }
+
+            {
+                auto txn = CreateWriteTransaction();
+                co_await Store->ConditionalUpdateAsync(*txn->StoreTransactionSPtr, 7, CreateString(L"updated"), DefaultTimeout, ktl::CancellationToken::None);
+
+                KArray<KeyValuePair<LONG64, KString::SPtr>> values(GetAllocator());
+                KArray<bool> exists(GetAllocator());
+                co_await Store->MultiGetAsync(*txn->StoreTransactionSPtr, keys, DefaultTimeout, values, exists, ktl::CancellationToken::None);
+
+                CODING_ERROR_ASSERT(values.Count() == keys.Count());
+                CODING_ERROR_ASSERT(exists.Count() == keys.Count());
+
+                for (ULONG32 i = 0; i < keys.Count(); i++)
+                {
+                    LONG64 key = keys[i];
+                    if (key == 100)
+                    {
+                        CODING_ERROR_ASSERT(exists[i] == false);
+                        continue;
+                    }
+
+                    KString::SPtr expectedValue = key == 7 ? CreateString(L"updated") : CreateString(static_cast<ULONG>(key));
+                    KString::SPtr actualValue = values[i].Value;
+
+                    CODING_ERROR_ASSERT(exists[i] == true);
+                    CODING_ERROR_ASSERT(EqualityFunction(actualValue, expectedValue));
+                }
+
+                co_await txn->AbortAsync();
+            }
+
+            // Values loaded from disk are cached like single key reads.
+            for (LONG64 key : { 0, 3, 15, 19 })
+            {
+                VersionedItem<KString::SPtr>::SPtr versionedItem = Store->ConsolidationManagerSPtr->Read(key);
+                CODING_ERROR_ASSERT(versionedItem->GetInUse() == true);
+                CODING_ERROR_ASSERT(versionedItem->GetValue() != nullptr);
+            }
+
+            co_return;
+        }
+
+        ktl::Awaitable<void> MultiGet_Snapshot_ShouldReadVersionsAtVisibilityLsn_Test()
+        {
+            KArray<LONG64> keys(GetAllocator());
+            KArray<KString::SPtr> oldValues(GetAllocator());
+            KArray<KString::SPtr> newValues(GetAllocator());
+
+            for (LONG64 key = 0; key < 10; key++)
+            {
+                auto txn = CreateWriteTransaction();
+                co_await Store->AddAsync(*txn->StoreTransactionSPtr, key, CreateString(static_cast<ULONG>(key)), DefaultTimeout, ktl::CancellationToken::None);
+                co_await txn->CommitAsync();
+
+                keys.Append(key);
+                oldValues.Append(CreateString(static_cast<ULONG>(key)));
+                newValues.Append(CreateString(static_cast<ULONG>(key + 100)));
+            }
+
+            co_await CheckpointAsync();
+            SweepConsolidatedState();
+            SweepConsolidatedState();
+
+            // Start the snapshot transaction and read to snap its visibility LSN
+            auto snapshottedTxn = CreateWriteTransaction();
+            snapshottedTxn->StoreTransactionSPtr->ReadIsolationLevel = StoreTransactionReadIsolationLevel::Snapshot;
+            co_await VerifyKeyExistsAsync(*Store, *snapshottedTxn->StoreTransactionSPtr, 0, nullptr, CreateString(static_cast<ULONG>(0)), EqualityFunction);
+
+            for (LONG64 key = 0; key < 10; key++)
+            {
+                auto txn = CreateWriteTransaction();
+                co_await Store->ConditionalUpdateAsync(*txn->StoreTransactionSPtr, key, CreateString(static_cast<ULONG>(key + 100)), DefaultTimeout, ktl::CancellationToken::None);
+                co_await txn->CommitAsync();
+            }
+
+            // The updates are still in the differential state, so the snapshot finds the previous versions swept in the consolidated state
+            co_await VerifyMultiGetAsync(*snapshottedTxn->StoreTransactionSPtr, keys, oldValues);
+
+            // After consolidation the previous versions only exist in the snapshot container and on disk
+            co_await CheckpointAsync();
+            co_await VerifyMultiGetAsync(*snapshottedTxn->StoreTransactionSPtr, keys, oldValues);
+
+            {
+                auto txn = CreateWriteTransaction();
+                co_await VerifyMultiGetAsync(*txn->StoreTransactionSPtr, keys, newValues);
+                co_await txn->AbortAsync();
+            }
+
+            co_await snapshottedTxn->AbortAsync();
+            co_return;
+        }
+
+        ktl::Awaitable<void> MultiGet_SweptKeysInManyCheckpointFiles_ShouldSucceed_Test()
+        {
+            Store->MergeHelperSPtr->CurrentMergePolicy = MergePolicy::None;
+
+            KArray<LONG64> keys(GetAllocator());
+            KArray<KString::SPtr> expectedValues(GetAllocator());
+
+            for (LONG64 checkpoint = 0; checkpoint < 4; checkpoint++)
+            {
+                for (LONG64 key = checkpoint * 10; key < (checkpoint + 1) * 10; key++)
+                {
+                    auto txn = CreateWriteTransaction();
+                    co_await Store->AddAsync(*txn->StoreTransactionSPtr, key, CreateString(static_cast<ULONG>(key)), DefaultTimeout, ktl::CancellationToken::None);
+                    co_await txn->CommitAsync();
+                }
+
+                co_await CheckpointAsync();
+            }
+
+            SweepConsolidatedState();
+            SweepConsolidatedState();
+
+            // Interleave the keys of the files, in descending order
+            for (LONG64 i = 9; i >= 0; i--)
+            {
+                for (LONG64 checkpoint = 3; checkpoint >= 0; checkpoint--)
+                {
+                    LONG64 key = checkpoint * 10 + i;
+                    keys.Append(key);
+                    expectedValues.Append(CreateString(static_cast<ULONG>(key)));
+                }
+            }
+
+            KArray<ULONG> fileIds(GetAllocator());
+            for (ULONG32 i = 0; i < keys.Count(); i++)
+            {
+                VersionedItem<KString::SPtr>::SPtr versionedItem = Store->ConsolidationManagerSPtr->Read(keys[i]);
+                CODING_ERROR_ASSERT(versionedItem->GetValue() == nullptr);
+
+                bool isNewFileId = true;
+                for (ULONG32 j = 0; j < fileIds.Count(); j++)
+                {
+                    isNewFileId = isNewFileId && fileIds[j] != versionedItem->GetFileId();
+                }
+
+                if (isNewFileId)
+                {
+                    fileIds.Append(versionedItem->GetFileId());
+                }
+            }
+
+            CODING_ERROR_ASSERT(fileIds.Count() == 4);
+
+            {
+                auto txn = CreateWriteTransaction();
+                co_await VerifyMultiGetAsync(*txn->StoreTransactionSPtr, keys, expectedValues);
+                co_await txn->AbortAsync();
+            }
+
+            for (ULONG32 i = 0; i < keys.Count(); i++)
+            {
+                VersionedItem<KString::SPtr>::SPtr versionedItem = Store->ConsolidationManagerSPtr->Read(keys[i]);
+                CODING_ERROR_ASSERT(versionedItem->GetValue() != nullptr);
+            }
+
+            co_return;
+        }
+
+        ktl::Awaitable<void> MultiGet_SweptKeysInCompressedValueFile_ShouldSucceed_Test()
+        {
+            Store->EnableValueCompression = true;
+
+            KArray<LONG64> keys(GetAllocator());
+            KArray<KString::SPtr> expectedValues(GetAllocator());
+
+            for (LONG64 key = 0; key < 20; key++)
+            {
+                auto txn = CreateWriteTransaction();
+                co_await Store->AddAsync(*txn->StoreTransactionSPtr, key, CreateCompressibleString(static_cast<ULONG>(key)), DefaultTimeout, ktl::CancellationToken::None);
+                co_await txn->CommitAsync();
+
+                keys.Append(key);
+                expectedValues.Append(CreateCompressibleString(static_cast<ULONG>(key)));
+            }
+
+            co_await CheckpointAsync();
+            SweepConsolidatedState();
+            SweepConsolidatedState();
+
+            for (ULONG32 i = 0; i < keys.Count(); i++)
+            {
+                VersionedItem<KString::SPtr>::SPtr versionedItem = Store->ConsolidationManagerSPtr->Read(keys[i]);
+                CODING_ERROR_ASSERT(versionedItem->GetValue() == nullptr);
+            }
+
+            {
+                auto txn = CreateWriteTransaction();
+                co_await VerifyMultiGetAsync(*txn->StoreTransactionSPtr, keys, expectedValues);
+                co_await txn->AbortAsync();
+            }
+
+            // The values were compressed on disk and are accounted at their decompressed size once loaded
+            for (ULONG32 i = 0; i < keys.Count(); i++)
+            {
+                VersionedItem<KString::SPtr>::SPtr versionedItem = Store->ConsolidationManagerSPtr->Read(keys[i]);
+                CODING_ERROR_ASSERT(versionedItem->GetValue() != nullptr);
+                CODING_ERROR_ASSERT(versionedItem->GetValueSize() < versionedItem->GetInMemoryValueSize());
+            }
+
+            co_return;
+        }
+
     #pragma endregion
     };
 
@@ -883,5 +1145,25 @@ namespace TStoreTests
         SyncAwait(CompleteCheckpoint_WithConcurrentReads_ShouldSucceed_Test());
     }
 
+    BOOST_AUTO_TEST_CASE(MultiGet_SweptAndWriteSetKeys_ShouldSucceed)
+    {
+        SyncAwait(MultiGet_SweptAndWriteSetKeys_ShouldSucceed_Test());
+    }
+
+    BOOST_AUTO_TEST_CASE(MultiGet_Snapshot_ShouldReadVersionsAtVisibilityLsn)
+    {
+        SyncAwait(MultiGet_Snapshot_ShouldReadVersionsAtVisibilityLsn_Test());
+    }
+
+    BOOST_AUTO_TEST_CASE(MultiGet_SweptKeysInManyCheckpointFiles_ShouldSucceed)
+    {
+        SyncAwait(MultiGet_SweptKeysInManyCheckpointFiles_ShouldSucceed_Test());
+    }
+
+    BOOST_AUTO_TEST_CASE(MultiGet_SweptKeysInCompressedValueFile_ShouldSucceed)
+    {
+        SyncAwait(MultiGet_SweptKeysInCompressedValueFile_ShouldSucceed_Test());
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
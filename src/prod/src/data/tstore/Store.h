@@ -316,6 +316,38 @@ namespace Data
                 enableSweep_ = enable;
             }
 
+            //
+            // Whether checkpoints and merges LZ4 compress the values they write. Existing files are read either way.
+            //
+            // Compressed value files are written with footer version 2, which builds without value compression reject.
+            // Copy, backup and restore move checkpoint files as they are, so turning this on is only safe once every replica
+            // of the partition, and every cluster a backup may be restored to, runs a build that reads version 2.
+            // Turning it off again does not rewrite existing files; they go away as merges replace them.
+            //
+            __declspec(property(get = get_EnableValueCompression, put = set_EnableValueCompression)) bool EnableValueCompression;
+            bool get_EnableValueCompression() const override
+            {
+                return enableValueCompression_;
+            }
+            void set_EnableValueCompression(__in bool enable)
+            {
+                enableValueCompression_ = enable;
+            }
+
+            //
+            // Whether checkpoints and merges write a sparse key block index into the key files.
+            // Nothing reads keys through the index yet, so it is off by default.
+            //
+            __declspec(property(get = get_EnableKeyBlockIndex, put = set_EnableKeyBlockIndex)) bool EnableKeyBlockIndex;
+            bool get_EnableKeyBlockIndex() const override
+            {
+                return enableKeyBlockIndex_;
+            }
+            void set_EnableKeyBlockIndex(__in bool enable)
+            {
+                enableKeyBlockIndex_ = enable;
+            }
+
             __declspec(property(get = get_SweepTask, put = set_SweepTask)) ktl::AwaitableCompletionSource<bool>::SPtr SweepTaskSourceSPtr;
             ktl::AwaitableCompletionSource<bool>::SPtr get_SweepTask()
             {
@@ -347,6 +379,21 @@ namespace Data
                 numberOfInflightRecoveryTasks_ = numRecoveryTasks;
             }
 
+            //
+            // Number of key chunks per key checkpoint file that recovery decodes concurrently.
+            // Values above 1 call the key serializer from several thread pool threads at once;
+            // only set them for stores whose key serializer is thread safe.
+            //
+            __declspec(property(get = get_RecoveryKeyDecodeParallelism, put = set_RecoveryKeyDecodeParallelism)) ULONG32 RecoveryKeyDecodeParallelism;
+            ULONG32 get_RecoveryKeyDecodeParallelism() const
+            {
+                return recoveryKeyDecodeParallelism_;
+            }
+            void set_RecoveryKeyDecodeParallelism(__in ULONG32 parallelism)
+            {
+                recoveryKeyDecodeParallelism_ = parallelism;
+            }
+
             __declspec(property(get = get_MergeHelper)) MergeHelper::SPtr MergeHelperSPtr;
             MergeHelper::SPtr get_MergeHelper() const override
             {
@@ -819,6 +866,203 @@ namespace Data
                 co_return exists;
             }
 
+            //
+            // Reads all the keys under one prime lock acquisition and, for snapshot reads, one visibility sequence number.
+            // Values that are not in memory are loaded in disk order, batched per checkpoint file.
+            //
+            ktl::Awaitable<void> MultiGetAsync(
+                __in IStoreTransaction<TKey, TValue>& storeTransaction,
+                __in KArray<TKey> const & keys,
+                __in Common::TimeSpan timeout,
+                __out KArray<KeyValuePair<LONG64, TValue>>& values,
+                __out KArray<bool>& exists,
+                __in ktl::CancellationToken const & cancellationToken) override
+            {
+                ApiEntry();
+
+                KSharedPtr<StoreTransaction<TKey, TValue>> storeTransactionSPtr = static_cast<StoreTransaction<TKey, TValue>*>(&storeTransaction);
+                ReadMode readMode = ReadMode::CacheResult;
+
+                try
+                {
+                    ThrowIfFaulted(*storeTransactionSPtr);
+                    ThrowIfNotReadable(*storeTransactionSPtr);
+
+                    Common::TimeSpan primeLockTimeout = timeout;
+                    if (primeLockTimeout < Common::TimeSpan::Zero)
+                    {
+                        primeLockTimeout = Common::TimeSpan::MaxValue;
+                    }
+                    co_await storeTransactionSPtr->AcquirePrimeLockAsync(*lockManager_, LockMode::Shared, primeLockTimeout, false);
+
+                    // If the operation was cancelled during the lock wait, then terminate
+                    cancellationToken.ThrowIfCancellationRequested();
+
+                    ThrowIfFaulted(*storeTransactionSPtr);
+
+                    values.Clear();
+                    exists.Clear();
+
+                    KArray<ULONG32> pendingKeyIndexes(this->GetThisAllocator(), keys.Count());
+                    Diagnostics::Validate(pendingKeyIndexes.Status());
+
+                    for (ULONG32 i = 0; i < keys.Count(); i++)
+                    {
+                        NTSTATUS status = values.Append(KeyValuePair<LONG64, TValue>(-1, TValue()));
+                        Diagnostics::Validate(status);
+
+                        status = exists.Append(false);
+                        Diagnostics::Validate(status);
+
+                        KSharedPtr<VersionedItem<TValue>> versionedItemSPtr = nullptr;
+                        if (!storeTransactionSPtr->IsWriteSetEmpty)
+                        {
+                            auto writeset = storeTransactionSPtr->GetComponent(func_);
+                            STORE_ASSERT(writeset != nullptr, "writeset != nullptr");
+
+                            TKey key = keys[i];
+                            versionedItemSPtr = writeset->Read(key);
+                        }
+
+                        if (versionedItemSPtr != nullptr)
+                        {
+                            // Safe to get the value from versioned item since it is in the write set
+                            values[i].Key = versionedItemSPtr->GetVersionSequenceNumber();
+                            if (versionedItemSPtr->GetRecordKind() != RecordKind::DeletedVersion)
+                            {
+                                values[i].Value = versionedItemSPtr->GetValue();
+                                exists[i] = true;
+                            }
+
+                            continue;
+                        }
+
+                        status = pendingKeyIndexes.Append(i);
+                        Diagnostics::Validate(status);
+                    }
+
+                    if (pendingKeyIndexes.Count() == 0)
+                    {
+                        co_return;
+                    }
+
+                    LONG64 visibilitySequenceNumber = Constants::InvalidLsn;
+                    KSharedPtr<SnapshotComponent<TKey, TValue>> snapshotComponentSPtr = nullptr;
+
+                    if (storeTransactionSPtr->ReadIsolationLevel == StoreTransactionReadIsolationLevel::Enum::Snapshot)
+                    {
+                        TxnReplicator::Transaction::SPtr transaction = static_cast<TxnReplicator::Transaction *>(storeTransactionSPtr->ReplicatorTransaction.RawPtr());
+                        Diagnostics::Validate(co_await transaction->GetVisibilitySequenceNumberAsync(visibilitySequenceNumber));
+
+                        snapshotComponentSPtr = snapshotContainerSPtr_->Read(visibilitySequenceNumber);
+                    }
+                    else
+                    {
+                        STORE_ASSERT(storeTransactionSPtr->ReadIsolationLevel == StoreTransactionReadIsolationLevel::Enum::ReadRepeatable,
+                            "store transaction should be read committed or repeatable read");
+                        co_await AcquireKeyReadLocksAsync(*lockManager_, keys, pendingKeyIndexes, *storeTransactionSPtr, timeout);
+
+                        // If the operation was cancelled during the lock wait, then terminate
+                        cancellationToken.ThrowIfCancellationRequested();
+                    }
+
+                    auto cachedDifferentialStoreComponentSPtr = differentialStoreComponentSPtr_.Get();
+                    STORE_ASSERT(cachedDifferentialStoreComponentSPtr != nullptr, "cachedDifferentialStoreComponentSPtr != nullptr");
+
+                    KSharedPtr<KSharedArray<KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>>>> diskReadsSPtr =
+                        _new(this->GetThisAllocationTag(), this->GetThisAllocator()) KSharedArray<KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>>>();
+                    Diagnostics::Validate(diskReadsSPtr);
+
+                    for (ULONG32 i = 0; i < pendingKeyIndexes.Count(); i++)
+                    {
+                        ULONG32 keyIndex = pendingKeyIndexes[i];
+                        TKey key = keys[keyIndex];
+
+                        // Same precedence as TryGetValueForReadOnlyTransactionsAsync: differential state, snapshot container, consolidated state.
+                        KSharedPtr<VersionedItem<TValue>> versionedItemSPtr = visibilitySequenceNumber == Constants::InvalidLsn ?
+                            cachedDifferentialStoreComponentSPtr->Read(key) :
+                            cachedDifferentialStoreComponentSPtr->Read(key, visibilitySequenceNumber);
+
+                        if (versionedItemSPtr != nullptr)
+                        {
+                            SetMultiGetResult(*versionedItemSPtr, versionedItemSPtr->GetRecordKind() != RecordKind::DeletedVersion ? versionedItemSPtr->GetValue() : TValue(), keyIndex, values, exists);
+                            continue;
+                        }
+
+                        if (snapshotComponentSPtr != nullptr)
+                        {
+                            auto readResultSPtr = co_await snapshotComponentSPtr->ReadAsync(key, visibilitySequenceNumber, readMode);
+                            if (readResultSPtr->HasValue())
+                            {
+                                STORE_ASSERT(readResultSPtr->VersionedItem != nullptr, "versionedItemFromSnapshotComponent != nullptr");
+                                SetMultiGetResult(*readResultSPtr->VersionedItem, readResultSPtr->Value, keyIndex, values, exists);
+                                continue;
+                            }
+                        }
+
+                        versionedItemSPtr = visibilitySequenceNumber == Constants::InvalidLsn ?
+                            consolidationManagerSPtr_->Read(key) :
+                            consolidationManagerSPtr_->Read(key, visibilitySequenceNumber);
+
+                        if (versionedItemSPtr == nullptr)
+                        {
+                            continue;
+                        }
+
+                        if (versionedItemSPtr->GetRecordKind() == RecordKind::DeletedVersion)
+                        {
+                            SetMultiGetResult(*versionedItemSPtr, TValue(), keyIndex, values, exists);
+                            continue;
+                        }
+
+                        {
+                            versionedItemSPtr->AcquireLock();
+                            KFinally([&] { versionedItemSPtr->ReleaseLock(*traceComponent_); });
+                            if (versionedItemSPtr->IsInMemory())
+                            {
+                                versionedItemSPtr->SetInUse(true);
+                                SetMultiGetResult(*versionedItemSPtr, versionedItemSPtr->GetValue(), keyIndex, values, exists);
+                                continue;
+                            }
+                        }
+
+                        NTSTATUS status = diskReadsSPtr->Append(KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>>(keyIndex, versionedItemSPtr));
+                        Diagnostics::Validate(status);
+                    }
+
+                    if (diskReadsSPtr->Count() > 0)
+                    {
+                        bool loaded = co_await TryLoadValuesAsync(*diskReadsSPtr, readMode, values, exists);
+                        if (!loaded)
+                        {
+                            // A checkpoint or merge swapped the metadata tables; re-read these keys one at a time, which retries until the load succeeds.
+                            for (ULONG32 i = 0; i < diskReadsSPtr->Count(); i++)
+                            {
+                                ULONG32 keyIndex = (*diskReadsSPtr)[i].Key;
+                                TKey key = keys[keyIndex];
+
+                                auto readResultSPtr = co_await ReadFromConsolidatedStateAsync(key, visibilitySequenceNumber, readMode, cancellationToken);
+                                if (readResultSPtr->VersionedItem != nullptr)
+                                {
+                                    SetMultiGetResult(*readResultSPtr->VersionedItem, readResultSPtr->Value, keyIndex, values, exists);
+                                }
+                            }
+                        }
+                    }
+
+                    // Check if transaction has been disposed since replicator can dispose a long running tx or on change role and it can race with a read.
+                    ThrowIfFaulted(*storeTransactionSPtr);
+
+                    // Make sure a read does not start in primary role and completes in secondary role.
+                    ThrowIfNotReadable(*storeTransactionSPtr);
+                }
+                catch (ktl::Exception const & e)
+                {
+                    TraceException(L"MultiGetAsync", e, storeTransactionSPtr->Id);
+                    throw;
+                }
+            }
+
             ktl::Awaitable<bool> TryGetValueAsync(
                 __in IStoreTransaction<TKey, TValue>& storeTransaction,
                 __in TKey key,
@@ -2892,7 +3136,7 @@ namespace Data
                             if (readMode == ReadMode::CacheResult)
                             {
                                 // If there are multiple loads in progress there could be some overcounting here - not worth locking for it.
-                                consolidationManagerSPtr_->AddToMemorySize(versionedItem->GetValueSize());
+                                consolidationManagerSPtr_->AddToMemorySize(versionedItem->GetInMemoryValueSize());
                             }
 
                             break;
@@ -3025,6 +3269,169 @@ namespace Data
                 co_return successful;
             }
 
+            //
+            // Loads the values of the given consolidated items, grouped by checkpoint file and read in offset order.
+            // Returns false if the metadata tables could not be referenced, in which case the items have to be re-read.
+            //
+            ktl::Awaitable<bool> TryLoadValuesAsync(
+                __in KSharedArray<KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>>> & diskReads,
+                __in ReadMode readMode,
+                __out KArray<KeyValuePair<LONG64, TValue>>& values,
+                __out KArray<bool>& exists)
+            {
+                KSharedPtr<KSharedArray<KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>>>> diskReadsSPtr = &diskReads;
+                SharedException::CSPtr exceptionCSPtr = nullptr;
+                bool currentAddRefSucceeded = false;
+                bool nextAddRefSucceeded = false;
+                bool mergeAddRefSucceeded = false;
+                bool successful = true;
+
+                // Snap tables upfront so that the current does not become next by the time this function completes
+                MetadataTable::SPtr cachedCurrentMetadataTableSPtr = currentMetadataTableSPtr_.Get();
+                STORE_ASSERT(cachedCurrentMetadataTableSPtr != nullptr, "current metadata table cannot be null");
+
+                MetadataTable::SPtr cachedNextMetadataTableSPtr = nextMetadataTableSPtr_.Get();
+                MetadataTable::SPtr cachedMergeMetadataTableSPtr = mergeMetadataTableSPtr_.Get();
+
+                try
+                {
+                    currentAddRefSucceeded = cachedCurrentMetadataTableSPtr->TryAddReference();
+                    successful = currentAddRefSucceeded;
+
+                    if (successful && cachedNextMetadataTableSPtr != nullptr)
+                    {
+                        nextAddRefSucceeded = cachedNextMetadataTableSPtr->TryAddReference();
+                        successful = nextAddRefSucceeded;
+                    }
+
+                    if (successful && cachedMergeMetadataTableSPtr != nullptr)
+                    {
+                        mergeAddRefSucceeded = cachedMergeMetadataTableSPtr->TryAddReference();
+                        successful = mergeAddRefSucceeded;
+                    }
+
+                    if (successful)
+                    {
+                        KSharedPtr<VersionedItemDiskOrderComparer<TValue>> comparerSPtr = nullptr;
+                        NTSTATUS status = VersionedItemDiskOrderComparer<TValue>::Create(this->GetThisAllocator(), comparerSPtr);
+                        Diagnostics::Validate(status);
+
+                        Sorter<KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>>>::QuickSort(true, *comparerSPtr, diskReadsSPtr);
+
+                        ULONG32 groupStart = 0;
+                        while (groupStart < diskReadsSPtr->Count())
+                        {
+                            ULONG32 fileId = (*diskReadsSPtr)[groupStart].Value->GetFileId();
+
+                            KSharedPtr<KSharedArray<KSharedPtr<VersionedItem<TValue>>>> itemsSPtr = _new(this->GetThisAllocationTag(), this->GetThisAllocator()) KSharedArray<KSharedPtr<VersionedItem<TValue>>>();
+                            Diagnostics::Validate(itemsSPtr);
+
+                            ULONG32 groupEnd = groupStart;
+                            while (groupEnd < diskReadsSPtr->Count() && (*diskReadsSPtr)[groupEnd].Value->GetFileId() == fileId)
+                            {
+                                status = itemsSPtr->Append((*diskReadsSPtr)[groupEnd].Value);
+                                Diagnostics::Validate(status);
+                                groupEnd++;
+                            }
+
+                            // Order is important. Check the merge table first and then next
+                            MetadataTable::SPtr metadataTableSPtr = cachedCurrentMetadataTableSPtr;
+                            if (mergeAddRefSucceeded && cachedMergeMetadataTableSPtr->Table->ContainsKey(fileId))
+                            {
+                                metadataTableSPtr = cachedMergeMetadataTableSPtr;
+                            }
+                            else if (nextAddRefSucceeded && cachedNextMetadataTableSPtr->Table->ContainsKey(fileId))
+                            {
+                                metadataTableSPtr = cachedNextMetadataTableSPtr;
+                            }
+                            else
+                            {
+                                STORE_ASSERT(cachedCurrentMetadataTableSPtr->Table->ContainsKey(fileId), "Current metadata table must contain the file id");
+                            }
+
+                            KSharedPtr<KSharedArray<TValue>> loadedValuesSPtr = co_await MetadataManager::ReadValuesAsync<TValue>(*metadataTableSPtr, fileId, *itemsSPtr, *valueConverterSPtr_);
+                            STORE_ASSERT(loadedValuesSPtr->Count() == itemsSPtr->Count(), "Loaded {1} values for {2} items", loadedValuesSPtr->Count(), itemsSPtr->Count());
+
+                            for (ULONG32 i = groupStart; i < groupEnd; i++)
+                            {
+                                KSharedPtr<VersionedItem<TValue>> versionedItemSPtr = (*diskReadsSPtr)[i].Value;
+                                TValue value = (*loadedValuesSPtr)[i - groupStart];
+
+                                if (readMode == ReadMode::CacheResult)
+                                {
+                                    versionedItemSPtr->AcquireLock();
+                                    KFinally([&] { versionedItemSPtr->ReleaseLock(*traceComponent_); });
+
+                                    // Duplicate keys or a concurrent reader may have loaded the value already.
+                                    if (!versionedItemSPtr->IsInMemory())
+                                    {
+                                        // Always call set and get within the lock - if TValue is a shared ptr its access should be protected.
+                                        versionedItemSPtr->SetValue(value);
+
+                                        // Update in memory after setting value
+                                        versionedItemSPtr->SetIsInMemory(true);
+
+                                        // If there are multiple loads in progress there could be some overcounting here - not worth locking for it.
+                                        consolidationManagerSPtr_->AddToMemorySize(versionedItemSPtr->GetInMemoryValueSize());
+                                    }
+
+                                    // Set in use only after updating the value
+                                    versionedItemSPtr->SetInUse(true);
+                                }
+
+                                SetMultiGetResult(*versionedItemSPtr, value, (*diskReadsSPtr)[i].Key, values, exists);
+                            }
+
+                            groupStart = groupEnd;
+                        }
+                    }
+                }
+                catch (ktl::Exception const & e)
+                {
+                    TraceException(L"TryLoadValuesAsync", e);
+                    exceptionCSPtr = SharedException::Create(e, this->GetThisAllocator());
+                    successful = false;
+                }
+
+                if (currentAddRefSucceeded)
+                {
+                    co_await cachedCurrentMetadataTableSPtr->ReleaseReferenceAsync();
+                }
+
+                if (nextAddRefSucceeded)
+                {
+                    co_await cachedNextMetadataTableSPtr->ReleaseReferenceAsync();
+                }
+
+                if (mergeAddRefSucceeded)
+                {
+                    co_await cachedMergeMetadataTableSPtr->ReleaseReferenceAsync();
+                }
+
+                if (exceptionCSPtr != nullptr)
+                {
+                    auto exec = exceptionCSPtr->Info;
+                    throw exec;
+                }
+
+                co_return successful;
+            }
+
+            void SetMultiGetResult(
+                __in VersionedItem<TValue> & versionedItem,
+                __in TValue const & value,
+                __in ULONG32 keyIndex,
+                __out KArray<KeyValuePair<LONG64, TValue>>& values,
+                __out KArray<bool>& exists)
+            {
+                values[keyIndex].Key = versionedItem.GetVersionSequenceNumber();
+                if (versionedItem.GetRecordKind() != RecordKind::DeletedVersion)
+                {
+                    values[keyIndex].Value = value;
+                    exists[keyIndex] = true;
+                }
+            }
+
             ktl::Awaitable<void> CheckpointAsync(__in ktl::CancellationToken const & cancellationToken)
             {
                 // Acquire prime lock for checkpointing.
@@ -3127,7 +3534,9 @@ namespace Data
                             this->GetThisAllocator(),
                             *traceComponent_,
                             perfCounters_,
-                            true);
+                            true,
+                            enableValueCompression_,
+                            enableKeyBlockIndex_);
 
                         ASSERT_IF(checkpointFileSPtr == nullptr, "Checkpoint file cannot be null");
 
@@ -3313,9 +3722,11 @@ namespace Data
 
                 if (mergeMetadataTableInformationSPtr != nullptr)
                 {
-                    if (mergeMetadataTableInformationSPtr->NewMergedFileSPtr != nullptr)
+                    auto newMergedFilesSPtr = mergeMetadataTableInformationSPtr->NewMergedFilesSPtr;
+
+                    for (ULONG32 i = 0; i < newMergedFilesSPtr->Count(); i++)
                     {
-                        auto fileMetadataSPtr = mergeMetadataTableInformationSPtr->NewMergedFileSPtr;
+                        auto fileMetadataSPtr = (*newMergedFilesSPtr)[i];
                         MetadataManager::AddFile(*tmpMetadataTable.Table, fileMetadataSPtr->FileId, *fileMetadataSPtr);
                     }
 
@@ -4196,6 +4607,64 @@ namespace Data
                 }
             }
 
+            //
+            // Acquires the read locks of the given keys in ascending hash order, so that two multi-key readers cannot deadlock on each other.
+            // The locks are taken one at a time from the lock manager and share a single deadline: each acquire waits for what is left of the timeout.
+            //
+            ktl::Awaitable<void> AcquireKeyReadLocksAsync(
+                __in LockManager& lockManager,
+                __in KArray<TKey> const & keys,
+                __in KArray<ULONG32> const & keyIndexes,
+                __in StoreTransaction<TKey, TValue>& storeTransaction,
+                __in Common::TimeSpan timeout)
+            {
+                KSharedPtr<StoreTransaction<TKey, TValue>> storeTransactionSPtr(&storeTransaction);
+                LockManager::SPtr lockManagerSPtr(&lockManager);
+
+                KSharedPtr<KSharedArray<ULONG64>> hashesSPtr = _new(this->GetThisAllocationTag(), this->GetThisAllocator()) KSharedArray<ULONG64>();
+                Diagnostics::Validate(hashesSPtr);
+
+                for (ULONG32 i = 0; i < keyIndexes.Count(); i++)
+                {
+                    TKey key = keys[keyIndexes[i]];
+                    auto keyBytes = GetKeyBytes(key);
+                    NTSTATUS status = hashesSPtr->Append(GetHash(*keyBytes));
+                    Diagnostics::Validate(status);
+                }
+
+                Data::Utilities::UnsignedLongComparer::SPtr comparerSPtr = nullptr;
+                NTSTATUS status = Data::Utilities::UnsignedLongComparer::Create(this->GetThisAllocator(), comparerSPtr);
+                Diagnostics::Validate(status);
+
+                Sorter<ULONG64>::QuickSort(true, *comparerSPtr, hashesSPtr);
+
+                Common::Stopwatch stopwatch;
+                stopwatch.Start();
+
+                for (ULONG32 i = 0; i < hashesSPtr->Count(); i++)
+                {
+                    // Duplicate keys, or keys that collide on the hash, share one lock.
+                    if (i > 0 && (*hashesSPtr)[i] == (*hashesSPtr)[i - 1])
+                    {
+                        continue;
+                    }
+
+                    // A negative timeout is infinite, which AcquireKeyReadLockAsync handles.
+                    Common::TimeSpan remainingTimeout = timeout;
+                    if (timeout >= Common::TimeSpan::Zero && timeout != Common::TimeSpan::MaxValue)
+                    {
+                        remainingTimeout = timeout.SubtractWithMaxAndMinValueCheck(stopwatch.Elapsed);
+                        if (remainingTimeout < Common::TimeSpan::Zero)
+                        {
+                            // An uncontended lock is still granted once the deadline has passed.
+                            remainingTimeout = Common::TimeSpan::Zero;
+                        }
+                    }
+
+                    co_await AcquireKeyReadLockAsync(*lockManagerSPtr, (*hashesSPtr)[i], *storeTransactionSPtr, remainingTimeout);
+                }
+            }
+
             ktl::Awaitable<void> CloseAndReopenLockManagerAsync() noexcept
             {
                 co_await lockManager_->CloseAsync();
@@ -4525,6 +4994,7 @@ namespace Data
 
                 STORE_ASSERT(isClosing_ == false, "Store should not be closing during recovery");
 
+                recoveryComponentSPtr->KeyDecodeParallelism = recoveryKeyDecodeParallelism_;
                 co_await recoveryComponentSPtr->RecoverAsync(cancellationToken);
                 auto cachedEstimator = keySizeEstimatorSPtr_.Get();
                 auto averageKeySize = recoveryComponentSPtr->TotalKeyCount > 0 ? recoveryComponentSPtr->TotalKeySize / recoveryComponentSPtr->TotalKeyCount : 0;
@@ -4565,7 +5035,8 @@ namespace Data
 
                     OnRecoverKeyCallback(row.Key, *row.Value);
 
-                    consolidationManagerSPtr_->Add(row.Key, *row.Value);
+                    // The recovered keys are merged in sorted order, so the consolidated state is built by appending.
+                    consolidationManagerSPtr_->AppendSorted(row.Key, *row.Value);
 
                     if (shouldLoadValuesInRecovery_)
                     {
@@ -4610,13 +5081,11 @@ namespace Data
                     IncrementCount(Constants::InvalidLsn, Constants::InvalidLsn);
                 }
 
+                consolidationManagerSPtr_->CompleteAppendSorted();
+
                 if (shouldLoadValuesInRecovery_)
                 {
-                    // TODO: Replace with WhenAll
-                    for (ULONG32 i = 0; i < loadTasks->Count(); i++)
-                    {
-                        co_await (*loadTasks)[i];
-                    }
+                    co_await TaskUtilities<TValue>::WhenAll(*loadTasks);
 
                     stopwatch.Stop();
 
@@ -5391,12 +5860,15 @@ namespace Data
             KString::CSPtr bkpMetadataFilePath_;
             bool isAlwaysReadable_;
             bool enableSweep_;
+            bool enableValueCompression_;
+            bool enableKeyBlockIndex_;
             ThreadSafeSPtrCache<ktl::AwaitableCompletionSource<bool>> sweepTcsSPtr_ = {nullptr};
             ktl::CancellationTokenSource::SPtr sweepTaskCancellationSourceSPtr_ = nullptr;
             LONG64 sweepInProgress_;
             bool enableEnumerationWithRepeatableRead_;
             bool shouldLoadValuesInRecovery_;
             ULONG32 numberOfInflightRecoveryTasks_;
+            ULONG32 recoveryKeyDecodeParallelism_;
             bool wasCopyAborted_;
             KString::SPtr langTypeInfo_;
             KString::SPtr lang_;
@@ -5431,10 +5903,13 @@ namespace Data
             enableBackgroundConsolidation_(true),
             isAlwaysReadable_(true), // TODO: should be configured on creation
             enableSweep_(false), // Factory will enable sweep
+            enableValueCompression_(false),
+            enableKeyBlockIndex_(false),
             sweepInProgress_(0),
             enableEnumerationWithRepeatableRead_(false),
             shouldLoadValuesInRecovery_(false),
             numberOfInflightRecoveryTasks_(1),
+            recoveryKeyDecodeParallelism_(Constants::DefaultRecoveryKeyDecodeParallelism),
             wasCopyAborted_(false),
             dictionaryChangeHandlerMask_(DictionaryChangeEventMask::Enum::All),
             hasPersistedState_(true)
@@ -42,6 +42,7 @@ namespace Data
             DECLARE_STORE_STRUCTURED_TRACE(ConsolidationManagerSlowConsolidation, Common::Guid, Common::WStringLiteral, LONG64, LONG64);
             DECLARE_STORE_STRUCTURED_TRACE(ConsolidationManagerMergeAsync, Common::Guid, Common::WStringLiteral, Common::WStringLiteral);
             DECLARE_STORE_STRUCTURED_TRACE(ConsolidationManagerMergeFile, Common::Guid, Common::WStringLiteral, Common::WStringLiteral);
+            DECLARE_STORE_STRUCTURED_TRACE(ConsolidationManagerSerialMergeFallback, Common::Guid, Common::WStringLiteral, ULONG32, ULONG32);
             
             // Recovery Store Component
             DECLARE_STORE_STRUCTURED_TRACE(RecoveryStoreComponentMergeKeyCheckpointFilesAsync, Common::Guid, Common::WStringLiteral, Common::WStringLiteral, LONG64);
@@ -289,7 +290,10 @@ namespace Data
                 STORE_STRUCTURED_TRACE(VolatileCopyManagerProcessVersionCopyOperationMsg, 206, Warning, "{1}: Unknown copy protocol version={2}", "id", "TraceTag", "Version"),
                 STORE_STRUCTURED_TRACE(VolatileCopyManagerProcessMetadataCopyOperation, 207, Info, "{1}: metadataSize={2}", "id", "TraceTag", "MetadataSize"),
                 STORE_STRUCTURED_TRACE(VolatileCopyManagerProcessDataCopyOperation, 208, Info, "{1}: keysInChunk={2} runningTotal={3} keyBytes={4} valueBytes={5}", "id", "TraceTag", "KeysInChunk", "RunningTotal", "KeyBytes", "ValueBytes"),
-                STORE_STRUCTURED_TRACE(VolatileCopyManagerProcessCompleteCopyOperation, 209, Info, "{1}: totalKeys={2}", "id", "TraceTag", "TotalKeys")
+                STORE_STRUCTURED_TRACE(VolatileCopyManagerProcessCompleteCopyOperation, 209, Info, "{1}: totalKeys={2}", "id", "TraceTag", "TotalKeys"),
+
+                // Consolidation Manager
+                STORE_STRUCTURED_TRACE(ConsolidationManagerSerialMergeFallback, 210, Warning, "{1}: merge parallelism {2} ignored, file {3} has no key block index. Set Store EnableKeyBlockIndex to write it.", "id", "TraceTag", "MergeParallelism", "FileId")
             {
             }
             static Common::Global<StoreEventSource> Events;
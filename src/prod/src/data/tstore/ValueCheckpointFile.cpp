@@ -250,7 +250,8 @@ ktl::Awaitable<void> ValueCheckpointFile::FlushAsync(
     STORE_ASSERT(NT_SUCCESS(status), "Error writing value checkpoint properties block. Status: {1}", status);
 
     // Write the Footer.
-    status = FileFooter::Create(*propertiesHandleSPtr, FileVersion, GetThisAllocator(), footerSPtr_);
+    ULONG32 version = propertiesSPtr_->IsCompressed ? CompressedFileVersion : FileVersion;
+    status = FileFooter::Create(*propertiesHandleSPtr, version, GetThisAllocator(), footerSPtr_);
     Diagnostics::Validate(status);
 
     BlockHandle::SPtr blockHandleSPtr = nullptr;
@@ -312,7 +313,7 @@ ktl::Awaitable<void> ValueCheckpointFile::ReadMetadataAsync()
         footerSPtr_ = co_await FileBlock<FileFooter::SPtr>::ReadBlockAsync(*filestreamSPtr, *footerHandleSPtr, footerFunc, GetThisAllocator(), ktl::CancellationToken::None);
 
         // Verify we know how to deserialize this version of the checkpoint file.
-        if (footerSPtr_->Version != FileVersion)
+        if (footerSPtr_->Version != FileVersion && footerSPtr_->Version != CompressedFileVersion)
         {
             throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION); 
         }
@@ -328,6 +329,11 @@ ktl::Awaitable<void> ValueCheckpointFile::ReadMetadataAsync()
             propFunc,
             GetThisAllocator(),
             ktl::CancellationToken::None);
+
+        if (propertiesSPtr_->IsCompressed != (footerSPtr_->Version == CompressedFileVersion))
+        {
+            throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+        }
     }
     catch (ktl::Exception const& e)
     {
@@ -417,4 +423,86 @@ ktl::Awaitable<void> ValueCheckpointFile::CloseAsync()
     co_return;
 }
 
+void ValueCheckpointFile::EncodeValue(
+    __in BinaryWriter& memoryBuffer,
+    __in KBuffer const & serializedValue)
+{
+    ULONG32 serializedSize = serializedValue.QuerySize();
+
+    if (serializedSize >= MinimumCompressedValueSize)
+    {
+        // The compressed form is only kept if it is smaller than the serialized value.
+        KBuffer::SPtr compressedSPtr = nullptr;
+        NTSTATUS status = KBuffer::Create(serializedSize, compressedSPtr, GetThisAllocator(), VALUECHECKPOINTFILE_TAG);
+        Diagnostics::Validate(status);
+
+        size_t compressedSize = Common::Lz4::Compress(
+            serializedValue.GetBuffer(),
+            serializedSize,
+            compressedSPtr->GetBuffer(),
+            serializedSize - sizeof(ULONG32));
+
+        if (compressedSize > 0)
+        {
+            memoryBuffer.Write(serializedSize);
+            memoryBuffer.Write(compressedSPtr.RawPtr(), static_cast<ULONG>(compressedSize));
+            return;
+        }
+    }
+
+    WriteUncompressedHeader(memoryBuffer);
+    if (serializedSize > 0)
+    {
+        memoryBuffer.Write(&serializedValue, serializedSize);
+    }
+}
+
+void ValueCheckpointFile::WriteUncompressedHeader(__in BinaryWriter& memoryBuffer)
+{
+    memoryBuffer.Write(static_cast<ULONG32>(0));
+}
+
+KBuffer::SPtr ValueCheckpointFile::DecodeValue(__in KBuffer const & encodedValue)
+{
+    ULONG encodedSize = encodedValue.QuerySize();
+    if (encodedSize < sizeof(ULONG32))
+    {
+        throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+    }
+
+    BYTE const * input = static_cast<BYTE const *>(encodedValue.GetBuffer());
+    ULONG32 serializedSize = 0;
+    memcpy(&serializedSize, input, sizeof(ULONG32));
+
+    ULONG payloadSize = encodedSize - sizeof(ULONG32);
+    KBuffer::SPtr resultSPtr = nullptr;
+
+    if (serializedSize == 0)
+    {
+        NTSTATUS status = KBuffer::Create(payloadSize, resultSPtr, GetThisAllocator(), VALUECHECKPOINTFILE_TAG);
+        Diagnostics::Validate(status);
+
+        if (payloadSize > 0)
+        {
+            memcpy(resultSPtr->GetBuffer(), input + sizeof(ULONG32), payloadSize);
+        }
+
+        return resultSPtr;
+    }
+
+    NTSTATUS status = KBuffer::Create(serializedSize, resultSPtr, GetThisAllocator(), VALUECHECKPOINTFILE_TAG);
+    Diagnostics::Validate(status);
 
+    bool isDecompressed = Common::Lz4::Decompress(
+        input + sizeof(ULONG32),
+        payloadSize,
+        resultSPtr->GetBuffer(),
+        serializedSize);
+
+    if (!isDecompressed)
+    {
+        throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
+    }
+
+    return resultSPtr;
+}
@@ -55,11 +55,32 @@ namespace Data
             //
             static const int FileVersion = 1;
 
+            //
+            // Version written for files whose values are compressed. Readers accept both versions.
+            // Readers from before value compression only accept FileVersion and fail to open these files.
+            //
+            static const int CompressedFileVersion = 2;
+
+            //
+            // Smaller values rarely compress enough to pay for the header and the decompression on read.
+            //
+            static const ULONG32 MinimumCompressedValueSize = 512;
+
             //
             // Buffer in memory approximately 32 KB of data before flushing to disk.
             //
             static const int MemoryBufferFlushSize = 32 * 1024;
 
+            //
+            // ReadValuesAsync fetches values with one read when they are at most this many bytes apart.
+            //
+            static const LONG64 MaxCoalescedReadGap = 16 * 1024;
+
+            //
+            // Upper bound on the size of a single coalesced read.
+            //
+            static const LONG64 MaxCoalescedReadSize = 1024 * 1024;
+
             //
             // The file extension for TStore checkpoint files that hold the serialized values.
             //
@@ -99,6 +120,20 @@ namespace Data
                 return propertiesSPtr_->FileId;
             }
 
+            //
+            // Whether values are LZ4 compressed. Must be set before the first value is written.
+            //
+            __declspec(property(get = get_IsCompressed, put = set_IsCompressed)) bool IsCompressed;
+            bool get_IsCompressed() const
+            {
+                return propertiesSPtr_->IsCompressed;
+            }
+            void set_IsCompressed(__in bool value)
+            {
+                STORE_ASSERT(propertiesSPtr_->ValueCount == 0, "Compression set after {1} values were written", propertiesSPtr_->ValueCount);
+                propertiesSPtr_->IsCompressed = value;
+            }
+
             __declspec(property(get = get_FileName)) KString::CSPtr FileName;
             KString::CSPtr get_FileName() const
             {
@@ -176,8 +211,6 @@ namespace Data
                     STORE_ASSERT(NT_SUCCESS(status), "Failed to read from file. status={1}", status);
                     STORE_ASSERT(bytesRead == size, "Did not read correct number of bytes. bytesRead={1} expected={2}", bytesRead, size);
 
-                    BinaryReader reader(*bufferSPtr, GetThisAllocator());
-
                     // Read the checksum from memory.
                     ULONG64 checksum = item->GetValueChecksum();
 
@@ -188,6 +221,15 @@ namespace Data
                         throw ktl::Exception(SF_STATUS_INVALID_OPERATION);
                     }
 
+                    // The checksum covers the bytes on disk, so it is verified before decompressing.
+                    if (propertiesSPtr_->IsCompressed)
+                    {
+                        bufferSPtr = DecodeValue(*bufferSPtr);
+                        item->SetInMemoryValueSize(static_cast<LONG32>(bufferSPtr->QuerySize()));
+                    }
+
+                    BinaryReader reader(*bufferSPtr, GetThisAllocator());
+
                     // Deserialize the value into memory.
                     TValue value = valueSerializer.Read(reader);
                     co_await streamPool_->ReleaseStreamAsync(*fileStreamSPtr);
@@ -260,6 +302,12 @@ namespace Data
                     {
                         throw ktl::Exception(STATUS_INTERNAL_DB_CORRUPTION);
                     }
+
+                    // Callers get the serialized value, so that it can be re-encoded for the file it is written to.
+                    if (propertiesSPtr_->IsCompressed)
+                    {
+                        bufferSPtr = DecodeValue(*bufferSPtr);
+                    }
                     
                     co_await streamPool_->ReleaseStreamAsync(*fileStreamSPtr);
                     fileStreamSPtr = nullptr;
@@ -285,6 +333,147 @@ namespace Data
                 }
             }
 
+            //
+            // Read the values of the given items from disk, in the order of the items.
+            // The items must be sorted by offset: values that are close on disk are fetched with a single read.
+            //
+            template<typename TValue>
+            ktl::Awaitable<KSharedPtr<KSharedArray<TValue>>> ReadValuesAsync(
+                __in KSharedArray<KSharedPtr<VersionedItem<TValue>>>& items,
+                __in Data::StateManager::IStateSerializer<TValue>& valueSerializer)
+            {
+                KSharedPtr<KSharedArray<KSharedPtr<VersionedItem<TValue>>>> itemsSPtr = &items;
+                KSharedPtr<Data::StateManager::IStateSerializer<TValue>> valueSerializerSPtr = &valueSerializer;
+
+                KSharedPtr<KSharedArray<TValue>> valuesSPtr = _new(VALUECHECKPOINTFILE_TAG, GetThisAllocator()) KSharedArray<TValue>();
+                Diagnostics::Validate(valuesSPtr);
+
+                for (ULONG32 i = 0; i < itemsSPtr->Count(); i++)
+                {
+                    KSharedPtr<VersionedItem<TValue>> item = (*itemsSPtr)[i];
+                    STORE_ASSERT(item->GetRecordKind() != RecordKind::DeletedVersion, "VersionedItem should not be DeletedVersion");
+                    STORE_ASSERT(i == 0 || (*itemsSPtr)[i - 1]->GetOffset() <= item->GetOffset(), "Items should be sorted by offset");
+
+                    // Validate that the item's disk properties are valid.
+                    if (static_cast<ULONG64>(item->GetOffset()) < propertiesSPtr_->ValuesHandle->Offset ||
+                        item->GetValueSize() < 0 ||
+                        static_cast<ULONG64>(item->GetOffset() + item->GetValueSize()) > propertiesSPtr_->ValuesHandle->EndOffset())
+                    {
+                        throw ktl::Exception(K_STATUS_OUT_OF_BOUNDS);
+                    }
+                }
+
+                ktl::io::KFileStream::SPtr fileStreamSPtr = nullptr;
+                SharedException::CSPtr exception = nullptr;
+
+                try
+                {
+                    fileStreamSPtr = co_await streamPool_->AcquireStreamAsync();
+
+                    ULONG32 runStart = 0;
+                    while (runStart < itemsSPtr->Count())
+                    {
+                        // Extend the read over the following values as long as the gaps between them stay small.
+                        LONG64 runOffset = (*itemsSPtr)[runStart]->GetOffset();
+                        LONG64 runEndOffset = runOffset + (*itemsSPtr)[runStart]->GetValueSize();
+                        ULONG32 runEnd = runStart + 1;
+
+                        while (runEnd < itemsSPtr->Count())
+                        {
+                            LONG64 nextOffset = (*itemsSPtr)[runEnd]->GetOffset();
+                            LONG64 nextEndOffset = nextOffset + (*itemsSPtr)[runEnd]->GetValueSize();
+                            if (nextOffset - runEndOffset > MaxCoalescedReadGap || nextEndOffset - runOffset > MaxCoalescedReadSize)
+                            {
+                                break;
+                            }
+
+                            if (nextEndOffset > runEndOffset)
+                            {
+                                runEndOffset = nextEndOffset;
+                            }
+
+                            runEnd++;
+                        }
+
+                        KBuffer::SPtr runBufferSPtr = nullptr;
+                        ULONG bytesRead = 0;
+                        ULONG runSize = static_cast<ULONG>(runEndOffset - runOffset);
+
+                        NTSTATUS status = KBuffer::Create(
+                            runSize,
+                            runBufferSPtr,
+                            GetThisAllocator());
+                        Diagnostics::Validate(status);
+
+                        fileStreamSPtr->SetPosition(runOffset);
+
+                        status = co_await fileStreamSPtr->ReadAsync(*runBufferSPtr, bytesRead, 0, runSize);
+                        STORE_ASSERT(NT_SUCCESS(status), "Failed to read from file. status={1}", status);
+                        STORE_ASSERT(bytesRead == runSize, "Did not read correct number of bytes. bytesRead={1} expected={2}", bytesRead, runSize);
+
+                        for (ULONG32 i = runStart; i < runEnd; i++)
+                        {
+                            KSharedPtr<VersionedItem<TValue>> item = (*itemsSPtr)[i];
+                            ULONG size = static_cast<ULONG>(item->GetValueSize());
+                            ULONG start = static_cast<ULONG>(item->GetOffset() - runOffset);
+
+                            KBuffer::SPtr bufferSPtr = runBufferSPtr;
+                            if (runEnd - runStart > 1)
+                            {
+                                status = KBuffer::Create(size, bufferSPtr, GetThisAllocator());
+                                Diagnostics::Validate(status);
+
+                                if (size > 0)
+                                {
+                                    memcpy(bufferSPtr->GetBuffer(), static_cast<BYTE *>(runBufferSPtr->GetBuffer()) + start, size);
+                                }
+                            }
+
+                            ULONG64 expectedChecksum = CRC64::ToCRC64(*bufferSPtr, 0, static_cast<ULONG32>(size));
+                            if (item->GetValueChecksum() != expectedChecksum)
+                            {
+                                throw ktl::Exception(SF_STATUS_INVALID_OPERATION);
+                            }
+
+                            // The checksum covers the bytes on disk, so it is verified before decompressing.
+                            if (propertiesSPtr_->IsCompressed)
+                            {
+                                bufferSPtr = DecodeValue(*bufferSPtr);
+                                item->SetInMemoryValueSize(static_cast<LONG32>(bufferSPtr->QuerySize()));
+                            }
+
+                            BinaryReader reader(*bufferSPtr, GetThisAllocator());
+                            status = valuesSPtr->Append(valueSerializerSPtr->Read(reader));
+                            Diagnostics::Validate(status);
+                        }
+
+                        runStart = runEnd;
+                    }
+
+                    co_await streamPool_->ReleaseStreamAsync(*fileStreamSPtr);
+                    fileStreamSPtr = nullptr;
+
+                    co_return valuesSPtr;
+                }
+                catch (ktl::Exception const& e)
+                {
+                    exception = SharedException::Create(e, GetThisAllocator());
+                }
+
+                if (fileStreamSPtr != nullptr && fileStreamSPtr->IsOpen())
+                {
+                    co_await streamPool_->ReleaseStreamAsync(*fileStreamSPtr);
+                    fileStreamSPtr = nullptr;
+                }
+
+                if (exception != nullptr)
+                {
+                    //clang compiler error, needs to assign before throw.
+                    auto ex = exception->Info;
+                    throw ex;
+                }
+            }
+
             //
             // Add a value to the given file stream, using the memory buffer to stage writes before issuing bulk disk IOs.
             //
@@ -335,6 +524,18 @@ namespace Data
                 __in KBlockFile::CreateDisposition createType);
             ktl::Awaitable<ktl::io::KFileStream::SPtr> CreateFileStreamAsync();
 
+            //
+            // Values in compressed files start with a ULONG32 header: zero if the serialized value follows as is,
+            // otherwise the size of the serialized value, followed by its LZ4 compressed form.
+            //
+            void EncodeValue(
+                __in BinaryWriter& memoryBuffer,
+                __in KBuffer const & serializedValue);
+
+            void WriteUncompressedHeader(__in BinaryWriter& memoryBuffer);
+
+            KBuffer::SPtr DecodeValue(__in KBuffer const & encodedValue);
+
             template<typename TValue>
             void WriteValue(
                 __in BinaryWriter& memoryBuffer,
@@ -349,6 +550,23 @@ namespace Data
                     // Serialize the value.
                     ULONG valueStartPosition = memoryBuffer.Position;
                     valueSerializer.Write(item.GetValue(), memoryBuffer);
+                    item.SetInMemoryValueSize(static_cast<LONG32>(memoryBuffer.Position - valueStartPosition));
+
+                    if (propertiesSPtr_->IsCompressed)
+                    {
+                        if (memoryBuffer.Position > valueStartPosition)
+                        {
+                            // Replace the serialized bytes with their encoded form.
+                            KBuffer::SPtr serializedValueSPtr = memoryBuffer.GetBuffer(valueStartPosition);
+                            memoryBuffer.Position = valueStartPosition;
+                            EncodeValue(memoryBuffer, *serializedValueSPtr);
+                        }
+                        else
+                        {
+                            WriteUncompressedHeader(memoryBuffer);
+                        }
+                    }
+
                     ULONG valueEndPosition = memoryBuffer.Position;
                     STORE_ASSERT(valueEndPosition >= valueStartPosition, "valueEndPosition={1} >= valueStartPosition={2}", valueEndPosition, valueStartPosition);
 
@@ -382,7 +600,16 @@ namespace Data
                     // WriteItemAsync valueSerializer followed by checksum.
                     // Serialize the value.
                     ULONG valueStartPosition = memoryBuffer.Position;
-                    memoryBuffer.Write(value);
+                    item.SetInMemoryValueSize(static_cast<LONG32>(value.QuerySize()));
+
+                    if (propertiesSPtr_->IsCompressed)
+                    {
+                        EncodeValue(memoryBuffer, value);
+                    }
+                    else
+                    {
+                        memoryBuffer.Write(value);
+                    }
 
                     ULONG valueEndPosition = memoryBuffer.Position;
                     STORE_ASSERT(valueEndPosition >= valueStartPosition, "valueEndPosition={1} >= valueStartPosition={2}", valueEndPosition, valueStartPosition);
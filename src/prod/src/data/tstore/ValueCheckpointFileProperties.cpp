@@ -13,7 +13,8 @@ using namespace Data::Utilities;
 ValueCheckpointFileProperties::ValueCheckpointFileProperties()
     :valuesHandleSPtr_(nullptr),
     valueCount_(0),
-    fileId_(0)
+    fileId_(0),
+    isCompressed_(false)
 {
 }
 
@@ -68,6 +69,17 @@ void ValueCheckpointFileProperties::Write(__in BinaryWriter& writer)
     writer.Write(fileId_);
     ByteAlignedReaderWriterHelper::WritePaddingUntilAligned(writer);
 
+    // 'IsCompressed' - bool
+    // Uncompressed files leave it out so that they stay readable by older versions.
+    if (isCompressed_)
+    {
+        writer.Write(static_cast<ULONG32>(PropertyId::IsCompressedProp));
+        VarInt::Write(writer, static_cast<ULONG32>(sizeof(bool)));
+        ByteAlignedReaderWriterHelper::WritePaddingUntilAligned(writer);
+        writer.Write(isCompressed_);
+        ByteAlignedReaderWriterHelper::WritePaddingUntilAligned(writer);
+    }
+
     ByteAlignedReaderWriterHelper::AssertIfNotAligned(writer.Position);
 }
 
@@ -92,6 +104,11 @@ void ValueCheckpointFileProperties::ReadProperty(
         ByteAlignedReaderWriterHelper::ReadPaddingUntilAligned(reader);
         break;
 
+    case PropertyId::IsCompressedProp:
+        reader.Read(isCompressed_);
+        ByteAlignedReaderWriterHelper::ReadPaddingUntilAligned(reader);
+        break;
+
     default:
         FilePropertySection::ReadProperty(reader, property, valueSize);
         ByteAlignedReaderWriterHelper::ReadPaddingUntilAligned(reader);
@@ -54,6 +54,19 @@ namespace Data
                 fileId_ = value;
             }
 
+            //
+            // Whether values larger than ValueCheckpointFile::MinimumCompressedValueSize are LZ4 compressed.
+            //
+            __declspec(property(get = get_IsCompressed, put = set_IsCompressed)) bool IsCompressed;
+            bool get_IsCompressed() const
+            {
+                return isCompressed_;
+            }
+            void set_IsCompressed(__in bool value)
+            {
+                isCompressed_ = value;
+            }
+
             //
             // Serialize ValueCheckpointFileProperties into the given stream.
             // The data is written is 8 bytes aligned.
@@ -75,6 +88,12 @@ namespace Data
             // FileId              bytes       4
             // RESERVED                        4
             // 
+            // IsCompressed.PID    int         4    (only written for compressed files)
+            // Size                VarInt      1
+            // RESERVED                        3
+            // IsCompressed        bool        1
+            // RESERVED                        7
+            // 
             // RESERVED: Fixed padding that is usable to add fields in future.
             // PADDING:  Due to dynamic size, cannot be used for adding fields.
             //
@@ -95,11 +114,13 @@ namespace Data
                 ValuesHandleProp = 1,
                 ValueCountProp = 2,
                 FileIdProp = 3,
+                IsCompressedProp = 4,
             };
 
             BlockHandle::SPtr valuesHandleSPtr_;
             ULONG64 valueCount_;
             ULONG32 fileId_;
+            bool isCompressed_;
 
         };
     }
@@ -76,6 +76,20 @@ namespace Data
             valueSize_ = valueSize;
          }
 
+         //
+         // Size of the serialized value, which is what the value accounts for in memory.
+         // GetValueSize is the size on disk, which is smaller for values stored compressed in their checkpoint file.
+         //
+         LONG32 GetInMemoryValueSize() const
+         {
+            return inMemoryValueSize_ >= 0 ? inMemoryValueSize_ : GetValueSize();
+         }
+
+         void SetInMemoryValueSize(__in LONG32 valueSize)
+         {
+            inMemoryValueSize_ = valueSize;
+         }
+
          virtual ULONG64 GetValueChecksum() const
          {
             return valueChecksum_;
@@ -331,6 +345,7 @@ namespace Data
 
          ULONG32     fileId_ = 0;
          LONG32      valueSize_ = -1;
+         LONG32      inMemoryValueSize_ = -1;
          ULONG64    valueChecksum_ = 0;
 
       private:
@@ -0,0 +1,78 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+#define VERSIONEDITEM_DISKORDER_COMPARER_TAG 'odIV'
+
+namespace Data
+{
+    namespace TStore
+    {
+        //
+        // Orders (key index, versioned item) pairs by the location of the item's value on disk: file id first, then offset.
+        //
+        template<typename TValue>
+        class VersionedItemDiskOrderComparer
+            : public IComparer<KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>>>
+            , public KObject<VersionedItemDiskOrderComparer<TValue>>
+            , public KShared<VersionedItemDiskOrderComparer<TValue>>
+        {
+            K_FORCE_SHARED(VersionedItemDiskOrderComparer)
+            K_SHARED_INTERFACE_IMP(IComparer)
+        public:
+            static NTSTATUS Create(
+                __in KAllocator & allocator,
+                __out SPtr & result)
+            {
+                result = _new(VERSIONEDITEM_DISKORDER_COMPARER_TAG, allocator) VersionedItemDiskOrderComparer<TValue>();
+                if (!result)
+                {
+                    return STATUS_INSUFFICIENT_RESOURCES;
+                }
+
+                return STATUS_SUCCESS;
+            }
+
+            int Compare(__in const KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>> & x, __in const KeyValuePair<ULONG32, KSharedPtr<VersionedItem<TValue>>> & y) const override
+            {
+                ULONG32 xFileId = x.Value->GetFileId();
+                ULONG32 yFileId = y.Value->GetFileId();
+                if (xFileId != yFileId)
+                {
+                    return xFileId < yFileId ? -1 : 1;
+                }
+
+                LONG64 xOffset = x.Value->GetOffset();
+                LONG64 yOffset = y.Value->GetOffset();
+                if (xOffset != yOffset)
+                {
+                    return xOffset < yOffset ? -1 : 1;
+                }
+
+                // Keep the order of the keys for values at the same location.
+                if (x.Key != y.Key)
+                {
+                    return x.Key < y.Key ? -1 : 1;
+                }
+
+                return 0;
+            }
+
+        private:
+            VersionedItemDiskOrderComparer();
+        };
+
+        template<typename TValue>
+        VersionedItemDiskOrderComparer<TValue>::VersionedItemDiskOrderComparer()
+        {
+        }
+
+        template<typename TValue>
+        VersionedItemDiskOrderComparer<TValue>::~VersionedItemDiskOrderComparer()
+        {
+        }
+    }
+}
@@ -39,6 +39,7 @@ namespace Data
 #include "StoreTraceComponent.h"
 #include "Sorter.h"
 #include "StreamPool.h"
+#include "MergeWriteThrottle.h"
 #include "SortedItemComparer.h"
 #include "FastSkipList.h"
 #include "FastSkipListEnumerator.h"
@@ -85,6 +86,7 @@ namespace Data
 #include "UpdatedVersionedItem.h"
 #include "DeletedVersionedItem.h"
 #include "KeyVersionedItemComparer.h"
+#include "VersionedItemDiskOrderComparer.h"
 #include "IReadableStoreComponent.h"
 #include "Diagnostics.h"
 #include "DifferentialStateVersions.h"
@@ -114,6 +116,7 @@ namespace Data
 #include "ValueBlockAlignedWriter.h"
 #include "KeyBlockAlignedWriter.h"
 #include "KeyCheckpointFileAsyncEnumerator.h"
+#include "KeyBlockIndex.h"
 #include "BlockAlignedWriter.h"
 #include "CheckpointFile.h"
 #include "FileMetadata.h"
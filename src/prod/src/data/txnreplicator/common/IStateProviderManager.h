@@ -26,6 +26,13 @@ namespace TxnReplicator
 
         virtual NTSTATUS Unlock(__in OperationContext const & operationContext) noexcept = 0;
 
+        // Returns the id of the state provider an operation is applied to, so that the operations of a transaction
+        // on different state providers can be applied concurrently.
+        // Returns false if the operation must be ordered with all other operations of its transaction.
+        virtual bool TryGetApplyStateProviderId(
+            __in_opt Data::Utilities::OperationData const * const metadataPtr,
+            __out FABRIC_STATE_PROVIDER_ID & stateProviderId) noexcept = 0;
+
         virtual NTSTATUS PrepareCheckpoint(__in LONG64 checkpointLSN) noexcept = 0;
 
         virtual ktl::Awaitable<NTSTATUS> PerformCheckpointAsync(
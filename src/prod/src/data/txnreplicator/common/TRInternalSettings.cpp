@@ -317,6 +317,70 @@ int TRInternalSettings::LoadGlobalSettingsCallerHoldsLock()
     this->flushedRecordsTraceVectorSize_ = globalConfig_->FlushedRecordsTraceVectorSize;
     i += 1;
 
+    this->groupCommitTargetSizeInKb_ = globalConfig_->GroupCommitTargetSizeInKb;
+    globalConfig_->GroupCommitTargetSizeInKbEntry.AddHandler(
+        [&](EventArgs const &)
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        TraceConfigUpdate<int64>(
+            L"GroupCommitTargetSizeInKb",
+            this->groupCommitTargetSizeInKb_,
+            globalConfig_->GroupCommitTargetSizeInKb);
+
+        this->groupCommitTargetSizeInKb_ = globalConfig_->GroupCommitTargetSizeInKb;
+    });
+
+    i += 1;
+
+    this->groupCommitMaxDelay_ = globalConfig_->GroupCommitMaxDelay;
+    globalConfig_->GroupCommitMaxDelayEntry.AddHandler(
+        [&](EventArgs const &)
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        TraceConfigUpdate<int64>(
+            L"GroupCommitMaxDelay",
+            this->groupCommitMaxDelay_.TotalMilliseconds(),
+            globalConfig_->GroupCommitMaxDelay.TotalMilliseconds());
+
+        this->groupCommitMaxDelay_ = globalConfig_->GroupCommitMaxDelay;
+    });
+
+    i += 1;
+
+    this->enableLogRecordCompression_ = globalConfig_->EnableLogRecordCompression;
+    globalConfig_->EnableLogRecordCompressionEntry.AddHandler(
+        [&](EventArgs const &)
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        TraceConfigUpdate<bool>(
+            L"EnableLogRecordCompression",
+            this->enableLogRecordCompression_,
+            globalConfig_->EnableLogRecordCompression);
+
+        this->enableLogRecordCompression_ = globalConfig_->EnableLogRecordCompression;
+    });
+
+    i += 1;
+
+    this->recoveryDecodeParallelism_ = globalConfig_->RecoveryDecodeParallelism;
+    globalConfig_->RecoveryDecodeParallelismEntry.AddHandler(
+        [&](EventArgs const &)
+    {
+        AcquireExclusiveLock grab(lock_);
+
+        TraceConfigUpdate<int64>(
+            L"RecoveryDecodeParallelism",
+            this->recoveryDecodeParallelism_,
+            globalConfig_->RecoveryDecodeParallelism);
+
+        this->recoveryDecodeParallelism_ = globalConfig_->RecoveryDecodeParallelism;
+    });
+
+    i += 1;
+
     return i;
 }
 
@@ -795,6 +859,30 @@ int64 TRInternalSettings::get_FlushedRecordsTraceVectorSize() const
     return flushedRecordsTraceVectorSize_;
 }
 
+int64 TRInternalSettings::get_GroupCommitTargetSizeInKb() const
+{
+    AcquireReadLock grab(lock_);
+    return groupCommitTargetSizeInKb_;
+}
+
+Common::TimeSpan TRInternalSettings::get_GroupCommitMaxDelay() const
+{
+    AcquireReadLock grab(lock_);
+    return groupCommitMaxDelay_;
+}
+
+bool TRInternalSettings::get_EnableLogRecordCompression() const
+{
+    AcquireReadLock grab(lock_);
+    return enableLogRecordCompression_;
+}
+
+int64 TRInternalSettings::get_RecoveryDecodeParallelism() const
+{
+    AcquireReadLock grab(lock_);
+    return recoveryDecodeParallelism_;
+}
+
 Common::TimeSpan TRInternalSettings::get_TruncationInterval() const
 {
     AcquireReadLock grab(lock_);
@@ -908,5 +996,17 @@ int TRInternalSettings::WriteTo(__in Common::TextWriter & w, Common::FormatOptio
     w.WriteLine("DispatchingMode = {0}, ", this->DispatchingMode);
     i += 1;
 
+    w.WriteLine("GroupCommitTargetSizeInKb = {0}, ", this->GroupCommitTargetSizeInKb);
+    i += 1;
+
+    w.WriteLine("GroupCommitMaxDelay = {0}, ", this->GroupCommitMaxDelay);
+    i += 1;
+
+    w.WriteLine("EnableLogRecordCompression = {0}, ", this->EnableLogRecordCompression);
+    i += 1;
+
+    w.WriteLine("RecoveryDecodeParallelism = {0}, ", this->RecoveryDecodeParallelism);
+    i += 1;
+
     return i;
 }
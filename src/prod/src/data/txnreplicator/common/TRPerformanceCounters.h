@@ -139,6 +139,30 @@ namespace TxnReplicator
                     L"Avg. Serialization Latency (ms) base",
                     L"Base counter for Average duration of serialization in PhysicalLogWriter flush",
                     noDisplay)
+                COUNTER_DEFINITION_WITH_BASE(
+                    21,
+                    22,
+                    Common::PerformanceCounterType::AverageCount64,
+                    L"Avg. Records Flushed/IO",
+                    L"The number of log records flushed in every IO.")
+                COUNTER_DEFINITION(
+                    22,
+                    Common::PerformanceCounterType::AverageBase,
+                    L"Avg. Records Flushed/IO Base",
+                    L"Base counter for Number of log records flushed per IO",
+                    noDisplay)
+                COUNTER_DEFINITION_WITH_BASE(
+                    23,
+                    24,
+                    Common::PerformanceCounterType::AverageCount64,
+                    L"Avg. Group Commit Wait (ms)",
+                    L"Average duration a PhysicalLogWriter flush was held to group more records")
+                COUNTER_DEFINITION(
+                    24,
+                    Common::PerformanceCounterType::AverageBase,
+                    L"Avg. Group Commit Wait (ms) base",
+                    L"Base counter for Average duration a PhysicalLogWriter flush was held to group more records",
+                    noDisplay)
 
             END_COUNTER_SET_DEFINITION()
 
@@ -162,6 +186,10 @@ namespace TxnReplicator
             DECLARE_COUNTER_INSTANCE(AvgFlushLatencyBase)
             DECLARE_COUNTER_INSTANCE(AvgSerializationLatency)
             DECLARE_COUNTER_INSTANCE(AvgSerializationLatencyBase)
+            DECLARE_COUNTER_INSTANCE(AvgRecordsPerFlush)
+            DECLARE_COUNTER_INSTANCE(AvgRecordsPerFlushBase)
+            DECLARE_COUNTER_INSTANCE(AvgGroupCommitWait)
+            DECLARE_COUNTER_INSTANCE(AvgGroupCommitWaitBase)
 
             BEGIN_COUNTER_SET_INSTANCE(TRPerformanceCounters)
                 DEFINE_COUNTER_INSTANCE(
@@ -224,6 +252,18 @@ namespace TxnReplicator
                 DEFINE_COUNTER_INSTANCE(
                     AvgSerializationLatencyBase,
                     20)
+                DEFINE_COUNTER_INSTANCE(
+                    AvgRecordsPerFlush,
+                    21)
+                DEFINE_COUNTER_INSTANCE(
+                    AvgRecordsPerFlushBase,
+                    22)
+                DEFINE_COUNTER_INSTANCE(
+                    AvgGroupCommitWait,
+                    23)
+                DEFINE_COUNTER_INSTANCE(
+                    AvgGroupCommitWaitBase,
+                    24)
             END_COUNTER_SET_INSTANCE()
 
             public:
@@ -20,6 +20,7 @@ TransactionBase::TransactionBase(
     , transactionId_(transactionId)
     , isPrimaryTransaction_(isPrimaryTransaction)
     , lockContexts_(GetThisAllocator())
+    , lockContextsLock_()
     , transactionManager_()
     , isWriteTransaction_(false)
     , retryDelay_(32)
@@ -41,6 +42,7 @@ TransactionBase::TransactionBase(
     , transactionId_(transactionId)
     , isPrimaryTransaction_(isPrimaryTransaction)
     , lockContexts_(GetThisAllocator())
+    , lockContextsLock_()
     , transactionManager_()
     , isWriteTransaction_(false)
     , retryDelay_(32)
@@ -243,7 +245,15 @@ bool TransactionBase::operator!=(TransactionBase const &other) const
 NTSTATUS TransactionBase::AddLockContext(
     __in LockContext & lockContext) noexcept
 {
-    return lockContexts_.Append(&lockContext);
+    // Secondary apply can run the operations of a transaction on different state providers concurrently
+    NTSTATUS status = STATUS_SUCCESS;
+
+    K_LOCK_BLOCK(lockContextsLock_)
+    {
+        status = lockContexts_.Append(&lockContext);
+    }
+
+    return status;
 }
 
 NTSTATUS TransactionBase::ErrorIfNotPrimaryTransaction(bool isPrimaryTransaction)
@@ -151,6 +151,7 @@ namespace TxnReplicator
         bool const isPrimaryTransaction_;
 
         KArray<LockContext::SPtr> lockContexts_;
+        KSpinLock lockContextsLock_;
         KWeakRef<ITransactionManager>::SPtr transactionManager_;
         KSpinLock transactionManagerLock_;
 
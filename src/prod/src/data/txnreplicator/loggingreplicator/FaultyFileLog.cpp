@@ -25,6 +25,7 @@ FaultyFileLog::FaultyFileLog(__in PartitionedReplicaId const & traceId)
     throwExceptionInFlushWithMarkerAsync_ = false;
     appendAsyncDelayInMs_ = 0;
     flushWithMarkerAsyncDelayInMs_ = 0;
+    flushWithMarkerAsyncCount_ = 0;
     testExceptionStatusCode_ = STATUS_INSUFFICIENT_RESOURCES;
 }
 
@@ -85,6 +86,8 @@ Awaitable<NTSTATUS> FaultyFileLog::AppendAsync(
 
 Awaitable<NTSTATUS> FaultyFileLog::FlushWithMarkerAsync(__in CancellationToken const& cancellationToken)
 {
+    InterlockedIncrement(&flushWithMarkerAsyncCount_);
+
     if (flushWithMarkerAsyncDelayInMs_ > 0)
     {
         NTSTATUS status = co_await KTimer::StartTimerAsync(GetThisAllocator(), FAULTYFILELOGMANAGER_TAG, flushWithMarkerAsyncDelayInMs_, nullptr);
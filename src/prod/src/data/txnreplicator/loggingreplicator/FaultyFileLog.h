@@ -57,6 +57,15 @@ namespace Data
                 flushWithMarkerAsyncDelayInMs_ = value;
             }
 
+            //
+            // Number of FlushWithMarkerAsync calls issued on the log
+            //
+            __declspec(property(get = get_FlushWithMarkerAsyncCount)) LONG FlushWithMarkerAsyncCount;
+            LONG get_FlushWithMarkerAsyncCount() const
+            {
+                return flushWithMarkerAsyncCount_;
+            };
+
             //
             // Determines if an exception status code should be returned in AppendAsync.
             // The exception type can be set through the ReturnedExceptionStatusCode property
@@ -118,6 +127,7 @@ namespace Data
 
             ULONG appendAsyncDelayInMs_;
             ULONG flushWithMarkerAsyncDelayInMs_;
+            volatile LONG flushWithMarkerAsyncCount_;
             bool throwExceptionInAppendAsync_;
             bool throwExceptionInFlushWithMarkerAsync_;
             NTSTATUS testExceptionStatusCode_;
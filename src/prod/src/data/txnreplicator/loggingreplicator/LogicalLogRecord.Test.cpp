@@ -74,6 +74,63 @@ namespace LoggingReplicatorTests
         return recordFromOperationData;
     }
 
+    //
+    // Create an operation data with buffers of repeating content, large enough to be compressed
+    //
+    OperationData::SPtr CreateCompressibleOperationData(
+        __in ULONG bufferCount,
+        __in ULONG bufferSize,
+        __in KAllocator & allocator)
+    {
+        OperationData::SPtr operationData = OperationData::Create(allocator);
+
+        for (ULONG i = 0; i < bufferCount; i++)
+        {
+            KBuffer::SPtr buffer = nullptr;
+            NTSTATUS status = KBuffer::Create(bufferSize, buffer, allocator);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            BYTE * content = static_cast<BYTE *>(buffer->GetBuffer());
+            for (ULONG j = 0; j < bufferSize; j++)
+            {
+                content[j] = static_cast<BYTE>('a' + ((i + j) % 8));
+            }
+
+            operationData->Append(*buffer);
+        }
+
+        return operationData;
+    }
+
+    //
+    // Returns the record type as written in the logical metadata section of a record written by LogRecord::WriteRecord,
+    // which is the buffer after the leading record length
+    //
+    LONG32 ReadSerializedRecordType(
+        __in OperationData const & writtenData,
+        __in KAllocator & allocator)
+    {
+        BinaryReader reader(*writtenData[1], allocator);
+
+        ULONG32 sizeOfSection = 0;
+        reader.Read(sizeOfSection);
+
+        LONG32 recordType = 0;
+        reader.Read(recordType);
+        return recordType;
+    }
+
+    //
+    // Readers from before log record compression only create records for the types up to LastValidEnum
+    // and fail on any other type, see LogRecord::ReadRecord
+    //
+    bool IsAcceptedByDownLevelReader(__in LONG32 serializedRecordType)
+    {
+        return
+            serializedRecordType > LogRecordType::Enum::Invalid &&
+            serializedRecordType <= LogRecordType::Enum::LastValidEnum;
+    }
+
     void SerializeAndVerifyOperationDataEquality(
         __in BinaryWriter & writer,
         __in OperationData::SPtr operationDataToVerify,
@@ -443,5 +500,149 @@ namespace LoggingReplicatorTests
         }
     }
 
+    BOOST_AUTO_TEST_CASE(VerifyOperationLogRecordEquals_CompressedPayload)
+    {
+        TEST_TRACE_BEGIN("VerifyOperationLogRecordEquals_CompressedPayload")
+        {
+            TestLogRecordUtility::SPtr util = TestLogRecordUtility::Create(allocator);
+
+            OperationData::SPtr metaData = CreateCompressibleOperationData(1, 64, allocator);
+            OperationData::SPtr undo = CreateCompressibleOperationData(3, 1024, allocator);
+            OperationData::SPtr redo = CreateCompressibleOperationData(2, 4096, allocator);
+
+            TestTransaction::SPtr transaction = TestTransaction::Create(*util->InvalidRecords, 1, 1, false, STATUS_SUCCESS, allocator);
+            transaction->AddOperation(metaData.RawPtr(), undo.RawPtr(), redo.RawPtr());
+
+            OperationLogRecord::SPtr baseRecord = dynamic_cast<OperationLogRecord *>(transaction->LogRecords[1].RawPtr());
+            baseRecord->CompressPayload = true;
+
+            LogRecord::SPtr fromOperationData = WriteAndVerifyLogicalRecord(*util, baseRecord);
+            OperationLogRecord::SPtr outputRecord = dynamic_cast<OperationLogRecord *>(fromOperationData.RawPtr());
+
+            // Both payloads were logged compressed
+            BYTE const expectedFlags = OperationDataCompression::UndoCompressed | OperationDataCompression::RedoCompressed;
+            VERIFY_ARE_EQUAL(baseRecord->CompressionFlags, expectedFlags);
+            VERIFY_ARE_EQUAL(outputRecord->CompressionFlags, expectedFlags);
+            VERIFY_IS_TRUE(outputRecord->ApproximateSizeOnDisk < 3 * 1024 + 2 * 4096);
+
+            // The payload read back is decompressed with the original buffer boundaries
+            VERIFY_ARE_EQUAL(undo->Test_Equals(*outputRecord->Undo), true);
+            VERIFY_ARE_EQUAL(redo->Test_Equals(*outputRecord->Redo), true);
+            VERIFY_ARE_EQUAL(outputRecord->Redo->BufferCount, 2);
+
+            // Decompression happens once, later reads return the published payload
+            VERIFY_ARE_EQUAL(outputRecord->Redo.RawPtr(), outputRecord->Redo.RawPtr());
+
+            // Records received in compressed form are written again without being decompressed
+            WriteAndVerifyLogicalRecord(*util, outputRecord);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(VerifyBeginTxRecordEquals_CompressedPayload)
+    {
+        TEST_TRACE_BEGIN("VerifyBeginTxRecordEquals_CompressedPayload")
+        {
+            TestLogRecordUtility::SPtr util = TestLogRecordUtility::Create(allocator);
+
+            OperationData::SPtr metaData = CreateCompressibleOperationData(1, 64, allocator);
+            OperationData::SPtr undo = CreateCompressibleOperationData(3, 1024, allocator);
+
+            // Redo data below the compression threshold is stored as is
+            OperationData::SPtr redo = CreateCompressibleOperationData(1, 128, allocator);
+
+            TestTransaction::SPtr transaction =
+                TestTransaction::Create(
+                    *util->InvalidRecords,
+                    metaData.RawPtr(),
+                    undo.RawPtr(),
+                    redo.RawPtr(),
+                    false,
+                    STATUS_SUCCESS,
+                    allocator);
+
+            BeginTransactionOperationLogRecord::SPtr baseRecord = dynamic_cast<BeginTransactionOperationLogRecord *>(transaction->LogRecords[0].RawPtr());
+            baseRecord->CompressPayload = true;
+
+            LogRecord::SPtr fromOperationData = WriteAndVerifyLogicalRecord(*util, baseRecord);
+            BeginTransactionOperationLogRecord::SPtr outputRecord = dynamic_cast<BeginTransactionOperationLogRecord *>(fromOperationData.RawPtr());
+
+            // Only the undo data was large enough to be compressed
+            BYTE const expectedFlags = OperationDataCompression::UndoCompressed;
+            VERIFY_ARE_EQUAL(baseRecord->CompressionFlags, expectedFlags);
+            VERIFY_ARE_EQUAL(outputRecord->CompressionFlags, expectedFlags);
+
+            VERIFY_ARE_EQUAL(undo->Test_Equals(*outputRecord->Undo), true);
+            VERIFY_ARE_EQUAL(redo->Test_Equals(*outputRecord->Redo), true);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(CompressedPayload_RejectedByDownLevelReader)
+    {
+        TEST_TRACE_BEGIN("CompressedPayload_RejectedByDownLevelReader")
+        {
+            TestLogRecordUtility::SPtr util = TestLogRecordUtility::Create(allocator);
+
+            OperationData::SPtr metaData = CreateCompressibleOperationData(1, 64, allocator);
+            OperationData::SPtr undo = CreateCompressibleOperationData(3, 1024, allocator);
+            OperationData::SPtr redo = CreateCompressibleOperationData(2, 4096, allocator);
+            OperationData::SPtr smallRedo = CreateCompressibleOperationData(1, 128, allocator);
+
+            // Operation record with a compressed payload
+            {
+                TestTransaction::SPtr transaction = TestTransaction::Create(*util->InvalidRecords, 1, 1, false, STATUS_SUCCESS, allocator);
+                transaction->AddOperation(metaData.RawPtr(), undo.RawPtr(), redo.RawPtr());
+
+                OperationLogRecord::SPtr record = dynamic_cast<OperationLogRecord *>(transaction->LogRecords[1].RawPtr());
+                record->CompressPayload = true;
+
+                util->Reset();
+                OperationData::CSPtr writtenData = util->WriteRecord(*record, false);
+
+                LONG32 serializedRecordType = ReadSerializedRecordType(*writtenData, allocator);
+                VERIFY_ARE_EQUAL(serializedRecordType, static_cast<LONG32>(LogRecordType::Enum::CompressedOperation));
+                VERIFY_IS_FALSE(IsAcceptedByDownLevelReader(serializedRecordType));
+
+                // Current readers map it back to an operation record
+                LogRecord::SPtr readRecord = util->ReadRecordFromOperationData(writtenData, *util->InvalidRecords);
+                VERIFY_ARE_EQUAL(readRecord->RecordType, LogRecordType::Enum::Operation);
+            }
+
+            // Begin transaction record with a compressed payload
+            {
+                TestTransaction::SPtr transaction =
+                    TestTransaction::Create(*util->InvalidRecords, metaData.RawPtr(), undo.RawPtr(), redo.RawPtr(), false, STATUS_SUCCESS, allocator);
+
+                BeginTransactionOperationLogRecord::SPtr record = dynamic_cast<BeginTransactionOperationLogRecord *>(transaction->LogRecords[0].RawPtr());
+                record->CompressPayload = true;
+
+                util->Reset();
+                OperationData::CSPtr writtenData = util->WriteRecord(*record, false);
+
+                LONG32 serializedRecordType = ReadSerializedRecordType(*writtenData, allocator);
+                VERIFY_ARE_EQUAL(serializedRecordType, static_cast<LONG32>(LogRecordType::Enum::CompressedBeginTransaction));
+                VERIFY_IS_FALSE(IsAcceptedByDownLevelReader(serializedRecordType));
+
+                LogRecord::SPtr readRecord = util->ReadRecord(writtenData, false);
+                VERIFY_ARE_EQUAL(readRecord->RecordType, LogRecordType::Enum::BeginTransaction);
+            }
+
+            // Compression enabled but nothing large enough to compress keeps the format older readers accept
+            {
+                TestTransaction::SPtr transaction = TestTransaction::Create(*util->InvalidRecords, 1, 1, false, STATUS_SUCCESS, allocator);
+                transaction->AddOperation(metaData.RawPtr(), smallRedo.RawPtr(), smallRedo.RawPtr());
+
+                OperationLogRecord::SPtr record = dynamic_cast<OperationLogRecord *>(transaction->LogRecords[1].RawPtr());
+                record->CompressPayload = true;
+
+                util->Reset();
+                OperationData::CSPtr writtenData = util->WriteRecord(*record, false);
+
+                LONG32 serializedRecordType = ReadSerializedRecordType(*writtenData, allocator);
+                VERIFY_ARE_EQUAL(serializedRecordType, static_cast<LONG32>(LogRecordType::Enum::Operation));
+                VERIFY_IS_TRUE(IsAcceptedByDownLevelReader(serializedRecordType));
+            }
+        }
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
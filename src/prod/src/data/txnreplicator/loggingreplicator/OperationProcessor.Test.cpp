@@ -31,7 +31,10 @@ namespace LoggingReplicatorTests
             CommonConfig config; // load the config object as its needed for the tracing to work
         }
         
-        void InitializeTest(__in int seed, __in bool recoveryCompleted);
+        void InitializeTest(
+            __in int seed,
+            __in bool recoveryCompleted,
+            __in std::wstring const & dispatchingMode = L"");
         void EndTest();
 
         static void AddExpectedOperationData(
@@ -83,7 +86,10 @@ namespace LoggingReplicatorTests
         apiFaultUtility_.Reset();
     }
 
-    void OperationProcessorTests::InitializeTest(__in int seed, __in bool recoveryCompleted)
+    void OperationProcessorTests::InitializeTest(
+        __in int seed,
+        __in bool recoveryCompleted,
+        __in std::wstring const & dispatchingMode)
     {
         UNREFERENCED_PARAMETER(seed);
 
@@ -111,7 +117,9 @@ namespace LoggingReplicatorTests
 
         std::wstring currentDirectory = Common::Directory::GetCurrentDirectoryW();
         KString::SPtr mockWorkFolder = Data::Utilities::KPath::Combine(currentDirectory.c_str(), L"OperationProcessorTests", allocator);
-        TRInternalSettingsSPtr settings = TRInternalSettings::Create(nullptr, make_shared<TransactionalReplicatorConfig>());
+        std::shared_ptr<TransactionalReplicatorConfig> globalConfig = make_shared<TransactionalReplicatorConfig>();
+        globalConfig->DispatchingMode = dispatchingMode;
+        TRInternalSettingsSPtr settings = TRInternalSettings::Create(nullptr, globalConfig);
         TestHealthClientSPtr healthClient = TestHealthClient::Create();
         TestTransactionReplicator::SPtr txnReplicator = TestTransactionReplicator::Create(allocator);
 
@@ -509,6 +517,146 @@ namespace LoggingReplicatorTests
         }
     }
 
+    BOOST_AUTO_TEST_CASE(StateProviderDispatching_ManyStateProviders_VerifyApplyOrderPerStateProvider)
+    {
+        TEST_TRACE_BEGIN("StateProviderDispatching_ManyStateProviders_VerifyApplyOrderPerStateProvider")
+
+        {
+            // Recovery apply is not a primary apply, so the operations of a transaction are applied on one lane per state provider
+            InitializeTest(seed, false, Constants::StateProviderPartitionedDispatchingMode);
+
+            testStateManager_->ApplyStateProviderIdEnabled = true;
+            apiFaultUtility_->DelayApi(ApiName::ApplyAsync, Common::TimeSpan::FromMilliseconds(10));
+
+            ULONG const stateProviderCount = 4;
+            ULONG const operationsPerTx = 12;
+            ULONG const txCount = 3;
+
+            KArray<TestTransaction::SPtr> testTxList(allocator);
+            KArray<TestGroupCommitValidationResult> expectedResults(allocator);
+
+            for (ULONG i = 0; i < txCount; i++)
+            {
+                OperationData::SPtr data = TestTransaction::GenerateOperationData(1, 10, allocator);
+                OperationData::SPtr metadata = TestStateProviderManager::CreateApplyStateProviderMetadata(0, allocator);
+
+                TestTransaction::SPtr testTx = TestTransaction::Create(
+                    *invalidLogRecords_,
+                    metadata.RawPtr(),
+                    data.RawPtr(),
+                    data.RawPtr(),
+                    false,
+                    STATUS_SUCCESS,
+                    allocator);
+
+                for (ULONG j = 1; j < operationsPerTx; j++)
+                {
+                    metadata = TestStateProviderManager::CreateApplyStateProviderMetadata(j % stateProviderCount, allocator);
+                    testTx->AddOperation(metadata.RawPtr(), data.RawPtr(), data.RawPtr());
+                }
+
+                testTx->Commit(true);
+                testTxList.Append(testTx);
+            }
+
+            // Each transaction is followed by a barrier so that the dispatcher applies the commits one after the other
+            LONG64 lsn = 1;
+            KArray<LogRecord::SPtr> txnRecords(allocator);
+            for (ULONG i = 0; i < txCount; i++)
+            {
+                KArray<TestTransaction::SPtr> singleTxList(allocator);
+                singleTxList.Append(testTxList[i]);
+
+                KArray<LogRecord::SPtr> records = TestTransactionGenerator::InterleaveTransactions(singleTxList, lsn, seed, allocator, lsn);
+                expectedResults.Append(TestTransactionGenerator::InsertBarrier(records, 1, 0, 0, 0, seed, allocator));
+
+                for (ULONG j = 0; j < records.Count(); j++)
+                {
+                    txnRecords.Append(records[j]);
+                }
+            }
+
+            LoggedRecords::SPtr loggedRecords = LoggedRecords::Create(txnRecords, allocator);
+
+            recordsDispatcher_->DispatchLoggedRecords(*loggedRecords);
+
+            // The test state manager asserts that every state provider sees its operations in commit and lsn order
+            bool isProcessingComplete = testStateManager_->WaitForProcessingToComplete(static_cast<LONG>(txCount * operationsPerTx), 0, Common::TimeSpan::FromSeconds(5));
+            VERIFY_ARE_EQUAL(isProcessingComplete, true);
+
+            // There is a single lane on a single processor machine
+            if (Common::Environment::GetNumberOfProcessors() > 1)
+            {
+                VERIFY_IS_TRUE(testStateManager_->MaxConcurrentApplyCount > 1);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(StateProviderDispatching_ConsecutiveCommitsOnSameStateProvider_VerifyApplyOrder)
+    {
+        TEST_TRACE_BEGIN("StateProviderDispatching_ConsecutiveCommitsOnSameStateProvider_VerifyApplyOrder")
+
+        {
+            // Apply lanes only live for one commit. The second commit must not reach state provider 0 before the
+            // lane of the first commit has drained it, even though its other lane finishes much earlier
+            InitializeTest(seed, false, Constants::StateProviderPartitionedDispatchingMode);
+
+            testStateManager_->ApplyStateProviderIdEnabled = true;
+            apiFaultUtility_->DelayApi(ApiName::ApplyAsync, Common::TimeSpan::FromMilliseconds(10));
+
+            ULONG const operationsPerTx = 8;
+            ULONG const txCount = 2;
+
+            LONG64 lsn = 1;
+            KArray<LogRecord::SPtr> txnRecords(allocator);
+            KArray<TestGroupCommitValidationResult> expectedResults(allocator);
+
+            for (ULONG i = 0; i < txCount; i++)
+            {
+                OperationData::SPtr data = TestTransaction::GenerateOperationData(1, 10, allocator);
+                OperationData::SPtr metadata = TestStateProviderManager::CreateApplyStateProviderMetadata(0, allocator);
+
+                TestTransaction::SPtr testTx = TestTransaction::Create(
+                    *invalidLogRecords_,
+                    metadata.RawPtr(),
+                    data.RawPtr(),
+                    data.RawPtr(),
+                    false,
+                    STATUS_SUCCESS,
+                    allocator);
+
+                // The first commit puts most of its operations on state provider 0 and one on state provider 1
+                for (ULONG j = 1; j < operationsPerTx; j++)
+                {
+                    FABRIC_STATE_PROVIDER_ID stateProviderId = (i == 0 && j == 1) ? 1 : 0;
+                    metadata = TestStateProviderManager::CreateApplyStateProviderMetadata(stateProviderId, allocator);
+                    testTx->AddOperation(metadata.RawPtr(), data.RawPtr(), data.RawPtr());
+                }
+
+                testTx->Commit(true);
+
+                KArray<TestTransaction::SPtr> testTxList(allocator);
+                testTxList.Append(testTx);
+
+                KArray<LogRecord::SPtr> records = TestTransactionGenerator::InterleaveTransactions(testTxList, lsn, seed, allocator, lsn);
+                expectedResults.Append(TestTransactionGenerator::InsertBarrier(records, 1, 0, 0, 0, seed, allocator));
+
+                for (ULONG j = 0; j < records.Count(); j++)
+                {
+                    txnRecords.Append(records[j]);
+                }
+            }
+
+            LoggedRecords::SPtr loggedRecords = LoggedRecords::Create(txnRecords, allocator);
+
+            recordsDispatcher_->DispatchLoggedRecords(*loggedRecords);
+
+            // The test state manager asserts that state provider 0 sees all operations of the first commit before the second
+            bool isProcessingComplete = testStateManager_->WaitForProcessingToComplete(static_cast<LONG>(txCount * operationsPerTx), 0, Common::TimeSpan::FromSeconds(5));
+            VERIFY_ARE_EQUAL(isProcessingComplete, true);
+        }
+    }
+
     BOOST_AUTO_TEST_CASE(OneCommittedTx_VerifyWaitForLogicalRecordsProcessing)
     {
         TEST_TRACE_BEGIN("OneCommittedTx_VerifyWaitForLogicalRecordsProcessing")
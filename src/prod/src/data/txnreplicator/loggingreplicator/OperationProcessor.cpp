@@ -38,6 +38,10 @@ OperationProcessor::OperationProcessor(
     , backupManager_(&backupManager)
     , transactionalReplicatorConfig_(transactionalReplicatorConfig)
     , enableSecondaryCommitApplyAcknowledgement_(transactionalReplicatorConfig->EnableSecondaryCommitApplyAcknowledgement)
+    , stateProviderApplyLaneCount_(
+        transactionalReplicatorConfig->DispatchingMode.compare(Constants::StateProviderPartitionedDispatchingMode) == 0 ?
+            static_cast<ULONG>(Common::Environment::GetNumberOfProcessors()) :
+            0)
     , serviceError_(STATUS_SUCCESS)
     , logError_(STATUS_SUCCESS)
     , lastAppliedBarrierRecord_(nullptr)
@@ -615,6 +619,176 @@ void OperationProcessor::Unlock(__in LogicalLogRecord & record)
     ProcessedLogicalRecord(record);
 }
 
+Awaitable<bool> OperationProcessor::TryApplyTransactionByStateProviderAsync(
+    __in IStateProviderManager & stateManager,
+    __in BeginTransactionOperationLogRecord & beginTransactionRecord,
+    __in EndTransactionLogRecord & endTransactionRecord,
+    __in ApplyContext::Enum applyRedoContext,
+    __out NTSTATUS & status) noexcept
+{
+    status = STATUS_SUCCESS;
+
+    IStateProviderManager::SPtr stateManagerSPtr = &stateManager;
+    BeginTransactionOperationLogRecord::SPtr beginTransactionRecordSPtr = &beginTransactionRecord;
+    EndTransactionLogRecord::SPtr endTransactionRecordSPtr = &endTransactionRecord;
+
+    // Lanes only live for this commit. The dispatcher does not start a later commit that can touch the same state
+    // providers until this apply returns, and this apply waits for all of its lanes, so order across commits holds
+    std::unordered_map<ULONG, ApplyLaneSPtr> lanes;
+    TransactionLogRecord::SPtr transactionRecord = beginTransactionRecordSPtr.RawPtr();
+
+    try
+    {
+        // Operations on the same state provider stay in log order within their lane
+        while (transactionRecord.RawPtr() != endTransactionRecordSPtr.RawPtr())
+        {
+            // The transaction object is shared on the secondary, so the commit lsn is set before any lane starts applying
+            transactionRecord->BaseTransaction.CommitSequenceNumber = endTransactionRecordSPtr->Lsn;
+
+            OperationData::CSPtr metadata = nullptr;
+
+            if (transactionRecord->RecordType == LogRecordType::Enum::BeginTransaction)
+            {
+                metadata = beginTransactionRecordSPtr->Metadata;
+            }
+            else
+            {
+                OperationLogRecord * operationRecord = dynamic_cast<OperationLogRecord *>(transactionRecord.RawPtr());
+                ASSERT_IF(
+                    operationRecord == nullptr,
+                    "{0}: TryApplyTransactionByStateProviderAsync | Unexpected dynamic cast failure",
+                    TraceId);
+
+                metadata = operationRecord->Metadata;
+            }
+
+            FABRIC_STATE_PROVIDER_ID stateProviderId = 0;
+            if (!stateManagerSPtr->TryGetApplyStateProviderId(metadata.RawPtr(), stateProviderId))
+            {
+                co_return false;
+            }
+
+            ULONG laneIndex = static_cast<ULONG>(static_cast<ULONG64>(stateProviderId) % stateProviderApplyLaneCount_);
+            ApplyLaneSPtr & lane = lanes[laneIndex];
+
+            if (lane == nullptr)
+            {
+                KSharedArray<TransactionLogRecord::SPtr> * lanePointer = _new(LOGRECORDS_DISPATCHER_TAG, GetThisAllocator()) KSharedArray<TransactionLogRecord::SPtr>();
+                THROW_ON_ALLOCATION_FAILURE(lanePointer);
+
+                lane = lanePointer;
+            }
+
+            THROW_ON_FAILURE(lane->Append(transactionRecord));
+
+            transactionRecord = transactionRecord->ChildTransactionRecord;
+
+            ASSERT_IFNOT(
+                transactionRecord != nullptr && !LogRecord::IsInvalid(transactionRecord.RawPtr()),
+                "{0}: TryApplyTransactionByStateProviderAsync | Invalid child xact record encountered",
+                TraceId);
+        }
+
+        if (lanes.size() < 2)
+        {
+            co_return false;
+        }
+
+        KArray<Awaitable<NTSTATUS>> laneTasks(GetThisAllocator(), static_cast<ULONG>(lanes.size()));
+        THROW_ON_FAILURE(laneTasks.Status());
+
+        // The first lane to fail stops the others before their next operation, as the serial apply stops at the failed operation.
+        // Operations already applied are not undone; the failure is reported as a service error like any other apply failure.
+        LONG volatile firstFailure = STATUS_SUCCESS;
+
+        for (auto & pair : lanes)
+        {
+            THROW_ON_FAILURE(laneTasks.Append(ApplyLaneAsync(*stateManagerSPtr, pair.second, applyRedoContext, firstFailure)));
+        }
+
+        status = co_await TaskUtilities<NTSTATUS>::WhenAll_NoException(laneTasks);
+
+        if (NT_SUCCESS(status))
+        {
+            status = firstFailure;
+        }
+    }
+    catch (Exception & e)
+    {
+        status = e.GetStatus();
+    }
+
+    co_return true;
+}
+
+Awaitable<NTSTATUS> OperationProcessor::ApplyLaneAsync(
+    __in IStateProviderManager & stateManager,
+    __in ApplyLaneSPtr lane,
+    __in ApplyContext::Enum applyRedoContext,
+    __inout LONG volatile & firstFailure) noexcept
+{
+    IStateProviderManager::SPtr stateManagerSPtr = &stateManager;
+    NTSTATUS status = STATUS_SUCCESS;
+
+    co_await CorHelper::ThreadPoolThread(GetThisKtlSystem().DefaultThreadPool());
+
+    for (ULONG i = 0; i < lane->Count(); i++)
+    {
+        if (firstFailure != STATUS_SUCCESS)
+        {
+            break;
+        }
+
+        TransactionLogRecord::SPtr transactionRecord = (*lane)[i];
+        OperationData::CSPtr metadata = nullptr;
+        OperationData::CSPtr redo = nullptr;
+
+        BeginTransactionOperationLogRecord * beginTransactionRecord = dynamic_cast<BeginTransactionOperationLogRecord *>(transactionRecord.RawPtr());
+        OperationLogRecord * operationRecord = dynamic_cast<OperationLogRecord *>(transactionRecord.RawPtr());
+
+        if (beginTransactionRecord != nullptr)
+        {
+            metadata = beginTransactionRecord->Metadata;
+            redo = beginTransactionRecord->Redo;
+        }
+        else
+        {
+            metadata = operationRecord->Metadata;
+            redo = operationRecord->Redo;
+        }
+
+        OperationContext::CSPtr operationContext = nullptr;
+
+        status = co_await stateManagerSPtr->ApplyAsync(
+            transactionRecord->Lsn,
+            transactionRecord->BaseTransaction,
+            applyRedoContext,
+            metadata.RawPtr(),
+            redo.RawPtr(),
+            operationContext);
+
+        if (!NT_SUCCESS(status))
+        {
+            InterlockedCompareExchange(&firstFailure, status, STATUS_SUCCESS);
+            break;
+        }
+
+        if (operationContext != nullptr)
+        {
+            if (beginTransactionRecord != nullptr)
+            {
+                beginTransactionRecord->OperationContextValue = *operationContext;
+            }
+            else
+            {
+                operationRecord->OperationContextValue = *operationContext;
+            }
+        }
+    }
+
+    co_return status;
+}
+
 void OperationProcessor::FireCommitNotification(__in TransactionBase const & transaction)
 {
     ITransactionChangeHandler::SPtr eventHandler = changeHandlerCache_.Get();
@@ -836,6 +1010,38 @@ Awaitable<void> OperationProcessor::ApplyCallback(__in LogRecord & record) noexc
                     endTransactionRecord->Lsn);
             }
 
+            // Secondary and recovery apply can run the operations on different state providers concurrently
+            if (stateProviderApplyLaneCount_ > 1 && (applyRedoContext & ApplyContext::PRIMARY) == 0)
+            {
+                bool isApplied = co_await TryApplyTransactionByStateProviderAsync(
+                    *stateManager,
+                    *beginTransactionRecord,
+                    *endTransactionRecord,
+                    applyRedoContext,
+                    status);
+
+                if (isApplied)
+                {
+                    if (!NT_SUCCESS(status))
+                    {
+                        break;
+                    }
+
+                    EventSource::Events->OPApplyCallbackTransactionRecord(
+                        TracePartitionId,
+                        ReplicaId,
+                        roleContextDrainState_->DrainStream,
+                        endTransactionRecord->RecordType,
+                        endTransactionRecord->Lsn,
+                        endTransactionRecord->Psn,
+                        endTransactionRecord->RecordPosition,
+                        endTransactionRecord->BaseTransaction.TransactionId,
+                        false);
+
+                    break;
+                }
+            }
+
             OperationContext::CSPtr operationContext = nullptr;
             
             status = co_await stateManager->ApplyAsync(
@@ -147,6 +147,25 @@ namespace Data
 
             ktl::Awaitable<void> ApplyCallback(__in LogRecordLib::LogRecord & record) noexcept;
 
+            typedef KSharedArray<LogRecordLib::TransactionLogRecord::SPtr>::SPtr ApplyLaneSPtr;
+
+            //
+            // Applies the operations of a committed transaction on one lane per state provider when the dispatching mode is "stateprovider".
+            // Returns false without applying any operation if the transaction touches a single lane or contains state manager operations.
+            //
+            ktl::Awaitable<bool> TryApplyTransactionByStateProviderAsync(
+                __in TxnReplicator::IStateProviderManager & stateManager,
+                __in LogRecordLib::BeginTransactionOperationLogRecord & beginTransactionRecord,
+                __in LogRecordLib::EndTransactionLogRecord & endTransactionRecord,
+                __in TxnReplicator::ApplyContext::Enum applyRedoContext,
+                __out NTSTATUS & status) noexcept;
+
+            ktl::Awaitable<NTSTATUS> ApplyLaneAsync(
+                __in TxnReplicator::IStateProviderManager & stateManager,
+                __in ApplyLaneSPtr lane,
+                __in TxnReplicator::ApplyContext::Enum applyRedoContext,
+                __inout LONG volatile & firstFailure) noexcept;
+
             void FireCommitNotification(__in TxnReplicator::TransactionBase const & transaction);
 
             bool ProcessError(
@@ -175,6 +194,9 @@ namespace Data
             TxnReplicator::TRInternalSettingsSPtr const transactionalReplicatorConfig_;
             bool const enableSecondaryCommitApplyAcknowledgement_;
 
+            // Number of lanes the operations of a transaction are sharded into by state provider on apply. 0 if disabled.
+            ULONG const stateProviderApplyLaneCount_;
+
             TxnReplicator::ITransactionalReplicator * transactionalReplicator_;
         };
     }
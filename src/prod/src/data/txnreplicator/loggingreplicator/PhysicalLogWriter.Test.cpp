@@ -54,6 +54,10 @@ namespace LoggingReplicatorTests
             ULONG count,
             KStringView const flusher);
 
+        Awaitable<void> FlushSequentiallyAsync(
+            ULONG count,
+            KStringView const flusher);
+
         LogRecord::SPtr InsertLogRecords(__in ULONG recordCount, __out ULONG & expectedBufferSize, __out LONG64 & currentBufferSize);
 
         void WaitForRecordFlushToPSN(__in LONG64 targetPsn);
@@ -75,6 +79,7 @@ namespace LoggingReplicatorTests
         PartitionedReplicaId::SPtr prId_;
         KtlSystem * underlyingSystem_;
         KSharedArray<NTSTATUS>::SPtr flushCallbackExceptionArray_;
+        KSpinLock insertLock_;
 
     private:
         LogRecord::SPtr CreateRandomLogRecord();
@@ -211,6 +216,25 @@ namespace LoggingReplicatorTests
         co_return tailRecord;
     }
 
+    Awaitable<void> PhysicalLogWriterTests::FlushSequentiallyAsync(
+        ULONG count,
+        KStringView const flusher)
+    {
+        for (ULONG i = 0; i < count; i++)
+        {
+            // Records must be inserted one at a time, producers resume on different threads
+            K_LOCK_BLOCK(insertLock_)
+            {
+                LogRecord::SPtr record = CreateRandomLogRecord();
+                writer_->InsertBufferedRecord(*record);
+            }
+
+            co_await writer_->FlushAsync(flusher);
+        }
+
+        co_return;
+    }
+
     LogRecord::SPtr PhysicalLogWriterTests::InsertLogRecords(
         __in ULONG recordCount,
         __out ULONG & expectedBufferSize,
@@ -466,6 +490,140 @@ namespace LoggingReplicatorTests
         }
     }
 
+    BOOST_AUTO_TEST_CASE(MultiThreaded_FastFlush_GroupCommit)
+    {
+        TEST_TRACE_BEGIN("MultiThreaded_FastFlush_GroupCommit")
+        {
+            SyncAwait(this->CreatePLWAsync(*prId_, L"MultiThreaded_FastFlush_GroupCommit"));
+            SyncAwait(this->CreateAndFlushLogHead());
+
+            // A flush latency under 2ms still yields a group commit delay, it is tracked below millisecond precision
+            fileLog_->FlushWithMarkerAsyncDelayInMs = 1;
+
+            // Fill the moving average of the flush latency
+            for (ULONG i = 0; i < Data::LogRecordLib::Constants::PhysicalLogWriterMovingAverageHistory; i++)
+            {
+                SyncAwait(CreateLogRecordsAsync(1, L"MultiThreaded_FastFlush_GroupCommitWarmup"));
+            }
+
+            VERIFY_ARE_EQUAL(writer_->GroupCommitWaitCount, 0);
+
+            // Each producer issues its next FlushAsync as soon as its previous one completes, so FlushAsync calls
+            // keep arriving while a flush is held
+            KArray<Awaitable<void>> producers(allocator);
+            status = STATUS_SUCCESS;
+
+            ULONG const producerCount = 8;
+            ULONG const flushesPerProducer = 25;
+            LONG flushCountBefore = fileLog_->FlushWithMarkerAsyncCount;
+
+            for (ULONG i = 0; i < producerCount; i++)
+            {
+                Awaitable<void> producer = FlushSequentiallyAsync(flushesPerProducer, L"MultiThreaded_FastFlush_GroupCommit");
+                status = producers.Append(Ktl::Move(producer));
+                CODING_ERROR_ASSERT(status == STATUS_SUCCESS);
+            }
+
+            for (ULONG i = 0; i < producers.Count(); i++)
+            {
+                SyncAwait(producers[i]);
+            }
+
+            LONG logFlushCount = fileLog_->FlushWithMarkerAsyncCount - flushCountBefore;
+            LONG64 waitCount = writer_->GroupCommitWaitCount;
+            LONG64 joinCount = writer_->GroupCommitJoinCount;
+            Trace.WriteInfo(
+                TraceComponent,
+                "{0} MultiThreaded_FastFlush_GroupCommit: {1} log flushes for {2} FlushAsync calls, {3} held, {4} joined",
+                prId_->TraceId,
+                logFlushCount,
+                producerCount * flushesPerProducer,
+                waitCount,
+                joinCount);
+
+            // With the delay at 0 no flush is held, and every join below would have been a log flush of its own
+            VERIFY_IS_TRUE(waitCount > 0);
+            VERIFY_IS_TRUE(joinCount > 0);
+            VERIFY_IS_TRUE(logFlushCount > 0);
+            VERIFY_IS_TRUE(logFlushCount + joinCount <= static_cast<LONG64>(producerCount * flushesPerProducer));
+
+            auto tailRecord = SyncAwait(CreateLogRecordsAsync(1, L"MultiThreaded_FastFlush_GroupCommitLast"));
+
+            VERIFY_ARE_EQUAL(writer_->CurrentLogTailRecord->Psn, tailRecord->Psn);
+            WaitForRecordFlushToPSN(tailRecord->Psn);
+            WaitForRecordFlush();
+
+            VERIFY_ARE_EQUAL(writer_->BufferedRecordsBytes, 0);
+            VERIFY_ARE_EQUAL(writer_->PendingFlushRecordsBytes, 0);
+
+            SyncAwait(fileLog_->CloseAsync());
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(RecoveryRead_ParallelDecode_RecordsInOrder)
+    {
+        TEST_TRACE_BEGIN("RecoveryRead_ParallelDecode_RecordsInOrder")
+        {
+            SyncAwait(this->CreatePLWAsync(*prId_, L"RecoveryRead_ParallelDecode_RecordsInOrder"));
+            SyncAwait(this->CreateAndFlushLogHead());
+
+            // More records than one read ahead batch of the 4 decode threads
+            LogRecord::SPtr tailRecord = nullptr;
+            for (ULONG i = 0; i < 12; i++)
+            {
+                tailRecord = SyncAwait(CreateLogRecordsAsync(100, L"RecoveryRead_ParallelDecode_RecordsInOrder"));
+            }
+
+            WaitForRecordFlushToPSN(tailRecord->Psn);
+            WaitForRecordFlush();
+
+            TRANSACTIONAL_REPLICATOR_SETTINGS txrSettings = { 0 };
+            TransactionalReplicatorSettingsUPtr tmp;
+            TransactionalReplicatorSettings::FromPublicApi(txrSettings, tmp);
+
+            std::shared_ptr<TransactionalReplicatorConfig> globalConfig = make_shared<TransactionalReplicatorConfig>();
+            globalConfig->RecoveryDecodeParallelism = 4;
+
+            TRInternalSettingsSPtr config = TRInternalSettings::Create(move(tmp), globalConfig);
+            VERIFY_ARE_EQUAL(config->RecoveryDecodeParallelism, static_cast<int64>(4));
+
+            ILogicalLogReadStream::SPtr readStream;
+            status = fileLog_->CreateReadStream(readStream, 1);
+            CODING_ERROR_ASSERT(status == STATUS_SUCCESS);
+
+            LogRecords::SPtr records = LogRecords::Create(
+                *prId_,
+                *readStream,
+                *invalidRecords_,
+                logHead_->RecordPosition,
+                tailRecord->RecordPosition,
+                TestHealthClient::Create(),
+                config,
+                allocator);
+
+            // Records decoded in parallel must still be returned in log order
+            LONG64 expectedPsn = logHead_->Psn;
+            ULONG64 lastRecordPosition = 0;
+
+            while (SyncAwait(records->MoveNextAsync(CancellationToken::None)))
+            {
+                LogRecord::SPtr record = records->GetCurrent();
+
+                VERIFY_ARE_EQUAL(record->Psn, expectedPsn);
+                VERIFY_IS_TRUE(expectedPsn == logHead_->Psn || record->RecordPosition > lastRecordPosition);
+
+                lastRecordPosition = record->RecordPosition;
+                expectedPsn++;
+            }
+
+            VERIFY_ARE_EQUAL(expectedPsn - 1, tailRecord->Psn);
+
+            records->Dispose();
+            SyncAwait(readStream->CloseAsync());
+            SyncAwait(fileLog_->CloseAsync());
+        }
+    }
+
     BOOST_AUTO_TEST_CASE(SetTailRecord_LogicalRecord)
     {
         TEST_TRACE_BEGIN("SetTailRecord_LogicalRecord")
@@ -38,6 +38,8 @@ PhysicalLogWriter::PhysicalLogWriter(
     , maxWriteCacheSizeInBytes_(maxWriteCacheSizeBytes)
     , bufferedRecordsBytes_(0)
     , pendingFlushRecordsBytes_(0)
+    , groupCommitWaitCount_(0)
+    , groupCommitJoinCount_(0)
     , currentLogTailPosition_(0)
     , currentLogTailPsn_(0)
     , currentLogTailRecord_(&invalidTailRecord)
@@ -50,9 +52,9 @@ PhysicalLogWriter::PhysicalLogWriter(
     , recordWriter_(GetThisAllocator())
     , perfCounters_(perfCounters)
     , transactionalReplicatorConfig_(transactionalReplicatorConfig)
-    , runningLatencySumMs_(0)
+    , runningLatencySumTicks_(0)
     , writeSpeedBytesPerSecondSum_(0)
-    , avgRunningLatencyMilliseconds_(GetThisAllocator(), Constants::PhysicalLogWriterMovingAverageHistory, 0)
+    , avgRunningLatencyTicks_(GetThisAllocator(), Constants::PhysicalLogWriterMovingAverageHistory, 0)
     , avgWriteSpeedBytesPerSecond_(GetThisAllocator(), Constants::PhysicalLogWriterMovingAverageHistory, 0)
     , recomputeOffsets_(recomputeOffsets)
 {
@@ -72,7 +74,7 @@ PhysicalLogWriter::PhysicalLogWriter(
 
     ASSERT_IFNOT(ioMonitor_ != nullptr, "Failed to initialize health tracker");
 
-    THROW_ON_CONSTRUCTOR_FAILURE(avgRunningLatencyMilliseconds_);
+    THROW_ON_CONSTRUCTOR_FAILURE(avgRunningLatencyTicks_);
     THROW_ON_CONSTRUCTOR_FAILURE(avgWriteSpeedBytesPerSecond_);
 
     InitializeMovingAverageKArray();
@@ -114,6 +116,8 @@ PhysicalLogWriter::PhysicalLogWriter(
     , maxWriteCacheSizeInBytes_(maxWriteCacheSizeBytes)
     , bufferedRecordsBytes_(0)
     , pendingFlushRecordsBytes_(0)
+    , groupCommitWaitCount_(0)
+    , groupCommitJoinCount_(0)
     , currentLogTailPosition_(0)
     , currentLogTailPsn_(0)
     , currentLogTailRecord_(&tailRecord)
@@ -126,9 +130,9 @@ PhysicalLogWriter::PhysicalLogWriter(
     , recordWriter_(GetThisAllocator())
     , perfCounters_(perfCounters)
     , transactionalReplicatorConfig_(transactionalReplicatorConfig)
-    , runningLatencySumMs_(0)
+    , runningLatencySumTicks_(0)
     , writeSpeedBytesPerSecondSum_(0)
-    , avgRunningLatencyMilliseconds_(GetThisAllocator(), Constants::PhysicalLogWriterMovingAverageHistory, 0)
+    , avgRunningLatencyTicks_(GetThisAllocator(), Constants::PhysicalLogWriterMovingAverageHistory, 0)
     , avgWriteSpeedBytesPerSecond_(GetThisAllocator(), Constants::PhysicalLogWriterMovingAverageHistory, 0)
     , recomputeOffsets_(recomputeOffsets)
 {
@@ -138,7 +142,7 @@ PhysicalLogWriter::PhysicalLogWriter(
         L"PhysicalLogWriter",
         reinterpret_cast<uintptr_t>(this));
 
-    THROW_ON_CONSTRUCTOR_FAILURE(avgRunningLatencyMilliseconds_);
+    THROW_ON_CONSTRUCTOR_FAILURE(avgRunningLatencyTicks_);
     THROW_ON_CONSTRUCTOR_FAILURE(avgWriteSpeedBytesPerSecond_);
 
     ioMonitor_ = IOMonitor::Create(
@@ -648,6 +652,7 @@ Task PhysicalLogWriter::FlushTask(__in AwaitableCompletionSource<void> & initiat
         flushWatch.Stop();
 
         UpdateWriteStats(flushWatch, numberOfBytes);
+        UpdatePerfCounter(PerfCounterName::AvgRecordsPerFlush, flushingRecords_->Count());
 
         currentLogTailPosition_ += numberOfBytes;
         newTail = (*flushingRecords_)[flushingRecords_->Count() - 1];
@@ -666,7 +671,7 @@ Task PhysicalLogWriter::FlushTask(__in AwaitableCompletionSource<void> & initiat
                 flushWatch.ElapsedMilliseconds,
                 serializationWatch.ElapsedMilliseconds,
                 (double)writeSpeedBytesPerSecondSum_ / Constants::PhysicalLogWriterMovingAverageHistory,
-                (double)runningLatencySumMs_ / Constants::PhysicalLogWriterMovingAverageHistory,
+                (double)runningLatencySumTicks_ / Constants::PhysicalLogWriterMovingAverageHistory / Common::TimeSpan::TicksPerMillisecond,
                 logicalLogStream_->WritePosition - (LONG)numberOfBytes);
         }
         else
@@ -679,7 +684,7 @@ Task PhysicalLogWriter::FlushTask(__in AwaitableCompletionSource<void> & initiat
                 flushWatch.ElapsedMilliseconds,
                 serializationWatch.ElapsedMilliseconds,
                 (double)writeSpeedBytesPerSecondSum_ / Constants::PhysicalLogWriterMovingAverageHistory,
-                (double)runningLatencySumMs_ / Constants::PhysicalLogWriterMovingAverageHistory,
+                (double)runningLatencySumTicks_ / Constants::PhysicalLogWriterMovingAverageHistory / Common::TimeSpan::TicksPerMillisecond,
                 logicalLogStream_->WritePosition - (LONG)numberOfBytes);
         }
     
@@ -723,11 +728,102 @@ Task PhysicalLogWriter::FlushTask(__in AwaitableCompletionSource<void> & initiat
             isFlushTask = false;
         }
 
+        if (isFlushTask)
+        {
+            ULONG groupCommitDelayMs = GetGroupCommitDelayMs(flushingTasks->Count());
+
+            if (groupCommitDelayMs > 0)
+            {
+                Common::Stopwatch groupCommitWatch;
+                groupCommitWatch.Start();
+
+                co_await KTimer::StartTimerAsync(GetThisAllocator(), PHYSICALLOGWRITER_TAG, groupCommitDelayMs, nullptr);
+
+                JoinPendingFlushes(*flushingTasks);
+
+                groupCommitWatch.Stop();
+                UpdatePerfCounter(PerfCounterName::AvgGroupCommitWait, groupCommitWatch.ElapsedMilliseconds);
+                ++groupCommitWaitCount_;
+            }
+        }
+
     } while (isFlushTask);
 
     co_return;
 }
 
+ULONG PhysicalLogWriter::GetGroupCommitDelayMs(__in ULONG concurrentFlushCount) const
+{
+    // A single waiter means the writer is not busy enough for a larger write to pay off
+    if (concurrentFlushCount < 2 || !NT_SUCCESS(closedError_.load()))
+    {
+        return 0;
+    }
+
+    LONG64 targetBytes = transactionalReplicatorConfig_->GroupCommitTargetSizeInKb * 1024;
+    if (targetBytes <= 0 || pendingFlushRecordsBytes_.load() >= targetBytes)
+    {
+        return 0;
+    }
+
+    // Holding the flush for more than half of the device flush latency costs the grouped records more than issuing it right away
+    LONG64 delayTicks = (runningLatencySumTicks_ / Constants::PhysicalLogWriterMovingAverageHistory) / 2;
+    LONG64 maxDelayTicks = transactionalReplicatorConfig_->GroupCommitMaxDelay.Ticks;
+
+    if (delayTicks > maxDelayTicks)
+    {
+        delayTicks = maxDelayTicks;
+    }
+
+    // The timer has millisecond resolution, a delay under half a millisecond is not worth holding the flush for
+    LONG64 delayMs = (delayTicks + Common::TimeSpan::TicksPerMillisecond / 2) / Common::TimeSpan::TicksPerMillisecond;
+    LONG64 maxDelayMs = transactionalReplicatorConfig_->GroupCommitMaxDelay.TotalMilliseconds();
+
+    if (delayMs > maxDelayMs)
+    {
+        delayMs = maxDelayMs;
+    }
+
+    return delayMs > 0 ? static_cast<ULONG>(delayMs) : 0;
+}
+
+void PhysicalLogWriter::JoinPendingFlushes(__inout KSharedArray<AwaitableCompletionSource<void>::SPtr> & flushingTasks)
+{
+    NTSTATUS status = STATUS_SUCCESS;
+
+    K_LOCK_BLOCK(flushLock_)
+    {
+        if (pendingFlushRecords_ != nullptr)
+        {
+            for (ULONG i = 0; i < pendingFlushRecords_->Count(); i++)
+            {
+                status = flushingRecords_->Append((*pendingFlushRecords_)[i]);
+                THROW_ON_FAILURE(status);
+            }
+
+            pendingFlushRecords_ = nullptr;
+        }
+
+        // Includes the waiters that had no records of their own, their records are already part of this flush
+        if (pendingFlushTasks_ != nullptr)
+        {
+            // Without the hold, these waiters would have been issued as the next flush
+            if (pendingFlushTasks_->Count() > 0)
+            {
+                ++groupCommitJoinCount_;
+            }
+
+            for (ULONG i = 0; i < pendingFlushTasks_->Count(); i++)
+            {
+                status = flushingTasks.Append((*pendingFlushTasks_)[i]);
+                THROW_ON_FAILURE(status);
+            }
+
+            pendingFlushTasks_ = nullptr;
+        }
+    }
+}
+
 void PhysicalLogWriter::FailedFlushTask(__inout KSharedArray<AwaitableCompletionSource<void>::SPtr>::SPtr & flushingTasks)
 {
     ASSERT_IF(
@@ -921,7 +1017,7 @@ void PhysicalLogWriter::InitializeMovingAverageKArray()
 {
     for(ULONG i = 0; i < Constants::PhysicalLogWriterMovingAverageHistory; i++)
     {
-        avgRunningLatencyMilliseconds_.Append(0);
+        avgRunningLatencyTicks_.Append(0);
         avgWriteSpeedBytesPerSecond_.Append(0);
     }
 }
@@ -936,14 +1032,14 @@ void PhysicalLogWriter::UpdateWriteStats(
     UpdatePerfCounter(PerfCounterName::AvgBytesPerFlush, (LONG)bytesWritten);
 
     LONG64 localAvgWriteSpeed = (LONG64)((bytesWritten * 10000 * 1000) / (ULONG)(watch.ElapsedTicks + 1));
-    LONG64 localAvgRunningLatencyMs = watch.ElapsedMilliseconds;
+    LONG64 localAvgRunningLatencyTicks = watch.ElapsedTicks;
 
-    UpdatePerfCounter(PerfCounterName::AvgFlushLatency, localAvgRunningLatencyMs);
+    UpdatePerfCounter(PerfCounterName::AvgFlushLatency, watch.ElapsedMilliseconds);
 
-    runningLatencySumMs_ -= avgRunningLatencyMilliseconds_[0];
-    avgRunningLatencyMilliseconds_.Remove(0);
-    avgRunningLatencyMilliseconds_.Append(localAvgRunningLatencyMs);
-    runningLatencySumMs_ += localAvgRunningLatencyMs;
+    runningLatencySumTicks_ -= avgRunningLatencyTicks_[0];
+    avgRunningLatencyTicks_.Remove(0);
+    avgRunningLatencyTicks_.Append(localAvgRunningLatencyTicks);
+    runningLatencySumTicks_ += localAvgRunningLatencyTicks;
 
     writeSpeedBytesPerSecondSum_ -= avgWriteSpeedBytesPerSecond_[0];
     avgWriteSpeedBytesPerSecond_.Remove(0);
@@ -974,6 +1070,14 @@ void PhysicalLogWriter::UpdatePerfCounter(
             perfCounters_->AvgSerializationLatencyBase.Increment();
             perfCounters_->AvgSerializationLatency.IncrementBy(value);
             break;
+        case PerfCounterName::AvgRecordsPerFlush:
+            perfCounters_->AvgRecordsPerFlushBase.Increment();
+            perfCounters_->AvgRecordsPerFlush.IncrementBy(value);
+            break;
+        case PerfCounterName::AvgGroupCommitWait:
+            perfCounters_->AvgGroupCommitWaitBase.Increment();
+            perfCounters_->AvgGroupCommitWait.IncrementBy(value);
+            break;
         default:
             break;
         }
@@ -15,7 +15,9 @@ namespace Data
             LogFlushBytes,
             AvgBytesPerFlush,
             AvgFlushLatency,
-            AvgSerializationLatency
+            AvgSerializationLatency,
+            AvgRecordsPerFlush,
+            AvgGroupCommitWait
 
         } PerfCounterName;
 
@@ -27,6 +29,9 @@ namespace Data
         //
         //  2. FlushAsync() - Flushes all the records that were inserted into the buffered list. If there is an outstanding flush pending, a new flush is not issued until the previous one completes
         //
+        // When flushes are issued concurrently, the flush task may hold the next group commit for a fraction of the measured flush latency
+        // to let more records join it (see GetGroupCommitDelayMs). A flush issued while the writer is idle is always started immediately.
+        //
         class PhysicalLogWriter final 
             : public Utilities::IDisposable
             , public KObject<PhysicalLogWriter>
@@ -104,6 +109,21 @@ namespace Data
                 return pendingFlushRecordsBytes_.load();
             }
 
+            //
+            // Number of flushes held for group commit, and of held flushes that FlushAsync calls joined while they were held
+            //
+            __declspec(property(get = get_GroupCommitWaitCount)) LONG64 GroupCommitWaitCount;
+            LONG64 get_GroupCommitWaitCount() const
+            {
+                return groupCommitWaitCount_.load();
+            }
+
+            __declspec(property(get = get_GroupCommitJoinCount)) LONG64 GroupCommitJoinCount;
+            LONG64 get_GroupCommitJoinCount() const
+            {
+                return groupCommitJoinCount_.load();
+            }
+
             __declspec(property(get = get_IsCompletelyFlushed )) bool IsCompletelyFlushed;
             bool get_IsCompletelyFlushed() const
             {
@@ -222,6 +242,13 @@ namespace Data
                 __inout KSharedArray<ktl::AwaitableCompletionSource<void>::SPtr> & flushedTasks,
                 __out KSharedArray<ktl::AwaitableCompletionSource<void>::SPtr>::SPtr & flushingTasks);
 
+            // Returns the duration in milliseconds for which the next flush should be held to group more records, 0 if it must be issued immediately.
+            // Computed from the flush latency in ticks and rounded to the millisecond resolution of the timer.
+            ULONG GetGroupCommitDelayMs(__in ULONG concurrentFlushCount) const;
+
+            // Moves the records and tasks of the FlushAsync calls that arrived while the next flush was held into the flushing list
+            void JoinPendingFlushes(__inout KSharedArray<ktl::AwaitableCompletionSource<void>::SPtr> & flushingTasks);
+
             // Invoked after the flush task completes a flush
             void FlushCompleted();
             // Invoked before the flush task issues a flush
@@ -267,6 +294,8 @@ namespace Data
             LONG const maxWriteCacheSizeInBytes_;
             Common::atomic_long bufferedRecordsBytes_;
             Common::atomic_long pendingFlushRecordsBytes_;
+            Common::atomic_long groupCommitWaitCount_;
+            Common::atomic_long groupCommitJoinCount_;
             ULONG64 currentLogTailPosition_;
             LONG64 currentLogTailPsn_;
             
@@ -303,9 +332,10 @@ namespace Data
 
             TxnReplicator::TRPerformanceCountersSPtr const perfCounters_;
 
-            LONG64 runningLatencySumMs_;
+            // Flush latency is tracked in ticks, sub-millisecond flushes still yield a group commit delay
+            LONG64 runningLatencySumTicks_;
             LONG64 writeSpeedBytesPerSecondSum_;
-            KArray<LONG64> avgRunningLatencyMilliseconds_;
+            KArray<LONG64> avgRunningLatencyTicks_;
             KArray<LONG64> avgWriteSpeedBytesPerSecond_;
 
             TxnReplicator::IOMonitor::SPtr ioMonitor_;
@@ -27,9 +27,16 @@ TestStateProviderManager::TestStateProviderManager(__in ApiFaultUtility & apiFau
     , setCurrentStateApiCount_(0)
     , endSettingCurrentStateApiCount_(0)
     , apiFaultUtility_(&apiFaultUtility)
+    , applyStateProviderIdEnabled_(false)
+    , lastAppliedPositionByStateProvider_(GetThisAllocator())
+    , concurrentApplyCount_(0)
+    , maxConcurrentApplyCount_(0)
 {
     NTSTATUS status = expectedData_.Initialize(20011, K_DefaultHashFunction);
     CODING_ERROR_ASSERT(status == STATUS_SUCCESS);
+
+    status = lastAppliedPositionByStateProvider_.Initialize(101, K_DefaultHashFunction);
+    CODING_ERROR_ASSERT(status == STATUS_SUCCESS);
 }
 
 TestStateProviderManager::~TestStateProviderManager()
@@ -101,7 +108,18 @@ Awaitable<NTSTATUS> TestStateProviderManager::ApplyAsync(
     }
     else
     {
+        if (applyStateProviderIdEnabled_)
+        {
+            OnStateProviderApplyStarted(logicalSequenceNumber, transactionBase.CommitSequenceNumber, metadataPtr);
+        }
+
         NTSTATUS status = co_await apiFaultUtility_->WaitUntilSignaledAsync(ApiName::ApplyAsync);
+
+        if (applyStateProviderIdEnabled_)
+        {
+            OnStateProviderApplyCompleted();
+        }
+
         if (!NT_SUCCESS(status))
         {
             co_return status;
@@ -120,6 +138,80 @@ NTSTATUS TestStateProviderManager::Unlock(__in OperationContext const & operatio
     return STATUS_SUCCESS;
 }
 
+bool TestStateProviderManager::TryGetApplyStateProviderId(
+    __in_opt OperationData const * const metadataPtr,
+    __out FABRIC_STATE_PROVIDER_ID & stateProviderId) noexcept
+{
+    stateProviderId = 0;
+
+    if (!applyStateProviderIdEnabled_ ||
+        metadataPtr == nullptr ||
+        metadataPtr->BufferCount == 0 ||
+        (*metadataPtr)[0]->QuerySize() < sizeof(FABRIC_STATE_PROVIDER_ID))
+    {
+        return false;
+    }
+
+    KMemCpySafe(&stateProviderId, sizeof(FABRIC_STATE_PROVIDER_ID), (*metadataPtr)[0]->GetBuffer(), sizeof(FABRIC_STATE_PROVIDER_ID));
+    return true;
+}
+
+OperationData::SPtr TestStateProviderManager::CreateApplyStateProviderMetadata(
+    __in FABRIC_STATE_PROVIDER_ID stateProviderId,
+    __in KAllocator & allocator)
+{
+    KBuffer::SPtr buffer;
+    NTSTATUS status = KBuffer::Create(sizeof(FABRIC_STATE_PROVIDER_ID), buffer, allocator);
+    CODING_ERROR_ASSERT(status == STATUS_SUCCESS);
+
+    KMemCpySafe(buffer->GetBuffer(), sizeof(FABRIC_STATE_PROVIDER_ID), &stateProviderId, sizeof(FABRIC_STATE_PROVIDER_ID));
+
+    OperationData::SPtr metadata = OperationData::Create(allocator);
+    metadata->Append(*buffer);
+    return metadata;
+}
+
+void TestStateProviderManager::OnStateProviderApplyStarted(
+    __in LONG64 logicalSequenceNumber,
+    __in LONG64 commitSequenceNumber,
+    __in_opt OperationData const * const metadataPtr)
+{
+    FABRIC_STATE_PROVIDER_ID stateProviderId = 0;
+    CODING_ERROR_ASSERT(TryGetApplyStateProviderId(metadataPtr, stateProviderId));
+
+    K_LOCK_BLOCK(lock_)
+    {
+        concurrentApplyCount_++;
+        if (concurrentApplyCount_ > maxConcurrentApplyCount_)
+        {
+            maxConcurrentApplyCount_ = concurrentApplyCount_;
+        }
+
+        // Operations on the same state provider must be applied in commit order, and in log order within a commit.
+        // Operations of interleaved transactions can have lower lsns than those of an earlier commit.
+        AppliedPosition lastApplied;
+        NTSTATUS status = lastAppliedPositionByStateProvider_.Get(stateProviderId, lastApplied);
+        CODING_ERROR_ASSERT(
+            status == STATUS_NOT_FOUND ||
+            lastApplied.CommitSequenceNumber < commitSequenceNumber ||
+            (lastApplied.CommitSequenceNumber == commitSequenceNumber && lastApplied.LogicalSequenceNumber < logicalSequenceNumber));
+
+        AppliedPosition position;
+        position.CommitSequenceNumber = commitSequenceNumber;
+        position.LogicalSequenceNumber = logicalSequenceNumber;
+        status = lastAppliedPositionByStateProvider_.Put(stateProviderId, position, TRUE);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+    }
+}
+
+void TestStateProviderManager::OnStateProviderApplyCompleted()
+{
+    K_LOCK_BLOCK(lock_)
+    {
+        concurrentApplyCount_--;
+    }
+}
+
 void TestStateProviderManager::Reuse()
 {
     K_LOCK_BLOCK(lock_)
@@ -127,6 +219,9 @@ void TestStateProviderManager::Reuse()
         expectedData_.Reset();
         applyCount_.store(0);
         unlockCount_.store(0);
+        lastAppliedPositionByStateProvider_.Clear();
+        concurrentApplyCount_ = 0;
+        maxConcurrentApplyCount_ = 0;
 
         LONG64* txId;
         ExpectedDataValue* val;
@@ -51,6 +51,31 @@ namespace LoggingReplicatorTests
             return endSettingCurrentStateApiCount_;
         }
 
+        //
+        // When set, the metadata of every operation carries the id of its state provider in its first buffer
+        // (see CreateApplyStateProviderMetadata) and recovery applies verify that each state provider sees its operations in lsn order
+        //
+        __declspec(property(get = get_ApplyStateProviderIdEnabled, put = set_ApplyStateProviderIdEnabled)) bool ApplyStateProviderIdEnabled;
+        bool get_ApplyStateProviderIdEnabled() const
+        {
+            return applyStateProviderIdEnabled_;
+        }
+        void set_ApplyStateProviderIdEnabled(bool val)
+        {
+            applyStateProviderIdEnabled_ = val;
+        }
+
+        // Largest number of applies observed in flight at the same time
+        __declspec(property(get = get_MaxConcurrentApplyCount)) LONG MaxConcurrentApplyCount;
+        LONG get_MaxConcurrentApplyCount() const
+        {
+            return maxConcurrentApplyCount_;
+        }
+
+        static Data::Utilities::OperationData::SPtr CreateApplyStateProviderMetadata(
+            __in FABRIC_STATE_PROVIDER_ID stateProviderId,
+            __in KAllocator & allocator);
+
         ktl::Awaitable<NTSTATUS> ApplyAsync(
             __in LONG64 logicalSequenceNumber,
             __in TxnReplicator::TransactionBase const & transactionBase,
@@ -61,6 +86,10 @@ namespace LoggingReplicatorTests
 
         NTSTATUS Unlock(__in TxnReplicator::OperationContext const & operationContext) noexcept override;
 
+        bool TryGetApplyStateProviderId(
+            __in_opt Data::Utilities::OperationData const * const metadataPtr,
+            __out FABRIC_STATE_PROVIDER_ID & stateProviderId) noexcept override;
+
         NTSTATUS PrepareCheckpoint(__in LONG64 checkpointLSN) noexcept override;
 
         ktl::Awaitable<NTSTATUS> PerformCheckpointAsync(
@@ -126,10 +155,23 @@ namespace LoggingReplicatorTests
             ULONG IndexToThrowException;
         };
 
+        struct AppliedPosition
+        {
+            LONG64 CommitSequenceNumber;
+            LONG64 LogicalSequenceNumber;
+        };
+
         TestStateProviderManager(__in ApiFaultUtility & apiFaultUtility);
 
         ExpectedDataValue * GetValue(__in LONG64 txId);
 
+        void OnStateProviderApplyStarted(
+            __in LONG64 logicalSequenceNumber,
+            __in LONG64 commitSequenceNumber,
+            __in_opt Data::Utilities::OperationData const * const metadataPtr);
+
+        void OnStateProviderApplyCompleted();
+
         static void VerifyOperationData(
             __in_opt Data::Utilities::OperationData const * const actualData,
             __in_opt Data::Utilities::OperationData const * const expectedData);
@@ -143,6 +185,10 @@ namespace LoggingReplicatorTests
         ULONG32 beginSettingCurrentStateApiCount_;
         ULONG32 setCurrentStateApiCount_;
         ULONG32 endSettingCurrentStateApiCount_;
+        bool applyStateProviderIdEnabled_;
+        KHashTable<FABRIC_STATE_PROVIDER_ID, AppliedPosition> lastAppliedPositionByStateProvider_;
+        LONG concurrentApplyCount_;
+        LONG maxConcurrentApplyCount_;
     };
 }
 
@@ -249,6 +249,8 @@ NTSTATUS TransactionManager::AddOperation(
         *invalidLogRecords_->Inv_PhysicalLogRecord,
         *invalidLogRecords_->Inv_TransactionLogRecord,
         GetThisAllocator());
+
+    record->CompressPayload = transactionalReplicatorConfig_->EnableLogRecordCompression;
     
     NTSTATUS status = ReplicateAndLogLogicalRecord(*record);
 
@@ -279,6 +281,8 @@ Awaitable<NTSTATUS> TransactionManager::AddOperationAsync(
         *invalidLogRecords_->Inv_TransactionLogRecord,
         GetThisAllocator());
 
+    record->CompressPayload = transactionalReplicatorConfig_->EnableLogRecordCompression;
+
     NTSTATUS status = ReplicateAndLogLogicalRecord(*record);
 
     CO_RETURN_ON_FAILURE(status);
@@ -311,6 +315,8 @@ Awaitable<NTSTATUS> TransactionManager::AddOperationAsync(
         *invalidLogRecords_->Inv_TransactionLogRecord,
         GetThisAllocator());
 
+    record->CompressPayload = transactionalReplicatorConfig_->EnableLogRecordCompression;
+
     NTSTATUS status = ReplicateAndLogLogicalRecord(*record);
     
     CO_RETURN_ON_FAILURE(status);
@@ -343,6 +349,8 @@ NTSTATUS TransactionManager::BeginTransaction(
         *invalidLogRecords_->Inv_TransactionLogRecord,
         GetThisAllocator());
 
+    record->CompressPayload = transactionalReplicatorConfig_->EnableLogRecordCompression;
+
     NTSTATUS status = ReplicateAndLogLogicalRecord(*record);
 
     RETURN_ON_FAILURE(status);
@@ -373,6 +381,8 @@ Awaitable<NTSTATUS> TransactionManager::BeginTransactionAsync(
         *invalidLogRecords_->Inv_TransactionLogRecord,
         GetThisAllocator());
 
+    record->CompressPayload = transactionalReplicatorConfig_->EnableLogRecordCompression;
+
     NTSTATUS status = ReplicateAndLogLogicalRecord(*record);
 
     CO_RETURN_ON_FAILURE(status);
@@ -15,9 +15,9 @@ const ULONG BeginTransactionOperationLogRecord::DiskSpaceUsed = sizeof(LONG32) +
 BeginTransactionOperationLogRecord::BeginTransactionOperationLogRecord()
     : TransactionLogRecord()
     , isSingleOperationTransaction_(false)
+    , compressPayload_(false)
     , metaData_(nullptr)
-    , undo_(nullptr)
-    , redo_(nullptr)
+    , payload_(nullptr, nullptr)
     , operationContext_(nullptr)
     , recordEpoch_(Epoch::InvalidEpoch())
     , replicatedData_(nullptr)
@@ -32,9 +32,9 @@ BeginTransactionOperationLogRecord::BeginTransactionOperationLogRecord(
     __in TransactionLogRecord & invalidTransactionLog)
     : TransactionLogRecord(recordType, recordPosition, lsn, invalidPhysicalLogRecord, invalidTransactionLog)
     , isSingleOperationTransaction_(false)
+    , compressPayload_(false)
     , metaData_(nullptr)
-    , undo_(nullptr)
-    , redo_(nullptr)
+    , payload_(nullptr, nullptr)
     , operationContext_(nullptr)
     , recordEpoch_(Epoch::InvalidEpoch())
     , replicatedData_(nullptr)
@@ -55,9 +55,9 @@ BeginTransactionOperationLogRecord::BeginTransactionOperationLogRecord(
     __in TransactionLogRecord & invalidTransactionLog)
     : TransactionLogRecord(LogRecordType::Enum::BeginTransaction, transactionBase, invalidPhysicalLogRecord, invalidTransactionLog, nullptr)
     , isSingleOperationTransaction_(isSingleOperationTransaction)
+    , compressPayload_(false)
     , metaData_(metaData)
-    , undo_(undo)
-    , redo_(redo)
+    , payload_(undo, redo)
     , operationContext_(operationContext)
     , recordEpoch_(Epoch::InvalidEpoch())
     , replicatedData_(nullptr)
@@ -130,8 +130,18 @@ void BeginTransactionOperationLogRecord::UpdateApproximateDiskSize()
 {
     ApproximateSizeOnDisk = ApproximateSizeOnDisk + DiskSpaceUsed;
     ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(metaData_.RawPtr());
-    ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(undo_.RawPtr());
-    ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(redo_.RawPtr());
+    ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(GetSerializedUndo());
+    ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(GetSerializedRedo());
+}
+
+OperationData::CSPtr BeginTransactionOperationLogRecord::get_Undo() const
+{
+    return payload_.GetUndo(GetThisAllocator());
+}
+
+OperationData::CSPtr BeginTransactionOperationLogRecord::get_Redo() const
+{
+    return payload_.GetRedo(GetThisAllocator());
 }
 
 OperationContext::CSPtr BeginTransactionOperationLogRecord::ResetOperationContext()
@@ -163,6 +173,14 @@ void BeginTransactionOperationLogRecord::Read(
     // Read single operation optimization flag.
     binaryReader.Read(isSingleOperationTransaction_);
 
+    BYTE compressionFlags = OperationDataCompression::None;
+    if (binaryReader.Position < endPosition)
+    {
+        binaryReader.Read(compressionFlags);
+    }
+
+    payload_.CompressionFlags = compressionFlags;
+
     // Jump to the end of the section ignoring fields that are not understood.
     ASSERT_IFNOT(
         endPosition >= binaryReader.Position,
@@ -172,8 +190,10 @@ void BeginTransactionOperationLogRecord::Read(
     binaryReader.Position = endPosition;
 
     metaData_ = OperationData::DeSerialize(binaryReader, GetThisAllocator());
-    redo_ = OperationData::DeSerialize(binaryReader, GetThisAllocator());
-    undo_ = OperationData::DeSerialize(binaryReader, GetThisAllocator());
+    OperationData::CSPtr redo = OperationData::DeSerialize(binaryReader, GetThisAllocator());
+    OperationData::CSPtr undo = OperationData::DeSerialize(binaryReader, GetThisAllocator());
+
+    payload_.SetSerialized(undo, redo);
 
     UpdateApproximateDiskSize();
 }
@@ -196,6 +216,14 @@ void BeginTransactionOperationLogRecord::ReadLogical(
     // Read metadata fields
     reader.Read(isSingleOperationTransaction_);
 
+    BYTE compressionFlags = OperationDataCompression::None;
+    if (reader.Position < endPosition)
+    {
+        reader.Read(compressionFlags);
+    }
+
+    payload_.CompressionFlags = compressionFlags;
+
     // Jump to the end of the section ignoring fields that are not understood.
     ASSERT_IFNOT(
         endPosition >= reader.Position, 
@@ -205,18 +233,35 @@ void BeginTransactionOperationLogRecord::ReadLogical(
     reader.Position = endPosition;
 
     metaData_ = OperationData::DeSerialize(operationData, index, GetThisAllocator());
-    redo_ = OperationData::DeSerialize(operationData, index, GetThisAllocator());
-    undo_ = OperationData::DeSerialize(operationData, index, GetThisAllocator());
+    OperationData::CSPtr redo = OperationData::DeSerialize(operationData, index, GetThisAllocator());
+    OperationData::CSPtr undo = OperationData::DeSerialize(operationData, index, GetThisAllocator());
+
+    payload_.SetSerialized(undo, redo);
 
     UpdateApproximateDiskSize();
 }
 
+LogRecordType::Enum BeginTransactionOperationLogRecord::GetSerializedRecordType() const
+{
+    // See OperationLogRecord::GetSerializedRecordType
+    return payload_.CompressionFlags != OperationDataCompression::None ?
+        LogRecordType::Enum::CompressedBeginTransaction :
+        LogRecordType::Enum::BeginTransaction;
+}
+
 void BeginTransactionOperationLogRecord::Write(
     __in BinaryWriter & binaryWriter,
     __inout OperationData & operationData,
     __in bool isPhysicalWrite,
     __in bool forceRecomputeOffsets)
 {
+    // Compressed before the base class writes the record type, which depends on the compression flags.
+    // Payloads read in compressed form are written back unchanged
+    if (replicatedData_ == nullptr && compressPayload_)
+    {
+        payload_.Compress(true, GetThisAllocator());
+    }
+
     __super::Write(binaryWriter, operationData, isPhysicalWrite, forceRecomputeOffsets);
 
     if(replicatedData_ == nullptr)
@@ -227,6 +272,12 @@ void BeginTransactionOperationLogRecord::Write(
         binaryWriter.Position += sizeof(ULONG32);
         
         binaryWriter.Write(isSingleOperationTransaction_);
+
+        // Written only if a payload is compressed, in which case the record is written as CompressedBeginTransaction
+        if (payload_.CompressionFlags != OperationDataCompression::None)
+        {
+            binaryWriter.Write(payload_.CompressionFlags);
+        }
         
         ULONG32 endPosition = binaryWriter.Position;
         ULONG32 sizeOfSection = endPosition - startingPosition;
@@ -247,13 +298,13 @@ void BeginTransactionOperationLogRecord::Write(
         // Write user redo data
         OperationData::Serialize(
             binaryWriter,
-            redo_.RawPtr(),
+            GetSerializedRedo(),
             *replicatedData_);
 
         // Write user undo data
         OperationData::Serialize(
             binaryWriter,
-            undo_.RawPtr(),
+            GetSerializedUndo(),
             *replicatedData_);
     }
     
@@ -266,9 +317,10 @@ ULONG BeginTransactionOperationLogRecord::GetSizeOnWire() const
         __super::GetSizeOnWire() +
         sizeof(LONG32) +
         __super::CalculateWireSize(metaData_.RawPtr()) +
-        __super::CalculateWireSize(redo_.RawPtr()) +
-        __super::CalculateWireSize(undo_.RawPtr()) +
-        sizeof(bool);
+        __super::CalculateWireSize(GetSerializedRedo()) +
+        __super::CalculateWireSize(GetSerializedUndo()) +
+        sizeof(bool) +
+        (payload_.CompressionFlags != OperationDataCompression::None ? sizeof(BYTE) : 0);
 }
 
 bool BeginTransactionOperationLogRecord::Test_Equals(__in LogRecord const & other) const
@@ -277,17 +329,22 @@ bool BeginTransactionOperationLogRecord::Test_Equals(__in LogRecord const & othe
 
     if (__super::Test_Equals(other))
     {
+        OperationData::CSPtr redo = Redo;
+        OperationData::CSPtr otherRedo = otherBeginTxLogRecord.Redo;
+        OperationData::CSPtr undo = Undo;
+        OperationData::CSPtr otherUndo = otherBeginTxLogRecord.Undo;
+
         return
             isSingleOperationTransaction_ == otherBeginTxLogRecord.isSingleOperationTransaction_ &&
             metaData_ != nullptr ?
                 metaData_->Test_Equals(*otherBeginTxLogRecord.metaData_) :
                 (metaData_ == otherBeginTxLogRecord.metaData_) != 0 &&
-            redo_ != nullptr ?
-                redo_->Test_Equals(*otherBeginTxLogRecord.redo_) :
-                (redo_ == otherBeginTxLogRecord.redo_) != 0 &&
-            undo_ != nullptr ?
-                undo_->Test_Equals(*otherBeginTxLogRecord.undo_) :
-                (undo_ == otherBeginTxLogRecord.undo_) != 0;
+            redo != nullptr ?
+                redo->Test_Equals(*otherRedo) :
+                (redo == otherRedo) != 0 &&
+            undo != nullptr ?
+                undo->Test_Equals(*otherUndo) :
+                (undo == otherUndo) != 0;
     }
 
     return false;
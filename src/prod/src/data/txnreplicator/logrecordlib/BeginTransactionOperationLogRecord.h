@@ -88,16 +88,35 @@ namespace Data
                 metaData_ = &value;
             }
 
+            //
+            // Compressed undo and redo data read from the log or received from the primary are decompressed on first access
+            //
             __declspec(property(get = get_Undo)) Utilities::OperationData::CSPtr Undo;
-            Utilities::OperationData::CSPtr get_Undo() const
+            Utilities::OperationData::CSPtr get_Undo() const;
+
+            __declspec(property(get = get_Redo)) Utilities::OperationData::CSPtr Redo;
+            Utilities::OperationData::CSPtr get_Redo() const;
+
+            //
+            // If set before the record is first written, the undo and redo data are stored compressed in the log and replicated compressed
+            //
+            __declspec(property(get = get_CompressPayload, put = set_CompressPayload)) bool CompressPayload;
+            bool get_CompressPayload() const
             {
-                return undo_;
+                return compressPayload_;
+            }
+            void set_CompressPayload(__in bool value)
+            {
+                compressPayload_ = value;
             }
 
-            __declspec(property(get = get_Redo)) Utilities::OperationData::CSPtr Redo;
-            Utilities::OperationData::CSPtr get_Redo() const
+            //
+            // OperationDataCompression flags of the undo and redo data stored compressed in the log
+            //
+            __declspec(property(get = get_CompressionFlags)) BYTE CompressionFlags;
+            BYTE get_CompressionFlags() const
             {
-                return redo_;
+                return payload_.CompressionFlags;
             }
 
             TxnReplicator::OperationContext::CSPtr ResetOperationContext();
@@ -114,6 +133,8 @@ namespace Data
                 __in Utilities::OperationData const & operationData,
                 __inout INT & index) override;
 
+            LogRecordType::Enum GetSerializedRecordType() const override;
+
             void Write(
                 __in Utilities::BinaryWriter & binaryWriter,
                 __inout Utilities::OperationData & operationData,
@@ -143,10 +164,20 @@ namespace Data
 
             void UpdateApproximateDiskSize();
 
+            Utilities::OperationData const * GetSerializedUndo() const
+            {
+                return payload_.GetSerializedUndo();
+            }
+
+            Utilities::OperationData const * GetSerializedRedo() const
+            {
+                return payload_.GetSerializedRedo();
+            }
+
             bool isSingleOperationTransaction_;
+            bool compressPayload_;
             Utilities::OperationData::CSPtr metaData_;
-            Utilities::OperationData::CSPtr undo_;
-            Utilities::OperationData::CSPtr redo_;
+            OperationLogRecordPayload payload_;
             TxnReplicator::OperationContext::CSPtr operationContext_;
             TxnReplicator::Epoch recordEpoch_;
             Utilities::OperationData::SPtr replicatedData_;
@@ -198,14 +198,43 @@ Awaitable<LogRecord::SPtr> LogRecord::ReadNextRecordAsync(
     __in bool isPhysicalRead,
     __in bool useInvalidRecordPosition,
     __in bool setRecordLength)
+{
+    ULONG64 recordPosition = 0;
+    KBuffer::SPtr buffer = co_await ReadNextRecordBufferAsync(
+        stream,
+        allocator,
+        recordPosition);
+
+    nextRecordPosition = recordPosition + sizeof(ULONG32) + buffer->QuerySize();
+
+    BinaryReader logReader(*buffer, allocator);
+    if (useInvalidRecordPosition)
+    {
+        recordPosition = Constants::InvalidRecordPosition;
+    }
+
+    co_return ReadRecordWithHeaders(
+        logReader,
+        recordPosition,
+        invalidLogRecords,
+        allocator,
+        isPhysicalRead,
+        setRecordLength);
+}
+
+Awaitable<KBuffer::SPtr> LogRecord::ReadNextRecordBufferAsync(
+    __in io::KStream & stream,
+    __in KAllocator & allocator,
+    __out ULONG64 & recordPosition)
 {
     NTSTATUS status = 0;
     ULONG32 recordLength = 0;
-    ULONG64 recordPosition = (ULONG64) stream.GetPosition();
     ULONG bytesRead = 0;
     ULONG32 bytesToRead = 0;
     KBuffer::SPtr buffer = nullptr;
 
+    recordPosition = (ULONG64) stream.GetPosition();
+
     // Read next record length
     bytesToRead = sizeof(ULONG32);
     status = KBuffer::Create(
@@ -228,8 +257,7 @@ Awaitable<LogRecord::SPtr> LogRecord::ReadNextRecordAsync(
     BinaryReader recordSizereader(*buffer, allocator);
     recordSizereader.Read(recordLength);
 
-    nextRecordPosition = 2 * sizeof(ULONG32) + recordPosition + recordLength;
-
+    // The record is followed by a copy of its length
     bytesToRead = sizeof(ULONG32) + recordLength;
 
     status = KBuffer::Create(
@@ -248,19 +276,22 @@ Awaitable<LogRecord::SPtr> LogRecord::ReadNextRecordAsync(
         status == STATUS_SUCCESS && bytesRead == bytesToRead,
         "Incorrect bytes read: {0} {1}", bytesRead, bytesToRead);
 
-    BinaryReader logReader(*buffer, allocator);
-    if (useInvalidRecordPosition)
-    {
-        recordPosition = Constants::InvalidRecordPosition;
-    }
+    co_return buffer;
+}
 
-    co_return ReadRecordWithHeaders(
+LogRecord::SPtr LogRecord::DecodeRecordBuffer(
+    __in KBuffer const & recordBuffer,
+    __in ULONG64 recordPosition,
+    __in InvalidLogRecords & invalidLogRecords,
+    __in KAllocator & allocator)
+{
+    BinaryReader logReader(recordBuffer, allocator);
+
+    return ReadRecordWithHeaders(
         logReader,
         recordPosition,
         invalidLogRecords,
-        allocator,
-        isPhysicalRead,
-        setRecordLength);
+        allocator);
 }
 
 Awaitable<LogRecord::SPtr> LogRecord::ReadPreviousRecordAsync(
@@ -507,7 +538,7 @@ LogRecord::SPtr LogRecord::InternalReadFromOperationData(
         ULONG32 endPosition = startingPosition + sizeOfRecord;
 
         reader.Read(recordTypeInt);
-        recordType = static_cast<LogRecordType::Enum>(recordTypeInt);
+        recordType = GetRecordTypeFromSerialized(recordTypeInt);
         reader.Read(lsn);
 
         ASSERT_IFNOT(
@@ -613,7 +644,7 @@ LogRecord::SPtr LogRecord::ReadRecord(
     ULONG32 endingPosition = startingPosition + sizeOfSection;
 
     binaryReader.Read(recordTypeInt);
-    recordType = static_cast<LogRecordType::Enum>(recordTypeInt);
+    recordType = GetRecordTypeFromSerialized(recordTypeInt);
 
     switch (recordType)
     {
@@ -842,6 +873,26 @@ void LogRecord::ReadLogical(
     UNREFERENCED_PARAMETER(index);
 }
 
+LogRecordType::Enum LogRecord::GetSerializedRecordType() const
+{
+    return recordType_;
+}
+
+LogRecordType::Enum LogRecord::GetRecordTypeFromSerialized(__in LONG32 serializedRecordType)
+{
+    LogRecordType::Enum recordType = static_cast<LogRecordType::Enum>(serializedRecordType);
+
+    switch (recordType)
+    {
+    case LogRecordType::Enum::CompressedBeginTransaction:
+        return LogRecordType::Enum::BeginTransaction;
+    case LogRecordType::Enum::CompressedOperation:
+        return LogRecordType::Enum::Operation;
+    default:
+        return recordType;
+    }
+}
+
 void LogRecord::Write(
     __in BinaryWriter & binaryWriter,
     __inout OperationData & operationData,
@@ -857,7 +908,7 @@ void LogRecord::Write(
     binaryWriter.Position += sizeof(ULONG32);
 
     // Logical Metadata fields
-    binaryWriter.Write(static_cast<LONG32>(recordType_));
+    binaryWriter.Write(static_cast<LONG32>(GetSerializedRecordType()));
     binaryWriter.Write(lsn_);
 
     // End Logical Metadata section
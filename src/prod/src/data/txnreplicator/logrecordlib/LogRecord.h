@@ -103,6 +103,21 @@ namespace Data
                 __in bool useInvalidRecordPosition = false,
                 __in bool setRecordLength = true);
 
+            //
+            // Used by the recovery reader to separate reading the next record from the input file stream from decoding it,
+            // so that the records read ahead can be decoded in parallel
+            //
+            static ktl::Awaitable<KBuffer::SPtr> ReadNextRecordBufferAsync(
+                __in ktl::io::KStream & stream,
+                __in KAllocator & allocator,
+                __out ULONG64 & recordPosition);
+
+            static LogRecord::SPtr DecodeRecordBuffer(
+                __in KBuffer const & recordBuffer,
+                __in ULONG64 recordPosition,
+                __in InvalidLogRecords & invalidLogRecords,
+                __in KAllocator & allocator);
+
             //
             // Primarily used by the recovery and backup log readers to read the previous record in the input file stream
             //
@@ -354,6 +369,12 @@ namespace Data
                 __in Utilities::OperationData const & operationData,
                 __inout INT & index);
 
+            //
+            // Record type written to the logical metadata section, which can differ from RecordType to
+            // select a serialization format that older readers do not accept
+            //
+            virtual LogRecordType::Enum GetSerializedRecordType() const;
+
             //
             // Writes the content of the log record into a buffer and appends the buffer to the operationData parameter
             // The binaryWriter is a temporary object that can be used for serialization of the data
@@ -373,6 +394,8 @@ namespace Data
 
         private:
 
+            static LogRecordType::Enum GetRecordTypeFromSerialized(__in LONG32 serializedRecordType);
+
             static LogRecord::SPtr ReadRecordWithHeaders(
                 __in Utilities::BinaryReader & binaryReader,
                 __in ULONG64 recordPosition,
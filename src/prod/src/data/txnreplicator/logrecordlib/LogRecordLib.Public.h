@@ -15,6 +15,8 @@
 #include "TracingHeaders.h"
 
 #include "Pointers.h"
+#include "OperationDataCompression.h"
+#include "OperationLogRecordPayload.h"
 #include "LogRecord.h"
 #include "LogicalLogRecord.h"
 #include "PhysicalLogRecord.h"
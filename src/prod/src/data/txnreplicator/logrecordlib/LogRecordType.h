@@ -43,7 +43,14 @@ namespace Data
 
                 CompleteCheckpoint = 13,
 
-                LastValidEnum = CompleteCheckpoint
+                LastValidEnum = CompleteCheckpoint,
+
+                // Serialized types of BeginTransaction and Operation records whose payloads are compressed.
+                // Readers that predate compression fail on the unknown type instead of applying LZ4 bytes as
+                // the payload. They never appear as the type of a log record in memory.
+                CompressedBeginTransaction = 14,
+
+                CompressedOperation = 15
             };
 
             void WriteToTextWriter(Common::TextWriter & w, Enum const & val);
@@ -11,6 +11,8 @@ using namespace TxnReplicator;
 using namespace Data::Utilities;
 
 LONG UpdateStartingPositionAfterBytes = 1024 * 1024;
+ULONG ParallelDecodeBatchSizePerThread = 128;
+ULONG64 ParallelDecodeMaxReadAheadBytes = 4 * 1024 * 1024;
 
 LogRecords::LogRecords(
     __in Data::Utilities::PartitionedReplicaId const & traceId,
@@ -38,6 +40,11 @@ LogRecords::LogRecords(
     , lastPhysicalRecord_()
     , invalidLogRecords_(logManager.InvalidLogRecords)
     , transactionalReplicatorConfig_(config)
+    , decodeParallelism_(1)
+    , readAheadBuffers_(GetThisAllocator())
+    , readAheadPositions_(GetThisAllocator())
+    , readAheadRecords_(GetThisAllocator())
+    , readAheadIndex_(0)
 {
     ASSERT_IFNOT(
         enumerationStartingPosition <= enumerationEndingPosition,
@@ -97,11 +104,20 @@ LogRecords::LogRecords(
     , lastPhysicalRecord_()
     , invalidLogRecords_(&invalidLogRecords)
     , transactionalReplicatorConfig_(config)
+    , decodeParallelism_(static_cast<ULONG>(config->RecoveryDecodeParallelism))
+    , readAheadBuffers_(GetThisAllocator())
+    , readAheadPositions_(GetThisAllocator())
+    , readAheadRecords_(GetThisAllocator())
+    , readAheadIndex_(0)
 {
     ASSERT_IFNOT(
         enumerationStartingPosition <= enumerationEndingPosition,
         "LogRecords : Enumeration start position must be less than or equal to end position");
 
+    THROW_ON_CONSTRUCTOR_FAILURE(readAheadBuffers_);
+    THROW_ON_CONSTRUCTOR_FAILURE(readAheadPositions_);
+    THROW_ON_CONSTRUCTOR_FAILURE(readAheadRecords_);
+
     ioMonitor_ = IOMonitor::Create(
         traceId,
         Constants::SlowPhysicalLogReadOperationName,
@@ -205,25 +221,18 @@ void LogRecords::Reset()
     readStream_->SetPosition(LONGLONG(enumerationStartingPosition_));
     currentRecord_ = invalidLogRecords_->Inv_LogRecord;
     lastPhysicalRecord_ = nullptr;
+
+    readAheadRecords_.Clear();
+    readAheadIndex_ = 0;
 }
 
 Awaitable<bool> LogRecords::MoveNextAsync(__in CancellationToken const & cancellationToken)
 {
-    if (readStream_->GetPosition() <= (LONG64)enumerationEndingPosition_ && !isDisposed_)
-    {
-        Common::Stopwatch logReadWatch;
-        logReadWatch.Start();
-
-        LogRecord::SPtr record = co_await LogRecord::ReadNextRecordAsync(
-            *readStream_,
-            *invalidLogRecords_,
-            GetThisAllocator());
+    bool hasReadAheadRecords = readAheadIndex_ < readAheadRecords_.Count();
 
-        logReadWatch.Stop();
-        if (logReadWatch.Elapsed > transactionalReplicatorConfig_->SlowLogIODuration)
-        {
-            ioMonitor_->OnSlowOperation();   
-        }
+    if ((hasReadAheadRecords || readStream_->GetPosition() <= (LONG64)enumerationEndingPosition_) && !isDisposed_)
+    {
+        LogRecord::SPtr record = co_await ReadNextRecordAsync();
 
         ASSERT_IFNOT(
             record != nullptr,
@@ -282,3 +291,126 @@ Awaitable<bool> LogRecords::MoveNextAsync(__in CancellationToken const & cancell
 
     co_return false;
 }
+
+Awaitable<LogRecord::SPtr> LogRecords::ReadNextRecordAsync()
+{
+    if (decodeParallelism_ <= 1)
+    {
+        Common::Stopwatch logReadWatch;
+        logReadWatch.Start();
+
+        LogRecord::SPtr record = co_await LogRecord::ReadNextRecordAsync(
+            *readStream_,
+            *invalidLogRecords_,
+            GetThisAllocator());
+
+        logReadWatch.Stop();
+        if (logReadWatch.Elapsed > transactionalReplicatorConfig_->SlowLogIODuration)
+        {
+            ioMonitor_->OnSlowOperation();   
+        }
+
+        co_return record;
+    }
+
+    if (readAheadIndex_ == readAheadRecords_.Count())
+    {
+        co_await ReadAheadAndDecodeAsync();
+    }
+
+    // Release the reference held by the read ahead batch as the caller takes ownership of the record
+    LogRecord::SPtr record = readAheadRecords_[readAheadIndex_];
+    readAheadRecords_[readAheadIndex_] = nullptr;
+    readAheadIndex_++;
+
+    co_return record;
+}
+
+Awaitable<void> LogRecords::ReadAheadAndDecodeAsync()
+{
+    NTSTATUS status = STATUS_SUCCESS;
+    ULONG batchSize = decodeParallelism_ * ParallelDecodeBatchSizePerThread;
+    ULONG64 readAheadBytes = 0;
+
+    readAheadBuffers_.Clear();
+    readAheadPositions_.Clear();
+    readAheadRecords_.Clear();
+    readAheadIndex_ = 0;
+
+    // Reading the stream is sequential, only the decoding of the records read is parallelized.
+    // The batch is bounded by bytes as well, so that large records do not make the read ahead hold an unbounded amount of memory
+    while (readAheadBuffers_.Count() < batchSize &&
+        readAheadBytes < ParallelDecodeMaxReadAheadBytes &&
+        readStream_->GetPosition() <= (LONG64)enumerationEndingPosition_)
+    {
+        Common::Stopwatch logReadWatch;
+        logReadWatch.Start();
+
+        ULONG64 recordPosition = 0;
+        KBuffer::SPtr buffer = co_await LogRecord::ReadNextRecordBufferAsync(
+            *readStream_,
+            GetThisAllocator(),
+            recordPosition);
+
+        logReadWatch.Stop();
+        if (logReadWatch.Elapsed > transactionalReplicatorConfig_->SlowLogIODuration)
+        {
+            ioMonitor_->OnSlowOperation();   
+        }
+
+        readAheadBytes += buffer->QuerySize();
+
+        status = readAheadBuffers_.Append(buffer);
+        THROW_ON_FAILURE(status);
+
+        status = readAheadPositions_.Append(recordPosition);
+        THROW_ON_FAILURE(status);
+
+        status = readAheadRecords_.Append(LogRecord::SPtr());
+        THROW_ON_FAILURE(status);
+    }
+
+    ULONG count = readAheadBuffers_.Count();
+
+    ASSERT_IFNOT(
+        count > 0,
+        "LogRecords::ReadAheadAndDecodeAsync : Must read at least one record");
+
+    ULONG taskCount = __min(decodeParallelism_, count);
+    KArray<Awaitable<void>> decodeTasks(GetThisAllocator(), taskCount);
+    THROW_ON_FAILURE(decodeTasks.Status());
+
+    for (ULONG i = 0; i < taskCount; i++)
+    {
+        status = decodeTasks.Append(DecodeRecordsAsync(
+            (count * i) / taskCount,
+            (count * (i + 1)) / taskCount));
+        THROW_ON_FAILURE(status);
+    }
+
+    co_await TaskUtilities<void>::WhenAll(decodeTasks);
+
+    readAheadBuffers_.Clear();
+    readAheadPositions_.Clear();
+
+    co_return;
+}
+
+Awaitable<void> LogRecords::DecodeRecordsAsync(
+    __in ULONG startIndex,
+    __in ULONG endIndex)
+{
+    co_await CorHelper::ThreadPoolThread(GetThisKtlSystem().DefaultThreadPool());
+
+    // Every task decodes a disjoint range of the pre-sized batch
+    for (ULONG i = startIndex; i < endIndex; i++)
+    {
+        readAheadRecords_[i] = LogRecord::DecodeRecordBuffer(
+            *readAheadBuffers_[i],
+            readAheadPositions_[i],
+            *invalidLogRecords_,
+            GetThisAllocator());
+    }
+
+    co_return;
+}
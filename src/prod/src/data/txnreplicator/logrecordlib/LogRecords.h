@@ -89,6 +89,17 @@ namespace Data
 
             ktl::Task DisposeReadStream();
 
+            ktl::Awaitable<LogRecord::SPtr> ReadNextRecordAsync();
+
+            //
+            // Reads the next batch of records from the stream and decodes them on decodeParallelism_ thread pool threads
+            //
+            ktl::Awaitable<void> ReadAheadAndDecodeAsync();
+
+            ktl::Awaitable<void> DecodeRecordsAsync(
+                __in ULONG startIndex,
+                __in ULONG endIndex);
+
             bool isDisposed_;
             ILogManagerReadOnly::SPtr const logManager_;
             ULONG64 const enumerationEndingPosition_;
@@ -104,6 +115,13 @@ namespace Data
             InvalidLogRecords::SPtr invalidLogRecords_;
             TxnReplicator::IOMonitor::SPtr ioMonitor_;
             TxnReplicator::TRInternalSettingsSPtr transactionalReplicatorConfig_;
+
+            // Records read ahead by the recovery reader, consumed in log order from readAheadIndex_
+            ULONG const decodeParallelism_;
+            KArray<KBuffer::SPtr> readAheadBuffers_;
+            KArray<ULONG64> readAheadPositions_;
+            KArray<LogRecord::SPtr> readAheadRecords_;
+            ULONG readAheadIndex_;
         };
     }
 }
@@ -0,0 +1,183 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace ktl;
+using namespace Data::LogRecordLib;
+using namespace Data::Utilities;
+
+// Smaller payloads rarely compress enough to pay for the header and the decompression at apply
+ULONG const OperationDataCompression::MinimumSizeInBytes = 512;
+
+OperationData::CSPtr OperationDataCompression::Compress(
+    __in_opt OperationData const * const operationData,
+    __in KAllocator & allocator)
+{
+    if (operationData == nullptr)
+    {
+        return nullptr;
+    }
+
+    ULONG bufferCount = operationData->BufferCount;
+    ULONG64 totalSize = 0;
+
+    for (ULONG i = 0; i < bufferCount; i++)
+    {
+        totalSize += (*operationData)[i]->QuerySize();
+    }
+
+    ULONG64 headerSize = sizeof(ULONG32) * (static_cast<ULONG64>(bufferCount) + 1);
+
+    if (totalSize < MinimumSizeInBytes ||
+        totalSize > MAXULONG32 ||
+        headerSize >= totalSize)
+    {
+        return nullptr;
+    }
+
+    // The compressed form is only kept if it is smaller than the original payload
+    ULONG capacity = static_cast<ULONG>(totalSize - headerSize);
+
+    KBuffer::CSPtr source = nullptr;
+    if (bufferCount == 1)
+    {
+        source = (*operationData)[0];
+    }
+    else
+    {
+        KBuffer::SPtr contiguous = nullptr;
+        NTSTATUS status = KBuffer::Create(static_cast<ULONG>(totalSize), contiguous, allocator, OPERATIONDATACOMPRESSION_TAG);
+        THROW_ON_FAILURE(status);
+
+        BYTE * target = static_cast<BYTE *>(contiguous->GetBuffer());
+        for (ULONG i = 0; i < bufferCount; i++)
+        {
+            ULONG size = (*operationData)[i]->QuerySize();
+            if (size > 0)
+            {
+                memcpy(target, (*operationData)[i]->GetBuffer(), size);
+                target += size;
+            }
+        }
+
+        source = contiguous.RawPtr();
+    }
+
+    KBuffer::SPtr compressed = nullptr;
+    NTSTATUS status = KBuffer::Create(static_cast<ULONG>(headerSize) + capacity, compressed, allocator, OPERATIONDATACOMPRESSION_TAG);
+    THROW_ON_FAILURE(status);
+
+    ULONG32 * header = static_cast<ULONG32 *>(compressed->GetBuffer());
+    header[0] = bufferCount;
+    for (ULONG i = 0; i < bufferCount; i++)
+    {
+        header[i + 1] = (*operationData)[i]->QuerySize();
+    }
+
+    size_t compressedSize = Common::Lz4::Compress(
+        source->GetBuffer(),
+        static_cast<size_t>(totalSize),
+        static_cast<BYTE *>(compressed->GetBuffer()) + headerSize,
+        capacity);
+
+    if (compressedSize == 0)
+    {
+        return nullptr;
+    }
+
+    status = compressed->SetSize(static_cast<ULONG>(headerSize + compressedSize), TRUE, OPERATIONDATACOMPRESSION_TAG);
+    THROW_ON_FAILURE(status);
+
+    OperationData::SPtr result = OperationData::Create(allocator);
+    result->Append(*compressed);
+
+    return result.RawPtr();
+}
+
+OperationData::CSPtr OperationDataCompression::Decompress(
+    __in OperationData const & compressedData,
+    __in KAllocator & allocator)
+{
+    if (compressedData.BufferCount != 1)
+    {
+        throw Exception(STATUS_INTERNAL_DB_CORRUPTION);
+    }
+
+    KBuffer::CSPtr compressed = compressedData[0];
+    BYTE const * input = static_cast<BYTE const *>(compressed->GetBuffer());
+    ULONG inputSize = compressed->QuerySize();
+
+    ULONG32 bufferCount = 0;
+    if (inputSize < sizeof(ULONG32))
+    {
+        throw Exception(STATUS_INTERNAL_DB_CORRUPTION);
+    }
+
+    memcpy(&bufferCount, input, sizeof(ULONG32));
+
+    ULONG64 headerSize = sizeof(ULONG32) * (static_cast<ULONG64>(bufferCount) + 1);
+    if (headerSize > inputSize)
+    {
+        throw Exception(STATUS_INTERNAL_DB_CORRUPTION);
+    }
+
+    ULONG32 const * sizes = reinterpret_cast<ULONG32 const *>(input + sizeof(ULONG32));
+    ULONG64 totalSize = 0;
+
+    for (ULONG i = 0; i < bufferCount; i++)
+    {
+        totalSize += sizes[i];
+    }
+
+    if (totalSize > MAXULONG32)
+    {
+        throw Exception(STATUS_INTERNAL_DB_CORRUPTION);
+    }
+
+    KBuffer::SPtr contiguous = nullptr;
+    NTSTATUS status = KBuffer::Create(static_cast<ULONG>(totalSize), contiguous, allocator, OPERATIONDATACOMPRESSION_TAG);
+    THROW_ON_FAILURE(status);
+
+    bool isDecompressed = Common::Lz4::Decompress(
+        input + headerSize,
+        static_cast<size_t>(inputSize - headerSize),
+        contiguous->GetBuffer(),
+        static_cast<size_t>(totalSize));
+
+    if (!isDecompressed)
+    {
+        throw Exception(STATUS_INTERNAL_DB_CORRUPTION);
+    }
+
+    if (bufferCount == 1)
+    {
+        OperationData::SPtr result = OperationData::Create(allocator);
+        result->Append(*contiguous);
+        return result.RawPtr();
+    }
+
+    KArray<KBuffer::CSPtr> items(allocator, bufferCount);
+    THROW_ON_FAILURE(items.Status());
+
+    BYTE const * next = static_cast<BYTE const *>(contiguous->GetBuffer());
+    for (ULONG i = 0; i < bufferCount; i++)
+    {
+        KBuffer::SPtr buffer = nullptr;
+        status = KBuffer::Create(sizes[i], buffer, allocator, OPERATIONDATACOMPRESSION_TAG);
+        THROW_ON_FAILURE(status);
+
+        if (sizes[i] > 0)
+        {
+            memcpy(buffer->GetBuffer(), next, sizes[i]);
+            next += sizes[i];
+        }
+
+        status = items.Append(buffer.RawPtr());
+        THROW_ON_FAILURE(status);
+    }
+
+    return OperationData::Create(items, allocator);
+}
@@ -0,0 +1,47 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Data
+{
+    namespace LogRecordLib
+    {
+        //
+        // LZ4 block compression of the redo and undo data of operation log records.
+        //
+        // The compressed form is an operation data with a single buffer laid out as:
+        //  [ULONG32 buffer count][ULONG32 size of every buffer][compressed concatenation of the buffers]
+        // so that the buffer boundaries seen by the state providers are preserved after decompression.
+        //
+        class OperationDataCompression
+        {
+        public:
+
+            //
+            // Flags written in the metadata section of the operation log records for every payload that is stored compressed
+            //
+            static BYTE const None = 0x0;
+            static BYTE const RedoCompressed = 0x1;
+            static BYTE const UndoCompressed = 0x2;
+
+            static ULONG const MinimumSizeInBytes;
+
+            //
+            // Returns nullptr if the operation data is smaller than MinimumSizeInBytes or does not shrink
+            //
+            static Utilities::OperationData::CSPtr Compress(
+                __in_opt Utilities::OperationData const * const operationData,
+                __in KAllocator & allocator);
+
+            //
+            // Throws STATUS_INTERNAL_DB_CORRUPTION if the compressed operation data is malformed
+            //
+            static Utilities::OperationData::CSPtr Decompress(
+                __in Utilities::OperationData const & compressedData,
+                __in KAllocator & allocator);
+        };
+    }
+}
@@ -20,9 +20,9 @@ OperationLogRecord::OperationLogRecord(
     __in TransactionLogRecord & invalidTransactionLog)
     : TransactionLogRecord(recordType, recordPosition, lsn, invalidPhysicalLogRecord, invalidTransactionLog)
     , isRedoOnly_(false)
+    , compressPayload_(false)
     , metaData_(nullptr)
-    , undo_(nullptr)
-    , redo_(nullptr)
+    , payload_(nullptr, nullptr)
     , operationContext_(nullptr)
     , replicatedData_(nullptr)
 {
@@ -39,9 +39,9 @@ OperationLogRecord::OperationLogRecord(
     __in TransactionLogRecord & invalidTransactionLog)
     : TransactionLogRecord(LogRecordType::Enum::Operation, transaction, invalidPhysicalLogRecord, invalidTransactionLog, &invalidTransactionLog)
     , isRedoOnly_(false)
+    , compressPayload_(false)
     , metaData_(metaData)
-    , undo_(undo)
-    , redo_(redo)
+    , payload_(undo, redo)
     , operationContext_(operationContext)
     , replicatedData_(nullptr)
 {
@@ -57,9 +57,9 @@ OperationLogRecord::OperationLogRecord(
     __in TransactionLogRecord & invalidTransactionLog)
     : TransactionLogRecord(LogRecordType::Enum::Operation, transaction, invalidPhysicalLogRecord, invalidTransactionLog, &invalidTransactionLog)
     , isRedoOnly_(true)
+    , compressPayload_(false)
     , metaData_(metaData)
-    , undo_(nullptr)
-    , redo_(redo)
+    , payload_(nullptr, redo)
     , operationContext_(operationContext)
     , replicatedData_(nullptr)
 {
@@ -150,14 +150,24 @@ void OperationLogRecord::UpdateApproximateDiskSize()
 {
     ApproximateSizeOnDisk = ApproximateSizeOnDisk + DiskSpaceUsed;
     ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(metaData_.RawPtr());
-    ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(redo_.RawPtr());
+    ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(GetSerializedRedo());
 
     if (!isRedoOnly_)
     {
-        ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(undo_.RawPtr());
+        ApproximateSizeOnDisk = ApproximateSizeOnDisk + __super::CalculateDiskWriteSize(GetSerializedUndo());
     }
 }
 
+OperationData::CSPtr OperationLogRecord::get_Undo() const
+{
+    return payload_.GetUndo(GetThisAllocator());
+}
+
+OperationData::CSPtr OperationLogRecord::get_Redo() const
+{
+    return payload_.GetRedo(GetThisAllocator());
+}
+
 OperationContext::CSPtr OperationLogRecord::ResetOperationContext()
 {
     OperationContext::CSPtr context = operationContext_;
@@ -185,6 +195,14 @@ void OperationLogRecord::Read(
 
     binaryReader.Read(isRedoOnly_);
 
+    BYTE compressionFlags = OperationDataCompression::None;
+    if (binaryReader.Position < logicalEndPosition)
+    {
+        binaryReader.Read(compressionFlags);
+    }
+
+    payload_.CompressionFlags = compressionFlags;
+
     // Jump to the end of the section ignoring fields that are not understood.
     ASSERT_IFNOT(
         logicalEndPosition >= binaryReader.Position,
@@ -202,13 +220,16 @@ void OperationLogRecord::Read(
     }
 
     metaData_ = OperationData::DeSerialize(binaryReader, GetThisAllocator());
-    redo_ = OperationData::DeSerialize(binaryReader, GetThisAllocator());
+    OperationData::CSPtr redo = OperationData::DeSerialize(binaryReader, GetThisAllocator());
+    OperationData::CSPtr undo = nullptr;
 
     if (!isRedoOnly_)
     {
-        undo_ = OperationData::DeSerialize(binaryReader, GetThisAllocator());
+        undo = OperationData::DeSerialize(binaryReader, GetThisAllocator());
     }
 
+    payload_.SetSerialized(undo, redo);
+
     UpdateApproximateDiskSize();
 }
 
@@ -229,6 +250,14 @@ void OperationLogRecord::ReadLogical(
 
     reader.Read(isRedoOnly_);
 
+    BYTE compressionFlags = OperationDataCompression::None;
+    if (reader.Position < logicalEndPosition)
+    {
+        reader.Read(compressionFlags);
+    }
+
+    payload_.CompressionFlags = compressionFlags;
+
     // Jump to the end of the section ignoring fields that are not understood.
     ASSERT_IFNOT(
         logicalEndPosition >= reader.Position,
@@ -246,22 +275,41 @@ void OperationLogRecord::ReadLogical(
     }
 
     metaData_ = OperationData::DeSerialize(operationData, index, GetThisAllocator());
-    redo_ = OperationData::DeSerialize(operationData, index, GetThisAllocator());
+    OperationData::CSPtr redo = OperationData::DeSerialize(operationData, index, GetThisAllocator());
+    OperationData::CSPtr undo = nullptr;
    
     if (!isRedoOnly_)
     {
-        undo_ = OperationData::DeSerialize(operationData, index, GetThisAllocator());
+        undo = OperationData::DeSerialize(operationData, index, GetThisAllocator());
     }
 
+    payload_.SetSerialized(undo, redo);
+
     UpdateApproximateDiskSize();
 }
 
+LogRecordType::Enum OperationLogRecord::GetSerializedRecordType() const
+{
+    // Readers skip unknown metadata fields, so the compression flags alone would let an older reader
+    // apply the compressed bytes as the payload. The distinct type makes it fail on the record instead.
+    return payload_.CompressionFlags != OperationDataCompression::None ?
+        LogRecordType::Enum::CompressedOperation :
+        LogRecordType::Enum::Operation;
+}
+
 void OperationLogRecord::Write(
     __in BinaryWriter & binaryWriter,
     __inout OperationData & operationData,
     __in bool isPhysicalWrite,
     __in bool forceRecomputeOffsets)
 {
+    // Compressed before the base class writes the record type, which depends on the compression flags.
+    // Payloads read in compressed form are written back unchanged
+    if (replicatedData_ == nullptr && compressPayload_)
+    {
+        payload_.Compress(!isRedoOnly_, GetThisAllocator());
+    }
+
     __super::Write(binaryWriter, operationData, isPhysicalWrite, forceRecomputeOffsets);
 
     if (replicatedData_ == nullptr)
@@ -274,6 +322,12 @@ void OperationLogRecord::Write(
 
         binaryWriter.Write(isRedoOnly_);
 
+        // Written only if a payload is compressed, in which case the record is written as CompressedOperation
+        if (payload_.CompressionFlags != OperationDataCompression::None)
+        {
+            binaryWriter.Write(payload_.CompressionFlags);
+        }
+
         // End of metadata.
         ULONG32 endPosition = binaryWriter.Position;
         ULONG32 sizeOfSection = endPosition - startingPosition;
@@ -294,7 +348,7 @@ void OperationLogRecord::Write(
         // Write user redo data
         OperationData::Serialize(
             binaryWriter,
-            redo_.RawPtr(),
+            GetSerializedRedo(),
             *localReplicatedData);
 
         if (!isRedoOnly_)
@@ -302,7 +356,7 @@ void OperationLogRecord::Write(
             // Write user undo data
             OperationData::Serialize(
                 binaryWriter,
-                undo_.RawPtr(),
+                GetSerializedUndo(),
                 *localReplicatedData);
         }
 
@@ -318,12 +372,17 @@ ULONG OperationLogRecord::GetSizeOnWire() const
         __super::GetSizeOnWire() +
         sizeof(LONG32) +
         __super::CalculateWireSize(metaData_.RawPtr()) +
-        __super::CalculateWireSize(redo_.RawPtr()) +
+        __super::CalculateWireSize(GetSerializedRedo()) +
         sizeof(bool);
 
+    if (payload_.CompressionFlags != OperationDataCompression::None)
+    {
+        size += sizeof(BYTE);
+    }
+
     if (!isRedoOnly_)
     {
-        size += __super::CalculateWireSize(undo_.RawPtr());
+        size += __super::CalculateWireSize(GetSerializedUndo());
     }
 
     return size;
@@ -335,17 +394,22 @@ bool OperationLogRecord::Test_Equals(__in LogRecord const & other) const
 
     if (__super::Test_Equals(other))
     {
+        OperationData::CSPtr redo = Redo;
+        OperationData::CSPtr otherRedo = otherOperationLogRecord.Redo;
+        OperationData::CSPtr undo = Undo;
+        OperationData::CSPtr otherUndo = otherOperationLogRecord.Undo;
+
         return
             isRedoOnly_ == otherOperationLogRecord.isRedoOnly_ &&
             metaData_ != nullptr ?
                 metaData_->Test_Equals(*otherOperationLogRecord.metaData_) :
                 (metaData_ == otherOperationLogRecord.metaData_) != 0 &&
-            redo_ != nullptr ?
-                redo_->Test_Equals(*otherOperationLogRecord.redo_) :
-                (redo_ == otherOperationLogRecord.redo_) != 0 &&
-            undo_ != nullptr ?
-                undo_->Test_Equals(*otherOperationLogRecord.undo_) :
-                (undo_ == otherOperationLogRecord.undo_) != 0;
+            redo != nullptr ?
+                redo->Test_Equals(*otherRedo) :
+                (redo == otherRedo) != 0 &&
+            undo != nullptr ?
+                undo->Test_Equals(*otherUndo) :
+                (undo == otherUndo) != 0;
     }
 
     return false;
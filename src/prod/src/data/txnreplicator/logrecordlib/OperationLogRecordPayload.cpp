@@ -0,0 +1,148 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+using namespace ktl;
+using namespace Data::LogRecordLib;
+using namespace Data::Utilities;
+
+OperationLogRecordPayload::OperationLogRecordPayload(
+    __in_opt OperationData const * const undo,
+    __in_opt OperationData const * const redo)
+    : compressionFlags_(OperationDataCompression::None)
+    , compressedUndo_(nullptr)
+    , compressedRedo_(nullptr)
+    , undo_(nullptr)
+    , redo_(nullptr)
+{
+    Replace(undo_, undo);
+    Replace(redo_, redo);
+}
+
+OperationLogRecordPayload::~OperationLogRecordPayload()
+{
+    Replace(undo_, nullptr);
+    Replace(redo_, nullptr);
+}
+
+void OperationLogRecordPayload::SetSerialized(
+    __in OperationData::CSPtr const & undo,
+    __in OperationData::CSPtr const & redo)
+{
+    // Compressed payloads are kept as read, so that copy and replication from this replica reuse them unchanged
+    if ((compressionFlags_ & OperationDataCompression::UndoCompressed) != 0)
+    {
+        compressedUndo_ = undo;
+    }
+    else
+    {
+        Replace(undo_, undo.RawPtr());
+    }
+
+    if ((compressionFlags_ & OperationDataCompression::RedoCompressed) != 0)
+    {
+        compressedRedo_ = redo;
+    }
+    else
+    {
+        Replace(redo_, redo.RawPtr());
+    }
+}
+
+void OperationLogRecordPayload::Compress(
+    __in bool includeUndo,
+    __in KAllocator & allocator)
+{
+    if (compressionFlags_ != OperationDataCompression::None)
+    {
+        return;
+    }
+
+    compressedRedo_ = OperationDataCompression::Compress(redo_, allocator);
+    if (compressedRedo_ != nullptr)
+    {
+        compressionFlags_ |= OperationDataCompression::RedoCompressed;
+    }
+
+    if (includeUndo)
+    {
+        compressedUndo_ = OperationDataCompression::Compress(undo_, allocator);
+        if (compressedUndo_ != nullptr)
+        {
+            compressionFlags_ |= OperationDataCompression::UndoCompressed;
+        }
+    }
+}
+
+OperationData::CSPtr OperationLogRecordPayload::GetUndo(__in KAllocator & allocator) const
+{
+    if (compressedUndo_ == nullptr)
+    {
+        return undo_;
+    }
+
+    return GetDecompressed(undo_, compressedUndo_, allocator);
+}
+
+OperationData::CSPtr OperationLogRecordPayload::GetRedo(__in KAllocator & allocator) const
+{
+    if (compressedRedo_ == nullptr)
+    {
+        return redo_;
+    }
+
+    return GetDecompressed(redo_, compressedRedo_, allocator);
+}
+
+OperationData const * OperationLogRecordPayload::GetSerializedUndo() const
+{
+    return compressedUndo_ != nullptr ? compressedUndo_.RawPtr() : undo_;
+}
+
+OperationData const * OperationLogRecordPayload::GetSerializedRedo() const
+{
+    return compressedRedo_ != nullptr ? compressedRedo_.RawPtr() : redo_;
+}
+
+OperationData::CSPtr OperationLogRecordPayload::GetDecompressed(
+    __inout OperationData const * volatile & decompressed,
+    __in OperationData::CSPtr const & compressed,
+    __in KAllocator & allocator)
+{
+    OperationData const * current = decompressed;
+    if (current != nullptr)
+    {
+        return current;
+    }
+
+    OperationData::CSPtr result = OperationDataCompression::Decompress(*compressed, allocator);
+
+    PVOID previous = InterlockedCompareExchangePointer(
+        (PVOID volatile *)&decompressed,
+        (PVOID)result.RawPtr(),
+        nullptr);
+
+    if (previous != nullptr)
+    {
+        // Another reader published its copy first
+        return static_cast<OperationData const *>(previous);
+    }
+
+    // The reference taken by the decompression is now held by the published pointer
+    OperationData const * published = result.Detach();
+    return published;
+}
+
+void OperationLogRecordPayload::Replace(
+    __inout OperationData const * volatile & target,
+    __in_opt OperationData const * const value)
+{
+    OperationData::CSPtr reference = value;
+    OperationData::CSPtr previous = nullptr;
+
+    previous.Attach(target);
+    target = reference.Detach();
+}
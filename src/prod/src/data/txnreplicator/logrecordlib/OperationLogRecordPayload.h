@@ -0,0 +1,83 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#pragma once
+
+namespace Data
+{
+    namespace LogRecordLib
+    {
+        //
+        // Undo and redo data of the operation log records, in the form in which they are logged and replicated.
+        //
+        // Payloads read in compressed form are decompressed on first access. The decompression runs outside of any lock
+        // and the result is published with an interlocked compare exchange; a reader that loses the race drops its copy.
+        //
+        class OperationLogRecordPayload
+        {
+            K_DENY_COPY(OperationLogRecordPayload)
+
+        public:
+
+            OperationLogRecordPayload(
+                __in_opt Utilities::OperationData const * const undo,
+                __in_opt Utilities::OperationData const * const redo);
+
+            ~OperationLogRecordPayload();
+
+            //
+            // OperationDataCompression flags of the payloads stored compressed
+            //
+            __declspec(property(get = get_CompressionFlags, put = set_CompressionFlags)) BYTE CompressionFlags;
+            BYTE get_CompressionFlags() const
+            {
+                return compressionFlags_;
+            }
+            void set_CompressionFlags(__in BYTE value)
+            {
+                compressionFlags_ = value;
+            }
+
+            //
+            // Sets the payloads as read from the log or received from the primary, in the form given by CompressionFlags
+            //
+            void SetSerialized(
+                __in Utilities::OperationData::CSPtr const & undo,
+                __in Utilities::OperationData::CSPtr const & redo);
+
+            //
+            // Compresses the payloads that shrink, unless they were read in compressed form
+            //
+            void Compress(
+                __in bool includeUndo,
+                __in KAllocator & allocator);
+
+            Utilities::OperationData::CSPtr GetUndo(__in KAllocator & allocator) const;
+            Utilities::OperationData::CSPtr GetRedo(__in KAllocator & allocator) const;
+
+            Utilities::OperationData const * GetSerializedUndo() const;
+            Utilities::OperationData const * GetSerializedRedo() const;
+
+        private:
+
+            static Utilities::OperationData::CSPtr GetDecompressed(
+                __inout Utilities::OperationData const * volatile & decompressed,
+                __in Utilities::OperationData::CSPtr const & compressed,
+                __in KAllocator & allocator);
+
+            static void Replace(
+                __inout Utilities::OperationData const * volatile & target,
+                __in_opt Utilities::OperationData const * const value);
+
+            BYTE compressionFlags_;
+            Utilities::OperationData::CSPtr compressedUndo_;
+            Utilities::OperationData::CSPtr compressedRedo_;
+
+            // Each holds a reference on the decompressed payload, set at most once after construction
+            mutable Utilities::OperationData const * volatile undo_;
+            mutable Utilities::OperationData const * volatile redo_;
+        };
+    }
+}
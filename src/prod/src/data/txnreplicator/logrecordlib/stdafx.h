@@ -29,6 +29,7 @@
 #define INVALID_LOGRECORDS 'RLii'
 
 #define LOGRECORDS_TAG 'RgoL'
+#define OPERATIONDATACOMPRESSION_TAG 'CDpO'
 #define PHYSICALLOGREADER_TAG 'RyhP'
 
 #include "LogRecordLib.Public.h"
@@ -1344,6 +1344,35 @@ Awaitable<NTSTATUS> StateManager::ApplyAsync(
     co_return STATUS_SUCCESS;
 }
 
+bool StateManager::TryGetApplyStateProviderId(
+    __in_opt OperationData const * const metadataPtr,
+    __out FABRIC_STATE_PROVIDER_ID & stateProviderId) noexcept
+{
+    stateProviderId = EmptyStateProviderId;
+
+    if (metadataPtr == nullptr || metadataPtr->BufferCount == 0)
+    {
+        return false;
+    }
+
+    ULONG32 metadataOperationDataCount = 0;
+    OperationData::CSPtr userOperationData = nullptr;
+    NTSTATUS status = NamedOperationData::DeserializeContext(
+        metadataPtr,
+        GetThisAllocator(),
+        metadataOperationDataCount,
+        stateProviderId,
+        userOperationData);
+
+    if (NT_SUCCESS(status) == false)
+    {
+        return false;
+    }
+
+    // State manager operations add or remove state providers, so they are ordered with the operations on those state providers.
+    return stateProviderId != StateManagerId;
+}
+
 NTSTATUS StateManager::Unlock(
     __in OperationContext const& operationContext) noexcept
 {
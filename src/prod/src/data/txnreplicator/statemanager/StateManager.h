@@ -246,6 +246,10 @@ namespace Data
 
             NTSTATUS Unlock(__in TxnReplicator::OperationContext const & operationContext) noexcept override;
 
+            bool TryGetApplyStateProviderId(
+                __in_opt Data::Utilities::OperationData const * const metadataPtr,
+                __out FABRIC_STATE_PROVIDER_ID & stateProviderId) noexcept override;
+
             NTSTATUS PrepareCheckpoint(__in LONG64 checkpointLSN) noexcept override;
 
             ktl::Awaitable<NTSTATUS> PerformCheckpointAsync(
@@ -0,0 +1,81 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace UtilitiesTests
+{
+    using namespace ktl;
+    using namespace Data::Utilities;
+
+    class CRC32PerfTest
+    {
+    public:
+        Common::CommonConfig config; // load the config object as its needed for the tracing to work
+
+        void BufferPerfTest(
+            __in ULONG32 bufferSize,
+            __in ULONG32 numberOfOperations);
+    };
+
+    void CRC32PerfTest::BufferPerfTest(
+        __in ULONG32 bufferSize,
+        __in ULONG32 numberOfOperations)
+    {
+        cout << Common::formatString(
+            "Type: CRC32 HardwareAccelerated: {0} BufferSize: {1} Operations: {2}",
+            Common::crc32::IsHardwareAccelerated(),
+            bufferSize,
+            numberOfOperations) << endl;
+
+        std::vector<byte> buffer(bufferSize);
+        for (ULONG32 i = 0; i < bufferSize; i++)
+        {
+            buffer[i] = static_cast<byte>(i * 31 + 7);
+        }
+
+        ULONG32 checksum = 0;
+
+        Common::Stopwatch stopwatch;
+        stopwatch.Start();
+
+        for (ULONG32 i = 0; i < numberOfOperations; i++)
+        {
+            checksum ^= Common::crc32(buffer.data(), bufferSize).Value();
+        }
+
+        stopwatch.Stop();
+
+        LONG64 duration = stopwatch.ElapsedMilliseconds;
+        LONG64 tmpDuration = duration == 0 ? 1 : duration;
+        ULONG64 totalBytes = static_cast<ULONG64>(bufferSize) * numberOfOperations;
+
+        cout << Common::formatString(
+            "Result: Duration: {0} ms Operations: {1} Throughput: {2} MB/s Checksum: {3}",
+            duration,
+            numberOfOperations,
+            (totalBytes / (1024 * 1024)) * 1000 / tmpDuration,
+            checksum) << endl;
+
+        cout << endl;
+    }
+
+    BOOST_FIXTURE_TEST_SUITE(CRC32PerfTestSuite, CRC32PerfTest);
+
+    BOOST_AUTO_TEST_CASE(Perf_CRC32_Buffer_64_SUCCESS)
+    {
+        BufferPerfTest(64, 1024 * 1024);
+    }
+
+    BOOST_AUTO_TEST_CASE(Perf_CRC32_Buffer_4096_SUCCESS)
+    {
+        BufferPerfTest(4096, 64 * 1024);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,181 @@
+// ------------------------------------------------------------
+// Copyright (c) Microsoft Corporation.  All rights reserved.
+// Licensed under the MIT License (MIT). See License.txt in the repo root for license information.
+// ------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include <boost/test/unit_test.hpp>
+#include "Common/boost-taef.h"
+
+namespace UtilitiesTests
+{
+    using namespace ktl;
+    using namespace Data::Utilities;
+
+    class CRC64PerfTest
+    {
+    public:
+        Common::CommonConfig config; // load the config object as its needed for the tracing to work
+
+        CRC64PerfTest()
+        {
+            NTSTATUS status;
+            status = KtlSystem::Initialize(FALSE, &ktlSystem_);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+            ktlSystem_->SetStrictAllocationChecks(TRUE);
+        }
+
+        ~CRC64PerfTest()
+        {
+            ktlSystem_->Shutdown();
+        }
+
+        void BufferPerfTest(
+            __in ULONG32 bufferSize,
+            __in ULONG32 numberOfOperations);
+
+        void OperationDataPerfTest(
+            __in ULONG32 bufferCount,
+            __in ULONG32 bufferSize,
+            __in ULONG32 numberOfOperations);
+
+    private:
+        KBuffer::SPtr CreateBuffer(__in ULONG32 bufferSize)
+        {
+            KBuffer::SPtr buffer = nullptr;
+            NTSTATUS status = KBuffer::Create(bufferSize, buffer, GetAllocator());
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            byte * bytes = static_cast<byte *>(buffer->GetBuffer());
+            for (ULONG32 i = 0; i < bufferSize; i++)
+            {
+                bytes[i] = static_cast<byte>(i * 31 + 7);
+            }
+
+            return buffer;
+        }
+
+        void Trace(
+            __in ULONG32 count,
+            __in ULONG64 totalBytes,
+            __in LONG64 duration,
+            __in ULONG64 checksum)
+        {
+            LONG64 tmpDuration = duration == 0 ? 1 : duration;
+
+            cout << Common::formatString(
+                "Result: Duration: {0} ms Operations: {1} Throughput: {2} MB/s Checksum: {3}",
+                duration,
+                count,
+                (totalBytes / (1024 * 1024)) * 1000 / tmpDuration,
+                checksum) << endl;
+
+            cout << endl;
+        }
+
+        KAllocator& GetAllocator()
+        {
+            return ktlSystem_->PagedAllocator();
+        }
+
+    public:
+        KtlSystem* ktlSystem_;
+    };
+
+    void CRC64PerfTest::BufferPerfTest(
+        __in ULONG32 bufferSize,
+        __in ULONG32 numberOfOperations)
+    {
+        cout << Common::formatString(
+            "Type: CRC64 KBuffer HardwareAccelerated: {0} BufferSize: {1} Operations: {2}",
+            CRC64::IsHardwareAccelerated(),
+            bufferSize,
+            numberOfOperations) << endl;
+
+        KBuffer::SPtr buffer = CreateBuffer(bufferSize);
+        ULONG64 checksum = 0;
+
+        Common::Stopwatch stopwatch;
+        stopwatch.Start();
+
+        for (ULONG32 i = 0; i < numberOfOperations; i++)
+        {
+            checksum ^= CRC64::ToCRC64(*buffer, 0, bufferSize);
+        }
+
+        stopwatch.Stop();
+
+        Trace(
+            numberOfOperations,
+            static_cast<ULONG64>(bufferSize) * numberOfOperations,
+            stopwatch.ElapsedMilliseconds,
+            checksum);
+    }
+
+    void CRC64PerfTest::OperationDataPerfTest(
+        __in ULONG32 bufferCount,
+        __in ULONG32 bufferSize,
+        __in ULONG32 numberOfOperations)
+    {
+        cout << Common::formatString(
+            "Type: CRC64 OperationData HardwareAccelerated: {0} BufferCount: {1} BufferSize: {2} Operations: {3}",
+            CRC64::IsHardwareAccelerated(),
+            bufferCount,
+            bufferSize,
+            numberOfOperations) << endl;
+
+        OperationData::SPtr operationData = OperationData::Create(GetAllocator());
+        for (ULONG32 i = 0; i < bufferCount; i++)
+        {
+            operationData->Append(*CreateBuffer(bufferSize));
+        }
+
+        ULONG64 checksum = 0;
+
+        Common::Stopwatch stopwatch;
+        stopwatch.Start();
+
+        for (ULONG32 i = 0; i < numberOfOperations; i++)
+        {
+            checksum ^= CRC64::ToCRC64(*operationData, 0, bufferCount);
+        }
+
+        stopwatch.Stop();
+
+        Trace(
+            numberOfOperations,
+            static_cast<ULONG64>(bufferSize) * bufferCount * numberOfOperations,
+            stopwatch.ElapsedMilliseconds,
+            checksum);
+    }
+
+    BOOST_FIXTURE_TEST_SUITE(CRC64PerfTestSuite, CRC64PerfTest);
+
+    BOOST_AUTO_TEST_CASE(Perf_CRC64_Buffer_64_SUCCESS)
+    {
+        BufferPerfTest(64, 1024 * 1024);
+    }
+
+    BOOST_AUTO_TEST_CASE(Perf_CRC64_Buffer_4096_SUCCESS)
+    {
+        BufferPerfTest(4096, 64 * 1024);
+    }
+
+    BOOST_AUTO_TEST_CASE(Perf_CRC64_Buffer_1048576_SUCCESS)
+    {
+        BufferPerfTest(1024 * 1024, 256);
+    }
+
+    BOOST_AUTO_TEST_CASE(Perf_CRC64_OperationData_16_4096_SUCCESS)
+    {
+        OperationDataPerfTest(16, 4096, 4 * 1024);
+    }
+
+    BOOST_AUTO_TEST_CASE(Perf_CRC64_OperationData_256_100_SUCCESS)
+    {
+        OperationDataPerfTest(256, 100, 8 * 1024);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END()
+}
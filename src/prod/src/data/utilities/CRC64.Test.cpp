@@ -34,4 +34,76 @@ namespace UtilitiesTests
         result = CRC64::ToCRC64(buffer, 2, 5);
         CODING_ERROR_ASSERT(result == 14226437255121905647);
     }
+
+    BOOST_AUTO_TEST_CASE(ToCRC64_LargeBuffer)
+    {
+        // Long enough to go through the folded (hardware) path, with unaligned starts and a partial tail
+        byte buffer[1000];
+        for (ULONG32 i = 0; i < sizeof(buffer); i++)
+        {
+            buffer[i] = static_cast<byte>(i * 31 + 7);
+        }
+
+        ULONG64 result = CRC64::ToCRC64(buffer, 0, 1000);
+        CODING_ERROR_ASSERT(result == 17575910746972481767);
+
+        result = CRC64::ToCRC64(buffer, 3, 997);
+        CODING_ERROR_ASSERT(result == 13142732525756375851);
+
+        result = CRC64::ToCRC64(buffer, 1, 100);
+        CODING_ERROR_ASSERT(result == 1923476565371822097);
+    }
+
+    BOOST_AUTO_TEST_CASE(ToCRC64_OperationData_MatchesContiguous)
+    {
+        KtlSystem * ktlSystem = nullptr;
+        NTSTATUS status = KtlSystem::Initialize(FALSE, &ktlSystem);
+        CODING_ERROR_ASSERT(NT_SUCCESS(status));
+        ktlSystem->SetStrictAllocationChecks(TRUE);
+
+        {
+            KAllocator & allocator = ktlSystem->NonPagedAllocator();
+
+            ULONG32 const size = 300;
+            KBuffer::SPtr source = nullptr;
+            status = KBuffer::Create(size, source, allocator);
+            CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+            byte * buffer = static_cast<byte *>(source->GetBuffer());
+            for (ULONG32 i = 0; i < size; i++)
+            {
+                buffer[i] = static_cast<byte>(i * 13 + 5);
+            }
+
+            ULONG64 expected = CRC64::ToCRC64(*source, 0, size);
+
+            // Every split point must produce the CRC of the concatenation, whichever buffers end up on the folded path
+            for (ULONG32 split = 1; split < size; split += 7)
+            {
+                KBuffer::SPtr first = nullptr;
+                status = KBuffer::CreateOrCopyFrom(first, *source, 0, split, allocator);
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                KBuffer::SPtr second = nullptr;
+                status = KBuffer::CreateOrCopyFrom(second, *source, split, size - split, allocator);
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                OperationData::SPtr operationData = OperationData::Create(allocator);
+                operationData->Append(*first);
+                operationData->Append(*second);
+
+                CODING_ERROR_ASSERT(CRC64::ToCRC64(*operationData, 0, 2) == expected);
+
+                KArray<OperationData::CSPtr> operationDataArray(allocator);
+                CODING_ERROR_ASSERT(NT_SUCCESS(operationDataArray.Status()));
+
+                status = operationDataArray.Append(operationData.RawPtr());
+                CODING_ERROR_ASSERT(NT_SUCCESS(status));
+
+                CODING_ERROR_ASSERT(CRC64::ToCRC64(operationDataArray, 0, 1) == expected);
+            }
+        }
+
+        ktlSystem->Shutdown();
+    }
 }
@@ -5,6 +5,18 @@
 
 #include "stdafx.h"
 
+#if defined(_M_X64) || defined(__x86_64__)
+#define CRC64_CLMUL_SUPPORTED 1
+#if defined(PLATFORM_UNIX)
+#include <cpuid.h>
+#include <immintrin.h>
+#define CRC64_CLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+#else
+#include <intrin.h>
+#define CRC64_CLMUL_TARGET
+#endif
+#endif
+
 using namespace Data::Utilities;
 
 static const ULONG64 Crc64Table[] = {
@@ -266,6 +278,218 @@ static const ULONG64 Crc64Table[] = {
     0x9AFCE626CE85B507
 };
 
+// Inputs shorter than this are cheaper to checksum with the tables than to set up the folding
+static const ULONG32 Crc64FoldThreshold = 64;
+
+//
+// Slicing-by-8 tables: SlicingTable[k][b] is the CRC of byte b followed by k zero bytes.
+// Used when the CPU does not support carry-less multiplication.
+//
+class Crc64SlicingTables
+{
+public:
+    Crc64SlicingTables()
+    {
+        for (ULONG32 i = 0; i < 256; i++)
+        {
+            Table[0][i] = Crc64Table[i];
+        }
+
+        for (ULONG32 k = 1; k < 8; k++)
+        {
+            for (ULONG32 i = 0; i < 256; i++)
+            {
+                ULONG64 previous = Table[k - 1][i];
+                Table[k][i] = Crc64Table[previous >> 56] ^ (previous << 8);
+            }
+        }
+    }
+
+    ULONG64 Table[8][256];
+};
+
+// Built on first use so that checksums computed during static initialization see complete tables
+static Crc64SlicingTables const & GetCrc64SlicingTables()
+{
+    static Crc64SlicingTables const tables;
+    return tables;
+}
+
+static ULONG64 UpdateCrc64Table(
+    __in ULONG64 crc,
+    __in byte const * data,
+    __in ULONG32 count)
+{
+    for (ULONG32 i = 0; i < count; i++)
+    {
+        ULONG64 tableIndex = (static_cast<ULONG64>(crc >> 56) ^ data[i]) & 0xff;
+        crc = Crc64Table[tableIndex] ^ (crc << 8);
+    }
+
+    return crc;
+}
+
+static ULONG64 UpdateCrc64Slicing(
+    __in ULONG64 crc,
+    __in byte const * data,
+    __in ULONG32 count)
+{
+    ULONG64 const (&table)[8][256] = GetCrc64SlicingTables().Table;
+
+    while (count >= 8)
+    {
+        // The CRC is not reflected, so the first byte is the most significant one
+        ULONG64 value = crc ^
+            (static_cast<ULONG64>(data[0]) << 56 | static_cast<ULONG64>(data[1]) << 48 |
+             static_cast<ULONG64>(data[2]) << 40 | static_cast<ULONG64>(data[3]) << 32 |
+             static_cast<ULONG64>(data[4]) << 24 | static_cast<ULONG64>(data[5]) << 16 |
+             static_cast<ULONG64>(data[6]) << 8 | static_cast<ULONG64>(data[7]));
+
+        crc = table[7][value >> 56] ^ table[6][(value >> 48) & 0xff] ^
+              table[5][(value >> 40) & 0xff] ^ table[4][(value >> 32) & 0xff] ^
+              table[3][(value >> 24) & 0xff] ^ table[2][(value >> 16) & 0xff] ^
+              table[1][(value >> 8) & 0xff] ^ table[0][value & 0xff];
+
+        data += 8;
+        count -= 8;
+    }
+
+    return UpdateCrc64Table(crc, data, count);
+}
+
+#if defined(CRC64_CLMUL_SUPPORTED)
+
+static bool IsClmulSupported()
+{
+    unsigned int ecx = 0;
+
+#if defined(PLATFORM_UNIX)
+    unsigned int eax, ebx, edx;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+    {
+        return false;
+    }
+#else
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 1);
+    ecx = static_cast<unsigned int>(cpuInfo[2]);
+#endif
+
+    // CPUID.1:ECX bit 1 is PCLMULQDQ and bit 9 is SSSE3 (needed for the byte swap)
+    return (ecx & (1u << 1)) != 0 && (ecx & (1u << 9)) != 0;
+}
+
+static const bool Crc64UseClmul = IsClmulSupported();
+
+//
+// Folds the 128 bit remainder forward over the next 16 bytes:
+//  x = hi * (x^(d+64) mod P) + lo * (x^d mod P) + next
+// where the high and low halves of the constant hold the two multipliers for the folding distance d.
+//
+CRC64_CLMUL_TARGET
+static inline __m128i FoldCrc64(
+    __in __m128i x,
+    __in __m128i constants,
+    __in __m128i next)
+{
+    __m128i high = _mm_clmulepi64_si128(x, constants, 0x11);
+    __m128i low = _mm_clmulepi64_si128(x, constants, 0x00);
+    return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+CRC64_CLMUL_TARGET
+static inline __m128i LoadCrc64Block(
+    __in byte const * data,
+    __in __m128i byteSwap)
+{
+    // Byte swap so that bit i of the register is the coefficient of x^i
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(data)), byteSwap);
+}
+
+//
+// PCLMULQDQ folding of four 128 bit lanes, reduced with the tables at the end.
+// Requires count >= Crc64FoldThreshold.
+//
+CRC64_CLMUL_TARGET
+static ULONG64 UpdateCrc64Clmul(
+    __in ULONG64 crc,
+    __in byte const * data,
+    __in ULONG32 count)
+{
+    __m128i const byteSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    // x^576 mod P, x^512 mod P
+    __m128i const fold4 = _mm_set_epi64x(static_cast<LONG64>(0xDDF4B6981205B83F), static_cast<LONG64>(0x5F6843CA540DF020));
+
+    // x^192 mod P, x^128 mod P
+    __m128i const fold1 = _mm_set_epi64x(static_cast<LONG64>(0x4EB938A7D257740E), static_cast<LONG64>(0x05F5C3C7EB52FAB6));
+
+    // The running CRC is xor-ed into the first 8 bytes of the message
+    __m128i x0 = _mm_xor_si128(LoadCrc64Block(data, byteSwap), _mm_set_epi64x(static_cast<LONG64>(crc), 0));
+    __m128i x1 = LoadCrc64Block(data + 16, byteSwap);
+    __m128i x2 = LoadCrc64Block(data + 32, byteSwap);
+    __m128i x3 = LoadCrc64Block(data + 48, byteSwap);
+
+    data += 64;
+    count -= 64;
+
+    while (count >= 64)
+    {
+        x0 = FoldCrc64(x0, fold4, LoadCrc64Block(data, byteSwap));
+        x1 = FoldCrc64(x1, fold4, LoadCrc64Block(data + 16, byteSwap));
+        x2 = FoldCrc64(x2, fold4, LoadCrc64Block(data + 32, byteSwap));
+        x3 = FoldCrc64(x3, fold4, LoadCrc64Block(data + 48, byteSwap));
+
+        data += 64;
+        count -= 64;
+    }
+
+    __m128i x = FoldCrc64(x0, fold1, x1);
+    x = FoldCrc64(x, fold1, x2);
+    x = FoldCrc64(x, fold1, x3);
+
+    while (count >= 16)
+    {
+        x = FoldCrc64(x, fold1, LoadCrc64Block(data, byteSwap));
+
+        data += 16;
+        count -= 16;
+    }
+
+    // The remainder is a 16 byte message that already includes the running CRC
+    byte remainder[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(remainder), _mm_shuffle_epi8(x, byteSwap));
+
+    crc = UpdateCrc64Slicing(0, remainder, sizeof(remainder));
+    return UpdateCrc64Slicing(crc, data, count);
+}
+
+#endif
+
+static ULONG64 UpdateCrc64(
+    __in ULONG64 crc,
+    __in byte const * data,
+    __in ULONG32 count)
+{
+#if defined(CRC64_CLMUL_SUPPORTED)
+    if (Crc64UseClmul && count >= Crc64FoldThreshold)
+    {
+        return UpdateCrc64Clmul(crc, data, count);
+    }
+#endif
+
+    return UpdateCrc64Slicing(crc, data, count);
+}
+
+bool CRC64::IsHardwareAccelerated()
+{
+#if defined(CRC64_CLMUL_SUPPORTED)
+    return Crc64UseClmul;
+#else
+    return false;
+#endif
+}
+
 ULONG64 CRC64::ToCRC64(
    __in KBuffer const & buffer,
    __in ULONG32 offset,
@@ -279,13 +503,7 @@ ULONG64 CRC64::ToCRC64(
     __in ULONG32 offset,
     __in ULONG32 count)
 {
-    ULONG64 crc = 0xffffffffffffffff;
-
-    for (ULONG32 i = offset; i < offset + count; i++)
-    {
-        ULONG64 tableIndex = (static_cast<ULONG64>(crc >> 56) ^ value[i]) & 0xff;
-        crc = Crc64Table[tableIndex] ^ (crc << 8);
-    }
+    ULONG64 crc = UpdateCrc64(0xffffffffffffffff, value + offset, count);
 
     return crc ^ 0xffffffffffffffff;
 }
@@ -299,16 +517,11 @@ ULONG64 CRC64::ToCRC64(
 
     ASSERT_IF(offset + count > operationData.BufferCount, "Offset + Count cannot be larger than BufferCount");
 
+    // The running CRC is carried across the buffers so the result is the CRC of their concatenation
     for (ULONG32 bufferIndex = offset; bufferIndex < count + offset; bufferIndex++)
     {
         KBuffer::CSPtr bufferCSPtr = operationData[bufferIndex];
-        for (ULONG32 byteIndex = 0; byteIndex < bufferCSPtr->QuerySize(); byteIndex++)
-        {
-            void const * rawBuffer = bufferCSPtr->GetBuffer();
-            byte const * byteBuffer = static_cast<byte const *>(rawBuffer);
-            ULONG64 tableIndex = (static_cast<ULONG64>(crc >> 56) ^ byteBuffer[byteIndex]) & 0xff;
-            crc = Crc64Table[tableIndex] ^ (crc << 8);
-        }
+        crc = UpdateCrc64(crc, static_cast<byte const *>(bufferCSPtr->GetBuffer()), bufferCSPtr->QuerySize());
     }
 
     return crc ^ 0xffffffffffffffff;
@@ -325,17 +538,12 @@ ULONG64 CRC64::ToCRC64(
 
     for (ULONG32 operationDataIndex = offset; operationDataIndex < count + offset; operationDataIndex++)
     {
-        OperationData::CSPtr operationDataCSPtr = operationDataArray[operationDataIndex];
+        OperationData const & operationData = *operationDataArray[operationDataIndex];
 
-        for (ULONG32 bufferIndex = 0; bufferIndex < operationDataCSPtr->BufferCount; bufferIndex++)
+        for (ULONG32 bufferIndex = 0; bufferIndex < operationData.BufferCount; bufferIndex++)
         {
-            KBuffer::CSPtr bufferCSPtr = (*operationDataCSPtr)[bufferIndex];
-            for (ULONG32 byteIndex = 0; byteIndex < bufferCSPtr->QuerySize(); byteIndex++)
-            {
-                byte const * byteBuffer = static_cast<byte const *>(bufferCSPtr->GetBuffer());
-                ULONG64 tableIndex = (static_cast<ULONG64>(crc >> 56) ^ byteBuffer[byteIndex]) & 0xff;
-                crc = Crc64Table[tableIndex] ^ (crc << 8);
-            }
+            KBuffer::CSPtr bufferCSPtr = operationData[bufferIndex];
+            crc = UpdateCrc64(crc, static_cast<byte const *>(bufferCSPtr->GetBuffer()), bufferCSPtr->QuerySize());
         }
     }
 
@@ -11,9 +11,15 @@ namespace Data
     {
         class OperationData;
 
+        //
+        // CRC-64 (ECMA-182 polynomial) used for the log record and checkpoint checksums.
+        // Uses PCLMULQDQ folding when the CPU supports it and slicing-by-8 tables otherwise.
+        //
         class CRC64
         {
         public:
+            static bool IsHardwareAccelerated();
+
             static ULONG64 ToCRC64(
                 __in KBuffer const & buffer,
                 __in ULONG32 offset,
@@ -68,6 +68,48 @@ NTSTATUS LockControlBlock::Create(
    return STATUS_SUCCESS;
 }
 
+LockControlBlock::SPtr LockControlBlock::Reuse(
+   __in LockControlBlock & pooledLockControlBlock,
+   __in LockManager& lockManager,
+   __in LONG64 owner,
+   __in ULONG64 resourceNameHash,
+   __in LockMode::Enum mode,
+   __in Common::TimeSpan timeout,
+   __in LockStatus::Enum status,
+   __in bool isUpgraded)
+{
+   LockControlBlock & result = pooledLockControlBlock;
+   KInvariant(result.GetRefCount() == 0);
+
+   result.lockManagerSPtr_ = &lockManager;
+   result.lockOwner_ = owner;
+   result.lockResourceNameHash_ = resourceNameHash;
+   result.lockMode_ = mode;
+   result.timeOut_ = timeout;
+   result.lockStatus_ = status;
+   result.grantTime_ = 0;
+   result.isUpgradedLock_ = isUpgraded;
+   result.count_ = 1;
+
+   return LockControlBlock::SPtr(&result);
+}
+
+VOID LockControlBlock::OnDelete()
+{
+   // Release what the block references so that a pooled block does not keep the lock manager alive
+   KSharedPtr<LockManager> lockManagerSPtr = Ktl::Move(lockManagerSPtr_);
+   waiterSPtr_ = nullptr;
+   timerSPtr_ = nullptr;
+
+   if (lockManagerSPtr != nullptr && lockManagerSPtr->TryPoolLockControlBlock(*this))
+   {
+      // The pool is freed with the lock manager, possibly when lockManagerSPtr goes out of scope here.
+      return;
+   }
+
+   K_DELETE<LockControlBlock>(this);
+}
+
 LONG64 LockControlBlock::GetOwner() const 
 {
    return lockOwner_;
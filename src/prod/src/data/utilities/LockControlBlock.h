@@ -26,6 +26,19 @@ namespace Data
                __in KAllocator& Allocator,
                __out LockControlBlock::SPtr& Result);
 
+         //
+         // Re-initializes a pooled lock control block (reference count of zero) for a new lock request
+         //
+         static LockControlBlock::SPtr Reuse(
+               __in LockControlBlock & pooledLockControlBlock,
+               __in LockManager& lockManager,
+               __in LONG64 owner,
+               __in ULONG64 resourceNameHash,
+               __in LockMode::Enum mode,
+               __in Common::TimeSpan timeout,
+               __in LockStatus::Enum status,
+               __in bool isUpgraded);
+
          __declspec(property(get = get_LockCount, put = set_LockCount)) ULONG32 LockCount;
          ULONG32 get_LockCount() const
          {
@@ -89,6 +102,11 @@ namespace Data
             __in KAsyncContextBase* const,
             __in KAsyncContextBase&);
 
+         //
+         // Returns the block to the lock manager's pool instead of freeing it when the last reference is released
+         //
+         VOID OnDelete() override;
+
          KSharedPtr<LockManager> lockManagerSPtr_;
          LONG64 lockOwner_;
          ULONG64 lockResourceNameHash_;
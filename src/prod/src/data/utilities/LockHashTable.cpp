@@ -14,7 +14,14 @@ ULONG MyHashFunction(const ULONG64& Val)
 }
 
 LockHashTable::LockHashTable()
+    : lockControlBlockPool_(GetThisAllocator(), MaxPooledLockControlBlocks)
 {
+    if (!NT_SUCCESS(lockControlBlockPool_.Status()))
+    {
+        this->SetConstructorStatus(lockControlBlockPool_.Status());
+        return;
+    }
+
     UnsignedLongComparer::SPtr comparerSPtr;
     NTSTATUS status = UnsignedLongComparer::Create(this->GetThisAllocator(), comparerSPtr);
     this->SetConstructorStatus(status);
@@ -31,6 +38,10 @@ LockHashTable::LockHashTable()
 
 LockHashTable::~LockHashTable()
 {
+    for (ULONG32 index = 0; index < lockControlBlockPool_.Count(); index++)
+    {
+        K_DELETE<LockControlBlock>(lockControlBlockPool_[index]);
+    }
 }
 
 NTSTATUS LockHashTable::Create(
@@ -84,6 +95,38 @@ void LockHashTable::DecrementEmptyLocksCount()
     ASSERT_IFNOT(count >= 0, "Invalid count={0}", count);
 }
 
+LockControlBlock * LockHashTable::TryTakePooledLockControlBlock()
+{
+    LockControlBlock * lockControlBlock = nullptr;
+
+    K_LOCK_BLOCK(lockControlBlockPoolLock_)
+    {
+        ULONG32 count = lockControlBlockPool_.Count();
+        if (count > 0)
+        {
+            lockControlBlock = lockControlBlockPool_[count - 1];
+            BOOLEAN result = lockControlBlockPool_.Remove(count - 1);
+            KInvariant(result == TRUE);
+        }
+    }
+
+    return lockControlBlock;
+}
+
+bool LockHashTable::TryPoolLockControlBlock(__in LockControlBlock & lockControlBlock)
+{
+    K_LOCK_BLOCK(lockControlBlockPoolLock_)
+    {
+        if (lockControlBlockPool_.Count() < MaxPooledLockControlBlocks)
+        {
+            NTSTATUS status = lockControlBlockPool_.Append(&lockControlBlock);
+            return NT_SUCCESS(status);
+        }
+    }
+
+    return false;
+}
+
 void LockHashTable::Close()
 {
    lockEntriesSPtr_ = nullptr;
@@ -45,10 +45,22 @@ namespace Data
          void IncrementEmptyLocksCount();
          void DecrementEmptyLocksCount();
 
+         //
+         // Pool of lock control blocks whose last reference was released, reused by requests that hash to this table.
+         // Pooled blocks have a reference count of zero.
+         //
+         LockControlBlock * TryTakePooledLockControlBlock();
+         bool TryPoolLockControlBlock(__in LockControlBlock & lockControlBlock);
+
       private:
+         static const ULONG32 MaxPooledLockControlBlocks = 64;
+
          Dictionary<ULONG64, LockHashValue::SPtr>::SPtr lockEntriesSPtr_;
          KReaderWriterSpinLock lockHashTableLock_;
 
+         KSpinLock lockControlBlockPoolLock_;
+         KArray<LockControlBlock *> lockControlBlockPool_;
+
          LONG64 emptyLocksCount_ = 0;
       };
    }
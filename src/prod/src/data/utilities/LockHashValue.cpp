@@ -9,6 +9,7 @@
 using namespace Data::Utilities;
 
 LockHashValue::LockHashValue()
+   : fastState_(FastStateFree)
 {
    NTSTATUS status = LockResourceControlBlock::Create(this->GetThisAllocator(), lockResourceControlBlock_);
    this->SetConstructorStatus(status);
@@ -41,23 +42,101 @@ NTSTATUS LockHashValue::Create(
 void LockHashValue::EnterWriteLock()
 {
    lock_.Acquire();
+   InflateFastState();
 }
 
 void LockHashValue::ExitWriteLock()
 {
+   DeflateFastState();
    lock_.Release();
 }
 
 void LockHashValue::EnterReadLock()
 {
    lock_.Acquire();
+   InflateFastState();
 }
 
 void LockHashValue::ExitReadLock()
 {
+   DeflateFastState();
    lock_.Release();
 }
 
+bool LockHashValue::TryAcquireFast(__in LockControlBlock & lockControlBlock)
+{
+   LONG64 lockControlBlockState = reinterpret_cast<LONG64>(&lockControlBlock);
+   KInvariant(lockControlBlockState != FastStateFree && lockControlBlockState != FastStateInflated);
+
+   // The state owns a reference while the lock is granted through the fast path
+   lockControlBlock.AddRef();
+
+   if (InterlockedCompareExchange64(&fastState_, lockControlBlockState, FastStateFree) != FastStateFree)
+   {
+      lockControlBlock.Release();
+      return false;
+   }
+
+   return true;
+}
+
+bool LockHashValue::TryReleaseFast(__in LockControlBlock & lockControlBlock)
+{
+   LONG64 lockControlBlockState = reinterpret_cast<LONG64>(&lockControlBlock);
+
+   // Fails if the grant has been moved into the granted list by the slow path
+   if (InterlockedCompareExchange64(&fastState_, FastStateFree, lockControlBlockState) != lockControlBlockState)
+   {
+      return false;
+   }
+
+   lockControlBlock.Release();
+   return true;
+}
+
+void LockHashValue::InflateFastState()
+{
+   // Called with lock_ held
+   LONG64 state = fastState_;
+   while (state != FastStateInflated)
+   {
+      LONG64 previousState = InterlockedCompareExchange64(&fastState_, FastStateInflated, state);
+      if (previousState != state)
+      {
+         state = previousState;
+         continue;
+      }
+
+      if (state != FastStateFree)
+      {
+         //
+         // Move the fast path grantee into the granted list, taking over the reference owned by the state.
+         // It was granted on a resource with no clients, so the granted mode is its own mode.
+         //
+         LockControlBlock * grantee = reinterpret_cast<LockControlBlock *>(state);
+         ASSERT_IFNOT(!lockResourceControlBlock_->HasClients(), "Fast path grant on a resource with clients");
+
+         NTSTATUS status = lockResourceControlBlock_->GrantedList->Append(LockControlBlock::SPtr(grantee));
+         KInvariant(NT_SUCCESS(status));
+         grantee->Release();
+
+         lockResourceControlBlock_->LockModeGranted = grantee->GetLockMode();
+      }
+
+      break;
+   }
+}
+
+void LockHashValue::DeflateFastState()
+{
+   // Called with lock_ held. Only the slow path moves the state out of FastStateInflated.
+   if (fastState_ == FastStateInflated && !lockResourceControlBlock_->HasClients())
+   {
+      lockResourceControlBlock_->LockModeGranted = LockMode::Enum::Free;
+      InterlockedExchange64(&fastState_, FastStateFree);
+   }
+}
+
 void LockHashValue::Close()
 {
 
@@ -30,15 +30,44 @@ namespace Data
             lockResourceControlBlock_ = &value;
          }
 
+         //
+         // Taking the second level lock moves a fast path grantee into the granted list.
+         // Releasing it re-enables the fast path if the resource has no clients left.
+         //
          void EnterWriteLock();
          void ExitWriteLock();
          void EnterReadLock();
          void ExitReadLock();
          void Close();
 
+         //
+         // Lock-free fast path for a resource with a single lock owner.
+         // The grant is kept in fastState_ instead of the granted list, so it succeeds only if the resource has no granted or waiting clients.
+         //
+         __declspec(property(get = get_IsFastPathFree)) bool IsFastPathFree;
+         bool get_IsFastPathFree() const
+         {
+            return fastState_ == FastStateFree;
+         }
+
+         bool TryAcquireFast(__in LockControlBlock & lockControlBlock);
+         bool TryReleaseFast(__in LockControlBlock & lockControlBlock);
+
       private:
+         void InflateFastState();
+         void DeflateFastState();
+
+         //
+         // FastStateFree: no clients, the fast path can grant the lock.
+         // FastStateInflated: the granted list and waiting queue hold the state of the resource.
+         // Any other value is the LockControlBlock of the only granted lock, holding one reference on it.
+         //
+         static const LONG64 FastStateFree = 0;
+         static const LONG64 FastStateInflated = 1;
+
          LockResourceControlBlock::SPtr lockResourceControlBlock_;
          KSpinLock lock_;
+         volatile LONG64 fastState_;
       };
    }
 }
@@ -303,6 +303,71 @@ namespace UtilitiesTests
                 globalOpCount / duration.TotalSeconds());
         }
 
+        ktl::Awaitable<void> LockManager_AcquireReleaseOwnKey_UntilCancelled(
+            __in ULONG32 taskId,
+            __in LockMode::Enum mode,
+            __in LockManager & lockManager,
+            __in LONG64 & globalOpCount,
+            __in CancellationToken token)
+        {
+            co_await CorHelper::ThreadPoolThread(this->GetAllocator().GetKtlSystem().DefaultThreadPool());
+            LONG64 localOpCount = 0;
+            while (!token.IsCancellationRequested)
+            {
+                // Every task uses its own key so that no lock request ever waits
+                auto lock = co_await lockManager.AcquireLockAsync(
+                    taskId,
+                    taskId,
+                    mode,
+                    Common::TimeSpan::FromSeconds(4)
+                );
+
+                lockManager.ReleaseLock(*lock);
+                lock->Close();
+
+                localOpCount++;
+            }
+
+            InterlockedAdd64(&globalOpCount, localOpCount);
+        }
+
+        ktl::Awaitable<void> LockManager_UncontendedKeys_Throughput(__in Common::TimeSpan duration, __in LockMode::Enum mode)
+        {
+            for (ULONG numTasks = 1; numTasks <= 64; numTasks *= 2)
+            {
+                LockManager::SPtr lockManagerSPtr = nullptr;
+                LockManager::Create(GetAllocator(), lockManagerSPtr);
+                co_await lockManagerSPtr->OpenAsync();
+
+                ktl::CancellationTokenSource::SPtr tokenSource = nullptr;
+                ktl::CancellationTokenSource::Create(this->GetAllocator(), ALLOC_TAG, tokenSource);
+
+                LONG64 globalOpCount = 0;
+
+                KSharedArray<ktl::Awaitable<void>>::SPtr tasks = _new(ALLOC_TAG, this->GetAllocator()) KSharedArray<ktl::Awaitable<void>>();
+                for (ULONG i = 0; i < numTasks; i++)
+                {
+                    tasks->Append(LockManager_AcquireReleaseOwnKey_UntilCancelled(i, mode, *lockManagerSPtr, globalOpCount, tokenSource->Token));
+                }
+
+                Common::Threadpool::Post([&] {
+                    tokenSource->Cancel();
+                }, duration);
+
+                co_await TaskUtilities<void>::WhenAll(*tasks);
+
+                co_await lockManagerSPtr->CloseAsync();
+                Trace.WriteInfo(
+                    "Perf",
+                    "Uncontended {0} locks with {1} tasks: {2} acquisitions / {3} second = {4} acquisitions/sec",
+                    mode == LockMode::Enum::Shared ? "shared" : "exclusive",
+                    numTasks,
+                    globalOpCount,
+                    duration.TotalSeconds(),
+                    globalOpCount / duration.TotalSeconds());
+            }
+        }
+
     private:
         KtlSystem* ktlSystem_;
         LockManager::SPtr lockManagerSPtr_;
@@ -381,5 +446,15 @@ namespace UtilitiesTests
         SyncAwait(LockManager_SingleKeyRead_Throughput(Common::TimeSpan::FromSeconds(180), 12));
     }
 
+    BOOST_AUTO_TEST_CASE(LockManagerPerf_UncontendedKeys_Shared_Throughput)
+    {
+        SyncAwait(LockManager_UncontendedKeys_Throughput(Common::TimeSpan::FromSeconds(2), LockMode::Enum::Shared));
+    }
+
+    BOOST_AUTO_TEST_CASE(LockManagerPerf_UncontendedKeys_Exclusive_Throughput)
+    {
+        SyncAwait(LockManager_UncontendedKeys_Throughput(Common::TimeSpan::FromSeconds(2), LockMode::Enum::Exclusive));
+    }
+
     BOOST_AUTO_TEST_SUITE_END()
 }
@@ -284,6 +284,52 @@ namespace UtilitiesTests
            co_return;
        }
 
+        ktl::Awaitable<void> UncontendedLock_ReacquireAfterRelease_WaitersGrantedAfterRelease_Test()
+       {
+           LockManager::SPtr lockManagerSptr = LockManagerTest::CreateLockManager();
+
+           // Acquire and release the same resource repeatedly, reusing the released lock control blocks.
+           for (ULONG32 i = 0; i < 100; i++)
+           {
+               auto lock = co_await lockManagerSptr->AcquireLockAsync(17, 100, i % 2 == 0 ? LockMode::Enum::Shared : LockMode::Enum::Exclusive, TimeSpan::FromMilliseconds(100));
+               CODING_ERROR_ASSERT(lock->GetStatus() == LockStatus::Enum::Granted);
+
+               auto status = lockManagerSptr->ReleaseLock(*lock);
+               CODING_ERROR_ASSERT(status == UnlockStatus::Enum::Success);
+
+               status = lockManagerSptr->ReleaseLock(*lock);
+               CODING_ERROR_ASSERT(status == UnlockStatus::Enum::NotGranted);
+               lock->Close();
+           }
+
+           auto reader = co_await lockManagerSptr->AcquireLockAsync(17, 100, LockMode::Enum::Shared, TimeSpan::FromMilliseconds(100));
+           CODING_ERROR_ASSERT(reader->GetStatus() == LockStatus::Enum::Granted);
+
+           // The owner already holds the lock, so the lock count is incremented.
+           auto sameReader = co_await lockManagerSptr->AcquireLockAsync(17, 100, LockMode::Enum::Shared, TimeSpan::FromMilliseconds(100));
+           CODING_ERROR_ASSERT(sameReader.RawPtr() == reader.RawPtr());
+           CODING_ERROR_ASSERT(reader->LockCount == 2);
+
+           ktl::Awaitable<KSharedPtr<LockControlBlock>> writerAwaitable = lockManagerSptr->AcquireLockAsync(18, 100, LockMode::Enum::Exclusive, TimeSpan::MaxValue);
+           CODING_ERROR_ASSERT(!writerAwaitable.IsComplete());
+
+           auto status = lockManagerSptr->ReleaseLock(*reader);
+           CODING_ERROR_ASSERT(status == UnlockStatus::Enum::Success);
+           CODING_ERROR_ASSERT(!writerAwaitable.IsComplete());
+
+           status = lockManagerSptr->ReleaseLock(*reader);
+           CODING_ERROR_ASSERT(status == UnlockStatus::Enum::Success);
+           reader->Close();
+
+           auto writer = co_await writerAwaitable;
+           CODING_ERROR_ASSERT(writer->GetStatus() == LockStatus::Enum::Granted);
+
+           status = lockManagerSptr->ReleaseLock(*writer);
+           CODING_ERROR_ASSERT(status == UnlockStatus::Enum::Success);
+           writer->Close();
+           co_return;
+       }
+
         ktl::Awaitable<void> DifferentLock_ConcurrentWriters_ShouldSucceed_Test()
        {
           // Create 1000 outstanding writer locks, and verify they all acquire the same lock concurrently
@@ -1697,6 +1743,11 @@ namespace UtilitiesTests
        SyncAwait(SameLock_ReadersWaitingOnWriters_ShouldSucceedAfterWriterReleasesLock_Test());
    }
 
+   BOOST_AUTO_TEST_CASE(UncontendedLock_ReacquireAfterRelease_WaitersGrantedAfterRelease)
+   {
+       SyncAwait(UncontendedLock_ReacquireAfterRelease_WaitersGrantedAfterRelease_Test());
+   }
+
    BOOST_AUTO_TEST_CASE(DifferentLock_ConcurrentWriters_ShouldSucceed)
    {
        SyncAwait(DifferentLock_ConcurrentWriters_ShouldSucceed_Test());
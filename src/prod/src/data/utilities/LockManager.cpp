@@ -167,9 +167,7 @@ ktl::Awaitable<void> LockManager::CloseAsync() noexcept
         throw ktl::Exception(STATUS_INVALID_PARAMETER_3);
     }
 
-    AwaitableCompletionSource<KSharedPtr<LockControlBlock>>::SPtr waiterTcs = nullptr;
-    NTSTATUS status = AwaitableCompletionSource<KSharedPtr<LockControlBlock>>::Create(GetThisAllocator(), 0, waiterTcs);
-    THROW_ON_FAILURE(status);
+    NTSTATUS status = STATUS_SUCCESS;
     LockHashValue::SPtr lockHashValueSPtr = nullptr;
     ULONG32 lockHashTableIndex = static_cast<ULONG32>(resourceNameHash % lockHashTableCount_);
     auto lockHashTableSPtr = lockHashTables_[lockHashTableIndex];
@@ -194,12 +192,37 @@ ktl::Awaitable<void> LockManager::CloseAsync() noexcept
        LockControlBlock::SPtr lockControlBlockSPtr = nullptr;
        status = LockControlBlock::Create(*this, owner, resourceNameHash, mode, timeout, LockStatus::Invalid, false, GetThisAllocator(), lockControlBlockSPtr);
        THROW_ON_FAILURE(status);
-       waiterTcs->SetResult(lockControlBlockSPtr);
-       return waiterTcs->GetAwaitable();
+       return CompletedLockAsync(lockControlBlockSPtr);
     }
 
     LockMode::Enum tableLockMode = LockMode::Enum::Shared;
     bool lockHashFound = lockHashTableSPtr->LockEntries->TryGetValue(resourceNameHash, lockHashValueSPtr);
+    if (lockHashFound && IsFastPathMode(mode) && lockHashValueSPtr->IsFastPathFree)
+    {
+       //
+       // The resource has no clients. Grant the lock without the second level lock.
+       //
+       LockControlBlock::SPtr lockControlBlockSPtr = CreateLockControlBlock(*lockHashTableSPtr, owner, resourceNameHash, mode, timeout, LockStatus::Granted, false);
+       lockControlBlockSPtr->SetGrantedTime(KDateTime::Now());
+
+       if (lockHashValueSPtr->TryAcquireFast(*lockControlBlockSPtr))
+       {
+          // The resource was counted as empty. Done under the first level lock so that ClearLocks sees a consistent count.
+          lockHashTableSPtr->DecrementEmptyLocksCount();
+
+          //
+          // Release first level lock.
+          //
+          lockHashTableSPtr->ExitReadLock();
+
+          return CompletedLockAsync(lockControlBlockSPtr);
+       }
+
+       //
+       // Another request got to the resource first, take the slow path.
+       //
+    }
+
     if (!lockHashFound)
     {
         // Didn't find the lock hash, so try again in exclusive mode in case we need to insert
@@ -316,8 +339,7 @@ ktl::Awaitable<void> LockManager::CloseAsync() noexcept
              //
              // The lock request is added to the granted list and the granted mode is re-computed.
              //
-             status = LockControlBlock::Create(*this, owner, resourceNameHash, mode, timeout, LockStatus::Granted, false, GetThisAllocator(), lockControlBlockSPtr);
-             THROW_ON_FAILURE(status);
+             lockControlBlockSPtr = CreateLockControlBlock(*lockHashTableSPtr, owner, resourceNameHash, mode, timeout, LockStatus::Granted, false);
              lockControlBlockSPtr->SetGrantedTime(KDateTime::Now());
 
              //
@@ -356,8 +378,7 @@ ktl::Awaitable<void> LockManager::CloseAsync() noexcept
           //
           // Return immediately.
           //
-          waiterTcs->SetResult(lockControlBlockSPtr);
-          return waiterTcs->GetAwaitable();
+          return CompletedLockAsync(lockControlBlockSPtr);
        }
        else
        {
@@ -374,17 +395,14 @@ ktl::Awaitable<void> LockManager::CloseAsync() noexcept
              //
              // Timeout lock request immediately.
              //
-             status = LockControlBlock::Create(*this, owner, resourceNameHash, mode, timeout, LockStatus::Timeout, false, GetThisAllocator(), lockControlBlockSPtr);
-             THROW_ON_FAILURE(status);
-             waiterTcs->SetResult(lockControlBlockSPtr);
-             return waiterTcs->GetAwaitable();
+             lockControlBlockSPtr = CreateLockControlBlock(*lockHashTableSPtr, owner, resourceNameHash, mode, timeout, LockStatus::Timeout, false);
+             return CompletedLockAsync(lockControlBlockSPtr);
           }
 
           //
           // The lock request is added to the waiting list.
           //
-          status = LockControlBlock::Create(*this, owner, resourceNameHash, mode, timeout, LockStatus::Pending, isUpgrade, GetThisAllocator(), lockControlBlockSPtr);
-          THROW_ON_FAILURE(status);
+          lockControlBlockSPtr = CreateLockControlBlock(*lockHashTableSPtr, owner, resourceNameHash, mode, timeout, LockStatus::Pending, isUpgrade);
           if (!isUpgrade)
           {
              //
@@ -461,23 +479,43 @@ ktl::Awaitable<void> LockManager::CloseAsync() noexcept
        // Create new lock control block.
        //
        LockControlBlock::SPtr lockControlBlockSPtr = nullptr;
-       status = LockControlBlock::Create(*this, owner, resourceNameHash, mode, timeout, LockStatus::Granted, false, GetThisAllocator(), lockControlBlockSPtr);
-       THROW_ON_FAILURE(status);
+       lockControlBlockSPtr = CreateLockControlBlock(*lockHashTableSPtr, owner, resourceNameHash, mode, timeout, LockStatus::Granted, false);
        lockControlBlockSPtr->SetGrantedTime(KDateTime::Now());
 
-       //
-       // Add the new lock control block to the granted list.
-       //
-       status = lockHashValueSPtr->ResourceControlBlock->GrantedList->Append(lockControlBlockSPtr);
-       KInvariant(NT_SUCCESS(status));
-
        // Lock is no longer empty, cancelling out increment above
        // lockHashTableSPtr->DecrementEmptyLocksCount();
 
-       //
-       // Set the lock resource granted lock status.
-       //
-       lockHashValueSPtr->ResourceControlBlock->LockModeGranted = ConvertToMaxLockMode(mode, LockMode::Enum::Free);
+       if (IsFastPathMode(mode))
+       {
+          //
+          // The new resource is not visible to other requests yet, so the fast path grant cannot fail.
+          //
+          bool isAcquired = lockHashValueSPtr->TryAcquireFast(*lockControlBlockSPtr);
+          KInvariant(isAcquired);
+       }
+       else
+       {
+          //
+          // Acquire second level lock.
+          //
+          lockHashValueSPtr->EnterWriteLock();
+
+          //
+          // Add the new lock control block to the granted list.
+          //
+          status = lockHashValueSPtr->ResourceControlBlock->GrantedList->Append(lockControlBlockSPtr);
+          KInvariant(NT_SUCCESS(status));
+
+          //
+          // Set the lock resource granted lock status.
+          //
+          lockHashValueSPtr->ResourceControlBlock->LockModeGranted = ConvertToMaxLockMode(mode, LockMode::Enum::Free);
+
+          //
+          // Release second level lock.
+          //
+          lockHashValueSPtr->ExitWriteLock();
+       }
 
        //
        // Release first level lock.
@@ -497,9 +535,51 @@ ktl::Awaitable<void> LockManager::CloseAsync() noexcept
        //
        // Return immediately.
        //
-       waiterTcs->SetResult(lockControlBlockSPtr);
-       return waiterTcs->GetAwaitable();
+       return CompletedLockAsync(lockControlBlockSPtr);
+    }
+ }
+
+ ktl::Awaitable<KSharedPtr<LockControlBlock>> LockManager::CompletedLockAsync(__in KSharedPtr<LockControlBlock> lockControlBlock)
+ {
+    // Requests that complete synchronously do not need a completion source
+    co_return lockControlBlock;
+ }
+
+ LockControlBlock::SPtr LockManager::CreateLockControlBlock(
+    __in LockHashTable & lockHashTable,
+    __in LONG64 owner,
+    __in ULONG64 resourceNameHash,
+    __in LockMode::Enum mode,
+    __in Common::TimeSpan timeout,
+    __in LockStatus::Enum lockStatus,
+    __in bool isUpgraded)
+ {
+    LockControlBlock * pooledLockControlBlock = lockHashTable.TryTakePooledLockControlBlock();
+    if (pooledLockControlBlock != nullptr)
+    {
+       return LockControlBlock::Reuse(*pooledLockControlBlock, *this, owner, resourceNameHash, mode, timeout, lockStatus, isUpgraded);
     }
+
+    LockControlBlock::SPtr lockControlBlockSPtr = nullptr;
+    NTSTATUS status = LockControlBlock::Create(*this, owner, resourceNameHash, mode, timeout, lockStatus, isUpgraded, GetThisAllocator(), lockControlBlockSPtr);
+    THROW_ON_FAILURE(status);
+
+    return lockControlBlockSPtr;
+ }
+
+ bool LockManager::TryPoolLockControlBlock(__in LockControlBlock & lockControlBlock)
+ {
+    //
+    // The lock hash tables are created in Open and not changed afterwards.
+    // Blocks released once the lock manager is closed are freed.
+    //
+    if (!status_)
+    {
+       return false;
+    }
+
+    ULONG32 lockHashTableIndex = static_cast<ULONG32>(lockControlBlock.LockResourceNameHash % lockHashTableCount_);
+    return lockHashTables_[lockHashTableIndex]->TryPoolLockControlBlock(lockControlBlock);
  }
 
  UnlockStatus::Enum LockManager::ReleaseLock(__in LockControlBlock& acquiredLock)
@@ -527,6 +607,31 @@ ktl::Awaitable<void> LockManager::CloseAsync() noexcept
             ASSERT_IFNOT(task.IsTaskStarted(), "Failed to start clear locks background task");
         }
 
+       //
+       // A lock granted through the fast path is released without the second level lock,
+       // unless a conflicting request has moved it into the granted list in the meantime.
+       //
+       if (acquiredLock.LockCount == 1 && lockHashValueSPtr->TryReleaseFast(acquiredLock))
+       {
+          acquiredLock.LockCount = 0;
+          lockHashTableSPtr->IncrementEmptyLocksCount();
+
+          //
+          // Release first level lock.
+          //
+          lockHashTableSPtr->ExitReadLock();
+
+          //
+          // This lock control block cannot be reused after this call.
+          //
+          if (acquiredLock.StopExpire())
+          {
+             acquiredLock.Close();
+          }
+
+          return UnlockStatus::Enum::Success;
+       }
+
        //
        // Acquire second level lock.
        //
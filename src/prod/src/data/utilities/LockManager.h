@@ -51,6 +51,11 @@ namespace Data
 
             bool ExpireLock(__in LockControlBlock& lockControlBlockSPtr);
 
+            //
+            // Returns true if the lock control block was kept for reuse by a later lock request.
+            //
+            bool TryPoolLockControlBlock(__in LockControlBlock & lockControlBlock);
+
             bool IsShared(__in LockMode::Enum mode);
 
         protected:
@@ -91,6 +96,25 @@ namespace Data
                 __in LockMode::Enum key,
                 __in KSharedPtr<Dictionary<LockMode::Enum, LockMode::Enum>> value);
 
+            //
+            // Shared and exclusive locks on a resource without clients are granted without the second level lock.
+            //
+            static bool IsFastPathMode(__in LockMode::Enum mode)
+            {
+                return mode == LockMode::Enum::Shared || mode == LockMode::Enum::Exclusive;
+            }
+
+            static ktl::Awaitable<KSharedPtr<LockControlBlock>> CompletedLockAsync(__in KSharedPtr<LockControlBlock> lockControlBlock);
+
+            KSharedPtr<LockControlBlock> CreateLockControlBlock(
+                __in LockHashTable & lockHashTable,
+                __in LONG64 owner,
+                __in ULONG64 resourceNameHash,
+                __in LockMode::Enum mode,
+                __in Common::TimeSpan timeout,
+                __in LockStatus::Enum lockStatus,
+                __in bool isUpgraded);
+
             bool IsCompatible(
                 __in LockMode::Enum modeRequested,
                 __in LockMode::Enum modeGranted);